@@ -0,0 +1,99 @@
+/*-----------------------------------------------------------------------------------------------
+The MIT License (MIT)
+
+Copyright (c) 2015-2022 OSRE ( Open Source Render Engine ) by Kim Kulling
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of
+this software and associated documentation files (the "Software"), to deal in
+the Software without restriction, including without limitation the rights to
+use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+the Software, and to permit persons to whom the Software is furnished to do so,
+subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+-----------------------------------------------------------------------------------------------*/
+#pragma once
+
+#include <osre/Animation/AnimatorBase.h>
+#include <cppcore/Container/TArray.h>
+
+namespace OSRE {
+namespace Animation {
+
+/// The maximal number of bones which can influence one vertex.
+static constexpr ui32 MaxBoneInfluences = 4;
+
+//-------------------------------------------------------------------------------------------------
+///	@ingroup	Engine
+///
+///	@brief  The packed bone influences of one vertex. Indices and weights are stored as bytes,
+///         the weights are normalized so they sum up to 255.
+//-------------------------------------------------------------------------------------------------
+struct VertexInfluence {
+    uc8 mBoneIndices[MaxBoneInfluences];
+    uc8 mWeights[MaxBoneInfluences];
+};
+
+using VertexInfluenceArray = ::CPPCore::TArray<VertexInfluence>;
+
+//-------------------------------------------------------------------------------------------------
+///	@ingroup	Engine
+///
+///	@brief  Collects the per-bone vertex weights of a mesh and packs them into one influence
+///         stream per vertex. Every weight is visited once, so building the stream is linear
+///         in the number of weights. When more than MaxBoneInfluences bones reference a vertex
+///         the strongest ones are kept.
+//-------------------------------------------------------------------------------------------------
+class OSRE_EXPORT VertexInfluenceBuilder {
+public:
+    /// @brief  The maximal bone index which can be stored in a packed influence.
+    static constexpr ui32 MaxBoneIndex = 255;
+
+    /// @brief  The class constructor.
+    VertexInfluenceBuilder();
+
+    /// @brief  The class destructor.
+    ~VertexInfluenceBuilder() = default;
+
+    /// @brief  Will clear all collected weights and prepare the builder for a new mesh.
+    /// @param  numVertices     The number of vertices of the mesh.
+    void reset(size_t numVertices);
+
+    /// @brief  Will add the weights of one bone.
+    /// @param  boneIndex       The index of the bone.
+    /// @param  weights         The vertex weights of the bone.
+    /// @param  numWeights      The number of weights.
+    /// @param  vertexOffset    Will be added to all vertex indices of the weights.
+    /// @return true if successful, false in case of an invalid bone or vertex index.
+    bool addBone(ui32 boneIndex, const VertexWeight *weights, size_t numWeights, size_t vertexOffset);
+
+    /// @brief  Will return the number of vertices.
+    /// @return The number of vertices.
+    size_t getNumVertices() const;
+
+    /// @brief  Will pack the collected weights.
+    /// @param  influences      The packed influences, one per vertex.
+    void build(VertexInfluenceArray &influences) const;
+
+private:
+    struct Slot {
+        f32 mWeights[MaxBoneInfluences];
+        uc8 mBoneIndices[MaxBoneInfluences];
+    };
+    ::CPPCore::TArray<Slot> mSlots;
+};
+
+inline size_t VertexInfluenceBuilder::getNumVertices() const {
+    return mSlots.size();
+}
+
+} // Namespace Animation
+} // Namespace OSRE
@@ -0,0 +1,161 @@
+/*-----------------------------------------------------------------------------------------------
+The MIT License (MIT)
+
+Copyright (c) 2015-2022 OSRE ( Open Source Render Engine ) by Kim Kulling
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of
+this software and associated documentation files (the "Software"), to deal in
+the Software without restriction, including without limitation the rights to
+use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+the Software, and to permit persons to whom the Software is furnished to do so,
+subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+-----------------------------------------------------------------------------------------------*/
+#pragma once
+
+#include <osre/App/AppCommon.h>
+#include <osre/Common/TAABB.h>
+#include <cppcore/Container/TArray.h>
+
+namespace OSRE {
+
+// Forward declarations ---------------------------------------------------------------------------
+namespace Common {
+    class Frustum;
+    class Ray;
+}
+
+namespace App {
+
+//-------------------------------------------------------------------------------------------------
+///	@ingroup	Engine
+///
+///	@brief  This class implements a dynamic bounding volume hierarchy of axis aligned boxes.
+///
+/// Each proxy is stored as a leaf with a fat box, which is enlarged by a margin. Moving a proxy
+/// inside its fat box costs nothing, otherwise the leaf will be reinserted. An insertion picks
+/// the sibling with the lowest surface area cost and tree rotations keep the tree balanced, so
+/// queries with small result sets run in O(log n).
+//-------------------------------------------------------------------------------------------------
+class OSRE_EXPORT AABBTree {
+public:
+    /// @brief  The id of an invalid proxy.
+    static const i32 NullNode = -1;
+
+    /// @brief  The class constructor.
+    /// @param  margin      [in] The fat boxes will be enlarged by this margin.
+    explicit AABBTree(f32 margin = 0.1f);
+
+    /// @brief  The class destructor.
+    ~AABBTree();
+
+    /// @brief  Will create a new proxy.
+    /// @param  aabb        [in] The bounding box.
+    /// @param  userData    [in] The user data returned by the queries.
+    /// @return The proxy id.
+    i32 createProxy(const Common::AABB &aabb, void *userData);
+
+    /// @brief  Will destroy a proxy.
+    /// @param  proxyId     [in] The proxy id.
+    void destroyProxy(i32 proxyId);
+
+    /// @brief  Will move a proxy.
+    /// @param  proxyId     [in] The proxy id.
+    /// @param  aabb        [in] The new bounding box.
+    /// @return true if the proxy was reinserted, false if it is still inside its fat box.
+    bool moveProxy(i32 proxyId, const Common::AABB &aabb);
+
+    /// @brief  Returns the user data of a proxy.
+    /// @param  proxyId     [in] The proxy id.
+    /// @return The user data.
+    void *getUserData(i32 proxyId) const;
+
+    /// @brief  Returns the fat box of a proxy.
+    /// @param  proxyId     [in] The proxy id.
+    /// @return The fat box.
+    const Common::AABB &getFatAABB(i32 proxyId) const;
+
+    /// @brief  Collects all proxies intersecting a box.
+    /// @param  box         [in] The box to test.
+    /// @param  result      [out] The user data of all found proxies will be added.
+    void queryBox(const Common::AABB &box, CPPCore::TArray<void *> &result) const;
+
+    /// @brief  Collects all proxies intersecting a sphere.
+    /// @param  center      [in] The center of the sphere.
+    /// @param  radius      [in] The radius of the sphere.
+    /// @param  result      [out] The user data of all found proxies will be added.
+    void querySphere(const glm::vec3 &center, f32 radius, CPPCore::TArray<void *> &result) const;
+
+    /// @brief  Collects all proxies inside or intersecting a frustum.
+    /// @param  frustum     [in] The frustum to test.
+    /// @param  result      [out] The user data of all found proxies will be added.
+    void queryFrustum(const Common::Frustum &frustum, CPPCore::TArray<void *> &result) const;
+
+    /// @brief  Collects all proxies hit by a ray.
+    /// @param  ray         [in] The ray.
+    /// @param  maxDistance [in] The length of the ray, in units of its direction.
+    /// @param  result      [out] The user data of all found proxies will be added.
+    void queryRay(const Common::Ray &ray, f32 maxDistance, CPPCore::TArray<void *> &result) const;
+
+    /// @brief  Returns the number of proxies.
+    /// @return The number of proxies.
+    size_t getNumProxies() const;
+
+    /// @brief  Returns the number of levels, 0 for an empty tree.
+    /// @return The height.
+    i32 getHeight() const;
+
+    /// @brief  Will remove all proxies.
+    void clear();
+
+private:
+    struct Node {
+        Common::AABB m_aabb;
+        void *m_userData;
+        i32 m_parent;   ///< The parent or the next free node.
+        i32 m_child1;
+        i32 m_child2;
+        i32 m_height;   ///< 0 for leaves, -1 for free nodes.
+
+        bool isLeaf() const {
+            return NullNode == m_child1;
+        }
+    };
+
+    i32 allocateNode();
+    void freeNode(i32 nodeId);
+    void insertLeaf(i32 leaf);
+    void removeLeaf(i32 leaf);
+    i32 balance(i32 nodeId);
+    void refit(i32 nodeId);
+    void collectLeaves(i32 nodeId, CPPCore::TArray<void *> &result) const;
+    template <class Classifier>
+    void query(const Classifier &classifier, CPPCore::TArray<void *> &result) const;
+
+private:
+    CPPCore::TArray<Node> mNodes;
+    i32 mRoot;
+    i32 mFreeList;
+    size_t mNumProxies;
+    f32 mMargin;
+};
+
+inline size_t AABBTree::getNumProxies() const {
+    return mNumProxies;
+}
+
+inline i32 AABBTree::getHeight() const {
+    return NullNode == mRoot ? 0 : mNodes[mRoot].m_height + 1;
+}
+
+} // Namespace App
+} // Namespace OSRE
@@ -25,6 +25,7 @@ CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
 #include <osre/App/AssetsCommon.h>
 #include <osre/RenderBackend/RenderCommon.h>
 #include <osre/Animation/AnimatorBase.h>
+#include <osre/Animation/Skinning.h>
 #include <osre/Common/Ids.h>
 #include <osre/Common/TAABB.h>
 
@@ -71,7 +72,9 @@ class Node;
 class OSRE_EXPORT AssimpWrapper {
 public:
     using MaterialArray = CPPCore::TArray<RenderBackend::Material *>;
-    using Bone2NodeMap = std::map<const char *, const aiNode *>;
+    using Bone2NodeMap = std::map<String, const aiNode *>;
+    using BoneLookupMap = std::map<String, ui32>;
+    using InfluenceArray = CPPCore::TArray<Animation::VertexInfluenceArray *>;
     using AnimationMap = std::map<const char*, Animation::AnimationTrack*>;
 
     /// @brief The class constructor.
@@ -88,6 +91,12 @@ public:
     /// @return true, if successful. false if not.
     bool importAsset( const IO::Uri &file, ui32 flags );
 
+    /// @brief Will convert a scene, which was loaded or built before. The meshes are converted
+    ///        on the job system, when there is one.
+    /// @param scene    The scene, the caller keeps the ownership.
+    /// @return The imported entity, nullptr if the scene is nullptr.
+    Entity *importScene( const aiScene *scene );
+
     /// @brief  Will return the imported entity.
     /// @return The imported entity, nullptr if nothing was imported.
     Entity *getEntity() const;
@@ -97,12 +106,22 @@ public:
     /// @param numTriangles     The number of triangles in the model.
     void getStatistics(ui32 &numVertices, ui32 &numTriangles);
 
+    /// @brief Will return the packed bone influences of an imported mesh.
+    /// @param meshIdx          The index of the mesh.
+    /// @return The influences, one per vertex, or nullptr if the mesh is not skinned.
+    const Animation::VertexInfluenceArray *getVertexInfluences(size_t meshIdx) const;
+
+    /// @brief Will return the skeleton, which contains all imported bones.
+    /// @return The skeleton.
+    const Animation::Skeleton &getSkeleton() const;
+
 protected:
     Entity *convertScene();
     void importMeshes( aiMesh **meshes, ui32 numMeshes );
-	//void importBones(aiMesh* mesh);
+    void importBones( aiMesh *mesh, CPPCore::TArray<ui32> &boneIndices );
     void importNode( aiNode *node, Node *parent );
-    void importMaterial( aiMaterial *material );
+    void importMaterials( aiMaterial **materials, ui32 numMaterials );
+    void importMaterial( aiMaterial *material, CPPCore::TArray<RenderBackend::TextureResource *> &texResArray );
     void importSkeletons(aiSkeleton *skeletons, size_t numSkeletons);
     void importAnimation(aiAnimation *animation, Animation::AnimationTrack &currentAnimationTrack, AnimationMap &animLookup);
     void optimizeVertexBuffer();
@@ -120,6 +139,9 @@ private:
         String mRoot;
         String mAbsPathWithFile;
         Bone2NodeMap mBone2NodeMap;
+        BoneLookupMap mBoneLookup;
+        Animation::Skeleton mSkeleton;
+        InfluenceArray mInfluenceArray;
         ui32 mNumVertices;
         ui32 mNumTriangles;
         AssetContext(Common::Ids &ids, World *world);
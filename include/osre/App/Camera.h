@@ -31,6 +31,11 @@ CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
 #include <osre/Common/TAABB.h>
 
 namespace OSRE {
+
+namespace Common {
+    class Frustum;
+}
+
 namespace App {
 
 enum class CameraModel {
@@ -101,6 +106,10 @@ public:
     /// @brief
     const glm::mat4 &getProjection() const;
 
+    /// @brief  Will extract the view frustum from the current view-projection matrix.
+    /// @param  frustum     [out] The frustum in world space.
+    void getFrustum(Common::Frustum &frustum) const;
+
     /// @brief
     f32 getFov() const;
 
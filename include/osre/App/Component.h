@@ -71,6 +71,10 @@ public:
 
 protected:
     Component(Entity *owner, ui32 id, ComponentType type);
+    Component(const Component &) = default;
+    Component(Component &&) = default;
+    Component &operator = (const Component &) = default;
+    Component &operator = (Component &&) = default;
     virtual bool onPreprocess() = 0;
     virtual bool onUpdate(Time dt) = 0;
     virtual bool onRender(RenderBackend::RenderBackendService *renderBackendSrv) = 0;
@@ -114,12 +118,17 @@ inline ComponentType Component::getType() const {
 class OSRE_EXPORT RenderComponent : public Component {
 public:
     RenderComponent(Entity *owner, ui32 id);
+    RenderComponent(RenderComponent &&) = default;
+    RenderComponent &operator = (RenderComponent &&) = default;
     ~RenderComponent() override = default;
     size_t getNumGeometry() const;
     RenderBackend::Mesh *getMeshAt(size_t idx) const;
     void getMeshArray(RenderBackend::MeshArray &array);
     void addStaticMesh(RenderBackend::Mesh *geo);
     void addStaticMeshArray(const RenderBackend::MeshArray &array);
+    /// @brief  Will show or hide the already submitted meshes, the render batches keep them.
+    void setVisible(RenderBackend::RenderBackendService *rbSrv, bool visible);
+    bool isVisible() const;
 
 protected:
     bool onPreprocess() override;
@@ -128,7 +137,9 @@ protected:
     bool onPostprocess() override;
 
 private:
-    CPPCore::TArray<RenderBackend::Mesh*> m_newGeo;
+    CPPCore::TArray<RenderBackend::Mesh*> m_meshes;
+    size_t m_numSubmitted;
+    bool m_isVisible;
 };
 
 //-------------------------------------------------------------------------------------------------
@@ -139,6 +150,8 @@ private:
 class OSRE_EXPORT TransformComponent final : public Component {
 public:
     TransformComponent(Entity *owner, ui32 id);
+    TransformComponent(TransformComponent &&) = default;
+    TransformComponent &operator = (TransformComponent &&) = default;
     ~TransformComponent() override = default;
     void setNode(Node *node);
 
@@ -155,6 +168,8 @@ private:
 class LightComponent final : public Component {
 public:
     LightComponent(Entity *owner, ui32 id);
+    LightComponent(LightComponent &&) = default;
+    LightComponent &operator = (LightComponent &&) = default;
     ~LightComponent() override = default;
     void setLight(RenderBackend::Light *light);
 
@@ -171,6 +186,8 @@ private:
 class ScriptComponent final : public Component {
 public:
     ScriptComponent(Entity *owner, ui32 id);
+    ScriptComponent(ScriptComponent &&) = default;
+    ScriptComponent &operator = (ScriptComponent &&) = default;
     ~ScriptComponent() override = default;
 
 protected:
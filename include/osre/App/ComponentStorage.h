@@ -0,0 +1,137 @@
+/*-----------------------------------------------------------------------------------------------
+The MIT License (MIT)
+
+Copyright (c) 2015-2022 OSRE ( Open Source Render Engine ) by Kim Kulling
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of
+this software and associated documentation files (the "Software"), to deal in
+the Software without restriction, including without limitation the rights to
+use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+the Software, and to permit persons to whom the Software is furnished to do so,
+subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+-----------------------------------------------------------------------------------------------*/
+#pragma once
+
+#include <osre/App/Component.h>
+#include <osre/App/TComponentPool.h>
+
+namespace OSRE {
+namespace App {
+
+class Entity;
+
+//-------------------------------------------------------------------------------------------------
+///	@ingroup	Engine
+///
+///	@brief  This class stores the components of all entities of a world, one pool per type.
+///
+/// Each entity gets a small id from the storage, which is used as the key into the pools. Freed
+/// ids will be reused, so the sparse arrays of the pools stay as small as the number of entities.
+//-------------------------------------------------------------------------------------------------
+class OSRE_EXPORT ComponentStorage {
+public:
+    /// @brief  The number of components updated by one job.
+    static const size_t UpdateChunkSize = 1024;
+
+    /// @brief  The class constructor.
+    ComponentStorage();
+
+    /// @brief  The class destructor.
+    ~ComponentStorage();
+
+    /// @brief  Will create a new entity id.
+    /// @return The new id.
+    ui32 createEntityId();
+
+    /// @brief  Will release an entity id and destroy all components of the entity.
+    /// @param  entityId    [in] The entity id.
+    void releaseEntityId(ui32 entityId);
+
+    /// @brief  Will create a component for an entity.
+    /// @param  entityId    [in] The entity id.
+    /// @param  owner       [in] The entity.
+    /// @param  type        [in] The component type.
+    /// @return The component, the existing one if there is one already, nullptr for an unknown type.
+    Component *createComponent(ui32 entityId, Entity *owner, ComponentType type);
+
+    /// @brief  Will destroy the component of an entity.
+    /// @param  entityId    [in] The entity id.
+    /// @param  type        [in] The component type.
+    /// @return true if destroyed, false if the entity has no component of this type.
+    bool destroyComponent(ui32 entityId, ComponentType type);
+
+    /// @brief  Returns the component of an entity.
+    /// @param  entityId    [in] The entity id.
+    /// @param  type        [in] The component type.
+    /// @return The component or nullptr if the entity has none of this type.
+    Component *getComponent(ui32 entityId, ComponentType type);
+
+    /// @brief  Will update all components, the pools will be updated in parallel chunks.
+    /// @param  dt          [in] The current delta time-tick.
+    void update(Time dt);
+
+    /// @brief  Returns the number of living entity ids.
+    /// @return The number of entity ids.
+    size_t getNumEntities() const;
+
+    /// @brief  Returns the pool of the render components.
+    /// @return The pool.
+    TComponentPool<RenderComponent> &getRenderComponents();
+
+    /// @brief  Returns the pool of the transform components.
+    /// @return The pool.
+    TComponentPool<TransformComponent> &getTransformComponents();
+
+    /// @brief  Returns the pool of the light components.
+    /// @return The pool.
+    TComponentPool<LightComponent> &getLightComponents();
+
+    /// @brief  Returns the pool of the script components.
+    /// @return The pool.
+    TComponentPool<ScriptComponent> &getScriptComponents();
+
+    // Copying is not allowed
+    ComponentStorage(const ComponentStorage &) = delete;
+    ComponentStorage &operator=(const ComponentStorage &) = delete;
+
+private:
+    TComponentPool<RenderComponent> mRenderComponents;
+    TComponentPool<TransformComponent> mTransformComponents;
+    TComponentPool<LightComponent> mLightComponents;
+    TComponentPool<ScriptComponent> mScriptComponents;
+    CPPCore::TArray<ui32> mFreeIds;
+    ui32 mNextId;
+};
+
+inline size_t ComponentStorage::getNumEntities() const {
+    return mNextId - mFreeIds.size();
+}
+
+inline TComponentPool<RenderComponent> &ComponentStorage::getRenderComponents() {
+    return mRenderComponents;
+}
+
+inline TComponentPool<TransformComponent> &ComponentStorage::getTransformComponents() {
+    return mTransformComponents;
+}
+
+inline TComponentPool<LightComponent> &ComponentStorage::getLightComponents() {
+    return mLightComponents;
+}
+
+inline TComponentPool<ScriptComponent> &ComponentStorage::getScriptComponents() {
+    return mScriptComponents;
+}
+
+} // Namespace App
+} // Namespace OSRE
@@ -44,6 +44,7 @@ namespace App {
 class Node;
 class AbstractBehaviour;
 class Component;
+class ComponentStorage;
 class RenderComponent;
 class AppBase;
 class World;
@@ -63,21 +64,44 @@ public:
     bool preprocess();
     bool update( Time dt );
     bool render( RenderBackend::RenderBackendService *rbSrv );
+    void setVisible( RenderBackend::RenderBackendService *rbSrv, bool visible );
     bool postprocess();
+    Component *createComponent(ComponentType type);
+    bool destroyComponent(ComponentType type);
     Component *getComponent(ComponentType type) const;
+    ui32 getEntityId() const;
     void setAABB( const Common::AABB &aabb );
     const Common::AABB &getAABB() const;
+    void setBoundsProxy(i32 proxyId);
+    i32 getBoundsProxy() const;
+    World *getOwner() const;
+    void setOwner(World *owner);
     void serialize(IO::Stream *stream);
     void deserialize(IO::Stream *stream);
 
 private:
     AbstractBehaviour *m_behaviour;
-    RenderComponent *m_renderComponent;
+    ComponentStorage *mStorage;
+    bool mOwnsStorage;
+    ui32 mEntityId;
     Node *m_node;
     const Common::Ids &m_ids;
     Common::AABB m_aabb;
+    i32 mBoundsProxy;
     World *mOwner;
 };
 
+inline ui32 Entity::getEntityId() const {
+    return mEntityId;
+}
+
+inline World *Entity::getOwner() const {
+    return mOwner;
+}
+
+inline void Entity::setOwner(World *owner) {
+    mOwner = owner;
+}
+
 } // Namespace App
 } // Namespace OSRE
@@ -135,7 +135,19 @@ public:
     void setRotation(glm::quat &rotation);
     void setTransformationMatrix(const glm::mat4 &m);
     const glm::mat4 &getTransformationMatrix() const;
-    glm::mat4 getWorlTransformMatrix();
+
+    /// @brief  Returns the world transformation, the cached one if no transformation above has changed.
+    /// @return The world transformation.
+    const glm::mat4 &getWorlTransformMatrix();
+
+    /// @brief  Will update the cached world transformations of this node and its children. Only
+    ///         the subtrees with changed transformations are visited.
+    /// @param  queue   [inout] The breadth-first queue, kept by the caller to reuse its storage.
+    void updateWorldTransforms(NodeArray &queue);
+
+    /// @brief  Returns true, if the world transformation needs to be recomputed.
+    /// @return true for a dirty world transformation.
+    bool isWorldTransformDirty() const;
 
     void addMeshReference(size_t entityMeshIdx);
     size_t getNumMeshReferences() const;
@@ -145,6 +157,9 @@ protected:
     virtual void onUpdate(Time dt);
     virtual void onRender(RenderBackend::RenderBackendService *renderBackendSrv);
 
+private:
+    void setWorldTransformDirty();
+
 private:
     NodeArray m_children;
     Node *m_parent;
@@ -154,6 +169,9 @@ private:
     ::CPPCore::TArray<Properties::Property *> mPropertyArray;
     PropertyMap m_propMap;
     glm::mat4 m_localTransform;
+    glm::mat4 m_worldTransform;
+    bool m_worldTransformDirty;
+    bool m_hasDirtyChildren;
 };
 
 inline void Node::setActive(bool isActive) {
@@ -164,5 +182,9 @@ inline bool Node::isActive() const {
     return m_isActive;
 }
 
+inline bool Node::isWorldTransformDirty() const {
+    return m_worldTransformDirty;
+}
+
 } // Namespace App
 } // namespace OSRE
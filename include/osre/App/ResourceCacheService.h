@@ -24,13 +24,13 @@ CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
 
 #include <osre/Common/TResource.h>
 #include <osre/Common/TResourceCache.h>
-#include <osre/RenderBackend/RenderCommon.h>
+#include <osre/RenderBackend/Material.h>
 
 namespace OSRE {
 namespace App {
 
 using TextureResourceFactory = Common::TResourceFactory<RenderBackend::TextureResource>;
-using TextureResourceCache = Common::TResourceCache<TextureResourceFactory, RenderBackend::TextureResource>;
+using TextureResourceCache = RenderBackend::TextureResourceCache;
 
 //-------------------------------------------------------------------------------------------------
 ///	@ingroup    Engine
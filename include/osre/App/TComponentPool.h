@@ -0,0 +1,253 @@
+/*-----------------------------------------------------------------------------------------------
+The MIT License (MIT)
+
+Copyright (c) 2015-2022 OSRE ( Open Source Render Engine ) by Kim Kulling
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of
+this software and associated documentation files (the "Software"), to deal in
+the Software without restriction, including without limitation the rights to
+use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+the Software, and to permit persons to whom the Software is furnished to do so,
+subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+-----------------------------------------------------------------------------------------------*/
+#pragma once
+
+#include <osre/Common/osre_common.h>
+#include <osre/Debugging/osre_debugging.h>
+#include <osre/Threading/JobSystem.h>
+
+#include <cppcore/Container/TArray.h>
+
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace OSRE {
+namespace App {
+
+//-------------------------------------------------------------------------------------------------
+///	@ingroup	Engine
+///
+///	@brief  A sparse set of components of one type, keyed by the entity id.
+///
+/// The components are stored packed in a dense array, so systems can iterate over them without
+/// chasing a pointer per entity. The sparse array maps the entity id to the dense index, a remove
+/// moves the last component into the gap. So pointers to components are only valid until the
+/// next add or remove on the same pool.
+//-------------------------------------------------------------------------------------------------
+template <class T>
+class TComponentPool {
+    static_assert(std::is_move_constructible<T>::value && std::is_move_assignable<T>::value,
+            "The pool moves components on grow and remove.");
+
+public:
+    /// @brief  Marks an entity id without a component.
+    static const ui32 InvalidIndex = 0xffffffff;
+
+    /// @brief  The class constructor.
+    TComponentPool();
+
+    /// @brief  The class destructor.
+    ~TComponentPool() = default;
+
+    /// @brief  Will create the component for an entity.
+    /// @param  entityId    [in] The entity id.
+    /// @param  args        [in] The constructor arguments of the component.
+    /// @return The component, the existing one if the entity has one already.
+    template <class... Args>
+    T *add(ui32 entityId, Args &&...args);
+
+    /// @brief  Will remove the component of an entity.
+    /// @param  entityId    [in] The entity id.
+    /// @return true if removed, false if the entity has no component.
+    bool remove(ui32 entityId);
+
+    /// @brief  Returns the component of an entity.
+    /// @param  entityId    [in] The entity id.
+    /// @return The component or nullptr if the entity has none.
+    T *get(ui32 entityId);
+
+    /// @brief  Returns the component of an entity.
+    /// @param  entityId    [in] The entity id.
+    /// @return The component or nullptr if the entity has none.
+    const T *get(ui32 entityId) const;
+
+    /// @brief  Returns true, if the entity has a component.
+    /// @param  entityId    [in] The entity id.
+    /// @return true if the entity has a component.
+    bool has(ui32 entityId) const;
+
+    /// @brief  Returns the number of components.
+    /// @return The number of components.
+    size_t size() const;
+
+    /// @brief  Returns the packed component at a dense index.
+    /// @param  index       [in] The dense index.
+    /// @return The component.
+    T &at(size_t index);
+
+    /// @brief  Returns the entity id of the component at a dense index.
+    /// @param  index       [in] The dense index.
+    /// @return The entity id.
+    ui32 getEntityAt(size_t index) const;
+
+    /// @brief  Will remove all components.
+    void clear();
+
+    /// @brief  Calls a function for each component in packed order.
+    /// @param  func        [in] The function, called with a reference to the component.
+    template <class Func>
+    void forEach(Func func);
+
+    /// @brief  Calls a function for each component, chunks of components run in parallel on the
+    ///         job system. Runs serial, if there is no job system or only one chunk.
+    /// @param  chunkSize   [in] The number of components per chunk.
+    /// @param  func        [in] The function, called with a reference to the component.
+    template <class Func>
+    void forEachParallel(size_t chunkSize, Func func);
+
+private:
+    // The components have no default constructor, so they cannot be stored in a TArray
+    std::vector<T> mComponents;
+    CPPCore::TArray<ui32> mEntityIds;
+    CPPCore::TArray<ui32> mSparse;
+};
+
+template <class T>
+inline TComponentPool<T>::TComponentPool() :
+        mComponents(),
+        mEntityIds(),
+        mSparse() {
+    // empty
+}
+
+template <class T>
+template <class... Args>
+inline T *TComponentPool<T>::add(ui32 entityId, Args &&...args) {
+    if (entityId >= mSparse.size()) {
+        const size_t oldSize = mSparse.size();
+        mSparse.resize(entityId + 1);
+        for (size_t i = oldSize; i < mSparse.size(); ++i) {
+            mSparse[i] = InvalidIndex;
+        }
+    }
+    if (InvalidIndex != mSparse[entityId]) {
+        return &mComponents[mSparse[entityId]];
+    }
+
+    mSparse[entityId] = static_cast<ui32>(mComponents.size());
+    mComponents.emplace_back(std::forward<Args>(args)...);
+    mEntityIds.add(entityId);
+
+    return &mComponents.back();
+}
+
+template <class T>
+inline bool TComponentPool<T>::remove(ui32 entityId) {
+    if (!has(entityId)) {
+        return false;
+    }
+
+    const ui32 index = mSparse[entityId];
+    const ui32 last = static_cast<ui32>(mComponents.size() - 1);
+    if (index != last) {
+        mComponents[index] = std::move(mComponents[last]);
+        mEntityIds[index] = mEntityIds[last];
+        mSparse[mEntityIds[index]] = index;
+    }
+    mComponents.pop_back();
+    mEntityIds.removeBack();
+    mSparse[entityId] = InvalidIndex;
+
+    return true;
+}
+
+template <class T>
+inline T *TComponentPool<T>::get(ui32 entityId) {
+    if (!has(entityId)) {
+        return nullptr;
+    }
+
+    return &mComponents[mSparse[entityId]];
+}
+
+template <class T>
+inline const T *TComponentPool<T>::get(ui32 entityId) const {
+    if (!has(entityId)) {
+        return nullptr;
+    }
+
+    return &mComponents[mSparse[entityId]];
+}
+
+template <class T>
+inline bool TComponentPool<T>::has(ui32 entityId) const {
+    return entityId < mSparse.size() && InvalidIndex != mSparse[entityId];
+}
+
+template <class T>
+inline size_t TComponentPool<T>::size() const {
+    return mComponents.size();
+}
+
+template <class T>
+inline T &TComponentPool<T>::at(size_t index) {
+    osre_assert(index < mComponents.size());
+
+    return mComponents[index];
+}
+
+template <class T>
+inline ui32 TComponentPool<T>::getEntityAt(size_t index) const {
+    osre_assert(index < mEntityIds.size());
+
+    return mEntityIds[index];
+}
+
+template <class T>
+inline void TComponentPool<T>::clear() {
+    mComponents.clear();
+    mEntityIds.clear();
+    mSparse.clear();
+}
+
+template <class T>
+template <class Func>
+inline void TComponentPool<T>::forEach(Func func) {
+    for (T &component : mComponents) {
+        func(component);
+    }
+}
+
+template <class T>
+template <class Func>
+inline void TComponentPool<T>::forEachParallel(size_t chunkSize, Func func) {
+    osre_assert(0 != chunkSize);
+
+    Threading::JobSystem *jobSystem = Threading::JobSystem::getInstance();
+    const size_t numComponents = mComponents.size();
+    if (nullptr == jobSystem || numComponents <= chunkSize) {
+        forEach(func);
+        return;
+    }
+
+    T *components = mComponents.data();
+    jobSystem->parallelFor(numComponents, chunkSize, [components, &func](size_t begin, size_t end) {
+        for (size_t i = begin; i < end; ++i) {
+            func(components[i]);
+        }
+    });
+}
+
+} // Namespace App
+} // Namespace OSRE
@@ -23,6 +23,10 @@ CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
 #pragma once
 
 #include <osre/App/AppCommon.h>
+#include <osre/App/AABBTree.h>
+#include <osre/App/ComponentStorage.h>
+#include <osre/App/Node.h>
+#include <osre/Common/FrustumCuller.h>
 #include <osre/Scene/SceneCommon.h>
 #include <osre/Common/Object.h>
 #include <osre/Common/Ids.h>
@@ -30,6 +34,12 @@ CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
 #include <cppcore/Container/THashMap.h>
 
 namespace OSRE {
+
+namespace Common {
+    class Frustum;
+    class Ray;
+}
+
 namespace App {
 
 class Entity;
@@ -80,8 +90,8 @@ public:
     /// @return A pointer showing to the active view or nullptr, if no view is currently active.
     Camera *getActiveView() const;
 
-    /// @brief Will add a new entity.
-    /// @param entity   The entity to add.
+    /// @brief Will add a new entity, the world takes the ownership.
+    /// @param entity   The entity to add, it must be created for this world. Added ones are ignored.
     void addEntity( Entity *entity );
     
     /// @brief Will remove the entity from the world.
@@ -115,9 +125,41 @@ public:
     /// @brief  Will return the id container.
     /// @return The Id container.    
     const Common::Ids &getIds() const;
-    
+
+    /// @brief  Collects all entities intersecting a box.
+    /// @param  box         [in] The box in world space.
+    /// @param  entities    [out] The found entities will be added.
+    void queryBox(const Common::AABB &box, CPPCore::TArray<Entity *> &entities) const;
+
+    /// @brief  Collects all entities intersecting a sphere.
+    /// @param  center      [in] The center in world space.
+    /// @param  radius      [in] The radius.
+    /// @param  entities    [out] The found entities will be added.
+    void querySphere(const glm::vec3 &center, f32 radius, CPPCore::TArray<Entity *> &entities) const;
+
+    /// @brief  Collects all entities inside or intersecting a frustum.
+    /// @param  frustum     [in] The frustum in world space.
+    /// @param  entities    [out] The found entities will be added.
+    void queryFrustum(const Common::Frustum &frustum, CPPCore::TArray<Entity *> &entities) const;
+
+    /// @brief  Collects all entities hit by a ray.
+    /// @param  ray         [in] The ray in world space.
+    /// @param  maxDistance [in] The length of the ray, in units of its direction.
+    /// @param  entities    [out] The found entities will be added.
+    void queryRay(const Common::Ray &ray, f32 maxDistance, CPPCore::TArray<Entity *> &entities) const;
+
+    /// @brief  Will return the storage of the components of all entities.
+    /// @return The component storage.
+    ComponentStorage &getComponentStorage();
+
+    /// @brief  Will return the bounding tree of all entities.
+    /// @return The bounding tree.
+    const AABBTree &getBoundingTree() const;
+
 protected:
     void updateBoundingTrees();
+    void updateTransforms();
+    void updateProxies();
 
 private:
     CPPCore::TArray<Camera*> mViews;
@@ -127,9 +169,19 @@ private:
     Node *mRoot;
     Common::Ids mIds;
     RenderBackend::Pipeline *mPipeline;
+    ComponentStorage mComponentStorage;
+    AABBTree mBoundingTree;
+    Common::FrustumCuller mCuller;
+    CPPCore::TArray<Entity*> mCullEntities;
+    CPPCore::TArray<ui32> mVisibleEntities;
+    Node::NodeArray mTransformQueue;
     bool mDirtry;
 };
 
+inline ComponentStorage &World::getComponentStorage() {
+    return mComponentStorage;
+}
+
 inline size_t World::getNumCameras() const {
     return mViews.size();
 }
@@ -146,6 +198,10 @@ inline const Common::Ids &World::getIds() const {
     return mIds;
 }
 
+inline const AABBTree &World::getBoundingTree() const {
+    return mBoundingTree;
+}
+
 } // Namespace App
 } // Namespace OSRE
 
@@ -0,0 +1,118 @@
+/*-----------------------------------------------------------------------------------------------
+The MIT License (MIT)
+
+Copyright (c) 2015-2022 OSRE ( Open Source Render Engine ) by Kim Kulling
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of
+this software and associated documentation files (the "Software"), to deal in
+the Software without restriction, including without limitation the rights to
+use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+the Software, and to permit persons to whom the Software is furnished to do so,
+subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+-----------------------------------------------------------------------------------------------*/
+#pragma once
+
+#include <osre/Common/osre_common.h>
+
+#include <map>
+#include <vector>
+
+namespace OSRE {
+namespace Common {
+
+//-------------------------------------------------------------------------------------------------
+///	@ingroup	Engine
+///
+///	@brief  A first-fit free-list allocator for ranges of an external memory block.
+///
+/// The allocator does not own any memory, it only hands out offsets. This way it can manage the
+/// storage of GPU buffers as well. Released ranges are merged with their free neighbours, so the
+/// free list stays short as long as allocations are released in any order.
+//-------------------------------------------------------------------------------------------------
+class OSRE_EXPORT FreeListAllocator {
+public:
+    /// @brief  Will be returned, if a request cannot be served.
+    static const size_t InvalidOffset = ~static_cast<size_t>(0);
+
+    /// @brief  The class constructor.
+    /// @param  capacity    [in] The size of the managed block.
+    explicit FreeListAllocator(size_t capacity = 0);
+
+    /// @brief  The class destructor.
+    ~FreeListAllocator() = default;
+
+    /// @brief  Will release all allocations and set a new capacity.
+    /// @param  capacity    [in] The size of the managed block.
+    void reset(size_t capacity);
+
+    /// @brief  Will allocate a range.
+    /// @param  size        [in] The size of the range.
+    /// @param  alignment   [in] The offset will be a multiple of it, does not need to be a power of two.
+    /// @return The offset of the range or InvalidOffset, if no free range is large enough.
+    size_t alloc(size_t size, size_t alignment = 1);
+
+    /// @brief  Will release a range.
+    /// @param  offset      [in] The offset returned by alloc.
+    /// @return false, if there is no allocation at the offset.
+    bool release(size_t offset);
+
+    /// @brief  Will return the size of the managed block.
+    /// @return The capacity.
+    size_t getCapacity() const;
+
+    /// @brief  Will return the allocated size, including the alignment padding.
+    /// @return The used size.
+    size_t getUsed() const;
+
+    /// @brief  Will return the number of live allocations.
+    /// @return The number of allocations.
+    size_t getNumAllocations() const;
+
+    /// @brief  Will return the number of free ranges, a measure for the fragmentation.
+    /// @return The number of free ranges.
+    size_t getNumFreeRanges() const;
+
+    /// @brief  Will return the size of the largest free range.
+    /// @return The size of the largest free range.
+    size_t getLargestFreeRange() const;
+
+private:
+    struct Range {
+        size_t m_offset;
+        size_t m_size;
+    };
+
+    std::vector<Range> m_freeRanges;
+    std::map<size_t, Range> m_allocations;
+    size_t m_capacity;
+    size_t m_used;
+};
+
+inline size_t FreeListAllocator::getCapacity() const {
+    return m_capacity;
+}
+
+inline size_t FreeListAllocator::getUsed() const {
+    return m_used;
+}
+
+inline size_t FreeListAllocator::getNumAllocations() const {
+    return m_allocations.size();
+}
+
+inline size_t FreeListAllocator::getNumFreeRanges() const {
+    return m_freeRanges.size();
+}
+
+} // Namespace Common
+} // Namespace OSRE
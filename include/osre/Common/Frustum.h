@@ -24,6 +24,7 @@ CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
 
 #include <osre/Common/osre_common.h>
 #include <osre/Common/glm_common.h>
+#include <osre/Common/TAABB.h>
 
 namespace OSRE {
 namespace Common {
@@ -39,10 +40,19 @@ public:
         FarP
     };
 
+    /// @brief  Describes how a volume is located relative to the frustum.
+    enum class Visibility {
+        Outside,
+        Intersecting,
+        Inside
+    };
+
     Frustum();
     ~Frustum() = default;
     bool isIn(glm::vec3 &point);
+    Visibility classify(const AABB &aabb) const;
     void extractFrom(const glm::mat4 &vp);
+    const glm::vec4 &getPlane(ui32 index) const;
     void clear();
 
 private:
@@ -66,18 +76,50 @@ inline bool Frustum::isIn( glm::vec3 &point ) {
     return in;
 }
 
+inline Frustum::Visibility Frustum::classify(const AABB &aabb) const {
+    const glm::vec3 &min = aabb.getMin();
+    const glm::vec3 &max = aabb.getMax();
+    Visibility result = Visibility::Inside;
+    for (const auto &plane : mPlanes) {
+        // Test the corner furthest along the plane normal first, then the nearest one
+        const glm::vec3 pv(plane.x >= 0.0f ? max.x : min.x, plane.y >= 0.0f ? max.y : min.y, plane.z >= 0.0f ? max.z : min.z);
+        if (plane.x * pv.x + plane.y * pv.y + plane.z * pv.z + plane.w < 0.0f) {
+            return Visibility::Outside;
+        }
+
+        const glm::vec3 nv(plane.x >= 0.0f ? min.x : max.x, plane.y >= 0.0f ? min.y : max.y, plane.z >= 0.0f ? min.z : max.z);
+        if (plane.x * nv.x + plane.y * nv.y + plane.z * nv.z + plane.w < 0.0f) {
+            result = Visibility::Intersecting;
+        }
+    }
+
+    return result;
+}
+
 inline void Frustum::extractFrom(const glm::mat4 &vp) {
     glm::vec4 rowX = glm::row(vp, 0);
     glm::vec4 rowY = glm::row(vp, 1);
     glm::vec4 rowZ = glm::row(vp, 2);
     glm::vec4 rowW = glm::row(vp, 3);
 
-    mPlanes[0] = normalize(rowW + rowX);
-    mPlanes[1] = normalize(rowW - rowX);
-    mPlanes[2] = normalize(rowW + rowY);
-    mPlanes[3] = normalize(rowW - rowY);
-    mPlanes[4] = normalize(rowW + rowZ);
-    mPlanes[5] = normalize(rowW - rowZ);
+    mPlanes[0] = rowW + rowX;
+    mPlanes[1] = rowW - rowX;
+    mPlanes[2] = rowW + rowY;
+    mPlanes[3] = rowW - rowY;
+    mPlanes[4] = rowW + rowZ;
+    mPlanes[5] = rowW - rowZ;
+
+    // Scale by the length of the normal, so w is the distance to the origin
+    for (auto &plane : mPlanes) {
+        const f32 len = glm::length(glm::vec3(plane));
+        if (0.0f != len) {
+            plane /= len;
+        }
+    }
+}
+
+inline const glm::vec4 &Frustum::getPlane(ui32 index) const {
+    return mPlanes[index];
 }
 
 inline void Frustum::clear() {
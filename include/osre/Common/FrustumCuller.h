@@ -0,0 +1,89 @@
+/*-----------------------------------------------------------------------------------------------
+The MIT License (MIT)
+
+Copyright (c) 2015-2022 OSRE ( Open Source Render Engine ) by Kim Kulling
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of
+this software and associated documentation files (the "Software"), to deal in
+the Software without restriction, including without limitation the rights to
+use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+the Software, and to permit persons to whom the Software is furnished to do so,
+subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+-----------------------------------------------------------------------------------------------*/
+#pragma once
+
+#include <osre/Common/osre_common.h>
+#include <osre/Common/TAABB.h>
+#include <cppcore/Container/TArray.h>
+
+namespace OSRE {
+namespace Common {
+
+class Frustum;
+
+//-------------------------------------------------------------------------------------------------
+///	@ingroup	Engine
+///
+///	@brief  This class tests many bounding boxes against a frustum at once.
+///
+/// The boxes are stored as a structure of arrays, one array per component. As the plane is the
+/// same for all boxes, the corner to test is picked per plane and not per box, so each plane
+/// costs three multiply-adds and a compare for 8 boxes with AVX respectively 4 boxes with SSE.
+/// The arrays are padded to full blocks with empty boxes, which are never visible.
+//-------------------------------------------------------------------------------------------------
+class OSRE_EXPORT FrustumCuller {
+public:
+    /// @brief  The number of boxes in one block.
+    static const size_t BlockSize = 8;
+
+    /// @brief  The class constructor.
+    FrustumCuller();
+
+    /// @brief  The class destructor.
+    ~FrustumCuller();
+
+    /// @brief  Will add a new box.
+    /// @param  aabb        [in] The bounding box.
+    /// @return The index of the box.
+    size_t add(const AABB &aabb);
+
+    /// @brief  Will replace a box.
+    /// @param  index       [in] The index of the box.
+    /// @param  aabb        [in] The new bounding box.
+    void set(size_t index, const AABB &aabb);
+
+    /// @brief  Will remove all boxes.
+    void clear();
+
+    /// @brief  Returns the number of boxes.
+    /// @return The number of boxes.
+    size_t size() const;
+
+    /// @brief  Collects all boxes inside or intersecting the frustum.
+    /// @param  frustum     [in] The frustum.
+    /// @param  visible     [out] The indices of the visible boxes, in ascending order.
+    /// @return The number of visible boxes.
+    size_t cull(const Frustum &frustum, CPPCore::TArray<ui32> &visible) const;
+
+private:
+    CPPCore::TArray<f32> mMinX, mMinY, mMinZ;
+    CPPCore::TArray<f32> mMaxX, mMaxY, mMaxZ;
+    size_t mNumBoxes;
+};
+
+inline size_t FrustumCuller::size() const {
+    return mNumBoxes;
+}
+
+} // Namespace Common
+} // Namespace OSRE
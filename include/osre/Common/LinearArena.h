@@ -0,0 +1,138 @@
+/*-----------------------------------------------------------------------------------------------
+The MIT License (MIT)
+
+Copyright (c) 2015-2022 OSRE ( Open Source Render Engine ) by Kim Kulling
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of
+this software and associated documentation files (the "Software"), to deal in
+the Software without restriction, including without limitation the rights to
+use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+the Software, and to permit persons to whom the Software is furnished to do so,
+subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+-----------------------------------------------------------------------------------------------*/
+#pragma once
+
+#include <osre/Common/osre_common.h>
+
+#include <new>
+
+namespace OSRE {
+namespace Common {
+
+//-------------------------------------------------------------------------------------------------
+///	@ingroup	Engine
+///
+///	@brief  A bump-pointer arena for short-living allocations.
+///
+/// Memory is carved out linearly from one block and released in one shot by calling reset().
+/// When a request does not fit into the block anymore an overflow block will be allocated. On the
+/// next reset the main block grows to the seen high-water mark, so after a few warm-up cycles no
+/// heap allocation will happen anymore. Objects created in the arena do not get destructed.
+//-------------------------------------------------------------------------------------------------
+class OSRE_EXPORT LinearArena {
+public:
+    /// @brief  The default alignment for allocations.
+    static const size_t DefaultAlignment = 16;
+
+    /// @brief  The class constructor.
+    /// @param  capacity    [in] The initial capacity in bytes.
+    explicit LinearArena(size_t capacity = 0);
+
+    /// @brief  The class destructor.
+    ~LinearArena();
+
+    /// @brief  Ensures that the main block has at least the given size, only allowed when empty.
+    /// @param  capacity    [in] The capacity in bytes.
+    void reserve(size_t capacity);
+
+    /// @brief  Allocates a new block of memory.
+    /// @param  size        [in] The size in bytes.
+    /// @param  alignment   [in] The alignment, must be a power of two.
+    /// @return Pointer to the memory or nullptr if size is zero.
+    void *alloc(size_t size, size_t alignment = DefaultAlignment);
+
+    /// @brief  Allocates a new instance of T in the arena, the destructor will not be called.
+    /// @return The new instance.
+    template <class T>
+    T *create();
+
+    /// @brief  Releases all allocations in one shot.
+    void reset();
+
+    /// @brief  Will release all memory.
+    void clear();
+
+    /// @brief  Returns the number of bytes allocated since the last reset.
+    /// @return The used bytes.
+    size_t getUsed() const;
+
+    /// @brief  Returns the capacity of the main block.
+    /// @return The capacity in bytes.
+    size_t getCapacity() const;
+
+    /// @brief  Returns the largest number of bytes used between two resets.
+    /// @return The high-water mark in bytes.
+    size_t getHighWaterMark() const;
+
+    /// @brief  Returns the number of allocations which did not fit into the main block.
+    /// @return The number of overflow allocations.
+    size_t getNumOverflows() const;
+
+    // Copying is not allowed
+    LinearArena(const LinearArena &) = delete;
+    LinearArena &operator=(const LinearArena &) = delete;
+
+private:
+    struct OverflowBlock {
+        OverflowBlock *m_next;
+    };
+
+    bool releaseOverflow();
+
+    c8 *m_buffer;
+    size_t m_capacity;
+    size_t m_offset;
+    size_t m_used;
+    size_t m_highWaterMark;
+    size_t m_numOverflows;
+    OverflowBlock *m_overflow;
+};
+
+template <class T>
+inline T *LinearArena::create() {
+    void *ptr = alloc(sizeof(T), alignof(T) > DefaultAlignment ? alignof(T) : DefaultAlignment);
+    if (nullptr == ptr) {
+        return nullptr;
+    }
+
+    return new (ptr) T;
+}
+
+inline size_t LinearArena::getUsed() const {
+    return m_used;
+}
+
+inline size_t LinearArena::getCapacity() const {
+    return m_capacity;
+}
+
+inline size_t LinearArena::getHighWaterMark() const {
+    return m_highWaterMark;
+}
+
+inline size_t LinearArena::getNumOverflows() const {
+    return m_numOverflows;
+}
+
+} // Namespace Common
+} // Namespace OSRE
@@ -1,7 +1,7 @@
 /*-----------------------------------------------------------------------------------------------
 The MIT License (MIT)
 
-Copyright (c) 2015-2021 OSRE ( Open Source Render Engine ) by Kim Kulling
+Copyright (c) 2015-2022 OSRE ( Open Source Render Engine ) by Kim Kulling
 
 Permission is hereby granted, free of charge, to any person obtaining a copy of
 this software and associated documentation files (the "Software"), to deal in
@@ -25,69 +25,26 @@ CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
 #include <osre/Common/osre_common.h>
 
 namespace OSRE {
-namespace Collision {
+namespace Common {
 
+/// @brief  One item to sort, the index refers to the payload in the caller's array.
+struct SortItem {
+    ui64 m_key;     ///< The sort key.
+    ui32 m_index;   ///< The index of the payload.
+};
 
 //-------------------------------------------------------------------------------------------------
 ///	@ingroup	Engine
 ///
-///	@brief	
+///	@brief  Sorts the items by their 64-bit key in ascending order.
+///
+/// A stable LSD radix sort with 8-bit digits. Digits, which are the same for all keys, will be
+/// skipped, so keys using only a few bits are cheap to sort.
+/// @param  items       [inout] The items to sort.
+/// @param  tmp         [in]    Scratch buffer, must hold numItems items.
+/// @param  numItems    [in]    The number of items.
 //-------------------------------------------------------------------------------------------------
-template<class T>
-class TQuadTree {
-public:
-    using Rect  = Common::TRect2D<T>;
-    using Point = Common::TPoint2<T>;
-
-    TQuadTree(const Rect& rc);
-    ~TQuadTree();
-    void add(const Point& pt);
-
-private:
-    struct QuadNode {
-        Rect m_rect;
-        QuadNode*m_children[4];
-        
-        QuadNode(const Rect &rc) 
-        : m_rect( rc ) {
-            m_children[0] = m_children[1] = m_children[2] = m_children[3] = nullptr;
-        }
-        
-        QuadNode *isIn(const Point& pt) const {
-            if (m_rect.isIn(pt)) {
-                for (ui32 i = 0; i < 4; ++i) {
-                    if (nullptr != m_children[i]) {
-                        return m_children[i]->isIn(pt);
-                    }
-                }
-                
-                return this;
-            }
-        }
-    };
-
-    QuadNode*m_root;
-};
-
-template<class T>
-inline
-TQuadTree<T>::TQuadTree(const Rect &rc)
-: m_root( nullptr ) {
-    m_root = new Entity(rc);
-}
-
-template<class T>
-inline
-TQuadTree<T>::~TQuadTree() {
-    delete m_root;
-    m_root = nullptr;
-}
+OSRE_EXPORT void radixSort(SortItem *items, SortItem *tmp, size_t numItems);
 
-template<class T>
-inline
-void TQuadTree<T>::add(const Point& pt) {
-
-}
-} // Namespace Collision
+} // Namespace Common
 } // Namespace OSRE
-
@@ -47,10 +47,14 @@ public:
     const glm::vec3 &getMax() const;
     void merge(const glm::vec3 &vec);
     void merge(f32 x, f32 y, f32 z);
+    void merge(const AABB &aabb);
     void updateFromVector3Array(glm::vec3 *vecArray, ui32 numVectors);
     f32 getDiameter() const;
     glm::vec3 getCenter() const;
     bool isIn(const glm::vec3 &pt) const;
+    bool isIn(const AABB &aabb) const;
+    bool intersects(const AABB &aabb) const;
+    f32 getSurfaceArea() const;
     bool operator==(const AABB &rhs) const;
     bool operator!=(const AABB &rhs) const;
 
@@ -120,6 +124,16 @@ inline void AABB::merge(f32 x, f32 y, f32 z) {
     }
 }
 
+inline void AABB::merge(const AABB &aabb) {
+    // An empty box would spread the invalid markers
+    if (aabb.m_min.x > aabb.m_max.x) {
+        return;
+    }
+
+    merge(aabb.m_min);
+    merge(aabb.m_max);
+}
+
 inline void AABB::updateFromVector3Array(glm::vec3 *vecArray, ui32 numVectors) {
     if (nullptr == vecArray || 0 == numVectors) {
         return;
@@ -159,6 +173,29 @@ inline bool AABB::isIn(const glm::vec3 &pt) const {
     return true;
 }
 
+inline bool AABB::isIn(const AABB &aabb) const {
+    return m_min.x <= aabb.m_min.x && m_min.y <= aabb.m_min.y && m_min.z <= aabb.m_min.z &&
+           aabb.m_max.x <= m_max.x && aabb.m_max.y <= m_max.y && aabb.m_max.z <= m_max.z;
+}
+
+inline bool AABB::intersects(const AABB &aabb) const {
+    if (aabb.m_max.x < m_min.x || aabb.m_max.y < m_min.y || aabb.m_max.z < m_min.z) {
+        return false;
+    }
+
+    if (aabb.m_min.x > m_max.x || aabb.m_min.y > m_max.y || aabb.m_min.z > m_max.z) {
+        return false;
+    }
+
+    return true;
+}
+
+inline f32 AABB::getSurfaceArea() const {
+    const glm::vec3 d = m_max - m_min;
+
+    return 2.0f * (d.x * d.y + d.y * d.z + d.z * d.x);
+}
+
 inline bool AABB::operator == (const AABB &rhs) const {
     return (m_max == rhs.m_max && m_min == rhs.m_min);
 }
@@ -0,0 +1,240 @@
+/*-----------------------------------------------------------------------------------------------
+The MIT License (MIT)
+
+Copyright (c) 2015-2022 OSRE ( Open Source Render Engine ) by Kim Kulling
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of
+this software and associated documentation files (the "Software"), to deal in
+the Software without restriction, including without limitation the rights to
+use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+the Software, and to permit persons to whom the Software is furnished to do so,
+subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+-----------------------------------------------------------------------------------------------*/
+#pragma once
+
+#include <osre/Common/Logger.h>
+#include <osre/Common/osre_common.h>
+#include <osre/Debugging/osre_debugging.h>
+
+#include <cppcore/Container/TArray.h>
+
+namespace OSRE {
+namespace Common {
+
+//-------------------------------------------------------------------------------------------------
+///	@ingroup	Engine
+///
+///	@brief  A generational handle table.
+///
+/// Items are stored in a dense array, a handle stores the slot index and the generation of the
+/// slot. Every remove increases the generation of the slot, so a lookup with a handle which was
+/// issued before the remove will be detected as stale. Lookups are O(1), freed slots get reused.
+//-------------------------------------------------------------------------------------------------
+template <class T>
+class THandleTable {
+public:
+    /// @brief  The class constructor.
+    /// @param  reserve     [in] The number of slots to reserve.
+    explicit THandleTable(size_t reserve = 0);
+
+    /// @brief  The class destructor.
+    ~THandleTable() = default;
+
+    /// @brief  Will add a new item.
+    /// @param  item        [in] The item to add.
+    /// @return The handle to the item.
+    Handle add(const T &item);
+
+    /// @brief  Will remove the item, the handle and all copies of it will be stale afterwards.
+    /// @param  handle      [in] The handle of the item.
+    /// @return true if the item was removed, false if the handle was invalid or stale.
+    bool remove(Handle handle);
+
+    /// @brief  Returns true, if the handle points to a living item.
+    /// @param  handle      [in] The handle to check.
+    /// @return true if valid, false if not.
+    bool isValid(Handle handle) const;
+
+    /// @brief  Returns a pointer to the item.
+    /// @param  handle      [in] The handle of the item.
+    /// @return Pointer to the item or nullptr if the handle is invalid or stale.
+    T *get(Handle handle);
+
+    /// @brief  Returns a pointer to the item.
+    /// @param  handle      [in] The handle of the item.
+    /// @return Pointer to the item or nullptr if the handle is invalid or stale.
+    const T *get(Handle handle) const;
+
+    /// @brief  Returns the number of living items.
+    /// @return The number of items.
+    size_t size() const;
+
+    /// @brief  Returns the number of slots, including the free ones.
+    /// @return The number of slots.
+    size_t capacity() const;
+
+    /// @brief  Returns true, if the slot is in use.
+    /// @param  index       [in] The slot index.
+    /// @return true if in use.
+    bool isUsed(size_t index) const;
+
+    /// @brief  Returns the item in the slot, can be used to iterate over all slots.
+    /// @param  index       [in] The slot index.
+    /// @return The item.
+    T &at(size_t index);
+
+    /// @brief  Will remove all items, all handles will be stale afterwards.
+    void clear();
+
+private:
+    bool check(Handle handle) const;
+
+private:
+    CPPCore::TArray<T> m_items;
+    CPPCore::TArray<ui32> m_generations;
+    CPPCore::TArray<uc8> m_used;
+    CPPCore::TArray<ui32> m_freeSlots;
+    size_t m_numItems;
+};
+
+template <class T>
+inline THandleTable<T>::THandleTable(size_t reserve) :
+        m_items(),
+        m_generations(),
+        m_used(),
+        m_freeSlots(),
+        m_numItems(0) {
+    if (0 != reserve) {
+        m_items.reserve(reserve);
+        m_generations.reserve(reserve);
+        m_used.reserve(reserve);
+    }
+}
+
+template <class T>
+inline Handle THandleTable<T>::add(const T &item) {
+    ui32 index = 0;
+    if (m_freeSlots.isEmpty()) {
+        index = static_cast<ui32>(m_items.size());
+        m_items.add(item);
+        m_generations.add(0);
+        m_used.add(1);
+    } else {
+        index = m_freeSlots.back();
+        m_freeSlots.removeBack();
+        m_items[index] = item;
+        m_used[index] = 1;
+    }
+    ++m_numItems;
+
+    return Handle(static_cast<i32>(index), m_generations[index]);
+}
+
+template <class T>
+inline bool THandleTable<T>::remove(Handle handle) {
+    if (!check(handle)) {
+        return false;
+    }
+
+    const ui32 index = static_cast<ui32>(handle.m_idx);
+    m_items[index] = T();
+    m_used[index] = 0;
+    ++m_generations[index];
+    m_freeSlots.add(index);
+    --m_numItems;
+
+    return true;
+}
+
+template <class T>
+inline bool THandleTable<T>::isValid(Handle handle) const {
+    if (!handle.isValid() || static_cast<size_t>(handle.m_idx) >= m_items.size()) {
+        return false;
+    }
+
+    return 0 != m_used[handle.m_idx] && m_generations[handle.m_idx] == handle.m_generation;
+}
+
+template <class T>
+inline bool THandleTable<T>::check(Handle handle) const {
+    const bool valid = isValid(handle);
+#ifdef _DEBUG
+    if (!valid && handle.isValid()) {
+        osre_debug("THandleTable", "Access with a stale or unknown handle.");
+    }
+#endif
+    return valid;
+}
+
+template <class T>
+inline T *THandleTable<T>::get(Handle handle) {
+    if (!check(handle)) {
+        return nullptr;
+    }
+
+    return &m_items[handle.m_idx];
+}
+
+template <class T>
+inline const T *THandleTable<T>::get(Handle handle) const {
+    if (!check(handle)) {
+        return nullptr;
+    }
+
+    return &m_items[handle.m_idx];
+}
+
+template <class T>
+inline size_t THandleTable<T>::size() const {
+    return m_numItems;
+}
+
+template <class T>
+inline size_t THandleTable<T>::capacity() const {
+    return m_items.size();
+}
+
+template <class T>
+inline bool THandleTable<T>::isUsed(size_t index) const {
+    if (index >= m_used.size()) {
+        return false;
+    }
+
+    return 0 != m_used[index];
+}
+
+template <class T>
+inline T &THandleTable<T>::at(size_t index) {
+    osre_assert(index < m_items.size());
+
+    return m_items[index];
+}
+
+template <class T>
+inline void THandleTable<T>::clear() {
+    // Keep the generations, so old handles stay detectable as stale
+    m_freeSlots.clear();
+    for (size_t i = m_items.size(); i > 0; --i) {
+        const size_t index = i - 1;
+        if (0 != m_used[index]) {
+            m_items[index] = T();
+            m_used[index] = 0;
+            ++m_generations[index];
+        }
+        m_freeSlots.add(static_cast<ui32>(index));
+    }
+    m_numItems = 0;
+}
+
+} // Namespace Common
+} // Namespace OSRE
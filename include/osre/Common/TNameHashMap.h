@@ -0,0 +1,240 @@
+/*-----------------------------------------------------------------------------------------------
+The MIT License (MIT)
+
+Copyright (c) 2015-2022 OSRE ( Open Source Render Engine ) by Kim Kulling
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of
+this software and associated documentation files (the "Software"), to deal in
+the Software without restriction, including without limitation the rights to
+use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+the Software, and to permit persons to whom the Software is furnished to do so,
+subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+-----------------------------------------------------------------------------------------------*/
+#pragma once
+
+#include <osre/Common/StringUtils.h>
+#include <osre/Common/osre_common.h>
+
+#include <cppcore/Container/TArray.h>
+#include <cppcore/Container/THashMap.h>
+
+namespace OSRE {
+namespace Common {
+
+//-------------------------------------------------------------------------------------------------
+///	@ingroup	Engine
+///
+///	@brief  A map which stores items by their name.
+///
+/// The lookup uses the hash of the name. All names with the same hash share one bucket, and the
+/// names in the bucket are compared. So two names with the same hash can be stored both.
+//-------------------------------------------------------------------------------------------------
+template <class T>
+class TNameHashMap {
+public:
+    /// @brief  The class constructor.
+    TNameHashMap();
+
+    /// @brief  The class destructor.
+    ~TNameHashMap();
+
+    /// @brief  Will add a new item.
+    /// @param  name        [in] The name of the item.
+    /// @param  value       [in] The item.
+    /// @return true if added, false if the name is empty or there is an item with this name.
+    bool insert(const String &name, const T &value);
+
+    /// @brief  Returns true, if there is an item with this name.
+    /// @param  name        [in] The name.
+    /// @return true if found.
+    bool hasKey(const String &name) const;
+
+    /// @brief  Returns the item with this name.
+    /// @param  name        [in] The name.
+    /// @param  value       [out] The item.
+    /// @return true if found, false if not.
+    bool getValue(const String &name, T &value) const;
+
+    /// @brief  Will remove the item with this name.
+    /// @param  name        [in] The name.
+    /// @return true if removed, false if not found.
+    bool remove(const String &name);
+
+    /// @brief  Returns the number of items.
+    /// @return The number of items.
+    size_t size() const;
+
+    /// @brief  Will remove all items.
+    void clear();
+
+    // Copying is not allowed
+    TNameHashMap(const TNameHashMap &) = delete;
+    TNameHashMap &operator=(const TNameHashMap &) = delete;
+
+private:
+    struct Entry {
+        String mName;
+        T mValue;
+    };
+
+    struct Bucket {
+        HashId mHash;
+        size_t mIndex;
+        CPPCore::TArray<Entry> mEntries;
+    };
+
+    Bucket *findBucket(const String &name) const;
+    bool findEntry(const String &name, Bucket *&bucket, size_t &index) const;
+
+private:
+    CPPCore::THashMap<HashId, Bucket *> mLookup;
+    CPPCore::TArray<Bucket *> mBuckets;
+    size_t mNumItems;
+};
+
+template <class T>
+inline TNameHashMap<T>::TNameHashMap() :
+        mLookup(),
+        mBuckets(),
+        mNumItems(0) {
+    // empty
+}
+
+template <class T>
+inline TNameHashMap<T>::~TNameHashMap() {
+    clear();
+}
+
+template <class T>
+inline bool TNameHashMap<T>::insert(const String &name, const T &value) {
+    if (name.empty()) {
+        return false;
+    }
+
+    Bucket *bucket = nullptr;
+    size_t index = 0;
+    if (findEntry(name, bucket, index)) {
+        return false;
+    }
+
+    if (nullptr == bucket) {
+        bucket = new Bucket;
+        bucket->mHash = StringUtils::hashName(name);
+        bucket->mIndex = mBuckets.size();
+        mBuckets.add(bucket);
+        mLookup.insert(bucket->mHash, bucket);
+    }
+
+    Entry entry;
+    entry.mName = name;
+    entry.mValue = value;
+    bucket->mEntries.add(entry);
+    ++mNumItems;
+
+    return true;
+}
+
+template <class T>
+inline bool TNameHashMap<T>::hasKey(const String &name) const {
+    Bucket *bucket = nullptr;
+    size_t index = 0;
+
+    return findEntry(name, bucket, index);
+}
+
+template <class T>
+inline bool TNameHashMap<T>::getValue(const String &name, T &value) const {
+    Bucket *bucket = nullptr;
+    size_t index = 0;
+    if (!findEntry(name, bucket, index)) {
+        return false;
+    }
+    value = bucket->mEntries[index].mValue;
+
+    return true;
+}
+
+template <class T>
+inline bool TNameHashMap<T>::remove(const String &name) {
+    Bucket *bucket = nullptr;
+    size_t index = 0;
+    if (!findEntry(name, bucket, index)) {
+        return false;
+    }
+
+    bucket->mEntries.remove(index);
+    --mNumItems;
+    if (!bucket->mEntries.isEmpty()) {
+        return true;
+    }
+
+    // Move the last bucket into the free slot
+    Bucket *last = mBuckets.back();
+    mBuckets[bucket->mIndex] = last;
+    last->mIndex = bucket->mIndex;
+    mBuckets.removeBack();
+    mLookup.remove(bucket->mHash);
+    delete bucket;
+
+    return true;
+}
+
+template <class T>
+inline size_t TNameHashMap<T>::size() const {
+    return mNumItems;
+}
+
+template <class T>
+inline void TNameHashMap<T>::clear() {
+    for (size_t i = 0; i < mBuckets.size(); ++i) {
+        delete mBuckets[i];
+    }
+    mBuckets.clear();
+    mLookup.clear();
+    mNumItems = 0;
+}
+
+template <class T>
+inline typename TNameHashMap<T>::Bucket *TNameHashMap<T>::findBucket(const String &name) const {
+    Bucket *bucket = nullptr;
+    if (!mLookup.getValue(StringUtils::hashName(name), bucket)) {
+        return nullptr;
+    }
+
+    return bucket;
+}
+
+template <class T>
+inline bool TNameHashMap<T>::findEntry(const String &name, Bucket *&bucket, size_t &index) const {
+    bucket = nullptr;
+    if (name.empty()) {
+        return false;
+    }
+
+    bucket = findBucket(name);
+    if (nullptr == bucket) {
+        return false;
+    }
+
+    for (size_t i = 0; i < bucket->mEntries.size(); ++i) {
+        if (bucket->mEntries[i].mName == name) {
+            index = i;
+            return true;
+        }
+    }
+
+    return false;
+}
+
+} // Namespace Common
+} // Namespace OSRE
@@ -25,6 +25,10 @@ CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
 #include <osre/Common/Object.h>
 #include <osre/Common/osre_common.h>
 #include <osre/IO/Uri.h>
+#include <osre/Threading/JobSystem.h>
+
+#include <atomic>
+#include <thread>
 
 namespace OSRE {
 namespace Common {
@@ -41,6 +45,7 @@ struct ResourceStatistics {
 enum class ResourceState {
     Uninitialized,
     Unloaded,
+    Loading,    ///< The resource is loaded in the background.
     Loaded,
     Error
 };
@@ -49,12 +54,21 @@ template <class TResType, class TResLoader>
 class TResource : public Object {
 public:
     TResource(const String &name, const IO::Uri &uri);
-    virtual ~TResource() = default;
+    /// The loaded instance is owned by the resource, derived classes release its content.
+    virtual ~TResource();
     void setUri(const IO::Uri &uri);
     const IO::Uri &getUri() const;
     ResourceState getState() const;
     virtual ResourceState load(TResLoader &loader);
     virtual ResourceState unload(TResLoader &loader);
+    /// Will start loading in the background, the default implementation loads at once.
+    virtual ResourceState loadAsync();
+    /// Will wait while the resource is loading, the calling thread executes pending jobs meanwhile.
+    ResourceState waitForLoad() const;
+    /// Will return the memory of the loaded resource, 0 as long as it is not loaded.
+    size_t getMemory() const;
+    /// Will return true while the loaded instance is used outside of the cache, it will not be evicted then.
+    virtual bool isInUse() const;
     TResType *get();
 
 protected:
@@ -65,7 +79,7 @@ protected:
     virtual ResourceState onUnload(TResLoader &loader) = 0;
 
 private:
-    ResourceState m_state;
+    std::atomic<ResourceState> m_state;
     ResourceStatistics m_stats;
     IO::Uri m_uri;
     TResType *m_res;
@@ -81,6 +95,12 @@ inline TResource<TResType, TResLoader>::TResource(const String &name, const IO::
     // empty
 }
 
+template <class TResType, class TResLoader>
+inline TResource<TResType, TResLoader>::~TResource() {
+    delete m_res;
+    m_res = nullptr;
+}
+
 template <class TResType, class TResLoader>
 inline void TResource<TResType, TResLoader>::setUri(const IO::Uri &uri) {
     if (m_uri == uri) {
@@ -97,7 +117,7 @@ inline const IO::Uri &TResource<TResType, TResLoader>::getUri() const {
 
 template <class TResType, class TResLoader>
 inline ResourceState TResource<TResType, TResLoader>::getState() const {
-    return m_state;
+    return m_state.load(std::memory_order_acquire);
 }
 
 template <class TResType, class TResLoader>
@@ -126,9 +146,39 @@ inline ResourceState TResource<TResType, TResLoader>::unload(TResLoader &loader)
     return onUnload(loader);
 }
 
+template <class TResType, class TResLoader>
+inline ResourceState TResource<TResType, TResLoader>::loadAsync() {
+    TResLoader loader;
+    return load(loader);
+}
+
+template <class TResType, class TResLoader>
+inline ResourceState TResource<TResType, TResLoader>::waitForLoad() const {
+    // The load job may still be queued, so help instead of blocking
+    Threading::JobSystem *jobSystem = Threading::JobSystem::getInstance();
+    while (ResourceState::Loading == getState()) {
+        if (nullptr == jobSystem || !jobSystem->executeNext()) {
+            std::this_thread::yield();
+        }
+    }
+
+    return getState();
+}
+
+template <class TResType, class TResLoader>
+inline size_t TResource<TResType, TResLoader>::getMemory() const {
+    // The statistics are written by the loading thread before the state is published
+    return ResourceState::Loaded == getState() ? m_stats.m_memory : 0;
+}
+
+template <class TResType, class TResLoader>
+inline bool TResource<TResType, TResLoader>::isInUse() const {
+    return false;
+}
+
 template <class TResType, class TResLoader>
 inline void TResource<TResType, TResLoader>::setState(ResourceState newState) {
-    m_state = newState;
+    m_state.store(newState, std::memory_order_release);
 }
 
 } // Namespace Common
@@ -24,8 +24,13 @@ CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
 
 #include <osre/Common/Logger.h>
 #include <osre/Common/osre_common.h>
+#include <osre/Common/TNameHashMap.h>
+#include <osre/Common/TResource.h>
 #include <osre/IO/Uri.h>
-#include <map>
+
+#include <cppcore/Container/TArray.h>
+
+#include <mutex>
 
 namespace OSRE {
 
@@ -58,26 +63,96 @@ inline TResource *TResourceFactory<TResource>::create(const String &name, const
     return res;
 }
 
+//-------------------------------------------------------------------------------------------------
+///	@ingroup	Engine
+///
+///	@brief  This class implements a thread-safe cache for resources, keyed by the name.
+///
+/// The name is looked up by its hash, resources whose names have the same hash are chained and
+/// their names are compared.
+/// create and find work for any type. acquire, release and trim need a TResource, they add
+/// reference counting, asynchronous loading and a memory budget: acquire starts loading the
+/// resource and keeps it alive until it is released. Resources without references are kept in
+/// least recently used order and will be deleted as soon as the memory of all resources exceeds
+/// the budget. Resources which are still loading or still used outside the cache (see
+/// TResource::isInUse) will never be deleted, and neither clear nor the destructor may be called
+/// while any resource is loading.
+//-------------------------------------------------------------------------------------------------
 template <class TResourceFactory, class TResource>
 class TResourceCache {
 public:
+    /// @brief  The budget used by default, no eviction at all.
+    static const size_t NoBudget = ~static_cast<size_t>(0);
+
     TResourceCache();
     ~TResourceCache();
     void registerFactory(TResourceFactory &factory, bool owning);
+    /// Will create a new resource, an existing one with the same name will be returned.
     TResource *create(const String &name, const IO::Uri &uri = IO::Uri());
+    /// Will return the resource without adding a reference, it may be evicted later.
     TResource *find(const String &name) const;
+    /// Will return the resource with a new reference, it is created and its loading is started if needed.
+    TResource *acquire(const String &name, const IO::Uri &uri = IO::Uri());
+    /// Will remove a reference, the resource will be kept until it is evicted.
+    bool release(TResource *resource);
+    /// Will return the number of references of the resource.
+    ui32 getRefCount(const String &name) const;
+    /// Will delete unreferenced resources until the budget is met, returns the number of deleted resources.
+    size_t trim();
+    void setMemoryBudget(size_t budget);
+    size_t getMemoryBudget() const;
+    /// Will return the memory of all resources, as counted by the last acquire, release or trim.
+    size_t getMemoryUsage() const;
+    size_t getNumResources() const;
     void clear();
 
 private:
-    using ResourceMap = std::map<String, TResource*>;
-    ResourceMap m_resourceMap;
+    struct Entry {
+        String mName;
+        TResource *mResource;
+        ui32 mRefCount;
+        size_t mMemory;
+        size_t mIndex;
+        bool mPending;
+        bool mLoadRequested;
+        bool mInLru;
+        Entry *mLruPrev;
+        Entry *mLruNext;
+    };
+
+    Entry *findEntry(const String &name) const;
+    Entry *createEntry(const String &name, const IO::Uri &uri);
+    void destroyEntry(Entry *entry);
+    void pushLru(Entry *entry);
+    void removeLru(Entry *entry);
+    void updateMemory(Entry &entry);
+    size_t trimLocked();
+
+private:
+    mutable std::mutex m_lock;
+    TNameHashMap<Entry *> m_resourceMap;
+    CPPCore::TArray<Entry *> m_entries;
+    Entry *m_lruHead;
+    Entry *m_lruTail;
+    CPPCore::TArray<Entry *> m_pending;
+    size_t m_budget;
+    size_t m_memory;
     TResourceFactory *m_factory;
     bool m_owner;
 };
 
 template <class TResourceFactory, class TResource>
 inline TResourceCache<TResourceFactory, TResource>::TResourceCache() :
-        m_resourceMap(), m_factory(new TResourceFactory), m_owner(true) {
+        m_lock(),
+        m_resourceMap(),
+        m_entries(),
+        m_lruHead(nullptr),
+        m_lruTail(nullptr),
+        m_pending(),
+        m_budget(NoBudget),
+        m_memory(0),
+        m_factory(new TResourceFactory),
+        m_owner(true) {
     // empty
 }
 
@@ -92,6 +167,7 @@ inline TResourceCache<TResourceFactory, TResource>::~TResourceCache() {
 
 template <class TResourceFactory, class TResource>
 inline void TResourceCache<TResourceFactory, TResource>::registerFactory(TResourceFactory &factory, bool owning) {
+    std::lock_guard<std::mutex> lock(m_lock);
     if (nullptr != m_factory) {
         if (m_owner) {
             delete m_factory;
@@ -103,14 +179,103 @@ inline void TResourceCache<TResourceFactory, TResource>::registerFactory(TResour
 }
 
 template <class TResourceFactory, class TResource>
-inline TResource *TResourceCache<TResourceFactory, TResource>::create(const String &name, const IO::Uri &uri) {
+inline typename TResourceCache<TResourceFactory, TResource>::Entry *
+TResourceCache<TResourceFactory, TResource>::findEntry(const String &name) const {
+    Entry *entry = nullptr;
+    if (!m_resourceMap.getValue(name, entry)) {
+        return nullptr;
+    }
+
+    return entry;
+}
+
+template <class TResourceFactory, class TResource>
+inline typename TResourceCache<TResourceFactory, TResource>::Entry *
+TResourceCache<TResourceFactory, TResource>::createEntry(const String &name, const IO::Uri &uri) {
+    Entry *entry = findEntry(name);
+    if (nullptr != entry) {
+        return entry;
+    }
+
     TResource *resource = m_factory->create(name, uri);
     if (nullptr == resource) {
         return nullptr;
     }
-    m_resourceMap[name] = resource;
 
-    return resource;
+    entry = new Entry;
+    entry->mName = name;
+    entry->mResource = resource;
+    entry->mRefCount = 0;
+    entry->mMemory = 0;
+    entry->mIndex = m_entries.size();
+    entry->mPending = false;
+    entry->mLoadRequested = false;
+    entry->mInLru = false;
+    entry->mLruPrev = nullptr;
+    entry->mLruNext = nullptr;
+    m_entries.add(entry);
+    m_resourceMap.insert(name, entry);
+
+    // A new resource has no reference, so it is the most recently used candidate for eviction
+    pushLru(entry);
+
+    return entry;
+}
+
+template <class TResourceFactory, class TResource>
+inline void TResourceCache<TResourceFactory, TResource>::destroyEntry(Entry *entry) {
+    if (entry->mInLru) {
+        removeLru(entry);
+    }
+    m_resourceMap.remove(entry->mName);
+
+    // Move the last entry into the free slot
+    Entry *last = m_entries.back();
+    m_entries[entry->mIndex] = last;
+    last->mIndex = entry->mIndex;
+    m_entries.removeBack();
+
+    m_memory -= entry->mMemory;
+    delete entry->mResource;
+    delete entry;
+}
+
+template <class TResourceFactory, class TResource>
+inline void TResourceCache<TResourceFactory, TResource>::pushLru(Entry *entry) {
+    entry->mLruPrev = nullptr;
+    entry->mLruNext = m_lruHead;
+    if (nullptr != m_lruHead) {
+        m_lruHead->mLruPrev = entry;
+    } else {
+        m_lruTail = entry;
+    }
+    m_lruHead = entry;
+    entry->mInLru = true;
+}
+
+template <class TResourceFactory, class TResource>
+inline void TResourceCache<TResourceFactory, TResource>::removeLru(Entry *entry) {
+    if (nullptr != entry->mLruPrev) {
+        entry->mLruPrev->mLruNext = entry->mLruNext;
+    } else {
+        m_lruHead = entry->mLruNext;
+    }
+    if (nullptr != entry->mLruNext) {
+        entry->mLruNext->mLruPrev = entry->mLruPrev;
+    } else {
+        m_lruTail = entry->mLruPrev;
+    }
+    entry->mLruPrev = nullptr;
+    entry->mLruNext = nullptr;
+    entry->mInLru = false;
+}
+
+template <class TResourceFactory, class TResource>
+inline TResource *TResourceCache<TResourceFactory, TResource>::create(const String &name, const IO::Uri &uri) {
+    std::lock_guard<std::mutex> lock(m_lock);
+    Entry *entry = createEntry(name, uri);
+
+    return nullptr != entry ? entry->mResource : nullptr;
 }
 
 template <class TResourceFactory, class TResource>
@@ -119,21 +284,176 @@ inline TResource *TResourceCache<TResourceFactory, TResource>::find(const String
         return nullptr;
     }
 
-    typename ResourceMap::const_iterator it = m_resourceMap.find(name);
-    if (m_resourceMap.end() == it) {
+    std::lock_guard<std::mutex> lock(m_lock);
+    const Entry *entry = findEntry(name);
+
+    return nullptr != entry ? entry->mResource : nullptr;
+}
+
+template <class TResourceFactory, class TResource>
+inline TResource *TResourceCache<TResourceFactory, TResource>::acquire(const String &name, const IO::Uri &uri) {
+    if (name.empty()) {
         return nullptr;
     }
 
-    return it->second;
+    TResource *resource = nullptr;
+    bool startLoad = false;
+    {
+        std::lock_guard<std::mutex> lock(m_lock);
+        Entry *entry = createEntry(name, uri);
+        if (nullptr == entry) {
+            return nullptr;
+        }
+
+        resource = entry->mResource;
+        if (0 == entry->mRefCount++ && entry->mInLru) {
+            removeLru(entry);
+        }
+
+        // Only the first caller starts loading, the memory is counted by trim as soon as the load is done
+        const ResourceState state = resource->getState();
+        if ((ResourceState::Uninitialized == state || ResourceState::Unloaded == state) && !entry->mLoadRequested) {
+            entry->mLoadRequested = true;
+            startLoad = true;
+        }
+        if (ResourceState::Loaded != state && !entry->mPending) {
+            m_pending.add(entry);
+            entry->mPending = true;
+        }
+        updateMemory(*entry);
+    }
+    if (!startLoad) {
+        return resource;
+    }
+
+    // Without a job system loading is synchronous, so it must not block the other users of the
+    // cache. The reference keeps the resource alive meanwhile.
+    resource->loadAsync();
+
+    std::lock_guard<std::mutex> lock(m_lock);
+    Entry *entry = findEntry(name);
+    if (nullptr != entry) {
+        updateMemory(*entry);
+    }
+
+    return resource;
+}
+
+template <class TResourceFactory, class TResource>
+inline bool TResourceCache<TResourceFactory, TResource>::release(TResource *resource) {
+    if (nullptr == resource) {
+        return false;
+    }
+
+    std::lock_guard<std::mutex> lock(m_lock);
+    Entry *entry = findEntry(resource->getName());
+    if (nullptr == entry || entry->mResource != resource || 0 == entry->mRefCount) {
+        osre_debug(ResTag, "Resource " + resource->getName() + " is not referenced.");
+        return false;
+    }
+
+    updateMemory(*entry);
+    if (0 == --entry->mRefCount) {
+        pushLru(entry);
+        trimLocked();
+    }
+
+    return true;
+}
+
+template <class TResourceFactory, class TResource>
+inline ui32 TResourceCache<TResourceFactory, TResource>::getRefCount(const String &name) const {
+    std::lock_guard<std::mutex> lock(m_lock);
+    const Entry *entry = findEntry(name);
+
+    return nullptr != entry ? entry->mRefCount : 0;
+}
+
+template <class TResourceFactory, class TResource>
+inline void TResourceCache<TResourceFactory, TResource>::updateMemory(Entry &entry) {
+    const size_t memory = entry.mResource->getMemory();
+    m_memory = m_memory - entry.mMemory + memory;
+    entry.mMemory = memory;
+}
+
+template <class TResourceFactory, class TResource>
+inline size_t TResourceCache<TResourceFactory, TResource>::trim() {
+    std::lock_guard<std::mutex> lock(m_lock);
+
+    return trimLocked();
+}
+
+template <class TResourceFactory, class TResource>
+inline size_t TResourceCache<TResourceFactory, TResource>::trimLocked() {
+    // Count the resources which finished loading since they were acquired
+    for (size_t i = 0; i < m_pending.size();) {
+        // The state is read first, a loaded resource has its final memory. A resource may still be
+        // waiting for the start of its load, which happens outside of the lock.
+        Entry *entry = m_pending[i];
+        const ResourceState state = entry->mResource->getState();
+        updateMemory(*entry);
+        if (ResourceState::Loaded != state && ResourceState::Error != state) {
+            ++i;
+            continue;
+        }
+        entry->mPending = false;
+        entry->mLoadRequested = false;
+        m_pending[i] = m_pending.back();
+        m_pending.removeBack();
+    }
+
+    // Evict the least recently used ones first, pending ones are still referenced by the list above
+    size_t numEvicted = 0;
+    Entry *entry = m_lruTail;
+    while (m_memory > m_budget && nullptr != entry) {
+        Entry *prev = entry->mLruPrev;
+        if (!entry->mPending && ResourceState::Loading != entry->mResource->getState() && !entry->mResource->isInUse()) {
+            destroyEntry(entry);
+            ++numEvicted;
+        }
+        entry = prev;
+    }
+
+    return numEvicted;
+}
+
+template <class TResourceFactory, class TResource>
+inline void TResourceCache<TResourceFactory, TResource>::setMemoryBudget(size_t budget) {
+    std::lock_guard<std::mutex> lock(m_lock);
+    m_budget = budget;
+}
+
+template <class TResourceFactory, class TResource>
+inline size_t TResourceCache<TResourceFactory, TResource>::getMemoryBudget() const {
+    std::lock_guard<std::mutex> lock(m_lock);
+    return m_budget;
+}
+
+template <class TResourceFactory, class TResource>
+inline size_t TResourceCache<TResourceFactory, TResource>::getMemoryUsage() const {
+    std::lock_guard<std::mutex> lock(m_lock);
+    return m_memory;
+}
+
+template <class TResourceFactory, class TResource>
+inline size_t TResourceCache<TResourceFactory, TResource>::getNumResources() const {
+    std::lock_guard<std::mutex> lock(m_lock);
+    return m_entries.size();
 }
 
 template <class TResourceFactory, class TResource>
 inline void TResourceCache<TResourceFactory, TResource>::clear() {
-    typename ResourceMap::iterator it(m_resourceMap.begin());
-    for (; it != m_resourceMap.end(); ++it) {
-        delete it->second;
+    std::lock_guard<std::mutex> lock(m_lock);
+    for (size_t i = 0; i < m_entries.size(); ++i) {
+        delete m_entries[i]->mResource;
+        delete m_entries[i];
     }
+    m_entries.clear();
     m_resourceMap.clear();
+    m_lruHead = nullptr;
+    m_lruTail = nullptr;
+    m_pending.clear();
+    m_memory = 0;
 }
 
 } // Namespace Common
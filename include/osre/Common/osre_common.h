@@ -151,22 +151,24 @@ using String = std::string;
 using StringArray = ::CPPCore::TArray<String>;
 
 
-/// @brief  A handle struct.
+/// @brief  A handle struct, the generation is used to detect stale handles.
 struct Handle {
     static constexpr i32 Invalid = -1;
     
     i32 m_idx;
+    ui32 m_generation;
 
-    Handle() : m_idx(Invalid) {
+    Handle() : m_idx(Invalid), m_generation(0) {
         // empty
     }
 
-    explicit Handle(i32 idx) {
-        init(idx);
+    explicit Handle(i32 idx, ui32 generation = 0) {
+        init(idx, generation);
     }
 
-    void init(i32 idx) {
+    void init(i32 idx, ui32 generation = 0) {
         m_idx = idx;
+        m_generation = generation;
     }
 
     bool isValid() const {
@@ -174,7 +176,7 @@ struct Handle {
     }
 
     bool operator == (const Handle &rhs) const {
-        return m_idx == rhs.m_idx;
+        return m_idx == rhs.m_idx && m_generation == rhs.m_generation;
     }
 
     bool operator != (const Handle &rhs) const {
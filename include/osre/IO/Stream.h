@@ -48,7 +48,8 @@ public:
         ReadAccessBinary,       ///< Read-access in binary mode.
         WriteAccessBinary,      ///< Write-access in binary mode.
         ReadWriteAccess,        ///< Read/Write-access.
-        AppendAccess            ///< Append-access, stuff will be attached and the file end.
+        AppendAccess,           ///< Append-access, stuff will be attached and the file end.
+        ReadAccessMapped        ///< Read-access, the whole file is mapped into memory.
     };
 
     /// @brief  Enumerates the requested file position
@@ -94,6 +95,10 @@ public:
     /// @return true, if map operation is supported.
     virtual bool canBeMapped() const;
 
+    /// @brief  Returns the whole content as a memory location, only valid while the stream is open.
+    /// @return The mapped content, nullptr if the stream cannot be mapped.
+    virtual const void *map();
+
     /// @brief  Set the current request mode.
     /// @param  accessMode      [in] The new access mode.
     virtual void setAccessMode( AccessMode accessMode );
@@ -63,6 +63,10 @@ public:
     ///	@param	rMemInUse			[ out ] The memory in use in percent.
     static void getMemoryStatus( ui32 &rTotalPhysicMem, ui32 &rMemInUse );
 
+    ///	@brief	Returns the number of logical CPU cores.
+    ///	@return	The number of cores, at least one.
+    static ui32 getNumCPUCores();
+
 
     static bool registerThreadName( const ThreadId &id, const String &name );
     static bool unregisterThreadName( const ThreadId &id );
@@ -24,6 +24,7 @@ CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
 
 #include <osre/Profiling/ProfilingCommon.h>
 #include <cppcore/Container/THashMap.h>
+#include <cppcore/Container/TArray.h>
 
 namespace OSRE {
 namespace Profiling {
@@ -33,6 +34,10 @@ namespace Profiling {
 ///
 ///	@brief  This class is used to set performance counters like FPS. You can register your own 
 /// counters as well.
+///
+/// All methods are guarded by one lock, the render thread and the application thread can 
+/// register, set and query counters concurrently. The registry is created and destroyed by the 
+/// render back-end service outside of the render thread.
 //-------------------------------------------------------------------------------------------------
 class OSRE_EXPORT PerformanceCounterRegistry {
 public:
@@ -73,6 +78,7 @@ private:
     };
     static PerformanceCounterRegistry *s_instance;
     CPPCore::THashMap<ui32, CounterMeasure*> m_counters;
+    CPPCore::TArray<CounterMeasure*> m_measures;
 };
 
 } // Namespace Profiling
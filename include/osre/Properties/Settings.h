@@ -52,7 +52,7 @@ public:
         AppVersionMinor,        ///< The application minor version.
         AppVersionPatch,        ///< The application version, patch level.
         WindowsTitle,			///< The title of the main window.
-        RenderAPI,				///< The requested render API.
+        RenderAPI,				///< The requested render API ( opengl, vulkan or null ).
         WinX,					///< The x coordinate of the upper left window point.
         WinY,					///< The y coordinate of the upper left window point.
         WinWidth,				///< The width of the window.
@@ -69,6 +69,7 @@ public:
         DefaultFont,            ///< The default font for rendering.
         RenderMode,             ///< The requested render mode (2D or 3D, default 3D).
         PluginDllName,          ///< The name for the child application.
+        FramesInFlight,         ///< The number of pipelined render frames, 1 for lockstep rendering.
         MaxKonfigKey			///< The upper limit.
     };
 
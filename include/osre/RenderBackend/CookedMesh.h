@@ -0,0 +1,82 @@
+/*-----------------------------------------------------------------------------------------------
+The MIT License (MIT)
+
+Copyright (c) 2015-2022 OSRE ( Open Source Render Engine ) by Kim Kulling
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of
+this software and associated documentation files (the "Software"), to deal in
+the Software without restriction, including without limitation the rights to
+use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+the Software, and to permit persons to whom the Software is furnished to do so,
+subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+-----------------------------------------------------------------------------------------------*/
+#pragma once
+
+#include <osre/RenderBackend/RenderCommon.h>
+
+#include <cppcore/Container/TArray.h>
+
+namespace OSRE {
+
+namespace IO {
+    class Stream;
+}
+
+namespace RenderBackend {
+
+//-------------------------------------------------------------------------------------------------
+///	@ingroup	Engine
+///
+///	@brief  This class reads and writes meshes in the cooked binary format.
+///
+/// A cooked file starts with a header, followed by one fixed-size entry per mesh and the data
+/// sections: names, vertex streams, index streams and primitive groups. Every section starts at a
+/// 16-byte aligned offset. The entries contain the vertex and index layout, the bounding box, the
+/// model matrix and the name of the material. The buffers are stored in their render layout, so
+/// loading a mesh is a bulk copy per buffer and needs no work per vertex.
+//-------------------------------------------------------------------------------------------------
+class OSRE_EXPORT CookedMesh {
+public:
+    /// @brief  The magic number at the start of each file, "OSMC".
+    static const ui32 Magic = 0x434d534f;
+
+    /// @brief  The current format version, files with another version are rejected.
+    static const ui32 Version = 1;
+
+    /// @brief  The alignment of all sections in bytes.
+    static const size_t Alignment = 16;
+
+    /// @brief  Will write meshes into a stream.
+    /// @param  meshes          [in] The meshes to write.
+    /// @param  stream          [in] The stream, must be open for binary writing.
+    /// @return true if successful, false in case of an error.
+    static bool save(const MeshArray &meshes, IO::Stream &stream);
+
+    /// @brief  Will read meshes from a stream, mapped streams will be read without a copy.
+    /// @param  stream          [in] The stream, must be open for reading.
+    /// @param  meshes          [out] The new meshes will be added.
+    /// @param  materialRefs    [out] The material name per loaded mesh will be added, optional.
+    /// @return true if successful, false in case of an error.
+    static bool load(IO::Stream &stream, MeshArray &meshes, CPPCore::TArray<String> *materialRefs = nullptr);
+
+    /// @brief  Will read meshes from a memory location containing a cooked file.
+    /// @param  data            [in] The file content.
+    /// @param  size            [in] The size of the file content in bytes.
+    /// @param  meshes          [out] The new meshes will be added.
+    /// @param  materialRefs    [out] The material name per loaded mesh will be added, optional.
+    /// @return true if successful, false in case of an error.
+    static bool load(const uc8 *data, size_t size, MeshArray &meshes, CPPCore::TArray<String> *materialRefs = nullptr);
+};
+
+} // Namespace RenderBackend
+} // Namespace OSRE
@@ -0,0 +1,91 @@
+/*-----------------------------------------------------------------------------------------------
+The MIT License (MIT)
+
+Copyright (c) 2015-2022 OSRE ( Open Source Render Engine ) by Kim Kulling
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of
+this software and associated documentation files (the "Software"), to deal in
+the Software without restriction, including without limitation the rights to
+use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+the Software, and to permit persons to whom the Software is furnished to do so,
+subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+-----------------------------------------------------------------------------------------------*/
+#pragma once
+
+#include <osre/RenderBackend/RenderCommon.h>
+
+namespace OSRE {
+
+namespace IO {
+    class Stream;
+}
+
+namespace RenderBackend {
+
+//-------------------------------------------------------------------------------------------------
+///	@ingroup	Engine
+///
+///	@brief  This class reads and writes textures in the cooked binary format.
+///
+/// A cooked file starts with a header, followed by one entry per mip level and the level data.
+/// Every level starts at a 16-byte aligned offset and is stored in the upload layout of its pixel
+/// format, so the mip chain is computed once when cooking and loading needs no decoding at all.
+/// The texture gets all levels tightly packed, starting with the largest one.
+//-------------------------------------------------------------------------------------------------
+class OSRE_EXPORT CookedTexture {
+public:
+    /// @brief  The magic number at the start of each file, "OSTC".
+    static const ui32 Magic = 0x4354534f;
+
+    /// @brief  The current format version, files with another version are rejected.
+    static const ui32 Version = 1;
+
+    /// @brief  The alignment of all levels in bytes.
+    static const size_t Alignment = 16;
+
+    /// @brief  The file extension of cooked textures.
+    static const c8 *Extension;
+
+    /// @brief  Will encode an image with its complete mip chain into a stream. The rows are stored
+    ///         as given, so the image must already be flipped for OpenGL.
+    /// @param  pixels      [in] The pixels, 8 bit per channel.
+    /// @param  width       [in] The width in pixels.
+    /// @param  height      [in] The height in pixels.
+    /// @param  channels    [in] The number of channels, 1 to 4.
+    /// @param  format      [in] The target format, R8G8B8, R8G8B8A8 or a format which can be encoded.
+    /// @param  stream      [in] The stream, must be open for binary writing.
+    /// @return true if successful, false in case of an error.
+    static bool cook(const uc8 *pixels, ui32 width, ui32 height, ui32 channels, PixelFormatType format, IO::Stream &stream);
+
+    /// @brief  Will write a texture with all its mip levels into a stream.
+    /// @param  tex         [in] The texture to write.
+    /// @param  stream      [in] The stream, must be open for binary writing.
+    /// @return true if successful, false in case of an error.
+    static bool save(const Texture &tex, IO::Stream &stream);
+
+    /// @brief  Will read a texture from a stream, mapped streams will be read without a copy.
+    /// @param  stream      [in] The stream, must be open for reading.
+    /// @param  tex         [out] The texture to fill, the data is released by the TextureLoader.
+    /// @return true if successful, false in case of an error.
+    static bool load(IO::Stream &stream, Texture &tex);
+
+    /// @brief  Will read a texture from a memory location containing a cooked file.
+    /// @param  data        [in] The file content.
+    /// @param  size        [in] The size of the file content in bytes.
+    /// @param  tex         [out] The texture to fill, the data is released by the TextureLoader.
+    /// @return true if successful, false in case of an error.
+    static bool load(const uc8 *data, size_t size, Texture &tex);
+};
+
+} // Namespace RenderBackend
+} // Namespace OSRE
@@ -1,6 +1,7 @@
 #pragma once
 
 #include <osre/Common/osre_common.h>
+#include <osre/Common/TResourceCache.h>
 #include <osre/IO/Uri.h>
 #include <cppcore/Container/TArray.h>
 #include <osre/RenderBackend/Shader.h>
@@ -35,6 +36,7 @@ enum class MaterialColorType : ui32 {
 };
 
 using TextureResourceArray = CPPCore::TArray<RenderBackend::TextureResource *>;
+using TextureResourceCache = Common::TResourceCache<Common::TResourceFactory<TextureResource>, TextureResource>;
 
 static constexpr ui32 MaxMatColorType = static_cast<ui32>(MaterialColorType::NumMaterialColorTypes);
 
@@ -46,6 +48,8 @@ public:
     MaterialType m_type;
     size_t m_numTextures;
     Texture **m_textures;
+    TextureResourceArray m_texResources;    ///< The referenced texture resources, released with the material.
+    TextureResourceCache *m_texCache;       ///< The cache holding the texture resources.
     Shader *m_shader;
     ui32 m_numParameters;
     UniformVar *m_parameters;
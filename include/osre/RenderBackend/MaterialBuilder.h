@@ -38,7 +38,8 @@ namespace RenderBackend {
 class OSRE_EXPORT MaterialBuilder {
 public:
     /// @brief Will create the material builder instance.
-    static void create();
+    /// @param  texCache    The cache for the texture resources, an own one is used for nullptr.
+    static void create(TextureResourceCache *texCache = nullptr);
 
     /// @brief Will destroy the material builder instance.
     static void destroy();
@@ -50,7 +51,8 @@ public:
         
     /// @brief  Will create the texture material instance.
     /// @param  matName      The name for the material.
-    /// @param  texResArray  The array with all textures to use.
+    /// @param  texResArray  The array with all textures to use. They describe the textures by name and
+    ///                      uri, the material references the ones of the texture cache.
     /// @param  type         The vertex type.
     /// @return The created instance will be returned.
     static RenderBackend::Material* createTexturedMaterial(const String& matName, RenderBackend::TextureResourceArray& texResArray, 
@@ -58,7 +60,7 @@ public:
     
     /// @brief  Will create the texture material instance with your own shader code.
     /// @param  matName      The name for the material.
-    /// @param  texResArray  The array with all textures to use.
+    /// @param  texResArray  The array with all textures to use, see above.
     /// @param  VsSrc        The vertex shader source.
     /// @param  FsSrc        The fragment shader source.
     /// @return The created instance will be returned.
@@ -76,10 +78,15 @@ private:
     ///	@brief The class destructor.
     ~MaterialBuilder();
 
+    /// Will reference the textures from the texture cache and assign them to the material.
+    static void acquireTextures(RenderBackend::Material *mat, RenderBackend::TextureResourceArray &texResArray);
+
 private:
     using MaterialFactory = Common::TResourceFactory<RenderBackend::Material>;
     using MaterialCache = Common::TResourceCache<MaterialFactory, RenderBackend::Material>;
     static MaterialCache *s_materialCache;
+    static TextureResourceCache *s_texCache;
+    static bool s_ownsTexCache;
 };
 
 } // Namespace RenderBackend
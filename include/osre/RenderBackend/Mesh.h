@@ -23,6 +23,7 @@ CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
 #pragma once
 
 #include <osre/Common/glm_common.h>
+#include <osre/Common/TAABB.h>
 #include <osre/RenderBackend/RenderCommon.h>
 
 #include <cppcore/Container/TArray.h>
@@ -63,6 +64,7 @@ public:
         } else {
             mVertexBuffer->attach(vertices, size);
         }
+        mAabbDirty = true;
     }
 
     template <class T>
@@ -79,7 +81,41 @@ public:
     void addPrimitiveGroup(size_t numIndices, PrimitiveType primTypes, ui32 startIndex);
     void addPrimitiveGroup(PrimitiveGroup *group);
 
-    
+    /// @brief  Marks a byte range of the vertex buffer as modified, it gets merged with former ranges.
+    /// @param  offset  [in] The offset in bytes.
+    /// @param  size    [in] The size in bytes.
+    void markVertexRangeDirty(size_t offset, size_t size);
+
+    /// @brief  Will return true, if a modified range was marked since the last update.
+    /// @return true for a modified range.
+    bool hasDirtyVertexRange() const;
+
+    /// @brief  Will return the offset of the modified range.
+    /// @return The offset in bytes.
+    size_t getDirtyVertexOffset() const;
+
+    /// @brief  Will return the size of the modified range.
+    /// @return The size in bytes, 0 if nothing was marked.
+    size_t getDirtyVertexSize() const;
+
+    /// @brief  Will reset the modified range, called when the update was submitted.
+    void clearDirtyVertexRange();
+
+    /// @brief  Will store the bounding box of the vertex data.
+    /// @param  aabb    [in] The bounding box.
+    void setAABB(const Common::AABB &aabb);
+
+    /// @brief  Will return the cached bounding box, only valid when it is not dirty.
+    /// @return The bounding box.
+    const Common::AABB &getAABB() const;
+
+    /// @brief  Will return true, if the vertex data was changed since the bounding box was stored.
+    /// @return true for a bounding box which needs to get recomputed.
+    bool isAABBDirty() const;
+
+    /// @brief  Will mark the bounding box as outdated, needed after direct writes to the vertex buffer.
+    void invalidateAABB();
+
     OSRE_NON_COPYABLE(Mesh)
 
 private:
@@ -97,6 +133,10 @@ private:
     ::CPPCore::TArray<uc8> mVertexData;
     ::CPPCore::TArray<uc8> mIndexData;
     ui32 mLastIndex;
+    size_t mDirtyBegin;
+    size_t mDirtyEnd;
+    Common::AABB mAabb;
+    bool mAabbDirty;
 };
 
 inline void Mesh::setMaterial(Material *mat) {
@@ -157,5 +197,39 @@ inline bool Mesh::isLocal() const {
     return m_localMatrix;
 }
 
+inline bool Mesh::hasDirtyVertexRange() const {
+    return mDirtyEnd > mDirtyBegin;
+}
+
+inline size_t Mesh::getDirtyVertexOffset() const {
+    return hasDirtyVertexRange() ? mDirtyBegin : 0;
+}
+
+inline size_t Mesh::getDirtyVertexSize() const {
+    return hasDirtyVertexRange() ? mDirtyEnd - mDirtyBegin : 0;
+}
+
+inline void Mesh::clearDirtyVertexRange() {
+    mDirtyBegin = 0;
+    mDirtyEnd = 0;
+}
+
+inline void Mesh::setAABB(const Common::AABB &aabb) {
+    mAabb = aabb;
+    mAabbDirty = false;
+}
+
+inline const Common::AABB &Mesh::getAABB() const {
+    return mAabb;
+}
+
+inline bool Mesh::isAABBDirty() const {
+    return mAabbDirty;
+}
+
+inline void Mesh::invalidateAABB() {
+    mAabbDirty = true;
+}
+
 } // Namespace RenderBackend
 } // Namespace OSRE
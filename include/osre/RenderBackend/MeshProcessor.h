@@ -35,16 +35,27 @@ namespace RenderBackend {
 //-------------------------------------------------------------------------------------------------
 ///	@ingroup	Engine
 ///
-///	@brief
+///	@brief  Computes the bounding box of a set of meshes. The box of each mesh is cached in the
+/// mesh and will only be computed again when its vertex data was changed.
 //-------------------------------------------------------------------------------------------------
 class OSRE_EXPORT MeshProcessor : public Common::AbstractProcessor {
 public:
+    /// @brief  Meshes with more vertices than this will be split across the job system workers.
+    static constexpr size_t ParallelThreshold = 128 * 1024;
+
     MeshProcessor();
     ~MeshProcessor();
     bool execute() override;
     void addMesh( RenderBackend::Mesh *geo );
     const Common::AABB &getAABB() const;
 
+    /// @brief  Will merge the positions of a strided vertex stream into a bounding box.
+    /// @param  vertices    [in] The vertex data, the position must be the first component.
+    /// @param  numVertices [in] The number of vertices.
+    /// @param  stride      [in] The distance between two vertices in bytes.
+    /// @param  aabb        [inout] The bounding box to merge into.
+    static void computeAABB(const uc8 *vertices, size_t numVertices, size_t stride, Common::AABB &aabb);
+
 private:
     void handleMesh( RenderBackend::Mesh *mesh );
 
@@ -28,6 +28,7 @@ CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
 #include <osre/RenderBackend/Pipeline.h>
 #include <osre/RenderBackend/RenderCommon.h>
 #include <osre/Threading/SystemTask.h>
+#include <osre/Threading/Fence.h>
 #include <osre/Common/glm_common.h>
 
 namespace OSRE {
@@ -129,6 +130,31 @@ struct OSRE_EXPORT CommitFrameEventData : Common::EventData {
     Frame *m_frame;
 };
 
+//-------------------------------------------------------------------------------------------------
+///	@ingroup	Engine
+///
+///	@brief  Describes the frame to render. The render task signals the frame fence after the
+/// event was handled, this will release the frame slot for the submitting thread. The render
+/// back-end may call setRendered to report the latency.
+//-------------------------------------------------------------------------------------------------
+struct OSRE_EXPORT RenderFrameEventData : Common::EventData {
+    RenderFrameEventData() :
+            EventData(OnRenderFrameEvent, nullptr),
+            m_frameNumber(0),
+            m_submitTime(0),
+            m_latency(0) {
+        // empty
+    }
+
+    /// @brief  Will store the frame latency.
+    void setRendered() const;
+
+    ui64 m_frameNumber;
+    i64 m_submitTime;
+    /// The latency in microseconds, valid for the submitting thread once the fence was signaled.
+    mutable i64 m_latency;
+};
+
 //-------------------------------------------------------------------------------------------------
 ///	@ingroup	Engine
 ///
@@ -157,6 +183,9 @@ struct OSRE_EXPORT ResizeEventData : Common::EventData {
 //-------------------------------------------------------------------------------------------------
 class OSRE_EXPORT RenderBackendService : public Common::AbstractService {
 public:
+    /// @brief  The upper limit for pipelined frames, @see Settings::FramesInFlight.
+    static constexpr ui32 MaxFramesInFlight = 3;
+
     /// @brief  The class constructor.
     RenderBackendService();
 
@@ -217,6 +246,23 @@ public:
 
     void updateMesh(Mesh *mesh);
 
+    /// @brief  Will show or hide an already added mesh, a hidden mesh stays resident but is not drawn.
+    /// @param  mesh        [in] The mesh.
+    /// @param  visible     [in] true to draw the mesh, false to skip it.
+    void setMeshVisible(Mesh *mesh, bool visible);
+
+    /// @brief  Will set the transforms for a range of instances of the active batch.
+    /// @param  first       [in] The index of the first instance.
+    /// @param  count       [in] The number of transforms.
+    /// @param  transforms  [in] The transforms, only the modified range will be uploaded.
+    void setInstanceTransforms(ui32 first, ui32 count, const glm::mat4 *transforms);
+
+    /// @brief  Will set the colors for a range of instances of the active batch.
+    /// @param  first       [in] The index of the first instance.
+    /// @param  count       [in] The number of colors.
+    /// @param  colors      [in] The colors, only the modified range will be uploaded.
+    void setInstanceColors(ui32 first, ui32 count, const glm::vec4 *colors);
+
     bool endRenderBatch();
 
     bool endPass();
@@ -233,6 +279,10 @@ public:
 
     void syncRenderThread();
 
+    /// @brief  Returns the number of frames which can be in flight, 1 means lockstep rendering.
+    /// @return The number of frames in flight.
+    ui32 getNumFramesInFlight() const;
+
     void setViewport(ui32 x, ui32 y, ui32 w, ui32 h);
 
     const Viewport &getViewport() const;
@@ -247,21 +297,35 @@ protected:
     /// @brief  The update callback.
     bool onUpdate() override;
 
+    /// @brief  Waits until the next frame slot is not in flight anymore and resets it.
+    void acquireNextFrame();
+
     /// @brief  All render passes will be initialized
     void initPasses();
 
     /// @brief  Will apply all used parameters
     void commitNextFrame();
 
+    /// @brief  Will wait until the render back-end has finished all submitted frames.
+    void awaitFramesInFlight();
+
+    /// @brief  Will update the frame latency counter with the last finished frame.
+    void publishFrameLatency();
+
 private:
     Threading::SystemTaskPtr m_renderTaskPtr;
     const Properties::Settings *m_settings;
     Viewport mViewport;
     bool m_ownsSettingsConfig;
+    bool m_ownsCounterRegistry;
     bool m_frameCreated;
-    Frame m_frames[2];
-    Frame *m_renderFrame;
+    Frame m_frames[MaxFramesInFlight + 1];
+    CommitFrameEventData m_commitFrameData[MaxFramesInFlight + 1];
+    RenderFrameEventData m_renderFrameData[MaxFramesInFlight + 1];
     Frame *m_submitFrame;
+    ui32 m_numFramesInFlight;
+    ui64 m_frameNumber;
+    Threading::Fence m_frameFence;
     bool m_dirty;
     CPPCore::TArray<PassData*> m_passes;
     PassData *m_currentPass;
@@ -278,5 +342,9 @@ inline void RenderBackendService::enableAutoResizing( bool enabled ) {
     mBehaviour.ResizeViewport = enabled;
 }
 
+inline ui32 RenderBackendService::getNumFramesInFlight() const {
+    return m_numFramesInFlight;
+}
+
 } // Namespace RenderBackend
 } // Namespace OSRE
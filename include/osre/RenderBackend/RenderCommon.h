@@ -23,6 +23,7 @@ CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
 #pragma once
 
 #include <osre/Common/TResource.h>
+#include <osre/Common/LinearArena.h>
 #include <osre/RenderBackend/Shader.h>
 #include <osre/Common/osre_common.h>
 #include <osre/Debugging/osre_debugging.h>
@@ -34,6 +35,8 @@ CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
 #include <cppcore/Container/TStaticArray.h>
 #include <cppcore/Memory/TPoolAllocator.h>
 
+#include <atomic>
+
 namespace OSRE {
 namespace RenderBackend {
 
@@ -82,6 +85,12 @@ enum class PixelFormatType {
     InvaliTextureType=-1,   ///< Marker for an invalid texture.
     R8G8B8 = 0,             ///< 24 bit data, r, g, b
     R8G8B8A8,               ///< 32 bit data, r, g, b, a
+    BC1,                    ///< Block compressed, 4 bit per pixel, r, g, b
+    BC3,                    ///< Block compressed, 8 bit per pixel, r, g, b, a
+    BC5,                    ///< Block compressed, 8 bit per pixel, r, g
+    BC7,                    ///< Block compressed, 8 bit per pixel, r, g, b, a
+    ETC2_RGB8,              ///< ETC2 compressed, 4 bit per pixel, r, g, b
+    ETC2_RGBA8,             ///< ETC2 compressed, 8 bit per pixel, r, g, b, a
     NumPixelFormatTypes     ///< The number of formats
 };
 
@@ -181,6 +190,10 @@ enum class ParameterType {
     PT_Float2Array,
     PT_Float3,
     PT_Float3Array,
+    PT_Float4,
+    PT_Float4Array,
+    PT_Mat3,
+    PT_Mat3Array,
     PT_Mat4,
     PT_Mat4Array,
 
@@ -205,6 +218,7 @@ enum class VertexAttribute : int {
     Instance1, ///< "instance1"
     Instance2, ///< "instance2"
     Instance3, ///< "instance3"
+    InstanceColor, ///< "instancecolor"
     NumVertexAttrs, ///< Number of enums.
 
     InvalidVertexAttr ///< Enum for invalid enum.
@@ -284,6 +298,22 @@ struct OSRE_EXPORT UIVert {
     static const String *getAttributes();
 };
 
+///	@brief  This struct declares the per-instance data of an instanced draw call. The columns of
+/// the transform and the color are fetched once per instance.
+struct OSRE_EXPORT InstanceVert {
+    glm::mat4 transform; ///< The model transform ( instance0..instance3 )
+    glm::vec4 color; ///< The instance color ( r|g|b|a )
+
+    InstanceVert();
+    ~InstanceVert() = default;
+
+    /// @brief  Returns the number of attributes.
+    static size_t getNumAttributes();
+
+    /// @brief  Returns the attribute array.
+    static const String *getAttributes();
+};
+
 ///	@brief  Utility function for calculate the vertex format size.
 inline size_t getVertexFormatSize(VertexFormat format) {
     ui32 size(0);
@@ -427,7 +457,13 @@ struct OSRE_EXPORT Texture {
     ui32 m_width;
     ui32 m_height;
     ui32 m_channels;
+    /// The number of mip levels in m_data, tightly packed and starting with the largest one.
+    ui32 mNumMipLevels;
     Handle m_texHandle;
+    /// The streaming state, textures filled by hand are loaded at once.
+    std::atomic<Common::ResourceState> mState;
+    /// The number of render back-end users waiting for the data, the texture is not evicted meanwhile.
+    std::atomic<ui32> mUseCount;
 
     Texture();
     ~Texture();
@@ -443,21 +479,34 @@ public:
     size_t load(const IO::Uri &uri, Texture *tex);
     bool unload(Texture *tex);
     static RenderBackend::Texture *getDefaultTexture();
+    /// Will flip the image rows in place, OpenGL expects the first row at the bottom.
+    static void flipVertical(uc8 *data, ui32 width, ui32 height, ui32 channels);
 };
 
 ///	@brief  This class is used to represent a texture resource.
 class OSRE_EXPORT TextureResource : public Common::TResource<Texture, TextureLoader> {
 public:
     TextureResource(const String &name, const IO::Uri &uri);
-    ~TextureResource() override = default;
+    /// The decoded image is released by the loader, it must not be loading anymore.
+    ~TextureResource() override;
     void setTargetType(TextureTargetType targetType);
     TextureTargetType getTargetType() const;
     void setTextureStage(TextureStageType stage);
     TextureStageType setTextureStage() const;
+    /// Will decode the texture on the job system. The texture is created at once and stays
+    /// in the Loading state until the decoded image is published, the resource must be kept
+    /// alive until then. Without a job system the texture is loaded synchronously.
+    Common::ResourceState loadAsync() override;
+    /// Will return true while the render back-end still reads the texture data.
+    bool isInUse() const override;
 
 protected:
     Common::ResourceState onLoad(const IO::Uri &uri, TextureLoader &loader) override;
     Common::ResourceState onUnload(TextureLoader &loader) override;
+    void setState(Common::ResourceState newState) override;
+
+private:
+    static void onLoadJob(void *data);
 
 private:
     TextureTargetType m_targetType;
@@ -694,12 +743,13 @@ struct MeshEntry {
     CPPCore::TArray<Mesh*> mMeshArray;
 };
 
-struct RenderBatchData {
+struct OSRE_EXPORT RenderBatchData {
     enum DirtyMode {
         MatrixBufferDirty = 1,
         UniformBufferDirty = 2,
         MeshDirty = 4,
-        MeshUpdateDirty = 8
+        MeshUpdateDirty = 8,
+        InstanceDataDirty = 16
     };
 
     const c8 *m_id;
@@ -707,6 +757,9 @@ struct RenderBatchData {
     CPPCore::TArray<UniformVar *> m_uniforms;
     CPPCore::TArray<MeshEntry *> m_meshArray;
     CPPCore::TArray<Mesh *> m_updateMeshArray;
+    CPPCore::TArray<InstanceVert> m_instances;
+    size_t m_instanceDirtyBegin;
+    size_t m_instanceDirtyEnd;
     ui32 m_dirtyFlag;
 
     RenderBatchData(const c8 *id) :
@@ -715,14 +768,62 @@ struct RenderBatchData {
             m_uniforms(),
             m_meshArray(),
             m_updateMeshArray(),
+            m_instances(),
+            m_instanceDirtyBegin(0),
+            m_instanceDirtyEnd(0),
             m_dirtyFlag(0) {
         osre_assert(id != nullptr);
     }
 
     MeshEntry *getMeshEntryByName(const c8 *name);
     UniformVar *getVarByName(const c8 *name);
+
+    /// @brief  Will set the transforms for a range of instances, the stream grows when needed.
+    /// @param  first       [in] The first instance to modify.
+    /// @param  count       [in] The number of instances to modify.
+    /// @param  transforms  [in] The new transforms.
+    void setInstanceTransforms(size_t first, size_t count, const glm::mat4 *transforms);
+
+    /// @brief  Will set the colors for a range of instances, the stream grows when needed.
+    /// @param  first       [in] The first instance to modify.
+    /// @param  count       [in] The number of instances to modify.
+    /// @param  colors      [in] The new colors.
+    void setInstanceColors(size_t first, size_t count, const glm::vec4 *colors);
+
+    /// @brief  Returns true, if instances were modified since the last commit.
+    bool hasDirtyInstances() const;
+
+    /// @brief  Returns the first modified instance.
+    size_t getDirtyInstanceOffset() const;
+
+    /// @brief  Returns the number of modified instances.
+    size_t getDirtyInstanceCount() const;
+
+    /// @brief  Will clear the modified instance range after the commit.
+    void clearDirtyInstances();
+
+private:
+    void growInstances(size_t numInstances);
+    void markInstancesDirty(size_t first, size_t count);
 };
 
+inline bool RenderBatchData::hasDirtyInstances() const {
+    return m_instanceDirtyEnd > m_instanceDirtyBegin;
+}
+
+inline size_t RenderBatchData::getDirtyInstanceOffset() const {
+    return hasDirtyInstances() ? m_instanceDirtyBegin : 0;
+}
+
+inline size_t RenderBatchData::getDirtyInstanceCount() const {
+    return hasDirtyInstances() ? m_instanceDirtyEnd - m_instanceDirtyBegin : 0;
+}
+
+inline void RenderBatchData::clearDirtyInstances() {
+    m_instanceDirtyBegin = 0;
+    m_instanceDirtyEnd = 0;
+}
+
 struct PassData {
     const c8 *m_id;
     FrameBuffer *m_renderTarget;
@@ -784,15 +885,19 @@ struct FrameSubmitCmd {
         UpdateBuffer = 2,
         UpdateMatrixes = 4,
         UpdateUniforms = 8,
-        AddRenderData = 16
+        AddRenderData = 16,
+        UpdateInstances = 32,
+        UpdateVisibility = 64
     };
 
     guid m_meshId;
     const c8 *m_passId;
     const c8 *m_batchId;
     ui32 m_updateFlags;
+    size_t m_offset;
     size_t m_size;
     c8 *m_data;
+    bool m_visible;
     ::CPPCore::TArray<MeshEntry*> m_newMeshes;
     ::CPPCore::TArray<PassData*> m_updatedPasses;
 
@@ -801,15 +906,15 @@ struct FrameSubmitCmd {
             m_passId(nullptr),
             m_batchId(nullptr),
             m_updateFlags(0),
+            m_offset(0),
             m_size(0),
             m_data(nullptr),
+            m_visible(true),
             m_newMeshes() {
         // empty
     }
 };
 
-using FrameSubmitCmdAllocator = ::CPPCore::TPoolAllocator<FrameSubmitCmd>;
-
 struct UniformBuffer {
     UniformBuffer() :
             m_numvars(0),
@@ -860,6 +965,51 @@ struct UniformBuffer {
         write((c8 *)var->m_data.getData(), var->m_data.m_size);
     }
 
+    /// @brief  Will return the size of an encoded variable: info, name and data.
+    static size_t getEncodedSize(const UniformVar *var) {
+        if (nullptr == var) {
+            return 0;
+        }
+
+        return sizeof(ui32) + var->m_name.size() + var->m_data.m_size;
+    }
+
+    /// @brief  Will encode a variable into the given memory, returns the number of written bytes.
+    static size_t encodeVar(const UniformVar *var, c8 *dest) {
+        if (nullptr == var || nullptr == dest) {
+            return 0;
+        }
+
+        const ui32 varInfo = encode((ui16)var->m_name.size(), (ui16)var->m_data.m_size);
+        ::memcpy(dest, &varInfo, sizeof(ui32));
+        size_t offset = sizeof(ui32);
+        ::memcpy(&dest[offset], var->m_name.c_str(), var->m_name.size());
+        offset += var->m_name.size();
+        ::memcpy(&dest[offset], var->m_data.getData(), var->m_data.m_size);
+
+        return offset + var->m_data.m_size;
+    }
+
+    /// @brief  Will decode one variable, returns the number of read bytes or 0 for a truncated entry.
+    static size_t decodeVar(const c8 *src, size_t size, String &name, const c8 *&data, ui16 &dataLen) {
+        if (nullptr == src || size < sizeof(ui32)) {
+            return 0;
+        }
+
+        ui32 varInfo = 0;
+        ::memcpy(&varInfo, src, sizeof(ui32));
+        ui16 nameLen = 0;
+        decode(varInfo, nameLen, dataLen);
+        const size_t encodedSize = sizeof(ui32) + nameLen + dataLen;
+        if (encodedSize > size) {
+            return 0;
+        }
+        name.assign(&src[sizeof(ui32)], nameLen);
+        data = &src[sizeof(ui32) + nameLen];
+
+        return encodedSize;
+    }
+
     void readVar(c8 *id, size_t &size, c8 *data) {
         ui32 varInfo = 0;
         read((c8 *)&varInfo, sizeof(ui32));
@@ -893,10 +1043,11 @@ struct UniformBuffer {
     MemoryBuffer m_buffer;
 };
 
+/// @brief  Stores all submit commands of one frame, commands and payloads live in the frame arena.
 struct Frame {
     ::CPPCore::TArray<PassData *> m_newPasses;
     ::CPPCore::TArray<FrameSubmitCmd*> m_submitCmds;
-    FrameSubmitCmdAllocator m_submitCmdAllocator;
+    Common::LinearArena m_arena;
     UniformBuffer *m_uniforBuffers;
     Pipeline *m_pipeline;
 
@@ -904,6 +1055,10 @@ struct Frame {
     ~Frame();
     void init(::CPPCore::TArray<PassData *> &newPasses);
     FrameSubmitCmd *enqueue();
+    /// @brief  Allocates payload memory, valid until the next reset.
+    c8 *alloc(size_t size);
+    /// @brief  Releases all commands and payloads in one shot.
+    void reset();
 
     Frame(const Frame &) = delete;
     Frame(Frame &&) = delete;
@@ -0,0 +1,104 @@
+/*-----------------------------------------------------------------------------------------------
+The MIT License (MIT)
+
+Copyright (c) 2015-2022 OSRE ( Open Source Render Engine ) by Kim Kulling
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of
+this software and associated documentation files (the "Software"), to deal in
+the Software without restriction, including without limitation the rights to
+use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+the Software, and to permit persons to whom the Software is furnished to do so,
+subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+-----------------------------------------------------------------------------------------------*/
+#pragma once
+
+#include <osre/RenderBackend/RenderCommon.h>
+
+namespace OSRE {
+namespace RenderBackend {
+
+//-------------------------------------------------------------------------------------------------
+///	@ingroup	Engine
+///
+///	@brief  This class provides the block compressed texture formats.
+///
+/// All compressed formats store blocks of 4x4 pixels, images with a size which is not a multiple
+/// of four are padded to whole blocks. BC1, BC3 and BC5 can be encoded and decoded on the CPU, the
+/// encoder uses the bounding box of each block as the endpoints. BC7 and ETC2 are passed through
+/// to the GPU only, they have to be encoded by an external tool.
+//-------------------------------------------------------------------------------------------------
+class OSRE_EXPORT TextureCompression {
+public:
+    /// @brief  Returns true, if the pixel format is a block compressed format.
+    /// @param  format      [in] The pixel format.
+    /// @return true if compressed, false if not.
+    static bool isCompressed(PixelFormatType format);
+
+    /// @brief  Returns the size of one 4x4 block in bytes.
+    /// @param  format      [in] The pixel format.
+    /// @return The block size, 0 for formats which are not compressed.
+    static ui32 getBlockSize(PixelFormatType format);
+
+    /// @brief  Returns the size of one image in bytes.
+    /// @param  format      [in] The pixel format.
+    /// @param  width       [in] The width in pixels.
+    /// @param  height      [in] The height in pixels.
+    /// @return The size of the image.
+    static size_t getImageSize(PixelFormatType format, ui32 width, ui32 height);
+
+    /// @brief  Returns the number of levels of a complete mip chain, down to 1x1.
+    /// @param  width       [in] The width of the first level.
+    /// @param  height      [in] The height of the first level.
+    /// @return The number of levels.
+    static ui32 getNumMipLevels(ui32 width, ui32 height);
+
+    /// @brief  Returns true, if images can be encoded into the format on the CPU.
+    /// @param  format      [in] The pixel format.
+    /// @return true if supported, false if not.
+    static bool canEncode(PixelFormatType format);
+
+    /// @brief  Returns true, if images in the format can be decoded on the CPU.
+    /// @param  format      [in] The pixel format.
+    /// @return true if supported, false if not.
+    static bool canDecode(PixelFormatType format);
+
+    /// @brief  Will encode an image, BC5 stores the first two channels.
+    /// @param  format      [in] The compressed format.
+    /// @param  pixels      [in] The pixels, 8 bit per channel.
+    /// @param  width       [in] The width in pixels.
+    /// @param  height      [in] The height in pixels.
+    /// @param  channels    [in] The number of channels, 1 to 4.
+    /// @param  blocks      [out] The compressed image, must have the size of getImageSize.
+    /// @return true if successful, false in case of an error.
+    static bool encode(PixelFormatType format, const uc8 *pixels, ui32 width, ui32 height, ui32 channels, uc8 *blocks);
+
+    /// @brief  Will decode an image into 8 bit RGBA.
+    /// @param  format      [in] The compressed format.
+    /// @param  blocks      [in] The compressed image.
+    /// @param  width       [in] The width in pixels.
+    /// @param  height      [in] The height in pixels.
+    /// @param  rgba        [out] The pixels, must have the size of width * height * 4.
+    /// @return true if successful, false in case of an error.
+    static bool decode(PixelFormatType format, const uc8 *blocks, ui32 width, ui32 height, uc8 *rgba);
+
+    /// @brief  Will compute the next mip level with a box filter.
+    /// @param  pixels      [in] The pixels, 8 bit per channel.
+    /// @param  width       [in] The width in pixels.
+    /// @param  height      [in] The height in pixels.
+    /// @param  channels    [in] The number of channels.
+    /// @param  target      [out] The half sized image, at least one pixel in each direction.
+    static void downsample(const uc8 *pixels, ui32 width, ui32 height, ui32 channels, uc8 *target);
+};
+
+} // Namespace RenderBackend
+} // Namespace OSRE
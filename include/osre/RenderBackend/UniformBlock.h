@@ -0,0 +1,222 @@
+/*-----------------------------------------------------------------------------------------------
+The MIT License (MIT)
+
+Copyright (c) 2015-2022 OSRE ( Open Source Render Engine ) by Kim Kulling
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of
+this software and associated documentation files (the "Software"), to deal in
+the Software without restriction, including without limitation the rights to
+use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+the Software, and to permit persons to whom the Software is furnished to do so,
+subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+-----------------------------------------------------------------------------------------------*/
+#pragma once
+
+#include <osre/Common/osre_common.h>
+#include <osre/RenderBackend/RenderCommon.h>
+#include <cppcore/Container/TArray.h>
+
+namespace OSRE {
+namespace RenderBackend {
+
+/// @brief  The uniform blocks known by the engine, each one uses its own binding point.
+enum class UniformBlockType {
+    FrameBlock = 0,     ///< Camera data, shared by all draws of a frame.
+    MaterialBlock,      ///< The parameters of the active material.
+    DrawBlock,          ///< The model matrices of a multi-draw, indexed by the draw id.
+    NumBlockTypes,      ///< Number of enums.
+
+    InvalidBlockType    ///< Enum for invalid enum.
+};
+
+constexpr ui32 MaxUniformBlockTypes = static_cast<ui32>(UniformBlockType::NumBlockTypes);
+
+//-------------------------------------------------------------------------------------------------
+///	@ingroup	Engine
+///
+///	@brief  This class stores the data of a uniform block in the std140 layout.
+///
+/// The members can be declared in the order of the block, the offsets will be computed by the
+/// std140 rules. Or they can be added with the offsets reflected from a linked shader program.
+/// Values are written in the tightly packed layout of UniformDataBlob and get padded here, so the
+/// whole block can be uploaded with one buffer update.
+//-------------------------------------------------------------------------------------------------
+class OSRE_EXPORT UniformBlock {
+public:
+    /// @brief  Describes one member of the block.
+    struct Member {
+        String m_name;          ///< The member name.
+        ui32 m_hash;            ///< The hashed name.
+        ParameterType m_type;   ///< The parameter type.
+        ui32 m_numItems;        ///< The number of array items.
+        size_t m_offset;        ///< The offset in the block.
+        size_t m_arrayStride;   ///< The stride between two array items.
+    };
+
+    /// @brief  The class constructor.
+    /// @param  name    [in] The block name used in the shader.
+    explicit UniformBlock(const String &name);
+
+    /// @brief  The class destructor.
+    ~UniformBlock() = default;
+
+    /// @brief  Will return the block name.
+    /// @return The block name.
+    const String &getName() const;
+
+    /// @brief  Will return the block type, derived from the name.
+    /// @return The block type.
+    UniformBlockType getType() const;
+
+    /// @brief  Will append a new member, the offset follows the std140 rules.
+    /// @param  name        [in] The member name.
+    /// @param  type        [in] The member type.
+    /// @param  numItems    [in] The number of array items.
+    /// @return The offset of the new member.
+    size_t addMember(const String &name, ParameterType type, ui32 numItems = 1);
+
+    /// @brief  Will add a new member with a known offset, for instance from shader reflection.
+    /// @param  name        [in] The member name.
+    /// @param  type        [in] The member type.
+    /// @param  numItems    [in] The number of array items.
+    /// @param  offset      [in] The offset in the block.
+    /// @param  arrayStride [in] The stride between two array items.
+    void addMember(const String &name, ParameterType type, ui32 numItems, size_t offset, size_t arrayStride);
+
+    /// @brief  Will look for a member.
+    /// @param  name    [in] The member name.
+    /// @return The member or nullptr, if there is none with this name.
+    const Member *findMember(const String &name) const;
+
+    /// @brief  Will look for the index of a member.
+    /// @param  name    [in] The member name.
+    /// @return The index or -1, if there is no member with this name.
+    i32 getMemberIndex(const String &name) const;
+
+    /// @brief  Will return a member by its index.
+    /// @param  index   [in] The member index.
+    /// @return The member or nullptr, if the index is out of range.
+    const Member *getMemberAt(size_t index) const;
+
+    /// @brief  Will return the number of members.
+    /// @return The number of members.
+    size_t getNumMembers() const;
+
+    /// @brief  Will write a value into the block, the block gets dirty only if the value changes.
+    /// @param  name    [in] The member name.
+    /// @param  data    [in] The tightly packed value.
+    /// @param  size    [in] The size of the value in bytes.
+    /// @return false, if the block does not contain the member.
+    bool setValue(const String &name, const void *data, size_t size);
+
+    /// @brief  Will write a value into the block without a name lookup.
+    /// @param  index   [in] The member index.
+    /// @param  data    [in] The tightly packed value.
+    /// @param  size    [in] The size of the value in bytes.
+    /// @return false, if the index is out of range.
+    bool setValue(size_t index, const void *data, size_t size);
+
+    /// @brief  Will return the block data.
+    /// @return Pointer to the block data.
+    const c8 *getData() const;
+
+    /// @brief  Will return the block size, including the trailing padding.
+    /// @return The size in bytes.
+    size_t getSize() const;
+
+    /// @brief  Will return true, if the data has changed since the last upload.
+    /// @return The dirty state.
+    bool isDirty() const;
+
+    /// @brief  Will reset the dirty state after an upload.
+    void clearDirty();
+
+    /// @brief  Will return the block type for a block name.
+    /// @param  name    [in] The block name.
+    /// @return The block type, InvalidBlockType for unknown blocks.
+    static UniformBlockType getTypeFromName(const String &name);
+
+    /// @brief  Will return the block name for a type.
+    /// @param  type    [in] The block type.
+    /// @return The block name.
+    static const c8 *getBlockName(UniformBlockType type);
+
+    /// @brief  Will return the std140 base alignment of a type.
+    /// @param  type    [in] The parameter type.
+    /// @return The base alignment in bytes.
+    static size_t getBaseAlignment(ParameterType type);
+
+    /// @brief  Will return the std140 stride of one array item.
+    /// @param  type    [in] The parameter type.
+    /// @return The stride in bytes.
+    static size_t getArrayStride(ParameterType type);
+
+    /// @brief  Will return the tightly packed size of one item.
+    /// @param  type    [in] The parameter type.
+    /// @return The size in bytes.
+    static size_t getItemSize(ParameterType type);
+
+private:
+    void resize(size_t size);
+
+private:
+    String mName;
+    UniformBlockType mType;
+    CPPCore::TArray<Member> mMembers;
+    size_t mEnd;
+    MemoryBuffer mData;
+    bool mDirty;
+};
+
+inline const String &UniformBlock::getName() const {
+    return mName;
+}
+
+inline UniformBlockType UniformBlock::getType() const {
+    return mType;
+}
+
+inline size_t UniformBlock::getNumMembers() const {
+    return mMembers.size();
+}
+
+inline const UniformBlock::Member *UniformBlock::getMemberAt(size_t index) const {
+    if (index >= mMembers.size()) {
+        return nullptr;
+    }
+
+    return &mMembers[index];
+}
+
+inline const c8 *UniformBlock::getData() const {
+    if (mData.isEmpty()) {
+        return nullptr;
+    }
+
+    return &mData[0];
+}
+
+inline size_t UniformBlock::getSize() const {
+    return mData.size();
+}
+
+inline bool UniformBlock::isDirty() const {
+    return mDirty;
+}
+
+inline void UniformBlock::clearDirty() {
+    mDirty = false;
+}
+
+} // Namespace RenderBackend
+} // Namespace OSRE
@@ -0,0 +1,82 @@
+/*-----------------------------------------------------------------------------------------------
+The MIT License (MIT)
+
+Copyright (c) 2015-2022 OSRE ( Open Source Render Engine ) by Kim Kulling
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of
+this software and associated documentation files (the "Software"), to deal in
+the Software without restriction, including without limitation the rights to
+use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+the Software, and to permit persons to whom the Software is furnished to do so,
+subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+-----------------------------------------------------------------------------------------------*/
+#pragma once
+
+#include <osre/Common/osre_common.h>
+
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+
+namespace OSRE {
+namespace Threading {
+
+//-------------------------------------------------------------------------------------------------
+///	@ingroup	Engine
+///
+///	@brief	This class implements a monotonic fence to synchronize two threads.
+///
+/// The producing thread signals increasing values, for instance the number of the last finished
+/// frame. A consuming thread can wait until a given value was reached. Waiting for value - N
+/// turns the fence into a counting semaphore for N slots of a ring.
+//-------------------------------------------------------------------------------------------------
+class OSRE_EXPORT Fence {
+public:
+    /// @brief  The number of spins before a waiting thread will be parked.
+    static const ui32 SpinCount = 1024;
+
+    ///	@brief	The class constructor.
+    /// @param  initialValue    [in] The initial value.
+    explicit Fence(ui64 initialValue = 0);
+
+    ///	@brief	The class destructor.
+    ~Fence();
+
+    ///	@brief	Will signal a new value, smaller values than the current one will be ignored.
+    /// @param  value   [in] The new value.
+    void signal(ui64 value);
+
+    ///	@brief	Returns the last signaled value.
+    /// @return The current value.
+    ui64 getValue() const;
+
+    ///	@brief	Waits until the given value was signaled, spins first and parks the thread afterwards.
+    /// @param  value   [in] The value to wait for.
+    void wait(ui64 value);
+
+    ///	@brief	Will reset the fence, no thread is allowed to wait.
+    /// @param  value   [in] The new value.
+    void reset(ui64 value = 0);
+
+    // Copying is not allowed
+    Fence(const Fence &) = delete;
+    Fence &operator=(const Fence &) = delete;
+
+private:
+    std::atomic<ui64> m_value;
+    std::mutex m_lock;
+    std::condition_variable m_event;
+};
+
+} // Namespace Threading
+} // Namespace OSRE
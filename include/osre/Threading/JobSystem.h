@@ -0,0 +1,173 @@
+/*-----------------------------------------------------------------------------------------------
+The MIT License (MIT)
+
+Copyright (c) 2015-2022 OSRE ( Open Source Render Engine ) by Kim Kulling
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of
+this software and associated documentation files (the "Software"), to deal in
+the Software without restriction, including without limitation the rights to
+use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+the Software, and to permit persons to whom the Software is furnished to do so,
+subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+-----------------------------------------------------------------------------------------------*/
+#pragma once
+
+#include <osre/Common/osre_common.h>
+#include <osre/Threading/TLockFreeQueue.h>
+#include <osre/Threading/TWorkStealingDeque.h>
+
+#include <atomic>
+#include <condition_variable>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace OSRE {
+namespace Threading {
+
+struct Job;
+
+/// @brief  The job handle, valid until the job pool wrapped around.
+using JobHandle = Job *;
+
+/// @brief  The function executed by a job.
+using JobFunc = void (*)(void *data);
+
+/// @brief  The function executed for one range of a parallel for, the end is exclusive.
+using ParallelForFunc = std::function<void(size_t begin, size_t end)>;
+
+//-------------------------------------------------------------------------------------------------
+///	@ingroup	Engine
+///
+///	@brief	This class implements a job system with a fixed pool of worker threads.
+///
+/// Each worker owns a work-stealing deque, it executes its own jobs in LIFO order and steals the
+/// oldest jobs of other workers when running dry. The creating thread is worker 0, it executes
+/// jobs while waiting for a job to be finished. Jobs of foreign threads will be injected by a
+/// shared queue.
+/// A job is finished when its function and all its child jobs were executed. A job added as a
+/// dependency will be started when all its preconditions are finished. Jobs are taken from a ring
+/// of MaxJobs entries, so handles shall not be kept for longer than the next MaxJobs jobs. Slots of
+/// unfinished jobs are skipped, the allocating thread executes jobs until a slot is free.
+//-------------------------------------------------------------------------------------------------
+class OSRE_EXPORT JobSystem {
+public:
+    /// @brief  The number of jobs in the ring, must be a power of two.
+    static const ui32 MaxJobs = 4096;
+    /// @brief  The maximal number of jobs which depend on one job.
+    static const ui32 MaxContinuations = 8;
+    /// @brief  The number of spins before an idle worker will be parked.
+    static const ui32 SpinCount = 1024;
+
+    ///	@brief	The class constructor.
+    /// @param  numWorkers  [in] The number of worker threads, 0 for one per CPU core beside the
+    ///                          calling thread.
+    explicit JobSystem(ui32 numWorkers = 0);
+
+    ///	@brief	The class destructor, pending jobs will not be executed.
+    ~JobSystem();
+
+    /// @brief  Creates the global instance.
+    /// @param  numWorkers  [in] The number of worker threads, 0 for one per CPU core.
+    /// @return true if successful, false if the instance already exists.
+    static bool create(ui32 numWorkers = 0);
+
+    /// @brief  Destroys the global instance.
+    /// @return true if successful, false if there is no instance.
+    static bool destroy();
+
+    /// @brief  Returns the global instance.
+    /// @return The instance or nullptr if not created.
+    static JobSystem *getInstance();
+
+    /// @brief  Creates a new job, it will not be executed before calling run.
+    /// @param  func    [in] The job function, nullptr for a job just grouping its children.
+    /// @param  data    [in] The user data passed to the function.
+    /// @return The job handle.
+    JobHandle createJob(JobFunc func, void *data);
+
+    /// @brief  Creates a new job, the parent is not finished before the child is finished.
+    /// @param  parent  [in] The parent job, must not be finished.
+    /// @param  func    [in] The job function.
+    /// @param  data    [in] The user data passed to the function.
+    /// @return The job handle.
+    JobHandle createChildJob(JobHandle parent, JobFunc func, void *data);
+
+    /// @brief  The job will not be started before the precondition is finished.
+    /// @param  job             [in] The dependent job, must not be running.
+    /// @param  precondition    [in] The precondition, a finished one is ignored.
+    /// @return true if successful, false if the precondition has too many dependent jobs.
+    bool addDependency(JobHandle job, JobHandle precondition);
+
+    /// @brief  Starts the job as soon as all its preconditions are finished.
+    /// @param  job     [in] The job to start.
+    void run(JobHandle job);
+
+    /// @brief  Waits until the job is finished, the calling thread executes jobs meanwhile.
+    /// @param  job     [in] The job to wait for.
+    void waitFor(JobHandle job);
+
+    /// @brief  Returns true, if the job and all its children are finished.
+    /// @param  job     [in] The job.
+    /// @return true if finished.
+    bool isFinished(JobHandle job) const;
+
+    /// @brief  Executes one pending job on the calling thread, used to help while waiting.
+    /// @return true if a job was executed, false if there was none.
+    bool executeNext();
+
+    /// @brief  Splits the range [0, count) into ranges and executes them in parallel.
+    /// @param  count       [in] The number of elements.
+    /// @param  grainSize   [in] The minimal number of elements per range.
+    /// @param  func        [in] The function called for each range.
+    void parallelFor(size_t count, size_t grainSize, const ParallelForFunc &func);
+
+    /// @brief  Returns the number of threads executing jobs, including the creating thread.
+    /// @return The number of workers.
+    ui32 getNumWorkers() const;
+
+    // Copying is not allowed
+    JobSystem(const JobSystem &) = delete;
+    JobSystem &operator=(const JobSystem &) = delete;
+
+private:
+    using JobDeque = TWorkStealingDeque<Job *>;
+
+    Job *allocateJob();
+    void push(Job *job);
+    bool tryExecuteNext(i32 workerIndex);
+    Job *getNextJob(i32 workerIndex);
+    void execute(Job *job);
+    void finish(Job *job);
+    void resolveDependency(Job *job);
+    void workerMain(ui32 workerIndex);
+    i32 getWorkerIndex() const;
+
+private:
+    static JobSystem *sInstance;
+
+    Job *m_jobs;
+    std::atomic<ui32> m_nextJob;
+    std::vector<JobDeque *> m_deques;
+    TLockFreeQueue<Job *> m_injectedJobs;
+    std::vector<std::thread> m_threads;
+    std::atomic<bool> m_running;
+    std::atomic<i32> m_numQueued;
+    std::atomic<i32> m_numSleeping;
+    std::mutex m_parkLock;
+    std::condition_variable m_parkEvent;
+};
+
+} // Namespace Threading
+} // Namespace OSRE
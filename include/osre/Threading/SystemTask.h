@@ -23,7 +23,7 @@ CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
 #pragma once
 
 #include <osre/Threading/AbstractTask.h>
-#include <osre/Threading/TAsyncQueue.h>
+#include <osre/Threading/TLockFreeQueue.h>
 #include <osre/Common/TObjPtr.h>
 
 namespace OSRE {
@@ -34,8 +34,10 @@ namespace Common {
 
 namespace Threading {
 
+class Fence;
 class SystemTaskThread;
 class TaskJob;
+class TaskJobPool;
 
 //-------------------------------------------------------------------------------------------------
 ///	@ingroup	Engine
@@ -89,23 +91,39 @@ public:
     ///	@brief	An event handler will be detached.
     virtual void detachEventHandler();
     
-    ///	@brief	A new task job will be enqueued.
+    ///	@brief	A new task job will be enqueued. Waits while all jobs are in flight, when called by 
+    /// the task thread itself it fails instead.
     ///	@param	pEvent		[in] A pointer showing to the event, which describes the kind of job.
     ///	@param	pEventData	[in] A pointer showing to the event data.
     ///	@return	true, if the enqueue operation was successful, false if not.
     virtual bool sendEvent( const Common::Event *pEvent, const Common::EventData *pEventData );
+
+    ///	@brief	A new task job will be enqueued, the fence is signaled after the job was handled.
+    ///	@param	pEvent		[in] A pointer showing to the event, which describes the kind of job.
+    ///	@param	pEventData	[in] A pointer showing to the event data.
+    ///	@param	fence		[in] The fence, it is signaled as well when the task stops before.
+    ///	@param	value		[in] The value to signal.
+    ///	@return	true, if the enqueue operation was successful, false if not.
+    bool sendEvent( const Common::Event *pEvent, const Common::EventData *pEventData, Fence *fence, ui64 value );
     
     ///	@brief	Returns the number of enqueued jobs.
     ///	@return	The number of attached jobs.
     virtual size_t getEvetQueueSize() const;
     
+    ///	@brief	Returns the access mode of the event queue.
+    ///	@return	The queue mode.
+    QueueMode getQueueMode() const;
+
     ///	@brief	The factory method, creates a new instance of the system task.
-    static SystemTask *create( const String &rTaskName );
+    ///	@param	rTaskName	[in] The task name.
+    ///	@param	mode		[in] Use QueueMode::SPSC when only one thread will send events.
+    static SystemTask *create( const String &rTaskName, QueueMode mode = QueueMode::MPSC );
 
 protected:
     ///	@brief	The class constructor.
     ///	@param	taskName	[in] The class instance name.
-    SystemTask( const String &taskName );
+    ///	@param	mode		[in] The access mode of the event queue.
+    SystemTask( const String &taskName, QueueMode mode );
 
     ///	@brief	The class destructor, virtual.
     virtual ~SystemTask();
@@ -114,8 +132,10 @@ private:
     WorkingMode m_workingMode;
     BufferMode m_buffermode;
     SystemTaskThread *m_taskThread;
-    using TaskQueue = Threading::TAsyncQueue<const TaskJob*>;
+    using TaskQueue = Threading::TLockFreeQueue<TaskJob*>;
+    QueueMode m_queueMode;
     TaskQueue *m_asyncQueue;
+    TaskJobPool *m_jobPool;
 };
 
 using SystemTaskPtr = Common::TObjPtr<Threading::SystemTask>;
@@ -0,0 +1,296 @@
+/*-----------------------------------------------------------------------------------------------
+The MIT License (MIT)
+
+Copyright (c) 2015-2022 OSRE ( Open Source Render Engine ) by Kim Kulling
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of
+this software and associated documentation files (the "Software"), to deal in
+the Software without restriction, including without limitation the rights to
+use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+the Software, and to permit persons to whom the Software is furnished to do so,
+subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+-----------------------------------------------------------------------------------------------*/
+#pragma once
+
+#include <osre/Common/osre_common.h>
+#include <osre/Debugging/osre_debugging.h>
+#include <osre/Threading/ThreadingCommon.h>
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+
+namespace OSRE {
+namespace Threading {
+
+/// @brief  Describes how many threads are allowed to access a lock-free queue.
+enum class QueueMode {
+    SPSC,   ///< Single producer, single consumer.
+    MPSC,   ///< Multiple producers, single consumer.
+    MPMC    ///< Multiple producers, multiple consumers.
+};
+
+//-------------------------------------------------------------------------------------------------
+///	@ingroup	Infrastructure
+///
+///	@brief	This template class implements a bounded lock-free queue.
+///
+/// Each slot stores a sequence number, so producers and consumers only have to agree on the slot
+/// they own ( see Dmitry Vyukov's bounded queue ). If only one producer respectively one consumer
+/// is used the position update is a plain store instead of a compare-and-swap.
+/// A waiting consumer spins a while before it will be parked, a producer only touches the parking
+/// lock when a consumer is asleep.
+//-------------------------------------------------------------------------------------------------
+template <class T>
+class TLockFreeQueue {
+public:
+    /// @brief  The number of spins before a waiting consumer will be parked.
+    static const ui32 SpinCount = 1024;
+
+    ///	@brief	The class constructor.
+    /// @param  capacity    [in] The capacity, will be rounded up to a power of two.
+    /// @param  mode        [in] The access mode.
+    explicit TLockFreeQueue(size_t capacity = 1024, QueueMode mode = QueueMode::MPSC);
+
+    ///	@brief	The class destructor.
+    ~TLockFreeQueue();
+
+    /// @brief  Tries to enqueue a new item.
+    /// @param  item    [in] The item to enqueue.
+    /// @return true if successful, false if the queue is full.
+    bool tryEnqueue(const T &item);
+
+    ///	@brief	A new item will be enqueued, will yield as long as the queue is full. Must not be 
+    /// called by the consuming thread, it would wait for itself.
+    ///	@param	item    [in] The item to enqueue.
+    void enqueue(const T &item);
+
+    /// @brief  Tries to dequeue the next item.
+    /// @param  item    [out] The dequeued item.
+    /// @return true if successful, false if the queue is empty.
+    bool tryDequeue(T &item);
+
+    ///	@brief	The next item will be returned and removed, will wait until an item is available.
+    ///	@return	The next item in the queue.
+    T dequeue();
+
+    ///	@brief	Waits until an item was enqueued, spins first and parks the thread afterwards.
+    void awaitEnqueuedItem();
+
+    ///	@brief	Wakes up a parked consumer.
+    void signalEnqueuedItem();
+
+    ///	@brief	Returns the number of enqueued items, only a snapshot.
+    ///	@return	The number of enqueued items.
+    size_t size() const;
+
+    ///	@brief	Returns true, if the queue is empty.
+    ///	@return	true, if no item was enqueued.
+    bool isEmpty() const;
+
+    /// @brief  Returns the capacity.
+    /// @return The capacity.
+    size_t capacity() const;
+
+    /// @brief  Returns the access mode.
+    /// @return The access mode.
+    QueueMode getMode() const;
+
+    /// Copying is not allowed.
+    TLockFreeQueue(const TLockFreeQueue<T> &) = delete;
+    TLockFreeQueue &operator=(const TLockFreeQueue<T> &) = delete;
+
+private:
+    static const size_t CacheLineSize = 64;
+
+    struct Cell {
+        std::atomic<size_t> m_sequence;
+        T m_item;
+    };
+
+    Cell *m_cells;
+    size_t m_mask;
+    QueueMode m_mode;
+    alignas(CacheLineSize) std::atomic<size_t> m_enqueuePos;
+    alignas(CacheLineSize) std::atomic<size_t> m_dequeuePos;
+    alignas(CacheLineSize) std::atomic<i32> m_numSleeping;
+    std::mutex m_parkLock;
+    std::condition_variable m_parkEvent;
+};
+
+template <class T>
+inline TLockFreeQueue<T>::TLockFreeQueue(size_t capacity, QueueMode mode) :
+        m_cells(nullptr),
+        m_mask(0),
+        m_mode(mode),
+        m_enqueuePos(0),
+        m_dequeuePos(0),
+        m_numSleeping(0),
+        m_parkLock(),
+        m_parkEvent() {
+    size_t size = 2;
+    while (size < capacity) {
+        size <<= 1;
+    }
+    m_mask = size - 1;
+    m_cells = new Cell[size];
+    for (size_t i = 0; i < size; ++i) {
+        m_cells[i].m_sequence.store(i, std::memory_order_relaxed);
+    }
+}
+
+template <class T>
+inline TLockFreeQueue<T>::~TLockFreeQueue() {
+    delete[] m_cells;
+    m_cells = nullptr;
+}
+
+template <class T>
+inline bool TLockFreeQueue<T>::tryEnqueue(const T &item) {
+    const bool singleProducer = QueueMode::SPSC == m_mode;
+    size_t pos = m_enqueuePos.load(std::memory_order_relaxed);
+    Cell *cell = nullptr;
+    for (;;) {
+        cell = &m_cells[pos & m_mask];
+        const size_t seq = cell->m_sequence.load(std::memory_order_acquire);
+        const intptr_t diff = (intptr_t)seq - (intptr_t)pos;
+        if (0 == diff) {
+            if (singleProducer) {
+                m_enqueuePos.store(pos + 1, std::memory_order_relaxed);
+                break;
+            }
+            if (m_enqueuePos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+                break;
+            }
+        } else if (diff < 0) {
+            return false;
+        } else {
+            pos = m_enqueuePos.load(std::memory_order_relaxed);
+        }
+    }
+
+    cell->m_item = item;
+    cell->m_sequence.store(pos + 1, std::memory_order_release);
+
+    // Only pay for the wakeup when a consumer is parked
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    if (0 != m_numSleeping.load(std::memory_order_relaxed)) {
+        signalEnqueuedItem();
+    }
+
+    return true;
+}
+
+template <class T>
+inline void TLockFreeQueue<T>::enqueue(const T &item) {
+    while (!tryEnqueue(item)) {
+        std::this_thread::yield();
+    }
+}
+
+template <class T>
+inline bool TLockFreeQueue<T>::tryDequeue(T &item) {
+    const bool singleConsumer = QueueMode::MPMC != m_mode;
+    size_t pos = m_dequeuePos.load(std::memory_order_relaxed);
+    Cell *cell = nullptr;
+    for (;;) {
+        cell = &m_cells[pos & m_mask];
+        const size_t seq = cell->m_sequence.load(std::memory_order_acquire);
+        const intptr_t diff = (intptr_t)seq - (intptr_t)(pos + 1);
+        if (0 == diff) {
+            if (singleConsumer) {
+                m_dequeuePos.store(pos + 1, std::memory_order_relaxed);
+                break;
+            }
+            if (m_dequeuePos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+                break;
+            }
+        } else if (diff < 0) {
+            return false;
+        } else {
+            pos = m_dequeuePos.load(std::memory_order_relaxed);
+        }
+    }
+
+    item = cell->m_item;
+    cell->m_sequence.store(pos + m_mask + 1, std::memory_order_release);
+
+    return true;
+}
+
+template <class T>
+inline T TLockFreeQueue<T>::dequeue() {
+    T item;
+    while (!tryDequeue(item)) {
+        awaitEnqueuedItem();
+    }
+
+    return item;
+}
+
+template <class T>
+inline void TLockFreeQueue<T>::awaitEnqueuedItem() {
+    for (ui32 i = 0; i < SpinCount; ++i) {
+        if (!isEmpty()) {
+            return;
+        }
+        cpuPause();
+    }
+
+    std::unique_lock<std::mutex> lock(m_parkLock);
+    m_numSleeping.fetch_add(1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+
+    // Check again after announcing the sleep, a producer may have missed us
+    while (isEmpty()) {
+        m_parkEvent.wait_for(lock, std::chrono::milliseconds(10));
+    }
+    m_numSleeping.fetch_sub(1, std::memory_order_relaxed);
+}
+
+template <class T>
+inline void TLockFreeQueue<T>::signalEnqueuedItem() {
+    std::lock_guard<std::mutex> lock(m_parkLock);
+    m_parkEvent.notify_all();
+}
+
+template <class T>
+inline size_t TLockFreeQueue<T>::size() const {
+    const size_t enqueuePos = m_enqueuePos.load(std::memory_order_acquire);
+    const size_t dequeuePos = m_dequeuePos.load(std::memory_order_acquire);
+
+    return enqueuePos > dequeuePos ? enqueuePos - dequeuePos : 0;
+}
+
+template <class T>
+inline bool TLockFreeQueue<T>::isEmpty() const {
+    const size_t pos = m_dequeuePos.load(std::memory_order_relaxed);
+    const size_t seq = m_cells[pos & m_mask].m_sequence.load(std::memory_order_acquire);
+
+    return seq != pos + 1;
+}
+
+template <class T>
+inline size_t TLockFreeQueue<T>::capacity() const {
+    return m_mask + 1;
+}
+
+template <class T>
+inline QueueMode TLockFreeQueue<T>::getMode() const {
+    return m_mode;
+}
+
+} // Namespace Threading
+} // Namespace OSRE
@@ -0,0 +1,183 @@
+/*-----------------------------------------------------------------------------------------------
+The MIT License (MIT)
+
+Copyright (c) 2015-2022 OSRE ( Open Source Render Engine ) by Kim Kulling
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of
+this software and associated documentation files (the "Software"), to deal in
+the Software without restriction, including without limitation the rights to
+use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+the Software, and to permit persons to whom the Software is furnished to do so,
+subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+-----------------------------------------------------------------------------------------------*/
+#pragma once
+
+#include <osre/Common/osre_common.h>
+
+#include <atomic>
+
+namespace OSRE {
+namespace Threading {
+
+//-------------------------------------------------------------------------------------------------
+///	@ingroup	Infrastructure
+///
+///	@brief	This template class implements a bounded work-stealing deque.
+///
+/// The owning thread pushes and pops items at the bottom end without any lock, all other threads
+/// steal items from the top end ( see Chase and Lev, "Dynamic Circular Work-Stealing Deque", and
+/// the C11 version by Le et al. ). Only the last item is contended, it is resolved by a single
+/// compare-and-swap on the top index. The capacity is fixed, a push to a full deque will fail.
+//-------------------------------------------------------------------------------------------------
+template <class T>
+class TWorkStealingDeque {
+public:
+    ///	@brief	The class constructor.
+    /// @param  capacity    [in] The capacity, will be rounded up to a power of two.
+    explicit TWorkStealingDeque(size_t capacity = 1024);
+
+    ///	@brief	The class destructor.
+    ~TWorkStealingDeque();
+
+    /// @brief  Pushes a new item at the bottom, only allowed for the owning thread.
+    /// @param  item    [in] The item to push.
+    /// @return true if successful, false if the deque is full.
+    bool push(const T &item);
+
+    /// @brief  Pops the last pushed item, only allowed for the owning thread.
+    /// @param  item    [out] The popped item.
+    /// @return true if successful, false if the deque is empty or the item was stolen.
+    bool pop(T &item);
+
+    /// @brief  Steals the oldest item, allowed for any thread.
+    /// @param  item    [out] The stolen item.
+    /// @return true if successful, false if the deque is empty or another thief was faster.
+    bool steal(T &item);
+
+    ///	@brief	Returns the number of items, only a snapshot.
+    ///	@return	The number of items.
+    size_t size() const;
+
+    ///	@brief	Returns true, if the deque is empty.
+    ///	@return	true, if no item was pushed.
+    bool isEmpty() const;
+
+    /// @brief  Returns the capacity.
+    /// @return The capacity.
+    size_t capacity() const;
+
+    /// Copying is not allowed.
+    TWorkStealingDeque(const TWorkStealingDeque<T> &) = delete;
+    TWorkStealingDeque &operator=(const TWorkStealingDeque<T> &) = delete;
+
+private:
+    static const size_t CacheLineSize = 64;
+
+    std::atomic<T> *m_items;
+    size_t m_mask;
+    alignas(CacheLineSize) std::atomic<i64> m_top;
+    alignas(CacheLineSize) std::atomic<i64> m_bottom;
+};
+
+template <class T>
+inline TWorkStealingDeque<T>::TWorkStealingDeque(size_t capacity) :
+        m_items(nullptr),
+        m_mask(0),
+        m_top(0),
+        m_bottom(0) {
+    size_t size = 2;
+    while (size < capacity) {
+        size <<= 1;
+    }
+    m_mask = size - 1;
+    m_items = new std::atomic<T>[size];
+}
+
+template <class T>
+inline TWorkStealingDeque<T>::~TWorkStealingDeque() {
+    delete[] m_items;
+    m_items = nullptr;
+}
+
+template <class T>
+inline bool TWorkStealingDeque<T>::push(const T &item) {
+    const i64 bottom = m_bottom.load(std::memory_order_relaxed);
+    const i64 top = m_top.load(std::memory_order_acquire);
+    if (bottom - top > static_cast<i64>(m_mask)) {
+        return false;
+    }
+
+    m_items[bottom & m_mask].store(item, std::memory_order_relaxed);
+    m_bottom.store(bottom + 1, std::memory_order_release);
+
+    return true;
+}
+
+template <class T>
+inline bool TWorkStealingDeque<T>::pop(T &item) {
+    const i64 bottom = m_bottom.load(std::memory_order_relaxed) - 1;
+    m_bottom.store(bottom, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    i64 top = m_top.load(std::memory_order_relaxed);
+    if (top > bottom) {
+        // Was already empty
+        m_bottom.store(bottom + 1, std::memory_order_relaxed);
+        return false;
+    }
+
+    item = m_items[bottom & m_mask].load(std::memory_order_relaxed);
+    if (top != bottom) {
+        return true;
+    }
+
+    // Last item, race against the thieves
+    const bool success = m_top.compare_exchange_strong(top, top + 1, std::memory_order_seq_cst, std::memory_order_relaxed);
+    m_bottom.store(bottom + 1, std::memory_order_relaxed);
+
+    return success;
+}
+
+template <class T>
+inline bool TWorkStealingDeque<T>::steal(T &item) {
+    i64 top = m_top.load(std::memory_order_acquire);
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    const i64 bottom = m_bottom.load(std::memory_order_acquire);
+    if (top >= bottom) {
+        return false;
+    }
+
+    item = m_items[top & m_mask].load(std::memory_order_relaxed);
+
+    return m_top.compare_exchange_strong(top, top + 1, std::memory_order_seq_cst, std::memory_order_relaxed);
+}
+
+template <class T>
+inline size_t TWorkStealingDeque<T>::size() const {
+    const i64 bottom = m_bottom.load(std::memory_order_acquire);
+    const i64 top = m_top.load(std::memory_order_acquire);
+
+    return bottom > top ? static_cast<size_t>(bottom - top) : 0;
+}
+
+template <class T>
+inline bool TWorkStealingDeque<T>::isEmpty() const {
+    return 0 == size();
+}
+
+template <class T>
+inline size_t TWorkStealingDeque<T>::capacity() const {
+    return m_mask + 1;
+}
+
+} // Namespace Threading
+} // Namespace OSRE
@@ -24,6 +24,7 @@ CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
 
 #include <osre/Common/osre_common.h>
 #include <osre/Debugging/osre_debugging.h>
+#include <osre/Threading/Fence.h>
 
 namespace OSRE {
 
@@ -44,10 +45,17 @@ using TaskJobFunctor = Common::Functor<void, ui32, void *>;
 //-------------------------------------------------------------------------------------------------
 class OSRE_EXPORT TaskJob {
 public:
-    TaskJob(const Common::Event *pEvent, const Common::EventData *pEventData);
+    ///	@brief	The default class constructor, used for pooled jobs.
+    TaskJob();
+
     ///	@brief	The class constructor with the event and the event data.
     ///	@param	pEvent		[in] A pointer showing to the event.
     ///	@param	pEventData	[in] A pointer showing to the event data.
+    TaskJob(const Common::Event *pEvent, const Common::EventData *pEventData);
+
+    ///	@brief	The class constructor with the event, the event data and the job functor.
+    ///	@param	pEvent		[in] A pointer showing to the event.
+    ///	@param	pEventData	[in] A pointer showing to the event data.
     TaskJob(const Common::Event *pEvent, const Common::EventData *pEventData, TaskJobFunctor &tj);
 
     ///	@brief	The class destructor.
@@ -66,10 +74,17 @@ public:
     ///	@param	pEventData	A pointer showing to the event data.
     void set(const Common::Event *pEvent, const Common::EventData *pEventData);
 
+    ///	@brief	Set a fence, which will be signaled when the job is done or dropped.
+    ///	@param	fence		[in] The fence, nullptr for none.
+    ///	@param	value		[in] The value to signal.
+    void setFence(Fence *fence, ui64 value);
+
+    ///	@brief	Will signal the fence, if there is one.
+    void signalFence();
+
     ///	@brief	Clears the TaskJob-instance.
     void clear();
 
-    TaskJob() = delete;
     TaskJob(const TaskJob &) = delete;
     TaskJob &operator=(const TaskJob &) = delete;
 
@@ -77,19 +92,32 @@ private:
     const Common::Event *m_event;
     const Common::EventData *m_eventData;
     TaskJobFunctor &mFunctor;
+    Fence *m_fence;
+    ui64 m_fenceValue;
 };
 
 static TaskJobFunctor DummyFunc;
 
-TaskJob::TaskJob(const Common::Event *pEvent, const Common::EventData *pEventData) :
+inline TaskJob::TaskJob() :
+        m_event(nullptr),
+        m_eventData(nullptr),
+        mFunctor(DummyFunc),
+        m_fence(nullptr),
+        m_fenceValue(0) {
+    // empty
+}
+
+inline TaskJob::TaskJob(const Common::Event *pEvent, const Common::EventData *pEventData) :
         m_event(pEvent),
         m_eventData(pEventData),
-        mFunctor(DummyFunc) {
+        mFunctor(DummyFunc),
+        m_fence(nullptr),
+        m_fenceValue(0) {
     osre_assert(nullptr != pEvent);
 }
 
 inline TaskJob::TaskJob(const Common::Event *pEvent, const Common::EventData *pEventData, TaskJobFunctor &tj) :
-        m_event(pEvent), m_eventData(pEventData), mFunctor(tj) {
+        m_event(pEvent), m_eventData(pEventData), mFunctor(tj), m_fence(nullptr), m_fenceValue(0) {
     osre_assert(nullptr != pEvent);
 }
 
@@ -110,9 +138,22 @@ inline void TaskJob::set(const Common::Event *pEvent, const Common::EventData *p
     m_eventData = pEventData;
 }
 
+inline void TaskJob::setFence(Fence *fence, ui64 value) {
+    m_fence = fence;
+    m_fenceValue = value;
+}
+
+inline void TaskJob::signalFence() {
+    if (nullptr != m_fence) {
+        m_fence->signal(m_fenceValue);
+    }
+}
+
 inline void TaskJob::clear() {
     m_event = nullptr;
     m_eventData = nullptr;
+    m_fence = nullptr;
+    m_fenceValue = 0;
 }
 
 } // Namespace Threading
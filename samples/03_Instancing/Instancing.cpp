@@ -26,8 +26,13 @@ CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
 #include <osre/Common/BaseMath.h>
 #include <osre/Platform/AbstractWindow.h>
 #include <osre/Properties/Settings.h>
+#include <osre/RenderBackend/Material.h>
+#include <osre/RenderBackend/MaterialBuilder.h>
+#include <osre/RenderBackend/Mesh.h>
+#include <osre/RenderBackend/MeshBuilder.h>
 #include <osre/RenderBackend/RenderBackendService.h>
 #include <osre/RenderBackend/RenderCommon.h>
+#include <osre/RenderBackend/Shader.h>
 #include <osre/Scene/Scene.h>
 
 using namespace ::OSRE;
@@ -38,16 +43,65 @@ using namespace ::OSRE::RenderBackend;
 // To identify local log entries
 static const c8 *Tag = "InstancingApp";
 
-/// The example application, will create the render environment and render a simple triangle onto it
+// The instance grid, all instances will be rendered with one draw call
+static constexpr ui32 GridSize = 100;
+static constexpr ui32 NumInstances = GridSize * GridSize;
+
+static const String VsSrc =
+        "#version 400 core\n"
+        "\n"
+        "layout(location = 0) in vec3 position;	 // object space vertex position\n"
+        "layout(location = 1) in vec3 normal;    // object space vertex normal\n"
+        "layout(location = 2) in vec3 color0;    // per-vertex colour\n"
+        "\n"
+        "// per-instance data\n"
+        "in vec4 instance0;\n"
+        "in vec4 instance1;\n"
+        "in vec4 instance2;\n"
+        "in vec4 instance3;\n"
+        "in vec4 instancecolor;\n"
+        "\n"
+        "// output from the vertex shader\n"
+        "smooth out vec4 vSmoothColor;\n"
+        "\n"
+        "layout(std140) uniform FrameBlock {\n"
+        "    mat4 View;\n"
+        "    mat4 Projection;\n"
+        "};\n"
+        "\n"
+        "void main() {\n"
+        "    mat4 Model = mat4(instance0, instance1, instance2, instance3);\n"
+        "    vSmoothColor = vec4(color0, 1) * instancecolor;\n"
+        "    gl_Position = Projection * View * Model * vec4(position, 1);\n"
+        "}\n";
+
+static const String FsSrc =
+        "#version 400 core\n"
+        "\n"
+        "layout(location=0) out vec4 vFragColor;\n"
+        "\n"
+        "smooth in vec4 vSmoothColor;\n"
+        "\n"
+        "void main() {\n"
+        "    vFragColor = vSmoothColor;\n"
+        "}\n";
+
+/// The example application, will render a grid of triangles with one instanced draw call
 class InstancingApp : public App::AppBase {
-    App::Entity *mEntity;
-    App::Camera *mCamera;
+    f32 mAngle;
+    ui32 mCurrentRow;
+    glm::mat4 mView;
+    glm::mat4 mProjection;
+    CPPCore::TArray<glm::mat4> mTransforms;
 
 public:
     InstancingApp(int argc, char *argv[]) :
             AppBase(argc, (const char **)argv, "api:model", "The render API:The model to load"),
-            mEntity(nullptr),
-            mCamera(nullptr) {
+            mAngle(0.0f),
+            mCurrentRow(0),
+            mView(1.0f),
+            mProjection(1.0f),
+            mTransforms() {
         // empty
     }
 
@@ -81,36 +135,74 @@ protected:
 
         Rect2ui windowsRect;
         rootWindow->getWindowsRect(windowsRect);
+        const f32 aspect = static_cast<f32>(windowsRect.width) / static_cast<f32>(windowsRect.height);
+        mProjection = glm::perspective(glm::radians(60.0f), aspect, 0.1f, 1000.0f);
+        mView = glm::lookAt(glm::vec3(0, 0, 150), glm::vec3(0, 0, 0), glm::vec3(0, 1, 0));
+
+        // The material cache owns the material
+        TextureResourceArray texResArray;
+        Material *material = MaterialBuilder::createTexturedMaterial("InstanceMat", texResArray, VsSrc, FsSrc);
+        if (nullptr == material) {
+            osre_error(Tag, "Cannot create instance material.");
+            return false;
+        }
+        Shader *shader = material->getShader();
+        if (nullptr != shader) {
+            shader->addVertexAttribute("position");
+            shader->addVertexAttribute("normal");
+            shader->addVertexAttribute("color0");
+        }
 
-        Camera *camera = getStage()->getActiveWorld()->addCamera("cam1");
-        camera->setProjectionParameters(60.f, (f32)windowsRect.width, (f32)windowsRect.height, 0.0001f, 1000.f);
-        World *world = getStage()->getActiveWorld();
-        mEntity = new App::Entity("instance", world->getIds(), world);
         MeshBuilder meshBuilder;
-        AppBase::getStage()->getActiveWorld()->addEntity(mEntity);
-        RenderBackend::Mesh *mesh = meshBuilder.createTriangle(VertexType::RenderVertex, BufferAccessType::ReadWrite).getMesh();
-        if (nullptr != mesh) {
-            RenderComponent *rc = (RenderComponent *)mEntity->getComponent(ComponentType::RenderComponentType);
-            rc->addStaticMesh(mesh);
-            Time dt;
-            world->update(dt);
-            camera->observeBoundingBox(mEntity->getAABB());
+        Mesh *mesh = meshBuilder.createTriangle(VertexType::ColorVertex, BufferAccessType::ReadOnly).getMesh();
+        if (nullptr == mesh) {
+            osre_error(Tag, "Cannot create instanced mesh.");
+            return false;
+        }
+        mesh->setMaterial(material);
+
+        CPPCore::TArray<glm::vec4> colors;
+        colors.resize(NumInstances);
+        mTransforms.resize(NumInstances);
+        const f32 offset = static_cast<f32>(GridSize) * 0.5f;
+        for (ui32 y = 0; y < GridSize; ++y) {
+            for (ui32 x = 0; x < GridSize; ++x) {
+                const glm::vec3 pos(static_cast<f32>(x) - offset, static_cast<f32>(y) - offset, 0.0f);
+                mTransforms[y * GridSize + x] = glm::scale(glm::translate(glm::mat4(1.0f), pos), glm::vec3(0.4f));
+                colors[y * GridSize + x] = glm::vec4(static_cast<f32>(x) / GridSize, static_cast<f32>(y) / GridSize, 1.0f, 1.0f);
+            }
         }
 
+        rbSrv->beginPass(RenderPass::getPassNameById(RenderPassId));
+        rbSrv->beginRenderBatch("instances");
+        rbSrv->addMesh(mesh, NumInstances);
+        rbSrv->setInstanceTransforms(0, NumInstances, &mTransforms[0]);
+        rbSrv->setInstanceColors(0, NumInstances, &colors[0]);
+        rbSrv->endRenderBatch();
+        rbSrv->endPass();
+
         return true;
     }
 
     void onUpdate() override {
-        // Rotate the model
-        glm::mat4 rot(1.0);
-
         RenderBackendService *rbSrv(getRenderBackendService());
 
-        rbSrv->beginPass(RenderPass::getPassNameById(RenderPassId));
-        rbSrv->beginRenderBatch("b1");
+        // Rotate one row per frame, only this row will be uploaded
+        mAngle += 0.02f;
+        const glm::mat4 rot = glm::rotate(glm::mat4(1.0f), mAngle, glm::vec3(0, 0, 1));
+        glm::mat4 *row = &mTransforms[mCurrentRow * GridSize];
+        for (ui32 x = 0; x < GridSize; ++x) {
+            row[x] = glm::translate(glm::mat4(1.0f), glm::vec3(row[x][3])) * rot * glm::scale(glm::mat4(1.0f), glm::vec3(0.4f));
+        }
 
+        rbSrv->beginPass(RenderPass::getPassNameById(RenderPassId));
+        rbSrv->beginRenderBatch("instances");
+        rbSrv->setMatrix(MatrixType::View, mView);
+        rbSrv->setMatrix(MatrixType::Projection, mProjection);
+        rbSrv->setInstanceTransforms(mCurrentRow * GridSize, GridSize, row);
         rbSrv->endRenderBatch();
         rbSrv->endPass();
+        mCurrentRow = (mCurrentRow + 1) % GridSize;
 
         // Scene::DbgRenderer::getInstance()->renderDbgText(0, 0, 2U, "XXX");
 
@@ -0,0 +1,120 @@
+/*-----------------------------------------------------------------------------------------------
+The MIT License (MIT)
+
+Copyright (c) 2015-2022 OSRE ( Open Source Render Engine ) by Kim Kulling
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of
+this software and associated documentation files (the "Software"), to deal in
+the Software without restriction, including without limitation the rights to
+use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+the Software, and to permit persons to whom the Software is furnished to do so,
+subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+-----------------------------------------------------------------------------------------------*/
+#include <osre/Animation/Skinning.h>
+#include <osre/Common/Logger.h>
+
+#include <cstring>
+
+namespace OSRE {
+namespace Animation {
+
+static const c8 *Tag = "Skinning";
+
+VertexInfluenceBuilder::VertexInfluenceBuilder() :
+        mSlots() {
+    // empty
+}
+
+void VertexInfluenceBuilder::reset(size_t numVertices) {
+    mSlots.resize(numVertices);
+    if (0 != numVertices) {
+        ::memset(&mSlots[0], 0, sizeof(Slot) * numVertices);
+    }
+}
+
+bool VertexInfluenceBuilder::addBone(ui32 boneIndex, const VertexWeight *weights, size_t numWeights, size_t vertexOffset) {
+    if (boneIndex > MaxBoneIndex) {
+        osre_debug(Tag, "Bone index exceeds the packed index range.");
+        return false;
+    }
+
+    if (nullptr == weights) {
+        return 0 == numWeights;
+    }
+
+    bool ok = true;
+    const size_t numVertices = mSlots.size();
+    for (size_t i = 0; i < numWeights; ++i) {
+        const VertexWeight &vw = weights[i];
+        const size_t vertexIdx = vertexOffset + vw.m_vertexIdx;
+        if (vertexIdx >= numVertices) {
+            ok = false;
+            continue;
+        }
+
+        // Keep the slots sorted by weight, the weakest influence falls out at the end
+        Slot &slot = mSlots[vertexIdx];
+        ui32 pos = MaxBoneInfluences;
+        while (pos > 0 && slot.mWeights[pos - 1] < vw.m_vertexWeight) {
+            --pos;
+        }
+        if (pos == MaxBoneInfluences) {
+            continue;
+        }
+
+        for (ui32 j = MaxBoneInfluences - 1; j > pos; --j) {
+            slot.mWeights[j] = slot.mWeights[j - 1];
+            slot.mBoneIndices[j] = slot.mBoneIndices[j - 1];
+        }
+        slot.mWeights[pos] = vw.m_vertexWeight;
+        slot.mBoneIndices[pos] = static_cast<uc8>(boneIndex);
+    }
+
+    if (!ok) {
+        osre_debug(Tag, "Vertex weights with an invalid vertex index found.");
+    }
+
+    return ok;
+}
+
+void VertexInfluenceBuilder::build(VertexInfluenceArray &influences) const {
+    const size_t numVertices = mSlots.size();
+    influences.resize(numVertices);
+    for (size_t i = 0; i < numVertices; ++i) {
+        const Slot &slot = mSlots[i];
+        VertexInfluence &influence = influences[i];
+        f32 sum = 0.0f;
+        for (ui32 j = 0; j < MaxBoneInfluences; ++j) {
+            influence.mBoneIndices[j] = slot.mBoneIndices[j];
+            sum += slot.mWeights[j];
+        }
+
+        // Vertices without any bone keep zero weights
+        if (sum <= 0.0f) {
+            ::memset(influence.mWeights, 0, sizeof(influence.mWeights));
+            continue;
+        }
+
+        // Renormalize and hand the rounding error to the strongest influence
+        ui32 total = 0;
+        for (ui32 j = 1; j < MaxBoneInfluences; ++j) {
+            const ui32 w = static_cast<ui32>(slot.mWeights[j] / sum * 255.0f + 0.5f);
+            influence.mWeights[j] = static_cast<uc8>(w);
+            total += w;
+        }
+        influence.mWeights[0] = static_cast<uc8>(total < 255 ? 255 - total : 0);
+    }
+}
+
+} // Namespace Animation
+} // Namespace OSRE
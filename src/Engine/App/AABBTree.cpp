@@ -0,0 +1,496 @@
+/*-----------------------------------------------------------------------------------------------
+The MIT License (MIT)
+
+Copyright (c) 2015-2022 OSRE ( Open Source Render Engine ) by Kim Kulling
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of
+this software and associated documentation files (the "Software"), to deal in
+the Software without restriction, including without limitation the rights to
+use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+the Software, and to permit persons to whom the Software is furnished to do so,
+subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+-----------------------------------------------------------------------------------------------*/
+#include <osre/App/AABBTree.h>
+#include <osre/Common/Frustum.h>
+#include <osre/Common/TRay.h>
+#include <osre/Debugging/osre_debugging.h>
+
+#include <algorithm>
+#include <limits>
+
+namespace OSRE {
+namespace App {
+
+using namespace ::OSRE::Common;
+using namespace ::CPPCore;
+
+namespace {
+
+using Visibility = Frustum::Visibility;
+
+// Balanced trees stay far below this depth
+static const i32 MaxStackSize = 256;
+
+AABB combine(const AABB &lhs, const AABB &rhs) {
+    AABB aabb(lhs);
+    aabb.merge(rhs);
+
+    return aabb;
+}
+
+struct BoxClassifier {
+    const AABB &m_box;
+
+    Visibility classify(const AABB &aabb) const {
+        if (!m_box.intersects(aabb)) {
+            return Visibility::Outside;
+        }
+
+        return m_box.isIn(aabb) ? Visibility::Inside : Visibility::Intersecting;
+    }
+};
+
+struct SphereClassifier {
+    glm::vec3 m_center;
+    f32 m_sqrRadius;
+
+    Visibility classify(const AABB &aabb) const {
+        const glm::vec3 &min = aabb.getMin();
+        const glm::vec3 &max = aabb.getMax();
+        const glm::vec3 closest = glm::clamp(m_center, min, max);
+        const glm::vec3 toClosest = closest - m_center;
+        if (glm::dot(toClosest, toClosest) > m_sqrRadius) {
+            return Visibility::Outside;
+        }
+
+        const glm::vec3 farthest(m_center.x < (min.x + max.x) * 0.5f ? max.x : min.x,
+                m_center.y < (min.y + max.y) * 0.5f ? max.y : min.y,
+                m_center.z < (min.z + max.z) * 0.5f ? max.z : min.z);
+        const glm::vec3 toFarthest = farthest - m_center;
+
+        return glm::dot(toFarthest, toFarthest) <= m_sqrRadius ? Visibility::Inside : Visibility::Intersecting;
+    }
+};
+
+struct FrustumClassifier {
+    const Frustum &m_frustum;
+
+    Visibility classify(const AABB &aabb) const {
+        return m_frustum.classify(aabb);
+    }
+};
+
+struct RayClassifier {
+    glm::vec3 m_origin;
+    glm::vec3 m_invDirection;
+    f32 m_maxDistance;
+
+    // Slab test, a ray never contains a box
+    Visibility classify(const AABB &aabb) const {
+        const glm::vec3 t0 = (aabb.getMin() - m_origin) * m_invDirection;
+        const glm::vec3 t1 = (aabb.getMax() - m_origin) * m_invDirection;
+        const glm::vec3 tNear = glm::min(t0, t1);
+        const glm::vec3 tFar = glm::max(t0, t1);
+        const f32 enter = std::max(std::max(tNear.x, tNear.y), std::max(tNear.z, 0.0f));
+        const f32 leave = std::min(std::min(tFar.x, tFar.y), std::min(tFar.z, m_maxDistance));
+
+        return enter <= leave ? Visibility::Intersecting : Visibility::Outside;
+    }
+};
+
+} // Anonymous namespace
+
+AABBTree::AABBTree(f32 margin) :
+        mNodes(),
+        mRoot(NullNode),
+        mFreeList(NullNode),
+        mNumProxies(0),
+        mMargin(margin) {
+    // empty
+}
+
+AABBTree::~AABBTree() {
+    // empty
+}
+
+i32 AABBTree::createProxy(const AABB &aabb, void *userData) {
+    const i32 proxyId = allocateNode();
+    const glm::vec3 margin(mMargin);
+    Node &node = mNodes[proxyId];
+    node.m_aabb.set(aabb.getMin() - margin, aabb.getMax() + margin);
+    node.m_userData = userData;
+    node.m_height = 0;
+    insertLeaf(proxyId);
+    ++mNumProxies;
+
+    return proxyId;
+}
+
+void AABBTree::destroyProxy(i32 proxyId) {
+    osre_assert(0 <= proxyId && proxyId < static_cast<i32>(mNodes.size()));
+    osre_assert(mNodes[proxyId].isLeaf());
+
+    removeLeaf(proxyId);
+    freeNode(proxyId);
+    --mNumProxies;
+}
+
+bool AABBTree::moveProxy(i32 proxyId, const AABB &aabb) {
+    osre_assert(0 <= proxyId && proxyId < static_cast<i32>(mNodes.size()));
+    osre_assert(mNodes[proxyId].isLeaf());
+
+    if (mNodes[proxyId].m_aabb.isIn(aabb)) {
+        return false;
+    }
+
+    removeLeaf(proxyId);
+    const glm::vec3 margin(mMargin);
+    mNodes[proxyId].m_aabb.set(aabb.getMin() - margin, aabb.getMax() + margin);
+    insertLeaf(proxyId);
+
+    return true;
+}
+
+void *AABBTree::getUserData(i32 proxyId) const {
+    osre_assert(0 <= proxyId && proxyId < static_cast<i32>(mNodes.size()));
+
+    return mNodes[proxyId].m_userData;
+}
+
+const AABB &AABBTree::getFatAABB(i32 proxyId) const {
+    osre_assert(0 <= proxyId && proxyId < static_cast<i32>(mNodes.size()));
+
+    return mNodes[proxyId].m_aabb;
+}
+
+void AABBTree::queryBox(const AABB &box, TArray<void *> &result) const {
+    const BoxClassifier classifier = { box };
+    query(classifier, result);
+}
+
+void AABBTree::querySphere(const glm::vec3 &center, f32 radius, TArray<void *> &result) const {
+    const SphereClassifier classifier = { center, radius * radius };
+    query(classifier, result);
+}
+
+void AABBTree::queryFrustum(const Frustum &frustum, TArray<void *> &result) const {
+    const FrustumClassifier classifier = { frustum };
+    query(classifier, result);
+}
+
+void AABBTree::queryRay(const Ray &ray, f32 maxDistance, TArray<void *> &result) const {
+    // Division by zero gives infinity, which is what the slab test expects
+    const glm::vec3 &dir = ray.getDirection();
+    const f32 inf = std::numeric_limits<f32>::infinity();
+    const glm::vec3 invDirection(0.0f != dir.x ? 1.0f / dir.x : inf,
+            0.0f != dir.y ? 1.0f / dir.y : inf,
+            0.0f != dir.z ? 1.0f / dir.z : inf);
+    const RayClassifier classifier = { ray.getOrigin(), invDirection, maxDistance };
+    query(classifier, result);
+}
+
+void AABBTree::clear() {
+    mNodes.clear();
+    mRoot = NullNode;
+    mFreeList = NullNode;
+    mNumProxies = 0;
+}
+
+template <class Classifier>
+void AABBTree::query(const Classifier &classifier, TArray<void *> &result) const {
+    if (NullNode == mRoot) {
+        return;
+    }
+
+    i32 stack[MaxStackSize];
+    i32 stackSize = 0;
+    stack[stackSize++] = mRoot;
+    while (stackSize > 0) {
+        const i32 nodeId = stack[--stackSize];
+        const Node &node = mNodes[nodeId];
+        const Visibility visibility = classifier.classify(node.m_aabb);
+        if (Visibility::Outside == visibility) {
+            continue;
+        }
+
+        if (node.isLeaf()) {
+            result.add(node.m_userData);
+        } else if (Visibility::Inside == visibility) {
+            // No need to test the subtree
+            collectLeaves(nodeId, result);
+        } else {
+            osre_assert(stackSize + 2 <= MaxStackSize);
+            stack[stackSize++] = node.m_child1;
+            stack[stackSize++] = node.m_child2;
+        }
+    }
+}
+
+void AABBTree::collectLeaves(i32 nodeId, TArray<void *> &result) const {
+    i32 stack[MaxStackSize];
+    i32 stackSize = 0;
+    stack[stackSize++] = nodeId;
+    while (stackSize > 0) {
+        const Node &node = mNodes[stack[--stackSize]];
+        if (node.isLeaf()) {
+            result.add(node.m_userData);
+        } else {
+            osre_assert(stackSize + 2 <= MaxStackSize);
+            stack[stackSize++] = node.m_child1;
+            stack[stackSize++] = node.m_child2;
+        }
+    }
+}
+
+i32 AABBTree::allocateNode() {
+    if (NullNode == mFreeList) {
+        // Grow the pool and chain the new nodes into the free list
+        const i32 oldSize = static_cast<i32>(mNodes.size());
+        const i32 newSize = oldSize > 0 ? oldSize * 2 : 16;
+        mNodes.resize(newSize);
+        for (i32 i = oldSize; i < newSize; ++i) {
+            mNodes[i].m_parent = i + 1 < newSize ? i + 1 : NullNode;
+            mNodes[i].m_height = -1;
+        }
+        mFreeList = oldSize;
+    }
+
+    const i32 nodeId = mFreeList;
+    Node &node = mNodes[nodeId];
+    mFreeList = node.m_parent;
+    node.m_aabb.reset();
+    node.m_userData = nullptr;
+    node.m_parent = NullNode;
+    node.m_child1 = NullNode;
+    node.m_child2 = NullNode;
+    node.m_height = 0;
+
+    return nodeId;
+}
+
+void AABBTree::freeNode(i32 nodeId) {
+    Node &node = mNodes[nodeId];
+    node.m_parent = mFreeList;
+    node.m_height = -1;
+    mFreeList = nodeId;
+}
+
+void AABBTree::insertLeaf(i32 leaf) {
+    if (NullNode == mRoot) {
+        mRoot = leaf;
+        mNodes[leaf].m_parent = NullNode;
+        return;
+    }
+
+    // Branch and bound search for the sibling with the lowest cost. The cost is the area of the
+    // new parent plus the area all ancestors grow by, see Bittner et al., "Fast Insertion-Based
+    // Optimization of Bounding Volume Hierarchies".
+    const AABB leafAABB = mNodes[leaf].m_aabb;
+    const f32 leafArea = leafAABB.getSurfaceArea();
+    i32 sibling = mRoot;
+    f32 bestCost = combine(mNodes[mRoot].m_aabb, leafAABB).getSurfaceArea();
+    i32 stack[MaxStackSize];
+    f32 inheritedCosts[MaxStackSize];
+    i32 stackSize = 0;
+    stack[stackSize] = mRoot;
+    inheritedCosts[stackSize++] = 0.0f;
+    while (stackSize > 0) {
+        --stackSize;
+        const Node &node = mNodes[stack[stackSize]];
+        const f32 inheritedCost = inheritedCosts[stackSize];
+        const f32 directCost = combine(node.m_aabb, leafAABB).getSurfaceArea();
+        const f32 cost = directCost + inheritedCost;
+        if (cost < bestCost) {
+            bestCost = cost;
+            sibling = stack[stackSize];
+        }
+
+        // Going down this node makes it grow anyway, the leaf area is the least to add
+        const f32 childInheritedCost = inheritedCost + directCost - node.m_aabb.getSurfaceArea();
+        if (!node.isLeaf() && leafArea + childInheritedCost < bestCost) {
+            // Visit the child growing less first, it will tighten the bound early
+            i32 first = node.m_child1, second = node.m_child2;
+            const AABB &firstAABB = mNodes[first].m_aabb;
+            const AABB &secondAABB = mNodes[second].m_aabb;
+            if (combine(firstAABB, leafAABB).getSurfaceArea() - firstAABB.getSurfaceArea() >
+                    combine(secondAABB, leafAABB).getSurfaceArea() - secondAABB.getSurfaceArea()) {
+                std::swap(first, second);
+            }
+            osre_assert(stackSize + 2 <= MaxStackSize);
+            stack[stackSize] = second;
+            inheritedCosts[stackSize++] = childInheritedCost;
+            stack[stackSize] = first;
+            inheritedCosts[stackSize++] = childInheritedCost;
+        }
+    }
+
+    // Create a new parent for the sibling and the leaf, may grow the node pool
+    const i32 oldParent = mNodes[sibling].m_parent;
+    const i32 newParent = allocateNode();
+    Node &parent = mNodes[newParent];
+    parent.m_parent = oldParent;
+    parent.m_aabb = combine(leafAABB, mNodes[sibling].m_aabb);
+    parent.m_height = mNodes[sibling].m_height + 1;
+    parent.m_child1 = sibling;
+    parent.m_child2 = leaf;
+    if (NullNode != oldParent) {
+        if (mNodes[oldParent].m_child1 == sibling) {
+            mNodes[oldParent].m_child1 = newParent;
+        } else {
+            mNodes[oldParent].m_child2 = newParent;
+        }
+    } else {
+        mRoot = newParent;
+    }
+    mNodes[sibling].m_parent = newParent;
+    mNodes[leaf].m_parent = newParent;
+
+    refit(newParent);
+}
+
+void AABBTree::removeLeaf(i32 leaf) {
+    if (leaf == mRoot) {
+        mRoot = NullNode;
+        return;
+    }
+
+    const i32 parent = mNodes[leaf].m_parent;
+    const i32 grandParent = mNodes[parent].m_parent;
+    const i32 sibling = mNodes[parent].m_child1 == leaf ? mNodes[parent].m_child2 : mNodes[parent].m_child1;
+    freeNode(parent);
+    if (NullNode == grandParent) {
+        mRoot = sibling;
+        mNodes[sibling].m_parent = NullNode;
+        return;
+    }
+
+    // Replace the parent by the sibling
+    if (mNodes[grandParent].m_child1 == parent) {
+        mNodes[grandParent].m_child1 = sibling;
+    } else {
+        mNodes[grandParent].m_child2 = sibling;
+    }
+    mNodes[sibling].m_parent = grandParent;
+
+    refit(grandParent);
+}
+
+void AABBTree::refit(i32 nodeId) {
+    // Fix heights and boxes up to the root and rotate where the tree became unbalanced
+    for (i32 index = nodeId; NullNode != index;) {
+        index = balance(index);
+        Node &node = mNodes[index];
+        const Node &child1 = mNodes[node.m_child1];
+        const Node &child2 = mNodes[node.m_child2];
+        node.m_height = 1 + std::max(child1.m_height, child2.m_height);
+        node.m_aabb = combine(child1.m_aabb, child2.m_aabb);
+        index = node.m_parent;
+    }
+}
+
+i32 AABBTree::balance(i32 iA) {
+    Node &a = mNodes[iA];
+    if (a.isLeaf() || a.m_height < 2) {
+        return iA;
+    }
+
+    const i32 iB = a.m_child1;
+    const i32 iC = a.m_child2;
+    Node &b = mNodes[iB];
+    Node &c = mNodes[iC];
+    const i32 diff = c.m_height - b.m_height;
+
+    // Rotate C up
+    if (diff > 1) {
+        const i32 iF = c.m_child1;
+        const i32 iG = c.m_child2;
+        Node &f = mNodes[iF];
+        Node &g = mNodes[iG];
+
+        c.m_child1 = iA;
+        c.m_parent = a.m_parent;
+        a.m_parent = iC;
+        if (NullNode == c.m_parent) {
+            mRoot = iC;
+        } else if (mNodes[c.m_parent].m_child1 == iA) {
+            mNodes[c.m_parent].m_child1 = iC;
+        } else {
+            mNodes[c.m_parent].m_child2 = iC;
+        }
+
+        // The higher grandchild stays with C
+        if (f.m_height > g.m_height) {
+            c.m_child2 = iF;
+            a.m_child2 = iG;
+            g.m_parent = iA;
+            a.m_aabb = combine(b.m_aabb, g.m_aabb);
+            c.m_aabb = combine(a.m_aabb, f.m_aabb);
+            a.m_height = 1 + std::max(b.m_height, g.m_height);
+            c.m_height = 1 + std::max(a.m_height, f.m_height);
+        } else {
+            c.m_child2 = iG;
+            a.m_child2 = iF;
+            f.m_parent = iA;
+            a.m_aabb = combine(b.m_aabb, f.m_aabb);
+            c.m_aabb = combine(a.m_aabb, g.m_aabb);
+            a.m_height = 1 + std::max(b.m_height, f.m_height);
+            c.m_height = 1 + std::max(a.m_height, g.m_height);
+        }
+
+        return iC;
+    }
+
+    // Rotate B up
+    if (diff < -1) {
+        const i32 iD = b.m_child1;
+        const i32 iE = b.m_child2;
+        Node &d = mNodes[iD];
+        Node &e = mNodes[iE];
+
+        b.m_child1 = iA;
+        b.m_parent = a.m_parent;
+        a.m_parent = iB;
+        if (NullNode == b.m_parent) {
+            mRoot = iB;
+        } else if (mNodes[b.m_parent].m_child1 == iA) {
+            mNodes[b.m_parent].m_child1 = iB;
+        } else {
+            mNodes[b.m_parent].m_child2 = iB;
+        }
+
+        if (d.m_height > e.m_height) {
+            b.m_child2 = iD;
+            a.m_child1 = iE;
+            e.m_parent = iA;
+            a.m_aabb = combine(c.m_aabb, e.m_aabb);
+            b.m_aabb = combine(a.m_aabb, d.m_aabb);
+            a.m_height = 1 + std::max(c.m_height, e.m_height);
+            b.m_height = 1 + std::max(a.m_height, d.m_height);
+        } else {
+            b.m_child2 = iE;
+            a.m_child1 = iD;
+            d.m_parent = iA;
+            a.m_aabb = combine(c.m_aabb, d.m_aabb);
+            b.m_aabb = combine(a.m_aabb, e.m_aabb);
+            a.m_height = 1 + std::max(c.m_height, d.m_height);
+            b.m_height = 1 + std::max(a.m_height, e.m_height);
+        }
+
+        return iB;
+    }
+
+    return iA;
+}
+
+} // Namespace App
+} // Namespace OSRE
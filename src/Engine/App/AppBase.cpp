@@ -37,12 +37,14 @@ CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
 #include <osre/Platform/AbstractTimer.h>
 #include <osre/Platform/AbstractWindow.h>
 #include <osre/Platform/PlatformInterface.h>
+#include <osre/Profiling/PerformanceCounterRegistry.h>
 #include <osre/Properties/Settings.h>
 #include <osre/RenderBackend/Pipeline.h>
 #include <osre/RenderBackend/RenderBackendService.h>
 #include <osre/RenderBackend/TransformMatrixBlock.h>
 #include <osre/App/Camera.h>
 #include <osre/RenderBackend/MaterialBuilder.h>
+#include <osre/Threading/JobSystem.h>
 
 #include "src/Engine/App/MouseEventListener.h"
 #include "src/Engine/Platform/PlatformPluginFactory.h"
@@ -235,6 +237,13 @@ bool AppBase::onCreate() {
         osre_debug(Tag, "Cannot create asset registry.");
     }
 
+    // Registered before the renderer is created, the render thread stores shader binaries there
+#ifdef OSRE_WINDOWS
+    App::AssetRegistry::registerAssetPath("cache", "../../cache");
+#else
+    App::AssetRegistry::registerAssetPath("cache", "../cache");
+#endif
+
     // create the platform interface instance
     m_platformInterface = Platform::PlatformInterface::create(m_settings);
     if (nullptr == m_platformInterface) {
@@ -262,6 +271,10 @@ bool AppBase::onCreate() {
         return false;
     }
 
+    // The counters of the application, the render back-end service owns the registry
+    Profiling::PerformanceCounterRegistry::registerCounter("entitiesDrawn");
+    Profiling::PerformanceCounterRegistry::registerCounter("entitiesCulled");
+
     // Create our world
     mStage = new Stage("stage");
     mStage->createWorld("world");
@@ -279,8 +292,10 @@ bool AppBase::onCreate() {
 
     m_timer = Platform::PlatformInterface::getInstance()->getTimer();
 
-    MaterialBuilder::create();
+    // The materials reference their textures from the engine texture cache
     ResourceCacheService *rcSrv = new ResourceCacheService;
+    MaterialBuilder::create(rcSrv->getTextureResourceCache());
+    Threading::JobSystem::create();
 
     // Setup onMouse event-listener
     AbstractPlatformEventQueue *evHandler = m_platformInterface->getPlatformEventHandler();
@@ -338,6 +353,7 @@ bool AppBase::onDestroy() {
     }
 
     MaterialBuilder::destroy();
+    Threading::JobSystem::destroy();
 
     delete mStage;
     mStage = nullptr;
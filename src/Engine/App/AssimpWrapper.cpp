@@ -42,6 +42,8 @@ CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
 #include <osre/RenderBackend/MeshBuilder.h>
 #include <osre/RenderBackend/MeshProcessor.h>
 #include <osre/App/Node.h>
+#include <osre/Animation/Skinning.h>
+#include <osre/Threading/JobSystem.h>
 
 #include <assimp/postprocess.h>
 #include <assimp/scene.h>
@@ -49,6 +51,7 @@ CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
 #include <assimp/Importer.hpp>
 
 #include <iostream>
+#include <vector>
 
 namespace OSRE {
 namespace App {
@@ -96,6 +99,17 @@ static void setTexture(const String &resolvedPath, const aiString &texPath,
     texResArray.add(texRes);
 }
 
+// Runs the range on the job system when there is one, otherwise on the calling thread
+static void runParallel(size_t count, const Threading::ParallelForFunc &func) {
+    Threading::JobSystem *jobSystem = Threading::JobSystem::getInstance();
+    if (nullptr == jobSystem) {
+        func(0, count);
+        return;
+    }
+
+    jobSystem->parallelFor(count, 1, func);
+}
+
 AssimpWrapper::AssetContext::AssetContext(Common::Ids &ids, World *world) :
         mScene(nullptr),
         mMeshArray(),
@@ -108,6 +122,9 @@ AssimpWrapper::AssetContext::AssetContext(Common::Ids &ids, World *world) :
         mRoot(),
         mAbsPathWithFile(),
         mBone2NodeMap(),
+        mBoneLookup(),
+        mSkeleton(),
+        mInfluenceArray(),
         mNumVertices(0),
         mNumTriangles(0) {
     // empty
@@ -115,6 +132,12 @@ AssimpWrapper::AssetContext::AssetContext(Common::Ids &ids, World *world) :
  
 AssimpWrapper::AssetContext::~AssetContext() {
     delete mDefaultTexture;
+    for (size_t i = 0; i < mSkeleton.mBones.size(); ++i) {
+        delete mSkeleton.mBones[i];
+    }
+    for (size_t i = 0; i < mInfluenceArray.size(); ++i) {
+        delete mInfluenceArray[i];
+    }
 }
 
 AssimpWrapper::AssimpWrapper( Common::Ids &ids, World *world ) :
@@ -164,6 +187,17 @@ bool AssimpWrapper::importAsset(const IO::Uri &file, ui32 flags) {
     return true;
 }
 
+Entity *AssimpWrapper::importScene(const aiScene *scene) {
+    if (nullptr == scene) {
+        osre_error(Tag, "Scene to import is nullptr.");
+        return nullptr;
+    }
+
+    mAssetContext.mScene = scene;
+
+    return convertScene();
+}
+
 Entity *AssimpWrapper::getEntity() const {
     return mAssetContext.mEntity;
 }
@@ -173,6 +207,18 @@ void AssimpWrapper::getStatistics( ui32 &numVertices, ui32 &numTriangles ) {
     numTriangles = mAssetContext.mNumTriangles;
 }
 
+const VertexInfluenceArray *AssimpWrapper::getVertexInfluences(size_t meshIdx) const {
+    if (meshIdx >= mAssetContext.mInfluenceArray.size()) {
+        return nullptr;
+    }
+
+    return mAssetContext.mInfluenceArray[meshIdx];
+}
+
+const Skeleton &AssimpWrapper::getSkeleton() const {
+    return mAssetContext.mSkeleton;
+}
+
 Entity *AssimpWrapper::convertScene() {
     if (nullptr == mAssetContext.mScene) {
         return nullptr;
@@ -184,14 +230,7 @@ Entity *AssimpWrapper::convertScene() {
 
     mAssetContext.mEntity = new Entity(mAssetContext.mAbsPathWithFile, mAssetContext.mIds, mAssetContext.mWorld);
     if (mAssetContext.mScene->HasMaterials()) {
-        for (ui32 i = 0; i < mAssetContext.mScene->mNumMaterials; ++i) {
-            aiMaterial *currentMat = mAssetContext.mScene->mMaterials[i];
-            if (nullptr == currentMat) {
-                continue;
-            }
-
-            importMaterial(currentMat);
-        }
+        importMaterials(mAssetContext.mScene->mMaterials, mAssetContext.mScene->mNumMaterials);
     }
 
     if (mAssetContext.mScene->HasMeshes()) {
@@ -244,20 +283,109 @@ static void copyAiMatrix4x4(const aiMatrix4x4 &aiMat, glm::mat4 &mat) {
     mat[3].w = aiMat.d4;
 }
 
-using MeshIdxArray = ::CPPCore::TArray<size_t>;
-using Mat2MeshMap = std::map<aiMaterial *, MeshIdxArray *>;
+namespace {
+
+// Marks a bone which could not be registered
+static const ui32 InvalidBoneIndex = 0xffffffff;
+
+// One aiMesh and its place in the buffers of its material group
+struct MeshTask {
+    aiMesh *mMesh;
+    size_t mGroup;
+    size_t mVertexOffset;
+    size_t mIndexOffset;
+    size_t mNumIndices;
+    AABB mAabb;
+    ::CPPCore::TArray<ui32> mBoneIndices;
+};
+
+// All meshes sharing one material are merged into one Mesh
+struct MeshGroup {
+    ui32 mMaterialIndex;
+    size_t mNumVertices;
+    size_t mNumIndices;
+    bool mHasBones;
+    ::CPPCore::TArray<RenderVert> mVertices;
+    ::CPPCore::TArray<ui32> mIndices;
+    VertexInfluenceBuilder mInfluenceBuilder;
+};
+
+} // Anonymous namespace
+
+static size_t countIndices(const aiMesh *mesh) {
+    size_t numIndices = 0;
+    for (ui32 faceIdx = 0; faceIdx < mesh->mNumFaces; ++faceIdx) {
+        numIndices += mesh->mFaces[faceIdx].mNumIndices;
+    }
+
+    return numIndices;
+}
+
+// Writes the vertices, indices and weights of one mesh into its slice of the group buffers
+static void convertMesh(MeshTask &task, MeshGroup &group) {
+    const aiMesh *mesh = task.mMesh;
+    RenderVert *vertices = mesh->mNumVertices > 0 ? &group.mVertices[task.mVertexOffset] : nullptr;
+    for (ui32 k = 0; k < mesh->mNumVertices; ++k) {
+        RenderVert &v = vertices[k];
+        if (mesh->HasPositions()) {
+            const aiVector3D &vec3 = mesh->mVertices[k];
+            v.position.x = vec3.x;
+            v.position.y = vec3.y;
+            v.position.z = vec3.z;
+            task.mAabb.merge(vec3.x, vec3.y, vec3.z);
+        }
 
-static size_t countVertices(MeshIdxArray &miArray, const aiScene *scene) {
-    if (nullptr == scene) {
-        return 0;
+        if (mesh->HasNormals()) {
+            const aiVector3D &normal = mesh->mNormals[k];
+            v.normal.x = normal.x;
+            v.normal.y = normal.y;
+            v.normal.z = normal.z;
+        }
+
+        if (mesh->HasVertexColors(0)) {
+            const aiColor4D &diffuse = mesh->mColors[0][k];
+            v.color0.r = diffuse.r;
+            v.color0.g = diffuse.g;
+            v.color0.b = diffuse.b;
+        } else {
+            v.color0.r = 0.5;
+            v.color0.g = 0.5;
+            v.color0.b = 0.5;
+        }
+
+        if (mesh->HasTextureCoords(0)) {
+            const aiVector3D &tex0 = mesh->mTextureCoords[0][k];
+            v.tex0.x = tex0.x;
+            v.tex0.y = tex0.y;
+        }
     }
 
-    size_t numVertices = 0;
-    for (unsigned int i = 0; i < miArray.size(); ++i) {
-        numVertices += static_cast<size_t>(scene->mMeshes[miArray[i]]->mNumVertices);
+    ui32 *indices = task.mNumIndices > 0 ? &group.mIndices[task.mIndexOffset] : nullptr;
+    const ui32 vertexOffset = static_cast<ui32>(task.mVertexOffset);
+    for (ui32 faceIdx = 0; faceIdx < mesh->mNumFaces; ++faceIdx) {
+        const aiFace &currentFace = mesh->mFaces[faceIdx];
+        for (ui32 idx = 0; idx < currentFace.mNumIndices; ++idx) {
+            *indices++ = currentFace.mIndices[idx] + vertexOffset;
+        }
     }
 
-    return numVertices;
+    // The meshes of a group own disjoint vertex ranges, so the builder can be shared
+    Bone::VertexWeightArray weights;
+    for (ui32 boneIdx = 0; boneIdx < mesh->mNumBones; ++boneIdx) {
+        const aiBone *currentBone = mesh->mBones[boneIdx];
+        if (nullptr == currentBone || InvalidBoneIndex == task.mBoneIndices[boneIdx] || 0 == currentBone->mNumWeights) {
+            continue;
+        }
+
+        weights.resize(currentBone->mNumWeights);
+        for (ui32 weightIdx = 0; weightIdx < currentBone->mNumWeights; ++weightIdx) {
+            const aiVertexWeight &aiVW = currentBone->mWeights[weightIdx];
+            VertexWeight &w = weights[weightIdx];
+            w.m_vertexIdx = aiVW.mVertexId;
+            w.m_vertexWeight = static_cast<f32>(aiVW.mWeight);
+        }
+        group.mInfluenceBuilder.addBone(task.mBoneIndices[boneIdx], &weights[0], weights.size(), task.mVertexOffset);
+    }
 }
 
 void AssimpWrapper::importMeshes(aiMesh **meshes, ui32 numMeshes) {
@@ -266,9 +394,11 @@ void AssimpWrapper::importMeshes(aiMesh **meshes, ui32 numMeshes) {
         return;
     }
 
-    AABB aabb = mAssetContext.mEntity->getAABB();
-
-    Mat2MeshMap mat2MeshMap;
+    // Group the meshes by material in the order of their first appearance and register
+    // the bones, both touch shared state and stay on the calling thread.
+    std::map<aiMaterial *, size_t> mat2Group;
+    std::vector<MeshTask> tasks;
+    tasks.reserve(numMeshes);
     for (ui32 meshIndex = 0; meshIndex < numMeshes; ++meshIndex) {
         aiMesh *currentMesh = meshes[meshIndex];
         if (nullptr == currentMesh) {
@@ -280,142 +410,134 @@ void AssimpWrapper::importMeshes(aiMesh **meshes, ui32 numMeshes) {
         if (nullptr == mat) {
             continue;
         }
-        
-        Mat2MeshMap::const_iterator it = mat2MeshMap.find(mat);
-        MeshIdxArray *miArray = nullptr;
-        if (mat2MeshMap.end() == it) {
-            miArray = new MeshIdxArray;
-            mat2MeshMap[mat] = miArray;
-        } else {
-            miArray = it->second;
+
+        std::map<aiMaterial *, size_t>::const_iterator it = mat2Group.find(mat);
+        const size_t groupIdx = mat2Group.end() == it ? mat2Group.size() : it->second;
+        if (mat2Group.end() == it) {
+            mat2Group[mat] = groupIdx;
         }
-        miArray->add(static_cast<size_t>(meshIndex));
-    }
 
-    for (size_t mat2MeshIdx = 0; mat2MeshIdx < mat2MeshMap.size(); ++mat2MeshIdx) {
-        mAssetContext.mMeshArray.add(new Mesh("m1", VertexType::RenderVertex, IndexType::UnsignedInt));
+        tasks.push_back(MeshTask());
+        MeshTask &task = tasks.back();
+        task.mMesh = currentMesh;
+        task.mGroup = groupIdx;
+        task.mVertexOffset = 0;
+        task.mIndexOffset = 0;
+        task.mNumIndices = 0;
+        if (currentMesh->HasBones()) {
+            importBones(currentMesh, task.mBoneIndices);
+        }
     }
 
-    size_t i = 0;
-    aiMesh *currentMesh = nullptr;
-    ::CPPCore::TArray<RenderVert> vertices;
-    for (auto & it : mat2MeshMap) {
-        CPPCore::TArray<ui32> indexArray;
-        MeshIdxArray *miArray = it.second;
-        if (nullptr == miArray) {
-            continue;
+    runParallel(tasks.size(), [&tasks](size_t begin, size_t end) {
+        for (size_t i = begin; i < end; ++i) {
+            tasks[i].mNumIndices = countIndices(tasks[i].mMesh);
         }
+    });
+
+    std::vector<MeshGroup> groups(mat2Group.size());
+    for (MeshGroup &group : groups) {
+        group.mMaterialIndex = 0;
+        group.mNumVertices = 0;
+        group.mNumIndices = 0;
+        group.mHasBones = false;
+    }
+
+    for (MeshTask &task : tasks) {
+        MeshGroup &group = groups[task.mGroup];
+        group.mMaterialIndex = task.mMesh->mMaterialIndex;
+        task.mVertexOffset = group.mNumVertices;
+        task.mIndexOffset = group.mNumIndices;
+        group.mNumVertices += task.mMesh->mNumVertices;
+        group.mNumIndices += task.mNumIndices;
+        group.mHasBones |= !task.mBoneIndices.isEmpty();
+    }
+
+    for (MeshGroup &group : groups) {
+        group.mVertices.resize(group.mNumVertices);
+        group.mIndices.resize(group.mNumIndices);
+        if (group.mHasBones) {
+            group.mInfluenceBuilder.reset(group.mNumVertices);
+        }
+    }
 
-        const size_t numVerts = countVertices(*miArray, mAssetContext.mScene);
-        vertices.resize(numVerts);
-        Mesh &newMesh = *mAssetContext.mMeshArray[i];
-        size_t vertexOffset = 0, indexOffset = 0;
-        for (unsigned long long meshIndex : *miArray) {
-            currentMesh = mAssetContext.mScene->mMeshes[meshIndex];
-            if (nullptr == currentMesh) {
-                continue;
-            }
-
-            for (ui32 k = 0; k < currentMesh->mNumVertices; ++k) {
-                if (currentMesh->HasPositions()) {
-                    mAssetContext.mNumVertices++;
-                    const aiVector3D &vec3 = currentMesh->mVertices[k];
-                    vertices[vertexOffset].position.x = vec3.x;
-                    vertices[vertexOffset].position.y = vec3.y;
-                    vertices[vertexOffset].position.z = vec3.z;
-
-                    aabb.merge(vec3.x, vec3.y, vec3.z);
-                }
-
-                if (currentMesh->HasNormals()) {
-                    const aiVector3D &normal = currentMesh->mNormals[k];
-                    vertices[vertexOffset].normal.x = normal.x;
-                    vertices[vertexOffset].normal.y = normal.y;
-                    vertices[vertexOffset].normal.z = normal.z;
-                }
-
-                if (currentMesh->HasVertexColors(0)) {
-                    const aiColor4D &diffuse = currentMesh->mColors[0][k];
-                    vertices[vertexOffset].color0.r = diffuse.r;
-                    vertices[vertexOffset].color0.g = diffuse.g;
-                    vertices[vertexOffset].color0.b = diffuse.b;
-                } else {
-                    vertices[vertexOffset].color0.r = 0.5;
-                    vertices[vertexOffset].color0.g = 0.5;
-                    vertices[vertexOffset].color0.b = 0.5;
-                }
-
-                for (ui32 texIdx = 0; texIdx < AI_MAX_NUMBER_OF_TEXTURECOORDS; texIdx++) {
-                    if (currentMesh->HasTextureCoords(texIdx)) {
-                        if (0 == texIdx) {
-                            aiVector3D &tex0 = currentMesh->mTextureCoords[texIdx][k];
-                            vertices[vertexOffset].tex0.x = tex0.x;
-                            vertices[vertexOffset].tex0.y = tex0.y;
-                        }
-                    }
-                }
-
-                if (currentMesh->HasBones()) {
-                    Bone *bones = new Bone[currentMesh->mNumBones];
-                    for (ui32 l = 0; l < currentMesh->mNumBones; ++l) {
-                        aiBone *currentBone = currentMesh->mBones[l];
-                        if (nullptr == currentBone) {
-                            osre_debug(Tag, "Invalid bone instance found.");
-                            continue;
-                        }
-
-                        Bone &bone = bones[l];
-                        bone.mName = currentBone->mName.C_Str();
-                        copyAiMatrix4x4(currentBone->mOffsetMatrix, bone.m_offsetMatrix);
-                        VertexWeight *wArray = new VertexWeight[currentBone->mNumWeights];
-                        
-                        for (ui32 weightIdx = 0; weightIdx < currentBone->mNumWeights; ++weightIdx) {
-                            aiVertexWeight &aiVW = currentBone->mWeights[l];
-                            VertexWeight &w = wArray[weightIdx];
-                            w.m_vertexIdx = aiVW.mVertexId;
-                            w.m_vertexWeight = aiVW.mWeight;
-                        }
-                        bone.m_vertexWeights.add(wArray, currentBone->mNumWeights);
-                        const aiNode *node = mAssetContext.mScene->mRootNode->FindNode(bone.mName.c_str());
-                        if (nullptr != node) {
-                            mAssetContext.mBone2NodeMap[bone.mName.c_str()] = node;
-                        }
-                    }
-                }
-
-                ++vertexOffset;
-            }
-
-            for (ui32 faceIdx = 0; faceIdx < currentMesh->mNumFaces; ++faceIdx) {
-                aiFace &currentFace = currentMesh->mFaces[faceIdx];
-                mAssetContext.mNumTriangles++;
-                for (ui32 idx = 0; idx < currentFace.mNumIndices; ++idx) {
-                    const ui32 currentIndex = currentFace.mIndices[idx];
-                    indexArray.add(static_cast<ui32>(currentIndex + indexOffset));
-                }
-            }
+    runParallel(tasks.size(), [&tasks, &groups](size_t begin, size_t end) {
+        for (size_t i = begin; i < end; ++i) {
+            convertMesh(tasks[i], groups[tasks[i].mGroup]);
+        }
+    });
 
-            indexOffset += currentMesh->mNumVertices;
+    const size_t meshOffset = mAssetContext.mMeshArray.size();
+    for (size_t groupIdx = 0; groupIdx < groups.size(); ++groupIdx) {
+        mAssetContext.mMeshArray.add(new Mesh("m1", VertexType::RenderVertex, IndexType::UnsignedInt));
+        mAssetContext.mInfluenceArray.add(groups[groupIdx].mHasBones ? new VertexInfluenceArray : nullptr);
+    }
 
-            const size_t vbSize = sizeof(RenderVert) * numVerts;
-            newMesh.createVertexBuffer(&vertices[0], vbSize, BufferAccessType::ReadOnly);
+    // All sub-meshes of one material share the buffers, so create them once per group
+    runParallel(groups.size(), [this, &groups, meshOffset](size_t begin, size_t end) {
+        for (size_t groupIdx = begin; groupIdx < end; ++groupIdx) {
+            MeshGroup &group = groups[groupIdx];
+            Mesh &newMesh = *mAssetContext.mMeshArray[meshOffset + groupIdx];
+            if (0 != group.mNumVertices && 0 != group.mNumIndices) {
+                const size_t vbSize = sizeof(RenderVert) * group.mNumVertices;
+                newMesh.createVertexBuffer(&group.mVertices[0], vbSize, BufferAccessType::ReadOnly);
 
-            const size_t ibSize = sizeof(ui32) * indexArray.size();
-            newMesh.createIndexBuffer(&indexArray[0], ibSize, IndexType::UnsignedInt, BufferAccessType::ReadOnly);
+                const size_t ibSize = sizeof(ui32) * group.mNumIndices;
+                newMesh.createIndexBuffer(&group.mIndices[0], ibSize, IndexType::UnsignedInt, BufferAccessType::ReadOnly);
 
-            newMesh.addPrimitiveGroup(indexArray.size(), PrimitiveType::TriangleList, 0);
+                newMesh.addPrimitiveGroup(group.mNumIndices, PrimitiveType::TriangleList, 0);
+                newMesh.setMaterial(mAssetContext.mMatArray[group.mMaterialIndex]);
+            }
 
-            newMesh.setMaterial(mAssetContext.mMatArray[currentMesh->mMaterialIndex]);
+            if (group.mHasBones) {
+                group.mInfluenceBuilder.build(*mAssetContext.mInfluenceArray[meshOffset + groupIdx]);
+            }
         }
+    });
 
-        ++i;
+    // Merge the results in scene order, so the import is deterministic
+    AABB aabb = mAssetContext.mEntity->getAABB();
+    for (const MeshTask &task : tasks) {
+        aabb.merge(task.mAabb);
+        if (task.mMesh->HasPositions()) {
+            mAssetContext.mNumVertices += task.mMesh->mNumVertices;
+        }
+        mAssetContext.mNumTriangles += task.mMesh->mNumFaces;
     }
     mAssetContext.mEntity->setAABB(aabb);
+}
+
+void AssimpWrapper::importBones(aiMesh *mesh, CPPCore::TArray<ui32> &boneIndices) {
+    boneIndices.resize(mesh->mNumBones);
+    for (ui32 boneIdx = 0; boneIdx < mesh->mNumBones; ++boneIdx) {
+        boneIndices[boneIdx] = InvalidBoneIndex;
+        aiBone *currentBone = mesh->mBones[boneIdx];
+        if (nullptr == currentBone) {
+            osre_debug(Tag, "Invalid bone instance found.");
+            continue;
+        }
+
+        // Bones are shared between meshes, so create every bone only once
+        const String boneName = currentBone->mName.C_Str();
+        BoneLookupMap::const_iterator it = mAssetContext.mBoneLookup.find(boneName);
+        if (mAssetContext.mBoneLookup.end() != it) {
+            boneIndices[boneIdx] = it->second;
+            continue;
+        }
 
-    for (auto &it : mat2MeshMap) {
-        delete it.second;
+        Bone *bone = new Bone;
+        bone->mName = boneName;
+        copyAiMatrix4x4(currentBone->mOffsetMatrix, bone->m_offsetMatrix);
+        const ui32 index = static_cast<ui32>(mAssetContext.mSkeleton.mBones.size());
+        mAssetContext.mSkeleton.mBones.add(bone);
+        mAssetContext.mBoneLookup[boneName] = index;
+        boneIndices[boneIdx] = index;
+
+        const aiNode *node = mAssetContext.mScene->mRootNode->FindNode(currentBone->mName);
+        if (nullptr != node) {
+            mAssetContext.mBone2NodeMap[boneName] = node;
+        }
     }
-    mat2MeshMap.clear();
 }
 
 void AssimpWrapper::importNode(aiNode *node, Node *parent) {
@@ -455,7 +577,31 @@ void AssimpWrapper::importNode(aiNode *node, Node *parent) {
     }
 }
 
-void AssimpWrapper::importMaterial(aiMaterial *material) {
+void AssimpWrapper::importMaterials(aiMaterial **materials, ui32 numMaterials) {
+    // The materials are created in scene order, the material cache is not thread-safe. Their
+    // textures come from the texture cache, so every file is loaded only once. The image files
+    // are decoded in the background and streamed in by the renderer.
+    for (ui32 i = 0; i < numMaterials; ++i) {
+        aiMaterial *currentMat = materials[i];
+        if (nullptr == currentMat) {
+            continue;
+        }
+
+        TextureResourceArray texResArray;
+        aiString texPath;
+        if (AI_SUCCESS == currentMat->GetTexture(aiTextureType_DIFFUSE, 0, &texPath)) {
+            setTexture(mAssetContext.mRoot, texPath, texResArray, TextureStageType::TextureStage0);
+        }
+
+        importMaterial(currentMat, texResArray);
+        for (size_t j = 0; j < texResArray.size(); ++j) {
+            delete texResArray[j];
+        }
+        texResArray.clear();
+    }
+}
+
+void AssimpWrapper::importMaterial(aiMaterial *material, TextureResourceArray &texResArray) {
     if (nullptr == material) {
         osre_trace(Tag, "Nullptr for material detected.");
         return;
@@ -463,10 +609,7 @@ void AssimpWrapper::importMaterial(aiMaterial *material) {
 
     i32 texIndex = 0;
     aiString texPath; // contains filename of texture
-    TextureResourceArray texResArray;
-    if (AI_SUCCESS == material->GetTexture(aiTextureType_DIFFUSE, texIndex, &texPath)) {
-        setTexture(mAssetContext.mRoot, texPath, texResArray, TextureStageType::TextureStage0);
-    } 
+    material->GetTexture(aiTextureType_DIFFUSE, texIndex, &texPath);
 
     String matName = texPath.C_Str();
     if (matName.empty()) {
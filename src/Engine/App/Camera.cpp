@@ -21,6 +21,7 @@ IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
 CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
 -----------------------------------------------------------------------------------------------*/
 #include <osre/App/Camera.h>
+#include <osre/Common/Frustum.h>
 #include <osre/Common/Logger.h>
 #include <osre/RenderBackend/RenderBackendService.h>
 #include <osre/Common/glm_common.h>
@@ -131,6 +132,10 @@ const glm::mat4 &Camera::getProjection() const {
     return m_projection;
 }
 
+void Camera::getFrustum(Frustum &frustum) const {
+    frustum.extractFrom(m_projection * m_view);
+}
+
 void Camera::onUpdate(Time) {
     const CameraModel cm = getCameraModel();
     if (cm == CameraModel::Perspective) {
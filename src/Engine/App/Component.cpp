@@ -49,7 +49,7 @@ void Component::render(RenderBackend::RenderBackendService *renderBackendSrv) {
 }
 
 RenderComponent::RenderComponent(Entity *owner, ui32 id) :
-        Component(owner, id, ComponentType::RenderComponentType), m_newGeo() {
+        Component(owner, id, ComponentType::RenderComponentType), m_meshes(), m_numSubmitted(0), m_isVisible(true) {
     // empty
 }
 
@@ -58,7 +58,7 @@ void RenderComponent::addStaticMesh(Mesh *geo) {
         return;
     }
 
-    m_newGeo.add(geo);
+    m_meshes.add(geo);
 }
 
 void RenderComponent::addStaticMeshArray(const RenderBackend::MeshArray &array) {
@@ -67,20 +67,38 @@ void RenderComponent::addStaticMeshArray(const RenderBackend::MeshArray &array)
     }
 
     for (size_t i = 0; i < array.size(); ++i) {
-        m_newGeo.add(array[i]);
+        m_meshes.add(array[i]);
     }
 }
 
 size_t RenderComponent::getNumGeometry() const {
-    return m_newGeo.size();
+    return m_meshes.size();
 }
 
 Mesh *RenderComponent::getMeshAt(size_t idx) const {
-    return m_newGeo[idx];
+    return m_meshes[idx];
 }
 
 void RenderComponent::getMeshArray(RenderBackend::MeshArray &meshArray) {
-    meshArray = m_newGeo;
+    meshArray = m_meshes;
+}
+
+void RenderComponent::setVisible(RenderBackendService *rbSrv, bool visible) {
+    osre_assert(nullptr != rbSrv);
+
+    if (m_isVisible == visible) {
+        return;
+    }
+
+    // Meshes which were not submitted yet will be added by the next render call
+    m_isVisible = visible;
+    for (size_t i = 0; i < m_numSubmitted; ++i) {
+        rbSrv->setMeshVisible(m_meshes[i], visible);
+    }
+}
+
+bool RenderComponent::isVisible() const {
+    return m_isVisible;
 }
 
 bool RenderComponent::onPreprocess() {
@@ -92,12 +110,11 @@ bool RenderComponent::onUpdate(Time) {
 }
 
 bool RenderComponent::onRender(RenderBackendService *renderBackendSrv) {
-    if (!m_newGeo.isEmpty()) {
-        for (ui32 i = 0; i < m_newGeo.size(); i++) {
-            renderBackendSrv->addMesh(m_newGeo[i], 0);
-        }
-        m_newGeo.resize(0);
+    // The batches keep the meshes, so every mesh is submitted only once
+    for (size_t i = m_numSubmitted; i < m_meshes.size(); ++i) {
+        renderBackendSrv->addMesh(m_meshes[i], 0);
     }
+    m_numSubmitted = m_meshes.size();
 
     return true;
 }
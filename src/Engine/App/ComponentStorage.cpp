@@ -0,0 +1,139 @@
+/*-----------------------------------------------------------------------------------------------
+The MIT License (MIT)
+
+Copyright (c) 2015-2022 OSRE ( Open Source Render Engine ) by Kim Kulling
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of
+this software and associated documentation files (the "Software"), to deal in
+the Software without restriction, including without limitation the rights to
+use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+the Software, and to permit persons to whom the Software is furnished to do so,
+subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+-----------------------------------------------------------------------------------------------*/
+#include <osre/App/ComponentStorage.h>
+#include <osre/Common/Logger.h>
+
+namespace OSRE {
+namespace App {
+
+static const c8 *Tag = "ComponentStorage";
+
+ComponentStorage::ComponentStorage() :
+        mRenderComponents(),
+        mTransformComponents(),
+        mLightComponents(),
+        mScriptComponents(),
+        mFreeIds(),
+        mNextId(0) {
+    // empty
+}
+
+ComponentStorage::~ComponentStorage() {
+    if (0 != getNumEntities()) {
+        osre_debug(Tag, "Destroying component storage with living entities.");
+    }
+}
+
+ui32 ComponentStorage::createEntityId() {
+    if (mFreeIds.isEmpty()) {
+        return mNextId++;
+    }
+
+    const ui32 id = mFreeIds.back();
+    mFreeIds.removeBack();
+
+    return id;
+}
+
+void ComponentStorage::releaseEntityId(ui32 entityId) {
+    if (entityId >= mNextId) {
+        osre_error(Tag, "Release of an unknown entity id.");
+        return;
+    }
+
+    mRenderComponents.remove(entityId);
+    mTransformComponents.remove(entityId);
+    mLightComponents.remove(entityId);
+    mScriptComponents.remove(entityId);
+    mFreeIds.add(entityId);
+}
+
+Component *ComponentStorage::createComponent(ui32 entityId, Entity *owner, ComponentType type) {
+    switch (type) {
+        case ComponentType::RenderComponentType:
+            return mRenderComponents.add(entityId, owner, entityId);
+        case ComponentType::TransformComponentType:
+            return mTransformComponents.add(entityId, owner, entityId);
+        case ComponentType::LightComponentType:
+            return mLightComponents.add(entityId, owner, entityId);
+        case ComponentType::ScriptComponentType:
+            return mScriptComponents.add(entityId, owner, entityId);
+        default:
+            break;
+    }
+
+    osre_error(Tag, "Unsupported component type.");
+    return nullptr;
+}
+
+bool ComponentStorage::destroyComponent(ui32 entityId, ComponentType type) {
+    switch (type) {
+        case ComponentType::RenderComponentType:
+            return mRenderComponents.remove(entityId);
+        case ComponentType::TransformComponentType:
+            return mTransformComponents.remove(entityId);
+        case ComponentType::LightComponentType:
+            return mLightComponents.remove(entityId);
+        case ComponentType::ScriptComponentType:
+            return mScriptComponents.remove(entityId);
+        default:
+            break;
+    }
+
+    return false;
+}
+
+Component *ComponentStorage::getComponent(ui32 entityId, ComponentType type) {
+    switch (type) {
+        case ComponentType::RenderComponentType:
+            return mRenderComponents.get(entityId);
+        case ComponentType::TransformComponentType:
+            return mTransformComponents.get(entityId);
+        case ComponentType::LightComponentType:
+            return mLightComponents.get(entityId);
+        case ComponentType::ScriptComponentType:
+            return mScriptComponents.get(entityId);
+        default:
+            break;
+    }
+
+    return nullptr;
+}
+
+void ComponentStorage::update(Time dt) {
+    mRenderComponents.forEachParallel(UpdateChunkSize, [dt](RenderComponent &component) {
+        component.update(dt);
+    });
+    mTransformComponents.forEachParallel(UpdateChunkSize, [dt](TransformComponent &component) {
+        component.update(dt);
+    });
+    mLightComponents.forEachParallel(UpdateChunkSize, [dt](LightComponent &component) {
+        component.update(dt);
+    });
+    mScriptComponents.forEachParallel(UpdateChunkSize, [dt](ScriptComponent &component) {
+        component.update(dt);
+    });
+}
+
+} // Namespace App
+} // Namespace OSRE
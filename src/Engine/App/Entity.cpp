@@ -20,8 +20,10 @@ COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
 IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
 CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
 -----------------------------------------------------------------------------------------------*/
+#include <osre/App/AABBTree.h>
 #include <osre/App/AbstractBehaviour.h>
 #include <osre/App/Component.h>
+#include <osre/App/ComponentStorage.h>
 #include <osre/App/Entity.h>
 #include <osre/App/World.h>
 #include <osre/RenderBackend/MeshProcessor.h>
@@ -35,19 +37,33 @@ using namespace ::OSRE::RenderBackend;
 Entity::Entity(const String &name, const Common::Ids &ids, World *world) :
         Object(name),
         m_behaviour(nullptr),
-        m_renderComponent(nullptr),
+        mStorage(nullptr),
+        mOwnsStorage(false),
+        mEntityId(0),
         m_node(nullptr),
         m_ids(ids),
         m_aabb(),
+        mBoundsProxy(AABBTree::NullNode),
         mOwner(world) {
-    m_renderComponent = new RenderComponent(this, 1);
+    // An entity without a world keeps its components on its own
+    if (nullptr != mOwner) {
+        mStorage = &mOwner->getComponentStorage();
+    } else {
+        mStorage = new ComponentStorage;
+        mOwnsStorage = true;
+    }
+    mEntityId = mStorage->createEntityId();
+    mStorage->createComponent(mEntityId, this, ComponentType::RenderComponentType);
     if (nullptr != mOwner) {
         mOwner->addEntity(this);
     }
 }
 
 Entity::~Entity() {
-    delete m_renderComponent;
+    mStorage->releaseEntityId(mEntityId);
+    if (mOwnsStorage) {
+        delete mStorage;
+    }
     if (nullptr != mOwner) {
         mOwner->removeEntity(this);
     }
@@ -66,8 +82,9 @@ Node *Entity::getNode() const {
 }
 
 bool Entity::preprocess() {
-    if (m_renderComponent != nullptr) {
-        m_renderComponent->preprocess();
+    Component *rc = getComponent(ComponentType::RenderComponentType);
+    if (rc != nullptr) {
+        rc->preprocess();
     }
     return true;
 }
@@ -81,32 +98,40 @@ bool Entity::update(Time dt) {
 }
 
 bool Entity::render(RenderBackend::RenderBackendService *rbSrv) {
-    m_renderComponent->render(rbSrv);
+    Component *rc = getComponent(ComponentType::RenderComponentType);
+    if (nullptr == rc) {
+        return false;
+    }
+    rc->render(rbSrv);
 
     return true;
 }
 
+void Entity::setVisible(RenderBackend::RenderBackendService *rbSrv, bool visible) {
+    RenderComponent *rc = (RenderComponent *)getComponent(ComponentType::RenderComponentType);
+    if (nullptr != rc) {
+        rc->setVisible(rbSrv, visible);
+    }
+}
+
 bool Entity::postprocess() {
-    if (m_renderComponent != nullptr) {
-        m_renderComponent->postprocess();
+    Component *rc = getComponent(ComponentType::RenderComponentType);
+    if (rc != nullptr) {
+        rc->postprocess();
     }
     return true;
 }
 
-Component *Entity::getComponent(ComponentType type) const {
-    switch (type) {
-        case OSRE::App::ComponentType::RenderComponentType:
-            return m_renderComponent;
-        case OSRE::App::ComponentType::ScriptComponentType:
-            break;
-        case OSRE::App::ComponentType::MaxNumComponents:
-        case OSRE::App::ComponentType::InvalidComponent:
-            break;
-        default:
-            break;
-    }
+Component *Entity::createComponent(ComponentType type) {
+    return mStorage->createComponent(mEntityId, this, type);
+}
+
+bool Entity::destroyComponent(ComponentType type) {
+    return mStorage->destroyComponent(mEntityId, type);
+}
 
-    return nullptr;
+Component *Entity::getComponent(ComponentType type) const {
+    return mStorage->getComponent(mEntityId, type);
 }
 
 void Entity::setAABB(const AABB &aabb) {
@@ -117,6 +142,14 @@ const AABB &Entity::getAABB() const {
     return m_aabb;
 }
 
+void Entity::setBoundsProxy(i32 proxyId) {
+    mBoundsProxy = proxyId;
+}
+
+i32 Entity::getBoundsProxy() const {
+    return mBoundsProxy;
+}
+
 void Entity::serialize( IO::Stream *stream ) {
     osre_assert(stream != nullptr);
 }
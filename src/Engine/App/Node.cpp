@@ -44,7 +44,10 @@ Node::Node(const String &name, Ids &ids, Node *parent) :
         m_ids(&ids),
         mPropertyArray(),
         m_propMap(),
-        m_localTransform() {
+        m_localTransform(1.0f),
+        m_worldTransform(1.0f),
+        m_worldTransformDirty(true),
+        m_hasDirtyChildren(false) {
     if (nullptr != m_parent) {
         m_parent->addChild(this);
     }
@@ -63,6 +66,7 @@ Node::~Node() {
 void Node::setParent(Node *parent) {
     // weak reference
     m_parent = parent;
+    setWorldTransformDirty();
 }
 
 Node *Node::getParent() const {
@@ -70,17 +74,15 @@ Node *Node::getParent() const {
 }
 
 Node *Node::createChild(const String &name) {
-    Node *child = new Node(name, *m_ids, this);
-    m_children.add(child);
-    child->get();
-
-    return child;
+    // The constructor adds the new node to its parent
+    return new Node(name, *m_ids, this);
 }
 
 void Node::addChild(Node *child) {
     if (nullptr != child) {
         m_children.add(child);
         child->get();
+        child->setWorldTransformDirty();
     }
 }
 
@@ -97,6 +99,7 @@ bool Node::removeChild(const String &name, TraverseMode mode) {
             if (currentNode->getName() == name) {
                 found = true;
                 m_children.remove(i);
+                currentNode->setParent(nullptr);
                 currentNode->release();
                 break;
             }
@@ -198,14 +201,17 @@ Properties::Property *Node::getProperty(const String name) const {
 
 void Node::translate(const glm::vec3 &pos) {
     m_localTransform = glm::translate(m_localTransform, pos);
+    setWorldTransformDirty();
 }
 
 void Node::scale(const glm::vec3 &scale) {
     m_localTransform = glm::scale(m_localTransform, scale);
+    setWorldTransformDirty();
 }
 
 void Node::rotate(f32 angle, const glm::vec3 &axis) {
     m_localTransform = glm::rotate(m_localTransform, angle, axis);
+    setWorldTransformDirty();
 }
 
 void Node::setRotation(glm::quat &rotation) {
@@ -214,19 +220,69 @@ void Node::setRotation(glm::quat &rotation) {
 
 void Node::setTransformationMatrix(const glm::mat4 &m) {
     m_localTransform = m;
+    setWorldTransformDirty();
 }
 
 const glm::mat4 &Node::getTransformationMatrix() const {
     return m_localTransform;
 }
 
-glm::mat4 Node::getWorlTransformMatrix() {
-    glm::mat4 wt(1.0);
-    for (const Node *node = this; node != nullptr; node = node->getParent()) {
-        wt = node->getTransformationMatrix() * wt;
+const glm::mat4 &Node::getWorlTransformMatrix() {
+    if (m_worldTransformDirty) {
+        if (nullptr != m_parent) {
+            m_worldTransform = m_parent->getWorlTransformMatrix() * m_localTransform;
+        } else {
+            m_worldTransform = m_localTransform;
+        }
+        m_worldTransformDirty = false;
+
+        // The children are still dirty, so the next update must walk down to them
+        m_hasDirtyChildren = !m_children.isEmpty();
+    }
+
+    return m_worldTransform;
+}
+
+void Node::updateWorldTransforms(NodeArray &queue) {
+    // Parents are always visited before their children, so their world transformation is valid.
+    // Clean subtrees without dirty children are skipped.
+    queue.clear();
+    queue.add(this);
+    for (size_t i = 0; i < queue.size(); ++i) {
+        Node *node = queue[i];
+        if (node->m_worldTransformDirty) {
+            node->getWorlTransformMatrix();
+        }
+        if (!node->m_hasDirtyChildren) {
+            continue;
+        }
+        node->m_hasDirtyChildren = false;
+        for (size_t j = 0; j < node->m_children.size(); ++j) {
+            Node *child = node->m_children[j];
+            if (nullptr != child && (child->m_worldTransformDirty || child->m_hasDirtyChildren)) {
+                queue.add(child);
+            }
+        }
+    }
+}
+
+void Node::setWorldTransformDirty() {
+    // Mark the path from the root, so the next update finds this node
+    for (Node *parent = m_parent; nullptr != parent && !parent->m_hasDirtyChildren; parent = parent->m_parent) {
+        parent->m_hasDirtyChildren = true;
+    }
+
+    // A dirty node has only dirty children, so the propagation can stop there
+    if (m_worldTransformDirty) {
+        return;
     }
 
-    return wt;
+    m_worldTransformDirty = true;
+    for (size_t i = 0; i < m_children.size(); ++i) {
+        if (nullptr != m_children[i]) {
+            m_children[i]->setWorldTransformDirty();
+        }
+    }
 }
 
 void Node::onUpdate(Time) {
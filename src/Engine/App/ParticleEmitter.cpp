@@ -113,6 +113,7 @@ void ParticleEmitter::update( d32 /*tick*/ ) {
         ::memcpy( &ptr[ offset ], &m_pos[ i ], sizeof( glm::vec3 ) );
         offset += sizeof( ColorVert );
     }
+    m_ptGeo->invalidateAABB();
 }
 
 void ParticleEmitter::setBounds(const Common::AABB& bounds) {
@@ -22,12 +22,15 @@ CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
 -----------------------------------------------------------------------------------------------*/
 #include <osre/App/Entity.h>
 #include <osre/App/World.h>
+#include <osre/Common/Frustum.h>
 #include <osre/Common/Logger.h>
 #include <osre/Common/StringUtils.h>
 #include <osre/Debugging/osre_debugging.h>
+#include <osre/Profiling/PerformanceCounterRegistry.h>
 #include <osre/RenderBackend/MeshProcessor.h>
 #include <osre/RenderBackend/RenderBackendService.h>
 #include <osre/App/Camera.h>
+#include <osre/App/Node.h>
 
 namespace OSRE {
 namespace App {
@@ -38,6 +41,28 @@ using namespace ::OSRE::RenderBackend;
 
 static const c8 *Tag = "World";
 
+// The extent of entities without bounds, large enough to be never culled
+static constexpr f32 UnboundedExtent = 1.0e30f;
+
+// Transforms a local box into world space, see Arvo, "Transforming Axis-Aligned Bounding Boxes"
+static AABB transformAABB(const AABB &aabb, const glm::mat4 &transform) {
+    const glm::vec3 center = aabb.getCenter();
+    const glm::vec3 extent = (aabb.getMax() - aabb.getMin()) * 0.5f;
+    const glm::vec3 worldCenter = glm::vec3(transform * glm::vec4(center, 1.0f));
+    glm::vec3 worldExtent;
+    for (glm::length_t i = 0; i < 3; ++i) {
+        worldExtent[i] = glm::abs(transform[0][i]) * extent.x + glm::abs(transform[1][i]) * extent.y + glm::abs(transform[2][i]) * extent.z;
+    }
+
+    return AABB(worldCenter - worldExtent, worldCenter + worldExtent);
+}
+
+static void addEntities(const TArray<void *> &found, TArray<Entity *> &entities) {
+    for (size_t i = 0; i < found.size(); ++i) {
+        entities.add(static_cast<Entity *>(found[i]));
+    }
+}
+
 template <class T>
 void lookupMapDeleterFunc(TArray<T> &ctr) {
     for (ui32 i = 0; i < ctr.size(); ++i) {
@@ -58,11 +83,30 @@ World::World(const String &worldName) :
         mRoot(nullptr),
         mIds(),
         mPipeline(nullptr),
+        mComponentStorage(),
+        mBoundingTree(),
+        mCuller(),
+        mCullEntities(),
+        mVisibleEntities(),
+        mTransformQueue(),
         mDirtry(false) {
     // empty
 }
 
 World::~World() {
+    // The entities release their ids in the component storage, so they must go first. The owner
+    // is cleared before, so the entities do not remove themselves from the list.
+    TArray<Entity *> entities;
+    entities = mEntities;
+    mEntities.clear();
+    for (size_t i = 0; i < entities.size(); ++i) {
+        Entity *entity = entities[i];
+        if (nullptr == entity || this != entity->getOwner()) {
+            continue;
+        }
+        entity->setOwner(nullptr);
+        delete entity;
+    }
     ContainerClear<TArray<Camera *>>(mViews, lookupMapDeleterFunc);
     mLookupViews.clear();
     mActiveCamera = nullptr;
@@ -127,6 +171,16 @@ void World::addEntity(Entity *entity) {
         osre_debug(Tag, "Pointer to entity are nullptr");
         return;
     }
+
+    // The components are stored in the storage of the world the entity was created with
+    if (this != entity->getOwner()) {
+        osre_error(Tag, "Entity " + entity->getName() + " was not created for this world.");
+        return;
+    }
+
+    if (mEntities.end() != mEntities.find(entity)) {
+        return;
+    }
     mDirtry = true;
     mEntities.add(entity);
 }
@@ -139,6 +193,10 @@ bool World::removeEntity(Entity *entity) {
     bool found = false;
     CPPCore::TArray<Entity*>::Iterator it = mEntities.find(entity);
     if (mEntities.end() != it) {
+        if (AABBTree::NullNode != entity->getBoundsProxy()) {
+            mBoundingTree.destroyProxy(entity->getBoundsProxy());
+            entity->setBoundsProxy(AABBTree::NullNode);
+        }
         mEntities.remove(it);
         found = true;
         mDirtry = true;
@@ -183,10 +241,15 @@ void World::update(Time dt) {
         updateBoundingTrees();
     }
     for (Entity *entity : mEntities) {
-        if (nullptr == entity) {
+        if (nullptr != entity) {
             entity->update(dt);
         }
     }
+    mComponentStorage.update(dt);
+
+    // Behaviours may have moved the nodes
+    updateTransforms();
+    updateProxies();
 }
 
 void World::draw(RenderBackendService *rbSrv) {
@@ -200,11 +263,36 @@ void World::draw(RenderBackendService *rbSrv) {
         mActiveCamera->draw(rbSrv);
     }
 
-    for (Entity *entity : mEntities) {
-        if (nullptr != entity) {
-            entity->render(rbSrv);
+    // The bounds are only valid if no entity was added or removed since the last update
+    size_t numDrawn = 0, numCulled = 0;
+    if (nullptr != mActiveCamera && !mDirtry) {
+        Frustum frustum;
+        mActiveCamera->getFrustum(frustum);
+        numDrawn = mCuller.cull(frustum, mVisibleEntities);
+        numCulled = mCuller.size() - numDrawn;
+
+        // The batches keep all submitted meshes, so the culled ones get hidden. The visible
+        // indices are in ascending order.
+        size_t next = 0;
+        for (size_t i = 0; i < mCullEntities.size(); ++i) {
+            const bool visible = next < numDrawn && mVisibleEntities[next] == i;
+            mCullEntities[i]->setVisible(rbSrv, visible);
+            if (visible) {
+                mCullEntities[i]->render(rbSrv);
+                ++next;
+            }
+        }
+    } else {
+        for (Entity *entity : mEntities) {
+            if (nullptr != entity) {
+                entity->setVisible(rbSrv, true);
+                entity->render(rbSrv);
+                ++numDrawn;
+            }
         }
     }
+    Profiling::PerformanceCounterRegistry::setCounter("entitiesDrawn", static_cast<ui32>(numDrawn));
+    Profiling::PerformanceCounterRegistry::setCounter("entitiesCulled", static_cast<ui32>(numCulled));
 
     rbSrv->endRenderBatch();
     rbSrv->endPass();
@@ -218,6 +306,9 @@ void World::updateBoundingTrees() {
         }
         MeshProcessor processor;
         RenderComponent *rc = (RenderComponent *)entity->getComponent(ComponentType::RenderComponentType);
+        if (nullptr == rc) {
+            continue;
+        }
         for (ui32 j = 0; j < rc->getNumGeometry(); ++j) {
             processor.addMesh(rc->getMeshAt(j));
         }
@@ -228,5 +319,80 @@ void World::updateBoundingTrees() {
     mDirtry = false;
 }
 
+void World::updateTransforms() {
+    if (nullptr != mRoot) {
+        mRoot->updateWorldTransforms(mTransformQueue);
+    }
+
+    // Imported models are hierarchies of their own
+    for (Entity *entity : mEntities) {
+        if (nullptr == entity) {
+            continue;
+        }
+        Node *node = entity->getNode();
+        if (nullptr != node && nullptr == node->getParent() && node != mRoot) {
+            node->updateWorldTransforms(mTransformQueue);
+        }
+    }
+}
+
+void World::updateProxies() {
+    mCuller.clear();
+    mCullEntities.clear();
+    for (ui32 i = 0; i < mEntities.size(); ++i) {
+        Entity *entity = mEntities[i];
+        if (nullptr == entity) {
+            continue;
+        }
+
+        const AABB &localAABB = entity->getAABB();
+        const i32 proxyId = entity->getBoundsProxy();
+        if (localAABB.getMin().x > localAABB.getMax().x) {
+            // No geometry, so nothing to find, but it must never be culled
+            if (AABBTree::NullNode != proxyId) {
+                mBoundingTree.destroyProxy(proxyId);
+                entity->setBoundsProxy(AABBTree::NullNode);
+            }
+            mCuller.add(AABB(glm::vec3(-UnboundedExtent), glm::vec3(UnboundedExtent)));
+            mCullEntities.add(entity);
+            continue;
+        }
+
+        Node *node = entity->getNode();
+        const AABB worldAABB = nullptr != node ? transformAABB(localAABB, node->getWorlTransformMatrix()) : localAABB;
+        mCuller.add(worldAABB);
+        mCullEntities.add(entity);
+        if (AABBTree::NullNode == proxyId) {
+            entity->setBoundsProxy(mBoundingTree.createProxy(worldAABB, entity));
+        } else {
+            mBoundingTree.moveProxy(proxyId, worldAABB);
+        }
+    }
+}
+
+void World::queryBox(const AABB &box, TArray<Entity *> &entities) const {
+    TArray<void *> found;
+    mBoundingTree.queryBox(box, found);
+    addEntities(found, entities);
+}
+
+void World::querySphere(const glm::vec3 &center, f32 radius, TArray<Entity *> &entities) const {
+    TArray<void *> found;
+    mBoundingTree.querySphere(center, radius, found);
+    addEntities(found, entities);
+}
+
+void World::queryFrustum(const Frustum &frustum, TArray<Entity *> &entities) const {
+    TArray<void *> found;
+    mBoundingTree.queryFrustum(frustum, found);
+    addEntities(found, entities);
+}
+
+void World::queryRay(const Ray &ray, f32 maxDistance, TArray<Entity *> &entities) const {
+    TArray<void *> found;
+    mBoundingTree.queryRay(ray, maxDistance, found);
+    addEntities(found, entities);
+}
+
 } // Namespace App
 } // namespace OSRE
@@ -0,0 +1,133 @@
+/*-----------------------------------------------------------------------------------------------
+The MIT License (MIT)
+
+Copyright (c) 2015-2022 OSRE ( Open Source Render Engine ) by Kim Kulling
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of
+this software and associated documentation files (the "Software"), to deal in
+the Software without restriction, including without limitation the rights to
+use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+the Software, and to permit persons to whom the Software is furnished to do so,
+subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+-----------------------------------------------------------------------------------------------*/
+#include <osre/Common/FreeListAllocator.h>
+
+namespace OSRE {
+namespace Common {
+
+const size_t FreeListAllocator::InvalidOffset;
+
+FreeListAllocator::FreeListAllocator(size_t capacity) :
+        m_freeRanges(),
+        m_allocations(),
+        m_capacity(0),
+        m_used(0) {
+    reset(capacity);
+}
+
+void FreeListAllocator::reset(size_t capacity) {
+    m_freeRanges.clear();
+    m_allocations.clear();
+    m_capacity = capacity;
+    m_used = 0;
+    if (0 != capacity) {
+        Range range = { 0, capacity };
+        m_freeRanges.push_back(range);
+    }
+}
+
+size_t FreeListAllocator::alloc(size_t size, size_t alignment) {
+    if (0 == size) {
+        return InvalidOffset;
+    }
+
+    if (0 == alignment) {
+        alignment = 1;
+    }
+
+    // The free ranges are sorted by their offset, take the first one which fits
+    for (size_t i = 0; i < m_freeRanges.size(); ++i) {
+        Range &range = m_freeRanges[i];
+        const size_t remainder = range.m_offset % alignment;
+        const size_t padding = 0 == remainder ? 0 : alignment - remainder;
+        if (range.m_size < padding + size) {
+            continue;
+        }
+
+        // The padding is kept with the allocation, so release gives it back as well
+        const size_t offset = range.m_offset + padding;
+        Range allocation = { range.m_offset, padding + size };
+        range.m_offset += allocation.m_size;
+        range.m_size -= allocation.m_size;
+        if (0 == range.m_size) {
+            m_freeRanges.erase(m_freeRanges.begin() + i);
+        }
+        m_allocations[offset] = allocation;
+        m_used += allocation.m_size;
+
+        return offset;
+    }
+
+    return InvalidOffset;
+}
+
+bool FreeListAllocator::release(size_t offset) {
+    std::map<size_t, Range>::iterator it = m_allocations.find(offset);
+    if (m_allocations.end() == it) {
+        return false;
+    }
+
+    const Range released = it->second;
+    m_allocations.erase(it);
+    m_used -= released.m_size;
+
+    size_t index = 0;
+    while (index < m_freeRanges.size() && m_freeRanges[index].m_offset < released.m_offset) {
+        ++index;
+    }
+    m_freeRanges.insert(m_freeRanges.begin() + index, released);
+
+    // Merge with the following and the preceding free range
+    if (index + 1 < m_freeRanges.size()) {
+        Range &range = m_freeRanges[index];
+        const Range &next = m_freeRanges[index + 1];
+        if (range.m_offset + range.m_size == next.m_offset) {
+            range.m_size += next.m_size;
+            m_freeRanges.erase(m_freeRanges.begin() + index + 1);
+        }
+    }
+    if (index > 0) {
+        Range &prev = m_freeRanges[index - 1];
+        const Range &range = m_freeRanges[index];
+        if (prev.m_offset + prev.m_size == range.m_offset) {
+            prev.m_size += range.m_size;
+            m_freeRanges.erase(m_freeRanges.begin() + index);
+        }
+    }
+
+    return true;
+}
+
+size_t FreeListAllocator::getLargestFreeRange() const {
+    size_t largest = 0;
+    for (size_t i = 0; i < m_freeRanges.size(); ++i) {
+        if (m_freeRanges[i].m_size > largest) {
+            largest = m_freeRanges[i].m_size;
+        }
+    }
+
+    return largest;
+}
+
+} // Namespace Common
+} // Namespace OSRE
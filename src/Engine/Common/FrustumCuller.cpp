@@ -0,0 +1,178 @@
+/*-----------------------------------------------------------------------------------------------
+The MIT License (MIT)
+
+Copyright (c) 2015-2022 OSRE ( Open Source Render Engine ) by Kim Kulling
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of
+this software and associated documentation files (the "Software"), to deal in
+the Software without restriction, including without limitation the rights to
+use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+the Software, and to permit persons to whom the Software is furnished to do so,
+subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+-----------------------------------------------------------------------------------------------*/
+#include <osre/Common/FrustumCuller.h>
+#include <osre/Common/Frustum.h>
+#include <osre/Debugging/osre_debugging.h>
+
+#if defined(__AVX__)
+#   include <immintrin.h>
+#   define OSRE_CULL_AVX
+#elif defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#   include <emmintrin.h>
+#   define OSRE_CULL_SSE
+#endif
+
+namespace OSRE {
+namespace Common {
+
+using namespace ::CPPCore;
+
+namespace {
+
+// The padding boxes are inverted, so every plane rejects them
+static constexpr f32 EmptyMin = 1.0e30f;
+static constexpr f32 EmptyMax = -1.0e30f;
+
+struct CullPlane {
+    f32 nx, ny, nz, w;
+    const f32 *x;   ///< The component array of the corner furthest along the normal.
+    const f32 *y;
+    const f32 *z;
+};
+
+inline void addVisible(ui32 mask, size_t first, size_t numBoxes, TArray<ui32> &visible) {
+    for (ui32 bit = 0; 0 != mask; ++bit, mask >>= 1) {
+        if (0 != (mask & 1) && first + bit < numBoxes) {
+            visible.add(static_cast<ui32>(first + bit));
+        }
+    }
+}
+
+} // Anonymous namespace
+
+FrustumCuller::FrustumCuller() :
+        mMinX(),
+        mMinY(),
+        mMinZ(),
+        mMaxX(),
+        mMaxY(),
+        mMaxZ(),
+        mNumBoxes(0) {
+    // empty
+}
+
+FrustumCuller::~FrustumCuller() {
+    // empty
+}
+
+size_t FrustumCuller::add(const AABB &aabb) {
+    if (mNumBoxes == mMinX.size()) {
+        for (size_t i = 0; i < BlockSize; ++i) {
+            mMinX.add(EmptyMin);
+            mMinY.add(EmptyMin);
+            mMinZ.add(EmptyMin);
+            mMaxX.add(EmptyMax);
+            mMaxY.add(EmptyMax);
+            mMaxZ.add(EmptyMax);
+        }
+    }
+    set(mNumBoxes, aabb);
+
+    return mNumBoxes++;
+}
+
+void FrustumCuller::set(size_t index, const AABB &aabb) {
+    osre_assert(index < mMinX.size());
+
+    const glm::vec3 &min = aabb.getMin();
+    const glm::vec3 &max = aabb.getMax();
+    mMinX[index] = min.x;
+    mMinY[index] = min.y;
+    mMinZ[index] = min.z;
+    mMaxX[index] = max.x;
+    mMaxY[index] = max.y;
+    mMaxZ[index] = max.z;
+}
+
+void FrustumCuller::clear() {
+    mMinX.clear();
+    mMinY.clear();
+    mMinZ.clear();
+    mMaxX.clear();
+    mMaxY.clear();
+    mMaxZ.clear();
+    mNumBoxes = 0;
+}
+
+size_t FrustumCuller::cull(const Frustum &frustum, TArray<ui32> &visible) const {
+    visible.clear();
+    if (0 == mNumBoxes) {
+        return 0;
+    }
+
+    CullPlane planes[6];
+    for (ui32 i = 0; i < 6; ++i) {
+        const glm::vec4 &plane = frustum.getPlane(i);
+        planes[i].nx = plane.x;
+        planes[i].ny = plane.y;
+        planes[i].nz = plane.z;
+        planes[i].w = plane.w;
+        planes[i].x = plane.x >= 0.0f ? &mMaxX[0] : &mMinX[0];
+        planes[i].y = plane.y >= 0.0f ? &mMaxY[0] : &mMinY[0];
+        planes[i].z = plane.z >= 0.0f ? &mMaxZ[0] : &mMinZ[0];
+    }
+
+    // A box is outside, if its furthest corner is behind any plane
+    const size_t numPadded = mMinX.size();
+#if defined(OSRE_CULL_AVX)
+    const __m256 zero = _mm256_setzero_ps();
+    for (size_t i = 0; i < numPadded; i += 8) {
+        __m256 outside = zero;
+        for (const CullPlane &plane : planes) {
+            __m256 d = _mm256_mul_ps(_mm256_set1_ps(plane.nx), _mm256_loadu_ps(plane.x + i));
+            d = _mm256_add_ps(d, _mm256_mul_ps(_mm256_set1_ps(plane.ny), _mm256_loadu_ps(plane.y + i)));
+            d = _mm256_add_ps(d, _mm256_mul_ps(_mm256_set1_ps(plane.nz), _mm256_loadu_ps(plane.z + i)));
+            d = _mm256_add_ps(d, _mm256_set1_ps(plane.w));
+            outside = _mm256_or_ps(outside, _mm256_cmp_ps(d, zero, _CMP_LT_OQ));
+        }
+        addVisible(~static_cast<ui32>(_mm256_movemask_ps(outside)) & 0xff, i, mNumBoxes, visible);
+    }
+#elif defined(OSRE_CULL_SSE)
+    const __m128 zero = _mm_setzero_ps();
+    for (size_t i = 0; i < numPadded; i += 4) {
+        __m128 outside = zero;
+        for (const CullPlane &plane : planes) {
+            __m128 d = _mm_mul_ps(_mm_set1_ps(plane.nx), _mm_loadu_ps(plane.x + i));
+            d = _mm_add_ps(d, _mm_mul_ps(_mm_set1_ps(plane.ny), _mm_loadu_ps(plane.y + i)));
+            d = _mm_add_ps(d, _mm_mul_ps(_mm_set1_ps(plane.nz), _mm_loadu_ps(plane.z + i)));
+            d = _mm_add_ps(d, _mm_set1_ps(plane.w));
+            outside = _mm_or_ps(outside, _mm_cmplt_ps(d, zero));
+        }
+        addVisible(~static_cast<ui32>(_mm_movemask_ps(outside)) & 0xf, i, mNumBoxes, visible);
+    }
+#else
+    for (size_t i = 0; i < numPadded; ++i) {
+        bool outside = false;
+        for (const CullPlane &plane : planes) {
+            const f32 d = plane.nx * plane.x[i] + plane.ny * plane.y[i] + plane.nz * plane.z[i] + plane.w;
+            outside = outside || d < 0.0f;
+        }
+        addVisible(outside ? 0 : 1, i, mNumBoxes, visible);
+    }
+#endif
+
+    return visible.size();
+}
+
+} // Namespace Common
+} // Namespace OSRE
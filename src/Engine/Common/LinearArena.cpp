@@ -0,0 +1,138 @@
+/*-----------------------------------------------------------------------------------------------
+The MIT License (MIT)
+
+Copyright (c) 2015-2022 OSRE ( Open Source Render Engine ) by Kim Kulling
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of
+this software and associated documentation files (the "Software"), to deal in
+the Software without restriction, including without limitation the rights to
+use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+the Software, and to permit persons to whom the Software is furnished to do so,
+subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+-----------------------------------------------------------------------------------------------*/
+#include <osre/Common/LinearArena.h>
+#include <osre/Debugging/osre_debugging.h>
+
+#include <cstdlib>
+
+namespace OSRE {
+namespace Common {
+
+static size_t alignUp(size_t value, size_t alignment) {
+    return (value + alignment - 1) & ~(alignment - 1);
+}
+
+static c8 *allocBlock(size_t size) {
+    return static_cast<c8 *>(::malloc(size));
+}
+
+LinearArena::LinearArena(size_t capacity) :
+        m_buffer(nullptr),
+        m_capacity(0),
+        m_offset(0),
+        m_used(0),
+        m_highWaterMark(0),
+        m_numOverflows(0),
+        m_overflow(nullptr) {
+    reserve(capacity);
+}
+
+LinearArena::~LinearArena() {
+    clear();
+}
+
+void LinearArena::reserve(size_t capacity) {
+    osre_assert(0 == m_offset);
+
+    capacity = alignUp(capacity, DefaultAlignment);
+    if (capacity <= m_capacity) {
+        return;
+    }
+
+    ::free(m_buffer);
+    m_buffer = allocBlock(capacity);
+    m_capacity = capacity;
+}
+
+void *LinearArena::alloc(size_t size, size_t alignment) {
+    if (0 == size) {
+        return nullptr;
+    }
+
+    osre_assert(0 == (alignment & (alignment - 1)));
+
+    // The block itself is malloc-aligned, so align the absolute address
+    const uintptr_t base = reinterpret_cast<uintptr_t>(m_buffer);
+    const size_t start = alignUp(base + m_offset, alignment) - base;
+    if (nullptr != m_buffer && start + size <= m_capacity) {
+        m_used += (start + size) - m_offset;
+        m_offset = start + size;
+        if (m_used > m_highWaterMark) {
+            m_highWaterMark = m_used;
+        }
+        return m_buffer + start;
+    }
+
+    // Does not fit, use an overflow block which will be freed on the next reset
+    const size_t header = alignUp(sizeof(OverflowBlock), alignment);
+    c8 *block = allocBlock(header + size + alignment);
+    OverflowBlock *overflow = reinterpret_cast<OverflowBlock *>(block);
+    overflow->m_next = m_overflow;
+    m_overflow = overflow;
+    ++m_numOverflows;
+
+    m_used += size;
+    if (m_used > m_highWaterMark) {
+        m_highWaterMark = m_used;
+    }
+    const uintptr_t data = alignUp(reinterpret_cast<uintptr_t>(block) + header, alignment);
+
+    return reinterpret_cast<void *>(data);
+}
+
+bool LinearArena::releaseOverflow() {
+    if (nullptr == m_overflow) {
+        return false;
+    }
+
+    while (nullptr != m_overflow) {
+        OverflowBlock *next = m_overflow->m_next;
+        ::free(m_overflow);
+        m_overflow = next;
+    }
+
+    return true;
+}
+
+void LinearArena::reset() {
+    const bool grow = releaseOverflow();
+    m_offset = 0;
+    m_used = 0;
+
+    if (grow) {
+        // Add some headroom for alignment padding
+        reserve(m_highWaterMark + m_highWaterMark / 4);
+    }
+}
+
+void LinearArena::clear() {
+    releaseOverflow();
+    m_offset = 0;
+    m_used = 0;
+    ::free(m_buffer);
+    m_buffer = nullptr;
+    m_capacity = 0;
+}
+
+} // Namespace Common
+} // Namespace OSRE
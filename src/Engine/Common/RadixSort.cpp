@@ -0,0 +1,85 @@
+/*-----------------------------------------------------------------------------------------------
+The MIT License (MIT)
+
+Copyright (c) 2015-2022 OSRE ( Open Source Render Engine ) by Kim Kulling
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of
+this software and associated documentation files (the "Software"), to deal in
+the Software without restriction, including without limitation the rights to
+use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+the Software, and to permit persons to whom the Software is furnished to do so,
+subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+-----------------------------------------------------------------------------------------------*/
+#include <osre/Common/RadixSort.h>
+#include <osre/Debugging/osre_debugging.h>
+
+#include <cstring>
+
+namespace OSRE {
+namespace Common {
+
+static constexpr ui32 NumDigits = 8;
+static constexpr ui32 NumBuckets = 256;
+
+void radixSort(SortItem *items, SortItem *tmp, size_t numItems) {
+    if (numItems < 2) {
+        return;
+    }
+    osre_assert(nullptr != items);
+    osre_assert(nullptr != tmp);
+
+    // Build all histograms in one pass
+    size_t histograms[NumDigits][NumBuckets];
+    ::memset(histograms, 0, sizeof(histograms));
+    for (size_t i = 0; i < numItems; ++i) {
+        const ui64 key = items[i].m_key;
+        for (ui32 digit = 0; digit < NumDigits; ++digit) {
+            ++histograms[digit][(key >> (digit * 8)) & 0xff];
+        }
+    }
+
+    SortItem *src = items;
+    SortItem *dst = tmp;
+    for (ui32 digit = 0; digit < NumDigits; ++digit) {
+        size_t *histogram = histograms[digit];
+
+        // All keys share this digit, nothing to do
+        const ui32 firstBucket = static_cast<ui32>((src[0].m_key >> (digit * 8)) & 0xff);
+        if (histogram[firstBucket] == numItems) {
+            continue;
+        }
+
+        size_t offset = 0;
+        for (ui32 bucket = 0; bucket < NumBuckets; ++bucket) {
+            const size_t count = histogram[bucket];
+            histogram[bucket] = offset;
+            offset += count;
+        }
+
+        for (size_t i = 0; i < numItems; ++i) {
+            const ui32 bucket = static_cast<ui32>((src[i].m_key >> (digit * 8)) & 0xff);
+            dst[histogram[bucket]++] = src[i];
+        }
+
+        SortItem *swap = src;
+        src = dst;
+        dst = swap;
+    }
+
+    if (src != items) {
+        ::memcpy(items, src, sizeof(SortItem) * numItems);
+    }
+}
+
+} // Namespace Common
+} // Namespace OSRE
@@ -67,7 +67,7 @@ bool FileStream::open() {
     const String &abspath = m_Uri.getAbsPath();
     String modestr;
     AccessMode mode = getAccessMode();
-    if (AccessMode::ReadAccessBinary == mode) {
+    if (AccessMode::ReadAccessBinary == mode || AccessMode::ReadAccessMapped == mode) {
         modestr = "rb";
     } else if (AccessMode::WriteAccessBinary == mode) {
         modestr = "wb";
@@ -0,0 +1,231 @@
+/*-----------------------------------------------------------------------------------------------
+The MIT License (MIT)
+
+Copyright (c) 2015-2022 OSRE ( Open Source Render Engine ) by Kim Kulling
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of
+this software and associated documentation files (the "Software"), to deal in
+the Software without restriction, including without limitation the rights to
+use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+the Software, and to permit persons to whom the Software is furnished to do so,
+subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+-----------------------------------------------------------------------------------------------*/
+#include "MappedFileStream.h"
+
+#include <osre/Common/Logger.h>
+#include <osre/Debugging/osre_debugging.h>
+
+#include <cstring>
+
+#ifdef OSRE_WINDOWS
+#   include <osre/Platform/Windows/MinWindows.h>
+#else
+#   include <fcntl.h>
+#   include <sys/mman.h>
+#   include <sys/stat.h>
+#   include <unistd.h>
+#endif
+
+namespace OSRE {
+namespace IO {
+
+static const c8 *Tag = "MappedFileStream";
+
+MappedFileStream::MappedFileStream() noexcept :
+        Stream(),
+        m_data(nullptr),
+        m_size(0),
+        m_pos(0)
+#ifdef OSRE_WINDOWS
+        , m_fileHandle(nullptr),
+        m_mappingHandle(nullptr)
+#endif
+{
+    // empty
+}
+
+MappedFileStream::MappedFileStream(const Uri &uri) :
+        Stream(uri, AccessMode::ReadAccessMapped),
+        m_data(nullptr),
+        m_size(0),
+        m_pos(0)
+#ifdef OSRE_WINDOWS
+        , m_fileHandle(nullptr),
+        m_mappingHandle(nullptr)
+#endif
+{
+    // empty
+}
+
+MappedFileStream::~MappedFileStream() {
+    if (isOpen()) {
+        MappedFileStream::close();
+    }
+}
+
+bool MappedFileStream::canRead() const {
+    return true;
+}
+
+bool MappedFileStream::canWrite() const {
+    return false;
+}
+
+bool MappedFileStream::canSeek() const {
+    return true;
+}
+
+bool MappedFileStream::canBeMapped() const {
+    return true;
+}
+
+const void *MappedFileStream::map() {
+    return m_data;
+}
+
+bool MappedFileStream::open() {
+    if (isOpen()) {
+        return false;
+    }
+
+    const String &abspath = m_Uri.getAbsPath();
+#ifdef OSRE_WINDOWS
+    HANDLE file = ::CreateFileA(abspath.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING,
+            FILE_ATTRIBUTE_NORMAL | FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+    if (INVALID_HANDLE_VALUE == file) {
+        return false;
+    }
+
+    LARGE_INTEGER size;
+    if (!::GetFileSizeEx(file, &size) || 0 == size.QuadPart) {
+        ::CloseHandle(file);
+        return false;
+    }
+
+    HANDLE mapping = ::CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+    if (nullptr == mapping) {
+        ::CloseHandle(file);
+        osre_error(Tag, "Cannot create mapping for " + abspath);
+        return false;
+    }
+
+    m_data = static_cast<const uc8 *>(::MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0));
+    if (nullptr == m_data) {
+        ::CloseHandle(mapping);
+        ::CloseHandle(file);
+        osre_error(Tag, "Cannot map " + abspath);
+        return false;
+    }
+    m_fileHandle = file;
+    m_mappingHandle = mapping;
+    m_size = static_cast<size_t>(size.QuadPart);
+#else
+    const int fd = ::open(abspath.c_str(), O_RDONLY);
+    if (-1 == fd) {
+        return false;
+    }
+
+    struct stat fileStat;
+    if (0 != ::fstat(fd, &fileStat) || 0 == fileStat.st_size) {
+        ::close(fd);
+        return false;
+    }
+
+    // The mapping stays valid after the descriptor was closed
+    void *data = ::mmap(nullptr, static_cast<size_t>(fileStat.st_size), PROT_READ, MAP_PRIVATE | MAP_POPULATE, fd, 0);
+    ::close(fd);
+    if (MAP_FAILED == data) {
+        osre_error(Tag, "Cannot map " + abspath);
+        return false;
+    }
+    m_data = static_cast<const uc8 *>(data);
+    m_size = static_cast<size_t>(fileStat.st_size);
+#endif
+    m_pos = 0;
+
+    return true;
+}
+
+bool MappedFileStream::close() {
+    if (!isOpen()) {
+        return false;
+    }
+
+#ifdef OSRE_WINDOWS
+    ::UnmapViewOfFile(m_data);
+    ::CloseHandle(m_mappingHandle);
+    ::CloseHandle(m_fileHandle);
+    m_mappingHandle = nullptr;
+    m_fileHandle = nullptr;
+#else
+    ::munmap(const_cast<uc8 *>(m_data), m_size);
+#endif
+    m_data = nullptr;
+    m_size = 0;
+    m_pos = 0;
+
+    return true;
+}
+
+size_t MappedFileStream::getSize() const {
+    return m_size;
+}
+
+size_t MappedFileStream::read(void *buffer, size_t size) {
+    if (nullptr == buffer || 0 == size || !isOpen()) {
+        return 0;
+    }
+
+    if (size > m_size - m_pos) {
+        size = m_size - m_pos;
+    }
+    ::memcpy(buffer, m_data + m_pos, size);
+    m_pos += size;
+
+    return size;
+}
+
+size_t MappedFileStream::readI32(i32 &value) {
+    return read(&value, sizeof(i32)) / sizeof(i32);
+}
+
+size_t MappedFileStream::readUI32(ui32 &value) {
+    return read(&value, sizeof(ui32)) / sizeof(ui32);
+}
+
+size_t MappedFileStream::readF32(f32 &value) {
+    return read(&value, sizeof(f32)) / sizeof(f32);
+}
+
+MappedFileStream::Position MappedFileStream::seek(Offset offset, Origin origin) {
+    size_t pos = offset;
+    if (Origin::Current == origin) {
+        pos += m_pos;
+    } else if (Origin::End == origin) {
+        pos = m_size;
+    }
+    m_pos = pos > m_size ? m_size : pos;
+
+    return static_cast<Position>(m_pos);
+}
+
+MappedFileStream::Position MappedFileStream::tell() {
+    return static_cast<Position>(m_pos);
+}
+
+bool MappedFileStream::isOpen() const {
+    return nullptr != m_data;
+}
+
+} // Namespace IO
+} // Namespace OSRE
@@ -0,0 +1,86 @@
+/*-----------------------------------------------------------------------------------------------
+The MIT License (MIT)
+
+Copyright (c) 2015-2022 OSRE ( Open Source Render Engine ) by Kim Kulling
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of
+this software and associated documentation files (the "Software"), to deal in
+the Software without restriction, including without limitation the rights to
+use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+the Software, and to permit persons to whom the Software is furnished to do so,
+subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+-----------------------------------------------------------------------------------------------*/
+#pragma once
+
+#include <osre/IO/Stream.h>
+
+namespace OSRE {
+namespace IO {
+
+//--------------------------------------------------------------------------------------------------------------------
+///	@ingroup	Infrastructure
+///
+///	@brief	This class implements a read-only file stream, which maps the whole file into memory when opened.
+///	Reads are copies out of the mapping, map() gives access to the content without any copy.
+//--------------------------------------------------------------------------------------------------------------------
+class MappedFileStream : public Stream {
+public:
+    /// The default class constructor.
+    MappedFileStream() noexcept;
+    /// The class constructor with URI.
+    explicit MappedFileStream(const Uri &uri);
+    /// The class destructor.
+    ~MappedFileStream() override;
+    /// true, the file is readable.
+    bool canRead() const override;
+    /// false, the mapping is read-only.
+    bool canWrite() const override;
+    /// true, seeking moves inside the mapping.
+    bool canSeek() const override;
+    /// true, the content is mapped.
+    bool canBeMapped() const override;
+    /// Returns the mapped content.
+    const void *map() override;
+    /// Opens and maps the file.
+    bool open() override;
+    /// Unmaps and closes the file.
+    bool close() override;
+    /// Returns file size.
+    size_t getSize() const override;
+    /// Reads from the mapping.
+    size_t read(void *buffer, size_t size) override;
+    /// Reads a single integer value.
+    size_t readI32(i32 &value) override;
+    /// Reads a single unsigned integer value.
+    size_t readUI32(ui32 &value) override;
+    /// Reads a single float value.
+    size_t readF32(f32 &value) override;
+    /// Moves to given position.
+    Position seek(Offset offset, Origin origin) override;
+    /// Position in the file.
+    Position tell() override;
+    /// Returns true, when the file is mapped.
+    bool isOpen() const override;
+
+private:
+    const uc8 *m_data;
+    size_t m_size;
+    size_t m_pos;
+#ifdef OSRE_WINDOWS
+    void *m_fileHandle;
+    void *m_mappingHandle;
+#endif
+};
+
+} // Namespace IO
+} // Namespace OSRE
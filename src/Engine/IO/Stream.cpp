@@ -63,6 +63,10 @@ bool Stream::canBeMapped() const {
     return false;
 }
 
+const void *Stream::map() {
+    return nullptr;
+}
+
 void Stream::setAccessMode(AccessMode accessMode) {
     m_AccessMode = accessMode;
 }
@@ -33,6 +33,7 @@ CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
 #endif
 
 #include <sstream>
+#include <thread>
 
 namespace OSRE {
 namespace Platform {
@@ -82,6 +83,16 @@ void SystemInfo::getMemoryStatus( ui32 &totalPhysicMem, ui32 &memInUse ) {
 #endif
 }
 
+ui32 SystemInfo::getNumCPUCores() {
+    // hardware_concurrency is allowed to return 0 when the number is not computable
+    const ui32 numCores = static_cast<ui32>( std::thread::hardware_concurrency() );
+    if ( 0 == numCores ) {
+        return 1;
+    }
+
+    return numCores;
+}
+
 bool SystemInfo::registerThreadName( const ThreadId &id, const String &name ) {
     ThreadNameMap::const_iterator it( s_threadNames.find( id.Id) );
     bool success( true );
@@ -23,6 +23,8 @@ CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
 #include <osre/Profiling/PerformanceCounterRegistry.h>
 #include <osre/Common/StringUtils.h>
 
+#include <mutex>
+
 namespace OSRE {
 namespace Profiling {
 
@@ -30,6 +32,9 @@ using namespace ::OSRE::Common;
 
 PerformanceCounterRegistry *PerformanceCounterRegistry::s_instance = nullptr;
 
+// Guards the instance and all counters
+static std::mutex s_lock;
+
 PerformanceCounterRegistry::CounterMeasure::CounterMeasure() : m_count( 0 ) {
     // empty
 }
@@ -38,15 +43,21 @@ PerformanceCounterRegistry::CounterMeasure::~CounterMeasure() {
     // empty
 }
 
-PerformanceCounterRegistry::PerformanceCounterRegistry() : m_counters() {
+PerformanceCounterRegistry::PerformanceCounterRegistry() :
+        m_counters(),
+        m_measures() {
     // empty
 }
     
 PerformanceCounterRegistry::~PerformanceCounterRegistry() {
-    // empty
+    for (size_t i = 0; i < m_measures.size(); ++i) {
+        delete m_measures[i];
+    }
+    m_measures.clear();
 }
     
 bool PerformanceCounterRegistry::create() {
+    std::lock_guard<std::mutex> lock(s_lock);
     if ( nullptr != s_instance ) {
         return false;
     }
@@ -57,6 +68,7 @@ bool PerformanceCounterRegistry::create() {
 }
 
 bool PerformanceCounterRegistry::destroy() {
+    std::lock_guard<std::mutex> lock(s_lock);
     if ( nullptr == s_instance ) {
         return false;
     }
@@ -68,6 +80,7 @@ bool PerformanceCounterRegistry::destroy() {
 }
 
 bool PerformanceCounterRegistry::registerCounter(const String &name) {
+    std::lock_guard<std::mutex> lock(s_lock);
     if ( nullptr == s_instance ) {
         return false;
     }
@@ -78,11 +91,13 @@ bool PerformanceCounterRegistry::registerCounter(const String &name) {
     }
     CounterMeasure *cm = new CounterMeasure;
     s_instance->m_counters.insert(hash, cm);
+    s_instance->m_measures.add(cm);
 
     return true;
 }
     
 bool PerformanceCounterRegistry::unregisterCounter(const String &name) {
+    std::lock_guard<std::mutex> lock(s_lock);
     if (nullptr == s_instance) {
         return false;
     }
@@ -98,12 +113,17 @@ bool PerformanceCounterRegistry::unregisterCounter(const String &name) {
     if ( nullptr == cm ) {
         return false;
     } 
+    CPPCore::TArray<CounterMeasure*>::Iterator it = s_instance->m_measures.find(cm);
+    if (s_instance->m_measures.end() != it) {
+        s_instance->m_measures.remove(it);
+    }
     delete cm;
 
     return s_instance->m_counters.remove(hash);
 }
 
 bool PerformanceCounterRegistry::setCounter( const String &name, ui32 value ) {
+    std::lock_guard<std::mutex> lock(s_lock);
     if ( nullptr == s_instance ) {
         return false;
     }
@@ -124,6 +144,7 @@ bool PerformanceCounterRegistry::resetCounter( const String &name ) {
 }
 
 bool PerformanceCounterRegistry::addValueToCounter( const String &name, ui32 value ) {
+    std::lock_guard<std::mutex> lock(s_lock);
     if ( nullptr == s_instance ) {
         return false;
     }
@@ -145,6 +166,7 @@ bool PerformanceCounterRegistry::addValueToCounter( const String &name, ui32 val
 }
 
 bool PerformanceCounterRegistry::queryCounter( const String &name, ui32 &counterValue ) {
+    std::lock_guard<std::mutex> lock(s_lock);
     if (nullptr == s_instance) {
         return false;
     }
@@ -56,7 +56,8 @@ static const c8 *ConfigKeyStringTable[Settings::MaxKonfigKey] = {
     "PollingMode",
     "DefaultFont",
     "RenderMode",
-    "PluginDllName"
+    "PluginDllName",
+    "FramesInFlight"
 };
 
 Settings::Settings() :
@@ -228,6 +229,9 @@ void Settings::initDefaults() {
 
     value.setInt( 1 );
     m_propertyMap->setProperty( RenderMode, ConfigKeyStringTable[ RenderMode], value );
+
+    value.setInt( 1 );
+    m_propertyMap->setProperty( FramesInFlight, ConfigKeyStringTable[ FramesInFlight ], value );
 }
 
 } // Namespace Properties
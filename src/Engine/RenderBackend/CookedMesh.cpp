@@ -0,0 +1,306 @@
+/*-----------------------------------------------------------------------------------------------
+The MIT License (MIT)
+
+Copyright (c) 2015-2022 OSRE ( Open Source Render Engine ) by Kim Kulling
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of
+this software and associated documentation files (the "Software"), to deal in
+the Software without restriction, including without limitation the rights to
+use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+the Software, and to permit persons to whom the Software is furnished to do so,
+subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+-----------------------------------------------------------------------------------------------*/
+#include <osre/RenderBackend/CookedMesh.h>
+#include <osre/RenderBackend/Material.h>
+#include <osre/RenderBackend/Mesh.h>
+#include <osre/RenderBackend/MeshProcessor.h>
+#include <osre/Common/glm_common.h>
+#include <osre/Common/Logger.h>
+#include <osre/IO/Stream.h>
+
+#include <cstring>
+#include <vector>
+
+namespace OSRE {
+namespace RenderBackend {
+
+using namespace ::OSRE::Common;
+
+static const c8 *Tag = "CookedMesh";
+
+namespace {
+
+struct CookedHeader {
+    ui32 mMagic;
+    ui32 mVersion;
+    ui32 mNumMeshes;
+    ui32 mReserved;
+};
+
+struct CookedMeshEntry {
+    ui64 mNameOffset;
+    ui64 mMaterialOffset;
+    ui32 mNameLength;
+    ui32 mMaterialLength;
+    i32 mVertexType;
+    i32 mIndexType;
+    ui32 mVertexAccess;
+    ui32 mIndexAccess;
+    ui32 mNumPrimGroups;
+    ui32 mIsLocal;
+    ui64 mVertexOffset;
+    ui64 mVertexSize;
+    ui64 mIndexOffset;
+    ui64 mIndexSize;
+    ui64 mPrimGroupOffset;
+    f32 mAabbMin[3];
+    f32 mAabbMax[3];
+    f32 mModel[16];
+};
+
+struct CookedPrimGroup {
+    ui32 mPrimitive;
+    ui32 mIndexType;
+    ui32 mStartIndex;
+    ui32 mNumIndices;
+};
+
+static_assert(sizeof(CookedHeader) % CookedMesh::Alignment == 0, "Header breaks the alignment.");
+static_assert(sizeof(CookedMeshEntry) % CookedMesh::Alignment == 0, "Mesh entry breaks the alignment.");
+static_assert(sizeof(CookedPrimGroup) % CookedMesh::Alignment == 0, "Primitive group breaks the alignment.");
+
+} // Anonymous namespace
+
+static ui64 alignOffset(ui64 offset) {
+    return (offset + CookedMesh::Alignment - 1) & ~static_cast<ui64>(CookedMesh::Alignment - 1);
+}
+
+static bool writePadded(IO::Stream &stream, const void *data, size_t size, ui64 &offset) {
+    static const uc8 Zeros[CookedMesh::Alignment] = {};
+    if (0 != size && stream.write(data, size) != size) {
+        return false;
+    }
+    offset += size;
+    const size_t padding = static_cast<size_t>(alignOffset(offset) - offset);
+    if (0 != padding && stream.write(Zeros, padding) != padding) {
+        return false;
+    }
+    offset += padding;
+
+    return true;
+}
+
+static bool isInFile(ui64 offset, ui64 size, size_t fileSize) {
+    return offset <= fileSize && size <= fileSize - offset;
+}
+
+static size_t getBufferSize(const BufferData *buffer) {
+    return nullptr != buffer ? buffer->getSize() : 0;
+}
+
+bool CookedMesh::save(const MeshArray &meshes, IO::Stream &stream) {
+    const ui32 numMeshes = static_cast<ui32>(meshes.size());
+    for (ui32 i = 0; i < numMeshes; ++i) {
+        if (nullptr == meshes[i]) {
+            osre_error(Tag, "Invalid mesh in mesh array.");
+            return false;
+        }
+    }
+
+    // First pass: compute the layout of all sections
+    std::vector<CookedMeshEntry> entries(numMeshes);
+    std::vector<String> materialNames(numMeshes);
+    ui64 offset = alignOffset(sizeof(CookedHeader) + sizeof(CookedMeshEntry) * numMeshes);
+    for (ui32 i = 0; i < numMeshes; ++i) {
+        Mesh *mesh = meshes[i];
+        CookedMeshEntry &entry = entries[i];
+        ::memset(&entry, 0, sizeof(CookedMeshEntry));
+        if (nullptr != mesh->getMaterial()) {
+            materialNames[i] = mesh->getMaterial()->m_name;
+        }
+
+        BufferData *vb = mesh->getVertexBuffer();
+        BufferData *ib = mesh->getIndexBuffer();
+        entry.mNameLength = static_cast<ui32>(mesh->getName().size());
+        entry.mMaterialLength = static_cast<ui32>(materialNames[i].size());
+        entry.mVertexType = static_cast<i32>(mesh->getVertexType());
+        entry.mIndexType = static_cast<i32>(mesh->getIndexType());
+        entry.mVertexAccess = static_cast<ui32>(nullptr != vb ? vb->getBufferAccessType() : BufferAccessType::ReadOnly);
+        entry.mIndexAccess = static_cast<ui32>(nullptr != ib ? ib->getBufferAccessType() : BufferAccessType::ReadOnly);
+        entry.mNumPrimGroups = static_cast<ui32>(mesh->getNumberOfPrimitiveGroups());
+        entry.mIsLocal = mesh->isLocal() ? 1 : 0;
+        ::memcpy(entry.mModel, glm::value_ptr(mesh->getLocalMatrix()), sizeof(entry.mModel));
+
+        // Store the bounds, so loading never touches the vertices
+        AABB aabb = mesh->getAABB();
+        const size_t stride = Mesh::getVertexSize(mesh->getVertexType());
+        if (mesh->isAABBDirty() && nullptr != vb && 0 != stride) {
+            aabb.reset();
+            MeshProcessor::computeAABB(reinterpret_cast<const uc8 *>(vb->getData()), vb->getSize() / stride, stride, aabb);
+        }
+        ::memcpy(entry.mAabbMin, &aabb.getMin()[0], sizeof(entry.mAabbMin));
+        ::memcpy(entry.mAabbMax, &aabb.getMax()[0], sizeof(entry.mAabbMax));
+
+        entry.mNameOffset = offset;
+        offset = alignOffset(offset + entry.mNameLength);
+        entry.mMaterialOffset = offset;
+        offset = alignOffset(offset + entry.mMaterialLength);
+        entry.mVertexOffset = offset;
+        entry.mVertexSize = getBufferSize(vb);
+        offset = alignOffset(offset + entry.mVertexSize);
+        entry.mIndexOffset = offset;
+        entry.mIndexSize = getBufferSize(ib);
+        offset = alignOffset(offset + entry.mIndexSize);
+        entry.mPrimGroupOffset = offset;
+        offset = alignOffset(offset + sizeof(CookedPrimGroup) * entry.mNumPrimGroups);
+    }
+
+    // Second pass: write everything in the same order
+    CookedHeader header = { Magic, Version, numMeshes, 0 };
+    ui64 written = 0;
+    bool ok = writePadded(stream, &header, sizeof(CookedHeader), written);
+    if (0 != numMeshes) {
+        ok = ok && writePadded(stream, entries.data(), sizeof(CookedMeshEntry) * numMeshes, written);
+    }
+    std::vector<CookedPrimGroup> groups;
+    for (ui32 i = 0; ok && i < numMeshes; ++i) {
+        Mesh *mesh = meshes[i];
+        const CookedMeshEntry &entry = entries[i];
+        osre_assert(written == entry.mNameOffset);
+        ok = writePadded(stream, mesh->getName().c_str(), entry.mNameLength, written);
+        ok = ok && writePadded(stream, materialNames[i].c_str(), entry.mMaterialLength, written);
+        if (ok && 0 != entry.mVertexSize) {
+            ok = writePadded(stream, mesh->getVertexBuffer()->getData(), static_cast<size_t>(entry.mVertexSize), written);
+        }
+        if (ok && 0 != entry.mIndexSize) {
+            ok = writePadded(stream, mesh->getIndexBuffer()->getData(), static_cast<size_t>(entry.mIndexSize), written);
+        }
+
+        groups.resize(entry.mNumPrimGroups);
+        for (ui32 j = 0; j < entry.mNumPrimGroups; ++j) {
+            const PrimitiveGroup *group = mesh->getPrimitiveGroupAt(j);
+            groups[j].mPrimitive = static_cast<ui32>(group->m_primitive);
+            groups[j].mIndexType = static_cast<ui32>(group->m_indexType);
+            groups[j].mStartIndex = static_cast<ui32>(group->m_startIndex);
+            groups[j].mNumIndices = static_cast<ui32>(group->m_numIndices);
+        }
+        if (ok && !groups.empty()) {
+            ok = writePadded(stream, groups.data(), sizeof(CookedPrimGroup) * groups.size(), written);
+        }
+    }
+
+    if (!ok) {
+        osre_error(Tag, "Error while writing the cooked meshes.");
+    }
+
+    return ok;
+}
+
+bool CookedMesh::load(IO::Stream &stream, MeshArray &meshes, CPPCore::TArray<String> *materialRefs) {
+    const uc8 *data = static_cast<const uc8 *>(stream.map());
+    if (nullptr != data) {
+        return load(data, stream.getSize(), meshes, materialRefs);
+    }
+
+    // Not mappable, so read the whole content at once
+    const size_t size = stream.getSize();
+    std::vector<uc8> content(size);
+    if (0 == size || stream.read(content.data(), size) != size) {
+        osre_error(Tag, "Cannot read cooked meshes from " + stream.getUri().getAbsPath());
+        return false;
+    }
+
+    return load(content.data(), size, meshes, materialRefs);
+}
+
+bool CookedMesh::load(const uc8 *data, size_t size, MeshArray &meshes, CPPCore::TArray<String> *materialRefs) {
+    if (nullptr == data || size < sizeof(CookedHeader)) {
+        osre_error(Tag, "Invalid cooked mesh data.");
+        return false;
+    }
+
+    CookedHeader header;
+    ::memcpy(&header, data, sizeof(CookedHeader));
+    if (Magic != header.mMagic) {
+        osre_error(Tag, "Data is not a cooked mesh file.");
+        return false;
+    }
+    if (Version != header.mVersion) {
+        osre_error(Tag, "Unsupported cooked mesh version.");
+        return false;
+    }
+    if (!isInFile(sizeof(CookedHeader), static_cast<ui64>(sizeof(CookedMeshEntry)) * header.mNumMeshes, size)) {
+        osre_error(Tag, "Cooked mesh file is truncated.");
+        return false;
+    }
+
+    // Validate all entries first, so a broken file does not leave half of the meshes behind
+    const uc8 *entryData = data + sizeof(CookedHeader);
+    for (ui32 i = 0; i < header.mNumMeshes; ++i) {
+        CookedMeshEntry entry;
+        ::memcpy(&entry, entryData + i * sizeof(CookedMeshEntry), sizeof(CookedMeshEntry));
+        const bool valid = isInFile(entry.mNameOffset, entry.mNameLength, size) &&
+                isInFile(entry.mMaterialOffset, entry.mMaterialLength, size) &&
+                isInFile(entry.mVertexOffset, entry.mVertexSize, size) &&
+                isInFile(entry.mIndexOffset, entry.mIndexSize, size) &&
+                isInFile(entry.mPrimGroupOffset, static_cast<ui64>(sizeof(CookedPrimGroup)) * entry.mNumPrimGroups, size) &&
+                entry.mVertexType >= 0 && entry.mVertexType < static_cast<i32>(VertexType::NumVertexTypes) &&
+                entry.mIndexType >= 0 && entry.mIndexType < static_cast<i32>(IndexType::NumIndexTypes);
+        if (!valid) {
+            osre_error(Tag, "Cooked mesh file is corrupt.");
+            return false;
+        }
+    }
+
+    for (ui32 i = 0; i < header.mNumMeshes; ++i) {
+        CookedMeshEntry entry;
+        ::memcpy(&entry, entryData + i * sizeof(CookedMeshEntry), sizeof(CookedMeshEntry));
+        const String name(reinterpret_cast<const c8 *>(data + entry.mNameOffset), entry.mNameLength);
+        Mesh *mesh = new Mesh(name, static_cast<VertexType>(entry.mVertexType), static_cast<IndexType>(entry.mIndexType));
+        if (0 != entry.mVertexSize) {
+            mesh->createVertexBuffer(const_cast<uc8 *>(data + entry.mVertexOffset), static_cast<size_t>(entry.mVertexSize),
+                    static_cast<BufferAccessType>(entry.mVertexAccess));
+        }
+        if (0 != entry.mIndexSize) {
+            mesh->createIndexBuffer(const_cast<uc8 *>(data + entry.mIndexOffset), static_cast<size_t>(entry.mIndexSize),
+                    static_cast<IndexType>(entry.mIndexType), static_cast<BufferAccessType>(entry.mIndexAccess));
+        }
+        const uc8 *groupData = data + entry.mPrimGroupOffset;
+        for (ui32 j = 0; j < entry.mNumPrimGroups; ++j) {
+            CookedPrimGroup groupEntry;
+            ::memcpy(&groupEntry, groupData + j * sizeof(CookedPrimGroup), sizeof(CookedPrimGroup));
+            PrimitiveGroup *group = new PrimitiveGroup;
+            group->m_primitive = static_cast<PrimitiveType>(groupEntry.mPrimitive);
+            group->m_indexType = static_cast<IndexType>(groupEntry.mIndexType);
+            group->m_startIndex = groupEntry.mStartIndex;
+            group->m_numIndices = groupEntry.mNumIndices;
+            mesh->addPrimitiveGroup(group);
+        }
+
+        glm::mat4 model;
+        ::memcpy(glm::value_ptr(model), entry.mModel, sizeof(entry.mModel));
+        mesh->setModelMatrix(0 != entry.mIsLocal, model);
+        mesh->setAABB(AABB(glm::vec3(entry.mAabbMin[0], entry.mAabbMin[1], entry.mAabbMin[2]),
+                glm::vec3(entry.mAabbMax[0], entry.mAabbMax[1], entry.mAabbMax[2])));
+        meshes.add(mesh);
+
+        if (nullptr != materialRefs) {
+            materialRefs->add(String(reinterpret_cast<const c8 *>(data + entry.mMaterialOffset), entry.mMaterialLength));
+        }
+    }
+
+    return true;
+}
+
+} // Namespace RenderBackend
+} // Namespace OSRE
@@ -0,0 +1,262 @@
+/*-----------------------------------------------------------------------------------------------
+The MIT License (MIT)
+
+Copyright (c) 2015-2022 OSRE ( Open Source Render Engine ) by Kim Kulling
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of
+this software and associated documentation files (the "Software"), to deal in
+the Software without restriction, including without limitation the rights to
+use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+the Software, and to permit persons to whom the Software is furnished to do so,
+subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+-----------------------------------------------------------------------------------------------*/
+#include <osre/RenderBackend/CookedTexture.h>
+#include <osre/RenderBackend/TextureCompression.h>
+#include <osre/Common/Logger.h>
+#include <osre/IO/Stream.h>
+
+#include <cstdlib>
+#include <cstring>
+#include <vector>
+
+namespace OSRE {
+namespace RenderBackend {
+
+static const c8 *Tag = "CookedTexture";
+
+const c8 *CookedTexture::Extension = "ostc";
+
+namespace {
+
+struct CookedHeader {
+    ui32 mMagic;
+    ui32 mVersion;
+    i32 mPixelFormat;
+    ui32 mWidth;
+    ui32 mHeight;
+    ui32 mChannels;
+    ui32 mNumMipLevels;
+    ui32 mReserved;
+};
+
+struct CookedMipLevel {
+    ui64 mOffset;
+    ui64 mSize;
+};
+
+static_assert(sizeof(CookedHeader) % CookedTexture::Alignment == 0, "Header breaks the alignment.");
+static_assert(sizeof(CookedMipLevel) % CookedTexture::Alignment == 0, "Mip level entry breaks the alignment.");
+
+} // Anonymous namespace
+
+static ui64 alignOffset(ui64 offset) {
+    return (offset + CookedTexture::Alignment - 1) & ~static_cast<ui64>(CookedTexture::Alignment - 1);
+}
+
+static bool writePadded(IO::Stream &stream, const void *data, size_t size, ui64 &offset) {
+    static const uc8 Zeros[CookedTexture::Alignment] = {};
+    if (0 != size && stream.write(data, size) != size) {
+        return false;
+    }
+    offset += size;
+    const size_t padding = static_cast<size_t>(alignOffset(offset) - offset);
+    if (0 != padding && stream.write(Zeros, padding) != padding) {
+        return false;
+    }
+    offset += padding;
+
+    return true;
+}
+
+static bool isInFile(ui64 offset, ui64 size, size_t fileSize) {
+    return offset <= fileSize && size <= fileSize - offset;
+}
+
+static ui32 getMipSize(ui32 size, ui32 level) {
+    const ui32 mipSize = size >> level;
+    return 0 != mipSize ? mipSize : 1;
+}
+
+static bool writeLevels(const CookedHeader &header, const std::vector<const uc8 *> &levels, IO::Stream &stream) {
+    const PixelFormatType format = static_cast<PixelFormatType>(header.mPixelFormat);
+    std::vector<CookedMipLevel> entries(header.mNumMipLevels);
+    ui64 offset = alignOffset(sizeof(CookedHeader) + sizeof(CookedMipLevel) * header.mNumMipLevels);
+    for (ui32 i = 0; i < header.mNumMipLevels; ++i) {
+        entries[i].mOffset = offset;
+        entries[i].mSize = TextureCompression::getImageSize(format, getMipSize(header.mWidth, i), getMipSize(header.mHeight, i));
+        offset = alignOffset(offset + entries[i].mSize);
+    }
+
+    ui64 written = 0;
+    bool ok = writePadded(stream, &header, sizeof(CookedHeader), written);
+    ok = ok && writePadded(stream, entries.data(), sizeof(CookedMipLevel) * entries.size(), written);
+    for (ui32 i = 0; ok && i < header.mNumMipLevels; ++i) {
+        osre_assert(written == entries[i].mOffset);
+        ok = writePadded(stream, levels[i], static_cast<size_t>(entries[i].mSize), written);
+    }
+
+    if (!ok) {
+        osre_error(Tag, "Error while writing the cooked texture.");
+    }
+
+    return ok;
+}
+
+bool CookedTexture::cook(const uc8 *pixels, ui32 width, ui32 height, ui32 channels, PixelFormatType format, IO::Stream &stream) {
+    if (nullptr == pixels || 0 == width || 0 == height || 0 == channels || channels > 4) {
+        osre_error(Tag, "Invalid image to cook.");
+        return false;
+    }
+
+    // Uncompressed levels are stored as they are, so the channels must match
+    const bool compressed = TextureCompression::isCompressed(format);
+    if (compressed && !TextureCompression::canEncode(format)) {
+        osre_error(Tag, "Pixel format cannot be encoded.");
+        return false;
+    }
+    if (!compressed && !((PixelFormatType::R8G8B8 == format && 3 == channels) || (PixelFormatType::R8G8B8A8 == format && 4 == channels))) {
+        osre_error(Tag, "Pixel format does not match the channels of the image.");
+        return false;
+    }
+
+    CookedHeader header = { Magic, Version, static_cast<i32>(format), width, height, channels,
+        TextureCompression::getNumMipLevels(width, height), 0 };
+
+    // Each level is filtered from the previous one before it is encoded
+    std::vector<std::vector<uc8>> levelData(header.mNumMipLevels);
+    std::vector<const uc8 *> levels(header.mNumMipLevels);
+    std::vector<uc8> current(pixels, pixels + static_cast<size_t>(width) * height * channels);
+    std::vector<uc8> next;
+    for (ui32 i = 0; i < header.mNumMipLevels; ++i) {
+        const ui32 mipWidth = getMipSize(width, i);
+        const ui32 mipHeight = getMipSize(height, i);
+        if (compressed) {
+            levelData[i].resize(TextureCompression::getImageSize(format, mipWidth, mipHeight));
+            if (!TextureCompression::encode(format, current.data(), mipWidth, mipHeight, channels, levelData[i].data())) {
+                return false;
+            }
+        } else {
+            levelData[i] = current;
+        }
+        levels[i] = levelData[i].data();
+
+        if (i + 1 < header.mNumMipLevels) {
+            next.resize(static_cast<size_t>(getMipSize(width, i + 1)) * getMipSize(height, i + 1) * channels);
+            TextureCompression::downsample(current.data(), mipWidth, mipHeight, channels, next.data());
+            current.swap(next);
+        }
+    }
+
+    return writeLevels(header, levels, stream);
+}
+
+bool CookedTexture::save(const Texture &tex, IO::Stream &stream) {
+    if (nullptr == tex.m_data || 0 == tex.m_width || 0 == tex.m_height || 0 == tex.mNumMipLevels ||
+            tex.mNumMipLevels > TextureCompression::getNumMipLevels(tex.m_width, tex.m_height)) {
+        osre_error(Tag, "Invalid texture to save.");
+        return false;
+    }
+
+    CookedHeader header = { Magic, Version, static_cast<i32>(tex.mPixelFormat), tex.m_width, tex.m_height, tex.m_channels,
+        tex.mNumMipLevels, 0 };
+    std::vector<const uc8 *> levels(tex.mNumMipLevels);
+    size_t offset = 0;
+    for (ui32 i = 0; i < tex.mNumMipLevels; ++i) {
+        levels[i] = tex.m_data + offset;
+        offset += TextureCompression::getImageSize(tex.mPixelFormat, getMipSize(tex.m_width, i), getMipSize(tex.m_height, i));
+    }
+
+    return writeLevels(header, levels, stream);
+}
+
+bool CookedTexture::load(IO::Stream &stream, Texture &tex) {
+    const uc8 *data = static_cast<const uc8 *>(stream.map());
+    if (nullptr != data) {
+        return load(data, stream.getSize(), tex);
+    }
+
+    // Not mappable, so read the whole content at once
+    const size_t size = stream.getSize();
+    std::vector<uc8> content(size);
+    if (0 == size || stream.read(content.data(), size) != size) {
+        osre_error(Tag, "Cannot read cooked texture from " + stream.getUri().getAbsPath());
+        return false;
+    }
+
+    return load(content.data(), size, tex);
+}
+
+bool CookedTexture::load(const uc8 *data, size_t size, Texture &tex) {
+    if (nullptr == data || size < sizeof(CookedHeader)) {
+        osre_error(Tag, "Invalid cooked texture data.");
+        return false;
+    }
+
+    CookedHeader header;
+    ::memcpy(&header, data, sizeof(CookedHeader));
+    if (Magic != header.mMagic) {
+        osre_error(Tag, "Data is not a cooked texture file.");
+        return false;
+    }
+    if (Version != header.mVersion) {
+        osre_error(Tag, "Unsupported cooked texture version.");
+        return false;
+    }
+    const bool valid = header.mPixelFormat >= 0 && header.mPixelFormat < static_cast<i32>(PixelFormatType::NumPixelFormatTypes) &&
+            0 != header.mWidth && 0 != header.mHeight && 0 != header.mNumMipLevels &&
+            header.mNumMipLevels <= TextureCompression::getNumMipLevels(header.mWidth, header.mHeight) &&
+            isInFile(sizeof(CookedHeader), static_cast<ui64>(sizeof(CookedMipLevel)) * header.mNumMipLevels, size);
+    if (!valid) {
+        osre_error(Tag, "Cooked texture file is corrupt.");
+        return false;
+    }
+
+    // Every level must have exactly the size of its format, so the packed levels can be walked without a table
+    const PixelFormatType format = static_cast<PixelFormatType>(header.mPixelFormat);
+    std::vector<CookedMipLevel> entries(header.mNumMipLevels);
+    ::memcpy(entries.data(), data + sizeof(CookedHeader), sizeof(CookedMipLevel) * entries.size());
+    size_t totalSize = 0;
+    for (ui32 i = 0; i < header.mNumMipLevels; ++i) {
+        const size_t levelSize = TextureCompression::getImageSize(format, getMipSize(header.mWidth, i), getMipSize(header.mHeight, i));
+        if (entries[i].mSize != levelSize || !isInFile(entries[i].mOffset, entries[i].mSize, size)) {
+            osre_error(Tag, "Cooked texture file is corrupt.");
+            return false;
+        }
+        totalSize += levelSize;
+    }
+
+    // The loader releases the data like the images from stb_image, so it is allocated the same way
+    uc8 *texData = static_cast<uc8 *>(::malloc(totalSize));
+    if (nullptr == texData) {
+        osre_error(Tag, "Out of memory while loading a cooked texture.");
+        return false;
+    }
+    size_t offset = 0;
+    for (ui32 i = 0; i < header.mNumMipLevels; ++i) {
+        ::memcpy(texData + offset, data + entries[i].mOffset, static_cast<size_t>(entries[i].mSize));
+        offset += static_cast<size_t>(entries[i].mSize);
+    }
+
+    tex.mPixelFormat = format;
+    tex.m_width = header.mWidth;
+    tex.m_height = header.mHeight;
+    tex.m_channels = header.mChannels;
+    tex.mNumMipLevels = header.mNumMipLevels;
+    tex.m_size = static_cast<ui32>(totalSize);
+    tex.m_data = texData;
+
+    return true;
+}
+
+} // Namespace RenderBackend
+} // Namespace OSRE
@@ -9,6 +9,8 @@ Material::Material(const String &name, const IO::Uri &uri) :
         m_type(MaterialType::ShaderMaterial),
         m_numTextures(0),
         m_textures(nullptr),
+        m_texResources(),
+        m_texCache(nullptr),
         m_shader(nullptr),
         m_numParameters(0),
         m_parameters(nullptr),
@@ -32,6 +34,15 @@ Material::~Material() {
 
     delete[] m_textures;
     m_textures = nullptr;
+
+    // The textures may be evicted as soon as no material uses them anymore
+    if (nullptr != m_texCache) {
+        for (size_t i = 0; i < m_texResources.size(); ++i) {
+            m_texCache->release(m_texResources[i]);
+        }
+    }
+    m_texResources.clear();
+    m_texCache = nullptr;
 }
 
 void Material::createShader(ShaderSourceArray &shaders) {
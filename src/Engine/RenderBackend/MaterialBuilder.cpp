@@ -33,6 +33,8 @@ namespace RenderBackend {
 using namespace ::OSRE::RenderBackend;
 
 MaterialBuilder::MaterialCache *MaterialBuilder::s_materialCache = nullptr;
+TextureResourceCache *MaterialBuilder::s_texCache = nullptr;
+bool MaterialBuilder::s_ownsTexCache = false;
 
 static const String GLSLVersionString_330 =
         "#version 330 core\n";
@@ -48,11 +50,22 @@ static const c8 *GLSLRenderVertexLayout =
         "layout(location = 3) in vec2 texcoord0;  // per-vertex tex coord, stage 0\n"
         "\n";
 
+// The backend defines OSRE_DRAW_ID, if the driver supports multi-draws with gl_DrawIDARB.
+// Then the model matrix is read from the DrawBlock instead of a uniform.
 static const c8 *GLSLCombinedMVPUniformSrc =
         "// uniforms\n"
+        "#ifdef OSRE_DRAW_ID\n"
+        "layout(std140) uniform DrawBlock {\n"
+        "    mat4 Models[OSRE_MAX_DRAWS];\n"
+        "};\n"
+        "#define Model Models[OSRE_DRAW_ID]\n"
+        "#else\n"
         "uniform mat4 Model;\n"
-        "uniform mat4 View;\n"
-        "uniform mat4 Projection;\n";
+        "#endif\n"
+        "layout(std140) uniform FrameBlock {\n"
+        "    mat4 View;\n"
+        "    mat4 Projection;\n"
+        "};\n";
 
 static const String GLSLVsSrc =
         GLSLVersionString_400 +
@@ -302,15 +315,53 @@ MaterialBuilder::~MaterialBuilder() {
     // empty
 }
 
-void MaterialBuilder::create() {
+void MaterialBuilder::create(TextureResourceCache *texCache) {
     if (nullptr == s_materialCache) {
         s_materialCache = new MaterialBuilder::MaterialCache;
     }
+
+    if (nullptr == s_texCache) {
+        s_ownsTexCache = nullptr == texCache;
+        s_texCache = s_ownsTexCache ? new TextureResourceCache : texCache;
+    }
 }
 
 void MaterialBuilder::destroy() {
+    // The materials release their textures, so the texture cache goes last
     delete s_materialCache;
     s_materialCache = nullptr;
+
+    if (s_ownsTexCache) {
+        delete s_texCache;
+    }
+    s_texCache = nullptr;
+    s_ownsTexCache = false;
+}
+
+void MaterialBuilder::acquireTextures(Material *mat, TextureResourceArray &texResArray) {
+    osre_assert(nullptr != mat);
+
+    mat->m_numTextures = texResArray.size();
+    mat->m_textures = new Texture *[texResArray.size()];
+    mat->m_texCache = s_texCache;
+    for (size_t i = 0; i < texResArray.size(); ++i) {
+        TextureResource *desc = texResArray[i];
+
+        // A new resource gets its setup before the load is started
+        TextureResource *texRes = s_texCache->create(desc->getName(), desc->getUri());
+        if (nullptr != texRes && Common::ResourceState::Uninitialized == texRes->getState()) {
+            texRes->setTargetType(desc->getTargetType());
+            texRes->setTextureStage(desc->setTextureStage());
+        }
+
+        texRes = s_texCache->acquire(desc->getName(), desc->getUri());
+        if (nullptr == texRes) {
+            mat->m_textures[i] = nullptr;
+            continue;
+        }
+        mat->m_texResources.add(texRes);
+        mat->m_textures[i] = texRes->get();
+    }
 }
 
 static void addMaterialParameter(Material *mat) {
@@ -370,16 +421,6 @@ RenderBackend::Material *MaterialBuilder::createTexturedMaterial(const String &m
         return mat;
     }
 
-    mat = s_materialCache->create(matName);
-    mat->m_numTextures = texResArray.size();
-    mat->m_textures = new Texture *[texResArray.size()];
-    for (size_t i = 0; i < texResArray.size(); ++i) {
-        TextureResource *texRes = texResArray[i];
-        TextureLoader loader;
-        texRes->load(loader);
-        mat->m_textures[i] = texRes->get();
-    }
-
     String vs, fs;
     if (type == VertexType::ColorVertex) {
         vs = GLSLVsSrc;
@@ -389,11 +430,14 @@ RenderBackend::Material *MaterialBuilder::createTexturedMaterial(const String &m
         fs = GLSLFragmentShaderSrcRV;
     }
 
+    // Checked first, the material cache owns the material and its texture references
     if (vs.empty() || fs.empty()) {
-        delete mat;
         return nullptr;
     }
 
+    mat = s_materialCache->create(matName);
+    acquireTextures(mat, texResArray);
+
     ShaderSourceArray arr;
     arr[static_cast<ui32>(ShaderType::SH_VertexShaderType)] = vs;
     arr[static_cast<ui32>(ShaderType::SH_FragmentShaderType)] = fs;
@@ -429,15 +473,7 @@ RenderBackend::Material *MaterialBuilder::createTexturedMaterial(const String &m
     }
 
     mat = s_materialCache->create(matName);
-    mat->m_numTextures = texResArray.size();
-    mat->m_textures = new Texture *[texResArray.size()];
-    for (size_t i = 0; i < texResArray.size(); ++i) {
-        TextureResource *texRes = texResArray[i];
-        IO::Uri uri = texRes->getUri();
-        TextureLoader loader;
-        texRes->load(loader);
-        mat->m_textures[i] = texRes->get();
-    }
+    acquireTextures(mat, texResArray);
 
     ShaderSourceArray shArray;
     shArray[static_cast<ui32>(ShaderType::SH_VertexShaderType)] = VsSrc;
@@ -51,7 +51,11 @@ Mesh::Mesh(const String &name, VertexType vertexType, IndexType indextype) :
         mId(99999999),
         mVertexData(),
         mIndexData(),
-        mLastIndex(0) {
+        mLastIndex(0),
+        mDirtyBegin(0),
+        mDirtyEnd(0),
+        mAabb(),
+        mAabbDirty(true) {
     mId = s_Ids.getUniqueId();
 }
 
@@ -69,16 +73,41 @@ Mesh::~Mesh() {
 
 void *Mesh::mapVertexBuffer( size_t vbSize, BufferAccessType accessType ) {
     mVertexBuffer = BufferData::alloc(BufferType::VertexBuffer, vbSize, accessType);
+    mAabbDirty = true;
     return mVertexBuffer->getData();
 }
 
 void Mesh::unmapVertexBuffer() {
-    // empty
+    // The mapped data may have been written
+    mAabbDirty = true;
 }
 
 void Mesh::createVertexBuffer(void *vertices, size_t vbSize, BufferAccessType accessType) {
     mVertexBuffer = BufferData::alloc(BufferType::VertexBuffer, vbSize, accessType);
     mVertexBuffer->copyFrom(vertices, vbSize);
+    mAabbDirty = true;
+}
+
+void Mesh::markVertexRangeDirty(size_t offset, size_t size) {
+    if (0 == size) {
+        return;
+    }
+
+    mAabbDirty = true;
+
+    const size_t end = offset + size;
+    if (!hasDirtyVertexRange()) {
+        mDirtyBegin = offset;
+        mDirtyEnd = end;
+        return;
+    }
+
+    if (offset < mDirtyBegin) {
+        mDirtyBegin = offset;
+    }
+    if (end > mDirtyEnd) {
+        mDirtyEnd = end;
+    }
 }
 
 BufferData *Mesh::getVertexBuffer() const {
@@ -470,6 +470,7 @@ MeshBuilder &MeshBuilder::allocTextBox(f32 x, f32 y, f32 textSize, const String
     TextureResource* texRes = new TextureResource("buildin_arial", IO::Uri("file://assets/Textures/Fonts/buildin_arial.bmp"));
     texResArray.add(texRes);
     mesh->setMaterial(MaterialBuilder::createTexturedMaterial("text_box_tex", texResArray, VertexType::RenderVertex));
+    delete texRes;
     mActiveMesh = mesh;
 
     return *this;
@@ -527,6 +528,13 @@ void MeshBuilder::updateTextBox( Mesh *geo, f32 textSize, const String &text ) {
 
     updateTextVertices(  numTextVerts, tex0, geo->getVertexBuffer() );
 
+    // Only the texture coordinates of the text quads have changed
+    size_t dirtySize = sizeof(RenderVert) * numTextVerts;
+    if (dirtySize > geo->getVertexBuffer()->getSize()) {
+        dirtySize = geo->getVertexBuffer()->getSize();
+    }
+    geo->markVertexRangeDirty(0, dirtySize);
+
     delete[] tex0;
 }
 
@@ -588,12 +596,18 @@ void MeshBuilder::updateTextVertices(size_t numVerts, ::glm::vec2 *tex0, BufferD
     osre_assert(nullptr != tex0);
     osre_assert(nullptr != vb);
 
+    // The text may be shorter than the allocated box
+    size_t size = sizeof(RenderVert) * numVerts;
+    if (size > vb->getSize()) {
+        size = vb->getSize();
+    }
+
     RenderVert *vert = new RenderVert[ numVerts ];
-    ::memcpy( &vert[ 0 ].position, vb->getData(), vb->getSize() );
+    ::memcpy( &vert[ 0 ].position, vb->getData(), size );
     for ( ui32 i = 0; i < numVerts; i++ ) {
         vert[ i ].tex0 = tex0[ i ];
     }
-    ::memcpy( vb->getData(), vert, vb->getSize() );
+    ::memcpy( vb->getData(), vert, size );
     delete[] vert;
 }
 
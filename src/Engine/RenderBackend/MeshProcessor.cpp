@@ -24,6 +24,19 @@ CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
 #include <osre/RenderBackend/Mesh.h>
 #include <osre/RenderBackend/RenderCommon.h>
 #include <osre/RenderBackend/MeshProcessor.h>
+#include <osre/Threading/JobSystem.h>
+
+#include <cfloat>
+#include <vector>
+
+#if defined(__AVX__)
+#   include <immintrin.h>
+#   define OSRE_AABB_AVX
+#   define OSRE_AABB_SSE
+#elif defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#   include <emmintrin.h>
+#   define OSRE_AABB_SSE
+#endif
 
 namespace OSRE {
 namespace RenderBackend {
@@ -32,6 +45,87 @@ using namespace ::OSRE::Common;
 
 static const i32 NeedsUpdate = 1;
 
+static void mergeAABB(AABB &dest, const AABB &src) {
+    // A box without any point keeps its sentinel values and must not be merged
+    if (src.getMin().x > src.getMax().x) {
+        return;
+    }
+
+    dest.merge(src.getMin());
+    dest.merge(src.getMax());
+}
+
+#ifdef OSRE_AABB_SSE
+
+// Loads x|y|z plus the following 4 bytes, the last lane will be ignored.
+static inline __m128 loadPosition(const uc8 *vertices, size_t index, size_t stride) {
+    return _mm_loadu_ps(reinterpret_cast<const f32 *>(&vertices[index * stride]));
+}
+
+#endif // OSRE_AABB_SSE
+
+static void reduceBounds(const uc8 *vertices, size_t numVertices, size_t stride, AABB &aabb) {
+    if (0 == numVertices) {
+        return;
+    }
+
+    f32 minVal[4] = { FLT_MAX, FLT_MAX, FLT_MAX, FLT_MAX };
+    f32 maxVal[4] = { -FLT_MAX, -FLT_MAX, -FLT_MAX, -FLT_MAX };
+    size_t i = 0;
+
+#ifdef OSRE_AABB_SSE
+    // The wide loads read 4 bytes behind the position, so the last vertex is handled scalar.
+    const size_t numWide = numVertices - 1;
+    __m128 min0 = _mm_loadu_ps(minVal), max0 = _mm_loadu_ps(maxVal);
+    __m128 min1 = min0, max1 = max0;
+#   ifdef OSRE_AABB_AVX
+    __m256 wideMin0 = _mm256_set1_ps(FLT_MAX), wideMax0 = _mm256_set1_ps(-FLT_MAX);
+    __m256 wideMin1 = wideMin0, wideMax1 = wideMax0;
+    for (; i + 4 <= numWide; i += 4) {
+        const __m256 p01 = _mm256_insertf128_ps(_mm256_castps128_ps256(loadPosition(vertices, i, stride)),
+                loadPosition(vertices, i + 1, stride), 1);
+        const __m256 p23 = _mm256_insertf128_ps(_mm256_castps128_ps256(loadPosition(vertices, i + 2, stride)),
+                loadPosition(vertices, i + 3, stride), 1);
+        wideMin0 = _mm256_min_ps(wideMin0, p01);
+        wideMax0 = _mm256_max_ps(wideMax0, p01);
+        wideMin1 = _mm256_min_ps(wideMin1, p23);
+        wideMax1 = _mm256_max_ps(wideMax1, p23);
+    }
+    wideMin0 = _mm256_min_ps(wideMin0, wideMin1);
+    wideMax0 = _mm256_max_ps(wideMax0, wideMax1);
+    min0 = _mm_min_ps(_mm256_castps256_ps128(wideMin0), _mm256_extractf128_ps(wideMin0, 1));
+    max0 = _mm_max_ps(_mm256_castps256_ps128(wideMax0), _mm256_extractf128_ps(wideMax0, 1));
+#   endif // OSRE_AABB_AVX
+    for (; i + 2 <= numWide; i += 2) {
+        const __m128 p0 = loadPosition(vertices, i, stride);
+        const __m128 p1 = loadPosition(vertices, i + 1, stride);
+        min0 = _mm_min_ps(min0, p0);
+        max0 = _mm_max_ps(max0, p0);
+        min1 = _mm_min_ps(min1, p1);
+        max1 = _mm_max_ps(max1, p1);
+    }
+    for (; i < numWide; ++i) {
+        const __m128 p = loadPosition(vertices, i, stride);
+        min0 = _mm_min_ps(min0, p);
+        max0 = _mm_max_ps(max0, p);
+    }
+    _mm_storeu_ps(minVal, _mm_min_ps(min0, min1));
+    _mm_storeu_ps(maxVal, _mm_max_ps(max0, max1));
+#endif // OSRE_AABB_SSE
+
+    for (; i < numVertices; ++i) {
+        f32 pos[3];
+        ::memcpy(pos, &vertices[i * stride], sizeof(pos));
+        for (ui32 j = 0; j < 3; ++j) {
+            minVal[j] = pos[j] < minVal[j] ? pos[j] : minVal[j];
+            maxVal[j] = pos[j] > maxVal[j] ? pos[j] : maxVal[j];
+        }
+    }
+
+    aabb.merge(minVal[0], minVal[1], minVal[2]);
+    aabb.merge(maxVal[0], maxVal[1], maxVal[2]);
+}
+
 MeshProcessor::MeshProcessor() :
         AbstractProcessor(),
         mMeshArray(),
@@ -74,39 +168,54 @@ const AABB &MeshProcessor::getAABB() const {
     return mAabb;
 }
 
-void MeshProcessor::handleMesh(Mesh *mesh) {
-    if (nullptr == mesh) {
+void MeshProcessor::computeAABB(const uc8 *vertices, size_t numVertices, size_t stride, AABB &aabb) {
+    if (nullptr == vertices || 0 == numVertices || stride < sizeof(glm::vec3)) {
         return;
     }
 
-    ui32 stride(0);
-    switch (mesh->getVertexType()) {
-        case VertexType::RenderVertex:
-            stride = sizeof(RenderVert);
-            break;
+    Threading::JobSystem *jobSystem = Threading::JobSystem::getInstance();
+    const size_t numChunks = numVertices / ParallelThreshold;
+    if (nullptr == jobSystem || numChunks < 2) {
+        reduceBounds(vertices, numVertices, stride, aabb);
+        return;
+    }
+
+    // Each chunk gets its own box, the last one takes the remaining vertices
+    std::vector<AABB> results(numChunks);
+    jobSystem->parallelFor(numChunks, 1, [&](size_t begin, size_t end) {
+        for (size_t chunk = begin; chunk < end; ++chunk) {
+            const size_t first = chunk * ParallelThreshold;
+            const size_t count = chunk + 1 == numChunks ? numVertices - first : ParallelThreshold;
+            reduceBounds(&vertices[first * stride], count, stride, results[chunk]);
+        }
+    });
+
+    for (const AABB &result : results) {
+        mergeAABB(aabb, result);
+    }
+}
 
-        case VertexType::ColorVertex:
-            stride = sizeof(ColorVert);
-            break;
+void MeshProcessor::handleMesh(Mesh *mesh) {
+    if (nullptr == mesh) {
+        return;
+    }
 
-        default:
-            break;
+    if (!mesh->isAABBDirty()) {
+        mergeAABB(mAabb, mesh->getAABB());
+        return;
     }
 
+    const size_t stride = Mesh::getVertexSize(mesh->getVertexType());
     BufferData *data = mesh->getVertexBuffer();
-    if (nullptr == data || 0L == data->getSize()) {
+    if (0 == stride || nullptr == data || 0L == data->getSize()) {
         return;
     }
 
-    ui32 offset = 0;
-    const ui32 numVertices = (ui32)data->getSize() / stride;
-    for (ui32 i = 0; i < numVertices; i++) {
-        glm::vec3 pos = {};
-        uc8 *ptr = (uc8*) data->getData();
-        ::memcpy(&pos.x, &ptr[offset], sizeof(glm::vec3));
-        offset += stride;
-        mAabb.merge(pos.x, pos.y, pos.z);
-    }
+    AABB aabb;
+    const size_t numVertices = data->getSize() / stride;
+    computeAABB(reinterpret_cast<const uc8 *>(data->getData()), numVertices, stride, aabb);
+    mesh->setAABB(aabb);
+    mergeAABB(mAabb, aabb);
 }
 
 } // namespace RenderBackend
@@ -0,0 +1,325 @@
+/*-----------------------------------------------------------------------------------------------
+The MIT License (MIT)
+
+Copyright (c) 2015-2022 OSRE ( Open Source Render Engine ) by Kim Kulling
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of
+this software and associated documentation files (the "Software"), to deal in
+the Software without restriction, including without limitation the rights to
+use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+the Software, and to permit persons to whom the Software is furnished to do so,
+subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+-----------------------------------------------------------------------------------------------*/
+#include "NullRenderEventHandler.h"
+
+#include <osre/Common/Logger.h>
+#include <osre/Debugging/osre_debugging.h>
+#include <osre/Profiling/PerformanceCounterRegistry.h>
+#include <osre/RenderBackend/Material.h>
+#include <osre/RenderBackend/Mesh.h>
+#include <osre/RenderBackend/Pipeline.h>
+#include <osre/RenderBackend/RenderCommon.h>
+
+namespace OSRE {
+namespace RenderBackend {
+
+using namespace ::OSRE::Common;
+using namespace ::OSRE::Profiling;
+
+// The OpenGL back-end uploads model, view and projection matrix for each material stage
+static const size_t MatrixUploadSize = 3 * sizeof(glm::mat4);
+
+NullRenderEventHandler::NullRenderEventHandler() :
+        AbstractEventHandler(),
+        m_isRunning(true),
+        m_pipeline(nullptr),
+        m_drawCmds(),
+        m_numFrames(0),
+        m_numDrawCalls(0),
+        m_numUploadedBytes(0),
+        m_numStateChanges(0),
+        m_committedBytes(0) {
+    // empty
+}
+
+NullRenderEventHandler::~NullRenderEventHandler() {
+    // empty
+}
+
+bool NullRenderEventHandler::onEvent(const Event &ev, const EventData *data) {
+    if (!m_isRunning) {
+        return true;
+    }
+
+    bool result(false);
+    if (OnAttachEventHandlerEvent == ev) {
+        result = onAttached(data);
+    } else if (OnDetatachEventHandlerEvent == ev) {
+        result = onDetached(data);
+    } else if (OnCreateRendererEvent == ev) {
+        result = onCreateRenderer(data);
+    } else if (OnDestroyRendererEvent == ev) {
+        result = onDestroyRenderer(data);
+    } else if (OnAttachViewEvent == ev) {
+        result = true;
+    } else if (OnDetachViewEvent == ev) {
+        result = true;
+    } else if (OnRenderFrameEvent == ev) {
+        result = onRenderFrame(data);
+    } else if (OnInitPassesEvent == ev) {
+        result = onInitRenderPasses(data);
+    } else if (OnCommitFrameEvent == ev) {
+        result = onCommitNexFrame(data);
+    } else if (OnClearSceneEvent == ev) {
+        result = onClearGeo(data);
+    } else if (OnShutdownRequestEvent == ev) {
+        result = onShutdownRequest(data);
+    } else if (OnResizeEvent == ev) {
+        result = true;
+    }
+
+    return result;
+}
+
+NullRenderStatistics NullRenderEventHandler::getStatistics() const {
+    NullRenderStatistics stats;
+    stats.m_numFrames = m_numFrames.load(std::memory_order_relaxed);
+    stats.m_numDrawCalls = m_numDrawCalls.load(std::memory_order_relaxed);
+    stats.m_numUploadedBytes = m_numUploadedBytes.load(std::memory_order_relaxed);
+    stats.m_numStateChanges = m_numStateChanges.load(std::memory_order_relaxed);
+
+    return stats;
+}
+
+bool NullRenderEventHandler::onAttached(const EventData *) {
+    m_drawCmds.resize(0);
+
+    return true;
+}
+
+bool NullRenderEventHandler::onDetached(const EventData *) {
+    m_drawCmds.clear();
+
+    return true;
+}
+
+bool NullRenderEventHandler::onCreateRenderer(const EventData *eventData) {
+    const CreateRendererEventData *createRendererEvData = static_cast<const CreateRendererEventData *>(eventData);
+    if (nullptr != createRendererEvData) {
+        m_pipeline = createRendererEvData->m_pipeline;
+    }
+
+    PerformanceCounterRegistry::registerCounter("drawCalls");
+    PerformanceCounterRegistry::registerCounter("uploadBytes");
+    PerformanceCounterRegistry::registerCounter("stateChanges");
+    PerformanceCounterRegistry::registerCounter("texturesPending");
+
+    return true;
+}
+
+bool NullRenderEventHandler::onDestroyRenderer(const EventData *) {
+    m_pipeline = nullptr;
+    m_drawCmds.resize(0);
+
+    return true;
+}
+
+bool NullRenderEventHandler::onClearGeo(const EventData *) {
+    m_drawCmds.resize(0);
+
+    return true;
+}
+
+bool NullRenderEventHandler::onRenderFrame(const EventData *eventData) {
+    ui64 numDrawCalls = 0;
+    ui64 numUploadedBytes = 0;
+    ui64 numStateChanges = 0;
+
+    // Replay the recorded commands like the OpenGL command buffer does
+    if (nullptr != m_pipeline) {
+        const size_t numPasses = m_pipeline->beginFrame();
+        for (ui32 passId = 0; passId < numPasses; ++passId) {
+            if (nullptr == m_pipeline->beginPass(passId)) {
+                continue;
+            }
+
+            // The fixed pipeline states of the pass
+            ++numStateChanges;
+            for (ui32 i = 0; i < m_drawCmds.size(); ++i) {
+                const NullDrawCmd &cmd = m_drawCmds[i];
+
+                // vertex array, shader and textures of the material stage
+                numStateChanges += 2 + cmd.m_numTextures;
+                numUploadedBytes += MatrixUploadSize;
+                numDrawCalls += cmd.m_numPrimGroups;
+            }
+            m_pipeline->endPass(passId);
+        }
+        m_pipeline->endFrame();
+    }
+
+    ++m_numFrames;
+    m_numDrawCalls += numDrawCalls;
+    m_numUploadedBytes += numUploadedBytes;
+    m_numStateChanges += numStateChanges;
+
+    // Buffer and uniform updates of the last commit belong to this frame
+    numUploadedBytes += m_committedBytes;
+    m_committedBytes = 0;
+    PerformanceCounterRegistry::setCounter("drawCalls", static_cast<ui32>(numDrawCalls));
+    PerformanceCounterRegistry::setCounter("uploadBytes", static_cast<ui32>(numUploadedBytes));
+    PerformanceCounterRegistry::setCounter("stateChanges", static_cast<ui32>(numStateChanges));
+
+    const RenderFrameEventData *data = static_cast<const RenderFrameEventData *>(eventData);
+    if (nullptr != data) {
+        data->setRendered();
+    }
+
+    return true;
+}
+
+void NullRenderEventHandler::addMeshes(MeshEntry *meshEntry) {
+    osre_assert(nullptr != meshEntry);
+
+    for (ui32 meshIdx = 0; meshIdx < meshEntry->mMeshArray.size(); ++meshIdx) {
+        Mesh *currentMesh = meshEntry->mMeshArray[meshIdx];
+        if (nullptr == currentMesh) {
+            osre_assert(nullptr != currentMesh);
+            continue;
+        }
+
+        // The vertex and the index buffer would be uploaded once
+        if (nullptr != currentMesh->getVertexBuffer()) {
+            m_numUploadedBytes += currentMesh->getVertexBuffer()->getSize();
+        }
+        if (nullptr != currentMesh->getIndexBuffer()) {
+            m_numUploadedBytes += currentMesh->getIndexBuffer()->getSize();
+        }
+
+        NullDrawCmd cmd;
+        cmd.m_numPrimGroups = static_cast<ui32>(currentMesh->getNumberOfPrimitiveGroups());
+        cmd.m_numTextures = 0;
+        Material *material = currentMesh->getMaterial();
+        if (nullptr != material) {
+            cmd.m_numTextures = static_cast<ui32>(material->m_numTextures);
+        }
+        m_drawCmds.add(cmd);
+    }
+}
+
+bool NullRenderEventHandler::onInitRenderPasses(const EventData *eventData) {
+    const InitPassesEventData *initPassesData = static_cast<const InitPassesEventData *>(eventData);
+    if (nullptr == initPassesData || nullptr == initPassesData->m_frame) {
+        return false;
+    }
+
+    Frame *frame = initPassesData->m_frame;
+    for (PassData *currentPass : frame->m_newPasses) {
+        if (nullptr == currentPass) {
+            osre_assert(nullptr != currentPass);
+            continue;
+        }
+
+        if (!currentPass->m_isDirty) {
+            continue;
+        }
+
+        for (RenderBatchData *currentBatchData : currentPass->m_geoBatches) {
+            if (nullptr == currentBatchData) {
+                continue;
+            }
+
+            for (UniformVar *uniform : currentBatchData->m_uniforms) {
+                if (nullptr != uniform) {
+                    m_numUploadedBytes += uniform->getSize();
+                }
+            }
+
+            for (ui32 meshEntryIdx = 0; meshEntryIdx < currentBatchData->m_meshArray.size(); ++meshEntryIdx) {
+                MeshEntry *currentMeshEntry = currentBatchData->m_meshArray[meshEntryIdx];
+                if (nullptr == currentMeshEntry) {
+                    osre_assert(nullptr != currentMeshEntry);
+                    continue;
+                }
+
+                if (!currentMeshEntry->m_isDirty) {
+                    continue;
+                }
+
+                addMeshes(currentMeshEntry);
+                currentMeshEntry->m_isDirty = false;
+            }
+        }
+    }
+
+    frame->m_newPasses.clear();
+
+    return true;
+}
+
+bool NullRenderEventHandler::onCommitNexFrame(const EventData *eventData) {
+    const CommitFrameEventData *data = static_cast<const CommitFrameEventData *>(eventData);
+    if (nullptr == data || nullptr == data->m_frame) {
+        return false;
+    }
+
+    ui64 committedBytes = 0;
+    for (FrameSubmitCmd *cmd : data->m_frame->m_submitCmds) {
+        if (nullptr == cmd) {
+            continue;
+        }
+
+        if (cmd->m_updateFlags & (ui32)FrameSubmitCmd::UpdateMatrixes) {
+            // Only stored on the CPU side, the upload happens with the material stage
+        } else if (cmd->m_updateFlags & (ui32)FrameSubmitCmd::UpdateUniforms) {
+            // One command holds all uniforms of a batch, only the values get uploaded
+            String name;
+            const c8 *varData = nullptr;
+            ui16 varDataLen = 0;
+            size_t offset = 0;
+            while (offset < cmd->m_size) {
+                const size_t read = UniformBuffer::decodeVar(&cmd->m_data[offset], cmd->m_size - offset, name, varData, varDataLen);
+                if (0 == read) {
+                    break;
+                }
+                committedBytes += varDataLen;
+                offset += read;
+            }
+        } else if (cmd->m_updateFlags & (ui32)FrameSubmitCmd::UpdateBuffer ||
+                   cmd->m_updateFlags & (ui32)FrameSubmitCmd::UpdateInstances) {
+            // bind, upload and unbind
+            m_numStateChanges += 2;
+            committedBytes += cmd->m_size;
+        } else if (cmd->m_updateFlags & (ui32)FrameSubmitCmd::AddRenderData) {
+            for (MeshEntry *entry : cmd->m_newMeshes) {
+                if (nullptr != entry) {
+                    addMeshes(entry);
+                }
+            }
+        }
+        cmd->m_updateFlags = 0u;
+    }
+    m_numUploadedBytes += committedBytes;
+    m_committedBytes += committedBytes;
+
+    return true;
+}
+
+bool NullRenderEventHandler::onShutdownRequest(const EventData *) {
+    m_isRunning = false;
+
+    return true;
+}
+
+} // Namespace RenderBackend
+} // Namespace OSRE
@@ -0,0 +1,128 @@
+/*-----------------------------------------------------------------------------------------------
+The MIT License (MIT)
+
+Copyright (c) 2015-2022 OSRE ( Open Source Render Engine ) by Kim Kulling
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of
+this software and associated documentation files (the "Software"), to deal in
+the Software without restriction, including without limitation the rights to
+use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+the Software, and to permit persons to whom the Software is furnished to do so,
+subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+-----------------------------------------------------------------------------------------------*/
+#pragma once
+
+#include <osre/Common/AbstractEventHandler.h>
+#include <osre/Common/Event.h>
+#include <osre/RenderBackend/RenderBackendService.h>
+
+#include <cppcore/Container/TArray.h>
+
+#include <atomic>
+
+namespace OSRE {
+namespace RenderBackend {
+
+class Pipeline;
+
+struct MeshEntry;
+
+/// @brief  The statistics of the null renderer, all values are accumulated since the creation.
+struct NullRenderStatistics {
+    ui64 m_numFrames;           ///< The number of rendered frames.
+    ui64 m_numDrawCalls;        ///< The number of draw calls, which would have been issued.
+    ui64 m_numUploadedBytes;    ///< The number of bytes, which would have been uploaded to the GPU.
+    ui64 m_numStateChanges;     ///< The number of state changes, which would have been issued.
+
+    /// @brief  The default class constructor.
+    NullRenderStatistics() : m_numFrames(0), m_numDrawCalls(0), m_numUploadedBytes(0), m_numStateChanges(0) {}
+};
+
+//-------------------------------------------------------------------------------------------------
+///	@ingroup	Engine
+///
+///	@brief  This class implements a render back-end without any GPU access.
+///
+/// All render events will be consumed and the CPU-side bookkeeping will be done, but no graphics
+/// API call will be issued. Instead the draw calls, uploaded bytes and state changes, which the
+/// OpenGL back-end would have issued, are counted. Use it to profile the render front-end in
+/// headless environments. Select it with the render API "null".
+//-------------------------------------------------------------------------------------------------
+class OSRE_EXPORT NullRenderEventHandler : public Common::AbstractEventHandler {
+public:
+    /// @brief The default class constructor.
+    NullRenderEventHandler();
+
+    ///	@brief  The class destructor.
+    ~NullRenderEventHandler() override;
+
+    /// @brief The OnEvent-callback.
+    /// @param ev           The event for handling.
+    /// @param eventData    The event data.
+    /// @return The result from the handler.
+    bool onEvent(const Common::Event &ev, const Common::EventData *eventData) override;
+
+    /// @brief  Will return the accumulated statistics, can be called from any thread.
+    /// @return The statistics.
+    NullRenderStatistics getStatistics() const;
+
+protected:
+    /// @brief  Callback for attaching the event handler.
+    bool onAttached(const Common::EventData *eventData) override;
+
+    /// @brief  Callback for detaching the event handler.
+    bool onDetached(const Common::EventData *eventData) override;
+
+    /// @brief  Callback for render backend creation.
+    bool onCreateRenderer(const Common::EventData *eventData);
+
+    /// @brief  Callback for render backend destroying.
+    bool onDestroyRenderer(const Common::EventData *eventData);
+
+    /// @brief  Callback for clearing all geometry from a stage.
+    bool onClearGeo(const Common::EventData *eventData);
+
+    /// @brief  Callback for the render frame.
+    bool onRenderFrame(const Common::EventData *eventData);
+
+    /// @brief  Callback to init the passes.
+    bool onInitRenderPasses(const Common::EventData *eventData);
+
+    /// @brief  Callback to commit the next frame.
+    bool onCommitNexFrame(const Common::EventData *eventData);
+
+    /// @brief  Callback for dealing with a shutdown request.
+    bool onShutdownRequest(const Common::EventData *eventData);
+
+private:
+    void addMeshes(MeshEntry *meshEntry);
+
+private:
+    /// The recorded draw, replayed once per pass and frame.
+    struct NullDrawCmd {
+        ui32 m_numPrimGroups;
+        ui32 m_numTextures;
+    };
+
+    bool m_isRunning;
+    Pipeline *m_pipeline;
+    CPPCore::TArray<NullDrawCmd> m_drawCmds;
+    std::atomic<ui64> m_numFrames;
+    std::atomic<ui64> m_numDrawCalls;
+    std::atomic<ui64> m_numUploadedBytes;
+    std::atomic<ui64> m_numStateChanges;
+    ui64 m_committedBytes;
+};
+
+} // Namespace RenderBackend
+} // Namespace OSRE
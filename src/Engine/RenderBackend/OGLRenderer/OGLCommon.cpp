@@ -24,11 +24,45 @@ CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
 
 #include <osre/Common/Logger.h>
 
+#include <unordered_map>
+
 namespace OSRE {
 namespace RenderBackend {
 
 static const c8 *Tag = "OGLRenderBackend";
 
+static std::unordered_map<String, ui32> &getParameterIdMap() {
+    static std::unordered_map<String, ui32> ParameterIds;
+    return ParameterIds;
+}
+
+ui32 getParameterId(const String &name) {
+    if (name.empty()) {
+        return InvalidParameterId;
+    }
+
+    std::unordered_map<String, ui32> &ids = getParameterIdMap();
+    std::unordered_map<String, ui32>::const_iterator it = ids.find(name);
+    if (ids.end() != it) {
+        return it->second;
+    }
+
+    const ui32 id = static_cast<ui32>(ids.size());
+    ids[name] = id;
+
+    return id;
+}
+
+ui32 findParameterId(const String &name) {
+    const std::unordered_map<String, ui32> &ids = getParameterIdMap();
+    std::unordered_map<String, ui32>::const_iterator it = ids.find(name);
+    if (ids.end() == it) {
+        return InvalidParameterId;
+    }
+
+    return it->second;
+}
+
 void checkOGLErrorState( const c8 *file, ui32 line ) {
 	GLenum error = glGetError();
 	if (GL_NO_ERROR == error) {
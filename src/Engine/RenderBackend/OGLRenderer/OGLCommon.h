@@ -24,6 +24,8 @@ CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
 
 #include <GL/glew.h>
 #include <osre/Common/osre_common.h>
+#include <osre/Common/FreeListAllocator.h>
+#include <cppcore/Container/THashMap.h>
 
 #include <osre/RenderBackend/RenderCommon.h>
 #include <osre/RenderBackend/RenderStates.h>
@@ -52,17 +54,30 @@ void checkOGLErrorState(const c8 *file, ui32 line);
 
 static const GLuint OGLNotSetId = 999999;
 static const GLint NoneLocation = -1;
+static const ui32 InvalidParameterId = 0xffffffff;
+
+/// @brief  Will return the id of a parameter name, the name gets interned on first use.
+/// Ids are dense and shared by all shaders, so a shader can store its locations in an array
+/// indexed by them. Only the render thread may call it.
+/// @param  name    [in] The parameter name.
+/// @return The parameter id, InvalidParameterId for an empty name.
+ui32 getParameterId(const String &name);
+
+/// @brief  Will return the id of an already interned parameter name.
+/// @param  name    [in] The parameter name.
+/// @return The parameter id, InvalidParameterId if the name is unknown.
+ui32 findParameterId(const String &name);
 
 ///	@brief  This struct declares opengl-specific buffer resource.
 struct OGLBuffer {
-    size_t m_handle;    ///< The buffer type.
+    Handle m_handle;    ///< The handle in the buffer table.
     BufferType m_type;  ///< The buffer type.
     GLuint m_oglId;     ///< The OpenGL buffer id.
     size_t m_geoId;     ///< The internal geo id.
     size_t m_size;      ///< The buffer size.
 
     /// @brief The default class constructor.
-    OGLBuffer() : m_handle(0), m_type(BufferType::InvalidType), m_oglId(OGLNotSetId), m_geoId(0), m_size(0){}
+    OGLBuffer() : m_handle(), m_type(BufferType::InvalidType), m_oglId(OGLNotSetId), m_geoId(0), m_size(0){}
 };
 
 ///	@brief  This struct declares an OpenGL specific vertex attribute like position or normals.
@@ -76,11 +91,11 @@ struct OGLVertexAttribute {
 
 ///	@brief  The OpenGL vertex array description.
 struct OGLVertexArray {
-    GLuint m_id;    ///< The vertex array id.
-    size_t m_slot;  ///< The slot id, used as an internal index.
+    GLuint m_id;        ///< The vertex array id.
+    Handle m_handle;    ///< The handle in the vertex array table.
 
     /// @brief The default class constructor.
-    OGLVertexArray() : m_id(0), m_slot(99999999) {}
+    OGLVertexArray() : m_id(0), m_handle() {}
 };
 
 ///	@brief  This struct represents a txture resource information.
@@ -89,14 +104,14 @@ struct OGLTexture {
     String m_name;          ///< The texture name.
     GLenum m_target;        ///< The texture target type.
     GLenum m_format;        ///< The texture format type.
-    size_t m_slot;          ///< The slot id, used as an internal index.
+    Handle m_handle;        ///< The handle in the texture table.
     ui32 m_width;
     ui32 m_height;
     ui32 m_channels;
 
     /// @brief The default class constructor.
     OGLTexture() : m_textureId(OGLNotSetId), m_name(), m_target(GL_NONE), m_format(GL_NONE), 
-                   m_slot(OGLNotSetId), m_width(0), m_height(0), m_channels(0) {}
+                   m_handle(), m_width(0), m_height(0), m_channels(0) {}
 };
 
 ///	@brief  This enum is used to describe a render command type.
@@ -114,21 +129,22 @@ struct OGLRenderCmd {
     OGLRenderCmdType m_type;    ///< The command type
     ui32 m_id;                  ///< The command id.
     void *m_data;               ///< The command data.
+    ui64 m_sortKey;             ///< The sort key, a draw command inherits the key of its material.
 
     /// @brief The default class constructor.
-    OGLRenderCmd(OGLRenderCmdType type) : m_type(type), m_id(999999), m_data(nullptr) {}
+    OGLRenderCmd(OGLRenderCmdType type) : m_type(type), m_id(999999), m_data(nullptr), m_sortKey(0) {}
 };
 
 ///	@brief This struct declares the needed data for a OpenGL parameter.
 struct OGLParameter {
     String m_name;              ///< The parameter name.
-    GLint m_loc;                ///< The parameter location in the shader.
+    ui32 m_id;                  ///< The interned name, indexes the location tables of the shaders.
     ParameterType m_type;       ///< The parameter type.
     UniformDataBlob *m_data;    ///< The data blob.
     size_t m_numItems;          ///< Number of items.
 
     /// @brief The default class constructor.
-    OGLParameter() :  m_name(""), m_loc(NoneLocation), m_type(ParameterType::PT_None), 
+    OGLParameter() :  m_name(""), m_id(InvalidParameterId), m_type(ParameterType::PT_None), 
                       m_data(nullptr), m_numItems(0) {}
 };
 
@@ -138,9 +154,42 @@ struct OGLPrimGroup {
     ui32 m_startIndex;      ///< The start index in the vertex buffer.
     size_t m_numIndices;    ///< The number of indices to render.
     GLenum m_indexType;     ///< The index data type.
+    GLint m_baseVertex;     ///< The first vertex of the mesh in a shared vertex buffer.
+    size_t m_indexOffset;   ///< The byte offset of the mesh indices in a shared index buffer.
+    ui32 m_firstIndex;      ///< The index offset counted in indices, used by indirect draws.
+
+    /// @brief The default class constructor.
+    OGLPrimGroup() : m_primitive(GL_NONE), m_startIndex(0), m_numIndices(0), m_indexType(GL_NONE),
+                     m_baseVertex(0), m_indexOffset(0), m_firstIndex(0) {} 
+};
+
+static const ui32 NoGeometryArena = 0xffffffff;
+
+///	@brief  This struct declares the location of the geometry of a mesh in a geometry arena.
+struct OGLGeometryRange {
+    ui32 m_arena;           ///< The arena index, NoGeometryArena for meshes with their own buffers.
+    size_t m_vertexOffset;  ///< The byte offset of the vertices in the vertex buffer.
+    size_t m_vertexSize;    ///< The size of the vertices in bytes.
+    size_t m_indexOffset;   ///< The byte offset of the indices in the index buffer.
+    GLint m_baseVertex;     ///< The index of the first vertex.
+
+    /// @brief The default class constructor.
+    OGLGeometryRange() : m_arena(NoGeometryArena), m_vertexOffset(0), m_vertexSize(0), m_indexOffset(0), m_baseVertex(0) {}
+};
+
+///	@brief  This struct declares a pair of large buffers shared by all static meshes of one vertex type.
+/// Meshes are drawn with a base vertex, so all of them can use the same vertex array.
+struct OGLGeometryArena {
+    VertexType m_vertexType;                ///< The vertex type of all meshes in the arena.
+    OGLBuffer *m_vertexBuffer;              ///< The shared vertex buffer.
+    OGLBuffer *m_indexBuffer;               ///< The shared index buffer.
+    Common::FreeListAllocator m_vertices;   ///< The allocator for the vertex buffer.
+    Common::FreeListAllocator m_indices;    ///< The allocator for the index buffer.
+    CPPCore::THashMap<ui32, OGLVertexArray *> m_vertexArrays;  ///< The vertex arrays by attribute locations.
 
     /// @brief The default class constructor.
-    OGLPrimGroup() : m_primitive(GL_NONE), m_startIndex(0), m_numIndices(0), m_indexType(GL_NONE) {} 
+    OGLGeometryArena() : m_vertexType(VertexType::InvalidVetexType), m_vertexBuffer(nullptr), m_indexBuffer(nullptr),
+                         m_vertices(), m_indices(), m_vertexArrays() {}
 };
 
 ///	@brief  This struct declares the data for a rendercall to set the correct material 
@@ -149,9 +198,10 @@ struct SetMaterialStageCmdData {
     OGLShader *m_shader;                        ///< The shader to use.
     CPPCore::TArray<OGLTexture *> m_textures;   ///< All texture to set.
     OGLVertexArray *m_vertexArray;              ///< Ther vertex array.
+    bool m_transparent;                         ///< true for a transparent material.
 
     /// @brief The default class constructor.
-    SetMaterialStageCmdData() : m_shader(nullptr), m_textures(), m_vertexArray(nullptr) {}
+    SetMaterialStageCmdData() : m_shader(nullptr), m_textures(), m_vertexArray(nullptr), m_transparent(false) {}
 };
 
 ///	@brief  The command data for setting the render target.
@@ -169,9 +219,10 @@ struct DrawInstancePrimitivesCmdData {
     size_t m_numInstances;                  ///< The number of instances to render.
     CPPCore::TArray<size_t> m_primitives;   ///< The primitives to render.
     const char *m_id;                       ///< The call id.
+    guid m_meshId;                          ///< The id of the drawn mesh, hidden meshes are skipped.
 
     /// @brief The default class constructor.
-    DrawInstancePrimitivesCmdData() : m_vertexArray(nullptr), m_numInstances(0), m_primitives(), m_id(nullptr) {}
+    DrawInstancePrimitivesCmdData() : m_vertexArray(nullptr), m_numInstances(0), m_primitives(), m_id(nullptr), m_meshId(999999) {}
 };
 
 ///	@brief  Thsi struct declares the data for a simple render call.
@@ -181,9 +232,11 @@ struct DrawPrimitivesCmdData {
     OGLVertexArray *m_vertexArray;          ///< The vertex array to use.
     CPPCore::TArray<size_t> m_primitives;   ///< The primitives to render.
     const char *m_id;                       ///< The id.
+    Handle m_matrixBuffer;                  ///< The cached handle of the matrix buffer.
+    guid m_meshId;                          ///< The id of the drawn mesh, hidden meshes are skipped.
 
     /// @brief The default class constructor.
-    DrawPrimitivesCmdData() : m_localMatrix(false), m_model(), m_vertexArray(nullptr), m_primitives(), m_id(nullptr) {}
+    DrawPrimitivesCmdData() : m_localMatrix(false), m_model(), m_vertexArray(nullptr), m_primitives(), m_id(nullptr), m_matrixBuffer(), m_meshId(999999) {}
 };
 
 /// @brief This struct declares the data structure of the GPU apabilities.
@@ -195,6 +248,13 @@ struct OGLCapabilities {
     i32 mMaxTextureImageUnits;  ///< The maximal number of texture image units.
     i32 mMaxTextureCoords;      ///< The maximal numberof texture coordinates.
     bool mInstancing;           ///< Instancing is supported.
+    bool mCompressionS3TC;      ///< BC1 and BC3 textures are supported.
+    bool mCompressionRGTC;      ///< BC5 textures are supported.
+    bool mCompressionBPTC;      ///< BC7 textures are supported.
+    bool mCompressionETC2;      ///< ETC2 textures are supported.
+    bool mProgramBinary;        ///< Linked programs can be stored as binaries.
+    bool mDrawParameters;       ///< Shaders can read gl_DrawIDARB.
+    bool mMultiDrawIndirect;    ///< Draws can be read from an indirect buffer.
 
     /// @brief The default class constructor.
     OGLCapabilities() :
@@ -204,7 +264,14 @@ struct OGLCapabilities {
             mMaxTextureUnits(-1),
             mMaxTextureImageUnits(-1),
             mMaxTextureCoords(-1),
-            mInstancing(true) {
+            mInstancing(true),
+            mCompressionS3TC(false),
+            mCompressionRGTC(false),
+            mCompressionBPTC(false),
+            mCompressionETC2(false),
+            mProgramBinary(false),
+            mDrawParameters(false),
+            mMultiDrawIndirect(false) {
         // empty
     }
 };
@@ -138,6 +138,18 @@ GLenum  OGLEnum::getGLTextureFormat(PixelFormatType texFormat) {
             return GL_RGB;
         case PixelFormatType::R8G8B8A8:
             return GL_RGBA;
+        case PixelFormatType::BC1:
+            return GL_COMPRESSED_RGB_S3TC_DXT1_EXT;
+        case PixelFormatType::BC3:
+            return GL_COMPRESSED_RGBA_S3TC_DXT5_EXT;
+        case PixelFormatType::BC5:
+            return GL_COMPRESSED_RG_RGTC2;
+        case PixelFormatType::BC7:
+            return GL_COMPRESSED_RGBA_BPTC_UNORM;
+        case PixelFormatType::ETC2_RGB8:
+            return GL_COMPRESSED_RGB8_ETC2;
+        case PixelFormatType::ETC2_RGBA8:
+            return GL_COMPRESSED_RGBA8_ETC2_EAC;
         case PixelFormatType::InvaliTextureType:
         default:
             osre_assert2( false, "Unknown enum for TextureParameterName." );
@@ -47,7 +47,7 @@ public:
     static GLenum getGLTextureTarget( TextureTargetType type );
     ///	@brief  Translates the texture parameter type to OpenGL.
     static GLenum getGLTextureEnum( TextureParameterName name );
-    /// @brief  Translates the texture format to the OpenGL specific enum.
+    /// @brief  Translates the texture format to the OpenGL specific enum, the internal format for compressed ones.
     static GLenum getGLTextureFormat(PixelFormatType texFormat);
     /// @brief  Translates the texture state to the corresponding GLenum value.
     static GLenum getGLTextureStage( TextureStageType texType );
@@ -0,0 +1,93 @@
+/*-----------------------------------------------------------------------------------------------
+The MIT License (MIT)
+
+Copyright (c) 2015-2022 OSRE ( Open Source Render Engine ) by Kim Kulling
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of
+this software and associated documentation files (the "Software"), to deal in
+the Software without restriction, including without limitation the rights to
+use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+the Software, and to permit persons to whom the Software is furnished to do so,
+subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+-----------------------------------------------------------------------------------------------*/
+#include "OGLMultiDrawBatch.h"
+
+namespace OSRE {
+namespace RenderBackend {
+
+constexpr ui32 OGLMultiDrawBatch::MaxDraws;
+
+OGLMultiDrawBatch::OGLMultiDrawBatch() :
+        mPrimitive(GL_NONE),
+        mIndexType(GL_NONE),
+        mCommands(),
+        mModels(),
+        mCounts(),
+        mIndexOffsets(),
+        mBaseVertices() {
+    mCommands.reserve(MaxDraws);
+    mModels.reserve(MaxDraws);
+    mCounts.reserve(MaxDraws);
+    mIndexOffsets.reserve(MaxDraws);
+    mBaseVertices.reserve(MaxDraws);
+}
+
+bool OGLMultiDrawBatch::canAdd(const OGLPrimGroup &grp) const {
+    if (mCommands.isEmpty()) {
+        return true;
+    }
+
+    if (mCommands.size() >= MaxDraws) {
+        return false;
+    }
+
+    return grp.m_primitive == mPrimitive && grp.m_indexType == mIndexType;
+}
+
+bool OGLMultiDrawBatch::add(const OGLPrimGroup &grp, const glm::mat4 &model) {
+    if (!canAdd(grp)) {
+        return false;
+    }
+
+    mPrimitive = grp.m_primitive;
+    mIndexType = grp.m_indexType;
+
+    // One instance starting at 0, so instanced attributes would read the first item
+    DrawElementsIndirectCommand cmd;
+    cmd.m_count = static_cast<GLuint>(grp.m_numIndices);
+    cmd.m_instanceCount = 1;
+    cmd.m_firstIndex = grp.m_firstIndex;
+    cmd.m_baseVertex = grp.m_baseVertex;
+    cmd.m_baseInstance = 0;
+    mCommands.add(cmd);
+    mModels.add(model);
+
+    mCounts.add(static_cast<GLsizei>(grp.m_numIndices));
+    mIndexOffsets.add(reinterpret_cast<const GLvoid *>(grp.m_indexOffset));
+    mBaseVertices.add(grp.m_baseVertex);
+
+    return true;
+}
+
+void OGLMultiDrawBatch::clear() {
+    mPrimitive = GL_NONE;
+    mIndexType = GL_NONE;
+    mCommands.resize(0);
+    mModels.resize(0);
+    mCounts.resize(0);
+    mIndexOffsets.resize(0);
+    mBaseVertices.resize(0);
+}
+
+} // Namespace RenderBackend
+} // Namespace OSRE
@@ -0,0 +1,159 @@
+/*-----------------------------------------------------------------------------------------------
+The MIT License (MIT)
+
+Copyright (c) 2015-2022 OSRE ( Open Source Render Engine ) by Kim Kulling
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of
+this software and associated documentation files (the "Software"), to deal in
+the Software without restriction, including without limitation the rights to
+use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+the Software, and to permit persons to whom the Software is furnished to do so,
+subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+-----------------------------------------------------------------------------------------------*/
+#pragma once
+
+#include "OGLCommon.h"
+
+#include <cppcore/Container/TArray.h>
+
+namespace OSRE {
+namespace RenderBackend {
+
+///	@brief  The layout of one draw in an indirect buffer, defined by ARB_draw_indirect.
+struct DrawElementsIndirectCommand {
+    GLuint m_count;         ///< The number of indices.
+    GLuint m_instanceCount; ///< The number of instances.
+    GLuint m_firstIndex;    ///< The first index in the index buffer.
+    GLint m_baseVertex;     ///< The value added to each index.
+    GLuint m_baseInstance;  ///< The first instance for instanced attributes.
+};
+
+//-------------------------------------------------------------------------------------------------
+///	@ingroup	Engine
+///
+///	@brief  Collects the draws of primitive groups for one multi-draw call.
+///
+/// All draws of a batch use the same primitive and index type, the vertex array and the shader
+/// are bound by the caller. For every draw the model matrix is stored, the shader reads it from
+/// the DrawBlock with gl_DrawIDARB. The draws are kept as indirect commands and as the arrays
+/// for glMultiDrawElementsBaseVertex, so both submission paths can use the same batch.
+//-------------------------------------------------------------------------------------------------
+class OGLMultiDrawBatch {
+public:
+    /// The maximal number of draws of one batch, 256 matrices fill the minimal uniform block size.
+    static constexpr ui32 MaxDraws = 256;
+
+    /// @brief  The class constructor.
+    OGLMultiDrawBatch();
+
+    /// @brief  The class destructor.
+    ~OGLMultiDrawBatch() = default;
+
+    /// @brief  Will check if a primitive group can be added.
+    /// @param  grp     [in] The primitive group.
+    /// @return false, if the batch is full or the group uses another primitive or index type.
+    bool canAdd(const OGLPrimGroup &grp) const;
+
+    /// @brief  Will add the draw of a primitive group.
+    /// @param  grp     [in] The primitive group.
+    /// @param  model   [in] The model matrix of the draw.
+    /// @return false, if the group cannot be added, flush the batch and add it again.
+    bool add(const OGLPrimGroup &grp, const glm::mat4 &model);
+
+    /// @brief  Will remove all draws.
+    void clear();
+
+    /// @brief  Will return the number of draws.
+    /// @return The number of draws.
+    ui32 size() const;
+
+    /// @brief  Will return true, if there are no draws.
+    /// @return true for an empty batch.
+    bool isEmpty() const;
+
+    /// @brief  Will return the primitive type of the draws.
+    /// @return The primitive type, GL_NONE for an empty batch.
+    GLenum getPrimitive() const;
+
+    /// @brief  Will return the index type of the draws.
+    /// @return The index type, GL_NONE for an empty batch.
+    GLenum getIndexType() const;
+
+    /// @brief  Will return the indirect commands.
+    /// @return Pointer to the commands.
+    const DrawElementsIndirectCommand *getCommands() const;
+
+    /// @brief  Will return the model matrices, in the std140 layout of a mat4 array.
+    /// @return Pointer to the matrices.
+    const glm::mat4 *getModels() const;
+
+    /// @brief  Will return the index counts for glMultiDrawElementsBaseVertex.
+    /// @return Pointer to the counts.
+    const GLsizei *getCounts() const;
+
+    /// @brief  Will return the index byte offsets for glMultiDrawElementsBaseVertex.
+    /// @return Pointer to the offsets.
+    const GLvoid *const *getIndexOffsets() const;
+
+    /// @brief  Will return the base vertices for glMultiDrawElementsBaseVertex.
+    /// @return Pointer to the base vertices.
+    const GLint *getBaseVertices() const;
+
+private:
+    GLenum mPrimitive;
+    GLenum mIndexType;
+    CPPCore::TArray<DrawElementsIndirectCommand> mCommands;
+    CPPCore::TArray<glm::mat4> mModels;
+    CPPCore::TArray<GLsizei> mCounts;
+    CPPCore::TArray<const GLvoid *> mIndexOffsets;
+    CPPCore::TArray<GLint> mBaseVertices;
+};
+
+inline ui32 OGLMultiDrawBatch::size() const {
+    return static_cast<ui32>(mCommands.size());
+}
+
+inline bool OGLMultiDrawBatch::isEmpty() const {
+    return mCommands.isEmpty();
+}
+
+inline GLenum OGLMultiDrawBatch::getPrimitive() const {
+    return mPrimitive;
+}
+
+inline GLenum OGLMultiDrawBatch::getIndexType() const {
+    return mIndexType;
+}
+
+inline const DrawElementsIndirectCommand *OGLMultiDrawBatch::getCommands() const {
+    return mCommands.isEmpty() ? nullptr : &mCommands[0];
+}
+
+inline const glm::mat4 *OGLMultiDrawBatch::getModels() const {
+    return mModels.isEmpty() ? nullptr : &mModels[0];
+}
+
+inline const GLsizei *OGLMultiDrawBatch::getCounts() const {
+    return mCounts.isEmpty() ? nullptr : &mCounts[0];
+}
+
+inline const GLvoid *const *OGLMultiDrawBatch::getIndexOffsets() const {
+    return mIndexOffsets.isEmpty() ? nullptr : &mIndexOffsets[0];
+}
+
+inline const GLint *OGLMultiDrawBatch::getBaseVertices() const {
+    return mBaseVertices.isEmpty() ? nullptr : &mBaseVertices[0];
+}
+
+} // Namespace RenderBackend
+} // Namespace OSRE
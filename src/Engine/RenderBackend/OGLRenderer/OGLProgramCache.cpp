@@ -0,0 +1,187 @@
+/*-----------------------------------------------------------------------------------------------
+The MIT License (MIT)
+
+Copyright (c) 2015-2022 OSRE ( Open Source Render Engine ) by Kim Kulling
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of
+this software and associated documentation files (the "Software"), to deal in
+the Software without restriction, including without limitation the rights to
+use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+the Software, and to permit persons to whom the Software is furnished to do so,
+subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+-----------------------------------------------------------------------------------------------*/
+#include "OGLProgramCache.h"
+#include "src/Engine/IO/FileStream.h"
+
+#include <osre/Common/Logger.h>
+#include <osre/IO/Directory.h>
+#include <osre/IO/Uri.h>
+#include <osre/RenderBackend/Shader.h>
+
+#include <cstdio>
+#include <cstring>
+
+namespace OSRE {
+namespace RenderBackend {
+
+using namespace ::OSRE::IO;
+
+static const c8 *Tag = "OGLProgramCache";
+
+static constexpr ui64 FnvOffset = 0xcbf29ce484222325ull;
+static constexpr ui64 FnvPrime = 0x100000001b3ull;
+
+static ui64 hashBytes(ui64 hash, const void *data, size_t size) {
+    const uc8 *ptr = static_cast<const uc8 *>(data);
+    for (size_t i = 0; i < size; ++i) {
+        hash ^= ptr[i];
+        hash *= FnvPrime;
+    }
+
+    return hash;
+}
+
+constexpr ui32 OGLProgramCache::Magic;
+constexpr ui32 OGLProgramCache::Version;
+
+OGLProgramCache::OGLProgramCache(const String &directory, const String &driverId) :
+        mDirectory(directory),
+        mDriverId(driverId),
+        mEnabled(false),
+        mNumHits(0),
+        mNumMisses(0) {
+    if (mDirectory.empty()) {
+        return;
+    }
+
+    const c8 last = mDirectory[mDirectory.size() - 1];
+    if ('/' != last && '\\' != last) {
+        mDirectory += '/';
+    }
+    mEnabled = Directory::exists(mDirectory) || Directory::createDirectory(mDirectory.c_str());
+    if (!mEnabled) {
+        osre_warn(Tag, "Cannot create program cache directory " + mDirectory);
+    }
+}
+
+ui64 OGLProgramCache::computeKey(const Shader &shader, const String &prelude) const {
+    ui64 hash = hashBytes(FnvOffset, mDriverId.c_str(), mDriverId.size());
+
+    // The prelude depends on the driver capabilities, the compiled program differs with it
+    hash = hashBytes(hash, prelude.c_str(), prelude.size());
+    for (ui32 i = 0; i < MaxShaderTypes; ++i) {
+        // The stage is part of the key, so moving a source to another stage changes it
+        const uc8 stage = static_cast<uc8>(i);
+        hash = hashBytes(hash, &stage, sizeof(uc8));
+        const ShaderType type = static_cast<ShaderType>(i);
+        if (shader.hasSource(type)) {
+            const c8 *src = shader.getSource(type);
+            hash = hashBytes(hash, src, ::strlen(src));
+        }
+    }
+
+    return hash;
+}
+
+String OGLProgramCache::getFilename(ui64 key) const {
+    c8 name[32];
+    ::snprintf(name, sizeof(name), "%016llx.glbin", static_cast<unsigned long long>(key));
+
+    return mDirectory + name;
+}
+
+bool OGLProgramCache::load(ui64 key, GLenum &format, std::vector<uc8> &binary) const {
+    if (!mEnabled) {
+        return false;
+    }
+
+    const String filename = getFilename(key);
+    FileStream stream(Uri("file://" + filename), Stream::AccessMode::ReadAccessBinary);
+    if (!stream.open()) {
+        return false;
+    }
+
+    ui32 magic(0), version(0), keyLow(0), keyHigh(0), binFormat(0), size(0);
+    stream.readUI32(magic);
+    stream.readUI32(version);
+    stream.readUI32(keyLow);
+    stream.readUI32(keyHigh);
+    stream.readUI32(binFormat);
+    stream.readUI32(size);
+    const ui64 storedKey = (static_cast<ui64>(keyHigh) << 32) | keyLow;
+    const size_t headerSize = 6 * sizeof(ui32);
+    if (Magic != magic || Version != version || key != storedKey || 0 == size || stream.getSize() != headerSize + size) {
+        osre_debug(Tag, "Invalid program cache entry " + filename);
+        stream.close();
+        return false;
+    }
+
+    binary.resize(size);
+    const bool ok = size == stream.read(&binary[0], size);
+    stream.close();
+    if (!ok) {
+        binary.clear();
+        return false;
+    }
+    format = static_cast<GLenum>(binFormat);
+
+    return true;
+}
+
+bool OGLProgramCache::store(ui64 key, GLenum format, const std::vector<uc8> &binary) const {
+    if (!mEnabled || binary.empty()) {
+        return false;
+    }
+
+    const String filename = getFilename(key);
+    FileStream stream(Uri("file://" + filename), Stream::AccessMode::WriteAccessBinary);
+    if (!stream.open()) {
+        osre_debug(Tag, "Cannot write program cache entry " + filename);
+        return false;
+    }
+
+    stream.writeUI32(Magic);
+    stream.writeUI32(Version);
+    stream.writeUI32(static_cast<ui32>(key & 0xffffffffull));
+    stream.writeUI32(static_cast<ui32>(key >> 32));
+    stream.writeUI32(static_cast<ui32>(format));
+    stream.writeUI32(static_cast<ui32>(binary.size()));
+    const bool ok = binary.size() == stream.write(&binary[0], binary.size());
+    stream.close();
+    if (!ok) {
+        // A truncated entry would be rejected on load anyway, but do not keep it around
+        ::remove(filename.c_str());
+    }
+
+    return ok;
+}
+
+void OGLProgramCache::remove(ui64 key) const {
+    if (!mEnabled) {
+        return;
+    }
+
+    ::remove(getFilename(key).c_str());
+}
+
+ui32 OGLProgramCache::getHitRate() const {
+    const ui32 numLookups = mNumHits + mNumMisses;
+    if (0 == numLookups) {
+        return 0;
+    }
+
+    return (mNumHits * 100) / numLookups;
+}
+
+} // Namespace RenderBackend
+} // Namespace OSRE
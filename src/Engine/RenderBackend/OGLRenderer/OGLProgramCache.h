@@ -0,0 +1,137 @@
+/*-----------------------------------------------------------------------------------------------
+The MIT License (MIT)
+
+Copyright (c) 2015-2022 OSRE ( Open Source Render Engine ) by Kim Kulling
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of
+this software and associated documentation files (the "Software"), to deal in
+the Software without restriction, including without limitation the rights to
+use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+the Software, and to permit persons to whom the Software is furnished to do so,
+subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+-----------------------------------------------------------------------------------------------*/
+#pragma once
+
+#include <osre/Common/osre_common.h>
+#include <osre/RenderBackend/RenderCommon.h>
+#include <GL/glew.h>
+
+#include <vector>
+
+namespace OSRE {
+namespace RenderBackend {
+
+class Shader;
+
+//-------------------------------------------------------------------------------------------------
+///	@ingroup	Engine
+///
+///	@brief  An on-disk cache for linked shader program binaries.
+///
+/// Each program is stored in its own file, named by a key hashed from all shader sources and the
+/// driver id (vendor, renderer and version string). A driver update changes the key, so stale
+/// binaries are never found. The driver may still reject a binary, the caller has to remove it
+/// and compile the program from source in this case.
+//-------------------------------------------------------------------------------------------------
+class OGLProgramCache {
+public:
+    static constexpr ui32 Magic = 0x4350534f; // "OSPC"
+    static constexpr ui32 Version = 1;
+
+    /// @brief  The class constructor.
+    /// @param  directory   [in] The cache directory, an empty name disables the cache.
+    /// @param  driverId    [in] The driver id, part of every key.
+    OGLProgramCache(const String &directory, const String &driverId);
+
+    /// @brief  The class destructor.
+    ~OGLProgramCache() = default;
+
+    /// @brief  Will return true, if the cache directory exists or was created.
+    /// @return The cache state.
+    bool isEnabled() const;
+
+    /// @brief  Will compute the key of a program.
+    /// @param  shader  [in] The shader with the sources of all stages.
+    /// @param  prelude [in] The code inserted into the sources before compiling them.
+    /// @return The key.
+    ui64 computeKey(const Shader &shader, const String &prelude = String()) const;
+
+    /// @brief  Will load a program binary.
+    /// @param  key     [in] The program key.
+    /// @param  format  [out] The driver specific binary format.
+    /// @param  binary  [out] The binary.
+    /// @return true, if a valid entry was found.
+    bool load(ui64 key, GLenum &format, std::vector<uc8> &binary) const;
+
+    /// @brief  Will store a program binary.
+    /// @param  key     [in] The program key.
+    /// @param  format  [in] The driver specific binary format.
+    /// @param  binary  [in] The binary.
+    /// @return true, if the entry was written.
+    bool store(ui64 key, GLenum format, const std::vector<uc8> &binary) const;
+
+    /// @brief  Will remove an entry, used for binaries rejected by the driver.
+    /// @param  key     [in] The program key.
+    void remove(ui64 key) const;
+
+    /// @brief  Will return the file name of an entry.
+    /// @param  key     [in] The program key.
+    /// @return The file name.
+    String getFilename(ui64 key) const;
+
+    /// @brief  Will count a lookup.
+    /// @param  hit     [in] true, if the program was created from the cache.
+    void countLookup(bool hit);
+
+    /// @brief  Will return the number of hits.
+    /// @return The number of hits.
+    ui32 getNumHits() const;
+
+    /// @brief  Will return the number of misses.
+    /// @return The number of misses.
+    ui32 getNumMisses() const;
+
+    /// @brief  Will return the hit rate.
+    /// @return The hit rate in percent, 0 if nothing was looked up.
+    ui32 getHitRate() const;
+
+private:
+    String mDirectory;
+    String mDriverId;
+    bool mEnabled;
+    ui32 mNumHits;
+    ui32 mNumMisses;
+};
+
+inline bool OGLProgramCache::isEnabled() const {
+    return mEnabled;
+}
+
+inline void OGLProgramCache::countLookup(bool hit) {
+    if (hit) {
+        ++mNumHits;
+    } else {
+        ++mNumMisses;
+    }
+}
+
+inline ui32 OGLProgramCache::getNumHits() const {
+    return mNumHits;
+}
+
+inline ui32 OGLProgramCache::getNumMisses() const {
+    return mNumMisses;
+}
+
+} // Namespace RenderBackend
+} // Namespace OSRE
@@ -23,17 +23,22 @@ CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
 #include "OGLRenderBackend.h"
 #include "OGLCommon.h"
 #include "OGLEnum.h"
+#include "OGLProgramCache.h"
 #include "OGLShader.h"
+#include "OGLStreamBuffer.h"
 
 #include <osre/Common/Logger.h>
+#include <osre/Common/StringUtils.h>
 #include <osre/Common/glm_common.h>
 #include <osre/Debugging/osre_debugging.h>
 #include <osre/IO/Stream.h>
 #include <osre/IO/Uri.h>
 #include <osre/Platform/AbstractOGLRenderContext.h>
 #include <osre/Profiling/PerformanceCounterRegistry.h>
+#include <osre/RenderBackend/Mesh.h>
 #include <osre/RenderBackend/RenderStates.h>
 #include <osre/RenderBackend/Shader.h>
+#include <osre/RenderBackend/TextureCompression.h>
 
 #include <cppcore/CPPCoreCommon.h>
 #include <cppcore/Memory/MemUtils.h>
@@ -42,6 +47,7 @@ CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
 //#include "SOIL.h"
 
 #include <iostream>
+#include <vector>
 
 namespace OSRE {
 namespace RenderBackend {
@@ -50,30 +56,65 @@ using namespace ::CPPCore;
 
 static const String Tag = "OGLRenderBackend";
 static const ui32 NotInitedHandle = 9999999;
+static const size_t StreamBufferSize = 4 * 1024 * 1024;
+static const size_t DefaultTextureUploadBudget = 8 * 1024 * 1024;
+static const size_t GeometryArenaVertexSize = 8 * 1024 * 1024;
+static const size_t GeometryArenaIndexSize = 4 * 1024 * 1024;
+static const size_t IndexAlignment = 4;
+static const size_t FrameBlockViewMember = 0;
+static const size_t FrameBlockProjectionMember = 1;
+static const size_t DrawBlockSize = OGLMultiDrawBatch::MaxDraws * sizeof(glm::mat4);
 
 OGLRenderBackend::OGLRenderBackend() :
+        mMatrixBlock(),
+        mFrameBlock(UniformBlock::getBlockName(UniformBlockType::FrameBlock)),
+        mFrameBlockBuffer(0),
         mRenderCtx(nullptr),
         mBuffers(),
+        mBufferLookupMap(),
+        mInstanceBufferLookupMap(),
+        mGeometryArenas(),
+        mGeometryLookupMap(),
         mActiveVB(NotInitedHandle),
         mActiveIB(NotInitedHandle),
         mVertexArrays(),
         mActiveVertexArray(OGLNotSetId),
         mShaders(),
+        mShaderLookupMap(),
         mTextures(),
-        mFreeTexSlots(),
-        m_texLookupMap(),
+        mTextureLookupMap(),
         mParameters(),
+        mParameterLookupMap(),
         mShaderInUse(nullptr),
-        mFreeBufferSlots(),
         mPrimitives(),
         mFpState(nullptr),
         mFpsCounter(nullptr),
         mOglCapabilities(),
-        mFrameFuffers() {
+        mFrameFuffers(),
+        mNumStateChanges(0),
+        mNumAvoidedStateChanges(0),
+        mStreamBuffer(nullptr),
+        mNumUploadedBytes(0),
+        mPendingTextures(),
+        mTextureUploadBudget(DefaultTextureUploadBudget),
+        mTextureUploadBytes(0),
+        mDriverId(),
+        mProgramCache(nullptr),
+        mModelParam(nullptr),
+        mViewParam(nullptr),
+        mProjectionParam(nullptr),
+        mMultiDraw(),
+        mDrawBlockBuffer(0),
+        mIndirectBuffer(0),
+        mNumDrawCalls(0) {
     mBindedTextures.resize((size_t)TextureStageType::NumTextureStageTypes);
     for (size_t i = 0; i < (size_t)TextureStageType::NumTextureStageTypes; ++i) {
         mBindedTextures[i] = nullptr;
     }
+
+    // The frame block layout is fixed, all shaders using it have to declare it this way
+    mFrameBlock.addMember("View", ParameterType::PT_Mat4);
+    mFrameBlock.addMember("Projection", ParameterType::PT_Mat4);
 }
 
 OGLRenderBackend::~OGLRenderBackend() {
@@ -86,6 +127,12 @@ OGLRenderBackend::~OGLRenderBackend() {
     releaseAllBuffers();
     releaseAllParameters();
     releaseAllPrimitiveGroups();
+
+    delete mStreamBuffer;
+    mStreamBuffer = nullptr;
+
+    delete mProgramCache;
+    mProgramCache = nullptr;
 }
 
 void OGLRenderBackend::enumerateGPUCaps() {
@@ -95,6 +142,17 @@ void OGLRenderBackend::enumerateGPUCaps() {
     glGetIntegerv(GL_MAX_TEXTURE_UNITS, &mOglCapabilities.mMaxTextureUnits);
     glGetIntegerv(GL_MAX_VERTEX_TEXTURE_IMAGE_UNITS, &mOglCapabilities.mMaxTextureImageUnits);
     glGetIntegerv(GL_MAX_TEXTURE_COORDS, &mOglCapabilities.mMaxTextureCoords);
+    mOglCapabilities.mCompressionS3TC = GLEW_EXT_texture_compression_s3tc != GL_FALSE;
+    mOglCapabilities.mCompressionRGTC = GLEW_VERSION_3_0 != GL_FALSE || GLEW_ARB_texture_compression_rgtc != GL_FALSE;
+    mOglCapabilities.mCompressionBPTC = GLEW_VERSION_4_2 != GL_FALSE || GLEW_ARB_texture_compression_bptc != GL_FALSE;
+    mOglCapabilities.mCompressionETC2 = GLEW_VERSION_4_3 != GL_FALSE || GLEW_ARB_ES3_compatibility != GL_FALSE;
+    if (GLEW_VERSION_4_1 != GL_FALSE || GLEW_ARB_get_program_binary != GL_FALSE) {
+        GLint numFormats(0);
+        glGetIntegerv(GL_NUM_PROGRAM_BINARY_FORMATS, &numFormats);
+        mOglCapabilities.mProgramBinary = numFormats > 0;
+    }
+    mOglCapabilities.mDrawParameters = GLEW_ARB_shader_draw_parameters != GL_FALSE;
+    mOglCapabilities.mMultiDrawIndirect = GLEW_VERSION_4_3 != GL_FALSE || GLEW_ARB_multi_draw_indirect != GL_FALSE;
 }
 
 void OGLRenderBackend::setMatrix(MatrixType type, const glm::mat4 &mat) {
@@ -136,35 +194,41 @@ const glm::mat4 &OGLRenderBackend::getMatrix(MatrixType type) const {
 }
 
 void OGLRenderBackend::applyMatrix() {
-    OGLParameter *model = getParameter("Model");
-    if (nullptr == model) {
-        UniformDataBlob *blob = UniformDataBlob::create(ParameterType::PT_Mat4, 1);
-        ::memcpy(blob->m_data, mMatrixBlock.getModelPtr(), sizeof(glm::mat4));
-        model = createParameter("Model", ParameterType::PT_Mat4, blob, 1);
-    } else {
-        memcpy(model->m_data->m_data, mMatrixBlock.getModelPtr(), sizeof(glm::mat4));
+    // View and projection are part of the frame block, if the shader declares it
+    const bool useFrameBlock = nullptr != mShaderInUse && nullptr != mShaderInUse->getUniformBlock(UniformBlockType::FrameBlock);
+    if (useFrameBlock) {
+        mFrameBlock.setValue(FrameBlockViewMember, mMatrixBlock.getViewPtr(), sizeof(glm::mat4));
+        mFrameBlock.setValue(FrameBlockProjectionMember, mMatrixBlock.getProjectionPtr(), sizeof(glm::mat4));
     }
-    setParameter(model);
 
-    OGLParameter *view = getParameter("View");
-    if (nullptr == view) {
-        UniformDataBlob *blob = UniformDataBlob::create(ParameterType::PT_Mat4, 1);
-        ::memcpy(blob->m_data, mMatrixBlock.getViewPtr(), sizeof(glm::mat4));
-        view = createParameter("View", ParameterType::PT_Mat4, blob, 1);
+    // A shader with a draw block reads the model matrix of a single draw from the first item
+    if (nullptr != mShaderInUse && nullptr != mShaderInUse->getUniformBlock(UniformBlockType::DrawBlock)) {
+        uploadDrawModels(&mMatrixBlock.m_model, 1);
     } else {
-        memcpy(view->m_data->m_data, mMatrixBlock.getViewPtr(), sizeof(glm::mat4));
+        setMatrixParameter(mModelParam, "Model", mMatrixBlock.getModelPtr());
+    }
+    if (useFrameBlock) {
+        return;
     }
-    setParameter(view);
 
-    OGLParameter *projection = getParameter("Projection");
-    if (nullptr == projection) {
-        UniformDataBlob *blob = UniformDataBlob::create(ParameterType::PT_Mat4, 1);
-        ::memcpy(blob->m_data, mMatrixBlock.getProjectionPtr(), sizeof(glm::mat4));
-        projection = createParameter("Projection", ParameterType::PT_Mat4, blob, 1);
-    } else {
-        memcpy(projection->m_data->m_data, mMatrixBlock.getProjectionPtr(), sizeof(glm::mat4));
+    setMatrixParameter(mViewParam, "View", mMatrixBlock.getViewPtr());
+    setMatrixParameter(mProjectionParam, "Projection", mMatrixBlock.getProjectionPtr());
+}
+
+void OGLRenderBackend::setMatrixParameter(OGLParameter *&param, const c8 *name, const f32 *matrix) {
+    // The parameter is looked up once, it stays valid until all parameters get released
+    if (nullptr == param) {
+        param = getParameter(name);
+        if (nullptr == param) {
+            param = createParameter(name, ParameterType::PT_Mat4, nullptr, 1);
+        }
+        if (nullptr == param) {
+            return;
+        }
     }
-    setParameter(projection);
+
+    ::memcpy(param->m_data->m_data, matrix, sizeof(glm::mat4));
+    setParameter(param);
 }
 
 bool OGLRenderBackend::create(Platform::AbstractOGLRenderContext *renderCtx) {
@@ -179,16 +243,19 @@ bool OGLRenderBackend::create(Platform::AbstractOGLRenderContext *renderCtx) {
     if (GLVendorString) {
         String vendor(GLVendorString);
         osre_info(Tag, vendor);
+        mDriverId += vendor;
     }
     const char *GLRendererString = (const char *)glGetString(GL_RENDERER);
     if (GLRendererString) {
         String renderer(GLRendererString);
         osre_info(Tag, renderer);
+        mDriverId += "|" + renderer;
     }
     const char *GLVersionString = (const char *)glGetString(GL_VERSION);
     if (GLVersionString) {
         String version(GLVersionString);
         osre_info(Tag, version);
+        mDriverId += "|" + version;
     }
     const char *GLExtensions = (const char *)glGetString(GL_EXTENSIONS);
     if (GLExtensions) {
@@ -211,10 +278,38 @@ bool OGLRenderBackend::create(Platform::AbstractOGLRenderContext *renderCtx) {
     glDepthFunc(GL_LESS);
     glEnable(GL_MULTISAMPLE);
 
+    // Dynamic buffers are streamed through a persistently mapped ring, if the driver supports it
+    mStreamBuffer = new OGLStreamBuffer(StreamBufferSize);
+    if (!mStreamBuffer->create(GLEW_ARB_buffer_storage != GL_FALSE)) {
+        mStreamBuffer->create(false);
+    }
+    osre_debug(Tag, mStreamBuffer->isPersistent() ? "Using persistent mapped stream buffer." : "Using glBufferSubData for buffer updates.");
+
     return true;
 }
 
 bool OGLRenderBackend::destroy() {
+    if (nullptr != mStreamBuffer) {
+        mStreamBuffer->destroy();
+        delete mStreamBuffer;
+        mStreamBuffer = nullptr;
+    }
+
+    if (0 != mFrameBlockBuffer) {
+        glDeleteBuffers(1, &mFrameBlockBuffer);
+        mFrameBlockBuffer = 0;
+    }
+
+    if (0 != mDrawBlockBuffer) {
+        glDeleteBuffers(1, &mDrawBlockBuffer);
+        mDrawBlockBuffer = 0;
+    }
+
+    if (0 != mIndirectBuffer) {
+        glDeleteBuffers(1, &mIndirectBuffer);
+        mIndirectBuffer = 0;
+    }
+
     return true;
 }
 
@@ -259,20 +354,10 @@ void OGLRenderBackend::setViewport(i32 x, i32 y, i32 w, i32 h) {
 }
 
 OGLBuffer *OGLRenderBackend::createBuffer(BufferType type) {
-    size_t handle(OGLNotSetId);
     GLuint bufferId(OGLNotSetId);
     glGenBuffers(1, &bufferId);
-    OGLBuffer *buffer(nullptr);
-    if (mFreeBufferSlots.isEmpty()) {
-        buffer = new OGLBuffer;
-        handle = mBuffers.size();
-        mBuffers.add(buffer);
-    } else {
-        handle = mFreeBufferSlots.back();
-        buffer = mBuffers[handle];
-        mFreeBufferSlots.removeBack();
-    }
-    buffer->m_handle = handle;
+    OGLBuffer *buffer = new OGLBuffer;
+    buffer->m_handle = mBuffers.add(buffer);
     buffer->m_type = type;
     buffer->m_oglId = bufferId;
     buffer->m_size = 0;
@@ -280,15 +365,35 @@ OGLBuffer *OGLRenderBackend::createBuffer(BufferType type) {
     return buffer;
 }
 
-OGLBuffer *OGLRenderBackend::getBufferById(guid geoId) {
-    OGLBuffer *buffer(nullptr);
-    for (ui32 i = 0; i < mBuffers.size(); i++) {
-        if (mBuffers[i]->m_geoId == geoId) {
-            buffer = mBuffers[i];
-            break;
-        }
+OGLBuffer *OGLRenderBackend::getBuffer(Handle handle) const {
+    OGLBuffer *const *buffer = mBuffers.get(handle);
+    if (nullptr == buffer) {
+        return nullptr;
     }
-    return buffer;
+
+    return *buffer;
+}
+
+void OGLRenderBackend::setBufferGeoId(OGLBuffer *buffer, guid geoId) {
+    if (nullptr == buffer) {
+        osre_debug(Tag, "Pointer to buffer is nullptr");
+        return;
+    }
+
+    // The first buffer for a geometry is the vertex buffer, this one will be used for updates
+    buffer->m_geoId = geoId;
+    if (!mBufferLookupMap.hasKey(geoId)) {
+        mBufferLookupMap.insert(geoId, buffer->m_handle);
+    }
+}
+
+OGLBuffer *OGLRenderBackend::getBufferById(guid geoId) const {
+    Handle handle;
+    if (!mBufferLookupMap.getValue(geoId, handle)) {
+        return nullptr;
+    }
+
+    return getBuffer(handle);
 }
 
 void OGLRenderBackend::bindBuffer(OGLBuffer *buffer) {
@@ -303,8 +408,8 @@ void OGLRenderBackend::bindBuffer(OGLBuffer *buffer) {
     //CHECKOGLERRORSTATE();
 }
 
-void OGLRenderBackend::bindBuffer(ui32 handle) {
-    OGLBuffer *buf(mBuffers[handle]);
+void OGLRenderBackend::bindBuffer(Handle handle) {
+    OGLBuffer *buf = getBuffer(handle);
     if (nullptr != buf) {
         bindBuffer(buf);
     }
@@ -330,6 +435,33 @@ void OGLRenderBackend::copyDataToBuffer(OGLBuffer *buffer, void *data, size_t si
     }
     GLenum target = OGLEnum::getGLBufferType(buffer->m_type);
     glBufferData(target, size, data, OGLEnum::getGLBufferAccessType(usage));
+    buffer->m_size = size;
+    mNumUploadedBytes += static_cast<ui32>(size);
+
+    CHECKOGLERRORSTATE();
+}
+
+void OGLRenderBackend::updateBuffer(OGLBuffer *buffer, size_t offset, void *data, size_t size) {
+    if (nullptr == buffer) {
+        osre_debug(Tag, "Pointer to buffer is nullptr");
+        return;
+    }
+
+    // A grown buffer needs new storage, all other updates keep the storage
+    if (offset + size > buffer->m_size || nullptr == mStreamBuffer) {
+        if (0 != offset) {
+            osre_debug(Tag, "Buffer range exceeds the buffer size.");
+            return;
+        }
+        bindBuffer(buffer);
+        copyDataToBuffer(buffer, data, size, BufferAccessType::ReadWrite);
+        unbindBuffer(buffer);
+        return;
+    }
+
+    if (mStreamBuffer->upload(buffer->m_oglId, offset, data, size)) {
+        mNumUploadedBytes += static_cast<ui32>(size);
+    }
 
     CHECKOGLERRORSTATE();
 }
@@ -340,25 +472,291 @@ void OGLRenderBackend::releaseBuffer(OGLBuffer *buffer) {
         return;
     }
 
-    const size_t slot = buffer->m_handle;
+    Handle handle;
+    if (mBufferLookupMap.getValue(buffer->m_geoId, handle) && handle == buffer->m_handle) {
+        mBufferLookupMap.remove(buffer->m_geoId);
+    }
+    if (BufferType::InstanceBuffer == buffer->m_type) {
+        const ui32 hash = static_cast<ui32>(buffer->m_geoId);
+        if (mInstanceBufferLookupMap.getValue(hash, handle) && handle == buffer->m_handle) {
+            mInstanceBufferLookupMap.remove(hash);
+        }
+    }
     glDeleteBuffers(1, &buffer->m_oglId);
-    buffer->m_handle = OGLNotSetId;
-    buffer->m_type = BufferType::EmptyBuffer;
-    buffer->m_oglId = OGLNotSetId;
-    mFreeBufferSlots.add(slot);
+    mBuffers.remove(buffer->m_handle);
+    delete buffer;
 }
 
 void OGLRenderBackend::releaseAllBuffers() {
-    for (ui32 i = 0; i < mBuffers.size(); ++i) {
-        OGLBuffer *buffer = mBuffers[i];
-        if (nullptr != buffer) {
-            if (buffer->m_type != BufferType::EmptyBuffer) {
-                releaseBuffer(buffer);
-            }
+    releaseAllGeometryArenas();
+    for (size_t i = 0; i < mBuffers.capacity(); ++i) {
+        if (mBuffers.isUsed(i)) {
+            releaseBuffer(mBuffers.at(i));
         }
     }
     mBuffers.clear();
-    mFreeBufferSlots.clear();
+    mBufferLookupMap.clear();
+    mInstanceBufferLookupMap.clear();
+}
+
+OGLGeometryArena *OGLRenderBackend::createGeometryArena(VertexType type, size_t vertexSize, size_t indexSize) {
+    OGLGeometryArena *arena = new OGLGeometryArena;
+    arena->m_vertexType = type;
+    arena->m_vertices.reset(vertexSize);
+    arena->m_indices.reset(indexSize);
+
+    // The copy target does not touch the index buffer binding of the bound vertex array
+    arena->m_vertexBuffer = createBuffer(BufferType::VertexBuffer);
+    arena->m_vertexBuffer->m_size = vertexSize;
+    glBindBuffer(GL_COPY_WRITE_BUFFER, arena->m_vertexBuffer->m_oglId);
+    glBufferData(GL_COPY_WRITE_BUFFER, vertexSize, nullptr, GL_STATIC_DRAW);
+
+    arena->m_indexBuffer = createBuffer(BufferType::IndexBuffer);
+    arena->m_indexBuffer->m_size = indexSize;
+    glBindBuffer(GL_COPY_WRITE_BUFFER, arena->m_indexBuffer->m_oglId);
+    glBufferData(GL_COPY_WRITE_BUFFER, indexSize, nullptr, GL_STATIC_DRAW);
+    glBindBuffer(GL_COPY_WRITE_BUFFER, 0);
+    CHECKOGLERRORSTATE();
+
+    mGeometryArenas.add(arena);
+
+    return arena;
+}
+
+void OGLRenderBackend::uploadToBuffer(OGLBuffer *buffer, size_t offset, const void *data, size_t size) {
+    glBindBuffer(GL_COPY_WRITE_BUFFER, buffer->m_oglId);
+    glBufferSubData(GL_COPY_WRITE_BUFFER, offset, size, data);
+    glBindBuffer(GL_COPY_WRITE_BUFFER, 0);
+    mNumUploadedBytes += static_cast<ui32>(size);
+
+    CHECKOGLERRORSTATE();
+}
+
+bool OGLRenderBackend::allocGeometry(Mesh *mesh, OGLGeometryRange &range) {
+    if (nullptr == mesh) {
+        osre_debug(Tag, "Pointer to mesh is nullptr");
+        return false;
+    }
+
+    BufferData *vertices = mesh->getVertexBuffer();
+    BufferData *indices = mesh->getIndexBuffer();
+    if (nullptr == vertices || nullptr == indices || 0 == vertices->getSize() || 0 == indices->getSize()) {
+        return false;
+    }
+
+    const VertexType type = mesh->getVertexType();
+    const size_t stride = Mesh::getVertexSize(type);
+    if (0 == stride) {
+        return false;
+    }
+
+    // A mesh added again gets a new range, the old one would never be released otherwise
+    releaseGeometry(mesh->getId());
+
+    // Vertices are aligned to the stride, so the offset is a base vertex
+    const size_t vertexSize = vertices->getSize();
+    const size_t indexSize = indices->getSize();
+    size_t vertexOffset = Common::FreeListAllocator::InvalidOffset;
+    size_t indexOffset = Common::FreeListAllocator::InvalidOffset;
+    ui32 arenaIdx = NoGeometryArena;
+    for (ui32 i = 0; i < mGeometryArenas.size(); ++i) {
+        OGLGeometryArena *current = mGeometryArenas[i];
+        if (current->m_vertexType != type) {
+            continue;
+        }
+
+        vertexOffset = current->m_vertices.alloc(vertexSize, stride);
+        if (Common::FreeListAllocator::InvalidOffset == vertexOffset) {
+            continue;
+        }
+        indexOffset = current->m_indices.alloc(indexSize, IndexAlignment);
+        if (Common::FreeListAllocator::InvalidOffset == indexOffset) {
+            current->m_vertices.release(vertexOffset);
+            continue;
+        }
+        arenaIdx = i;
+        break;
+    }
+
+    if (NoGeometryArena == arenaIdx) {
+        // Large meshes get an arena of their own size
+        const size_t arenaVertexSize = vertexSize + stride > GeometryArenaVertexSize ? vertexSize + stride : GeometryArenaVertexSize;
+        const size_t arenaIndexSize = indexSize + IndexAlignment > GeometryArenaIndexSize ? indexSize + IndexAlignment : GeometryArenaIndexSize;
+        OGLGeometryArena *arena = createGeometryArena(type, arenaVertexSize, arenaIndexSize);
+        if (nullptr == arena) {
+            return false;
+        }
+        vertexOffset = arena->m_vertices.alloc(vertexSize, stride);
+        indexOffset = arena->m_indices.alloc(indexSize, IndexAlignment);
+        if (Common::FreeListAllocator::InvalidOffset == vertexOffset || Common::FreeListAllocator::InvalidOffset == indexOffset) {
+            osre_error(Tag, "Cannot allocate the geometry in a new arena.");
+            if (Common::FreeListAllocator::InvalidOffset != vertexOffset) {
+                arena->m_vertices.release(vertexOffset);
+            }
+            if (Common::FreeListAllocator::InvalidOffset != indexOffset) {
+                arena->m_indices.release(indexOffset);
+            }
+            return false;
+        }
+        arenaIdx = static_cast<ui32>(mGeometryArenas.size() - 1);
+    }
+
+    OGLGeometryArena *arena = mGeometryArenas[arenaIdx];
+    uploadToBuffer(arena->m_vertexBuffer, vertexOffset, vertices->getData(), vertexSize);
+    uploadToBuffer(arena->m_indexBuffer, indexOffset, indices->getData(), indexSize);
+
+    range.m_arena = arenaIdx;
+    range.m_vertexOffset = vertexOffset;
+    range.m_vertexSize = vertexSize;
+    range.m_indexOffset = indexOffset;
+    range.m_baseVertex = static_cast<GLint>(vertexOffset / stride);
+    mGeometryLookupMap.insert(mesh->getId(), range);
+
+    return true;
+}
+
+bool OGLRenderBackend::releaseGeometry(guid geoId) {
+    OGLGeometryRange range;
+    if (!mGeometryLookupMap.getValue(geoId, range)) {
+        return false;
+    }
+    mGeometryLookupMap.remove(geoId);
+
+    if (range.m_arena >= mGeometryArenas.size()) {
+        return false;
+    }
+
+    // The arena keeps its buffers, the ranges are reused by the next meshes
+    OGLGeometryArena *arena = mGeometryArenas[range.m_arena];
+    arena->m_vertices.release(range.m_vertexOffset);
+    arena->m_indices.release(range.m_indexOffset);
+
+    return true;
+}
+
+OGLVertexArray *OGLRenderBackend::createGeometryVertexArray(ui32 arenaIdx, OGLShader *shader) {
+    if (arenaIdx >= mGeometryArenas.size() || nullptr == shader) {
+        return nullptr;
+    }
+
+    OGLGeometryArena *arena = mGeometryArenas[arenaIdx];
+    OGLVertexArray *vertexArray = createVertexArray();
+    bindVertexArray(vertexArray);
+    bindBuffer(arena->m_vertexBuffer);
+
+    TArray<OGLVertexAttribute *> attributes;
+    createVertexCompArray(arena->m_vertexType, shader, attributes);
+    bindVertexLayout(vertexArray, shader, Mesh::getVertexSize(arena->m_vertexType), attributes);
+    releaseVertexCompArray(attributes);
+
+    bindBuffer(arena->m_indexBuffer);
+    unbindVertexArray();
+
+    return vertexArray;
+}
+
+OGLVertexArray *OGLRenderBackend::getGeometryVertexArray(ui32 arenaIdx, OGLShader *shader) {
+    if (arenaIdx >= mGeometryArenas.size() || nullptr == shader) {
+        return nullptr;
+    }
+
+    // A vertex array stores attribute locations, only shaders using the same ones can share it
+    OGLGeometryArena *arena = mGeometryArenas[arenaIdx];
+    TArray<OGLVertexAttribute *> attributes;
+    createVertexCompArray(arena->m_vertexType, shader, attributes);
+    ui32 key = 2166136261u;
+    for (ui32 i = 0; i < attributes.size(); ++i) {
+        key = (key ^ attributes[i]->m_index) * 16777619u;
+    }
+    releaseVertexCompArray(attributes);
+
+    OGLVertexArray *vertexArray = nullptr;
+    if (arena->m_vertexArrays.getValue(key, vertexArray)) {
+        return vertexArray;
+    }
+
+    vertexArray = createGeometryVertexArray(arenaIdx, shader);
+    if (nullptr != vertexArray) {
+        arena->m_vertexArrays.insert(key, vertexArray);
+    }
+
+    return vertexArray;
+}
+
+void OGLRenderBackend::updateMeshBuffer(guid geoId, size_t offset, void *data, size_t size) {
+    OGLGeometryRange range;
+    if (!mGeometryLookupMap.getValue(geoId, range)) {
+        updateBuffer(getBufferById(geoId), offset, data, size);
+        return;
+    }
+
+    // The neighbours in the arena must not be overwritten
+    if (offset + size > range.m_vertexSize) {
+        osre_debug(Tag, "Static mesh cannot grow, use a buffer with write access for it.");
+        return;
+    }
+
+    OGLBuffer *buffer = mGeometryArenas[range.m_arena]->m_vertexBuffer;
+    if (nullptr != mStreamBuffer && mStreamBuffer->upload(buffer->m_oglId, range.m_vertexOffset + offset, data, size)) {
+        mNumUploadedBytes += static_cast<ui32>(size);
+        return;
+    }
+    uploadToBuffer(buffer, range.m_vertexOffset + offset, data, size);
+}
+
+void OGLRenderBackend::releaseAllGeometryArenas() {
+    // The vertex arrays of the arenas are released with all other vertex arrays
+    for (ui32 i = 0; i < mGeometryArenas.size(); ++i) {
+        OGLGeometryArena *arena = mGeometryArenas[i];
+        releaseBuffer(arena->m_vertexBuffer);
+        releaseBuffer(arena->m_indexBuffer);
+        delete arena;
+    }
+    mGeometryArenas.clear();
+    mGeometryLookupMap.clear();
+}
+
+OGLBuffer *OGLRenderBackend::createInstanceBuffer(const c8 *batchId, size_t numInstances) {
+    if (nullptr == batchId) {
+        osre_debug(Tag, "Batch id is nullptr");
+        return nullptr;
+    }
+
+    OGLBuffer *buffer = getInstanceBuffer(batchId);
+    if (nullptr != buffer) {
+        return buffer;
+    }
+
+    // Instance buffers are looked up by the batch, the hash of its name is used as the geo id
+    const ui32 hash = Common::StringUtils::hashName(batchId);
+    buffer = createBuffer(BufferType::InstanceBuffer);
+    buffer->m_geoId = hash;
+    mInstanceBufferLookupMap.insert(hash, buffer->m_handle);
+    if (0 != numInstances) {
+        TArray<InstanceVert> instances;
+        instances.resize(numInstances);
+        for (size_t i = 0; i < numInstances; ++i) {
+            instances[i] = InstanceVert();
+        }
+        bindBuffer(buffer);
+        copyDataToBuffer(buffer, &instances[0], sizeof(InstanceVert) * numInstances, BufferAccessType::ReadWrite);
+        unbindBuffer(buffer);
+    }
+
+    return buffer;
+}
+
+OGLBuffer *OGLRenderBackend::getInstanceBuffer(const c8 *batchId) const {
+    if (nullptr == batchId) {
+        return nullptr;
+    }
+
+    Handle handle;
+    if (!mInstanceBufferLookupMap.getValue(Common::StringUtils::hashName(batchId), handle)) {
+        return nullptr;
+    }
+
+    return getBuffer(handle);
 }
 
 bool OGLRenderBackend::createVertexCompArray(const VertexLayout *layout, OGLShader *shader, VertAttribArray &attributes) {
@@ -478,9 +876,7 @@ void OGLRenderBackend::releaseVertexCompArray(TArray<OGLVertexAttribute *> &attr
 OGLVertexArray *OGLRenderBackend::createVertexArray() {
     OGLVertexArray *vertexArray = new OGLVertexArray;
     glGenVertexArrays(1, &vertexArray->m_id);
-    const size_t id = mVertexArrays.size();
-    mVertexArrays.add(vertexArray);
-    vertexArray->m_slot = id;
+    vertexArray->m_handle = mVertexArrays.add(vertexArray);
 
     return vertexArray;
 }
@@ -527,6 +923,36 @@ bool OGLRenderBackend::bindVertexLayout(OGLVertexArray *va, OGLShader *shader, s
     return true;
 }
 
+bool OGLRenderBackend::bindInstanceLayout(OGLVertexArray *va, OGLShader *shader, OGLBuffer *instanceBuffer) {
+    if (nullptr == va || nullptr == shader || nullptr == instanceBuffer) {
+        return false;
+    }
+
+    bindVertexArray(va);
+    bindBuffer(instanceBuffer);
+
+    // The transform columns and the color are stored as consecutive vec4's
+    bool bound = false;
+    const String *attributes = InstanceVert::getAttributes();
+    for (size_t i = 0; i < InstanceVert::getNumAttributes(); ++i) {
+        // Shaders without instance attributes still may use gl_InstanceID
+        const GLint loc = shader->getAttributeLocation(attributes[i]);
+        if (InvalidLocationId == loc) {
+            continue;
+        }
+
+        glEnableVertexAttribArray(loc);
+        glVertexAttribPointer(loc, 4, GL_FLOAT, GL_FALSE, (GLsizei)sizeof(InstanceVert),
+                (const GLvoid *)(i * sizeof(glm::vec4)));
+        glVertexAttribDivisor(loc, 1);
+        bound = true;
+    }
+    unbindVertexArray();
+    unbindBuffer(instanceBuffer);
+
+    return bound;
+}
+
 void OGLRenderBackend::destroyVertexArray(OGLVertexArray *vertexArray) {
     if (nullptr == vertexArray) {
         return;
@@ -536,13 +962,13 @@ void OGLRenderBackend::destroyVertexArray(OGLVertexArray *vertexArray) {
     vertexArray->m_id = NotInitedHandle;
 }
 
-OGLVertexArray *OGLRenderBackend::getVertexArraybyId(ui32 id) const {
-    OGLVertexArray *va(nullptr);
-    if (id < mVertexArrays.size()) {
-        va = mVertexArrays[id];
+OGLVertexArray *OGLRenderBackend::getVertexArray(Handle handle) const {
+    OGLVertexArray *const *va = mVertexArrays.get(handle);
+    if (nullptr == va) {
+        return nullptr;
     }
 
-    return va;
+    return *va;
 }
 
 void OGLRenderBackend::bindVertexArray(OGLVertexArray *vertexArray) {
@@ -552,9 +978,13 @@ void OGLRenderBackend::bindVertexArray(OGLVertexArray *vertexArray) {
     }
 
     if ((mActiveVertexArray == OGLNotSetId) || (mActiveVertexArray != vertexArray->m_id)) {
+        flushMultiDraw();
         mActiveVertexArray = vertexArray->m_id;
         glBindVertexArray(mActiveVertexArray);
         CHECKOGLERRORSTATE();
+        countStateChange(true);
+    } else {
+        countStateChange(false);
     }
 }
 
@@ -564,17 +994,66 @@ void OGLRenderBackend::unbindVertexArray() {
 }
 
 void OGLRenderBackend::releaseAllVertexArrays() {
-    for (ui32 i = 0; i < mVertexArrays.size(); ++i) {
-        destroyVertexArray(mVertexArrays[i]);
+    for (ui32 i = 0; i < mGeometryArenas.size(); ++i) {
+        mGeometryArenas[i]->m_vertexArrays.clear();
+    }
+
+    for (size_t i = 0; i < mVertexArrays.capacity(); ++i) {
+        if (mVertexArrays.isUsed(i)) {
+            destroyVertexArray(mVertexArrays.at(i));
+            delete mVertexArrays.at(i);
+        }
     }
     mVertexArrays.clear();
 }
 
-static void loadShader(Shader *shaderInfo, OGLShader *oglShader, ShaderType type) {
+static String getDrawIdPrelude() {
+    return "#extension GL_ARB_shader_draw_parameters : require\n"
+           "#define OSRE_DRAW_ID gl_DrawIDARB\n"
+           "#define OSRE_MAX_DRAWS " + osre_to_string(OGLMultiDrawBatch::MaxDraws) + "\n";
+}
+
+static String::size_type findVersionDirective(const String &source) {
+    // Comments and empty lines may precede the directive, it starts the first line of code
+    String::size_type pos = source.find("#version");
+    while (String::npos != pos) {
+        String::size_type lineStart = pos;
+        while (lineStart > 0 && (' ' == source[lineStart - 1] || '\t' == source[lineStart - 1])) {
+            --lineStart;
+        }
+        if (0 == lineStart || '\n' == source[lineStart - 1]) {
+            return pos;
+        }
+        pos = source.find("#version", pos + 1);
+    }
+
+    return String::npos;
+}
+
+static String insertPrelude(const String &source, const String &prelude) {
+    // The prelude has to follow the version directive
+    const String::size_type versionPos = findVersionDirective(source);
+    if (String::npos == versionPos) {
+        return prelude + source;
+    }
+
+    const String::size_type lineEnd = source.find('\n', versionPos);
+    if (String::npos == lineEnd) {
+        return source + "\n" + prelude;
+    }
+
+    return source.substr(0, lineEnd + 1) + prelude + source.substr(lineEnd + 1);
+}
+
+static void loadShader(Shader *shaderInfo, OGLShader *oglShader, ShaderType type, const String &prelude) {
     osre_assert(oglShader != nullptr);
 
     if (shaderInfo->hasSource(type)) {
-        const bool result = oglShader->loadFromSource(type, shaderInfo->getSource(type));
+        String source = shaderInfo->getSource(type);
+        if (!prelude.empty() && ShaderType::SH_VertexShaderType == type) {
+            source = insertPrelude(source, prelude);
+        }
+        const bool result = oglShader->loadFromSource(type, source);
         if (!result) {
             osre_error(Tag, "Error while compiling VertexShader.");
             return;
@@ -582,6 +1061,33 @@ static void loadShader(Shader *shaderInfo, OGLShader *oglShader, ShaderType type
     }
 }
 
+void OGLRenderBackend::createProgramCache(const String &directory) {
+    delete mProgramCache;
+    mProgramCache = nullptr;
+    if (directory.empty()) {
+        return;
+    }
+
+    if (!mOglCapabilities.mProgramBinary) {
+        osre_debug(Tag, "Program binaries are not supported, shaders are compiled from source.");
+        return;
+    }
+
+    mProgramCache = new OGLProgramCache(directory, mDriverId);
+    if (!mProgramCache->isEnabled()) {
+        delete mProgramCache;
+        mProgramCache = nullptr;
+    }
+}
+
+ui32 OGLRenderBackend::getProgramCacheHitRate() const {
+    if (nullptr == mProgramCache) {
+        return 0;
+    }
+
+    return mProgramCache->getHitRate();
+}
+
 OGLShader *OGLRenderBackend::createShader(const String &name, Shader *shaderInfo) {
     if (name.empty()) {
         osre_debug(Tag, "Name for shader is nullptr");
@@ -594,42 +1100,87 @@ OGLShader *OGLRenderBackend::createShader(const String &name, Shader *shaderInfo
     }
 
     oglShader = new OGLShader(name);
-    mShaders.add(oglShader);
+    mShaderLookupMap.insert(name, mShaders.add(oglShader));
     if (shaderInfo) {
-        loadShader(shaderInfo, oglShader, ShaderType::SH_VertexShaderType);
-        loadShader(shaderInfo, oglShader, ShaderType::SH_FragmentShaderType);
-        loadShader(shaderInfo, oglShader, ShaderType::SH_GeometryShaderType);
+        bool result = false;
+        ui64 key = 0;
+
+        // Vertex shaders can read the model matrices of multi-draws, if the driver supports the draw id
+        const String prelude = mOglCapabilities.mDrawParameters ? getDrawIdPrelude() : String();
+        if (nullptr != mProgramCache) {
+            key = mProgramCache->computeKey(*shaderInfo, prelude);
+            GLenum format = 0;
+            std::vector<uc8> binary;
+            if (mProgramCache->load(key, format, binary)) {
+                result = oglShader->createFromBinary(format, binary);
+                if (!result) {
+                    osre_debug(Tag, "Cached binary of shader " + name + " was rejected, compiling it.");
+                    mProgramCache->remove(key);
+                }
+            }
+            mProgramCache->countLookup(result);
+        }
 
-        bool result = oglShader->createAndLink();
         if (!result) {
-            osre_error(Tag, "Error while linking shader");
+            loadShader(shaderInfo, oglShader, ShaderType::SH_VertexShaderType, prelude);
+            loadShader(shaderInfo, oglShader, ShaderType::SH_FragmentShaderType, prelude);
+            loadShader(shaderInfo, oglShader, ShaderType::SH_GeometryShaderType, prelude);
+
+            result = oglShader->createAndLink(nullptr != mProgramCache);
+            if (!result) {
+                osre_error(Tag, "Error while linking shader");
+            } else if (nullptr != mProgramCache) {
+                GLenum format = 0;
+                std::vector<uc8> binary;
+                if (oglShader->getBinary(format, binary)) {
+                    mProgramCache->store(key, format, binary);
+                }
+            }
+        }
+
+        const UniformBlock *frameBlock = oglShader->getUniformBlock(UniformBlockType::FrameBlock);
+        if (nullptr != frameBlock && frameBlock->getSize() != mFrameBlock.getSize()) {
+            osre_warn(Tag, "Frame block of shader " + name + " does not match the engine layout.");
+        }
+        const UniformBlock *drawBlock = oglShader->getUniformBlock(UniformBlockType::DrawBlock);
+        if (nullptr != drawBlock && drawBlock->getSize() != DrawBlockSize) {
+            osre_warn(Tag, "Draw block of shader " + name + " does not match the engine layout.");
         }
     }
 
     return oglShader;
 }
 
-OGLShader *OGLRenderBackend::getShader(const String &name) {
+OGLShader *OGLRenderBackend::getShader(const String &name) const {
     if (name.empty()) {
         return nullptr;
     }
 
-    OGLShader *shader = nullptr;
-    for (ui32 i = 0; i < mShaders.size(); ++i) {
-        if (mShaders[i]->getName() == name) {
-            shader = mShaders[i];
-            break;
-        }
+    Handle handle;
+    if (!mShaderLookupMap.getValue(name, handle)) {
+        return nullptr;
     }
 
-    return shader;
+    return getShader(handle);
+}
+
+OGLShader *OGLRenderBackend::getShader(Handle handle) const {
+    OGLShader *const *shader = mShaders.get(handle);
+    if (nullptr == shader) {
+        return nullptr;
+    }
+
+    return *shader;
 }
 
 bool OGLRenderBackend::useShader(OGLShader *shader) {
     if (mShaderInUse == shader) {
         // shader already in use
+        countStateChange(false);
         return true;
     }
+    countStateChange(true);
+    flushMultiDraw();
 
     // unuse an older shader
     if (nullptr != mShaderInUse) {
@@ -650,40 +1201,39 @@ OGLShader *OGLRenderBackend::getActiveShader() const {
 }
 
 bool OGLRenderBackend::releaseShader(OGLShader *shader) {
-    if (nullptr != shader) {
+    if (nullptr == shader) {
         return false;
     }
 
     // look for the shader
-    ui32 idx(0);
-    bool found(false);
-    for (ui32 i = 0; i < mShaders.size(); ++i) {
-        if (mShaders[i] == shader) {
-            found = true;
-            idx = i;
-            break;
-        }
+    Handle handle;
+    if (!mShaderLookupMap.getValue(shader->getName(), handle) || getShader(handle) != shader) {
+        return false;
     }
 
-    // remove shader from list
-    if (found) {
-        delete mShaders[idx];
-        mShaders.remove(idx);
+    // remove shader from the table
+    if (mShaderInUse == shader) {
+        useShader(nullptr);
     }
+    mShaderLookupMap.remove(shader->getName());
+    mShaders.remove(handle);
+    delete shader;
 
-    return found;
+    return true;
 }
 
 void OGLRenderBackend::releaseAllShaders() {
-    for (ui32 i = 0; i < mShaders.size(); ++i) {
-        if (nullptr != mShaders[i]) {
-            if (mShaderInUse == mShaders[i]) {
+    for (size_t i = 0; i < mShaders.capacity(); ++i) {
+        if (mShaders.isUsed(i)) {
+            OGLShader *shader = mShaders.at(i);
+            if (mShaderInUse == shader) {
                 useShader(nullptr);
             }
-            delete mShaders[i];
+            delete shader;
         }
     }
     mShaders.clear();
+    mShaderLookupMap.clear();
 }
 
 OGLTexture *OGLRenderBackend::createEmptyTexture(const String &name, TextureTargetType target, PixelFormatType format,
@@ -700,18 +1250,9 @@ OGLTexture *OGLRenderBackend::createEmptyTexture(const String &name, TextureTarg
     }
 
     // get texture slot
-    size_t slot = 0;
-    if (mFreeTexSlots.isEmpty()) {
-        slot = mTextures.size();
-        tex = new OGLTexture;
-        mTextures.add(tex);
-    } else {
-        slot = mFreeTexSlots.back();
-        mFreeTexSlots.removeBack();
-        tex = mTextures[slot];
-    }
-    tex->m_slot = slot;
-    m_texLookupMap[name] = slot;
+    tex = new OGLTexture;
+    tex->m_handle = mTextures.add(tex);
+    mTextureLookupMap.insert(name, tex->m_handle);
 
     GLuint textureId;
     glGenTextures(1, &textureId);
@@ -726,6 +1267,9 @@ OGLTexture *OGLRenderBackend::createEmptyTexture(const String &name, TextureTarg
     tex->m_target = OGLEnum::getGLTextureTarget(target);
     glBindTexture(tex->m_target, textureId);
 
+    // The binding of the first stage gets lost, so the next bindTexture must not be filtered
+    mBindedTextures[0] = nullptr;
+
     glTexParameteri(tex->m_target, OGLEnum::getGLTextureEnum(TextureParameterName::TextureParamMinFilter), GL_LINEAR);
     glTexParameteri(tex->m_target, OGLEnum::getGLTextureEnum(TextureParameterName::TextureParamMagFilter), GL_LINEAR);
     glTexParameteri(tex->m_target, OGLEnum::getGLTextureEnum(TextureParameterName::TextureParamWrapS), GL_CLAMP);
@@ -740,6 +1284,9 @@ static const c8 *DefaultTextureName = "default_tex";
 
 OGLTexture *OGLRenderBackend::createDefaultTexture(TextureTargetType target, PixelFormatType pixelFormat, ui32 width, ui32 height) {
     OGLTexture *glTex = createEmptyTexture(DefaultTextureName, target, pixelFormat, width, height, 1);
+    if (nullptr == glTex) {
+        return nullptr;
+    }
     c8 *imageData = new c8[width * height];
     int value;
     size_t offset = 0;
@@ -774,6 +1321,25 @@ void OGLRenderBackend::updateTexture(OGLTexture *oglTextue, ui32 offsetX, ui32 o
             oglTextue->m_height, oglTextue->m_format, GL_UNSIGNED_BYTE, data);
 }
 
+static ui32 getMipSize(ui32 size, ui32 level) {
+    const ui32 mipSize = size >> level;
+    return 0 != mipSize ? mipSize : 1;
+}
+
+static size_t getTextureSize(const Texture *tex) {
+    if (!TextureCompression::isCompressed(tex->mPixelFormat)) {
+        return static_cast<size_t>(tex->m_width) * tex->m_height * tex->m_channels;
+    }
+
+    // Compressed textures bring their whole mip chain
+    size_t size = 0;
+    for (ui32 level = 0; level < tex->mNumMipLevels; ++level) {
+        size += TextureCompression::getImageSize(tex->mPixelFormat, getMipSize(tex->m_width, level), getMipSize(tex->m_height, level));
+    }
+
+    return size;
+}
+
 OGLTexture *OGLRenderBackend::createTexture(const String &name, Texture *tex) {
     if (nullptr == tex) {
         return nullptr;
@@ -784,18 +1350,145 @@ OGLTexture *OGLRenderBackend::createTexture(const String &name, Texture *tex) {
         return glTex;
     }
 
+    const Common::ResourceState state = tex->mState.load(std::memory_order_acquire);
+    if (Common::ResourceState::Loaded != state || !isInUploadBudget(getTextureSize(tex))) {
+        glTex = createPlaceholderTexture(name, tex);
+        if (nullptr != glTex && Common::ResourceState::Error != state) {
+            // The texture data must not be evicted until it is uploaded
+            tex->mUseCount.fetch_add(1, std::memory_order_acq_rel);
+            PendingTexture pending = { tex, glTex };
+            mPendingTextures.add(pending);
+        }
+
+        return glTex;
+    }
+
     glTex = createEmptyTexture(name, tex->m_targetType, tex->mPixelFormat, tex->m_width, tex->m_height, tex->m_channels);
-    glTexImage2D(glTex->m_target, 0, GL_RGB, tex->m_width, tex->m_height, 0, glTex->m_format, GL_UNSIGNED_BYTE, tex->m_data);
-    glGenerateMipmap(glTex->m_target);
-    glTexParameterf(glTex->m_target, GL_TEXTURE_MAX_ANISOTROPY_EXT, mOglCapabilities.mMaxAniso);
+    uploadTexture(glTex, tex);
+
+    return glTex;
+}
+
+void OGLRenderBackend::processTextureUploads() {
+    mTextureUploadBytes = 0;
+    size_t i = 0;
+    while (i < mPendingTextures.size()) {
+        PendingTexture &pending = mPendingTextures[i];
+        const Common::ResourceState state = pending.mTexture->mState.load(std::memory_order_acquire);
+        if (Common::ResourceState::Loading == state) {
+            ++i;
+            continue;
+        }
+
+        // A failed texture keeps its placeholder
+        if (Common::ResourceState::Loaded == state) {
+            if (!isInUploadBudget(getTextureSize(pending.mTexture))) {
+                ++i;
+                continue;
+            }
+            uploadTexture(pending.mGLTexture, pending.mTexture);
+        }
+
+        removePendingTexture(i);
+    }
+}
+
+void OGLRenderBackend::removePendingTexture(size_t index) {
+    mPendingTextures[index].mTexture->mUseCount.fetch_sub(1, std::memory_order_acq_rel);
+    mPendingTextures[index] = mPendingTextures[mPendingTextures.size() - 1];
+    mPendingTextures.removeBack();
+}
+
+bool OGLRenderBackend::isInUploadBudget(size_t size) const {
+    // The first upload of a frame is always done, so large textures cannot starve
+    return 0 == mTextureUploadBytes || mTextureUploadBytes + size <= mTextureUploadBudget;
+}
+
+OGLTexture *OGLRenderBackend::createPlaceholderTexture(const String &name, Texture *tex) {
+    static const uc8 PlaceholderPixel[3] = { 255, 255, 255 };
+
+    OGLTexture *glTex = createEmptyTexture(name, tex->m_targetType, PixelFormatType::R8G8B8, 1, 1, 3);
+    if (nullptr == glTex) {
+        return nullptr;
+    }
+
+    glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
+    glTexImage2D(glTex->m_target, 0, GL_RGB, 1, 1, 0, glTex->m_format, GL_UNSIGNED_BYTE, PlaceholderPixel);
+    glPixelStorei(GL_UNPACK_ALIGNMENT, 4);
     glBindTexture(glTex->m_target, 0);
 
     return glTex;
 }
 
+void OGLRenderBackend::uploadTexture(OGLTexture *glTex, Texture *tex) {
+    if (nullptr == glTex || nullptr == tex) {
+        return;
+    }
+
+    // A placeholder is replaced in place, so all materials using it get the real texture
+    glTex->m_width = tex->m_width;
+    glTex->m_height = tex->m_height;
+    glTex->m_channels = tex->m_channels;
+    glTex->m_format = OGLEnum::getGLTextureFormat(tex->mPixelFormat);
+    glActiveTexture(GL_TEXTURE0);
+    glBindTexture(glTex->m_target, glTex->m_textureId);
+    mBindedTextures[0] = nullptr;
+
+    if (!TextureCompression::isCompressed(tex->mPixelFormat)) {
+        glTexImage2D(glTex->m_target, 0, GL_RGB, tex->m_width, tex->m_height, 0, glTex->m_format, GL_UNSIGNED_BYTE, tex->m_data);
+        glGenerateMipmap(glTex->m_target);
+    } else if (isTextureFormatSupported(tex->mPixelFormat)) {
+        // The mip chain was cooked offline, each level is uploaded as it is
+        const uc8 *data = tex->m_data;
+        for (ui32 level = 0; level < tex->mNumMipLevels; ++level) {
+            const ui32 width = getMipSize(tex->m_width, level);
+            const ui32 height = getMipSize(tex->m_height, level);
+            const size_t size = TextureCompression::getImageSize(tex->mPixelFormat, width, height);
+            glCompressedTexImage2D(glTex->m_target, level, glTex->m_format, width, height, 0, static_cast<GLsizei>(size), data);
+            data += size;
+        }
+        glTexParameteri(glTex->m_target, GL_TEXTURE_MAX_LEVEL, tex->mNumMipLevels - 1);
+        glTexParameteri(glTex->m_target, GL_TEXTURE_MIN_FILTER, tex->mNumMipLevels > 1 ? GL_LINEAR_MIPMAP_LINEAR : GL_LINEAR);
+    } else if (TextureCompression::canDecode(tex->mPixelFormat)) {
+        // The driver cannot sample the format, so the first level is decoded and the chain is built again
+        std::vector<uc8> rgba(static_cast<size_t>(tex->m_width) * tex->m_height * 4);
+        TextureCompression::decode(tex->mPixelFormat, tex->m_data, tex->m_width, tex->m_height, rgba.data());
+        glTex->m_format = GL_RGBA;
+        glTexImage2D(glTex->m_target, 0, GL_RGBA, tex->m_width, tex->m_height, 0, GL_RGBA, GL_UNSIGNED_BYTE, rgba.data());
+        glGenerateMipmap(glTex->m_target);
+    } else {
+        osre_error(Tag, "Compressed texture format is not supported by the GPU: " + tex->m_textureName);
+    }
+    glTexParameterf(glTex->m_target, GL_TEXTURE_MAX_ANISOTROPY_EXT, mOglCapabilities.mMaxAniso);
+    glBindTexture(glTex->m_target, 0);
+
+    const size_t size = getTextureSize(tex);
+    mTextureUploadBytes += size;
+    mNumUploadedBytes += static_cast<ui32>(size);
+}
+
+bool OGLRenderBackend::isTextureFormatSupported(PixelFormatType format) const {
+    switch (format) {
+        case PixelFormatType::BC1:
+        case PixelFormatType::BC3:
+            return mOglCapabilities.mCompressionS3TC;
+        case PixelFormatType::BC5:
+            return mOglCapabilities.mCompressionRGTC;
+        case PixelFormatType::BC7:
+            return mOglCapabilities.mCompressionBPTC;
+        case PixelFormatType::ETC2_RGB8:
+        case PixelFormatType::ETC2_RGBA8:
+            return mOglCapabilities.mCompressionETC2;
+        default:
+            break;
+    }
+
+    return true;
+}
+
 OGLTexture *OGLRenderBackend::createTextureFromFile(const String &name, const IO::Uri &fileloc) {
     OGLTexture *tex = findTexture(name);
-    if (nullptr == tex) {
+    if (nullptr != tex) {
         return tex;
     }
 
@@ -809,22 +1502,14 @@ OGLTexture *OGLRenderBackend::createTextureFromFile(const String &name, const IO
         return nullptr;
     }
 
-    // swap the texture data
-    // todo: must be done by my codec
-    for (i32 j = 0; j * 2 < height; ++j) {
-        i32 index1 = j * width * channels;
-        i32 index2 = (height - 1 - j) * width * channels;
-        for (i32 i = width * channels; i > 0; --i) {
-            GLubyte temp = data[index1];
-            data[index1] = data[index2];
-            data[index2] = temp;
-            ++index1;
-            ++index2;
-        }
-    }
+    TextureLoader::flipVertical(data, width, height, channels);
 
     // create texture and fill it
     tex = createEmptyTexture(name, TextureTargetType::Texture2D, PixelFormatType::R8G8B8, width, height, channels);
+    if (nullptr == tex) {
+        stbi_image_free(data);
+        return nullptr;
+    }
     glTexImage2D(tex->m_target, 0, GL_RGB, width, height, 0, tex->m_format, GL_UNSIGNED_BYTE, data);
     glBindTexture(tex->m_target, 0);
 
@@ -838,12 +1523,21 @@ OGLTexture *OGLRenderBackend::findTexture(const String &name) const {
         return nullptr;
     }
 
-    std::map<String, size_t>::const_iterator it = m_texLookupMap.find(name);
-    if (it == m_texLookupMap.end()) {
+    Handle handle;
+    if (!mTextureLookupMap.getValue(name, handle)) {
         return nullptr;
     }
 
-    return mTextures[it->second];
+    return getTexture(handle);
+}
+
+OGLTexture *OGLRenderBackend::getTexture(Handle handle) const {
+    OGLTexture *const *tex = mTextures.get(handle);
+    if (nullptr == tex) {
+        return nullptr;
+    }
+
+    return *tex;
 }
 
 bool OGLRenderBackend::bindTexture(OGLTexture *oglTexture, TextureStageType stageType) {
@@ -851,6 +1545,13 @@ bool OGLRenderBackend::bindTexture(OGLTexture *oglTexture, TextureStageType stag
         return false;
     }
 
+    // texture already bound to this stage
+    if (mBindedTextures[(size_t)stageType] == oglTexture) {
+        countStateChange(false);
+        return true;
+    }
+    countStateChange(true);
+
     GLenum glStageType = OGLEnum::getGLTextureStage(stageType);
     glActiveTexture(glStageType);
     glBindTexture(oglTexture->m_target, oglTexture->m_textureId);
@@ -867,42 +1568,49 @@ bool OGLRenderBackend::unbindTexture( TextureStageType stageType ) {
 
     if (nullptr != mBindedTextures[index]) {
         OGLTexture *oglTexture = mBindedTextures[index];
+        glActiveTexture(OGLEnum::getGLTextureStage(stageType));
         glBindTexture(oglTexture->m_target, 0);
         mBindedTextures[index] = nullptr;
+        countStateChange(true);
+    } else {
+        countStateChange(false);
     }
 
     return true;
 }
 
 void OGLRenderBackend::releaseTexture(OGLTexture *oglTexture) {
-    if (nullptr == mTextures[oglTexture->m_slot]) {
+    if (nullptr == oglTexture || getTexture(oglTexture->m_handle) != oglTexture) {
         return;
     }
 
-    glDeleteTextures(1, &oglTexture->m_textureId);
-    oglTexture->m_textureId = OGLNotSetId;
-    oglTexture->m_width = 0;
-    oglTexture->m_height = 0;
-    oglTexture->m_channels = 0;
-
-    mFreeTexSlots.add(oglTexture->m_slot);
+    for (size_t i = 0; i < mBindedTextures.size(); ++i) {
+        if (oglTexture == mBindedTextures[i]) {
+            mBindedTextures[i] = nullptr;
+        }
+    }
 
-    std::map<String, size_t>::iterator it(m_texLookupMap.find(oglTexture->m_name));
-    if (m_texLookupMap.end() != it) {
-        it = m_texLookupMap.erase(it);
+    for (size_t i = 0; i < mPendingTextures.size(); ++i) {
+        if (oglTexture == mPendingTextures[i].mGLTexture) {
+            removePendingTexture(i);
+            break;
+        }
     }
-    oglTexture->m_slot = 0;
+
+    glDeleteTextures(1, &oglTexture->m_textureId);
+    mTextureLookupMap.remove(oglTexture->m_name);
+    mTextures.remove(oglTexture->m_handle);
+    delete oglTexture;
 }
 
 void OGLRenderBackend::releaseAllTextures() {
-    for (ui32 i = 0; i < mTextures.size(); ++i) {
-        if (mTextures[i]->m_textureId != OGLNotSetId) {
-            releaseTexture(mTextures[i]);
+    for (size_t i = 0; i < mTextures.capacity(); ++i) {
+        if (mTextures.isUsed(i)) {
+            releaseTexture(mTextures.at(i));
         }
     }
-    mFreeTexSlots.clear();
     mTextures.clear();
-    m_texLookupMap.clear();
+    mTextureLookupMap.clear();
 }
 
 OGLParameter *OGLRenderBackend::createParameter(const String &name, ParameterType type,
@@ -917,7 +1625,7 @@ OGLParameter *OGLRenderBackend::createParameter(const String &name, ParameterTyp
     param = new OGLParameter;
     param->m_name = name;
     param->m_type = type;
-    param->m_loc = NoneLocation;
+    param->m_id = getParameterId(name);
     param->m_numItems = numItems;
     param->m_data = UniformDataBlob::create(type, param->m_numItems);
     if (nullptr != blob) {
@@ -926,6 +1634,7 @@ OGLParameter *OGLRenderBackend::createParameter(const String &name, ParameterTyp
         }
     }
     mParameters.add(param);
+    mParameterLookupMap.insert(name, param);
 
     return param;
 }
@@ -935,13 +1644,12 @@ OGLParameter *OGLRenderBackend::getParameter(const String &name) const {
         return nullptr;
     }
 
-    for (ui32 i = 0; i < mParameters.size(); ++i) {
-        if (mParameters[i]->m_name == name) {
-            return mParameters[i];
-        }
+    OGLParameter *param = nullptr;
+    if (!mParameterLookupMap.getValue(name, param)) {
+        return nullptr;
     }
 
-    return nullptr;
+    return param;
 }
 
 void OGLRenderBackend::setParameter(OGLParameter *param) {
@@ -955,65 +1663,89 @@ void OGLRenderBackend::setParameter(OGLParameter *param) {
         return;
     }
 
-    if (NoneLocation == param->m_loc) {
-        param->m_loc = mShaderInUse->getUniformLocation(param->m_name);
-        if (NoneLocation == param->m_loc) {
-            osre_debug(Tag, "Cannot location for parameter " + param->m_name + " in shader " + mShaderInUse->getName() + ".");
-            return;
-        }
+    // Block members get uploaded with their block before the next draw
+    const i32 member = mShaderInUse->getMaterialBlockMember(param->m_id);
+    if (-1 != member) {
+        UniformBlock *materialBlock = mShaderInUse->getUniformBlock(UniformBlockType::MaterialBlock);
+        materialBlock->setValue(static_cast<size_t>(member), param->m_data->getData(), param->m_data->m_size);
+        return;
+    }
+
+    // Locations belong to the program, parameters are shared by all of them
+    const GLint loc = mShaderInUse->getUniformLocation(param->m_id);
+    if (NoneLocation == loc) {
+        return;
     }
 
     switch (param->m_type) {
         case ParameterType::PT_Int: {
             GLint data;
             ::memcpy(&data, param->m_data->getData(), sizeof(GLint));
-            glUniform1i(param->m_loc, data);
+            glUniform1i(loc, data);
         } break;
 
         case ParameterType::PT_IntArray: {
-            glUniform1iv(param->m_loc, (GLsizei)param->m_numItems, (i32 *)param->m_data->getData());
+            glUniform1iv(loc, (GLsizei)param->m_numItems, (i32 *)param->m_data->getData());
         } break;
 
         case ParameterType::PT_Float: {
             GLfloat value;
             ::memcpy(&value, param->m_data->getData(), sizeof(GLfloat));
-            glUniform1f(param->m_loc, value);
+            glUniform1f(loc, value);
         } break;
 
         case ParameterType::PT_FloatArray: {
-            glUniform1fv(param->m_loc, (GLsizei)param->m_numItems, (f32 *)param->m_data->getData());
+            glUniform1fv(loc, (GLsizei)param->m_numItems, (f32 *)param->m_data->getData());
 
         } break;
 
         case ParameterType::PT_Float2: {
             GLfloat value[2] = {};
             ::memcpy(&value[0], param->m_data->getData(), sizeof(GLfloat) * 2);
-            glUniform2f(param->m_loc, value[0], value[1]);
+            glUniform2f(loc, value[0], value[1]);
         } break;
 
         case ParameterType::PT_Float2Array: {
-            glUniform2fv(param->m_loc, (GLsizei)param->m_numItems, (f32 *)param->m_data->getData());
+            glUniform2fv(loc, (GLsizei)param->m_numItems, (f32 *)param->m_data->getData());
         } break;
 
         case ParameterType::PT_Float3: {
             GLfloat value[3] = {};
             ::memcpy(&value[0], param->m_data->getData(), sizeof(GLfloat) * 3);
-            glUniform3f(param->m_loc, value[0], value[1], value[2]);
+            glUniform3f(loc, value[0], value[1], value[2]);
         } break;
 
         case ParameterType::PT_Float3Array: {
-            glUniform3fv(param->m_loc, (GLsizei)param->m_numItems, (f32 *)param->m_data->getData());
+            glUniform3fv(loc, (GLsizei)param->m_numItems, (f32 *)param->m_data->getData());
+
+        } break;
+
+        case ParameterType::PT_Float4: {
+            GLfloat value[4] = {};
+            ::memcpy(&value[0], param->m_data->getData(), sizeof(GLfloat) * 4);
+            glUniform4f(loc, value[0], value[1], value[2], value[3]);
+        } break;
+
+        case ParameterType::PT_Float4Array: {
+            glUniform4fv(loc, (GLsizei)param->m_numItems, (f32 *)param->m_data->getData());
+        } break;
 
+        case ParameterType::PT_Mat3: {
+            glUniformMatrix3fv(loc, 1, GL_FALSE, (f32 *)param->m_data->getData());
+        } break;
+
+        case ParameterType::PT_Mat3Array: {
+            glUniformMatrix3fv(loc, (GLsizei)param->m_numItems, GL_FALSE, (f32 *)param->m_data->getData());
         } break;
 
         case ParameterType::PT_Mat4: {
             glm::mat4 mat;
             ::memcpy(&mat, param->m_data->getData(), sizeof(glm::mat4));
-            glUniformMatrix4fv(param->m_loc, 1, GL_FALSE, glm::value_ptr(mat));
+            glUniformMatrix4fv(loc, 1, GL_FALSE, glm::value_ptr(mat));
         } break;
 
         case ParameterType::PT_Mat4Array: {
-            glUniformMatrix4fv(param->m_loc, (GLsizei)param->m_numItems, GL_FALSE, (f32 *)param->m_data->getData());
+            glUniformMatrix4fv(loc, (GLsizei)param->m_numItems, GL_FALSE, (f32 *)param->m_data->getData());
         } break;
 
         default:
@@ -1024,6 +1756,10 @@ void OGLRenderBackend::setParameter(OGLParameter *param) {
 
 void OGLRenderBackend::releaseAllParameters() {
     ContainerClear(mParameters);
+    mParameterLookupMap.clear();
+    mModelParam = nullptr;
+    mViewParam = nullptr;
+    mProjectionParam = nullptr;
 }
 
 void OGLRenderBackend::setParameter(OGLParameter **param, size_t numParam) {
@@ -1039,7 +1775,49 @@ void OGLRenderBackend::setParameter(OGLParameter **param, size_t numParam) {
     }
 }
 
-size_t OGLRenderBackend::addPrimitiveGroup(PrimitiveGroup *grp) {
+void OGLRenderBackend::commitUniformBlocks() {
+    if (nullptr == mShaderInUse) {
+        return;
+    }
+
+    if (nullptr != mShaderInUse->getUniformBlock(UniformBlockType::FrameBlock)) {
+        if (0 == mFrameBlockBuffer) {
+            glGenBuffers(1, &mFrameBlockBuffer);
+            glBindBuffer(GL_UNIFORM_BUFFER, mFrameBlockBuffer);
+            glBufferData(GL_UNIFORM_BUFFER, mFrameBlock.getSize(), mFrameBlock.getData(), GL_DYNAMIC_DRAW);
+            glBindBufferBase(GL_UNIFORM_BUFFER, static_cast<GLuint>(UniformBlockType::FrameBlock), mFrameBlockBuffer);
+            mFrameBlock.clearDirty();
+        } else if (mFrameBlock.isDirty()) {
+            glBindBuffer(GL_UNIFORM_BUFFER, mFrameBlockBuffer);
+            glBufferSubData(GL_UNIFORM_BUFFER, 0, mFrameBlock.getSize(), mFrameBlock.getData());
+            mFrameBlock.clearDirty();
+            countStateChange(true);
+        }
+        glBindBuffer(GL_UNIFORM_BUFFER, 0);
+    }
+
+    const ui32 numUploads = mShaderInUse->commitUniformBlocks();
+    for (ui32 i = 0; i < numUploads; ++i) {
+        countStateChange(true);
+    }
+}
+
+static size_t getIndexSize(GLenum indexType) {
+    switch (indexType) {
+        case GL_UNSIGNED_BYTE:
+            return sizeof(uc8);
+        case GL_UNSIGNED_SHORT:
+            return sizeof(ui16);
+        case GL_UNSIGNED_INT:
+            return sizeof(ui32);
+        default:
+            break;
+    }
+
+    return 0;
+}
+
+size_t OGLRenderBackend::addPrimitiveGroup(PrimitiveGroup *grp, const OGLGeometryRange *range) {
     if (nullptr == grp) {
         osre_error(Tag, "Group pointer is nullptr");
         return NotInitedHandle;
@@ -1050,6 +1828,15 @@ size_t OGLRenderBackend::addPrimitiveGroup(PrimitiveGroup *grp) {
     oglGrp->m_indexType = OGLEnum::getGLIndexType(grp->m_indexType);
     oglGrp->m_startIndex = (ui32)grp->m_startIndex;
     oglGrp->m_numIndices = grp->m_numIndices;
+    const size_t indexSize = getIndexSize(oglGrp->m_indexType);
+    oglGrp->m_indexOffset = oglGrp->m_startIndex * indexSize;
+    if (nullptr != range) {
+        oglGrp->m_baseVertex = range->m_baseVertex;
+        oglGrp->m_indexOffset += range->m_indexOffset;
+    }
+    if (0 != indexSize) {
+        oglGrp->m_firstIndex = static_cast<ui32>(oglGrp->m_indexOffset / indexSize);
+    }
 
     const size_t idx = mPrimitives.size();
     mPrimitives.add(oglGrp);
@@ -1149,31 +1936,112 @@ void OGLRenderBackend::releaseFrameBuffer(OGLFrameBuffer *oglFB) {
 void OGLRenderBackend::render(size_t primpGrpIdx) {
     OGLPrimGroup *grp(mPrimitives[primpGrpIdx]);
     if (nullptr != grp) {
-        glDrawElements(grp->m_primitive,
+        commitUniformBlocks();
+        glDrawElementsBaseVertex(grp->m_primitive,
                 (GLsizei)grp->m_numIndices,
                 grp->m_indexType,
-                (const GLvoid *)grp->m_startIndex);
+                (const GLvoid *)grp->m_indexOffset,
+                grp->m_baseVertex);
+        ++mNumDrawCalls;
     }
 }
 
-#if _MSC_VER > 1920 && !defined(__clang__)
-#   pragma warning(pop)
-#endif
-
 void OGLRenderBackend::render(size_t primpGrpIdx, size_t numInstances) {
     OGLPrimGroup *grp(mPrimitives[primpGrpIdx]);
     if (nullptr != grp) {
-        glDrawArraysInstanced(grp->m_primitive,
-                grp->m_startIndex,
+        commitUniformBlocks();
+        glDrawElementsInstancedBaseVertex(grp->m_primitive,
                 (GLsizei)grp->m_numIndices,
-                (GLsizei)numInstances);
+                grp->m_indexType,
+                (const GLvoid *)grp->m_indexOffset,
+                (GLsizei)numInstances,
+                grp->m_baseVertex);
+        ++mNumDrawCalls;
+    }
+}
+
+bool OGLRenderBackend::canMultiDraw() const {
+    if (!mOglCapabilities.mDrawParameters || nullptr == mShaderInUse) {
+        return false;
+    }
+
+    return nullptr != mShaderInUse->getUniformBlock(UniformBlockType::DrawBlock);
+}
+
+void OGLRenderBackend::addMultiDraw(size_t primGrpIdx, const glm::mat4 &model) {
+    OGLPrimGroup *grp(mPrimitives[primGrpIdx]);
+    if (nullptr == grp) {
+        return;
+    }
+
+    if (!mMultiDraw.canAdd(*grp)) {
+        flushMultiDraw();
+    }
+    mMultiDraw.add(*grp, model);
+}
+
+void OGLRenderBackend::flushMultiDraw() {
+    if (mMultiDraw.isEmpty()) {
+        return;
+    }
+
+    commitUniformBlocks();
+    uploadDrawModels(mMultiDraw.getModels(), mMultiDraw.size());
+
+    const GLsizei numDraws = static_cast<GLsizei>(mMultiDraw.size());
+    if (mOglCapabilities.mMultiDrawIndirect) {
+        if (0 == mIndirectBuffer) {
+            glGenBuffers(1, &mIndirectBuffer);
+            glBindBuffer(GL_DRAW_INDIRECT_BUFFER, mIndirectBuffer);
+            glBufferData(GL_DRAW_INDIRECT_BUFFER, OGLMultiDrawBatch::MaxDraws * sizeof(DrawElementsIndirectCommand), nullptr, GL_DYNAMIC_DRAW);
+        }
+        streamToBuffer(mIndirectBuffer, GL_DRAW_INDIRECT_BUFFER, mMultiDraw.getCommands(), numDraws * sizeof(DrawElementsIndirectCommand));
+        glBindBuffer(GL_DRAW_INDIRECT_BUFFER, mIndirectBuffer);
+        glMultiDrawElementsIndirect(mMultiDraw.getPrimitive(), mMultiDraw.getIndexType(), nullptr, numDraws, 0);
+        glBindBuffer(GL_DRAW_INDIRECT_BUFFER, 0);
+    } else {
+        glMultiDrawElementsBaseVertex(mMultiDraw.getPrimitive(), mMultiDraw.getCounts(), mMultiDraw.getIndexType(),
+                mMultiDraw.getIndexOffsets(), numDraws, mMultiDraw.getBaseVertices());
+    }
+    CHECKOGLERRORSTATE();
+
+    ++mNumDrawCalls;
+    mMultiDraw.clear();
+}
+
+void OGLRenderBackend::uploadDrawModels(const glm::mat4 *models, ui32 numModels) {
+    if (0 == mDrawBlockBuffer) {
+        glGenBuffers(1, &mDrawBlockBuffer);
+        glBindBuffer(GL_UNIFORM_BUFFER, mDrawBlockBuffer);
+        glBufferData(GL_UNIFORM_BUFFER, DrawBlockSize, nullptr, GL_DYNAMIC_DRAW);
+        glBindBufferBase(GL_UNIFORM_BUFFER, static_cast<GLuint>(UniformBlockType::DrawBlock), mDrawBlockBuffer);
+        glBindBuffer(GL_UNIFORM_BUFFER, 0);
+    }
+
+    // A mat4 array in the std140 layout is tightly packed
+    streamToBuffer(mDrawBlockBuffer, GL_UNIFORM_BUFFER, models, numModels * sizeof(glm::mat4));
+}
+
+void OGLRenderBackend::streamToBuffer(GLuint bufferId, GLenum target, const void *data, size_t size) {
+    if (nullptr == mStreamBuffer || !mStreamBuffer->upload(bufferId, 0, data, size)) {
+        glBindBuffer(target, bufferId);
+        glBufferSubData(target, 0, size, data);
+        glBindBuffer(target, 0);
     }
+    mNumUploadedBytes += static_cast<ui32>(size);
 }
 
+#if _MSC_VER > 1920 && !defined(__clang__)
+#   pragma warning(pop)
+#endif
+
 void OGLRenderBackend::renderFrame() {
     osre_assert(nullptr != mRenderCtx);
 
     mRenderCtx->update();
+    if (nullptr != mStreamBuffer) {
+        mStreamBuffer->fence();
+    }
     if (nullptr != mFpsCounter) {
         const ui32 fps = mFpsCounter->getFPS();
         Profiling::PerformanceCounterRegistry::setCounter("fps", fps);
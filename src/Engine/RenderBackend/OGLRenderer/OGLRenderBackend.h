@@ -23,13 +23,17 @@ CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
 #pragma once
 
 #include <cppcore/Container/TArray.h>
+#include <cppcore/Container/THashMap.h>
+#include <osre/Common/THandleTable.h>
+#include <osre/Common/TNameHashMap.h>
 #include <osre/Profiling/FPSCounter.h>
 #include <osre/RenderBackend/RenderBackendService.h>
 #include <osre/RenderBackend/RenderCommon.h>
 #include <osre/RenderBackend/TransformMatrixBlock.h>
+#include <osre/RenderBackend/UniformBlock.h>
 
 #include "OGLCommon.h"
-#include <map>
+#include "OGLMultiDrawBatch.h"
 
 namespace OSRE {
 
@@ -52,7 +56,10 @@ namespace Platform {
 
 namespace RenderBackend {
 
+class Mesh;
+class OGLProgramCache;
 class OGLShader;
+class OGLStreamBuffer;
 class Shader;
 
 struct ClearState;
@@ -63,6 +70,8 @@ struct ClearState;
 struct StencilState;
 struct OGLBuffer;
 struct OGLVertexArray;
+struct OGLGeometryArena;
+struct OGLGeometryRange;
 struct OGLVertexAttribute;
 struct OGLTexture;
 struct OGLFrameBuffer;
@@ -97,13 +106,34 @@ public:
 	void clearRenderTarget(const ClearState &clearState);
 	void setViewport(i32 x, i32 y, i32 w, i32 h);
 	OGLBuffer *createBuffer(BufferType type);
-    OGLBuffer *getBufferById(guid bufferId);
-	void bindBuffer(ui32 handle);
+	OGLBuffer *getBuffer(Handle handle) const;
+	void setBufferGeoId(OGLBuffer *buffer, guid geoId);
+    OGLBuffer *getBufferById(guid geoId) const;
+	void bindBuffer(Handle handle);
 	void bindBuffer(OGLBuffer *pBuffer);
 	void unbindBuffer(OGLBuffer *pBuffer);
 	void copyDataToBuffer(OGLBuffer *pBuffer, void *pData, size_t size, BufferAccessType usage);
+	/// Will update a range of a buffer, the storage is only reallocated when the buffer grows.
+	void updateBuffer(OGLBuffer *buffer, size_t offset, void *data, size_t size);
 	void releaseBuffer(OGLBuffer *pBuffer);
 	void releaseAllBuffers();
+	/// Will store the geometry of a static mesh in the shared buffers of its vertex type.
+	bool allocGeometry(Mesh *mesh, OGLGeometryRange &range);
+	/// Will return the range of a static mesh to its arena, false if the mesh has none.
+	bool releaseGeometry(guid geoId);
+	/// Will return the vertex array shared by all meshes of the arena using the attribute locations of the shader.
+	OGLVertexArray *getGeometryVertexArray(ui32 arena, OGLShader *shader);
+	/// Will create a vertex array for the arena which is not shared, used for meshes with instance streams.
+	OGLVertexArray *createGeometryVertexArray(ui32 arena, OGLShader *shader);
+	/// Will update the vertices of a mesh, no matter if it owns its buffer or lives in an arena.
+	void updateMeshBuffer(guid geoId, size_t offset, void *data, size_t size);
+	void releaseAllGeometryArenas();
+	size_t getNumGeometryArenas() const;
+	/// Will create the per-instance buffer of a batch, it starts with identity transforms.
+	OGLBuffer *createInstanceBuffer(const c8 *batchId, size_t numInstances);
+	OGLBuffer *getInstanceBuffer(const c8 *batchId) const;
+	/// Will bind the per-instance attributes used by the shader with a divisor of one.
+	bool bindInstanceLayout(OGLVertexArray *vertexArray, OGLShader *shader, OGLBuffer *instanceBuffer);
 	bool createVertexCompArray(const VertexLayout *layout, OGLShader *pShader, VertAttribArray &attributes);
 	bool createVertexCompArray(VertexType type, OGLShader *pShader, VertAttribArray &attributes);
 	void releaseVertexCompArray(CPPCore::TArray<OGLVertexAttribute *> &attributes);
@@ -113,12 +143,16 @@ public:
 	bool bindVertexLayout(OGLVertexArray *pVertexArray, OGLShader *pShader, size_t stride,
 			const CPPCore::TArray<OGLVertexAttribute *> &attributes);
 	void destroyVertexArray(OGLVertexArray *pVertexArray);
-	OGLVertexArray *getVertexArraybyId(ui32 id) const;
+	OGLVertexArray *getVertexArray(Handle handle) const;
 	void bindVertexArray(OGLVertexArray *pVertexArray);
 	void unbindVertexArray();
 	void releaseAllVertexArrays();
+	/// Will enable the program binary cache, an empty directory or a missing driver support disables it.
+	void createProgramCache(const String &directory);
+	/// Will create the shader, the program is taken from the binary cache when possible.
 	OGLShader *createShader(const String &name, Shader *pShader);
-	OGLShader *getShader(const String &name);
+	OGLShader *getShader(const String &name) const;
+	OGLShader *getShader(Handle handle) const;
 	bool useShader(OGLShader *pShader);
 	OGLShader *getActiveShader() const;
 	bool releaseShader(OGLShader *pShader);
@@ -126,9 +160,18 @@ public:
 	OGLTexture *createEmptyTexture(const String &name, TextureTargetType target, PixelFormatType pixelFormat, ui32 width, ui32 height, ui32 channels);
     OGLTexture *createDefaultTexture(TextureTargetType target, PixelFormatType pixelFormat, ui32 width, ui32 height);
 	void updateTexture(OGLTexture *pOGLTextue, ui32 offsetX, ui32 offsetY, c8 *data, size_t size);
+	/// Will create the texture, a placeholder is used until a streamed texture is ready and in budget.
 	OGLTexture *createTexture(const String &name, Texture *tex);
+	/// Will upload the streamed textures which got ready, the per-frame byte budget is reset first.
+	void processTextureUploads();
+	void setTextureUploadBudget(size_t budget);
+	size_t getTextureUploadBudget() const;
+	size_t getNumPendingTextures() const;
+	/// Returns true, if the GPU can sample textures of the pixel format.
+	bool isTextureFormatSupported(PixelFormatType format) const;
 	OGLTexture *createTextureFromFile(const String &name, const IO::Uri &fileloc);
 	OGLTexture *findTexture(const String &name) const;
+	OGLTexture *getTexture(Handle handle) const;
 	bool bindTexture(OGLTexture *pOGLTextue, TextureStageType stageType);
     bool unbindTexture( TextureStageType stageType);
 	void releaseTexture(OGLTexture *pTexture);
@@ -137,8 +180,11 @@ public:
 	OGLParameter *getParameter(const String &name) const;
 	void setParameter(OGLParameter *param);
 	void setParameter(OGLParameter **param, size_t numParam);
+	/// Will upload the dirty uniform blocks of the frame and of the active shader.
+	void commitUniformBlocks();
 	void releaseAllParameters();
-	size_t addPrimitiveGroup(PrimitiveGroup *grp);
+	/// Will add a primitive group, the range locates the mesh in a shared buffer.
+	size_t addPrimitiveGroup(PrimitiveGroup *grp, const OGLGeometryRange *range = nullptr);
 	void releaseAllPrimitiveGroups();
     OGLFrameBuffer *createFrameBuffer(const String &name, ui32 width, ui32 height, PixelFormatType pixelFormat, bool depthBuffer);
 	void bindFrameBuffer(OGLFrameBuffer *oglFB);
@@ -146,27 +192,63 @@ public:
 	void releaseFrameBuffer(OGLFrameBuffer *oglFB);
 	void render(size_t grimpGrpIdx);
 	void render(size_t primpGrpIdx, size_t numInstances);
+	/// Returns true, if the draws of the active shader can be collected into multi-draws.
+	bool canMultiDraw() const;
+	/// Will add a primitive group to the pending multi-draw, a full batch gets submitted first.
+	void addMultiDraw(size_t primGrpIdx, const glm::mat4 &model);
+	/// Will submit the pending multi-draw, call it before any state change.
+	void flushMultiDraw();
 	void renderFrame();
 	void setFixedPipelineStates(const RenderStates &states);
     void setExtensions(const String &extensions);
     const String &getExtensions() const;
+	void countStateChange(bool issued);
+	ui32 getNumStateChanges() const;
+	ui32 getNumAvoidedStateChanges() const;
+	void resetStateChangeCounters();
+	ui32 getNumUploadedBytes() const;
+	void resetUploadCounter();
+	ui32 getProgramCacheHitRate() const;
+	ui32 getNumDrawCalls() const;
+	void resetDrawCallCounter();
     
 private:
+	OGLTexture *createPlaceholderTexture(const String &name, Texture *tex);
+	void uploadTexture(OGLTexture *glTex, Texture *tex);
+	bool isInUploadBudget(size_t size) const;
+	void removePendingTexture(size_t index);
+	OGLGeometryArena *createGeometryArena(VertexType type, size_t vertexSize, size_t indexSize);
+	void uploadToBuffer(OGLBuffer *buffer, size_t offset, const void *data, size_t size);
+	void setMatrixParameter(OGLParameter *&param, const c8 *name, const f32 *matrix);
+	void uploadDrawModels(const glm::mat4 *models, ui32 numModels);
+	void streamToBuffer(GLuint bufferId, GLenum target, const void *data, size_t size);
+
+	struct PendingTexture {
+		Texture *mTexture;
+		OGLTexture *mGLTexture;
+	};
+
     TransformMatrixBlock mMatrixBlock;
+	UniformBlock mFrameBlock;
+	GLuint mFrameBlockBuffer;
     Platform::AbstractOGLRenderContext *mRenderCtx;
-	CPPCore::TArray<OGLBuffer*> mBuffers;
+	Common::THandleTable<OGLBuffer*> mBuffers;
+	CPPCore::THashMap<guid, Handle> mBufferLookupMap;
+	CPPCore::THashMap<ui32, Handle> mInstanceBufferLookupMap;
+	CPPCore::TArray<OGLGeometryArena *> mGeometryArenas;
+	CPPCore::THashMap<guid, OGLGeometryRange> mGeometryLookupMap;
 	GLuint mActiveVB;
 	GLuint mActiveIB;
-	CPPCore::TArray<OGLVertexArray*> mVertexArrays;
+	Common::THandleTable<OGLVertexArray*> mVertexArrays;
 	GLuint mActiveVertexArray;
-	CPPCore::TArray<OGLShader *> mShaders;
-	CPPCore::TArray<OGLTexture *> mTextures;
+	Common::THandleTable<OGLShader*> mShaders;
+	Common::TNameHashMap<Handle> mShaderLookupMap;
+	Common::THandleTable<OGLTexture*> mTextures;
     CPPCore::TArray<OGLTexture *> mBindedTextures;
-	CPPCore::TArray<size_t> mFreeTexSlots;
-	std::map<String, size_t> m_texLookupMap;
+	Common::TNameHashMap<Handle> mTextureLookupMap;
 	CPPCore::TArray<OGLParameter *> mParameters;
+	Common::TNameHashMap<OGLParameter *> mParameterLookupMap;
 	OGLShader *mShaderInUse;
-	CPPCore::TArray<size_t> mFreeBufferSlots;
 	CPPCore::TArray<OGLPrimGroup*> mPrimitives;
 	RenderStates *mFpState;
 	Profiling::FPSCounter *mFpsCounter;
@@ -175,7 +257,76 @@ private:
     String mExtensions;
     i32 mOpenGLVersion[2];
     Viewport mViewport;
+	ui32 mNumStateChanges;
+	ui32 mNumAvoidedStateChanges;
+	OGLStreamBuffer *mStreamBuffer;
+	ui32 mNumUploadedBytes;
+	CPPCore::TArray<PendingTexture> mPendingTextures;
+	size_t mTextureUploadBudget;
+	size_t mTextureUploadBytes;
+	String mDriverId;
+	OGLProgramCache *mProgramCache;
+	OGLParameter *mModelParam;
+	OGLParameter *mViewParam;
+	OGLParameter *mProjectionParam;
+	OGLMultiDrawBatch mMultiDraw;
+	GLuint mDrawBlockBuffer;
+	GLuint mIndirectBuffer;
+	ui32 mNumDrawCalls;
 };
 
+inline void OGLRenderBackend::countStateChange(bool issued) {
+	if (issued) {
+		++mNumStateChanges;
+	} else {
+		++mNumAvoidedStateChanges;
+	}
+}
+
+inline ui32 OGLRenderBackend::getNumStateChanges() const {
+	return mNumStateChanges;
+}
+
+inline ui32 OGLRenderBackend::getNumAvoidedStateChanges() const {
+	return mNumAvoidedStateChanges;
+}
+
+inline void OGLRenderBackend::resetStateChangeCounters() {
+	mNumStateChanges = 0;
+	mNumAvoidedStateChanges = 0;
+}
+
+inline ui32 OGLRenderBackend::getNumUploadedBytes() const {
+	return mNumUploadedBytes;
+}
+
+inline void OGLRenderBackend::resetUploadCounter() {
+	mNumUploadedBytes = 0;
+}
+
+inline ui32 OGLRenderBackend::getNumDrawCalls() const {
+	return mNumDrawCalls;
+}
+
+inline void OGLRenderBackend::resetDrawCallCounter() {
+	mNumDrawCalls = 0;
+}
+
+inline void OGLRenderBackend::setTextureUploadBudget(size_t budget) {
+	mTextureUploadBudget = budget;
+}
+
+inline size_t OGLRenderBackend::getTextureUploadBudget() const {
+	return mTextureUploadBudget;
+}
+
+inline size_t OGLRenderBackend::getNumGeometryArenas() const {
+	return mGeometryArenas.size();
+}
+
+inline size_t OGLRenderBackend::getNumPendingTextures() const {
+	return mPendingTextures.size();
+}
+
 } // Namespace RenderBackend
 } // Namespace OSRE
@@ -115,6 +115,7 @@ SetMaterialStageCmdData *setupMaterial(Material *material, OGLRenderBackend *rb,
                 // for setting up all buffer objects
                 eh->setActiveShader(shader);
             }
+            matData->m_transparent = material->m_color[static_cast<ui32>(MaterialColorType::Mat_Diffuse)].m_a < 1.0f;
             renderMatCmd->m_data = matData;
             eh->enqueueRenderCmd(renderMatCmd);
         } break;
@@ -138,6 +139,9 @@ void setupParameter(UniformVar *param, OGLRenderBackend *rb, OGLRenderEventHandl
     OGLParameter *oglParam = rb->getParameter(param->m_name);
     if (nullptr == oglParam) {
         oglParam = rb->createParameter(param->m_name, param->m_type, &param->m_data, param->m_numItems);
+        if (nullptr == oglParam) {
+            return;
+        }
     } else {
         ::memcpy(oglParam->m_data->getData(), param->m_data.getData(), param->m_data.m_size);
     }
@@ -146,7 +150,8 @@ void setupParameter(UniformVar *param, OGLRenderBackend *rb, OGLRenderEventHandl
     ev->setParameter(paramArray);
 }
 
-OGLVertexArray *setupBuffers(Mesh *mesh, OGLRenderBackend *rb, OGLShader *oglShader) {
+OGLVertexArray *setupBuffers(Mesh *mesh, OGLRenderBackend *rb, OGLShader *oglShader, bool instanced,
+        OGLGeometryRange &range) {
     osre_assert(nullptr != mesh);
     osre_assert(nullptr != rb);
     osre_assert(nullptr != oglShader);
@@ -157,8 +162,6 @@ OGLVertexArray *setupBuffers(Mesh *mesh, OGLRenderBackend *rb, OGLShader *oglSha
 
     rb->useShader(oglShader);
 
-    OGLVertexArray *vertexArray = rb->createVertexArray();
-    rb->bindVertexArray(vertexArray);
     BufferData *vertices = mesh->getVertexBuffer();
     if (nullptr == vertices) {
         osre_debug(Tag, "No vertex buffer data for setting up data.");
@@ -171,9 +174,22 @@ OGLVertexArray *setupBuffers(Mesh *mesh, OGLRenderBackend *rb, OGLShader *oglSha
         return nullptr;
     }
 
+    // Static meshes share the buffers and the vertex array of their vertex type. The instance
+    // streams are bound per batch, so instanced meshes get a vertex array of their own.
+    const bool isStatic = BufferAccessType::ReadOnly == vertices->m_access && BufferAccessType::ReadOnly == indices->m_access;
+    if (isStatic && rb->allocGeometry(mesh, range)) {
+        if (instanced) {
+            return rb->createGeometryVertexArray(range.m_arena, oglShader);
+        }
+        return rb->getGeometryVertexArray(range.m_arena, oglShader);
+    }
+
+    OGLVertexArray *vertexArray = rb->createVertexArray();
+    rb->bindVertexArray(vertexArray);
+
     // create vertex buffer and  and pass triangle vertex to buffer object
     OGLBuffer *vb = rb->createBuffer(vertices->m_type);
-    vb->m_geoId = mesh->getId();
+    rb->setBufferGeoId(vb, mesh->getId());
     rb->bindBuffer(vb);
     rb->copyDataToBuffer(vb, vertices->getData(), vertices->getSize(), vertices->m_access);
 
@@ -186,7 +202,7 @@ OGLVertexArray *setupBuffers(Mesh *mesh, OGLRenderBackend *rb, OGLShader *oglSha
 
     // create index buffer and pass indices to element array buffer
     OGLBuffer *ib = rb->createBuffer(indices->m_type);
-    ib->m_geoId = mesh->getId();
+    rb->setBufferGeoId(ib, mesh->getId());
     rb->bindBuffer(ib);
     rb->copyDataToBuffer(ib, indices->getData(), indices->getSize(), indices->m_access);
 
@@ -195,9 +211,27 @@ OGLVertexArray *setupBuffers(Mesh *mesh, OGLRenderBackend *rb, OGLShader *oglSha
     return vertexArray;
 }
 
+bool setupInstanceBuffer(const char *id, size_t numInstances, OGLRenderBackend *rb, OGLShader *oglShader,
+        OGLVertexArray *va) {
+    osre_assert(nullptr != rb);
+
+    if (nullptr == id || nullptr == oglShader || nullptr == va) {
+        return false;
+    }
+
+    // All meshes of a batch share the instance streams of the batch
+    OGLBuffer *instanceBuffer = rb->createInstanceBuffer(id, numInstances);
+    if (nullptr == instanceBuffer) {
+        osre_debug(Tag, "Cannot create instance buffer.");
+        return false;
+    }
+
+    return rb->bindInstanceLayout(va, oglShader, instanceBuffer);
+}
+
 void setupPrimDrawCmd(const char *id, bool useLocalMatrix, const glm::mat4 &model,
         const TArray<size_t> &primGroups, OGLRenderBackend *rb,
-        OGLRenderEventHandler *eh, OGLVertexArray *va) {
+        OGLRenderEventHandler *eh, OGLVertexArray *va, guid meshId) {
     osre_assert(nullptr != rb);
     osre_assert(nullptr != eh);
 
@@ -212,6 +246,7 @@ void setupPrimDrawCmd(const char *id, bool useLocalMatrix, const glm::mat4 &mode
         data->m_localMatrix = useLocalMatrix;
     }
     data->m_id = id;
+    data->m_meshId = meshId;
     data->m_vertexArray = va;
     data->m_primitives.reserve(primGroups.size());
     for (ui32 i = 0; i < primGroups.size(); ++i) {
@@ -223,7 +258,7 @@ void setupPrimDrawCmd(const char *id, bool useLocalMatrix, const glm::mat4 &mode
 }
 
 void setupInstancedDrawCmd(const char *id, const TArray<size_t> &ids, OGLRenderBackend *rb,
-        OGLRenderEventHandler *eh, OGLVertexArray *va, size_t numInstances) {
+        OGLRenderEventHandler *eh, OGLVertexArray *va, size_t numInstances, guid meshId) {
     osre_assert(nullptr != rb);
     osre_assert(nullptr != eh);
 
@@ -235,6 +270,7 @@ void setupInstancedDrawCmd(const char *id, const TArray<size_t> &ids, OGLRenderB
 
     DrawInstancePrimitivesCmdData *data = new DrawInstancePrimitivesCmdData;
     data->m_id = id;
+    data->m_meshId = meshId;
     data->m_vertexArray = va;
     data->m_numInstances = numInstances;
     data->m_primitives.reserve(ids.size());
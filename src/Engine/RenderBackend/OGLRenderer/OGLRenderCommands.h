@@ -50,16 +50,20 @@ struct SetRenderTargetCmdData;
 struct OGLParameter;
 struct UniformVar;
 struct SetMaterialStageCmdData;
+struct OGLGeometryRange;
 
 bool setupTextures(Material* mat, OGLRenderBackend* rb, CPPCore::TArray<OGLTexture*>& textures);
 SetMaterialStageCmdData* setupMaterial(Material* material, OGLRenderBackend* rb, OGLRenderEventHandler* eh);
 void setupParameter(UniformVar* param, OGLRenderBackend* rb, OGLRenderEventHandler* ev);
-OGLVertexArray* setupBuffers(Mesh* mesh, OGLRenderBackend* rb, OGLShader* oglShader);
+OGLVertexArray* setupBuffers(Mesh* mesh, OGLRenderBackend* rb, OGLShader* oglShader, bool instanced,
+    OGLGeometryRange& range);
+bool setupInstanceBuffer(const char* id, size_t numInstances, OGLRenderBackend* rb, OGLShader* oglShader,
+    OGLVertexArray* va);
 void setupPrimDrawCmd(const char* id, bool useLocalMatrix, const glm::mat4& model,
     const CPPCore::TArray<size_t>& primGroups, OGLRenderBackend* rb,
-    OGLRenderEventHandler* eh, OGLVertexArray* va);
+    OGLRenderEventHandler* eh, OGLVertexArray* va, guid meshId);
 void setupInstancedDrawCmd(const char* id, const CPPCore::TArray<size_t>& ids, OGLRenderBackend* rb,
-    OGLRenderEventHandler* eh, OGLVertexArray* va, size_t numInstances);
+    OGLRenderEventHandler* eh, OGLVertexArray* va, size_t numInstances, guid meshId);
 
 } // Namespace RenderBackend
 } // Namespace OSRE
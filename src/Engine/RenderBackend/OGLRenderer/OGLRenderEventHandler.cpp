@@ -173,6 +173,7 @@ bool OGLRenderEventHandler::onCreateRenderer(const EventData *eventData) {
     }
 
     m_oglBackend->create(m_renderCtx);
+    m_oglBackend->createProgramCache(App::AssetRegistry::getPath("cache"));
     if (!m_renderCtx->isActive()) {
         osre_debug(Tag, "Error while activating render-context.");
         return false;
@@ -189,14 +190,14 @@ bool OGLRenderEventHandler::onCreateRenderer(const EventData *eventData) {
     fontUri.setPath(path);
     m_renderCmdBuffer = new RenderCmdBuffer(m_oglBackend, m_renderCtx);
 
-    bool ok = Profiling::PerformanceCounterRegistry::create();
-    if (!ok) {
-        osre_error(Tag, "Error while destroying performance counters.");
-        return false;
-    }
-
     mPipeline = createRendererEvData->m_pipeline;
     Profiling::PerformanceCounterRegistry::registerCounter("fps");
+    Profiling::PerformanceCounterRegistry::registerCounter("stateChanges");
+    Profiling::PerformanceCounterRegistry::registerCounter("stateChangesAvoided");
+    Profiling::PerformanceCounterRegistry::registerCounter("drawCalls");
+    Profiling::PerformanceCounterRegistry::registerCounter("uploadBytes");
+    Profiling::PerformanceCounterRegistry::registerCounter("texturesPending");
+    Profiling::PerformanceCounterRegistry::registerCounter("shaderCacheHitRate");
 
     return true;
 }
@@ -208,10 +209,7 @@ bool OGLRenderEventHandler::onDestroyRenderer(const Common::EventData *) {
         return false;
     }
 
-    if (!Profiling::PerformanceCounterRegistry::destroy()) {
-        osre_error(Tag, "Error while destroying performance counters.");
-    }
-
+    m_oglBackend->destroy();
     m_renderCtx->destroy();
     delete m_renderCtx;
     m_renderCtx = nullptr;
@@ -249,15 +247,32 @@ bool OGLRenderEventHandler::onClearGeo(const EventData *) {
     return true;
 }
 
-bool OGLRenderEventHandler::onRenderFrame(const EventData*) {
+bool OGLRenderEventHandler::onRenderFrame(const EventData *eventData) {
     osre_assert(nullptr != m_oglBackend);
     osre_assert(nullptr != m_renderCmdBuffer);
     osre_assert(m_renderCtx != nullptr);
 
+    // Streamed textures replace their placeholders before the frame is drawn
+    m_oglBackend->processTextureUploads();
     m_renderCmdBuffer->onPreRenderFrame(mPipeline);
     m_renderCmdBuffer->onRenderFrame();
     m_renderCmdBuffer->onPostRenderFrame();
 
+    Profiling::PerformanceCounterRegistry::setCounter("stateChanges", m_oglBackend->getNumStateChanges());
+    Profiling::PerformanceCounterRegistry::setCounter("stateChangesAvoided", m_oglBackend->getNumAvoidedStateChanges());
+    m_oglBackend->resetStateChangeCounters();
+    Profiling::PerformanceCounterRegistry::setCounter("drawCalls", m_oglBackend->getNumDrawCalls());
+    m_oglBackend->resetDrawCallCounter();
+    Profiling::PerformanceCounterRegistry::setCounter("uploadBytes", m_oglBackend->getNumUploadedBytes());
+    m_oglBackend->resetUploadCounter();
+    Profiling::PerformanceCounterRegistry::setCounter("texturesPending", static_cast<ui32>(m_oglBackend->getNumPendingTextures()));
+    Profiling::PerformanceCounterRegistry::setCounter("shaderCacheHitRate", m_oglBackend->getProgramCacheHitRate());
+
+    const RenderFrameEventData *data = static_cast<const RenderFrameEventData *>(eventData);
+    if (nullptr != data) {
+        data->setRendered();
+    }
+
     return true;
 }
 
@@ -269,30 +284,34 @@ bool OGLRenderEventHandler::addMeshes(const c8 *id, CPPCore::TArray<size_t> &pri
             continue;
         }
 
-        // register primitive groups to render
-        for (size_t i = 0; i < currentMesh->getNumberOfPrimitiveGroups(); ++i) {
-            const size_t primIdx(m_oglBackend->addPrimitiveGroup(currentMesh->getPrimitiveGroupAt(i)));
-            primGroups.add(primIdx);
-        }
-
         // create the default material
         SetMaterialStageCmdData *data = setupMaterial(currentMesh->getMaterial(), m_oglBackend, this);
 
         // setup vertex array, vertex and index buffers
-        m_vertexArray = setupBuffers(currentMesh, m_oglBackend, m_renderCmdBuffer->getActiveShader());
+        OGLGeometryRange range;
+        m_vertexArray = setupBuffers(currentMesh, m_oglBackend, m_renderCmdBuffer->getActiveShader(),
+                0 != currentMeshEntry->numInstances, range);
         if (nullptr == m_vertexArray) {
             osre_debug(Tag, "Vertex-Array-pointer is a nullptr.");
             return false;
         }
         data->m_vertexArray = m_vertexArray;
 
+        // register primitive groups to render
+        for (size_t i = 0; i < currentMesh->getNumberOfPrimitiveGroups(); ++i) {
+            const size_t primIdx(m_oglBackend->addPrimitiveGroup(currentMesh->getPrimitiveGroupAt(i), &range));
+            primGroups.add(primIdx);
+        }
+
         // setup the draw calls
         if (0 == currentMeshEntry->numInstances) {
             setupPrimDrawCmd(id, currentMesh->isLocal(), currentMesh->getLocalMatrix(),
-                    primGroups, m_oglBackend, this, m_vertexArray);
+                    primGroups, m_oglBackend, this, m_vertexArray, currentMesh->getId());
         } else {
+            setupInstanceBuffer(id, currentMeshEntry->numInstances, m_oglBackend,
+                    m_renderCmdBuffer->getActiveShader(), m_vertexArray);
             setupInstancedDrawCmd(id, primGroups, m_oglBackend, this, m_vertexArray,
-                    currentMeshEntry->numInstances);
+                    currentMeshEntry->numInstances, currentMesh->getId());
         }
 
         primGroups.resize(0);
@@ -356,30 +375,34 @@ bool OGLRenderEventHandler::onInitRenderPasses(const Common::EventData *eventDat
                     }
 
 
-                    // register primitive groups to render
-                    for (size_t i = 0; i < currentMesh->getNumberOfPrimitiveGroups(); ++i) {
-                        const size_t primIdx(m_oglBackend->addPrimitiveGroup(currentMesh->getPrimitiveGroupAt(i)));
-                        primGroups.add(primIdx);
-                    }
-
                     // create the default material
                     SetMaterialStageCmdData *data = setupMaterial(currentMesh->getMaterial(), m_oglBackend, this);
 
                     // setup vertex array, vertex and index buffers
-                    m_vertexArray = setupBuffers(currentMesh, m_oglBackend, m_renderCmdBuffer->getActiveShader());
+                    OGLGeometryRange range;
+                    m_vertexArray = setupBuffers(currentMesh, m_oglBackend, m_renderCmdBuffer->getActiveShader(),
+                            0 != currentMeshEntry->numInstances, range);
                     if (nullptr == m_vertexArray) {
                         osre_debug(Tag, "Vertex-Array-pointer is a nullptr.");
                         return false;
                     }
                     data->m_vertexArray = m_vertexArray;
 
+                    // register primitive groups to render
+                    for (size_t i = 0; i < currentMesh->getNumberOfPrimitiveGroups(); ++i) {
+                        const size_t primIdx(m_oglBackend->addPrimitiveGroup(currentMesh->getPrimitiveGroupAt(i), &range));
+                        primGroups.add(primIdx);
+                    }
+
                     // setup the draw calls
                     if (0 == currentMeshEntry->numInstances) {
                         setupPrimDrawCmd(currentBatchData->m_id, currentMesh->isLocal(), currentMesh->getLocalMatrix(),
-                                primGroups, m_oglBackend, this, m_vertexArray);
+                                primGroups, m_oglBackend, this, m_vertexArray, currentMesh->getId());
                     } else {
+                        setupInstanceBuffer(currentBatchData->m_id, currentMeshEntry->numInstances, m_oglBackend,
+                                m_renderCmdBuffer->getActiveShader(), m_vertexArray);
                         setupInstancedDrawCmd(currentBatchData->m_id, primGroups, m_oglBackend, this, m_vertexArray,
-                                currentMeshEntry->numInstances);
+                                currentMeshEntry->numInstances, currentMesh->getId());
                     }
 
                     primGroups.resize(0);
@@ -398,17 +421,6 @@ bool OGLRenderEventHandler::onInitRenderPasses(const Common::EventData *eventDat
 }
 
 
-static void setName(c8 *name, size_t bufferSize, FrameSubmitCmd *cmd) {
-    ::memset(name, '\0', bufferSize);
-    size_t bufferLen = cmd->m_data[0];
-    if (bufferLen > bufferSize-1) {
-        bufferLen = bufferSize - 1;
-    }
-    ::strncpy(name, &cmd->m_data[1], bufferLen);
-}
-
-static const size_t BufferSize = 256;
-
 bool OGLRenderEventHandler::onCommitNexFrame(const EventData *eventData) {
     CommitFrameEventData *data = (CommitFrameEventData *)eventData;
     if (nullptr == data) {
@@ -427,32 +439,44 @@ bool OGLRenderEventHandler::onCommitNexFrame(const EventData *eventData) {
             MatrixBuffer *buffer = (MatrixBuffer *)cmd->m_data;
             m_renderCmdBuffer->setMatrixBuffer(cmd->m_batchId, buffer);
         } else if (cmd->m_updateFlags & (ui32)FrameSubmitCmd::UpdateUniforms) {
-            c8 name[BufferSize];
-            setName(name, BufferSize, cmd);
-            const ui32 offset = cmd->m_data[0] + 1;
-            const size_t size = cmd->m_size - offset;
-            OGLParameter *oglParam = m_oglBackend->getParameter(name);
-            ::memcpy(oglParam->m_data->getData(), &cmd->m_data[offset], size);
+            // All uniforms of a batch are stored in one command
+            String name;
+            const c8 *varData = nullptr;
+            ui16 varDataLen = 0;
+            size_t offset = 0;
+            while (offset < cmd->m_size) {
+                const size_t read = UniformBuffer::decodeVar(&cmd->m_data[offset], cmd->m_size - offset, name, varData, varDataLen);
+                if (0 == read) {
+                    osre_debug(Tag, "Truncated uniform data.");
+                    break;
+                }
+                offset += read;
+
+                OGLParameter *oglParam = m_oglBackend->getParameter(name);
+                if (nullptr == oglParam) {
+                    osre_debug(Tag, "Cannot find parameter " + name + ".");
+                    continue;
+                }
+                const size_t size = varDataLen < oglParam->m_data->m_size ? varDataLen : oglParam->m_data->m_size;
+                ::memcpy(oglParam->m_data->getData(), varData, size);
+            }
+            m_renderCmdBuffer->invalidateParameters();
         } else if (cmd->m_updateFlags & (ui32)FrameSubmitCmd::UpdateBuffer) {
-            OGLBuffer *buffer = m_oglBackend->getBufferById(cmd->m_meshId);
-            m_oglBackend->bindBuffer(buffer);
-            m_oglBackend->copyDataToBuffer(buffer, cmd->m_data, cmd->m_size, BufferAccessType::ReadWrite);
-            m_oglBackend->unbindBuffer(buffer);
+            m_oglBackend->updateMeshBuffer(cmd->m_meshId, cmd->m_offset, cmd->m_data, cmd->m_size);
         } else if (cmd->m_updateFlags & (ui32)FrameSubmitCmd::AddRenderData) {
-            for (ui32 i = 0; i < cmd->m_updatedPasses.size(); ++i) {
-                PassData *pd = cmd->m_updatedPasses[i];
-                for (RenderBatchData *rbd : pd->m_geoBatches) {
-                    for (MeshEntry *entry : rbd->m_meshArray) {
-                        CPPCore::TArray<size_t> primGroups;
-                        addMeshes(cmd->m_batchId, primGroups, entry);
-                    }
-                }
+            for (MeshEntry *entry : cmd->m_newMeshes) {
+                CPPCore::TArray<size_t> primGroups;
+                addMeshes(cmd->m_batchId, primGroups, entry);
             }
+        } else if (cmd->m_updateFlags & (ui32)FrameSubmitCmd::UpdateInstances) {
+            // Streams set before any instanced mesh was added will be bound when the mesh arrives
+            OGLBuffer *buffer = m_oglBackend->createInstanceBuffer(cmd->m_batchId, 0);
+            m_oglBackend->updateBuffer(buffer, cmd->m_offset, cmd->m_data, cmd->m_size);
+        } else if (cmd->m_updateFlags & (ui32)FrameSubmitCmd::UpdateVisibility) {
+            m_renderCmdBuffer->setMeshVisible(cmd->m_meshId, cmd->m_visible);
         }
         cmd->m_updateFlags = 0u;
     }
-    data->m_frame->m_submitCmds.resize(0);
-    data->m_frame->m_submitCmdAllocator.release();
 
     return true;
 }
@@ -21,6 +21,7 @@ IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
 CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
 -----------------------------------------------------------------------------------------------*/
 #include "OGLShader.h"
+#include "OGLCommon.h"
 #include "OGLEnum.h"
 #include <osre/Common/Logger.h>
 #include <osre/Debugging/osre_debugging.h>
@@ -39,9 +40,16 @@ OGLShader::OGLShader(const String &name) :
         m_numShader(0),
         m_attributeMap(),
         m_uniformLocationMap(),
+        m_attributeLocations(),
+        m_uniformLocations(),
+        m_blockMembers(),
         m_isCompiledAndLinked(false),
         m_isInUse(false) {
     ::memset(m_shaders, 0, sizeof(unsigned int) * 3);
+    for (ui32 i = 0; i < MaxUniformBlockTypes; ++i) {
+        m_uniformBlocks[i] = nullptr;
+        m_blockBuffers[i] = 0;
+    }
 }
 
 OGLShader::~OGLShader() {
@@ -51,6 +59,15 @@ OGLShader::~OGLShader() {
 
     CPPCore::ContainerClear(m_attribParams);
     CPPCore::ContainerClear(m_uniformParams);
+    for (ui32 i = 0; i < MaxUniformBlockTypes; ++i) {
+        delete m_uniformBlocks[i];
+        m_uniformBlocks[i] = nullptr;
+        if (0 != m_blockBuffers[i]) {
+            glDeleteBuffers(1, &m_blockBuffers[i]);
+            m_blockBuffers[i] = 0;
+        }
+    }
+
     for (ui32 i = 0; i < 3; ++i) {
         if (0 != m_shaders[i]) {
             glDeleteShader(m_shaders[i]);
@@ -73,6 +90,20 @@ bool OGLShader::loadFromSource(ShaderType type, const String &src) {
 
     const char *tmp = src.c_str();
     glShaderSource(shader, 1, &tmp, nullptr);
+    glCompileShader(shader);
+
+    GLint status(0);
+    glGetShaderiv(shader, GL_COMPILE_STATUS, &status);
+    if (GL_FALSE == status) {
+        GLint infoLogLength(0);
+        glGetShaderiv(shader, GL_INFO_LOG_LENGTH, &infoLogLength);
+        if (infoLogLength > 0) {
+            std::vector<GLchar> infoLog(infoLogLength, '\0');
+            glGetShaderInfoLog(shader, infoLogLength, nullptr, &infoLog[0]);
+            osre_debug(Tag, "Compile log: " + String(&infoLog[0]) + "\n");
+        }
+        return false;
+    }
 
     return true;
 }
@@ -96,7 +127,7 @@ bool OGLShader::loadFromStream(ShaderType type, IO::Stream &stream) {
     return retCode;
 }
 
-bool OGLShader::createAndLink() {
+bool OGLShader::createAndLink(bool retrievable) {
     if (isCompiled()) {
         osre_info(Tag, "Trying to compile shader program, which was compiled before.");
         return true;
@@ -117,6 +148,10 @@ bool OGLShader::createAndLink() {
         glAttachShader(m_shaderprog, m_shaders[static_cast<i32>(ShaderType::SH_GeometryShaderType)]);
     }
 
+    if (retrievable) {
+        glProgramParameteri(m_shaderprog, GL_PROGRAM_BINARY_RETRIEVABLE_HINT, GL_TRUE);
+    }
+
     bool result(true);
     GLint status(0);
     glLinkProgram(m_shaderprog);
@@ -125,17 +160,73 @@ bool OGLShader::createAndLink() {
         logCompileOrLinkError(m_shaderprog);
         result = false;
     } else {
-        getActiveAttributeList();
-        getActiveUniformList();
+        result = reflect();
     }
     m_isCompiledAndLinked = result;
 
     return result;
 }
 
+bool OGLShader::createFromBinary(GLenum format, const std::vector<uc8> &binary) {
+    if (isCompiled() || binary.empty()) {
+        return false;
+    }
+
+    m_shaderprog = glCreateProgram();
+    if (0 == m_shaderprog) {
+        osre_error(Tag, "Error while creating shader program.");
+        return false;
+    }
+
+    GLint status(0);
+    glProgramBinary(m_shaderprog, format, &binary[0], static_cast<GLsizei>(binary.size()));
+    glGetProgramiv(m_shaderprog, GL_LINK_STATUS, &status);
+    if (GL_FALSE == status) {
+        // Not an error, the driver rejects binaries of other driver versions
+        glDeleteProgram(m_shaderprog);
+        m_shaderprog = 0;
+        return false;
+    }
+
+    if (!reflect()) {
+        glDeleteProgram(m_shaderprog);
+        m_shaderprog = 0;
+        return false;
+    }
+    m_isCompiledAndLinked = true;
+
+    return true;
+}
+
+bool OGLShader::getBinary(GLenum &format, std::vector<uc8> &binary) const {
+    if (!isCompiled()) {
+        return false;
+    }
+
+    GLint size(0);
+    glGetProgramiv(m_shaderprog, GL_PROGRAM_BINARY_LENGTH, &size);
+    if (size < 1) {
+        return false;
+    }
+
+    binary.resize(static_cast<size_t>(size));
+    GLsizei length(0);
+    glGetProgramBinary(m_shaderprog, size, &length, &format, &binary[0]);
+    binary.resize(static_cast<size_t>(length));
+
+    return !binary.empty();
+}
+
 void OGLShader::use() {
     m_isInUse = true;
     glUseProgram(m_shaderprog);
+
+    // The binding points are shared by all programs
+    for (ui32 i = 0; i < MaxUniformBlockTypes; ++i) {
+        if (0 != m_blockBuffers[i]) {
+            glBindBufferBase(GL_UNIFORM_BUFFER, i, m_blockBuffers[i]);
+        }
+    }
 }
 
 void OGLShader::unuse() {
@@ -153,9 +244,7 @@ bool OGLShader::hasAttribute(const String &attribute) {
 }
 
 void OGLShader::addAttribute(const String &attribute) {
-    const GLint location = glGetAttribLocation(m_shaderprog, attribute.c_str());
-    m_attributeMap[attribute] = location;
-    if (InvalidLocationId == location) {
+    if (InvalidLocationId == getAttributeLocation(attribute)) {
         osre_debug(Tag, "Cannot find attribute " + attribute + " in shader.");
     }
 }
@@ -169,9 +258,7 @@ bool OGLShader::hasUniform(const String &uniform) {
 }
 
 void OGLShader::addUniform(const String &uniform) {
-    const GLint location = glGetUniformLocation(m_shaderprog, uniform.c_str());
-    m_uniformLocationMap[uniform] = location;
-    if (InvalidLocationId == location) {
+    if (InvalidLocationId == getUniformLocation(uniform) && -1 == getMaterialBlockMember(findParameterId(uniform))) {
         osre_debug(Tag, "Cannot find uniform variable " + uniform + " in shader.");
     }
 }
@@ -206,12 +293,16 @@ void OGLShader::getActiveAttributeList() {
                 strncpy(attribParam->m_name, stream.str().c_str(), stream.str().size());
                 attribParam->m_location = glGetAttribLocation(m_shaderprog, attribParam->m_name);
                 m_attribParams.add(attribParam);
+                m_attributeMap[attribParam->m_name] = attribParam->m_location;
+                setTableValue(m_attributeLocations, getParameterId(attribParam->m_name), attribParam->m_location);
             }
         } else {
             ActiveParameter *attribParam = new ActiveParameter;
             strncpy(attribParam->m_name, name, strlen(name));
             attribParam->m_location = glGetAttribLocation(m_shaderprog, attribParam->m_name);
             m_attribParams.add(attribParam);
+            m_attributeMap[attribParam->m_name] = attribParam->m_location;
+            setTableValue(m_attributeLocations, getParameterId(attribParam->m_name), attribParam->m_location);
         }
     }
 }
@@ -228,13 +319,178 @@ void OGLShader::getActiveUniformList() {
         c8 name[MaxLen];
         ::memset(name, '\0', sizeof(c8) * MaxLen);
         glGetActiveUniform(m_shaderprog, i, MaxLen, &actual_length, &size, &type, name);
-        ActiveParameter *attribParam = new ActiveParameter;
-        strncpy(attribParam->m_name, name, strlen(name));
-        attribParam->m_location = glGetUniformLocation(m_shaderprog, name);
-        m_attribParams.add(attribParam);
+        const GLint location = glGetUniformLocation(m_shaderprog, name);
+        if (InvalidLocationId == location) {
+            // Members of uniform blocks have no location
+            continue;
+        }
+
+        // Arrays are reported with the index of the first item, the location is the one of the array
+        c8 *bracket = ::strchr(name, '[');
+        if (nullptr != bracket) {
+            *bracket = '\0';
+        }
+
+        ActiveParameter *uniformParam = new ActiveParameter;
+        strncpy(uniformParam->m_name, name, strlen(name));
+        uniformParam->m_location = location;
+        m_uniformParams.add(uniformParam);
+        m_uniformLocationMap[uniformParam->m_name] = location;
+        setTableValue(m_uniformLocations, getParameterId(uniformParam->m_name), location);
     }
 }
 
+static ParameterType getParameterType(GLenum type, bool isArray) {
+    switch (type) {
+        case GL_INT:
+            return isArray ? ParameterType::PT_IntArray : ParameterType::PT_Int;
+        case GL_FLOAT:
+            return isArray ? ParameterType::PT_FloatArray : ParameterType::PT_Float;
+        case GL_FLOAT_VEC2:
+            return isArray ? ParameterType::PT_Float2Array : ParameterType::PT_Float2;
+        case GL_FLOAT_VEC3:
+            return isArray ? ParameterType::PT_Float3Array : ParameterType::PT_Float3;
+        case GL_FLOAT_VEC4:
+            return isArray ? ParameterType::PT_Float4Array : ParameterType::PT_Float4;
+        case GL_FLOAT_MAT3:
+            return isArray ? ParameterType::PT_Mat3Array : ParameterType::PT_Mat3;
+        case GL_FLOAT_MAT4:
+            return isArray ? ParameterType::PT_Mat4Array : ParameterType::PT_Mat4;
+        default:
+            break;
+    }
+
+    return ParameterType::PT_None;
+}
+
+bool OGLShader::getActiveUniformBlockList() {
+    const i32 numBlocks(getActiveParam(m_shaderprog, GL_ACTIVE_UNIFORM_BLOCKS));
+    if (numBlocks < 1) {
+        return true;
+    }
+
+    for (i32 i = 0; i < numBlocks; ++i) {
+        c8 name[MaxLen];
+        ::memset(name, '\0', sizeof(c8) * MaxLen);
+        glGetActiveUniformBlockName(m_shaderprog, i, MaxLen, nullptr, name);
+        const UniformBlockType type = UniformBlock::getTypeFromName(name);
+        if (UniformBlockType::InvalidBlockType == type) {
+            osre_debug(Tag, "Uniform block " + String(name) + " is not supported.");
+            continue;
+        }
+
+        GLint dataSize(0), numMembers(0);
+        glGetActiveUniformBlockiv(m_shaderprog, i, GL_UNIFORM_BLOCK_DATA_SIZE, &dataSize);
+        glGetActiveUniformBlockiv(m_shaderprog, i, GL_UNIFORM_BLOCK_ACTIVE_UNIFORMS, &numMembers);
+        if (numMembers < 1) {
+            continue;
+        }
+
+        CPPCore::TArray<GLint> indices;
+        indices.resize(numMembers);
+        glGetActiveUniformBlockiv(m_shaderprog, i, GL_UNIFORM_BLOCK_ACTIVE_UNIFORM_INDICES, &indices[0]);
+        CPPCore::TArray<GLint> offsets, strides, sizes, types;
+        offsets.resize(numMembers);
+        strides.resize(numMembers);
+        sizes.resize(numMembers);
+        types.resize(numMembers);
+        const GLuint *memberIndices = reinterpret_cast<const GLuint *>(&indices[0]);
+        glGetActiveUniformsiv(m_shaderprog, numMembers, memberIndices, GL_UNIFORM_OFFSET, &offsets[0]);
+        glGetActiveUniformsiv(m_shaderprog, numMembers, memberIndices, GL_UNIFORM_ARRAY_STRIDE, &strides[0]);
+        glGetActiveUniformsiv(m_shaderprog, numMembers, memberIndices, GL_UNIFORM_SIZE, &sizes[0]);
+        glGetActiveUniformsiv(m_shaderprog, numMembers, memberIndices, GL_UNIFORM_TYPE, &types[0]);
+
+        UniformBlock *block = new UniformBlock(name);
+        for (i32 j = 0; j < numMembers; ++j) {
+            c8 memberName[MaxLen];
+            ::memset(memberName, '\0', sizeof(c8) * MaxLen);
+            glGetActiveUniformName(m_shaderprog, memberIndices[j], MaxLen, nullptr, memberName);
+
+            // Arrays are reported with the index of the first item
+            c8 *bracket = ::strchr(memberName, '[');
+            if (nullptr != bracket) {
+                *bracket = '\0';
+            }
+
+            // A member, which cannot be written, would leave the block with undefined values
+            const ParameterType paramType = getParameterType(types[j], sizes[j] > 1);
+            if (ParameterType::PT_None == paramType) {
+                osre_error(Tag, "Type of block member " + String(memberName) + " in " + String(name) + " is not supported.");
+                delete block;
+                return false;
+            }
+            block->addMember(memberName, paramType, sizes[j], offsets[j], strides[j]);
+        }
+
+        const ui32 binding = static_cast<ui32>(type);
+        glUniformBlockBinding(m_shaderprog, i, binding);
+        m_uniformBlocks[binding] = block;
+
+        // The frame and draw blocks are shared by all programs and owned by the backend
+        if (UniformBlockType::FrameBlock != type && UniformBlockType::DrawBlock != type) {
+            glGenBuffers(1, &m_blockBuffers[binding]);
+            glBindBuffer(GL_UNIFORM_BUFFER, m_blockBuffers[binding]);
+            glBufferData(GL_UNIFORM_BUFFER, dataSize, nullptr, GL_DYNAMIC_DRAW);
+            glBindBuffer(GL_UNIFORM_BUFFER, 0);
+        }
+    }
+
+    return true;
+}
+
+bool OGLShader::reflect() {
+    getActiveAttributeList();
+    getActiveUniformList();
+    if (!getActiveUniformBlockList()) {
+        return false;
+    }
+
+    // Material parameters stored in the block are written by member index
+    const UniformBlock *materialBlock = getUniformBlock(UniformBlockType::MaterialBlock);
+    if (nullptr == materialBlock) {
+        return true;
+    }
+
+    for (size_t i = 0; i < materialBlock->getNumMembers(); ++i) {
+        const UniformBlock::Member *member = materialBlock->getMemberAt(i);
+        setTableValue(m_blockMembers, getParameterId(member->m_name), static_cast<GLint>(i));
+    }
+
+    return true;
+}
+
+void OGLShader::setTableValue(std::vector<GLint> &table, ui32 id, GLint value) {
+    if (InvalidParameterId == id) {
+        return;
+    }
+
+    if (id >= table.size()) {
+        table.resize(id + 1, -1);
+    }
+    table[id] = value;
+}
+
+ui32 OGLShader::commitUniformBlocks() {
+    ui32 numUploads(0);
+    for (ui32 i = 0; i < MaxUniformBlockTypes; ++i) {
+        UniformBlock *block = m_uniformBlocks[i];
+        if (0 == m_blockBuffers[i] || nullptr == block || !block->isDirty()) {
+            continue;
+        }
+
+        glBindBuffer(GL_UNIFORM_BUFFER, m_blockBuffers[i]);
+        glBufferSubData(GL_UNIFORM_BUFFER, 0, block->getSize(), block->getData());
+        block->clearDirty();
+        ++numUploads;
+    }
+
+    if (0 != numUploads) {
+        glBindBuffer(GL_UNIFORM_BUFFER, 0);
+    }
+
+    return numUploads;
+}
+
 void OGLShader::logCompileOrLinkError(ui32 shaderprog) {
     GLint infoLogLength(0);
     glGetProgramiv(shaderprog, GL_INFO_LOG_LENGTH, &infoLogLength);
@@ -250,22 +506,26 @@ bool OGLShader::isCompiled() const {
     return m_isCompiledAndLinked;
 }
 
-GLint OGLShader::getAttributeLocation(const String &attribute) {
-    const GLint loc = m_attributeMap[attribute];
-    return loc;
+GLint OGLShader::getAttributeLocation(const String &attribute) const {
+    std::map<String, GLint>::const_iterator it = m_attributeMap.find(attribute);
+    if (m_attributeMap.end() == it) {
+        return InvalidLocationId;
+    }
+
+    return it->second;
 }
 
-GLint OGLShader::getUniformLocation(const String &uniform) {
+GLint OGLShader::getUniformLocation(const String &uniform) const {
     if (uniform.empty()) {
         return InvalidLocationId;
     }
 
-    std::map<String, GLint>::iterator it = m_uniformLocationMap.find(uniform);
+    std::map<String, GLint>::const_iterator it = m_uniformLocationMap.find(uniform);
     if (m_uniformLocationMap.end() == it) {
         return InvalidLocationId;
     }
-    const GLint loc = m_uniformLocationMap[uniform];
-    return loc;
+
+    return it->second;
 }
 
 } // Namespace RenderBackend
@@ -26,9 +26,11 @@ CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
 #include <osre/Common/osre_common.h>
 #include <osre/Common/Object.h>
 #include <osre/RenderBackend/RenderCommon.h>
+#include <osre/RenderBackend/UniformBlock.h>
 #include <GL/glew.h>
 
 #include <map>
+#include <vector>
 
 namespace OSRE {
 
@@ -85,8 +87,21 @@ public:
     bool loadFromStream( ShaderType type, IO::Stream &stream );
 
     /// @brief  Will create and link a shader program.
+    /// @param  retrievable [in] true, if the program binary shall be retrievable after linking.
     /// @return true, if create & link was successful, false in case of an error.
-    bool createAndLink();
+    bool createAndLink(bool retrievable = false);
+
+    /// @brief  Will create the shader program from a binary of an earlier link.
+    /// @param  format  [in] The driver specific binary format.
+    /// @param  binary  [in] The binary.
+    /// @return true, if the driver accepted the binary, false if it must be compiled from source.
+    bool createFromBinary(GLenum format, const std::vector<uc8> &binary);
+
+    /// @brief  Will return the binary of the linked program.
+    /// @param  format  [out] The driver specific binary format.
+    /// @param  binary  [out] The binary.
+    /// @return true, if the binary was retrieved.
+    bool getBinary(GLenum &format, std::vector<uc8> &binary) const;
     
     /// @brief  Will bind this program to the current render context.
     void use();
@@ -100,7 +115,7 @@ public:
 	///	@return	true, if the attribute is used in the shader program, false if not.
     bool hasAttribute( const String& attribute );
 
-    /// @brief  Adds a new attribute to the shader.
+    /// @brief  Adds a new attribute to the shader, active attributes are known since linking.
     /// @param  attribute   [in] The name of the attribute.
     void addAttribute( const String& attribute );
 
@@ -110,7 +125,7 @@ public:
 	///	@return	true, if the uniform is used in the shader program, false if not.
 	bool hasUniform( const String& uniform );
 
-    /// @brief  Adds a new uniform to the shader.
+    /// @brief  Adds a new uniform to the shader, active uniforms are known since linking.
     /// @param  uniform     [in] The name of the uniform.
     void addUniform( const String& uniform );
     
@@ -120,6 +135,19 @@ public:
     /// @brief  Will create a list with all active uniforms.
     void getActiveUniformList();
 
+    /// @brief  Will reflect the layout of all known uniform blocks and assign their binding points.
+    /// @return false, if a block has a member of an unsupported type.
+    bool getActiveUniformBlockList();
+
+    /// @brief  Will return the reflected layout of a uniform block.
+    /// @param  type    [in] The block type.
+    /// @return The block or nullptr, if the program does not use it.
+    UniformBlock *getUniformBlock(UniformBlockType type) const;
+
+    /// @brief  Will upload all dirty blocks owned by the program, the frame block is owned by the backend.
+    /// @return The number of uploaded blocks.
+    ui32 commitUniformBlocks();
+
     /// @brief  Logs a compile and link error.
     /// @param  shaderprog  [in] The shader program handle.
     static void logCompileOrLinkError( ui32 shaderprog );
@@ -128,13 +156,36 @@ public:
 	///	@return	true, if the shader is compiled with success, false if not.
 	bool isCompiled() const;
 
-    GLint getAttributeLocation(const String &attribute);
-    GLint getUniformLocation(const String &uniform);
+    ///	@brief	Will return the OpenGL program id.
+    ///	@return	The program id, 0 if not linked.
+    ui32 getProgramId() const;
+
+    GLint getAttributeLocation(const String &attribute) const;
+    GLint getUniformLocation(const String &uniform) const;
+
+    /// @brief  Will return the location of an attribute without any lookup by name.
+    /// @param  id      [in] The parameter id of the attribute name.
+    /// @return The location, InvalidLocationId if the program does not use it.
+    GLint getAttributeLocation(ui32 id) const;
+
+    /// @brief  Will return the location of a uniform without any lookup by name.
+    /// @param  id      [in] The parameter id of the uniform name.
+    /// @return The location, InvalidLocationId if the uniform is not used or a block member.
+    GLint getUniformLocation(ui32 id) const;
+
+    /// @brief  Will return the member index in the material block for a parameter.
+    /// @param  id      [in] The parameter id of the member name.
+    /// @return The member index, -1 if the parameter is not stored in the material block.
+    i32 getMaterialBlockMember(ui32 id) const;
 
     // No copying
     OGLShader( const OGLShader & ) = delete;
     OGLShader &operator = ( const OGLShader & ) = delete;
 
+private:
+    bool reflect();
+    static void setTableValue(std::vector<GLint> &table, ui32 id, GLint value);
+
 private:
     ParameterArray m_attribParams;
     ParameterArray m_uniformParams;
@@ -144,9 +195,50 @@ private:
     ui32 m_shaders[ MaxShaderTypes ];
     std::map<String, GLint> m_attributeMap;
     std::map<String, GLint> m_uniformLocationMap;
+    std::vector<GLint> m_attributeLocations;
+    std::vector<GLint> m_uniformLocations;
+    std::vector<GLint> m_blockMembers;
+    UniformBlock *m_uniformBlocks[MaxUniformBlockTypes];
+    GLuint m_blockBuffers[MaxUniformBlockTypes];
     bool m_isCompiledAndLinked;
 	bool m_isInUse;
 };
 
+inline ui32 OGLShader::getProgramId() const {
+    return m_shaderprog;
+}
+
+inline GLint OGLShader::getAttributeLocation(ui32 id) const {
+    if (id >= m_attributeLocations.size()) {
+        return InvalidLocationId;
+    }
+
+    return m_attributeLocations[id];
+}
+
+inline GLint OGLShader::getUniformLocation(ui32 id) const {
+    if (id >= m_uniformLocations.size()) {
+        return InvalidLocationId;
+    }
+
+    return m_uniformLocations[id];
+}
+
+inline i32 OGLShader::getMaterialBlockMember(ui32 id) const {
+    if (id >= m_blockMembers.size()) {
+        return -1;
+    }
+
+    return m_blockMembers[id];
+}
+
+inline UniformBlock *OGLShader::getUniformBlock(UniformBlockType type) const {
+    if (type >= UniformBlockType::NumBlockTypes) {
+        return nullptr;
+    }
+
+    return m_uniformBlocks[static_cast<ui32>(type)];
+}
+
 } // Namespace RenderBackend
 } // Namespace OSRE
@@ -0,0 +1,193 @@
+/*-----------------------------------------------------------------------------------------------
+The MIT License (MIT)
+
+Copyright (c) 2015-2022 OSRE ( Open Source Render Engine ) by Kim Kulling
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of
+this software and associated documentation files (the "Software"), to deal in
+the Software without restriction, including without limitation the rights to
+use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+the Software, and to permit persons to whom the Software is furnished to do so,
+subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+-----------------------------------------------------------------------------------------------*/
+#include "OGLStreamBuffer.h"
+
+#include <osre/Common/Logger.h>
+
+namespace OSRE {
+namespace RenderBackend {
+
+static const c8 *Tag = "OGLStreamBuffer";
+
+static constexpr size_t Alignment = 16;
+static constexpr GLuint64 WaitTimeout = 1000000000; // 1 second in nanoseconds
+
+static size_t alignUp(size_t value) {
+    return (value + Alignment - 1) & ~(Alignment - 1);
+}
+
+OGLStreamBuffer::OGLStreamBuffer(size_t size) :
+        mSize(size),
+        mBufferId(0),
+        mMapped(nullptr),
+        mPersistent(false),
+        mHead(0),
+        mRegionBegin(0),
+        mRegions(),
+        mFirstRegion(0),
+        mNumRegions(0),
+        mNumStalls(0) {
+    // empty
+}
+
+OGLStreamBuffer::~OGLStreamBuffer() {
+    if (0 != mBufferId) {
+        osre_warn(Tag, "Stream buffer was not destroyed.");
+    }
+}
+
+bool OGLStreamBuffer::create(bool persistent) {
+    if (!persistent || 0 == mSize) {
+        return !persistent;
+    }
+
+    const GLbitfield flags = GL_MAP_WRITE_BIT | GL_MAP_PERSISTENT_BIT | GL_MAP_COHERENT_BIT;
+    glGenBuffers(1, &mBufferId);
+    glBindBuffer(GL_COPY_READ_BUFFER, mBufferId);
+    glBufferStorage(GL_COPY_READ_BUFFER, mSize, nullptr, flags);
+    mMapped = static_cast<c8 *>(glMapBufferRange(GL_COPY_READ_BUFFER, 0, mSize, flags));
+    glBindBuffer(GL_COPY_READ_BUFFER, 0);
+    if (nullptr == mMapped) {
+        osre_warn(Tag, "Cannot map stream buffer, using glBufferSubData.");
+        glDeleteBuffers(1, &mBufferId);
+        mBufferId = 0;
+        return false;
+    }
+    mPersistent = true;
+
+    return true;
+}
+
+void OGLStreamBuffer::destroy() {
+    popRegions(mNumRegions);
+    if (0 == mBufferId) {
+        return;
+    }
+
+    glBindBuffer(GL_COPY_READ_BUFFER, mBufferId);
+    glUnmapBuffer(GL_COPY_READ_BUFFER);
+    glBindBuffer(GL_COPY_READ_BUFFER, 0);
+    glDeleteBuffers(1, &mBufferId);
+    mBufferId = 0;
+    mMapped = nullptr;
+    mPersistent = false;
+    mHead = 0;
+    mRegionBegin = 0;
+}
+
+bool OGLStreamBuffer::upload(GLuint target, size_t offset, const void *data, size_t size) {
+    if (0 == target || nullptr == data || 0 == size) {
+        osre_debug(Tag, "Invalid upload.");
+        return false;
+    }
+
+    // Data which does not fit into the ring is written directly
+    if (!mPersistent || size > mSize) {
+        glBindBuffer(GL_COPY_WRITE_BUFFER, target);
+        glBufferSubData(GL_COPY_WRITE_BUFFER, offset, size, data);
+        glBindBuffer(GL_COPY_WRITE_BUFFER, 0);
+        return true;
+    }
+
+    size_t begin = alignUp(mHead);
+    if (begin + size > mSize) {
+        // Wrap around, the data written so far gets its own fence
+        closeRegion();
+        begin = 0;
+        mHead = 0;
+        mRegionBegin = 0;
+    }
+    waitForRange(begin, begin + size);
+
+    // The mapping is coherent, no flush is needed before the copy
+    ::memcpy(&mMapped[begin], data, size);
+    glBindBuffer(GL_COPY_READ_BUFFER, mBufferId);
+    glBindBuffer(GL_COPY_WRITE_BUFFER, target);
+    glCopyBufferSubData(GL_COPY_READ_BUFFER, GL_COPY_WRITE_BUFFER, begin, offset, size);
+    glBindBuffer(GL_COPY_WRITE_BUFFER, 0);
+    glBindBuffer(GL_COPY_READ_BUFFER, 0);
+    mHead = begin + size;
+
+    return true;
+}
+
+void OGLStreamBuffer::fence() {
+    if (mPersistent) {
+        closeRegion();
+    }
+}
+
+void OGLStreamBuffer::closeRegion() {
+    if (mHead <= mRegionBegin) {
+        return;
+    }
+
+    if (MaxRegions == mNumRegions) {
+        waitForRange(mRegions[mFirstRegion].m_begin, mRegions[mFirstRegion].m_end);
+    }
+
+    Region &region = mRegions[(mFirstRegion + mNumRegions) % MaxRegions];
+    region.m_begin = mRegionBegin;
+    region.m_end = mHead;
+    region.m_fence = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+    ++mNumRegions;
+    mRegionBegin = mHead;
+}
+
+void OGLStreamBuffer::waitForRange(size_t begin, size_t end) {
+    // Fences signal in order, waiting for the newest overlapping one covers all older ones
+    ui32 count = 0;
+    for (ui32 i = 0; i < mNumRegions; ++i) {
+        const Region &region = mRegions[(mFirstRegion + i) % MaxRegions];
+        if (region.m_begin < end && begin < region.m_end) {
+            count = i + 1;
+        }
+    }
+    if (0 == count) {
+        return;
+    }
+
+    const Region &region = mRegions[(mFirstRegion + count - 1) % MaxRegions];
+    GLenum result = glClientWaitSync(region.m_fence, 0, 0);
+    if (GL_TIMEOUT_EXPIRED == result) {
+        ++mNumStalls;
+        do {
+            result = glClientWaitSync(region.m_fence, GL_SYNC_FLUSH_COMMANDS_BIT, WaitTimeout);
+        } while (GL_TIMEOUT_EXPIRED == result);
+    }
+    if (GL_WAIT_FAILED == result) {
+        osre_error(Tag, "Waiting for stream buffer region failed.");
+    }
+    popRegions(count);
+}
+
+void OGLStreamBuffer::popRegions(ui32 count) {
+    for (ui32 i = 0; i < count && 0 != mNumRegions; ++i) {
+        glDeleteSync(mRegions[mFirstRegion].m_fence);
+        mFirstRegion = (mFirstRegion + 1) % MaxRegions;
+        --mNumRegions;
+    }
+}
+
+} // Namespace RenderBackend
+} // Namespace OSRE
@@ -0,0 +1,120 @@
+/*-----------------------------------------------------------------------------------------------
+The MIT License (MIT)
+
+Copyright (c) 2015-2022 OSRE ( Open Source Render Engine ) by Kim Kulling
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of
+this software and associated documentation files (the "Software"), to deal in
+the Software without restriction, including without limitation the rights to
+use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+the Software, and to permit persons to whom the Software is furnished to do so,
+subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+-----------------------------------------------------------------------------------------------*/
+#pragma once
+
+#include "OGLCommon.h"
+
+namespace OSRE {
+namespace RenderBackend {
+
+//-------------------------------------------------------------------------------------------------
+///	@ingroup	Engine
+///
+///	@brief  A ring buffer to stream dynamic data into existing buffer objects.
+///
+/// The ring is mapped persistently once (ARB_buffer_storage). Each upload is copied into the ring
+/// and from there into the target range with glCopyBufferSubData, so the target buffer keeps its
+/// storage and all vertex arrays using it stay valid. Used regions get a fence at the end of a
+/// frame, the ring only waits when it wraps into a region the GPU has not consumed yet.
+/// Without persistent mapping the data is written with glBufferSubData.
+//-------------------------------------------------------------------------------------------------
+class OGLStreamBuffer {
+public:
+    /// @brief  The class constructor.
+    /// @param  size    [in] The ring size in bytes.
+    explicit OGLStreamBuffer(size_t size);
+
+    /// @brief  The class destructor.
+    ~OGLStreamBuffer();
+
+    /// @brief  Will create the ring, needs an active render context.
+    /// @param  persistent  [in] true to use persistent mapping, false for the fallback.
+    /// @return true, if the requested mode is available.
+    bool create(bool persistent);
+
+    /// @brief  Will wait for all pending regions and release the ring.
+    void destroy();
+
+    /// @brief  Will upload data into a range of a buffer.
+    /// @param  target  [in] The OpenGL id of the target buffer.
+    /// @param  offset  [in] The offset in the target buffer.
+    /// @param  data    [in] The data to upload.
+    /// @param  size    [in] The size in bytes.
+    /// @return false, if the arguments are invalid.
+    bool upload(GLuint target, size_t offset, const void *data, size_t size);
+
+    /// @brief  Will fence the region used since the last call, call it once per frame.
+    void fence();
+
+    /// @brief  Will return true, if the ring is mapped persistently.
+    /// @return The mapping state.
+    bool isPersistent() const;
+
+    /// @brief  Will return the ring size.
+    /// @return The size in bytes.
+    size_t getSize() const;
+
+    /// @brief  Will return the number of waits for the GPU.
+    /// @return The number of stalls.
+    ui32 getNumStalls() const;
+
+private:
+    struct Region {
+        size_t m_begin;
+        size_t m_end;
+        GLsync m_fence;
+    };
+
+    void closeRegion();
+    void waitForRange(size_t begin, size_t end);
+    void popRegions(ui32 count);
+
+private:
+    static constexpr ui32 MaxRegions = 16;
+
+    size_t mSize;
+    GLuint mBufferId;
+    c8 *mMapped;
+    bool mPersistent;
+    size_t mHead;
+    size_t mRegionBegin;
+    Region mRegions[MaxRegions];
+    ui32 mFirstRegion;
+    ui32 mNumRegions;
+    ui32 mNumStalls;
+};
+
+inline bool OGLStreamBuffer::isPersistent() const {
+    return mPersistent;
+}
+
+inline size_t OGLStreamBuffer::getSize() const {
+    return mSize;
+}
+
+inline ui32 OGLStreamBuffer::getNumStalls() const {
+    return mNumStalls;
+}
+
+} // Namespace RenderBackend
+} // Namespace OSRE
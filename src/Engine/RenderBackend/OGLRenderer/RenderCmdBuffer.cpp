@@ -24,6 +24,7 @@ CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
 #include "Engine/RenderBackend/OGLRenderer/RenderCmdBuffer.h"
 #include "OGLCommon.h"
 #include "OGLRenderBackend.h"
+#include "OGLShader.h"
 #include <osre/Debugging/osre_debugging.h>
 #include <osre/Platform/AbstractOGLRenderContext.h>
 
@@ -35,14 +36,97 @@ using namespace ::OSRE::Platform;
 
 static const c8 *Tag = "RenderCmdBuffer";
 
+// The layout of the 64-bit sort key, from the highest to the lowest bits:
+// opaque:      segment (4) | 0 | shader (12) | material (16) | vertex array (16) | depth (14) | kind (1)
+// transparent: segment (4) | 1 | inverted depth (14) | shader (12) | material (16) | vertex array (16) | kind (1)
+// The segment is increased by every render target change, the kind bit keeps render target
+// commands in front of the commands of their segment. A queue with more render target changes
+// than segments keeps its submission order.
+static constexpr ui32 MaxSegment = 0xf;
+static constexpr ui64 MaxDepth = 0x3fff;
+static constexpr f32 DepthRange = 1000.0f;
+
+struct SortGroup {
+    ui64 m_segment;
+    bool m_isTarget;
+    bool m_transparent;
+    ui64 m_shader;
+    ui64 m_material;
+    ui64 m_vertexArray;
+    ui64 m_depth;
+    bool m_hasDepth;
+
+    SortGroup() :
+            SortGroup(0, false) {
+        // empty
+    }
+
+    SortGroup(ui64 segment, bool isTarget) :
+            m_segment(segment),
+            m_isTarget(isTarget),
+            m_transparent(false),
+            m_shader(0),
+            m_material(0),
+            m_vertexArray(0),
+            m_depth(0),
+            m_hasDepth(false) {
+        // empty
+    }
+
+    ui64 encode() const {
+        ui64 key = m_segment << 60;
+        if (m_isTarget) {
+            return key;
+        }
+        if (m_transparent) {
+            key |= 1ull << 59;
+            key |= (MaxDepth - m_depth) << 45;
+            key |= m_shader << 33;
+            key |= m_material << 17;
+            key |= m_vertexArray << 1;
+        } else {
+            key |= m_shader << 47;
+            key |= m_material << 31;
+            key |= m_vertexArray << 15;
+            key |= m_depth << 1;
+        }
+
+        return key | 1ull;
+    }
+};
+
+static ui64 quantizeDepth(const MatrixBuffer &buffer) {
+    const glm::vec4 pos = buffer.m_view * buffer.m_model * glm::vec4(0.0f, 0.0f, 0.0f, 1.0f);
+    f32 depth = -pos.z / DepthRange;
+    if (depth < 0.0f) {
+        depth = 0.0f;
+    } else if (depth > 1.0f) {
+        depth = 1.0f;
+    }
+
+    return static_cast<ui64>(depth * static_cast<f32>(MaxDepth));
+}
+
 RenderCmdBuffer::RenderCmdBuffer(OGLRenderBackend *renderBackend, AbstractOGLRenderContext *ctx) :
         mRBService(renderBackend),
         mRenderCtx(ctx),
+        mCommandQueue(),
+        mSortedQueue(),
+        mSortItems(),
+        mSortTmp(),
+        mGroupStarts(),
+        mIsSorted(false),
         mActiveShader(nullptr),
         mPrimitives(),
         mMaterials(),
         mParamArray(),
-        mMatrixBuffer(),
+        mMatrixBuffers(),
+        mMatrixBufferLookupMap(),
+        mHiddenMeshes(),
+        mMatrixesDirty(true),
+        mParamsDirty(true),
+        mCommittedShader(nullptr),
+        mActiveMaterial(nullptr),
         mPipeline(nullptr) {
     osre_assert(nullptr != mRBService);
     osre_assert(nullptr != mRenderCtx);
@@ -76,6 +160,7 @@ void RenderCmdBuffer::enqueueRenderCmd(OGLRenderCmd *renderCmd) {
     }
 
     mCommandQueue.add(renderCmd);
+    mIsSorted = false;
 }
 
 void RenderCmdBuffer::enqueueRenderCmdGroup(const String &groupName, CPPCore::TArray<OGLRenderCmd *> &cmdGroup) {
@@ -90,6 +175,7 @@ void RenderCmdBuffer::enqueueRenderCmdGroup(const String &groupName, CPPCore::TA
     }
 
     mCommandQueue.add(&cmdGroup[0], cmdGroup.size());
+    mIsSorted = false;
 }
 
 void RenderCmdBuffer::onPreRenderFrame(Pipeline *pipeline) {
@@ -97,6 +183,8 @@ void RenderCmdBuffer::onPreRenderFrame(Pipeline *pipeline) {
         return;
     }
     mPipeline = pipeline;
+    mCommittedShader = nullptr;
+    sortCommands();
     mRenderCtx->activate();
     mRBService->clearRenderTarget(mClearState);
 }
@@ -125,12 +213,23 @@ void RenderCmdBuffer::onRenderFrame() {
         states.m_samplerState = pass->getSamplerState();
         states.m_stencilState = pass->getStencilState();
         mRBService->setFixedPipelineStates(states);
+        mActiveMaterial = nullptr;
 
-        for (OGLRenderCmd *renderCmd : mCommandQueue) {
+        for (OGLRenderCmd *renderCmd : mSortedQueue) {
             if (nullptr == renderCmd) {
                 continue;
             }
 
+            // A material equal to the active one keeps the pending multi-draw open, all other
+            // commands change the state and need the pending draws to be submitted first
+            if (renderCmd->m_type == OGLRenderCmdType::SetMaterialCmd && isActiveMaterial((SetMaterialStageCmdData *)renderCmd->m_data)) {
+                mRBService->countStateChange(false);
+                continue;
+            }
+            if (renderCmd->m_type != OGLRenderCmdType::DrawPrimitivesCmd) {
+                mRBService->flushMultiDraw();
+            }
+
             if (renderCmd->m_type == OGLRenderCmdType::DrawPrimitivesCmd) {
                 onDrawPrimitivesCmd((DrawPrimitivesCmdData *)renderCmd->m_data);
             } else if (renderCmd->m_type == OGLRenderCmdType::DrawPrimitivesInstancesCmd) {
@@ -143,6 +242,7 @@ void RenderCmdBuffer::onRenderFrame() {
                 osre_error(Tag, "Unsupported render command type: " + static_cast<ui32>(renderCmd->m_type));
             }
         }
+        mRBService->flushMultiDraw();
 
         mPipeline->endPass(passId);
     }
@@ -162,7 +262,97 @@ void RenderCmdBuffer::onPostRenderFrame() {
 
 void RenderCmdBuffer::clear() {
     ContainerClear(mCommandQueue);
+    mSortedQueue.resize(0);
+    mIsSorted = false;
     mParamArray.resize(0);
+    mParamsDirty = true;
+    mCommittedShader = nullptr;
+    mActiveMaterial = nullptr;
+}
+
+void RenderCmdBuffer::sortCommands() {
+    if (mIsSorted) {
+        return;
+    }
+
+    // Split the queue into groups, a group is a material or render target command with the
+    // following draw commands. The groups get sorted, the commands in a group keep their order.
+    mSortItems.resize(0);
+    mGroupStarts.resize(0);
+    CPPCore::TArray<SortGroup> groups;
+    ui64 segment = 0;
+    bool segmentOverflow = false;
+    for (ui32 i = 0; i < mCommandQueue.size(); ++i) {
+        OGLRenderCmd *renderCmd = mCommandQueue[i];
+        if (nullptr == renderCmd) {
+            continue;
+        }
+
+        if (renderCmd->m_type == OGLRenderCmdType::SetRenderTargetCmd) {
+            if (segment < MaxSegment) {
+                ++segment;
+            } else {
+                segmentOverflow = true;
+            }
+            groups.add(SortGroup(segment, true));
+            mGroupStarts.add(i);
+        } else if (renderCmd->m_type == OGLRenderCmdType::SetMaterialCmd) {
+            SortGroup group(segment, false);
+            const SetMaterialStageCmdData *data = static_cast<const SetMaterialStageCmdData *>(renderCmd->m_data);
+            group.m_transparent = data->m_transparent;
+            if (nullptr != data->m_shader) {
+                group.m_shader = data->m_shader->getProgramId() & 0xfff;
+            }
+            if (!data->m_textures.isEmpty() && nullptr != data->m_textures[0]) {
+                group.m_material = data->m_textures[0]->m_textureId & 0xffff;
+            }
+            if (nullptr != data->m_vertexArray) {
+                group.m_vertexArray = data->m_vertexArray->m_id & 0xffff;
+            }
+            groups.add(group);
+            mGroupStarts.add(i);
+        } else {
+            if (groups.isEmpty()) {
+                groups.add(SortGroup(segment, false));
+                mGroupStarts.add(i);
+            }
+
+            // The first draw with matrices defines the depth of its group
+            SortGroup &group = groups[groups.size() - 1];
+            if (!group.m_hasDepth && renderCmd->m_type == OGLRenderCmdType::DrawPrimitivesCmd) {
+                const MatrixBuffer *buffer = getMatrixBuffer(static_cast<DrawPrimitivesCmdData *>(renderCmd->m_data));
+                if (nullptr != buffer) {
+                    group.m_depth = quantizeDepth(*buffer);
+                    group.m_hasDepth = true;
+                }
+            }
+        }
+    }
+    mGroupStarts.add(static_cast<ui32>(mCommandQueue.size()));
+
+    for (ui32 i = 0; i < groups.size(); ++i) {
+        Common::SortItem item;
+        item.m_key = segmentOverflow ? i : groups[i].encode();
+        item.m_index = i;
+        mSortItems.add(item);
+    }
+    mSortTmp.resize(mSortItems.size());
+    if (!mSortItems.isEmpty() && !segmentOverflow) {
+        Common::radixSort(&mSortItems[0], &mSortTmp[0], mSortItems.size());
+    }
+
+    mSortedQueue.resize(0);
+    for (ui32 i = 0; i < mSortItems.size(); ++i) {
+        const Common::SortItem &item = mSortItems[i];
+        for (ui32 j = mGroupStarts[item.m_index]; j < mGroupStarts[item.m_index + 1]; ++j) {
+            OGLRenderCmd *renderCmd = mCommandQueue[j];
+            if (nullptr != renderCmd) {
+                renderCmd->m_sortKey = item.m_key;
+                mSortedQueue.add(renderCmd);
+            }
+        }
+    }
+    mIsSorted = true;
 }
 
 static bool hasParam(const String &name, const ::CPPCore::TArray<OGLParameter *> &paramArray) {
@@ -191,26 +381,95 @@ void RenderCmdBuffer::setParameter(const ::CPPCore::TArray<OGLParameter *> &para
 }
 
 void RenderCmdBuffer::commitParameters() {
+    // Uniforms are stored per program, so a new program needs all of them
+    OGLShader *activeShader = mRBService->getActiveShader();
+    const bool shaderChanged = mCommittedShader != activeShader;
+    if (shaderChanged || mMatrixesDirty) {
+        commitMatrixes();
+    } else {
+        mRBService->countStateChange(false);
+    }
+
+    if (shaderChanged || mParamsDirty) {
+        for (ui32 i = 0; i < mParamArray.size(); i++) {
+            mRBService->setParameter(mParamArray[i]);
+        }
+        mRBService->countStateChange(true);
+    } else {
+        mRBService->countStateChange(false);
+    }
+    mCommittedShader = activeShader;
+    mParamsDirty = false;
+}
+
+void RenderCmdBuffer::commitMatrixes() {
     mRBService->setMatrix(MatrixType::Model, mModel);
     mRBService->setMatrix(MatrixType::View, mView);
     mRBService->setMatrix(MatrixType::Projection, mProj);
     mRBService->applyMatrix();
+    mRBService->countStateChange(true);
+    mMatrixesDirty = false;
+}
 
-    for (ui32 i = 0; i < mParamArray.size(); i++) {
-        mRBService->setParameter(mParamArray[i]);
-    }
+void RenderCmdBuffer::invalidateParameters() {
+    mParamsDirty = true;
 }
 
 void RenderCmdBuffer::setMatrixes(const glm::mat4 &model, const glm::mat4 &view, const glm::mat4 &proj) {
+    if (mModel == model && mView == view && mProj == proj) {
+        return;
+    }
+
     mModel = model;
     mView = view;
     mProj = proj;
+    mMatrixesDirty = true;
 }
 
-void RenderCmdBuffer::setMatrixBuffer(const c8 *id, MatrixBuffer *buffer) {
+void RenderCmdBuffer::setMatrixBuffer(const c8 *id, const MatrixBuffer *buffer) {
     osre_assert(nullptr != id);
+    osre_assert(nullptr != buffer);
+
+    // The buffer lives in the frame arena, so keep a copy
+    Handle handle;
+    if (mMatrixBufferLookupMap.getValue(id, handle)) {
+        MatrixBuffer *current = mMatrixBuffers.get(handle);
+        // Only a new depth changes the sort keys of the draws
+        if (quantizeDepth(*current) != quantizeDepth(*buffer)) {
+            mIsSorted = false;
+        }
+        *current = *buffer;
+    } else {
+        mMatrixBufferLookupMap.insert(id, mMatrixBuffers.add(*buffer));
+        mIsSorted = false;
+    }
+}
+
+const MatrixBuffer *RenderCmdBuffer::getMatrixBuffer(DrawPrimitivesCmdData *data) {
+    if (nullptr == data) {
+        return nullptr;
+    }
+
+    // Resolve the name only once, afterwards the cached handle will be used
+    if (!data->m_matrixBuffer.isValid() && nullptr != data->m_id) {
+        mMatrixBufferLookupMap.getValue(data->m_id, data->m_matrixBuffer);
+    }
+
+    return mMatrixBuffers.get(data->m_matrixBuffer);
+}
+
+void RenderCmdBuffer::setMeshVisible(guid meshId, bool visible) {
+    if (visible) {
+        if (mHiddenMeshes.hasKey(meshId)) {
+            mHiddenMeshes.remove(meshId);
+        }
+    } else if (!mHiddenMeshes.hasKey(meshId)) {
+        mHiddenMeshes.insert(meshId, true);
+    }
+}
 
-    mMatrixBuffer[id] = buffer;
+bool RenderCmdBuffer::isMeshVisible(guid meshId) const {
+    return !mHiddenMeshes.hasKey(meshId);
 }
 
 bool RenderCmdBuffer::onDrawPrimitivesCmd(DrawPrimitivesCmdData *data) {
@@ -218,9 +477,17 @@ bool RenderCmdBuffer::onDrawPrimitivesCmd(DrawPrimitivesCmdData *data) {
         return false;
     }
 
-    std::map<const char *, MatrixBuffer *>::iterator it = mMatrixBuffer.find(data->m_id);
-    if (it != mMatrixBuffer.end()) {
-        MatrixBuffer *buffer = it->second;
+    // Culled meshes keep their commands, they are only skipped
+    if (!isMeshVisible(data->m_meshId)) {
+        return true;
+    }
+
+    const MatrixBuffer *buffer = getMatrixBuffer(data);
+    if (mRBService->canMultiDraw()) {
+        return addMultiDraw(data, buffer);
+    }
+
+    if (nullptr != buffer) {
         setMatrixes(buffer->m_model, buffer->m_view, buffer->m_proj);
     }
 
@@ -228,6 +495,12 @@ bool RenderCmdBuffer::onDrawPrimitivesCmd(DrawPrimitivesCmdData *data) {
     if (data->m_localMatrix) {
         mRBService->setMatrix(MatrixType::Model, data->m_model);
         mRBService->applyMatrix();
+        mRBService->countStateChange(true);
+
+        // The uploaded model matrix differs from the stored one now
+        mMatrixesDirty = true;
+    } else if (mMatrixesDirty) {
+        commitMatrixes();
     }
     for (size_t i = 0; i < data->m_primitives.size(); ++i) {
         mRBService->render(data->m_primitives[i]);
@@ -236,11 +509,62 @@ bool RenderCmdBuffer::onDrawPrimitivesCmd(DrawPrimitivesCmdData *data) {
     return true;
 }
 
+bool RenderCmdBuffer::addMultiDraw(DrawPrimitivesCmdData *data, const MatrixBuffer *buffer) {
+    // The draws of a multi-draw share the view and the projection, the model is stored per draw
+    if (nullptr != buffer && (buffer->m_view != mView || buffer->m_proj != mProj)) {
+        mRBService->flushMultiDraw();
+        setMatrixes(mModel, buffer->m_view, buffer->m_proj);
+    }
+    if (mMatrixesDirty) {
+        mRBService->flushMultiDraw();
+        commitMatrixes();
+    }
+
+    mRBService->bindVertexArray(data->m_vertexArray);
+    glm::mat4 model = mModel;
+    if (data->m_localMatrix) {
+        model = data->m_model;
+    } else if (nullptr != buffer) {
+        model = buffer->m_model;
+    }
+    for (size_t i = 0; i < data->m_primitives.size(); ++i) {
+        mRBService->addMultiDraw(data->m_primitives[i], model);
+    }
+
+    return true;
+}
+
+bool RenderCmdBuffer::isActiveMaterial(const SetMaterialStageCmdData *data) const {
+    // Changed parameters or matrices have to be committed by the material command
+    if (nullptr == mActiveMaterial || nullptr == data || mParamsDirty || mMatrixesDirty) {
+        return false;
+    }
+
+    if (mActiveMaterial->m_shader != data->m_shader || mActiveMaterial->m_vertexArray != data->m_vertexArray) {
+        return false;
+    }
+
+    if (mActiveMaterial->m_textures.size() != data->m_textures.size()) {
+        return false;
+    }
+    for (ui32 i = 0; i < data->m_textures.size(); ++i) {
+        if (mActiveMaterial->m_textures[i] != data->m_textures[i]) {
+            return false;
+        }
+    }
+
+    return true;
+}
+
 bool RenderCmdBuffer::onDrawPrimitivesInstancesCmd(DrawInstancePrimitivesCmdData *data) {
     if (nullptr == data) {
         return false;
     }
 
+    if (!isMeshVisible(data->m_meshId)) {
+        return true;
+    }
+
     mRBService->bindVertexArray(data->m_vertexArray);
     for (size_t i = 0; i < data->m_primitives.size(); i++) {
         mRBService->render(data->m_primitives[i], data->m_numInstances);
@@ -261,6 +585,7 @@ bool RenderCmdBuffer::onSetRenderTargetCmd(SetRenderTargetCmdData *data) {
 }
 
 bool RenderCmdBuffer::onSetMaterialStageCmd(SetMaterialStageCmdData *data) {
+    mActiveMaterial = data;
     mRBService->bindVertexArray(data->m_vertexArray);
     mRBService->useShader(data->m_shader);
 
@@ -23,11 +23,13 @@ CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
 #pragma once
 
 #include <cppcore/Container/TArray.h>
+#include <cppcore/Container/THashMap.h>
 #include <osre/Common/BaseMath.h>
+#include <osre/Common/RadixSort.h>
+#include <osre/Common/THandleTable.h>
+#include <osre/Common/TNameHashMap.h>
 #include <osre/RenderBackend/RenderStates.h>
 
-#include <map>
-
 namespace OSRE {
 
 // Forward declarations
@@ -110,19 +112,32 @@ public:
     /// @param paramArray   The array with the assigned parameters.
     void setParameter(const ::CPPCore::TArray<OGLParameter *> &paramArray);
     
-    /// @brief Commits all assigned parameters to the active shader.
+    /// @brief Commits all assigned parameters to the active shader, unchanged ones will be skipped.
     void commitParameters();
 
+    /// @brief  Marks the parameters as changed, they will be committed with the next material.
+    void invalidateParameters();
+
     /// @brief  Will assign the default matrices.
     /// @param model    The model matrix.
     /// @param view     The view matrix
     /// @param proj     The projection matrix.
     void setMatrixes(const glm::mat4 &model, const glm::mat4 &view, const glm::mat4 &proj);
     
-    ///	@brief  Will assign a matrix buffer.
+    ///	@brief  Will assign a matrix buffer, the matrices will be copied.
     /// @param  id      The matrix buffer id
     /// @param  buffer  The matrix buffer itself.
-    void setMatrixBuffer(const c8 *id, MatrixBuffer *buffer);
+    void setMatrixBuffer(const c8 *id, const MatrixBuffer *buffer);
+
+    /// @brief  Will show or hide the draws of a mesh, hidden meshes stay resident.
+    /// @param  meshId  The mesh id.
+    /// @param  visible true to draw the mesh, false to skip it.
+    void setMeshVisible(guid meshId, bool visible);
+
+    /// @brief  Returns true, if the mesh will be drawn.
+    /// @param  meshId  The mesh id.
+    /// @return true, if the mesh is not hidden.
+    bool isMeshVisible(guid meshId) const;
 
 protected:
     /// The draw primitive callback.
@@ -133,20 +148,41 @@ protected:
     virtual bool onSetRenderTargetCmd(SetRenderTargetCmdData *data);
     /// The set material callback.
     virtual bool onSetMaterialStageCmd(SetMaterialStageCmdData *data);
+    /// Sorts the command queue by the sort keys, when the queue or the matrices have changed.
+    void sortCommands();
+    /// Uploads the matrices to the active shader.
+    void commitMatrixes();
+    /// Returns the matrix buffer for the draw command or nullptr if none.
+    const MatrixBuffer *getMatrixBuffer(DrawPrimitivesCmdData *data);
+    /// Adds the primitives of the draw command to the pending multi-draw.
+    bool addMultiDraw(DrawPrimitivesCmdData *data, const MatrixBuffer *buffer);
+    /// Returns true, if the material command would not change any state.
+    bool isActiveMaterial(const SetMaterialStageCmdData *data) const;
 
 private:
     OGLRenderBackend *mRBService;
     ClearState mClearState;
     Platform::AbstractOGLRenderContext *mRenderCtx;
     ::CPPCore::TArray<OGLRenderCmd *> mCommandQueue;
+    ::CPPCore::TArray<OGLRenderCmd *> mSortedQueue;
+    ::CPPCore::TArray<Common::SortItem> mSortItems;
+    ::CPPCore::TArray<Common::SortItem> mSortTmp;
+    ::CPPCore::TArray<ui32> mGroupStarts;
+    bool mIsSorted;
     OGLShader *mActiveShader;
     ::CPPCore::TArray<PrimitiveGroup *> mPrimitives;
     ::CPPCore::TArray<Material *> mMaterials;
     ::CPPCore::TArray<OGLParameter *> mParamArray;
-    std::map<const char *, MatrixBuffer *> mMatrixBuffer;
+    Common::THandleTable<MatrixBuffer> mMatrixBuffers;
+    Common::TNameHashMap<Handle> mMatrixBufferLookupMap;
+    ::CPPCore::THashMap<guid, bool> mHiddenMeshes;
     glm::mat4 mModel;
     glm::mat4 mView;
     glm::mat4 mProj;
+    bool mMatrixesDirty;
+    bool mParamsDirty;
+    OGLShader *mCommittedShader;
+    SetMaterialStageCmdData *mActiveMaterial;
     Pipeline *mPipeline;
 };
 
@@ -28,7 +28,10 @@ CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
 #include <osre/RenderBackend/DbgRenderer.h>
 #include <osre/Threading/SystemTask.h>
 
+#include "NullRenderer/NullRenderEventHandler.h"
 #include "OGLRenderer/OGLRenderEventHandler.h"
+
+#include <chrono>
 // clang-format off
 #ifdef OSRE_WINDOWS
 #   include <osre/Platform/Windows/MinWindows.h>
@@ -46,8 +49,19 @@ static const c8 *Tag = "RenderBackendService";
 
 static constexpr c8 OGL_API[] = "opengl";
 static constexpr c8 Vulkan_API[] = "vulkan";
+static constexpr c8 Null_API[] = "null";
 static constexpr i32 IdxNotFound = -1;
 
+static i64 getMicroseconds() {
+    return std::chrono::duration_cast<std::chrono::microseconds>(
+            std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+void RenderFrameEventData::setRendered() const {
+    // The counters belong to the submitting thread, it reads the latency after the fence
+    m_latency = getMicroseconds() - m_submitTime;
+}
+
 static i32 hasPass(const c8 *id, const ::CPPCore::TArray<PassData *> &passDataArray) {
     if (nullptr == id) {
         return IdxNotFound;
@@ -80,9 +94,12 @@ RenderBackendService::RenderBackendService() :
         m_settings(nullptr),
         mViewport(),
         m_ownsSettingsConfig(false),
+        m_ownsCounterRegistry(false),
         m_frameCreated(false),
-        m_renderFrame(&m_frames[0]),
-        m_submitFrame(&m_frames[1]),
+        m_submitFrame(&m_frames[0]),
+        m_numFramesInFlight(1),
+        m_frameNumber(0),
+        m_frameFence(),
         m_dirty(false),
         m_passes(),
         m_currentPass(nullptr),
@@ -115,9 +132,23 @@ bool RenderBackendService::onOpen() {
     }
 
     
+    i32 framesInFlight = m_settings->getInt(Settings::FramesInFlight);
+    if (framesInFlight < 1) {
+        framesInFlight = 1;
+    } else if (framesInFlight > static_cast<i32>(MaxFramesInFlight)) {
+        osre_warn(Tag, "Too many frames in flight requested, will be clamped.");
+        framesInFlight = static_cast<i32>(MaxFramesInFlight);
+    }
+    m_numFramesInFlight = static_cast<ui32>(framesInFlight);
+
+    // The counters are used by the render thread and the application, so they must exist before 
+    // the render task runs and outlive it
+    m_ownsCounterRegistry = Profiling::PerformanceCounterRegistry::create();
+    Profiling::PerformanceCounterRegistry::registerCounter("frameLatency");
+
     // Spawn the thread for our render task
     if (!m_renderTaskPtr.isValid()) {
-        m_renderTaskPtr.init(SystemTask::create("render_task"));
+        m_renderTaskPtr.init(SystemTask::create("render_task", QueueMode::SPSC));
     }
 
     // Run the render task
@@ -133,6 +164,8 @@ bool RenderBackendService::onOpen() {
         m_renderTaskPtr->attachEventHandler(new OGLRenderEventHandler);
     } else if (api == Vulkan_API) {
         // todo!
+    } else if (api == Null_API) {
+        m_renderTaskPtr->attachEventHandler(new NullRenderEventHandler);
     } else {
         osre_error(Tag, "Requested render-api unknown: " + api);
         ok = false;
@@ -156,10 +189,17 @@ bool RenderBackendService::onClose() {
         osre_error(Tag, "Cannot destroy Debug renderer");
     }
     if (m_renderTaskPtr->isRunning()) {
+        // The frames in flight still use the handler and the frame slots
+        awaitFramesInFlight();
         m_renderTaskPtr->detachEventHandler();
         m_renderTaskPtr->stop();
     }
 
+    if (m_ownsCounterRegistry) {
+        Profiling::PerformanceCounterRegistry::destroy();
+        m_ownsCounterRegistry = false;
+    }
+
     return true;
 }
 
@@ -168,20 +208,64 @@ bool RenderBackendService::onUpdate() {
         return false;
     }
 
+    acquireNextFrame();
     if (!m_frameCreated) {
         initPasses();
         m_frameCreated = true;
     }
 
+    const ui32 slot = static_cast<ui32>(m_frameNumber % (m_numFramesInFlight + 1));
     commitNextFrame();
 
-    // Synchronizing event with render back-end
-    auto result = m_renderTaskPtr->sendEvent(&OnRenderFrameEvent, nullptr);
-    m_renderTaskPtr->awaitUpdate();
+    RenderFrameEventData *data = &m_renderFrameData[slot];
+    data->m_frameNumber = m_frameNumber;
+    data->m_submitTime = getMicroseconds();
+    data->m_latency = 0;
+    auto result = m_renderTaskPtr->sendEvent(&OnRenderFrameEvent, data, &m_frameFence, m_frameNumber);
+
+    // In lockstep mode synchronize with the render back-end, otherwise the fence will block
+    // in acquireNextFrame when the ring is full.
+    if (1 == m_numFramesInFlight) {
+        m_renderTaskPtr->awaitUpdate();
+    }
 
     return result;
 }
 
+void RenderBackendService::acquireNextFrame() {
+    ++m_frameNumber;
+    if (m_frameNumber > m_numFramesInFlight) {
+        m_frameFence.wait(m_frameNumber - m_numFramesInFlight);
+    }
+
+    const ui32 slot = static_cast<ui32>(m_frameNumber % (m_numFramesInFlight + 1));
+    m_submitFrame = &m_frames[slot];
+
+    // The render thread is done with this slot, so release it in one shot
+    m_submitFrame->reset();
+    publishFrameLatency();
+}
+
+void RenderBackendService::awaitFramesInFlight() {
+    if (0 != m_frameNumber) {
+        m_frameFence.wait(m_frameNumber);
+    }
+}
+
+void RenderBackendService::publishFrameLatency() {
+    // The slot of the last finished frame is not reused before the next acquire
+    const ui64 finished = m_frameFence.getValue();
+    if (0 == finished) {
+        return;
+    }
+
+    const RenderFrameEventData &data = m_renderFrameData[finished % (m_numFramesInFlight + 1)];
+    // A back-end which does not report the latency leaves it at 0
+    if (data.m_frameNumber == finished && 0 != data.m_latency) {
+        Profiling::PerformanceCounterRegistry::setCounter("frameLatency", static_cast<ui32>(data.m_latency));
+    }
+}
+
 void RenderBackendService::setSettings(const Settings *config, bool moveOwnership) {
     if (m_ownsSettingsConfig && m_settings != nullptr) {
         delete m_settings;
@@ -213,7 +297,8 @@ void RenderBackendService::commitNextFrame() {
         return;
     }
 
-    CommitFrameEventData *data = new CommitFrameEventData;
+    const ui32 slot = static_cast<ui32>(m_frameNumber % (m_numFramesInFlight + 1));
+    CommitFrameEventData *data = &m_commitFrameData[slot];
     data->m_frame = m_submitFrame;
     for (ui32 i = 0; i < m_passes.size(); ++i) {
         PassData *currentPass = m_passes[i];
@@ -225,33 +310,28 @@ void RenderBackendService::commitNextFrame() {
                 cmd->m_batchId = currentBatch->m_id;
                 cmd->m_updateFlags |= (ui32) FrameSubmitCmd::UpdateMatrixes;
                 cmd->m_size = sizeof(MatrixBuffer);
-                cmd->m_data = new c8[cmd->m_size];
+                cmd->m_data = m_submitFrame->alloc(cmd->m_size);
                 ::memcpy(cmd->m_data, &currentBatch->m_matrixBuffer, cmd->m_size);
             } 
             
             if (currentBatch->m_dirtyFlag & RenderBatchData::UniformBufferDirty) {
-                UniformBuffer &uniformBuffer = data->m_frame->m_uniforBuffers[i];
+                // All uniforms of the batch travel in one command, the render thread packs them into its uniform blocks
+                size_t size = 0;
                 for (ui32 k = 0; k < currentBatch->m_uniforms.size(); ++k) {
+                    size += UniformBuffer::getEncodedSize(currentBatch->m_uniforms[k]);
+                }
+
+                if (0 != size) {
                     FrameSubmitCmd *cmd = m_submitFrame->enqueue();
                     cmd->m_passId = currentPass->m_id;
                     cmd->m_batchId = currentBatch->m_id;
                     cmd->m_updateFlags |= (ui32)FrameSubmitCmd::UpdateUniforms;
-                    UniformVar *var = currentBatch->m_uniforms[k];
-                    if (nullptr == var) {
-                        continue;
-                    }
-
-                    uniformBuffer.writeVar(var);
-
-                    // todo: replace by uniform buffer.
-                    cmd->m_size = var->getSize();
-                    cmd->m_data = new c8[cmd->m_size];
+                    cmd->m_size = size;
+                    cmd->m_data = m_submitFrame->alloc(cmd->m_size);
                     size_t offset = 0;
-                    cmd->m_data[offset] = var->m_name.size() > 255 ? 255 : static_cast<c8>(var->m_name.size());
-                    ++offset;
-                    ::memcpy(&cmd->m_data[offset], var->m_name.c_str(), var->m_name.size());
-                    offset += var->m_name.size();
-                    ::memcpy(&cmd->m_data[offset], var->m_data.getData(), var->m_data.m_size);
+                    for (ui32 k = 0; k < currentBatch->m_uniforms.size(); ++k) {
+                        offset += UniformBuffer::encodeVar(currentBatch->m_uniforms[k], &cmd->m_data[offset]);
+                    }
                 }
             } 
             
@@ -263,26 +343,49 @@ void RenderBackendService::commitNextFrame() {
                     cmd->m_updateFlags |= (ui32)FrameSubmitCmd::UpdateBuffer;
                     Mesh *currentMesh = currentBatch->m_updateMeshArray[k];
                     cmd->m_meshId = currentMesh->getId();
-                    cmd->m_size = currentMesh->getVertexBuffer()->getSize();
-                    cmd->m_data = new c8[cmd->m_size];
-                    ::memcpy(cmd->m_data, currentMesh->getVertexBuffer()->getData(), cmd->m_size);
+
+                    // Only copy the modified range, if the mesh knows it
+                    BufferData *vb = currentMesh->getVertexBuffer();
+                    cmd->m_offset = 0;
+                    cmd->m_size = vb->getSize();
+                    if (currentMesh->hasDirtyVertexRange() && currentMesh->getDirtyVertexOffset() < vb->getSize()) {
+                        cmd->m_offset = currentMesh->getDirtyVertexOffset();
+                        const size_t maxSize = vb->getSize() - cmd->m_offset;
+                        cmd->m_size = currentMesh->getDirtyVertexSize() < maxSize ? currentMesh->getDirtyVertexSize() : maxSize;
+                    }
+                    currentMesh->clearDirtyVertexRange();
+                    cmd->m_data = m_submitFrame->alloc(cmd->m_size);
+                    ::memcpy(cmd->m_data, &vb->getData()[cmd->m_offset], cmd->m_size);
                 }
+                currentBatch->m_updateMeshArray.resize(0);
             } 
             if (currentBatch->m_dirtyFlag & RenderBatchData::MeshDirty) {
+                // Take a snapshot, the batch may change while the frame is in flight
                 FrameSubmitCmd *cmd = m_submitFrame->enqueue();
-                PassData *pd = new PassData(currentPass->m_id, nullptr);
-                pd->m_geoBatches.add(currentBatch);
-                cmd->m_updatedPasses.add(pd);
+                cmd->m_passId = currentPass->m_id;
+                cmd->m_batchId = currentBatch->m_id;
+                for (MeshEntry *entry : currentBatch->m_meshArray) {
+                    cmd->m_newMeshes.add(entry);
+                }
                 cmd->m_updateFlags |= (ui32)FrameSubmitCmd::AddRenderData;
             }
+            if (currentBatch->m_dirtyFlag & RenderBatchData::InstanceDataDirty && currentBatch->hasDirtyInstances()) {
+                // Submitted after the meshes, so the instance buffer is bound to their vertex arrays
+                FrameSubmitCmd *cmd = m_submitFrame->enqueue();
+                cmd->m_passId = currentPass->m_id;
+                cmd->m_batchId = currentBatch->m_id;
+                cmd->m_updateFlags |= (ui32)FrameSubmitCmd::UpdateInstances;
+                cmd->m_offset = currentBatch->getDirtyInstanceOffset() * sizeof(InstanceVert);
+                cmd->m_size = currentBatch->getDirtyInstanceCount() * sizeof(InstanceVert);
+                cmd->m_data = m_submitFrame->alloc(cmd->m_size);
+                ::memcpy(cmd->m_data, &currentBatch->m_instances[currentBatch->getDirtyInstanceOffset()], cmd->m_size);
+                currentBatch->clearDirtyInstances();
+            }
 
             currentBatch->m_dirtyFlag = 0;
         }
     }
 
-    data->m_frame = m_submitFrame;
-    std::swap(m_submitFrame, m_renderFrame);
-
     m_renderTaskPtr->sendEvent(&OnCommitFrameEvent, data);
 }
 
@@ -518,10 +621,48 @@ void RenderBackendService::updateMesh(Mesh *mesh) {
         osre_error(Tag, "No active batch.");
         return;
     }
+
+    // One update per frame is enough, the latest data will be submitted
+    for (ui32 i = 0; i < m_currentBatch->m_updateMeshArray.size(); ++i) {
+        if (m_currentBatch->m_updateMeshArray[i] == mesh) {
+            return;
+        }
+    }
     m_currentBatch->m_updateMeshArray.add(mesh);
     m_currentBatch->m_dirtyFlag |= RenderBatchData::MeshUpdateDirty;
 }
 
+void RenderBackendService::setMeshVisible(Mesh *mesh, bool visible) {
+    if (nullptr == mesh) {
+        osre_debug(Tag, "Pointer to geometry is nullptr.");
+        return;
+    }
+
+    // Not bound to a batch, the render thread looks the draws up by the mesh id
+    FrameSubmitCmd *cmd = m_submitFrame->enqueue();
+    cmd->m_meshId = mesh->getId();
+    cmd->m_visible = visible;
+    cmd->m_updateFlags |= (ui32)FrameSubmitCmd::UpdateVisibility;
+}
+
+void RenderBackendService::setInstanceTransforms(ui32 first, ui32 count, const glm::mat4 *transforms) {
+    if (nullptr == m_currentBatch) {
+        osre_error(Tag, "No active batch.");
+        return;
+    }
+
+    m_currentBatch->setInstanceTransforms(first, count, transforms);
+}
+
+void RenderBackendService::setInstanceColors(ui32 first, ui32 count, const glm::vec4 *colors) {
+    if (nullptr == m_currentBatch) {
+        osre_error(Tag, "No active batch.");
+        return;
+    }
+
+    m_currentBatch->setInstanceColors(first, count, colors);
+}
+
 bool RenderBackendService::endRenderBatch() {
     if (nullptr == m_currentBatch) {
         return false;
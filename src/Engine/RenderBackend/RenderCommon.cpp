@@ -24,10 +24,16 @@ CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
 #include <osre/Common/Ids.h>
 #include <osre/Common/Logger.h>
 #include <osre/IO/Uri.h>
+#include <osre/RenderBackend/CookedTexture.h>
 #include <osre/RenderBackend/Mesh.h>
 #include <osre/RenderBackend/RenderCommon.h>
 #include <osre/RenderBackend/Shader.h>
 #include <osre/Common/glm_common.h>
+#include <osre/Threading/JobSystem.h>
+#include "src/Engine/IO/MappedFileStream.h"
+
+#include <cstring>
+#include <vector>
 
 #define STB_IMAGE_IMPLEMENTATION
 #include "stb_image.h" 
@@ -63,7 +69,8 @@ static const String
             "instance0", ///< Instance0
             "instance1", ///< Instance1
             "instance2", ///< Instance2
-            "instance3" ///< Instance3
+            "instance3", ///< Instance3
+            "instancecolor" ///< InstanceColor
         };
 
 static const String ErrorCmpName = "Error";
@@ -126,8 +133,33 @@ const String *RenderVert::getAttributes() {
     return RenderVertAttributes;
 }
 
+// List of attributes for instance data
+static const ui32 NumInstanceVertAttributes = 5;
+
+static const String InstanceVertAttributes[NumInstanceVertAttributes] = {
+    "instance0",
+    "instance1",
+    "instance2",
+    "instance3",
+    "instancecolor"
+};
+
+InstanceVert::InstanceVert() :
+        transform(1.0f),
+        color(1, 1, 1, 1) {
+    // empty
+}
+
+size_t InstanceVert::getNumAttributes() {
+    return NumInstanceVertAttributes;
+}
+
+const String *InstanceVert::getAttributes() {
+    return InstanceVertAttributes;
+}
+
 const String &getVertCompName(VertexAttribute attrib) {
-    if (attrib > VertexAttribute::Instance3) {
+    if (attrib > VertexAttribute::InstanceColor) {
         return ErrorCmpName;
     }
     return VertCompName[static_cast<int>(attrib)];
@@ -322,7 +354,10 @@ Texture::Texture() :
         m_width(0),
         m_height(0),
         m_channels(0),
-        m_texHandle() {
+        mNumMipLevels(1),
+        m_texHandle(),
+        mState(ResourceState::Loaded),
+        mUseCount(0) {
     // empty
 }
 
@@ -344,6 +379,19 @@ size_t TextureLoader::load(const IO::Uri &uri, Texture *tex) {
     String root = App::AssetRegistry::getPath("media");
     String path = App::AssetRegistry::resolvePathFromUri(uri);
 
+    // Cooked textures are read from a mapping, the mip chain is already in the upload format.
+    // The stream is opened directly, this runs on the job threads as well.
+    if (uri.getExtension() == CookedTexture::Extension) {
+        IO::MappedFileStream stream(IO::Uri("file://" + path));
+        if (!stream.open() || !CookedTexture::load(stream, *tex)) {
+            osre_debug(Tag, "Cannot load cooked texture " + filename);
+            return 0;
+        }
+        stream.close();
+
+        return tex->m_size;
+    }
+
     i32 width = 0, height = 0, channels = 0;
     
     tex->m_data = stbi_load(path.c_str(), &width, &height, &channels, 0);
@@ -354,25 +402,30 @@ size_t TextureLoader::load(const IO::Uri &uri, Texture *tex) {
     tex->m_width = width;
     tex->m_height = height;
     tex->m_channels = channels;
-
-    // swap the texture data
-    for (i32 j = 0; j * 2 < height; ++j) {
-        i32 index1 = j * width * channels;
-        i32 index2 = (height - 1 - j) * width * channels;
-        for (i32 i = width * channels; i > 0; --i) {
-            uc8 temp = tex->m_data[index1];
-            tex->m_data[index1] = tex->m_data[index2];
-            tex->m_data[index2] = temp;
-            ++index1;
-            ++index2;
-        }
-    }
+    flipVertical(tex->m_data, width, height, channels);
 
     const size_t size = width * height * channels;
 
     return size;
 }
 
+void TextureLoader::flipVertical(uc8 *data, ui32 width, ui32 height, ui32 channels) {
+    if (nullptr == data || height < 2) {
+        return;
+    }
+
+    // Swap whole rows instead of single bytes
+    const size_t rowSize = static_cast<size_t>(width) * channels;
+    std::vector<uc8> row(rowSize);
+    uc8 *top = data;
+    uc8 *bottom = data + (height - 1) * rowSize;
+    for (; top < bottom; top += rowSize, bottom -= rowSize) {
+        ::memcpy(&row[0], top, rowSize);
+        ::memcpy(top, bottom, rowSize);
+        ::memcpy(bottom, &row[0], rowSize);
+    }
+}
+
 static Texture *DefaultTexture = nullptr;
 
 RenderBackend::Texture *TextureLoader::getDefaultTexture() {
@@ -415,6 +468,12 @@ TextureResource::TextureResource(const String &name, const IO::Uri &uri) :
     // empty
 }
 
+TextureResource::~TextureResource() {
+    // The image data was allocated by stb_image, so the texture must not release it
+    TextureLoader loader;
+    unload(loader);
+}
+
 void TextureResource::setTargetType(TextureTargetType targetType) {
     m_targetType = targetType;
 }
@@ -431,6 +490,32 @@ TextureStageType TextureResource::setTextureStage() const {
     return m_stage;
 }
 
+ResourceState TextureResource::loadAsync() {
+    const ResourceState state = getState();
+    if (ResourceState::Loaded == state || ResourceState::Loading == state || ResourceState::Error == state) {
+        return state;
+    }
+
+    // The default texture is not decoded at all
+    Threading::JobSystem *jobSystem = Threading::JobSystem::getInstance();
+    if (nullptr == jobSystem || getName().find("$default") != String::npos) {
+        TextureLoader loader;
+        return load(loader);
+    }
+
+    Texture *tex = create();
+    if (nullptr == tex) {
+        return ResourceState::Error;
+    }
+
+    tex->m_textureName = getName();
+    tex->m_targetType = m_targetType;
+    setState(ResourceState::Loading);
+    jobSystem->run(jobSystem->createJob(onLoadJob, this));
+
+    return getState();
+}
+
 TextureLoader::TextureLoader() {
     // empty
 }
@@ -440,7 +525,7 @@ TextureLoader::~TextureLoader() {
 }
 
 ResourceState TextureResource::onLoad(const IO::Uri &uri, TextureLoader &loader) {
-    if (getState() == ResourceState::Loaded) {
+    if (getState() == ResourceState::Loaded || getState() == ResourceState::Loading) {
         return getState();
     }
 
@@ -456,8 +541,8 @@ ResourceState TextureResource::onLoad(const IO::Uri &uri, TextureLoader &loader)
         return getState();
     }
 
-    getStats().m_memory = loader.load(uri, tex);
     tex->m_targetType = m_targetType;
+    getStats().m_memory = loader.load(uri, tex);
     if (0 == getStats().m_memory) {
         setState(ResourceState::Error);
         osre_debug(Tag, "Cannot load texture " + uri.getAbsPath());
@@ -469,6 +554,33 @@ ResourceState TextureResource::onLoad(const IO::Uri &uri, TextureLoader &loader)
     return getState();
 }
 
+void TextureResource::setState(ResourceState newState) {
+    TResource::setState(newState);
+
+    // The render thread only sees the texture, so it gets the state as well
+    Texture *tex = get();
+    if (nullptr != tex) {
+        tex->mState.store(newState, std::memory_order_release);
+    }
+}
+
+bool TextureResource::isInUse() const {
+    const Texture *tex = const_cast<TextureResource *>(this)->get();
+    return nullptr != tex && 0 != tex->mUseCount.load(std::memory_order_acquire);
+}
+
+void TextureResource::onLoadJob(void *data) {
+    TextureResource *res = static_cast<TextureResource *>(data);
+    TextureLoader loader;
+    res->getStats().m_memory = loader.load(res->getUri(), res->get());
+    if (0 == res->getStats().m_memory) {
+        res->setState(ResourceState::Error);
+        return;
+    }
+
+    res->setState(ResourceState::Loaded);
+}
+
 ResourceState TextureResource::onUnload(TextureLoader &loader) {
     if (getState() == ResourceState::Unloaded) {
         return getState();
@@ -596,6 +708,57 @@ UniformVar *RenderBatchData::getVarByName(const c8 *name) {
     return nullptr;
 }
 
+void RenderBatchData::setInstanceTransforms(size_t first, size_t count, const glm::mat4 *transforms) {
+    if (nullptr == transforms || 0 == count) {
+        return;
+    }
+
+    growInstances(first + count);
+    for (size_t i = 0; i < count; ++i) {
+        m_instances[first + i].transform = transforms[i];
+    }
+    markInstancesDirty(first, count);
+}
+
+void RenderBatchData::setInstanceColors(size_t first, size_t count, const glm::vec4 *colors) {
+    if (nullptr == colors || 0 == count) {
+        return;
+    }
+
+    growInstances(first + count);
+    for (size_t i = 0; i < count; ++i) {
+        m_instances[first + i].color = colors[i];
+    }
+    markInstancesDirty(first, count);
+}
+
+void RenderBatchData::growInstances(size_t numInstances) {
+    const size_t oldSize = m_instances.size();
+    if (numInstances <= oldSize) {
+        return;
+    }
+
+    m_instances.resize(numInstances);
+    for (size_t i = oldSize; i < numInstances; ++i) {
+        m_instances[i] = InstanceVert();
+    }
+
+    // A grown stream needs new storage, so it will be uploaded completely
+    markInstancesDirty(0, numInstances);
+}
+
+void RenderBatchData::markInstancesDirty(size_t first, size_t count) {
+    const size_t last = first + count;
+    if (hasDirtyInstances()) {
+        m_instanceDirtyBegin = first < m_instanceDirtyBegin ? first : m_instanceDirtyBegin;
+        m_instanceDirtyEnd = last > m_instanceDirtyEnd ? last : m_instanceDirtyEnd;
+    } else {
+        m_instanceDirtyBegin = first;
+        m_instanceDirtyEnd = last;
+    }
+    m_dirtyFlag |= InstanceDataDirty;
+}
+
 RenderBatchData *PassData::getBatchById(const c8 *id) const {
     if (nullptr == id) {
         return nullptr;
@@ -611,17 +774,19 @@ RenderBatchData *PassData::getBatchById(const c8 *id) const {
 }
 
 static const size_t MaxSubmitCmds = 500;
+static const size_t FrameArenaSize = 256 * 1024;
 
 Frame::Frame() :
         m_newPasses(),
         m_submitCmds(),
-        m_submitCmdAllocator(),
+        m_arena(FrameArenaSize),
         m_uniforBuffers(nullptr),
         m_pipeline(nullptr) {
-    m_submitCmdAllocator.reserve(MaxSubmitCmds);
+    m_submitCmds.reserve(MaxSubmitCmds);
 }
 
 Frame::~Frame() {
+    reset();
     delete[] m_uniforBuffers;
     m_uniforBuffers = nullptr;
 }
@@ -637,7 +802,7 @@ void Frame::init(TArray<PassData *> &newPasses) {
 }
 
 FrameSubmitCmd *Frame::enqueue() {
-    FrameSubmitCmd *cmd = m_submitCmdAllocator.alloc();
+    FrameSubmitCmd *cmd = m_arena.create<FrameSubmitCmd>();
     if (nullptr != cmd) {
         m_submitCmds.add(cmd);
     }
@@ -645,6 +810,19 @@ FrameSubmitCmd *Frame::enqueue() {
     return cmd;
 }
 
+c8 *Frame::alloc(size_t size) {
+    return static_cast<c8 *>(m_arena.alloc(size));
+}
+
+void Frame::reset() {
+    // The commands own arrays, so run the destructors before dropping the arena
+    for (FrameSubmitCmd *cmd : m_submitCmds) {
+        cmd->~FrameSubmitCmd();
+    }
+    m_submitCmds.resize(0);
+    m_arena.reset();
+}
+
 UniformDataBlob::UniformDataBlob() :
         m_data(nullptr),
         m_size(0) {
@@ -680,6 +858,12 @@ UniformDataBlob *UniformDataBlob::create(ParameterType type, size_t arraySize) {
         case ParameterType::PT_Float3:
             blob->m_size = sizeof(f32) * 3;
             break;
+        case ParameterType::PT_Float4:
+            blob->m_size = sizeof(f32) * 4;
+            break;
+        case ParameterType::PT_Mat3:
+            blob->m_size = sizeof(f32) * 9;
+            break;
         case ParameterType::PT_Mat4:
             blob->m_size = sizeof(f32) * 16;
             break;
@@ -723,6 +907,12 @@ ui32 UniformVar::getParamDataSize(ParameterType type, ui32 arraySize) {
         case ParameterType::PT_Float3:
             size = sizeof(f32) * 3;
             break;
+        case ParameterType::PT_Float4:
+            size = sizeof(f32) * 4;
+            break;
+        case ParameterType::PT_Mat3:
+            size = sizeof(f32) * 9;
+            break;
         case ParameterType::PT_Mat4:
             size = sizeof(f32) * 16;
             break;
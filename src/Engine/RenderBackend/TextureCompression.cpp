@@ -0,0 +1,416 @@
+/*-----------------------------------------------------------------------------------------------
+The MIT License (MIT)
+
+Copyright (c) 2015-2022 OSRE ( Open Source Render Engine ) by Kim Kulling
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of
+this software and associated documentation files (the "Software"), to deal in
+the Software without restriction, including without limitation the rights to
+use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+the Software, and to permit persons to whom the Software is furnished to do so,
+subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+-----------------------------------------------------------------------------------------------*/
+#include <osre/RenderBackend/TextureCompression.h>
+#include <osre/Common/Logger.h>
+
+#include <cstring>
+
+namespace OSRE {
+namespace RenderBackend {
+
+static const c8 *Tag = "TextureCompression";
+
+static const ui32 BlockDim = 4;
+static const ui32 PixelsPerBlock = BlockDim * BlockDim;
+
+// Expands a pixel with 1 to 4 channels into RGBA, grey values are replicated
+static void fetchPixel(const uc8 *pixel, ui32 channels, uc8 *rgba) {
+    switch (channels) {
+        case 1:
+            rgba[0] = rgba[1] = rgba[2] = pixel[0];
+            rgba[3] = 255;
+            break;
+        case 2:
+            rgba[0] = rgba[1] = rgba[2] = pixel[0];
+            rgba[3] = pixel[1];
+            break;
+        case 3:
+            rgba[0] = pixel[0];
+            rgba[1] = pixel[1];
+            rgba[2] = pixel[2];
+            rgba[3] = 255;
+            break;
+        default:
+            ::memcpy(rgba, pixel, 4);
+            break;
+    }
+}
+
+// Gathers a block as RGBA, blocks crossing the border repeat the last row and column
+static void fetchBlock(const uc8 *pixels, ui32 width, ui32 height, ui32 channels, ui32 bx, ui32 by, uc8 *block) {
+    for (ui32 y = 0; y < BlockDim; ++y) {
+        const ui32 py = (by + y < height) ? by + y : height - 1;
+        for (ui32 x = 0; x < BlockDim; ++x) {
+            const ui32 px = (bx + x < width) ? bx + x : width - 1;
+            fetchPixel(pixels + (static_cast<size_t>(py) * width + px) * channels, channels, block + (y * BlockDim + x) * 4);
+        }
+    }
+}
+
+static void storeBlock(const uc8 *block, ui32 width, ui32 height, ui32 bx, ui32 by, uc8 *rgba) {
+    for (ui32 y = 0; y < BlockDim && by + y < height; ++y) {
+        for (ui32 x = 0; x < BlockDim && bx + x < width; ++x) {
+            ::memcpy(rgba + (static_cast<size_t>(by + y) * width + bx + x) * 4, block + (y * BlockDim + x) * 4, 4);
+        }
+    }
+}
+
+static ui16 packRGB565(const uc8 *rgb) {
+    return static_cast<ui16>(((rgb[0] >> 3) << 11) | ((rgb[1] >> 2) << 5) | (rgb[2] >> 3));
+}
+
+static void unpackRGB565(ui16 color, uc8 *rgb) {
+    const ui32 r = (color >> 11) & 0x1f;
+    const ui32 g = (color >> 5) & 0x3f;
+    const ui32 b = color & 0x1f;
+    rgb[0] = static_cast<uc8>((r << 3) | (r >> 2));
+    rgb[1] = static_cast<uc8>((g << 2) | (g >> 4));
+    rgb[2] = static_cast<uc8>((b << 3) | (b >> 2));
+}
+
+static ui16 readUI16(const uc8 *data) {
+    return static_cast<ui16>(data[0] | (data[1] << 8));
+}
+
+static void writeUI16(ui16 value, uc8 *data) {
+    data[0] = static_cast<uc8>(value & 0xff);
+    data[1] = static_cast<uc8>(value >> 8);
+}
+
+// Builds the four colors of a BC1 block, the three color mode is only used by BC1 itself
+static void buildColorPalette(ui16 c0, ui16 c1, bool fourColors, uc8 palette[4][4]) {
+    unpackRGB565(c0, palette[0]);
+    unpackRGB565(c1, palette[1]);
+    palette[0][3] = palette[1][3] = 255;
+    for (ui32 i = 0; i < 3; ++i) {
+        if (fourColors) {
+            palette[2][i] = static_cast<uc8>((2 * palette[0][i] + palette[1][i]) / 3);
+            palette[3][i] = static_cast<uc8>((palette[0][i] + 2 * palette[1][i]) / 3);
+        } else {
+            palette[2][i] = static_cast<uc8>((palette[0][i] + palette[1][i]) / 2);
+            palette[3][i] = 0;
+        }
+    }
+    palette[2][3] = 255;
+    palette[3][3] = fourColors ? 255 : 0;
+}
+
+static void encodeColorBlock(const uc8 *block, uc8 *dest) {
+    uc8 minColor[3] = { 255, 255, 255 };
+    uc8 maxColor[3] = { 0, 0, 0 };
+    for (ui32 i = 0; i < PixelsPerBlock; ++i) {
+        for (ui32 c = 0; c < 3; ++c) {
+            const uc8 value = block[i * 4 + c];
+            minColor[c] = value < minColor[c] ? value : minColor[c];
+            maxColor[c] = value > maxColor[c] ? value : maxColor[c];
+        }
+    }
+
+    // Move the endpoints inside the box, the interpolated colors cover it better
+    for (ui32 c = 0; c < 3; ++c) {
+        const uc8 inset = static_cast<uc8>((maxColor[c] - minColor[c]) >> 4);
+        minColor[c] = static_cast<uc8>(minColor[c] + inset);
+        maxColor[c] = static_cast<uc8>(maxColor[c] - inset);
+    }
+
+    // Pick the diagonal of the box, red and blue falling with green flip their endpoints
+    i32 center[3];
+    for (ui32 c = 0; c < 3; ++c) {
+        center[c] = (static_cast<i32>(minColor[c]) + static_cast<i32>(maxColor[c])) / 2;
+    }
+    i32 covariance[3] = { 0, 0, 0 };
+    for (ui32 i = 0; i < PixelsPerBlock; ++i) {
+        const i32 green = static_cast<i32>(block[i * 4 + 1]) - center[1];
+        covariance[0] += (static_cast<i32>(block[i * 4 + 0]) - center[0]) * green;
+        covariance[2] += (static_cast<i32>(block[i * 4 + 2]) - center[2]) * green;
+    }
+    for (ui32 c = 0; c < 3; c += 2) {
+        if (covariance[c] < 0) {
+            const uc8 tmp = minColor[c];
+            minColor[c] = maxColor[c];
+            maxColor[c] = tmp;
+        }
+    }
+
+    ui16 c0 = packRGB565(maxColor);
+    ui16 c1 = packRGB565(minColor);
+    if (c0 < c1) {
+        const ui16 tmp = c0;
+        c0 = c1;
+        c1 = tmp;
+    }
+    writeUI16(c0, dest);
+    writeUI16(c1, dest + 2);
+
+    ui32 indices = 0;
+    if (c0 != c1) {
+        uc8 palette[4][4];
+        buildColorPalette(c0, c1, true, palette);
+        for (ui32 i = 0; i < PixelsPerBlock; ++i) {
+            ui32 best = 0, bestDist = 0xffffffff;
+            for (ui32 j = 0; j < 4; ++j) {
+                ui32 dist = 0;
+                for (ui32 c = 0; c < 3; ++c) {
+                    const i32 d = static_cast<i32>(block[i * 4 + c]) - static_cast<i32>(palette[j][c]);
+                    dist += static_cast<ui32>(d * d);
+                }
+                if (dist < bestDist) {
+                    bestDist = dist;
+                    best = j;
+                }
+            }
+            indices |= best << (i * 2);
+        }
+    }
+    writeUI16(static_cast<ui16>(indices & 0xffff), dest + 4);
+    writeUI16(static_cast<ui16>(indices >> 16), dest + 6);
+}
+
+static void decodeColorBlock(const uc8 *src, bool forceFourColors, uc8 *block) {
+    const ui16 c0 = readUI16(src);
+    const ui16 c1 = readUI16(src + 2);
+    uc8 palette[4][4];
+    buildColorPalette(c0, c1, forceFourColors || c0 > c1, palette);
+    const ui32 indices = readUI16(src + 4) | (static_cast<ui32>(readUI16(src + 6)) << 16);
+    for (ui32 i = 0; i < PixelsPerBlock; ++i) {
+        ::memcpy(block + i * 4, palette[(indices >> (i * 2)) & 0x3], 4);
+    }
+}
+
+static void buildValuePalette(uc8 v0, uc8 v1, uc8 palette[8]) {
+    palette[0] = v0;
+    palette[1] = v1;
+    if (v0 > v1) {
+        for (ui32 i = 1; i < 7; ++i) {
+            palette[i + 1] = static_cast<uc8>(((7 - i) * v0 + i * v1) / 7);
+        }
+    } else {
+        for (ui32 i = 1; i < 5; ++i) {
+            palette[i + 1] = static_cast<uc8>(((5 - i) * v0 + i * v1) / 5);
+        }
+        palette[6] = 0;
+        palette[7] = 255;
+    }
+}
+
+// Encodes one channel of a block like BC4, used for the alpha of BC3 and both channels of BC5
+static void encodeValueBlock(const uc8 *block, ui32 channel, uc8 *dest) {
+    uc8 minValue = 255, maxValue = 0;
+    for (ui32 i = 0; i < PixelsPerBlock; ++i) {
+        const uc8 value = block[i * 4 + channel];
+        minValue = value < minValue ? value : minValue;
+        maxValue = value > maxValue ? value : maxValue;
+    }
+    dest[0] = maxValue;
+    dest[1] = minValue;
+
+    uc8 palette[8];
+    buildValuePalette(maxValue, minValue, palette);
+    ui64 indices = 0;
+    if (maxValue != minValue) {
+        for (ui32 i = 0; i < PixelsPerBlock; ++i) {
+            const i32 value = block[i * 4 + channel];
+            ui32 best = 0;
+            i32 bestDist = 256;
+            for (ui32 j = 0; j < 8; ++j) {
+                const i32 dist = value > palette[j] ? value - palette[j] : palette[j] - value;
+                if (dist < bestDist) {
+                    bestDist = dist;
+                    best = j;
+                }
+            }
+            indices |= static_cast<ui64>(best) << (i * 3);
+        }
+    }
+    for (ui32 i = 0; i < 6; ++i) {
+        dest[2 + i] = static_cast<uc8>((indices >> (i * 8)) & 0xff);
+    }
+}
+
+static void decodeValueBlock(const uc8 *src, ui32 channel, uc8 *block) {
+    uc8 palette[8];
+    buildValuePalette(src[0], src[1], palette);
+    ui64 indices = 0;
+    for (ui32 i = 0; i < 6; ++i) {
+        indices |= static_cast<ui64>(src[2 + i]) << (i * 8);
+    }
+    for (ui32 i = 0; i < PixelsPerBlock; ++i) {
+        block[i * 4 + channel] = palette[(indices >> (i * 3)) & 0x7];
+    }
+}
+
+bool TextureCompression::isCompressed(PixelFormatType format) {
+    return 0 != getBlockSize(format);
+}
+
+ui32 TextureCompression::getBlockSize(PixelFormatType format) {
+    switch (format) {
+        case PixelFormatType::BC1:
+        case PixelFormatType::ETC2_RGB8:
+            return 8;
+        case PixelFormatType::BC3:
+        case PixelFormatType::BC5:
+        case PixelFormatType::BC7:
+        case PixelFormatType::ETC2_RGBA8:
+            return 16;
+        default:
+            break;
+    }
+
+    return 0;
+}
+
+size_t TextureCompression::getImageSize(PixelFormatType format, ui32 width, ui32 height) {
+    const ui32 blockSize = getBlockSize(format);
+    if (0 != blockSize) {
+        const size_t numBlocksX = (width + BlockDim - 1) / BlockDim;
+        const size_t numBlocksY = (height + BlockDim - 1) / BlockDim;
+        return numBlocksX * numBlocksY * blockSize;
+    }
+
+    const size_t channels = PixelFormatType::R8G8B8A8 == format ? 4 : 3;
+    return static_cast<size_t>(width) * height * channels;
+}
+
+ui32 TextureCompression::getNumMipLevels(ui32 width, ui32 height) {
+    ui32 size = width > height ? width : height;
+    ui32 numLevels = 1;
+    while (size > 1) {
+        size >>= 1;
+        ++numLevels;
+    }
+
+    return numLevels;
+}
+
+bool TextureCompression::canEncode(PixelFormatType format) {
+    return PixelFormatType::BC1 == format || PixelFormatType::BC3 == format || PixelFormatType::BC5 == format;
+}
+
+bool TextureCompression::canDecode(PixelFormatType format) {
+    return canEncode(format);
+}
+
+bool TextureCompression::encode(PixelFormatType format, const uc8 *pixels, ui32 width, ui32 height, ui32 channels, uc8 *blocks) {
+    if (nullptr == pixels || nullptr == blocks || 0 == width || 0 == height || 0 == channels || channels > 4) {
+        osre_error(Tag, "Invalid image to encode.");
+        return false;
+    }
+    if (!canEncode(format)) {
+        osre_error(Tag, "Pixel format cannot be encoded.");
+        return false;
+    }
+
+    const ui32 blockSize = getBlockSize(format);
+    uc8 block[PixelsPerBlock * 4];
+    for (ui32 by = 0; by < height; by += BlockDim) {
+        for (ui32 bx = 0; bx < width; bx += BlockDim) {
+            fetchBlock(pixels, width, height, channels, bx, by, block);
+            switch (format) {
+                case PixelFormatType::BC1:
+                    encodeColorBlock(block, blocks);
+                    break;
+                case PixelFormatType::BC3:
+                    encodeValueBlock(block, 3, blocks);
+                    encodeColorBlock(block, blocks + 8);
+                    break;
+                case PixelFormatType::BC5:
+                    encodeValueBlock(block, 0, blocks);
+                    encodeValueBlock(block, 1, blocks + 8);
+                    break;
+                default:
+                    break;
+            }
+            blocks += blockSize;
+        }
+    }
+
+    return true;
+}
+
+bool TextureCompression::decode(PixelFormatType format, const uc8 *blocks, ui32 width, ui32 height, uc8 *rgba) {
+    if (nullptr == blocks || nullptr == rgba || 0 == width || 0 == height) {
+        osre_error(Tag, "Invalid image to decode.");
+        return false;
+    }
+    if (!canDecode(format)) {
+        osre_error(Tag, "Pixel format cannot be decoded.");
+        return false;
+    }
+
+    const ui32 blockSize = getBlockSize(format);
+    uc8 block[PixelsPerBlock * 4];
+    for (ui32 by = 0; by < height; by += BlockDim) {
+        for (ui32 bx = 0; bx < width; bx += BlockDim) {
+            switch (format) {
+                case PixelFormatType::BC1:
+                    decodeColorBlock(blocks, false, block);
+                    break;
+                case PixelFormatType::BC3:
+                    decodeColorBlock(blocks + 8, true, block);
+                    decodeValueBlock(blocks, 3, block);
+                    break;
+                case PixelFormatType::BC5:
+                    decodeValueBlock(blocks, 0, block);
+                    decodeValueBlock(blocks + 8, 1, block);
+                    for (ui32 i = 0; i < PixelsPerBlock; ++i) {
+                        block[i * 4 + 2] = 0;
+                        block[i * 4 + 3] = 255;
+                    }
+                    break;
+                default:
+                    break;
+            }
+            storeBlock(block, width, height, bx, by, rgba);
+            blocks += blockSize;
+        }
+    }
+
+    return true;
+}
+
+void TextureCompression::downsample(const uc8 *pixels, ui32 width, ui32 height, ui32 channels, uc8 *target) {
+    if (nullptr == pixels || nullptr == target) {
+        return;
+    }
+
+    // A side with a single pixel averages the pixel with itself, odd sizes drop the last one
+    const ui32 targetWidth = width > 1 ? width / 2 : 1;
+    const ui32 targetHeight = height > 1 ? height / 2 : 1;
+    for (ui32 y = 0; y < targetHeight; ++y) {
+        const size_t y0 = static_cast<size_t>(y) * 2;
+        const size_t y1 = height > 1 ? y0 + 1 : y0;
+        for (ui32 x = 0; x < targetWidth; ++x) {
+            const size_t x0 = static_cast<size_t>(x) * 2;
+            const size_t x1 = width > 1 ? x0 + 1 : x0;
+            for (ui32 c = 0; c < channels; ++c) {
+                const ui32 sum = pixels[(y0 * width + x0) * channels + c] + pixels[(y0 * width + x1) * channels + c] +
+                        pixels[(y1 * width + x0) * channels + c] + pixels[(y1 * width + x1) * channels + c];
+                target[(static_cast<size_t>(y) * targetWidth + x) * channels + c] = static_cast<uc8>((sum + 2) / 4);
+            }
+        }
+    }
+}
+
+} // Namespace RenderBackend
+} // Namespace OSRE
@@ -0,0 +1,277 @@
+/*-----------------------------------------------------------------------------------------------
+The MIT License (MIT)
+
+Copyright (c) 2015-2022 OSRE ( Open Source Render Engine ) by Kim Kulling
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of
+this software and associated documentation files (the "Software"), to deal in
+the Software without restriction, including without limitation the rights to
+use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+the Software, and to permit persons to whom the Software is furnished to do so,
+subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+-----------------------------------------------------------------------------------------------*/
+#include <osre/RenderBackend/UniformBlock.h>
+#include <osre/Common/Logger.h>
+#include <osre/Common/StringUtils.h>
+
+namespace OSRE {
+namespace RenderBackend {
+
+using namespace ::OSRE::Common;
+
+static const c8 *Tag = "UniformBlock";
+
+static const c8 *BlockNames[MaxUniformBlockTypes] = {
+    "FrameBlock",
+    "MaterialBlock",
+    "DrawBlock"
+};
+
+static constexpr size_t Vec4Size = sizeof(f32) * 4;
+
+static size_t roundUp(size_t value, size_t alignment) {
+    return (value + alignment - 1) & ~(alignment - 1);
+}
+
+static bool isArrayType(ParameterType type) {
+    switch (type) {
+        case ParameterType::PT_IntArray:
+        case ParameterType::PT_FloatArray:
+        case ParameterType::PT_Float2Array:
+        case ParameterType::PT_Float3Array:
+        case ParameterType::PT_Float4Array:
+        case ParameterType::PT_Mat3Array:
+        case ParameterType::PT_Mat4Array:
+            return true;
+        default:
+            break;
+    }
+
+    return false;
+}
+
+// A mat3 is stored as three vec3 columns, each column uses a vec4 slot
+static size_t getNumColumns(ParameterType type) {
+    if (ParameterType::PT_Mat3 == type || ParameterType::PT_Mat3Array == type) {
+        return 3;
+    }
+
+    return 1;
+}
+
+UniformBlock::UniformBlock(const String &name) :
+        mName(name),
+        mType(getTypeFromName(name)),
+        mMembers(),
+        mEnd(0),
+        mData(),
+        mDirty(false) {
+    // empty
+}
+
+size_t UniformBlock::addMember(const String &name, ParameterType type, ui32 numItems) {
+    // Arrays are aligned like vec4 and every item uses at least one vec4 slot
+    const bool isArray = isArrayType(type) || numItems > 1;
+    const size_t alignment = isArray ? Vec4Size : getBaseAlignment(type);
+    const size_t offset = roundUp(mEnd, alignment);
+    addMember(name, type, numItems, offset, getArrayStride(type));
+
+    return offset;
+}
+
+void UniformBlock::addMember(const String &name, ParameterType type, ui32 numItems, size_t offset, size_t arrayStride) {
+    if (nullptr != findMember(name)) {
+        osre_debug(Tag, "Member " + name + " already in block " + mName + ".");
+        return;
+    }
+
+    if (0 == numItems) {
+        numItems = 1;
+    }
+
+    Member member;
+    member.m_name = name;
+    member.m_hash = StringUtils::hashName(name);
+    member.m_type = type;
+    member.m_numItems = numItems;
+    member.m_offset = offset;
+    member.m_arrayStride = 0 == arrayStride ? getArrayStride(type) : arrayStride;
+    mMembers.add(member);
+
+    // Arrays and matrices are padded to a full vec4 at the end
+    size_t end = offset + member.m_arrayStride * (numItems - 1) + getItemSize(type);
+    if (isArrayType(type) || numItems > 1 || 1 != getNumColumns(type)) {
+        end = roundUp(end, Vec4Size);
+    }
+    if (end > mEnd) {
+        mEnd = end;
+    }
+
+    // The block size is a multiple of a vec4
+    resize(roundUp(mEnd, Vec4Size));
+}
+
+const UniformBlock::Member *UniformBlock::findMember(const String &name) const {
+    const i32 index = getMemberIndex(name);
+    if (-1 == index) {
+        return nullptr;
+    }
+
+    return &mMembers[index];
+}
+
+i32 UniformBlock::getMemberIndex(const String &name) const {
+    const ui32 hash = StringUtils::hashName(name);
+    for (ui32 i = 0; i < mMembers.size(); ++i) {
+        if (mMembers[i].m_hash == hash && mMembers[i].m_name == name) {
+            return static_cast<i32>(i);
+        }
+    }
+
+    return -1;
+}
+
+bool UniformBlock::setValue(const String &name, const void *data, size_t size) {
+    const i32 index = getMemberIndex(name);
+    if (-1 == index) {
+        return false;
+    }
+
+    return setValue(static_cast<size_t>(index), data, size);
+}
+
+bool UniformBlock::setValue(size_t index, const void *data, size_t size) {
+    if (index >= mMembers.size()) {
+        return false;
+    }
+
+    const Member *member = &mMembers[index];
+    if (nullptr == data) {
+        osre_debug(Tag, "Invalid data for member " + member->m_name + ".");
+        return true;
+    }
+
+    const size_t itemSize = getItemSize(member->m_type);
+    size_t numItems = 0 == itemSize ? 0 : size / itemSize;
+    if (numItems > member->m_numItems) {
+        numItems = member->m_numItems;
+    }
+
+    const size_t numColumns = getNumColumns(member->m_type);
+    const size_t columnSize = itemSize / numColumns;
+    const c8 *src = static_cast<const c8 *>(data);
+    for (size_t i = 0; i < numItems; ++i) {
+        for (size_t j = 0; j < numColumns; ++j) {
+            c8 *dest = &mData[member->m_offset + i * member->m_arrayStride + j * Vec4Size];
+            if (0 != ::memcmp(dest, src, columnSize)) {
+                ::memcpy(dest, src, columnSize);
+                mDirty = true;
+            }
+            src += columnSize;
+        }
+    }
+
+    return true;
+}
+
+UniformBlockType UniformBlock::getTypeFromName(const String &name) {
+    for (ui32 i = 0; i < MaxUniformBlockTypes; ++i) {
+        if (name == BlockNames[i]) {
+            return static_cast<UniformBlockType>(i);
+        }
+    }
+
+    return UniformBlockType::InvalidBlockType;
+}
+
+const c8 *UniformBlock::getBlockName(UniformBlockType type) {
+    if (type >= UniformBlockType::NumBlockTypes) {
+        return nullptr;
+    }
+
+    return BlockNames[static_cast<ui32>(type)];
+}
+
+size_t UniformBlock::getBaseAlignment(ParameterType type) {
+    switch (type) {
+        case ParameterType::PT_Int:
+        case ParameterType::PT_IntArray:
+        case ParameterType::PT_Float:
+        case ParameterType::PT_FloatArray:
+            return sizeof(f32);
+        case ParameterType::PT_Float2:
+        case ParameterType::PT_Float2Array:
+            return sizeof(f32) * 2;
+        case ParameterType::PT_Float3:
+        case ParameterType::PT_Float3Array:
+        case ParameterType::PT_Float4:
+        case ParameterType::PT_Float4Array:
+        case ParameterType::PT_Mat3:
+        case ParameterType::PT_Mat3Array:
+        case ParameterType::PT_Mat4:
+        case ParameterType::PT_Mat4Array:
+            return Vec4Size;
+        default:
+            break;
+    }
+
+    return 0;
+}
+
+size_t UniformBlock::getArrayStride(ParameterType type) {
+    return getNumColumns(type) * roundUp(getItemSize(type) / getNumColumns(type), Vec4Size);
+}
+
+size_t UniformBlock::getItemSize(ParameterType type) {
+    switch (type) {
+        case ParameterType::PT_Int:
+        case ParameterType::PT_IntArray:
+            return sizeof(i32);
+        case ParameterType::PT_Float:
+        case ParameterType::PT_FloatArray:
+            return sizeof(f32);
+        case ParameterType::PT_Float2:
+        case ParameterType::PT_Float2Array:
+            return sizeof(f32) * 2;
+        case ParameterType::PT_Float3:
+        case ParameterType::PT_Float3Array:
+            return sizeof(f32) * 3;
+        case ParameterType::PT_Float4:
+        case ParameterType::PT_Float4Array:
+            return sizeof(f32) * 4;
+        case ParameterType::PT_Mat3:
+        case ParameterType::PT_Mat3Array:
+            return sizeof(f32) * 9;
+        case ParameterType::PT_Mat4:
+        case ParameterType::PT_Mat4Array:
+            return sizeof(f32) * 16;
+        default:
+            break;
+    }
+
+    return 0;
+}
+
+void UniformBlock::resize(size_t size) {
+    const size_t oldSize = mData.size();
+    if (size <= oldSize) {
+        return;
+    }
+
+    mData.resize(size);
+    ::memset(&mData[oldSize], 0, size - oldSize);
+    mDirty = true;
+}
+
+} // Namespace RenderBackend
+} // Namespace OSRE
@@ -0,0 +1,75 @@
+/*-----------------------------------------------------------------------------------------------
+The MIT License (MIT)
+
+Copyright (c) 2015-2022 OSRE ( Open Source Render Engine ) by Kim Kulling
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of
+this software and associated documentation files (the "Software"), to deal in
+the Software without restriction, including without limitation the rights to
+use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+the Software, and to permit persons to whom the Software is furnished to do so,
+subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+-----------------------------------------------------------------------------------------------*/
+#include <osre/Threading/Fence.h>
+#include <osre/Threading/ThreadingCommon.h>
+
+namespace OSRE {
+namespace Threading {
+
+Fence::Fence(ui64 initialValue) :
+        m_value(initialValue),
+        m_lock(),
+        m_event() {
+    // empty
+}
+
+Fence::~Fence() {
+    // empty
+}
+
+void Fence::signal(ui64 value) {
+    {
+        std::lock_guard<std::mutex> lock(m_lock);
+        if (value <= m_value.load(std::memory_order_relaxed)) {
+            return;
+        }
+        m_value.store(value, std::memory_order_release);
+    }
+    m_event.notify_all();
+}
+
+ui64 Fence::getValue() const {
+    return m_value.load(std::memory_order_acquire);
+}
+
+void Fence::wait(ui64 value) {
+    for (ui32 i = 0; i < SpinCount; ++i) {
+        if (getValue() >= value) {
+            return;
+        }
+        cpuPause();
+    }
+
+    std::unique_lock<std::mutex> lock(m_lock);
+    while (getValue() < value) {
+        m_event.wait(lock);
+    }
+}
+
+void Fence::reset(ui64 value) {
+    std::lock_guard<std::mutex> lock(m_lock);
+    m_value.store(value, std::memory_order_release);
+}
+
+} // Namespace Threading
+} // Namespace OSRE
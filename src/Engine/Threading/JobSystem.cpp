@@ -0,0 +1,432 @@
+/*-----------------------------------------------------------------------------------------------
+The MIT License (MIT)
+
+Copyright (c) 2015-2022 OSRE ( Open Source Render Engine ) by Kim Kulling
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of
+this software and associated documentation files (the "Software"), to deal in
+the Software without restriction, including without limitation the rights to
+use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+the Software, and to permit persons to whom the Software is furnished to do so,
+subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+-----------------------------------------------------------------------------------------------*/
+#include <osre/Threading/JobSystem.h>
+#include <osre/Threading/ThreadingCommon.h>
+#include <osre/Debugging/osre_debugging.h>
+#include <osre/Platform/SystemInfo.h>
+
+#include <chrono>
+
+namespace OSRE {
+namespace Threading {
+
+static constexpr c8 Tag[] = "JobSystem";
+
+// States of the continuation counter beside the number of continuations
+static constexpr ui32 ContinuationsLocked = 0xfffffffeu; ///< The list is modified or read by finish.
+static constexpr ui32 ContinuationsSealed = 0xffffffffu; ///< The job is finished, the slot is free.
+
+/// @brief  A job stored in the ring of the job system.
+struct Job {
+    JobFunc m_func;
+    void *m_data;
+    Job *m_parent;
+    std::atomic<i32> m_unfinished;          ///< The job itself and its unfinished children.
+    std::atomic<i32> m_dependencies;        ///< The unfinished preconditions, plus one until run.
+    std::atomic<ui32> m_numContinuations;   ///< The number of continuations or one of the states.
+    Job *m_continuations[JobSystem::MaxContinuations];
+
+    Job() :
+            m_func(nullptr),
+            m_data(nullptr),
+            m_parent(nullptr),
+            m_unfinished(0),
+            m_dependencies(0),
+            m_numContinuations(ContinuationsSealed) {
+        // empty
+    }
+};
+
+namespace {
+
+// Locks the continuation list, returns the number of continuations or ContinuationsSealed
+ui32 lockContinuations(Job *job) {
+    for (;;) {
+        ui32 count = job->m_numContinuations.load(std::memory_order_acquire);
+        if (ContinuationsSealed == count) {
+            return count;
+        }
+        if (ContinuationsLocked != count &&
+                job->m_numContinuations.compare_exchange_weak(count, ContinuationsLocked, std::memory_order_acquire)) {
+            return count;
+        }
+        cpuPause();
+    }
+}
+
+struct ParallelForRange {
+    const ParallelForFunc *m_func;
+    size_t m_begin;
+    size_t m_end;
+};
+
+void parallelForJob(void *data) {
+    const ParallelForRange *range = static_cast<const ParallelForRange *>(data);
+    (*range->m_func)(range->m_begin, range->m_end);
+}
+
+// The job system owning the current thread and the index of its deque
+thread_local const JobSystem *sOwner = nullptr;
+thread_local i32 sWorkerIndex = -1;
+
+} // Anonymous namespace
+
+JobSystem *JobSystem::sInstance = nullptr;
+
+JobSystem::JobSystem(ui32 numWorkers) :
+        m_jobs(nullptr),
+        m_nextJob(0),
+        m_deques(),
+        m_injectedJobs(MaxJobs, QueueMode::MPMC),
+        m_threads(),
+        m_running(true),
+        m_numQueued(0),
+        m_numSleeping(0),
+        m_parkLock(),
+        m_parkEvent() {
+    if (0 == numWorkers) {
+        // The creating thread is a worker as well
+        const ui32 numCores = Platform::SystemInfo::getNumCPUCores();
+        numWorkers = numCores > 1 ? numCores - 1 : 0;
+    }
+
+    m_jobs = new Job[MaxJobs];
+    for (ui32 i = 0; i <= numWorkers; ++i) {
+        m_deques.push_back(new JobDeque(MaxJobs));
+    }
+
+    sOwner = this;
+    sWorkerIndex = 0;
+    for (ui32 i = 1; i <= numWorkers; ++i) {
+        m_threads.emplace_back(&JobSystem::workerMain, this, i);
+    }
+}
+
+JobSystem::~JobSystem() {
+    m_running.store(false, std::memory_order_release);
+    {
+        std::lock_guard<std::mutex> lock(m_parkLock);
+        m_parkEvent.notify_all();
+    }
+    for (std::thread &thread : m_threads) {
+        thread.join();
+    }
+
+    for (JobDeque *deque : m_deques) {
+        delete deque;
+    }
+    delete[] m_jobs;
+
+    if (this == sOwner) {
+        sOwner = nullptr;
+        sWorkerIndex = -1;
+    }
+}
+
+bool JobSystem::create(ui32 numWorkers) {
+    if (nullptr != sInstance) {
+        return false;
+    }
+
+    sInstance = new JobSystem(numWorkers);
+    return true;
+}
+
+bool JobSystem::destroy() {
+    if (nullptr == sInstance) {
+        return false;
+    }
+    delete sInstance;
+    sInstance = nullptr;
+    return true;
+}
+
+JobSystem *JobSystem::getInstance() {
+    return sInstance;
+}
+
+JobHandle JobSystem::createJob(JobFunc func, void *data) {
+    Job *job = allocateJob();
+    job->m_func = func;
+    job->m_data = data;
+    job->m_parent = nullptr;
+    job->m_numContinuations.store(0, std::memory_order_relaxed);
+    job->m_dependencies.store(1, std::memory_order_relaxed);
+    job->m_unfinished.store(1, std::memory_order_release);
+
+    return job;
+}
+
+JobHandle JobSystem::createChildJob(JobHandle parent, JobFunc func, void *data) {
+    osre_assert(nullptr != parent);
+    osre_assert(!isFinished(parent));
+
+    parent->m_unfinished.fetch_add(1, std::memory_order_relaxed);
+    Job *job = createJob(func, data);
+    job->m_parent = parent;
+
+    return job;
+}
+
+bool JobSystem::addDependency(JobHandle job, JobHandle precondition) {
+    osre_assert(nullptr != job);
+    osre_assert(nullptr != precondition);
+
+    // The precondition may finish meanwhile, a finished one does not hold the job back
+    const ui32 count = lockContinuations(precondition);
+    if (ContinuationsSealed == count) {
+        return true;
+    }
+    if (count >= MaxContinuations) {
+        precondition->m_numContinuations.store(count, std::memory_order_release);
+        osre_error(Tag, "Too many dependent jobs.");
+        return false;
+    }
+
+    job->m_dependencies.fetch_add(1, std::memory_order_relaxed);
+    precondition->m_continuations[count] = job;
+    precondition->m_numContinuations.store(count + 1, std::memory_order_release);
+
+    return true;
+}
+
+void JobSystem::run(JobHandle job) {
+    osre_assert(nullptr != job);
+
+    resolveDependency(job);
+}
+
+void JobSystem::waitFor(JobHandle job) {
+    osre_assert(nullptr != job);
+
+    const i32 workerIndex = getWorkerIndex();
+    while (!isFinished(job)) {
+        if (!tryExecuteNext(workerIndex)) {
+            std::this_thread::yield();
+        }
+    }
+}
+
+bool JobSystem::isFinished(JobHandle job) const {
+    osre_assert(nullptr != job);
+
+    return 0 == job->m_unfinished.load(std::memory_order_acquire);
+}
+
+bool JobSystem::executeNext() {
+    return tryExecuteNext(getWorkerIndex());
+}
+
+void JobSystem::parallelFor(size_t count, size_t grainSize, const ParallelForFunc &func) {
+    if (0 == count) {
+        return;
+    }
+
+    if (0 == grainSize) {
+        grainSize = 1;
+    }
+
+    // A few ranges per worker are enough to balance the load by stealing
+    const size_t maxRanges = static_cast<size_t>(getNumWorkers()) * 4;
+    size_t numRanges = (count + grainSize - 1) / grainSize;
+    if (numRanges > maxRanges) {
+        numRanges = maxRanges;
+    }
+
+    if (numRanges < 2 || m_threads.empty()) {
+        func(0, count);
+        return;
+    }
+
+    std::vector<ParallelForRange> ranges(numRanges);
+    const size_t rangeSize = count / numRanges;
+    const size_t remainder = count % numRanges;
+    JobHandle root = createJob(nullptr, nullptr);
+    size_t begin = 0;
+    for (size_t i = 0; i < numRanges; ++i) {
+        const size_t end = begin + rangeSize + (i < remainder ? 1 : 0);
+        ranges[i].m_func = &func;
+        ranges[i].m_begin = begin;
+        ranges[i].m_end = end;
+        run(createChildJob(root, parallelForJob, &ranges[i]));
+        begin = end;
+    }
+    run(root);
+    waitFor(root);
+}
+
+ui32 JobSystem::getNumWorkers() const {
+    return static_cast<ui32>(m_threads.size()) + 1;
+}
+
+Job *JobSystem::allocateJob() {
+    // Slots of unfinished jobs are skipped, the caller helps to finish jobs until one is free
+    const i32 workerIndex = getWorkerIndex();
+    ui32 numTries = 0;
+    for (;;) {
+        const ui32 index = m_nextJob.fetch_add(1, std::memory_order_relaxed) & (MaxJobs - 1);
+        Job *job = &m_jobs[index];
+        if (ContinuationsSealed == job->m_numContinuations.load(std::memory_order_acquire)) {
+            return job;
+        }
+
+        if (++numTries == MaxJobs) {
+            osre_error(Tag, "All jobs of the ring are unfinished, waiting for a free one.");
+        }
+        if (!tryExecuteNext(workerIndex)) {
+            cpuPause();
+        }
+    }
+}
+
+void JobSystem::push(Job *job) {
+    m_numQueued.fetch_add(1, std::memory_order_relaxed);
+
+    const i32 workerIndex = getWorkerIndex();
+    const bool queued = workerIndex >= 0 ? m_deques[workerIndex]->push(job) : m_injectedJobs.tryEnqueue(job);
+    if (!queued) {
+        // The queue is full, so just do it now
+        m_numQueued.fetch_sub(1, std::memory_order_relaxed);
+        execute(job);
+        return;
+    }
+
+    // Only pay for the wakeup when a worker is parked
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    if (0 != m_numSleeping.load(std::memory_order_relaxed)) {
+        std::lock_guard<std::mutex> lock(m_parkLock);
+        m_parkEvent.notify_one();
+    }
+}
+
+bool JobSystem::tryExecuteNext(i32 workerIndex) {
+    Job *job = getNextJob(workerIndex);
+    if (nullptr == job) {
+        return false;
+    }
+
+    m_numQueued.fetch_sub(1, std::memory_order_relaxed);
+    execute(job);
+
+    return true;
+}
+
+Job *JobSystem::getNextJob(i32 workerIndex) {
+    Job *job = nullptr;
+    if (workerIndex >= 0 && m_deques[workerIndex]->pop(job)) {
+        return job;
+    }
+
+    if (m_injectedJobs.tryDequeue(job)) {
+        return job;
+    }
+
+    // Steal from the others, starting with the next one to spread the thieves
+    const i32 numDeques = static_cast<i32>(m_deques.size());
+    for (i32 i = 1; i <= numDeques; ++i) {
+        const i32 victim = (workerIndex + i) % numDeques;
+        if (victim != workerIndex && m_deques[victim]->steal(job)) {
+            return job;
+        }
+    }
+
+    return nullptr;
+}
+
+void JobSystem::execute(Job *job) {
+    if (nullptr != job->m_func) {
+        job->m_func(job->m_data);
+    }
+    finish(job);
+}
+
+void JobSystem::finish(Job *job) {
+    if (1 != job->m_unfinished.fetch_sub(1, std::memory_order_acq_rel)) {
+        return;
+    }
+
+    // The slot is not reused before it is sealed, so copy parent and continuations first. Later
+    // dependencies on the job will see the seal and not wait.
+    Job *parent = job->m_parent;
+    const ui32 numContinuations = lockContinuations(job);
+    osre_assert(ContinuationsSealed != numContinuations);
+    Job *continuations[MaxContinuations];
+    for (ui32 i = 0; i < numContinuations; ++i) {
+        continuations[i] = job->m_continuations[i];
+    }
+    job->m_numContinuations.store(ContinuationsSealed, std::memory_order_release);
+
+    for (ui32 i = 0; i < numContinuations; ++i) {
+        resolveDependency(continuations[i]);
+    }
+
+    if (nullptr != parent) {
+        finish(parent);
+    }
+}
+
+void JobSystem::resolveDependency(Job *job) {
+    if (1 == job->m_dependencies.fetch_sub(1, std::memory_order_acq_rel)) {
+        push(job);
+    }
+}
+
+void JobSystem::workerMain(ui32 workerIndex) {
+    sOwner = this;
+    sWorkerIndex = static_cast<i32>(workerIndex);
+
+    while (m_running.load(std::memory_order_acquire)) {
+        if (tryExecuteNext(sWorkerIndex)) {
+            continue;
+        }
+
+        bool hasWork = false;
+        for (ui32 i = 0; i < SpinCount; ++i) {
+            if (m_numQueued.load(std::memory_order_relaxed) > 0) {
+                hasWork = true;
+                break;
+            }
+            cpuPause();
+        }
+        if (hasWork) {
+            continue;
+        }
+
+        std::unique_lock<std::mutex> lock(m_parkLock);
+        m_numSleeping.fetch_add(1, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+
+        // Check again after announcing the sleep, a producer may have missed us
+        if (m_running.load(std::memory_order_acquire) && m_numQueued.load(std::memory_order_relaxed) <= 0) {
+            m_parkEvent.wait_for(lock, std::chrono::milliseconds(1));
+        }
+        m_numSleeping.fetch_sub(1, std::memory_order_relaxed);
+    }
+}
+
+i32 JobSystem::getWorkerIndex() const {
+    return this == sOwner ? sWorkerIndex : -1;
+}
+
+} // Namespace Threading
+} // Namespace OSRE
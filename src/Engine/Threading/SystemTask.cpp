@@ -25,10 +25,12 @@ CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
 #include <osre/Debugging/osre_debugging.h>
 #include <osre/Platform/Threading.h>
 #include <osre/Threading/SystemTask.h>
-#include <osre/Threading/TAsyncQueue.h>
+#include <osre/Threading/TLockFreeQueue.h>
 #include <osre/Threading/TaskJob.h>
 
+#include <atomic>
 #include <sstream>
+#include <thread>
 
 namespace OSRE {
 namespace Threading {
@@ -36,9 +38,62 @@ namespace Threading {
 using namespace ::OSRE::Common;
 using namespace ::OSRE::Platform;
 
-TaskJob *TaskJobAlloc(const Event *ev, const EventData *eventData) {
-    return new TaskJob(ev, eventData);
-}
+static const size_t MaxEnqueuedJobs = 1024;
+
+//-------------------------------------------------------------------------------------------------
+///	@ingroup	Engine
+///
+///	@brief	A fixed pool of task jobs. The free list is a lock-free queue as well, the task thread
+/// gives the jobs back and the sending threads take them. The job queue is never smaller than the 
+/// pool, so each allocated job can be enqueued.
+//-------------------------------------------------------------------------------------------------
+class TaskJobPool {
+public:
+    TaskJobPool(size_t numJobs, QueueMode mode) :
+            m_jobs(nullptr),
+            m_freeJobs(numJobs, QueueMode::SPSC == mode ? QueueMode::SPSC : QueueMode::MPMC),
+            m_consumerId() {
+        m_jobs = new TaskJob[numJobs];
+        for (size_t i = 0; i < numJobs; ++i) {
+            m_freeJobs.enqueue(&m_jobs[i]);
+        }
+    }
+
+    ~TaskJobPool() {
+        delete[] m_jobs;
+        m_jobs = nullptr;
+    }
+
+    void setConsumer(std::thread::id consumerId) {
+        m_consumerId.store(consumerId, std::memory_order_relaxed);
+    }
+
+    TaskJob *alloc(const Event *ev, const EventData *eventData) {
+        TaskJob *job = nullptr;
+        while (!m_freeJobs.tryDequeue(job)) {
+            // All jobs are in flight, only the task thread can give them back, so it must not wait
+            if (std::this_thread::get_id() == m_consumerId.load(std::memory_order_relaxed)) {
+                return nullptr;
+            }
+            std::this_thread::yield();
+        }
+        job->set(ev, eventData);
+
+        return job;
+    }
+
+    void release(TaskJob *job) {
+        osre_assert(nullptr != job);
+
+        job->clear();
+        m_freeJobs.enqueue(job);
+    }
+
+private:
+    TaskJob *m_jobs;
+    TLockFreeQueue<TaskJob *> m_freeJobs;
+    std::atomic<std::thread::id> m_consumerId;
+};
 
 DECL_EVENT(OnStopSystemTaskEvent);
 
@@ -66,13 +121,15 @@ public:
         StackSize = 4096
     };
 
-    SystemTaskThread(const String &threadName, TAsyncQueue<const TaskJob *> *jobQueue) :
+    SystemTaskThread(const String &threadName, TLockFreeQueue<TaskJob *> *jobQueue, TaskJobPool *jobPool) :
             Thread(threadName, StackSize),
             m_updateEvent(nullptr),
             m_stopEvent(nullptr),
             m_activeJobQueue(jobQueue),
+            m_jobPool(jobPool),
             m_eventHandler(nullptr) {
         osre_assert(nullptr != jobQueue);
+        osre_assert(nullptr != jobPool);
 
         m_updateEvent = new ThreadEvent();
         m_stopEvent = new ThreadEvent();
@@ -111,11 +168,11 @@ public:
         return m_eventHandler;
     }
 
-    void setActiveJobQueue(Threading::TAsyncQueue<const TaskJob *> *pJobQueue) {
+    void setActiveJobQueue(Threading::TLockFreeQueue<TaskJob *> *pJobQueue) {
         m_activeJobQueue = pJobQueue;
     }
 
-    Threading::TAsyncQueue<const TaskJob *> *getActiveJobQueue() const {
+    Threading::TLockFreeQueue<TaskJob *> *getActiveJobQueue() const {
         return m_activeJobQueue;
     }
 
@@ -132,10 +189,12 @@ protected:
         osre_assert(nullptr != m_activeJobQueue);
 
         osre_debug(Tag, "SystemThread::run");
+        m_jobPool->setConsumer(std::this_thread::get_id());
         bool running = true;
         while (running) {
             m_activeJobQueue->awaitEnqueuedItem();
-            while (!m_activeJobQueue->isEmpty()) {
+            TaskJob *job = nullptr;
+            while (m_activeJobQueue->tryDequeue(job)) {
                 // for debugging
                 if (DebugQueueSize) {
                     size_t size = m_activeJobQueue->size();
@@ -144,11 +203,11 @@ protected:
                     osre_debug(Tag, stream.str());
                 }
 
-                const TaskJob *job = m_activeJobQueue->dequeue();
                 const Common::Event *ev = job->getEvent();
                 if (nullptr == ev) {
                     running = false;
                     osre_assert(nullptr != ev);
+                    m_jobPool->release(job);
                     continue;
                 }
 
@@ -160,6 +219,10 @@ protected:
                 if (m_eventHandler) {
                     m_eventHandler->onEvent(*ev, job->getEventData());
                 }
+
+                // Signaled here for every handler, even when it ignored the event
+                job->signalFence();
+                m_jobPool->release(job);
             }
 
             if (m_updateEvent) {
@@ -167,6 +230,14 @@ protected:
             }
         }
 
+        // Jobs sent after the stop will never be handled, so release their waiters
+        TaskJob *job = nullptr;
+        while (m_activeJobQueue->tryDequeue(job)) {
+            job->signalFence();
+            m_jobPool->release(job);
+        }
+        m_jobPool->setConsumer(std::thread::id());
+
         if (m_stopEvent) {
             m_stopEvent->signal();
         }
@@ -177,21 +248,30 @@ protected:
 private:
     Platform::ThreadEvent *m_updateEvent;
     Platform::ThreadEvent *m_stopEvent;
-    Threading::TAsyncQueue<const TaskJob *> *m_activeJobQueue;
+    Threading::TLockFreeQueue<TaskJob *> *m_activeJobQueue;
+    TaskJobPool *m_jobPool;
     Common::AbstractEventHandler *m_eventHandler;
 };
 
-SystemTask::SystemTask(const String &taskName) :
+SystemTask::SystemTask(const String &taskName, QueueMode mode) :
         AbstractTask(taskName),
         m_workingMode(Async),
         m_buffermode(SingleBuffer),
         m_taskThread(nullptr),
-        m_asyncQueue(nullptr) {
+        m_queueMode(mode),
+        m_asyncQueue(nullptr),
+        m_jobPool(nullptr) {
     // empty
 }
 
 SystemTask::~SystemTask() {
     osre_assert(!isRunning());
+
+    delete m_asyncQueue;
+    m_asyncQueue = nullptr;
+
+    delete m_jobPool;
+    m_jobPool = nullptr;
 }
 
 void SystemTask::setWorkingMode(AbstractTask::WorkingMode mode) {
@@ -225,9 +305,12 @@ bool SystemTask::start(Thread *pThread) {
     }
 
     // setup the thread context
-    m_asyncQueue = new Threading::TAsyncQueue<const TaskJob*>();
+    if (nullptr == m_asyncQueue) {
+        m_asyncQueue = new TaskQueue(MaxEnqueuedJobs, m_queueMode);
+        m_jobPool = new TaskJobPool(MaxEnqueuedJobs, m_queueMode);
+    }
     if (!pThread) {
-        m_taskThread = new SystemTaskThread(Object::getName() + ".thread", m_asyncQueue);
+        m_taskThread = new SystemTaskThread(Object::getName() + ".thread", m_asyncQueue, m_jobPool);
     } else {
         m_taskThread = reinterpret_cast<SystemTaskThread *>(pThread);
     }
@@ -303,10 +386,42 @@ bool SystemTask::sendEvent(const Event *ev, const EventData *eventData) {
     osre_assert(nullptr != m_asyncQueue);
     osre_assert(nullptr != ev);
 
-    TaskJob *taskJob = TaskJobAlloc(ev, eventData);
-    m_asyncQueue->enqueue(taskJob);
+    TaskJob *taskJob = m_jobPool->alloc(ev, eventData);
+    if (nullptr == taskJob) {
+        osre_error(Tag, "Job queue of task " + getName() + " is full, the task cannot send to itself.");
+        return false;
+    }
+    const bool ok = m_asyncQueue->tryEnqueue(taskJob);
+    osre_assert(ok);
 
-    return true;
+    return ok;
+}
+
+bool SystemTask::sendEvent(const Event *ev, const EventData *eventData, Fence *fence, ui64 value) {
+    // A stopped task will never handle the job
+    if (nullptr == m_taskThread) {
+        if (nullptr != fence) {
+            fence->signal(value);
+        }
+        return false;
+    }
+
+    osre_assert(nullptr != m_asyncQueue);
+    osre_assert(nullptr != ev);
+
+    TaskJob *taskJob = m_jobPool->alloc(ev, eventData);
+    if (nullptr == taskJob) {
+        osre_error(Tag, "Job queue of task " + getName() + " is full, the task cannot send to itself.");
+        if (nullptr != fence) {
+            fence->signal(value);
+        }
+        return false;
+    }
+    taskJob->setFence(fence, value);
+    const bool ok = m_asyncQueue->tryEnqueue(taskJob);
+    osre_assert(ok);
+
+    return ok;
 }
 
 size_t SystemTask::getEvetQueueSize() const {
@@ -343,8 +458,12 @@ void SystemTask::awaitStop() {
     }
 }
 
-SystemTask *SystemTask::create(const String &taskName) {
-    return new SystemTask(taskName);
+QueueMode SystemTask::getQueueMode() const {
+    return m_queueMode;
+}
+
+SystemTask *SystemTask::create(const String &taskName, QueueMode mode) {
+    return new SystemTask(taskName, mode);
 }
 
 } // Namespace Threading
@@ -0,0 +1,112 @@
+/*-----------------------------------------------------------------------------------------------
+The MIT License (MIT)
+
+Copyright (c) 2015-2022 OSRE ( Open Source Render Engine ) by Kim Kulling
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of
+this software and associated documentation files (the "Software"), to deal in
+the Software without restriction, including without limitation the rights to
+use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+the Software, and to permit persons to whom the Software is furnished to do so,
+subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+-----------------------------------------------------------------------------------------------*/
+#include "Benchmark.h"
+
+#include <osre/Animation/Skinning.h>
+
+namespace OSRE {
+namespace Benchmark {
+
+using namespace ::OSRE::Animation;
+
+static const ui32 NumVertices = 4000;
+static const ui32 NumBones = 32;
+static const ui32 InfluencesPerVertex = 4;
+static const ui32 NumRuns = 10;
+
+// Keeps the compiler from removing the import loops
+static volatile ui32 Sink = 0;
+
+// A synthetic rigged mesh, every vertex is weighted by four neighbouring bones
+struct RiggedMesh {
+    std::vector<std::vector<VertexWeight>> mBoneWeights;
+};
+
+static void createRiggedMesh(RiggedMesh &mesh) {
+    mesh.mBoneWeights.resize(NumBones);
+    for (ui32 v = 0; v < NumVertices; ++v) {
+        const ui32 first = (v * NumBones) / NumVertices;
+        for (ui32 i = 0; i < InfluencesPerVertex; ++i) {
+            VertexWeight vw = { v, 0.1f + 0.2f * static_cast<f32>(i) };
+            mesh.mBoneWeights[(first + i) % NumBones].push_back(vw);
+        }
+    }
+}
+
+// The former import, which visits all bones and weights again for every vertex
+static ui32 importPerVertex(const RiggedMesh &mesh) {
+    ui32 result = 0;
+    for (ui32 v = 0; v < NumVertices; ++v) {
+        Bone *bones = new Bone[NumBones];
+        for (ui32 b = 0; b < NumBones; ++b) {
+            const std::vector<VertexWeight> &src = mesh.mBoneWeights[b];
+            VertexWeight *wArray = new VertexWeight[src.size()];
+            for (size_t w = 0; w < src.size(); ++w) {
+                wArray[w] = src[w];
+            }
+            bones[b].m_vertexWeights.add(wArray, src.size());
+            result += static_cast<ui32>(bones[b].m_vertexWeights.size());
+            delete[] wArray;
+        }
+        delete[] bones;
+    }
+
+    return result;
+}
+
+static ui32 importPacked(const RiggedMesh &mesh, VertexInfluenceBuilder &builder, VertexInfluenceArray &influences) {
+    builder.reset(NumVertices);
+    for (ui32 b = 0; b < NumBones; ++b) {
+        const std::vector<VertexWeight> &src = mesh.mBoneWeights[b];
+        builder.addBone(b, src.data(), src.size(), 0);
+    }
+    builder.build(influences);
+
+    return influences[NumVertices / 2].mWeights[0];
+}
+
+OSRE_BENCHMARK(Skinning) {
+    RiggedMesh mesh;
+    createRiggedMesh(mesh);
+
+    const ui64 numOps = static_cast<ui64>(NumVertices) * NumRuns;
+    ui32 sum = 0;
+    BenchmarkTimer timer;
+    for (ui32 run = 0; run < NumRuns; ++run) {
+        sum += importPerVertex(mesh);
+    }
+    report("Skinning", "bones per vertex", numOps, timer.getMilliseconds());
+
+    VertexInfluenceBuilder builder;
+    VertexInfluenceArray influences;
+    timer.restart();
+    for (ui32 run = 0; run < NumRuns; ++run) {
+        sum += importPacked(mesh, builder, influences);
+    }
+    report("Skinning", "packed, once per mesh", numOps, timer.getMilliseconds());
+
+    Sink = sum;
+}
+
+} // namespace Benchmark
+} // namespace OSRE
@@ -0,0 +1,117 @@
+/*-----------------------------------------------------------------------------------------------
+The MIT License (MIT)
+
+Copyright (c) 2015-2022 OSRE ( Open Source Render Engine ) by Kim Kulling
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of
+this software and associated documentation files (the "Software"), to deal in
+the Software without restriction, including without limitation the rights to
+use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+the Software, and to permit persons to whom the Software is furnished to do so,
+subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+-----------------------------------------------------------------------------------------------*/
+#include "Benchmark.h"
+
+#include <osre/App/AABBTree.h>
+#include <osre/Common/TRay.h>
+
+#include <cmath>
+
+namespace OSRE {
+namespace Benchmark {
+
+using namespace ::OSRE::App;
+using namespace ::OSRE::Common;
+
+static const ui32 NumQueries = 10000;
+static const ui32 NumLinearQueries = 1000;
+
+static ui32 sSeed = 4711;
+static f32 sWorldSize = 100.0f;
+
+static f32 random(f32 range) {
+    sSeed = sSeed * 1664525u + 1013904223u;
+    return static_cast<f32>(sSeed >> 8) / static_cast<f32>(1 << 24) * range;
+}
+
+static AABB randomBox(f32 size) {
+    const glm::vec3 min(random(sWorldSize), random(sWorldSize), random(sWorldSize));
+    return AABB(min, min + glm::vec3(size));
+}
+
+OSRE_BENCHMARK(AABBTreeQuery) {
+    static const ui32 NumEntities[] = { 1000, 10000, 100000 };
+
+    for (ui32 numEntities : NumEntities) {
+        // Keep the density constant, so each query finds about the same number of entities
+        sWorldSize = 100.0f * std::cbrt(static_cast<f32>(numEntities) / 1000.0f);
+        std::vector<AABB> boxes;
+        std::vector<i32> proxies;
+        boxes.reserve(numEntities);
+        proxies.reserve(numEntities);
+        AABBTree tree;
+        BenchmarkTimer timer;
+        for (ui32 i = 0; i < numEntities; ++i) {
+            boxes.push_back(randomBox(2.0f));
+            proxies.push_back(tree.createProxy(boxes.back(), nullptr));
+        }
+        const String suffix = ", " + std::to_string(numEntities) + " entities";
+        report("AABBTreeQuery", "build" + suffix, numEntities, timer.getMilliseconds());
+        std::cout << "    height: " << tree.getHeight() << "\n";
+
+        // The same queries for both variants
+        std::vector<AABB> queries;
+        for (ui32 i = 0; i < NumQueries; ++i) {
+            queries.push_back(randomBox(10.0f));
+        }
+
+        size_t numFound = 0;
+        timer.restart();
+        for (ui32 i = 0; i < NumLinearQueries; ++i) {
+            for (const AABB &box : boxes) {
+                numFound += queries[i].intersects(box) ? 1 : 0;
+            }
+        }
+        report("AABBTreeQuery", "linear box" + suffix, NumLinearQueries, timer.getMilliseconds());
+
+        CPPCore::TArray<void *> result;
+        size_t numTreeFound = 0;
+        timer.restart();
+        for (const AABB &query : queries) {
+            result.clear();
+            tree.queryBox(query, result);
+            numTreeFound += result.size();
+        }
+        report("AABBTreeQuery", "tree box" + suffix, NumQueries, timer.getMilliseconds());
+        std::cout << "    found: " << numFound << " linear in " << NumLinearQueries << " queries, " << numTreeFound << " tree\n";
+
+        timer.restart();
+        for (ui32 i = 0; i < NumQueries; ++i) {
+            result.clear();
+            const glm::vec3 origin(random(sWorldSize), random(sWorldSize), random(sWorldSize));
+            tree.queryRay(Ray(origin, glm::vec3(0.0f, 0.0f, 1.0f)), 20.0f, result);
+        }
+        report("AABBTreeQuery", "tree ray" + suffix, NumQueries, timer.getMilliseconds());
+
+        timer.restart();
+        for (ui32 i = 0; i < numEntities; ++i) {
+            const glm::vec3 offset(random(1.0f) - 0.5f, random(1.0f) - 0.5f, random(1.0f) - 0.5f);
+            boxes[i].set(boxes[i].getMin() + offset, boxes[i].getMax() + offset);
+            tree.moveProxy(proxies[i], boxes[i]);
+        }
+        report("AABBTreeQuery", "move all" + suffix, numEntities, timer.getMilliseconds());
+    }
+}
+
+} // Namespace Benchmark
+} // Namespace OSRE
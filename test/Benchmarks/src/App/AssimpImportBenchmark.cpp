@@ -0,0 +1,132 @@
+/*-----------------------------------------------------------------------------------------------
+The MIT License (MIT)
+
+Copyright (c) 2015-2022 OSRE ( Open Source Render Engine ) by Kim Kulling
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of
+this software and associated documentation files (the "Software"), to deal in
+the Software without restriction, including without limitation the rights to
+use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+the Software, and to permit persons to whom the Software is furnished to do so,
+subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+-----------------------------------------------------------------------------------------------*/
+#include "Benchmark.h"
+
+#include <osre/App/AssimpWrapper.h>
+#include <osre/App/World.h>
+#include <osre/Common/Ids.h>
+#include <osre/RenderBackend/MaterialBuilder.h>
+#include <osre/Threading/JobSystem.h>
+
+#include <assimp/scene.h>
+
+namespace OSRE {
+namespace Benchmark {
+
+using namespace ::OSRE::App;
+using namespace ::OSRE::RenderBackend;
+
+static const ui32 NumMeshes = 256;
+static const ui32 NumMaterials = 8;
+static const ui32 GridSize = 32;
+static const ui32 NumRuns = 10;
+
+// A scene with one grid per mesh, the meshes use the materials in turn
+static aiScene *createScene() {
+    aiScene *scene = new aiScene;
+    scene->mNumMaterials = NumMaterials;
+    scene->mMaterials = new aiMaterial *[NumMaterials];
+    for (ui32 i = 0; i < NumMaterials; ++i) {
+        scene->mMaterials[i] = new aiMaterial;
+    }
+
+    const ui32 numVertices = (GridSize + 1) * (GridSize + 1);
+    const ui32 numFaces = GridSize * GridSize * 2;
+    scene->mNumMeshes = NumMeshes;
+    scene->mMeshes = new aiMesh *[NumMeshes];
+    scene->mRootNode = new aiNode("root");
+    scene->mRootNode->mNumMeshes = NumMeshes;
+    scene->mRootNode->mMeshes = new unsigned int[NumMeshes];
+    for (ui32 i = 0; i < NumMeshes; ++i) {
+        aiMesh *mesh = new aiMesh;
+        mesh->mMaterialIndex = i % NumMaterials;
+        mesh->mNumVertices = numVertices;
+        mesh->mVertices = new aiVector3D[numVertices];
+        mesh->mNormals = new aiVector3D[numVertices];
+        for (ui32 y = 0; y <= GridSize; ++y) {
+            for (ui32 x = 0; x <= GridSize; ++x) {
+                const ui32 idx = y * (GridSize + 1) + x;
+                mesh->mVertices[idx] = aiVector3D(static_cast<ai_real>(x), static_cast<ai_real>(y), static_cast<ai_real>(i));
+                mesh->mNormals[idx] = aiVector3D(0, 0, 1);
+            }
+        }
+
+        mesh->mNumFaces = numFaces;
+        mesh->mFaces = new aiFace[numFaces];
+        for (ui32 face = 0; face < numFaces; ++face) {
+            const ui32 quad = face / 2;
+            const ui32 v0 = (quad / GridSize) * (GridSize + 1) + quad % GridSize;
+            const ui32 v1 = v0 + 1, v2 = v0 + GridSize + 2, v3 = v0 + GridSize + 1;
+            aiFace &current = mesh->mFaces[face];
+            current.mNumIndices = 3;
+            current.mIndices = new unsigned int[3];
+            current.mIndices[0] = v0;
+            current.mIndices[1] = 0 == face % 2 ? v1 : v2;
+            current.mIndices[2] = 0 == face % 2 ? v2 : v3;
+        }
+        scene->mMeshes[i] = mesh;
+        scene->mRootNode->mMeshes[i] = i;
+    }
+
+    return scene;
+}
+
+static void importScene(const aiScene *scene) {
+    Common::Ids ids;
+    World world("benchmark");
+    AssimpWrapper wrapper(ids, &world);
+    wrapper.importScene(scene);
+}
+
+OSRE_BENCHMARK(AssimpImport) {
+    MaterialBuilder::create(nullptr);
+    aiScene *scene = createScene();
+    const ui64 numOps = static_cast<ui64>(NumMeshes) * NumRuns;
+
+    // Without a job system every stage of the conversion runs on the calling thread
+    const bool ownsJobSystem = nullptr == Threading::JobSystem::getInstance();
+    BenchmarkTimer timer;
+    if (ownsJobSystem) {
+        for (ui32 run = 0; run < NumRuns; ++run) {
+            importScene(scene);
+        }
+        report("AssimpImport", "serial", numOps, timer.getMilliseconds());
+        Threading::JobSystem::create();
+    }
+
+    timer.restart();
+    for (ui32 run = 0; run < NumRuns; ++run) {
+        importScene(scene);
+    }
+    const ui32 numWorkers = Threading::JobSystem::getInstance()->getNumWorkers();
+    report("AssimpImport", "parallel, " + std::to_string(numWorkers) + " workers", numOps, timer.getMilliseconds());
+    if (ownsJobSystem) {
+        Threading::JobSystem::destroy();
+    }
+
+    delete scene;
+    MaterialBuilder::destroy();
+}
+
+} // namespace Benchmark
+} // namespace OSRE
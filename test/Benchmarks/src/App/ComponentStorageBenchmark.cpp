@@ -0,0 +1,158 @@
+/*-----------------------------------------------------------------------------------------------
+The MIT License (MIT)
+
+Copyright (c) 2015-2022 OSRE ( Open Source Render Engine ) by Kim Kulling
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of
+this software and associated documentation files (the "Software"), to deal in
+the Software without restriction, including without limitation the rights to
+use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+the Software, and to permit persons to whom the Software is furnished to do so,
+subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+-----------------------------------------------------------------------------------------------*/
+#include "Benchmark.h"
+
+#include <osre/App/Component.h>
+#include <osre/App/Entity.h>
+#include <osre/App/TComponentPool.h>
+#include <osre/Common/Ids.h>
+#include <osre/Threading/JobSystem.h>
+
+#include <algorithm>
+#include <memory>
+
+namespace OSRE {
+namespace Benchmark {
+
+using namespace ::OSRE::App;
+
+static const ui32 NumEntities = 100000;
+static const ui32 NumFrames = 100;
+
+// A component with some state to update, like a particle or a simple physics body
+class MotionComponent final : public Component {
+public:
+    MotionComponent(Entity *owner, ui32 id) :
+            Component(owner, id, ComponentType::TransformComponentType),
+            mPosition(0.0f),
+            mVelocity(static_cast<f32>(id % 7), 1.0f, static_cast<f32>(id % 3)) {
+        // empty
+    }
+
+    ~MotionComponent() override = default;
+
+    const glm::vec3 &getPosition() const {
+        return mPosition;
+    }
+
+protected:
+    bool onPreprocess() override {
+        return true;
+    }
+
+    bool onUpdate(Time dt) override {
+        mPosition += mVelocity * dt.asSeconds();
+        return true;
+    }
+
+    bool onRender(RenderBackend::RenderBackendService *) override {
+        return true;
+    }
+
+    bool onPostprocess() override {
+        return true;
+    }
+
+private:
+    glm::vec3 mPosition;
+    glm::vec3 mVelocity;
+};
+
+// The former layout, each entity owns its heap allocated component
+struct PointerEntity {
+    String mName;
+    MotionComponent *mComponent;
+};
+
+OSRE_BENCHMARK(ComponentStorage) {
+    Common::Ids ids;
+    Entity owner("owner", ids, nullptr);
+    const Time dt(16000);
+
+    // Entities are created and destroyed over time, so their order in memory gets mixed
+    std::vector<std::unique_ptr<PointerEntity>> entities;
+    std::vector<PointerEntity *> entityArray;
+    for (ui32 i = 0; i < NumEntities; ++i) {
+        entities.emplace_back(new PointerEntity);
+        entities.back()->mName = "entity";
+        entities.back()->mComponent = new MotionComponent(&owner, i);
+        entityArray.push_back(entities.back().get());
+    }
+    ui32 seed = 4711;
+    for (size_t i = entityArray.size() - 1; i > 0; --i) {
+        seed = seed * 1664525u + 1013904223u;
+        std::swap(entityArray[i], entityArray[(seed >> 8) % (i + 1)]);
+    }
+
+    TComponentPool<MotionComponent> pool;
+    for (ui32 i = 0; i < NumEntities; ++i) {
+        pool.add(i, &owner, i);
+    }
+
+    const ui64 numOps = static_cast<ui64>(NumEntities) * NumFrames;
+    BenchmarkTimer timer;
+    for (ui32 frame = 0; frame < NumFrames; ++frame) {
+        for (PointerEntity *entity : entityArray) {
+            entity->mComponent->update(dt);
+        }
+    }
+    report("ComponentStorage", "pointer per entity", numOps, timer.getMilliseconds());
+
+    timer.restart();
+    for (ui32 frame = 0; frame < NumFrames; ++frame) {
+        pool.forEach([dt](MotionComponent &component) {
+            component.update(dt);
+        });
+    }
+    report("ComponentStorage", "packed pool", numOps, timer.getMilliseconds());
+
+    const bool ownsJobSystem = nullptr == Threading::JobSystem::getInstance();
+    if (ownsJobSystem) {
+        Threading::JobSystem::create();
+    }
+    timer.restart();
+    for (ui32 frame = 0; frame < NumFrames; ++frame) {
+        pool.forEachParallel(1024, [dt](MotionComponent &component) {
+            component.update(dt);
+        });
+    }
+    const ui32 numWorkers = Threading::JobSystem::getInstance()->getNumWorkers();
+    report("ComponentStorage", "packed pool, " + std::to_string(numWorkers) + " workers", numOps, timer.getMilliseconds());
+    if (ownsJobSystem) {
+        Threading::JobSystem::destroy();
+    }
+
+    // Keep the results alive
+    f32 sum = 0.0f;
+    for (size_t i = 0; i < pool.size(); ++i) {
+        sum += pool.at(i).getPosition().y + entities[i]->mComponent->getPosition().y;
+    }
+    std::cout << "    checksum: " << sum << "\n";
+
+    for (auto &entity : entities) {
+        delete entity->mComponent;
+    }
+}
+
+} // namespace Benchmark
+} // namespace OSRE
@@ -0,0 +1,112 @@
+/*-----------------------------------------------------------------------------------------------
+The MIT License (MIT)
+
+Copyright (c) 2015-2022 OSRE ( Open Source Render Engine ) by Kim Kulling
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of
+this software and associated documentation files (the "Software"), to deal in
+the Software without restriction, including without limitation the rights to
+use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+the Software, and to permit persons to whom the Software is furnished to do so,
+subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+-----------------------------------------------------------------------------------------------*/
+#include "Benchmark.h"
+
+#include <osre/App/Node.h>
+#include <osre/Common/Ids.h>
+
+namespace OSRE {
+namespace Benchmark {
+
+using namespace ::OSRE::App;
+using namespace ::OSRE::Common;
+
+static const ui32 NumChains = 16;
+static const ui32 ChainDepth = 64;
+static const ui32 NumFrames = 100;
+static const ui32 QueriesPerFrame = 4;
+
+// Keeps the compiler from removing the query loops
+static volatile f32 Sink = 0.0f;
+
+// The former implementation, which walks up the parent chain on every query
+static glm::mat4 walkParents(const Node *node) {
+    glm::mat4 wt(1.0);
+    for (; node != nullptr; node = node->getParent()) {
+        wt = node->getTransformationMatrix() * wt;
+    }
+
+    return wt;
+}
+
+OSRE_BENCHMARK(NodeTransform) {
+    Ids ids;
+    Node *root = new Node("root", ids, nullptr);
+    std::vector<Node *> nodes;
+    std::vector<Node *> chainRoots;
+    for (ui32 i = 0; i < NumChains; ++i) {
+        Node *parent = root;
+        for (ui32 j = 0; j < ChainDepth; ++j) {
+            parent = parent->createChild("bone");
+            parent->translate(glm::vec3(0.0f, 0.1f, 0.0f));
+            nodes.push_back(parent);
+        }
+        chainRoots.push_back(root->getChildAt(i));
+    }
+
+    const ui64 numOps = static_cast<ui64>(nodes.size()) * NumFrames * QueriesPerFrame;
+    f32 sum = 0.0f;
+    BenchmarkTimer timer;
+    for (ui32 frame = 0; frame < NumFrames; ++frame) {
+        root->translate(glm::vec3(0.01f, 0.0f, 0.0f));
+        for (ui32 q = 0; q < QueriesPerFrame; ++q) {
+            for (const Node *node : nodes) {
+                sum += walkParents(node)[3].x;
+            }
+        }
+    }
+    report("NodeTransform", "parent walk, all moved", numOps, timer.getMilliseconds());
+
+    Node::NodeArray queue;
+    timer.restart();
+    for (ui32 frame = 0; frame < NumFrames; ++frame) {
+        root->translate(glm::vec3(0.01f, 0.0f, 0.0f));
+        root->updateWorldTransforms(queue);
+        for (ui32 q = 0; q < QueriesPerFrame; ++q) {
+            for (Node *node : nodes) {
+                sum += node->getWorlTransformMatrix()[3].x;
+            }
+        }
+    }
+    report("NodeTransform", "cached, all moved", numOps, timer.getMilliseconds());
+
+    // Only one chain moves per frame, like a single animated character
+    timer.restart();
+    for (ui32 frame = 0; frame < NumFrames; ++frame) {
+        chainRoots[frame % NumChains]->rotate(0.01f, glm::vec3(0.0f, 0.0f, 1.0f));
+        root->updateWorldTransforms(queue);
+        for (ui32 q = 0; q < QueriesPerFrame; ++q) {
+            for (Node *node : nodes) {
+                sum += node->getWorlTransformMatrix()[3].x;
+            }
+        }
+    }
+    report("NodeTransform", "cached, one chain moved", numOps, timer.getMilliseconds());
+
+    Sink = sum;
+    root->releaseChildren();
+    root->release();
+}
+
+} // namespace Benchmark
+} // namespace OSRE
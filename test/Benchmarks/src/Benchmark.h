@@ -0,0 +1,108 @@
+/*-----------------------------------------------------------------------------------------------
+The MIT License (MIT)
+
+Copyright (c) 2015-2022 OSRE ( Open Source Render Engine ) by Kim Kulling
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of
+this software and associated documentation files (the "Software"), to deal in
+the Software without restriction, including without limitation the rights to
+use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+the Software, and to permit persons to whom the Software is furnished to do so,
+subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+-----------------------------------------------------------------------------------------------*/
+#pragma once
+
+#include <osre/Common/osre_common.h>
+
+#include <chrono>
+#include <iostream>
+#include <vector>
+
+namespace OSRE {
+namespace Benchmark {
+
+/// @brief  The function type of a benchmark.
+using BenchmarkFunc = void (*)();
+
+//-------------------------------------------------------------------------------------------------
+///	@ingroup	Test
+///
+///	@brief  Stores all benchmarks, they will be registered by the OSRE_BENCHMARK macro.
+//-------------------------------------------------------------------------------------------------
+class BenchmarkRegistry {
+public:
+    struct Entry {
+        const c8 *m_name;
+        BenchmarkFunc m_func;
+    };
+
+    static std::vector<Entry> &getEntries() {
+        static std::vector<Entry> entries;
+        return entries;
+    }
+
+    static void add(const c8 *name, BenchmarkFunc func) {
+        Entry entry = { name, func };
+        getEntries().push_back(entry);
+    }
+};
+
+struct BenchmarkRegistrar {
+    BenchmarkRegistrar(const c8 *name, BenchmarkFunc func) {
+        BenchmarkRegistry::add(name, func);
+    }
+};
+
+//-------------------------------------------------------------------------------------------------
+///	@ingroup	Test
+///
+///	@brief  A simple wall-clock timer for measurements.
+//-------------------------------------------------------------------------------------------------
+class BenchmarkTimer {
+public:
+    BenchmarkTimer() :
+            m_start(std::chrono::high_resolution_clock::now()) {
+        // empty
+    }
+
+    void restart() {
+        m_start = std::chrono::high_resolution_clock::now();
+    }
+
+    d32 getMilliseconds() const {
+        const auto duration = std::chrono::high_resolution_clock::now() - m_start;
+        return std::chrono::duration<d32, std::milli>(duration).count();
+    }
+
+private:
+    std::chrono::high_resolution_clock::time_point m_start;
+};
+
+/// @brief  Prints one result line.
+/// @param  name        [in] The benchmark name.
+/// @param  variant     [in] The measured variant.
+/// @param  numOps      [in] The number of operations.
+/// @param  ms          [in] The measured time in milliseconds.
+inline void report(const c8 *name, const String &variant, ui64 numOps, d32 ms) {
+    const d32 nsPerOp = numOps > 0 ? (ms * 1000000.0) / static_cast<d32>(numOps) : 0.0;
+    std::cout << name << " / " << variant << ": " << ms << " ms, " << numOps << " ops, "
+              << nsPerOp << " ns/op\n";
+}
+
+} // Namespace Benchmark
+} // Namespace OSRE
+
+#define OSRE_BENCHMARK(name)                                                      \
+    static void name();                                                           \
+    static ::OSRE::Benchmark::BenchmarkRegistrar name##Registrar(#name, name);    \
+    static void name()
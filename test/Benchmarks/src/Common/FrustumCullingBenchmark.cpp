@@ -0,0 +1,90 @@
+/*-----------------------------------------------------------------------------------------------
+The MIT License (MIT)
+
+Copyright (c) 2015-2022 OSRE ( Open Source Render Engine ) by Kim Kulling
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of
+this software and associated documentation files (the "Software"), to deal in
+the Software without restriction, including without limitation the rights to
+use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+the Software, and to permit persons to whom the Software is furnished to do so,
+subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+-----------------------------------------------------------------------------------------------*/
+#include "Benchmark.h"
+
+#include <osre/Common/Frustum.h>
+#include <osre/Common/FrustumCuller.h>
+
+#include <cppcore/Container/TArray.h>
+
+#include <cmath>
+
+namespace OSRE {
+namespace Benchmark {
+
+using namespace ::OSRE::Common;
+
+static const ui32 NumBoxes = 100000;
+static const ui32 NumFrames = 100;
+
+static ui32 sSeed = 4711;
+
+static f32 random(f32 range) {
+    sSeed = sSeed * 1664525u + 1013904223u;
+    return static_cast<f32>(sSeed >> 8) / static_cast<f32>(1 << 24) * range - range * 0.5f;
+}
+
+OSRE_BENCHMARK(FrustumCulling) {
+    std::vector<AABB> boxes;
+    boxes.reserve(NumBoxes);
+    FrustumCuller culler;
+    for (ui32 i = 0; i < NumBoxes; ++i) {
+        const glm::vec3 min(random(400.0f), random(400.0f), random(400.0f));
+        boxes.push_back(AABB(min, min + glm::vec3(2.0f)));
+        culler.add(boxes.back());
+    }
+
+    // Turn the camera a bit every frame, so each frame sees another set of boxes
+    std::vector<Frustum> frustums(NumFrames);
+    const glm::mat4 projection = glm::perspective(1.2f, 16.0f / 9.0f, 0.1f, 200.0f);
+    for (ui32 i = 0; i < NumFrames; ++i) {
+        const f32 angle = static_cast<f32>(i) * 0.0628f;
+        const glm::vec3 dir(std::cos(angle), std::sin(angle), 0.0f);
+        frustums[i].extractFrom(projection * glm::lookAt(glm::vec3(0.0f), dir, glm::vec3(0, 0, 1)));
+    }
+
+    const ui64 numOps = static_cast<ui64>(NumBoxes) * NumFrames;
+    size_t numScalar = 0;
+    BenchmarkTimer timer;
+    for (const Frustum &frustum : frustums) {
+        for (const AABB &aabb : boxes) {
+            if (frustum.classify(aabb) != Frustum::Visibility::Outside) {
+                ++numScalar;
+            }
+        }
+    }
+    report("FrustumCulling", "scalar classify, AoS", numOps, timer.getMilliseconds());
+
+    size_t numBatched = 0;
+    CPPCore::TArray<ui32> visible;
+    timer.restart();
+    for (const Frustum &frustum : frustums) {
+        numBatched += culler.cull(frustum, visible);
+    }
+    report("FrustumCulling", "batched cull, SoA", numOps, timer.getMilliseconds());
+
+    std::cout << "    visible: " << numScalar << " / " << numBatched << "\n";
+}
+
+} // namespace Benchmark
+} // namespace OSRE
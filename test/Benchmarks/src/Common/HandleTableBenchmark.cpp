@@ -0,0 +1,105 @@
+/*-----------------------------------------------------------------------------------------------
+The MIT License (MIT)
+
+Copyright (c) 2015-2022 OSRE ( Open Source Render Engine ) by Kim Kulling
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of
+this software and associated documentation files (the "Software"), to deal in
+the Software without restriction, including without limitation the rights to
+use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+the Software, and to permit persons to whom the Software is furnished to do so,
+subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+-----------------------------------------------------------------------------------------------*/
+#include "Benchmark.h"
+
+#include <osre/Common/THandleTable.h>
+
+#include <cppcore/Container/TArray.h>
+
+namespace OSRE {
+namespace Benchmark {
+
+using namespace ::OSRE::Common;
+
+static const ui32 NumLookups = 1000000;
+static const ui32 MaxScanOps = 100000000;
+
+// Keeps the compiler from removing the lookup loops
+static volatile ui64 Sink = 0;
+
+// Stands in for a backend resource like a buffer or a texture
+struct DummyResource {
+    guid m_id;
+    ui32 m_value;
+};
+
+// A simple LCG, so every variant uses the same access pattern
+static ui32 nextIndex(ui32 &state, ui32 numResources) {
+    state = state * 1664525u + 1013904223u;
+    return (state >> 8) % numResources;
+}
+
+static void runLookups(ui32 numResources) {
+    CPPCore::TArray<DummyResource *> resources;
+    THandleTable<DummyResource *> table;
+    CPPCore::TArray<Handle> handles;
+    for (ui32 i = 0; i < numResources; ++i) {
+        DummyResource *res = new DummyResource;
+        res->m_id = i + 1;
+        res->m_value = i;
+        resources.add(res);
+        handles.add(table.add(res));
+    }
+
+    const String variant = std::to_string(numResources) + " resources";
+    ui64 sum = 0;
+
+    // The handle lookup, O(1)
+    ui32 state = 1;
+    BenchmarkTimer timer;
+    for (ui32 i = 0; i < NumLookups; ++i) {
+        DummyResource *const *res = table.get(handles[nextIndex(state, numResources)]);
+        sum += (*res)->m_value;
+    }
+    report("ResourceLookup", "handle table, " + variant, NumLookups, timer.getMilliseconds());
+
+    // The linear scan by id, like the lookups before the handle table, O(n)
+    const ui32 numScans = MaxScanOps / numResources < NumLookups ? MaxScanOps / numResources : NumLookups;
+    state = 1;
+    timer.restart();
+    for (ui32 i = 0; i < numScans; ++i) {
+        const guid id = nextIndex(state, numResources) + 1;
+        for (ui32 j = 0; j < resources.size(); ++j) {
+            if (resources[j]->m_id == id) {
+                sum += resources[j]->m_value;
+                break;
+            }
+        }
+    }
+    report("ResourceLookup", "linear scan, " + variant, numScans, timer.getMilliseconds());
+
+    for (ui32 i = 0; i < resources.size(); ++i) {
+        delete resources[i];
+    }
+    Sink = sum;
+}
+
+OSRE_BENCHMARK(ResourceLookup) {
+    runLookups(100);
+    runLookups(1000);
+    runLookups(10000);
+    runLookups(100000);
+}
+
+} // Namespace Benchmark
+} // Namespace OSRE
@@ -0,0 +1,125 @@
+/*-----------------------------------------------------------------------------------------------
+The MIT License (MIT)
+
+Copyright (c) 2015-2022 OSRE ( Open Source Render Engine ) by Kim Kulling
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of
+this software and associated documentation files (the "Software"), to deal in
+the Software without restriction, including without limitation the rights to
+use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+the Software, and to permit persons to whom the Software is furnished to do so,
+subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+-----------------------------------------------------------------------------------------------*/
+#include "Benchmark.h"
+
+#include <osre/Profiling/PerformanceCounterRegistry.h>
+#include <osre/Properties/Settings.h>
+#include <osre/RenderBackend/MaterialBuilder.h>
+#include <osre/RenderBackend/Mesh.h>
+#include <osre/RenderBackend/RenderBackendService.h>
+#include <osre/RenderBackend/RenderPass.h>
+
+#include <vector>
+
+namespace OSRE {
+namespace Benchmark {
+
+using namespace ::OSRE::Properties;
+using namespace ::OSRE::RenderBackend;
+
+static const ui32 NumUpdateFrames = 500;
+static const c8 *DynamicBatchName = "dynamic_batch";
+
+// Updates a part of a dynamic mesh every frame, with and without a marked dirty range.
+// The null back-end reports the uploaded bytes, so the numbers show the transfer volume per frame.
+static void runBufferUpdate(ui32 numVertices, ui32 numModified, bool useDirtyRange) {
+    Settings *settings = new Settings;
+    settings->setString(Settings::RenderAPI, "null");
+
+    RenderBackendService *rbSrv = new RenderBackendService;
+    rbSrv->setSettings(settings, true);
+    if (!rbSrv->open()) {
+        std::cout << "Cannot open the render back-end.\n";
+        rbSrv->release();
+        return;
+    }
+
+    CreateRendererEventData *data = new CreateRendererEventData(nullptr);
+    data->m_pipeline = rbSrv->createDefaultPipeline();
+    rbSrv->sendEvent(&OnCreateRendererEvent, data);
+
+    std::vector<RenderVert> vertices(numVertices);
+    Mesh *mesh = new Mesh("dynamic", VertexType::RenderVertex, IndexType::UnsignedInt);
+    mesh->createVertexBuffer(&vertices[0], sizeof(RenderVert) * numVertices, BufferAccessType::ReadWrite);
+    mesh->addPrimitiveGroup(numVertices, PrimitiveType::PointList, 0);
+
+    const c8 *passName = RenderPass::getPassNameById(RenderPassId);
+    rbSrv->beginPass(passName);
+    rbSrv->beginRenderBatch(DynamicBatchName);
+    rbSrv->addMesh(mesh, 0);
+    rbSrv->endRenderBatch();
+    rbSrv->endPass();
+    rbSrv->update();
+
+    ui64 uploadedBytes = 0;
+    BenchmarkTimer timer;
+    for (ui32 frame = 0; frame < NumUpdateFrames; ++frame) {
+        // Move a window of vertices through the buffer
+        const ui32 first = (frame * numModified) % (numVertices - numModified + 1);
+        RenderVert *verts = reinterpret_cast<RenderVert *>(mesh->getVertexBuffer()->getData());
+        for (ui32 i = first; i < first + numModified; ++i) {
+            verts[i].position.y = static_cast<f32>(frame);
+        }
+        if (useDirtyRange) {
+            mesh->markVertexRangeDirty(sizeof(RenderVert) * first, sizeof(RenderVert) * numModified);
+        }
+
+        rbSrv->beginPass(passName);
+        rbSrv->beginRenderBatch(DynamicBatchName);
+        rbSrv->updateMesh(mesh);
+        rbSrv->endRenderBatch();
+        rbSrv->endPass();
+        rbSrv->update();
+        rbSrv->syncRenderThread();
+
+        ui32 frameBytes = 0;
+        Profiling::PerformanceCounterRegistry::queryCounter("uploadBytes", frameBytes);
+        uploadedBytes += frameBytes;
+    }
+    const d32 ms = timer.getMilliseconds();
+
+    const String variant = std::to_string(numModified) + " of " + std::to_string(numVertices) + " vertices, " +
+                           (useDirtyRange ? "dirty range" : "full buffer");
+    report("BufferUpdate", variant, NumUpdateFrames, ms);
+
+    const d32 mb = static_cast<d32>(uploadedBytes) / (1024.0 * 1024.0);
+    std::cout << "    per frame: " << (uploadedBytes / NumUpdateFrames) << " bytes uploaded, "
+              << (ms > 0.0 ? mb / (ms / 1000.0) : 0.0) << " MB/s\n";
+
+    rbSrv->sendEvent(&OnDestroyRendererEvent, nullptr);
+    rbSrv->close();
+    rbSrv->release();
+    delete mesh;
+}
+
+OSRE_BENCHMARK(BufferUpdate) {
+    MaterialBuilder::create();
+    runBufferUpdate(65536, 256, false);
+    runBufferUpdate(65536, 256, true);
+    runBufferUpdate(65536, 16384, false);
+    runBufferUpdate(65536, 16384, true);
+    MaterialBuilder::destroy();
+}
+
+} // Namespace Benchmark
+} // Namespace OSRE
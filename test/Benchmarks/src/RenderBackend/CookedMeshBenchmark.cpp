@@ -0,0 +1,122 @@
+/*-----------------------------------------------------------------------------------------------
+The MIT License (MIT)
+
+Copyright (c) 2015-2022 OSRE ( Open Source Render Engine ) by Kim Kulling
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of
+this software and associated documentation files (the "Software"), to deal in
+the Software without restriction, including without limitation the rights to
+use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+the Software, and to permit persons to whom the Software is furnished to do so,
+subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+-----------------------------------------------------------------------------------------------*/
+#include "Benchmark.h"
+
+#include <osre/RenderBackend/CookedMesh.h>
+#include <osre/RenderBackend/Mesh.h>
+#include "src/Engine/IO/FileStream.h"
+#include "src/Engine/IO/MappedFileStream.h"
+
+#include <cstdio>
+
+namespace OSRE {
+namespace Benchmark {
+
+using namespace ::OSRE::RenderBackend;
+using namespace ::OSRE::IO;
+
+static const ui32 NumVertices = 1000000;
+static const ui32 NumRuns = 10;
+
+// The imported streams as the importer gets them, one array per attribute
+struct SourceMesh {
+    std::vector<glm::vec3> mPositions;
+    std::vector<glm::vec3> mNormals;
+    std::vector<glm::vec2> mTexCoords;
+    std::vector<ui32> mIndices;
+};
+
+// Converts like AssimpWrapper::importMeshes, vertex by vertex into RenderVert
+static Mesh *convertPerVertex(const SourceMesh &source) {
+    Mesh *mesh = new Mesh("converted", VertexType::RenderVertex, IndexType::UnsignedInt);
+    std::vector<RenderVert> vertices(source.mPositions.size());
+    Common::AABB aabb;
+    for (size_t i = 0; i < vertices.size(); ++i) {
+        vertices[i].position = source.mPositions[i];
+        vertices[i].normal = source.mNormals[i];
+        vertices[i].tex0 = source.mTexCoords[i];
+        aabb.merge(source.mPositions[i].x, source.mPositions[i].y, source.mPositions[i].z);
+    }
+    mesh->createVertexBuffer(vertices.data(), vertices.size() * sizeof(RenderVert), BufferAccessType::ReadOnly);
+    std::vector<ui32> indices(source.mIndices);
+    mesh->createIndexBuffer(indices.data(), indices.size() * sizeof(ui32), IndexType::UnsignedInt, BufferAccessType::ReadOnly);
+    mesh->addPrimitiveGroup(indices.size(), PrimitiveType::TriangleList, 0);
+    mesh->setAABB(aabb);
+
+    return mesh;
+}
+
+OSRE_BENCHMARK(CookedMesh) {
+    SourceMesh source;
+    for (ui32 i = 0; i < NumVertices; ++i) {
+        const f32 x = static_cast<f32>(i % 1000), y = static_cast<f32>(i / 1000);
+        source.mPositions.push_back(glm::vec3(x, y, 0.0f));
+        source.mNormals.push_back(glm::vec3(0.0f, 0.0f, 1.0f));
+        source.mTexCoords.push_back(glm::vec2(x / 1000.0f, y / 1000.0f));
+        source.mIndices.push_back(i);
+    }
+
+    BenchmarkTimer timer;
+    MeshArray meshes;
+    for (ui32 i = 0; i < NumRuns; ++i) {
+        delete convertPerVertex(source);
+    }
+    report("CookedMesh", "per-vertex conversion", static_cast<ui64>(NumVertices) * NumRuns, timer.getMilliseconds());
+
+    const Uri uri("file://./CookedMeshBenchmark.osmc");
+    meshes.add(convertPerVertex(source));
+    FileStream writer(uri, Stream::AccessMode::WriteAccessBinary);
+    if (!writer.open() || !CookedMesh::save(meshes, writer)) {
+        std::cout << "    cannot write " << uri.getAbsPath() << "\n";
+        delete meshes[0];
+        return;
+    }
+    writer.close();
+    delete meshes[0];
+    meshes.clear();
+
+    timer.restart();
+    for (ui32 i = 0; i < NumRuns; ++i) {
+        FileStream reader(uri, Stream::AccessMode::ReadAccessBinary);
+        reader.open();
+        CookedMesh::load(reader, meshes);
+        delete meshes[0];
+        meshes.clear();
+    }
+    report("CookedMesh", "cooked, read", static_cast<ui64>(NumVertices) * NumRuns, timer.getMilliseconds());
+
+    timer.restart();
+    for (ui32 i = 0; i < NumRuns; ++i) {
+        MappedFileStream mapped(uri);
+        mapped.open();
+        CookedMesh::load(mapped, meshes);
+        delete meshes[0];
+        meshes.clear();
+    }
+    report("CookedMesh", "cooked, mapped", static_cast<ui64>(NumVertices) * NumRuns, timer.getMilliseconds());
+
+    ::remove("./CookedMeshBenchmark.osmc");
+}
+
+} // namespace Benchmark
+} // namespace OSRE
@@ -0,0 +1,106 @@
+/*-----------------------------------------------------------------------------------------------
+The MIT License (MIT)
+
+Copyright (c) 2015-2022 OSRE ( Open Source Render Engine ) by Kim Kulling
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of
+this software and associated documentation files (the "Software"), to deal in
+the Software without restriction, including without limitation the rights to
+use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+the Software, and to permit persons to whom the Software is furnished to do so,
+subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+-----------------------------------------------------------------------------------------------*/
+#include "Benchmark.h"
+
+#include <osre/RenderBackend/CookedTexture.h>
+#include <osre/RenderBackend/TextureCompression.h>
+#include "src/Engine/IO/FileStream.h"
+#include "src/Engine/IO/MappedFileStream.h"
+
+#include <cstdio>
+#include <cstdlib>
+
+namespace OSRE {
+namespace Benchmark {
+
+using namespace ::OSRE::RenderBackend;
+using namespace ::OSRE::IO;
+
+static const ui32 TextureSize = 1024;
+static const ui32 NumRuns = 10;
+
+// Builds the mip chain at load time, as it happens for images without a cooked chain
+static size_t buildMipChain(const std::vector<uc8> &pixels, std::vector<uc8> &chain) {
+    chain.assign(pixels.begin(), pixels.end());
+    ui32 width = TextureSize, height = TextureSize;
+    size_t offset = 0;
+    while (width > 1 || height > 1) {
+        const ui32 nextWidth = width > 1 ? width / 2 : 1, nextHeight = height > 1 ? height / 2 : 1;
+        const size_t levelSize = static_cast<size_t>(width) * height * 4;
+        chain.resize(offset + levelSize + static_cast<size_t>(nextWidth) * nextHeight * 4);
+        TextureCompression::downsample(&chain[offset], width, height, 4, &chain[offset + levelSize]);
+        offset += levelSize;
+        width = nextWidth;
+        height = nextHeight;
+    }
+
+    return chain.size();
+}
+
+static void benchmarkCooked(const std::vector<uc8> &pixels, PixelFormatType format, const c8 *variant, const c8 *file) {
+    const Uri uri(String("file://./") + file);
+    FileStream writer(uri, Stream::AccessMode::WriteAccessBinary);
+    if (!writer.open() || !CookedTexture::cook(pixels.data(), TextureSize, TextureSize, 4, format, writer)) {
+        std::cout << "    cannot write " << uri.getAbsPath() << "\n";
+        return;
+    }
+    writer.close();
+
+    BenchmarkTimer timer;
+    size_t uploadSize = 0;
+    for (ui32 i = 0; i < NumRuns; ++i) {
+        Texture tex;
+        MappedFileStream mapped(uri);
+        mapped.open();
+        CookedTexture::load(mapped, tex);
+        uploadSize = tex.m_size;
+        ::free(tex.m_data);
+        tex.m_data = nullptr;
+    }
+    report("CookedTexture", variant, static_cast<ui64>(TextureSize) * TextureSize * NumRuns, timer.getMilliseconds());
+    std::cout << "    upload size: " << uploadSize << " bytes\n";
+
+    ::remove((String("./") + file).c_str());
+}
+
+OSRE_BENCHMARK(CookedTexture) {
+    std::vector<uc8> pixels(static_cast<size_t>(TextureSize) * TextureSize * 4);
+    for (size_t i = 0; i < pixels.size(); ++i) {
+        pixels[i] = static_cast<uc8>((i / 4 % TextureSize + i / 4 / TextureSize * (i % 4 + 1)) & 0xff);
+    }
+
+    BenchmarkTimer timer;
+    std::vector<uc8> chain;
+    size_t uploadSize = 0;
+    for (ui32 i = 0; i < NumRuns; ++i) {
+        uploadSize = buildMipChain(pixels, chain);
+    }
+    report("CookedTexture", "RGBA, mips at load", static_cast<ui64>(TextureSize) * TextureSize * NumRuns, timer.getMilliseconds());
+    std::cout << "    upload size: " << uploadSize << " bytes\n";
+
+    benchmarkCooked(pixels, PixelFormatType::BC1, "cooked BC1, mapped", "CookedTextureBenchmark_bc1.ostc");
+    benchmarkCooked(pixels, PixelFormatType::BC3, "cooked BC3, mapped", "CookedTextureBenchmark_bc3.ostc");
+}
+
+} // namespace Benchmark
+} // namespace OSRE
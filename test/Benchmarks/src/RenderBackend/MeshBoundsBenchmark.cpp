@@ -0,0 +1,120 @@
+/*-----------------------------------------------------------------------------------------------
+The MIT License (MIT)
+
+Copyright (c) 2015-2022 OSRE ( Open Source Render Engine ) by Kim Kulling
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of
+this software and associated documentation files (the "Software"), to deal in
+the Software without restriction, including without limitation the rights to
+use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+the Software, and to permit persons to whom the Software is furnished to do so,
+subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+-----------------------------------------------------------------------------------------------*/
+#include "Benchmark.h"
+
+#include <osre/RenderBackend/Mesh.h>
+#include <osre/RenderBackend/MeshProcessor.h>
+
+#include <cstring>
+#include <vector>
+
+namespace OSRE {
+namespace Benchmark {
+
+using namespace ::OSRE::Common;
+using namespace ::OSRE::RenderBackend;
+
+static const ui32 NumBoundsRuns = 20;
+
+static void fillVertices(std::vector<RenderVert> &vertices) {
+    for (size_t i = 0; i < vertices.size(); ++i) {
+        const f32 t = static_cast<f32>(i);
+        vertices[i].position = glm::vec3(t * 0.001f, -t * 0.002f, static_cast<f32>(i % 113));
+    }
+}
+
+// The former per-vertex loop, copies every position and merges it component by component.
+static void scalarBounds(const std::vector<RenderVert> &vertices, AABB &aabb) {
+    const uc8 *ptr = reinterpret_cast<const uc8 *>(&vertices[0]);
+    size_t offset = 0;
+    for (size_t i = 0; i < vertices.size(); ++i) {
+        glm::vec3 pos;
+        ::memcpy(&pos.x, &ptr[offset], sizeof(glm::vec3));
+        offset += sizeof(RenderVert);
+        aabb.merge(pos.x, pos.y, pos.z);
+    }
+}
+
+static void runBoundsReduction(size_t numVertices) {
+    std::vector<RenderVert> vertices(numVertices);
+    fillVertices(vertices);
+
+    AABB scalar;
+    BenchmarkTimer timer;
+    for (ui32 run = 0; run < NumBoundsRuns; ++run) {
+        scalar.reset();
+        scalarBounds(vertices, scalar);
+    }
+    report("MeshBounds", std::to_string(numVertices) + " vertices, scalar", NumBoundsRuns * numVertices, timer.getMilliseconds());
+
+    AABB wide;
+    timer.restart();
+    for (ui32 run = 0; run < NumBoundsRuns; ++run) {
+        wide.reset();
+        MeshProcessor::computeAABB(reinterpret_cast<const uc8 *>(&vertices[0]), numVertices, sizeof(RenderVert), wide);
+    }
+    report("MeshBounds", std::to_string(numVertices) + " vertices, vectorized", NumBoundsRuns * numVertices, timer.getMilliseconds());
+
+    if (scalar != wide) {
+        std::cout << "    results differ!\n";
+    }
+}
+
+// Simulates the world update of a static scene, the boxes are only computed in the first run.
+static void runCachedBounds(ui32 numMeshes, size_t numVertices) {
+    std::vector<RenderVert> vertices(numVertices);
+    fillVertices(vertices);
+    std::vector<Mesh *> meshes;
+    for (ui32 i = 0; i < numMeshes; ++i) {
+        Mesh *mesh = new Mesh("static", VertexType::RenderVertex, IndexType::UnsignedShort);
+        mesh->createVertexBuffer(&vertices[0], sizeof(RenderVert) * numVertices, BufferAccessType::ReadOnly);
+        meshes.push_back(mesh);
+    }
+
+    BenchmarkTimer timer;
+    for (ui32 run = 0; run < NumBoundsRuns; ++run) {
+        MeshProcessor processor;
+        for (Mesh *mesh : meshes) {
+            processor.addMesh(mesh);
+        }
+        processor.execute();
+        if (0 == run) {
+            report("MeshBounds", std::to_string(numMeshes) + " meshes, first update", numMeshes, timer.getMilliseconds());
+            timer.restart();
+        }
+    }
+    report("MeshBounds", std::to_string(numMeshes) + " meshes, cached updates", (NumBoundsRuns - 1) * numMeshes, timer.getMilliseconds());
+
+    for (Mesh *mesh : meshes) {
+        delete mesh;
+    }
+}
+
+OSRE_BENCHMARK(MeshBounds) {
+    runBoundsReduction(4096);
+    runBoundsReduction(1024 * 1024);
+    runCachedBounds(1000, 4096);
+}
+
+} // Namespace Benchmark
+} // Namespace OSRE
@@ -0,0 +1,119 @@
+/*-----------------------------------------------------------------------------------------------
+The MIT License (MIT)
+
+Copyright (c) 2015-2022 OSRE ( Open Source Render Engine ) by Kim Kulling
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of
+this software and associated documentation files (the "Software"), to deal in
+the Software without restriction, including without limitation the rights to
+use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+the Software, and to permit persons to whom the Software is furnished to do so,
+subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+-----------------------------------------------------------------------------------------------*/
+#include "Benchmark.h"
+
+#include <osre/Profiling/PerformanceCounterRegistry.h>
+#include <osre/Properties/Settings.h>
+#include <osre/RenderBackend/MaterialBuilder.h>
+#include <osre/RenderBackend/Mesh.h>
+#include <osre/RenderBackend/MeshBuilder.h>
+#include <osre/RenderBackend/RenderBackendService.h>
+#include <osre/RenderBackend/RenderPass.h>
+
+#include <vector>
+
+namespace OSRE {
+namespace Benchmark {
+
+using namespace ::OSRE::Properties;
+using namespace ::OSRE::RenderBackend;
+
+static const ui32 NumFrames = 1000;
+
+// Runs the complete submission path against the null back-end, so only engine time is measured
+static void runSubmitPath(ui32 numBatches, i32 framesInFlight) {
+    Settings *settings = new Settings;
+    settings->setString(Settings::RenderAPI, "null");
+    settings->setInt(Settings::FramesInFlight, framesInFlight);
+
+    RenderBackendService *rbSrv = new RenderBackendService;
+    rbSrv->setSettings(settings, true);
+    if (!rbSrv->open()) {
+        std::cout << "Cannot open the render back-end.\n";
+        rbSrv->release();
+        return;
+    }
+
+    CreateRendererEventData *data = new CreateRendererEventData(nullptr);
+    data->m_pipeline = rbSrv->createDefaultPipeline();
+    rbSrv->sendEvent(&OnCreateRendererEvent, data);
+
+    // The batch ids must stay alive as long as the passes
+    std::vector<String> batchIds;
+    for (ui32 i = 0; i < numBatches; ++i) {
+        batchIds.push_back("batch_" + std::to_string(i));
+    }
+
+    const c8 *passName = RenderPass::getPassNameById(RenderPassId);
+    rbSrv->beginPass(passName);
+    for (ui32 i = 0; i < numBatches; ++i) {
+        MeshBuilder meshBuilder;
+        meshBuilder.allocCube(VertexType::RenderVertex, 1, 1, 1, BufferAccessType::ReadOnly);
+        rbSrv->beginRenderBatch(batchIds[i].c_str());
+        rbSrv->addMesh(meshBuilder.getMesh(), 0);
+        rbSrv->endRenderBatch();
+    }
+    rbSrv->endPass();
+
+    glm::mat4 model(1.0f);
+    BenchmarkTimer timer;
+    for (ui32 frame = 0; frame < NumFrames; ++frame) {
+        rbSrv->beginPass(passName);
+        for (ui32 i = 0; i < numBatches; ++i) {
+            rbSrv->beginRenderBatch(batchIds[i].c_str());
+            model[3][0] = static_cast<f32>(frame);
+            rbSrv->setMatrix(MatrixType::Model, model);
+            rbSrv->endRenderBatch();
+        }
+        rbSrv->endPass();
+        rbSrv->update();
+    }
+    rbSrv->syncRenderThread();
+    const d32 ms = timer.getMilliseconds();
+
+    const String variant = std::to_string(numBatches) + " batches, " + std::to_string(framesInFlight) + " frames in flight";
+    report("SubmitPath", variant, NumFrames, ms);
+
+    ui32 drawCalls = 0, uploadBytes = 0, stateChanges = 0;
+    Profiling::PerformanceCounterRegistry::queryCounter("drawCalls", drawCalls);
+    Profiling::PerformanceCounterRegistry::queryCounter("uploadBytes", uploadBytes);
+    Profiling::PerformanceCounterRegistry::queryCounter("stateChanges", stateChanges);
+    std::cout << "    per frame: " << drawCalls << " draw calls, " << uploadBytes << " bytes uploaded, "
+              << stateChanges << " state changes\n";
+
+    rbSrv->sendEvent(&OnDestroyRendererEvent, nullptr);
+    rbSrv->close();
+    rbSrv->release();
+}
+
+OSRE_BENCHMARK(SubmitPath) {
+    MaterialBuilder::create();
+    runSubmitPath(10, 1);
+    runSubmitPath(100, 1);
+    runSubmitPath(1000, 1);
+    runSubmitPath(1000, 2);
+    MaterialBuilder::destroy();
+}
+
+} // Namespace Benchmark
+} // Namespace OSRE
@@ -0,0 +1,114 @@
+/*-----------------------------------------------------------------------------------------------
+The MIT License (MIT)
+
+Copyright (c) 2015-2022 OSRE ( Open Source Render Engine ) by Kim Kulling
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of
+this software and associated documentation files (the "Software"), to deal in
+the Software without restriction, including without limitation the rights to
+use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+the Software, and to permit persons to whom the Software is furnished to do so,
+subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+-----------------------------------------------------------------------------------------------*/
+#include "Benchmark.h"
+
+#include <osre/Threading/JobSystem.h>
+
+#include <atomic>
+#include <cmath>
+#include <thread>
+
+namespace OSRE {
+namespace Benchmark {
+
+using namespace ::OSRE::Threading;
+
+static const ui32 NumBatches = 100;
+static const ui32 JobsPerBatch = 1000;
+
+static void emptyJob(void *) {
+    // empty
+}
+
+static d32 work(size_t begin, size_t end) {
+    d32 sum = 0.0;
+    for (size_t i = begin; i < end; ++i) {
+        sum += std::sqrt(static_cast<d32>(i));
+    }
+    return sum;
+}
+
+OSRE_BENCHMARK(JobSpawn) {
+    JobSystem jobSystem;
+    BenchmarkTimer timer;
+    for (ui32 i = 0; i < NumBatches; ++i) {
+        JobHandle root = jobSystem.createJob(nullptr, nullptr);
+        for (ui32 j = 0; j < JobsPerBatch; ++j) {
+            jobSystem.run(jobSystem.createChildJob(root, emptyJob, nullptr));
+        }
+        jobSystem.run(root);
+        jobSystem.waitFor(root);
+    }
+    report("JobSpawn", "JobSystem, " + std::to_string(jobSystem.getNumWorkers()) + " workers", NumBatches * JobsPerBatch, timer.getMilliseconds());
+}
+
+OSRE_BENCHMARK(ParallelFor) {
+    static const size_t Count = 4 * 1024 * 1024;
+    static const ui32 NumRuns = 20;
+
+    // Keep the results alive, so the work is not optimized away
+    d32 result = 0.0;
+    {
+        BenchmarkTimer timer;
+        for (ui32 i = 0; i < NumRuns; ++i) {
+            result += work(0, Count);
+        }
+        report("ParallelFor", "serial", NumRuns * Count, timer.getMilliseconds());
+    }
+    {
+        const ui32 numThreads = std::thread::hardware_concurrency() > 0 ? std::thread::hardware_concurrency() : 1;
+        BenchmarkTimer timer;
+        for (ui32 i = 0; i < NumRuns; ++i) {
+            std::vector<d32> sums(numThreads, 0.0);
+            std::vector<std::thread> threads;
+            const size_t chunk = Count / numThreads;
+            for (ui32 t = 0; t < numThreads; ++t) {
+                const size_t end = t + 1 == numThreads ? Count : (t + 1) * chunk;
+                threads.push_back(std::thread([&sums, t, chunk, end]() {
+                    sums[t] = work(t * chunk, end);
+                }));
+            }
+            for (ui32 t = 0; t < numThreads; ++t) {
+                threads[t].join();
+                result += sums[t];
+            }
+        }
+        report("ParallelFor", "thread per run", NumRuns * Count, timer.getMilliseconds());
+    }
+    {
+        JobSystem jobSystem;
+        BenchmarkTimer timer;
+        for (ui32 i = 0; i < NumRuns; ++i) {
+            std::atomic<i64> sum(0);
+            jobSystem.parallelFor(Count, 64 * 1024, [&sum](size_t begin, size_t end) {
+                sum.fetch_add(static_cast<i64>(work(begin, end)));
+            });
+            result += static_cast<d32>(sum.load());
+        }
+        report("ParallelFor", "JobSystem", NumRuns * Count, timer.getMilliseconds());
+    }
+    std::cout << "    checksum: " << result << "\n";
+}
+
+} // Namespace Benchmark
+} // Namespace OSRE
@@ -0,0 +1,207 @@
+/*-----------------------------------------------------------------------------------------------
+The MIT License (MIT)
+
+Copyright (c) 2015-2022 OSRE ( Open Source Render Engine ) by Kim Kulling
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of
+this software and associated documentation files (the "Software"), to deal in
+the Software without restriction, including without limitation the rights to
+use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+the Software, and to permit persons to whom the Software is furnished to do so,
+subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+-----------------------------------------------------------------------------------------------*/
+#include "Benchmark.h"
+
+#include <osre/Threading/TAsyncQueue.h>
+#include <osre/Threading/TLockFreeQueue.h>
+
+#include <atomic>
+#include <thread>
+
+namespace OSRE {
+namespace Benchmark {
+
+using namespace ::OSRE::Threading;
+
+static const ui32 NumItems = 1000000;
+static const ui32 NumProducers = 4;
+
+// Adapter to drive both queues with the same consumer loop
+struct AsyncQueueAdapter {
+    TAsyncQueue<ui32> m_queue;
+
+    void enqueue(ui32 item) {
+        m_queue.enqueue(item);
+    }
+
+    bool tryDequeue(ui32 &item) {
+        if (m_queue.isEmpty()) {
+            return false;
+        }
+        item = m_queue.dequeue();
+        return true;
+    }
+
+    void await() {
+        m_queue.awaitEnqueuedItem();
+    }
+
+    void wakeup() {
+        m_queue.signalEnqueuedItem();
+    }
+};
+
+struct LockFreeQueueAdapter {
+    TLockFreeQueue<ui32> m_queue;
+
+    explicit LockFreeQueueAdapter(QueueMode mode) :
+            m_queue(1024, mode) {
+        // empty
+    }
+
+    void enqueue(ui32 item) {
+        m_queue.enqueue(item);
+    }
+
+    bool tryDequeue(ui32 &item) {
+        return m_queue.tryDequeue(item);
+    }
+
+    void await() {
+        m_queue.awaitEnqueuedItem();
+    }
+
+    void wakeup() {
+        m_queue.signalEnqueuedItem();
+    }
+};
+
+template <class Queue>
+static d32 runThroughput(Queue &queue, ui32 numProducers) {
+    const ui32 itemsPerProducer = NumItems / numProducers;
+    std::atomic<bool> done(false);
+
+    BenchmarkTimer timer;
+    std::vector<std::thread> producers;
+    for (ui32 i = 0; i < numProducers; ++i) {
+        producers.push_back(std::thread([&queue, itemsPerProducer]() {
+            for (ui32 j = 0; j < itemsPerProducer; ++j) {
+                queue.enqueue(j);
+            }
+        }));
+    }
+
+    // The condition-variable based queue may miss a wakeup, so keep on poking the consumer
+    std::thread waker([&queue, &done]() {
+        while (!done.load()) {
+            queue.wakeup();
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+    });
+
+    ui32 received = 0, item = 0;
+    const ui32 expected = itemsPerProducer * numProducers;
+    while (received < expected) {
+        queue.await();
+        while (queue.tryDequeue(item)) {
+            ++received;
+        }
+    }
+    const d32 ms = timer.getMilliseconds();
+
+    done.store(true);
+    waker.join();
+    for (std::thread &producer : producers) {
+        producer.join();
+    }
+
+    return ms;
+}
+
+template <class Queue>
+static void runPingPong(const c8 *name, const String &variant, Queue &request, Queue &response) {
+    static const ui32 NumRoundTrips = 20000;
+    std::atomic<bool> done(false);
+    std::thread waker([&request, &response, &done]() {
+        while (!done.load()) {
+            request.wakeup();
+            response.wakeup();
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+    });
+    std::thread consumer([&request, &response, &done]() {
+        ui32 item = 0;
+        while (!done.load()) {
+            request.await();
+            while (request.tryDequeue(item)) {
+                response.enqueue(item);
+            }
+        }
+    });
+
+    d32 maxMs = 0.0;
+    BenchmarkTimer total;
+    for (ui32 i = 0; i < NumRoundTrips; ++i) {
+        BenchmarkTimer timer;
+        request.enqueue(i);
+        ui32 item = 0;
+        while (!response.tryDequeue(item)) {
+            response.await();
+        }
+        const d32 ms = timer.getMilliseconds();
+        maxMs = ms > maxMs ? ms : maxMs;
+    }
+    report(name, variant + " round trip", NumRoundTrips, total.getMilliseconds());
+    std::cout << "    worst round trip: " << maxMs * 1000.0 << " us\n";
+
+    done.store(true);
+    request.enqueue(0);
+    consumer.join();
+    waker.join();
+}
+
+OSRE_BENCHMARK(TaskQueueSPSC) {
+    {
+        AsyncQueueAdapter queue;
+        report("TaskQueueSPSC", "TAsyncQueue", NumItems, runThroughput(queue, 1));
+    }
+    {
+        LockFreeQueueAdapter queue(QueueMode::SPSC);
+        report("TaskQueueSPSC", "TLockFreeQueue", NumItems, runThroughput(queue, 1));
+    }
+}
+
+OSRE_BENCHMARK(TaskQueueMPSC) {
+    {
+        AsyncQueueAdapter queue;
+        report("TaskQueueMPSC", "TAsyncQueue", NumItems, runThroughput(queue, NumProducers));
+    }
+    {
+        LockFreeQueueAdapter queue(QueueMode::MPSC);
+        report("TaskQueueMPSC", "TLockFreeQueue", NumItems, runThroughput(queue, NumProducers));
+    }
+}
+
+OSRE_BENCHMARK(TaskQueueHandoff) {
+    {
+        AsyncQueueAdapter request, response;
+        runPingPong("TaskQueueHandoff", "TAsyncQueue", request, response);
+    }
+    {
+        LockFreeQueueAdapter request(QueueMode::SPSC), response(QueueMode::SPSC);
+        runPingPong("TaskQueueHandoff", "TLockFreeQueue", request, response);
+    }
+}
+
+} // Namespace Benchmark
+} // Namespace OSRE
@@ -0,0 +1,48 @@
+/*-----------------------------------------------------------------------------------------------
+The MIT License (MIT)
+
+Copyright (c) 2015-2022 OSRE ( Open Source Render Engine ) by Kim Kulling
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of
+this software and associated documentation files (the "Software"), to deal in
+the Software without restriction, including without limitation the rights to
+use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+the Software, and to permit persons to whom the Software is furnished to do so,
+subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+-----------------------------------------------------------------------------------------------*/
+#include "Benchmark.h"
+
+#include <osre/Common/ArgumentParser.h>
+
+#include <cstring>
+
+using namespace ::OSRE;
+using namespace ::OSRE::Benchmark;
+
+int main(int argc, char *argv[]) {
+    Common::ArgumentParser argParser(argc, (const char **)argv, "test", "A dedicated benchmark");
+    String test = "";
+    if (argParser.hasArgument("test")) {
+        test = argParser.getArgument("test");
+    }
+
+    for (const BenchmarkRegistry::Entry &entry : BenchmarkRegistry::getEntries()) {
+        if (!test.empty() && nullptr == ::strstr(entry.m_name, test.c_str())) {
+            continue;
+        }
+        std::cout << "Running " << entry.m_name << "\n";
+        entry.m_func();
+    }
+
+    return 0;
+}
@@ -128,6 +128,7 @@ public:
                 TextureResource *texRes = new TextureResource("SpiderTex", IO::Uri("file://assets/Models/Obj/SpiderTex.jpg"));
                 texResArray.add(texRes);
                 Material *material = MaterialBuilder::createTexturedMaterial("SpiderTex", texResArray, VsSrc, FsSrc);
+                delete texRes;
                 mesh->setMaterial(material);
                 Shader *shader = material->getShader();
                 if (shader != nullptr) {
@@ -0,0 +1,110 @@
+/*-----------------------------------------------------------------------------------------------
+The MIT License (MIT)
+
+Copyright (c) 2015-2022 OSRE ( Open Source Render Engine ) by Kim Kulling
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of
+this software and associated documentation files (the "Software"), to deal in
+the Software without restriction, including without limitation the rights to
+use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+the Software, and to permit persons to whom the Software is furnished to do so,
+subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+-----------------------------------------------------------------------------------------------*/
+#include "osre_testcommon.h"
+#include <osre/Animation/Skinning.h>
+
+namespace OSRE {
+namespace UnitTest {
+
+using namespace ::OSRE::Animation;
+
+class SkinningTest : public ::testing::Test {
+protected:
+    static ui32 sumWeights(const VertexInfluence &influence) {
+        ui32 sum = 0;
+        for (ui32 i = 0; i < MaxBoneInfluences; ++i) {
+            sum += influence.mWeights[i];
+        }
+
+        return sum;
+    }
+};
+
+TEST_F(SkinningTest, buildInfluencesTest) {
+    VertexInfluenceBuilder builder;
+    builder.reset(3);
+    EXPECT_EQ(3u, builder.getNumVertices());
+
+    VertexWeight bone0[] = { { 0, 1.0f }, { 1, 0.25f } };
+    VertexWeight bone1[] = { { 1, 0.75f } };
+    EXPECT_TRUE(builder.addBone(0, bone0, 2, 0));
+    EXPECT_TRUE(builder.addBone(7, bone1, 1, 0));
+
+    VertexInfluenceArray influences;
+    builder.build(influences);
+    ASSERT_EQ(3u, influences.size());
+
+    EXPECT_EQ(0u, influences[0].mBoneIndices[0]);
+    EXPECT_EQ(255u, influences[0].mWeights[0]);
+    EXPECT_EQ(255u, sumWeights(influences[0]));
+
+    // The strongest influence comes first
+    EXPECT_EQ(7u, influences[1].mBoneIndices[0]);
+    EXPECT_EQ(0u, influences[1].mBoneIndices[1]);
+    EXPECT_EQ(191u, influences[1].mWeights[0]);
+    EXPECT_EQ(64u, influences[1].mWeights[1]);
+
+    // A vertex without bones has no weights
+    EXPECT_EQ(0u, sumWeights(influences[2]));
+}
+
+TEST_F(SkinningTest, keepStrongestInfluencesTest) {
+    VertexInfluenceBuilder builder;
+    builder.reset(1);
+    const f32 weights[] = { 0.05f, 0.3f, 0.1f, 0.2f, 0.25f, 0.1f };
+    for (ui32 i = 0; i < 6; ++i) {
+        VertexWeight vw = { 0, weights[i] };
+        EXPECT_TRUE(builder.addBone(i, &vw, 1, 0));
+    }
+
+    VertexInfluenceArray influences;
+    builder.build(influences);
+    ASSERT_EQ(1u, influences.size());
+    EXPECT_EQ(1u, influences[0].mBoneIndices[0]);
+    EXPECT_EQ(4u, influences[0].mBoneIndices[1]);
+    EXPECT_EQ(3u, influences[0].mBoneIndices[2]);
+    EXPECT_EQ(255u, sumWeights(influences[0]));
+    for (ui32 i = 1; i < MaxBoneInfluences; ++i) {
+        EXPECT_LE(influences[0].mWeights[i], influences[0].mWeights[i - 1]);
+    }
+}
+
+TEST_F(SkinningTest, vertexOffsetAndInvalidInputTest) {
+    VertexInfluenceBuilder builder;
+    builder.reset(4);
+
+    VertexWeight vw = { 1, 1.0f };
+    EXPECT_TRUE(builder.addBone(2, &vw, 1, 2));
+    EXPECT_FALSE(builder.addBone(2, &vw, 1, 3));
+    EXPECT_FALSE(builder.addBone(VertexInfluenceBuilder::MaxBoneIndex + 1, &vw, 1, 0));
+
+    VertexInfluenceArray influences;
+    builder.build(influences);
+    ASSERT_EQ(4u, influences.size());
+    EXPECT_EQ(2u, influences[3].mBoneIndices[0]);
+    EXPECT_EQ(255u, influences[3].mWeights[0]);
+    EXPECT_EQ(0u, sumWeights(influences[1]));
+}
+
+} // Namespace UnitTest
+} // Namespace OSRE
@@ -0,0 +1,218 @@
+/*-----------------------------------------------------------------------------------------------
+The MIT License (MIT)
+
+Copyright (c) 2015-2022 OSRE ( Open Source Render Engine ) by Kim Kulling
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of
+this software and associated documentation files (the "Software"), to deal in
+the Software without restriction, including without limitation the rights to
+use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+the Software, and to permit persons to whom the Software is furnished to do so,
+subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+-----------------------------------------------------------------------------------------------*/
+#include "osre_testcommon.h"
+#include <osre/App/AABBTree.h>
+#include <osre/Common/Frustum.h>
+#include <osre/Common/TRay.h>
+
+#include <algorithm>
+#include <vector>
+
+namespace OSRE {
+namespace UnitTest {
+
+using namespace ::OSRE::App;
+using namespace ::OSRE::Common;
+
+class AABBTreeTest : public ::testing::Test {
+protected:
+    static const i32 GridSize = 20;
+
+    // Unit boxes on a grid in the xy-plane, the user data is the index
+    void fillGrid(AABBTree &tree, std::vector<i32> &proxies) {
+        for (i32 y = 0; y < GridSize; ++y) {
+            for (i32 x = 0; x < GridSize; ++x) {
+                const glm::vec3 min(x * 2.0f, y * 2.0f, 0.0f);
+                const size_t index = static_cast<size_t>(y * GridSize + x);
+                proxies.push_back(tree.createProxy(AABB(min, min + glm::vec3(1.0f)), reinterpret_cast<void *>(index + 1)));
+            }
+        }
+    }
+
+    static std::vector<size_t> toIndices(const CPPCore::TArray<void *> &result) {
+        std::vector<size_t> indices;
+        for (size_t i = 0; i < result.size(); ++i) {
+            indices.push_back(reinterpret_cast<size_t>(result[i]) - 1);
+        }
+        std::sort(indices.begin(), indices.end());
+        return indices;
+    }
+};
+
+TEST_F(AABBTreeTest, createTest) {
+    AABBTree tree;
+    EXPECT_EQ(0u, tree.getNumProxies());
+    EXPECT_EQ(0, tree.getHeight());
+
+    CPPCore::TArray<void *> result;
+    tree.queryBox(AABB(glm::vec3(-1), glm::vec3(1)), result);
+    EXPECT_EQ(0u, result.size());
+}
+
+TEST_F(AABBTreeTest, balanceTest) {
+    AABBTree tree;
+    std::vector<i32> proxies;
+    fillGrid(tree, proxies);
+    EXPECT_EQ(static_cast<size_t>(GridSize * GridSize), tree.getNumProxies());
+
+    // 400 leaves need at least 10 levels, the rotations keep it close to that
+    EXPECT_LE(10, tree.getHeight());
+    EXPECT_GE(20, tree.getHeight());
+
+    for (size_t i = 0; i < proxies.size(); i += 2) {
+        tree.destroyProxy(proxies[i]);
+    }
+    EXPECT_EQ(proxies.size() / 2, tree.getNumProxies());
+
+    tree.clear();
+    EXPECT_EQ(0u, tree.getNumProxies());
+    EXPECT_EQ(0, tree.getHeight());
+}
+
+TEST_F(AABBTreeTest, queryBoxTest) {
+    AABBTree tree(0.0f);
+    std::vector<i32> proxies;
+    fillGrid(tree, proxies);
+
+    CPPCore::TArray<void *> result;
+    tree.queryBox(AABB(glm::vec3(0.5f, 0.5f, -1.0f), glm::vec3(2.5f, 0.8f, 1.0f)), result);
+    const std::vector<size_t> indices = toIndices(result);
+    ASSERT_EQ(2u, indices.size());
+    EXPECT_EQ(0u, indices[0]);
+    EXPECT_EQ(1u, indices[1]);
+
+    // A box containing everything takes the shortcut over whole subtrees
+    result.clear();
+    tree.queryBox(AABB(glm::vec3(-1000.0f), glm::vec3(1000.0f)), result);
+    EXPECT_EQ(proxies.size(), result.size());
+}
+
+TEST_F(AABBTreeTest, querySphereTest) {
+    AABBTree tree(0.0f);
+    std::vector<i32> proxies;
+    fillGrid(tree, proxies);
+
+    CPPCore::TArray<void *> result;
+    tree.querySphere(glm::vec3(4.5f, 4.5f, 0.5f), 0.5f, result);
+    const std::vector<size_t> indices = toIndices(result);
+    ASSERT_EQ(1u, indices.size());
+    EXPECT_EQ(static_cast<size_t>(2 * GridSize + 2), indices[0]);
+}
+
+TEST_F(AABBTreeTest, queryRayTest) {
+    AABBTree tree(0.0f);
+    std::vector<i32> proxies;
+    fillGrid(tree, proxies);
+
+    // Along the first row
+    CPPCore::TArray<void *> result;
+    tree.queryRay(Ray(glm::vec3(-1.0f, 0.5f, 0.5f), glm::vec3(1.0f, 0.0f, 0.0f)), 1000.0f, result);
+    EXPECT_EQ(static_cast<size_t>(GridSize), result.size());
+
+    // The length limits the hits
+    result.clear();
+    tree.queryRay(Ray(glm::vec3(-1.0f, 0.5f, 0.5f), glm::vec3(1.0f, 0.0f, 0.0f)), 4.5f, result);
+    EXPECT_EQ(2u, result.size());
+}
+
+TEST_F(AABBTreeTest, queryFrustumTest) {
+    AABBTree tree(0.0f);
+    std::vector<i32> proxies;
+    fillGrid(tree, proxies);
+
+    // Looking down at the first boxes
+    const glm::mat4 vp = glm::perspective(0.5f, 1.0f, 0.1f, 100.0f) * glm::lookAt(glm::vec3(1.5f, 1.5f, 10.0f), glm::vec3(1.5f, 1.5f, 0.0f), glm::vec3(0, 1, 0));
+    Frustum frustum;
+    frustum.extractFrom(vp);
+
+    CPPCore::TArray<void *> result;
+    tree.queryFrustum(frustum, result);
+    const std::vector<size_t> indices = toIndices(result);
+    EXPECT_FALSE(indices.empty());
+    EXPECT_GT(proxies.size(), indices.size());
+    EXPECT_TRUE(std::find(indices.begin(), indices.end(), 0u) != indices.end());
+    EXPECT_TRUE(std::find(indices.begin(), indices.end(), proxies.size() - 1) == indices.end());
+}
+
+TEST_F(AABBTreeTest, moveProxyTest) {
+    AABBTree tree(0.5f);
+    const i32 proxy = tree.createProxy(AABB(glm::vec3(0.0f), glm::vec3(1.0f)), nullptr);
+
+    // Small moves stay inside the fat box
+    EXPECT_FALSE(tree.moveProxy(proxy, AABB(glm::vec3(0.2f), glm::vec3(1.2f))));
+    EXPECT_TRUE(tree.moveProxy(proxy, AABB(glm::vec3(10.0f), glm::vec3(11.0f))));
+    EXPECT_EQ(glm::vec3(9.5f), tree.getFatAABB(proxy).getMin());
+
+    CPPCore::TArray<void *> result;
+    tree.queryBox(AABB(glm::vec3(-1.0f), glm::vec3(2.0f)), result);
+    EXPECT_EQ(0u, result.size());
+    tree.queryBox(AABB(glm::vec3(10.0f), glm::vec3(10.5f)), result);
+    EXPECT_EQ(1u, result.size());
+}
+
+TEST_F(AABBTreeTest, bruteForceTest) {
+    static const size_t NumProxies = 500;
+
+    // Random moves must not change any result compared to a linear scan
+    AABBTree tree;
+    std::vector<AABB> boxes;
+    std::vector<i32> proxies;
+    ui32 seed = 12345;
+    auto random = [&seed](f32 range) {
+        seed = seed * 1664525u + 1013904223u;
+        return static_cast<f32>(seed >> 8) / static_cast<f32>(1 << 24) * range;
+    };
+    for (size_t i = 0; i < NumProxies; ++i) {
+        const glm::vec3 min(random(100.0f), random(100.0f), random(100.0f));
+        boxes.push_back(AABB(min, min + glm::vec3(random(5.0f))));
+        proxies.push_back(tree.createProxy(boxes[i], reinterpret_cast<void *>(i + 1)));
+    }
+
+    for (ui32 round = 0; round < 10; ++round) {
+        for (size_t i = 0; i < NumProxies; i += 3) {
+            const glm::vec3 offset(random(4.0f) - 2.0f, random(4.0f) - 2.0f, random(4.0f) - 2.0f);
+            boxes[i].set(boxes[i].getMin() + offset, boxes[i].getMax() + offset);
+            tree.moveProxy(proxies[i], boxes[i]);
+        }
+
+        const glm::vec3 min(random(100.0f), random(100.0f), random(100.0f));
+        const AABB query(min, min + glm::vec3(20.0f));
+        CPPCore::TArray<void *> result;
+        tree.queryBox(query, result);
+        const std::vector<size_t> indices = toIndices(result);
+
+        // The tree uses fat boxes, so it may report a few more
+        for (size_t i = 0; i < NumProxies; ++i) {
+            if (query.intersects(boxes[i])) {
+                EXPECT_TRUE(std::binary_search(indices.begin(), indices.end(), i));
+            }
+        }
+        for (size_t index : indices) {
+            EXPECT_TRUE(query.intersects(tree.getFatAABB(proxies[index])));
+        }
+    }
+    EXPECT_GE(24, tree.getHeight());
+}
+
+} // Namespace UnitTest
+} // Namespace OSRE
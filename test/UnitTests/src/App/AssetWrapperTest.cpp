@@ -22,15 +22,84 @@ CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
 -----------------------------------------------------------------------------------------------*/
 #include <gtest/gtest.h>
 #include <osre/App/AssimpWrapper.h>
+#include <osre/App/Component.h>
+#include <osre/App/Entity.h>
+#include <osre/App/World.h>
 #include <osre/Common/Ids.h>
+#include <osre/RenderBackend/MaterialBuilder.h>
+#include <osre/RenderBackend/Mesh.h>
+#include <osre/Threading/JobSystem.h>
+
+#include <assimp/scene.h>
+
+#include <cstring>
 
 namespace OSRE {
 namespace UnitTest {
 
 using namespace ::OSRE::App;
+using namespace ::OSRE::RenderBackend;
 
 class AssimpWrapperTest : public ::testing::Test {
-    // empty
+protected:
+    // A scene with one quad per mesh, the meshes use the materials in turn
+    static aiScene *createScene(ui32 numMeshes, ui32 numMaterials) {
+        aiScene *scene = new aiScene;
+        scene->mNumMaterials = numMaterials;
+        scene->mMaterials = new aiMaterial *[numMaterials];
+        for (ui32 i = 0; i < numMaterials; ++i) {
+            scene->mMaterials[i] = new aiMaterial;
+        }
+
+        scene->mNumMeshes = numMeshes;
+        scene->mMeshes = new aiMesh *[numMeshes];
+        scene->mRootNode = new aiNode("root");
+        scene->mRootNode->mNumMeshes = numMeshes;
+        scene->mRootNode->mMeshes = new unsigned int[numMeshes];
+        for (ui32 i = 0; i < numMeshes; ++i) {
+            aiMesh *mesh = new aiMesh;
+            mesh->mMaterialIndex = i % numMaterials;
+            mesh->mNumVertices = 4;
+            mesh->mVertices = new aiVector3D[4];
+            mesh->mNormals = new aiVector3D[4];
+            const ai_real x = static_cast<ai_real>(i);
+            mesh->mVertices[0] = aiVector3D(x, 0, 0);
+            mesh->mVertices[1] = aiVector3D(x + 1, 0, 0);
+            mesh->mVertices[2] = aiVector3D(x + 1, 1, 0);
+            mesh->mVertices[3] = aiVector3D(x, 1, 0);
+            for (ui32 j = 0; j < 4; ++j) {
+                mesh->mNormals[j] = aiVector3D(0, 0, 1);
+            }
+
+            static const unsigned int QuadIndices[6] = { 0, 1, 2, 0, 2, 3 };
+            mesh->mNumFaces = 2;
+            mesh->mFaces = new aiFace[2];
+            for (ui32 j = 0; j < 2; ++j) {
+                mesh->mFaces[j].mNumIndices = 3;
+                mesh->mFaces[j].mIndices = new unsigned int[3];
+                ::memcpy(mesh->mFaces[j].mIndices, &QuadIndices[j * 3], sizeof(unsigned int) * 3);
+            }
+            scene->mMeshes[i] = mesh;
+            scene->mRootNode->mMeshes[i] = i;
+        }
+
+        return scene;
+    }
+
+    static void getMeshes(Entity *entity, MeshArray &meshes) {
+        ASSERT_NE(nullptr, entity);
+        RenderComponent *rc = static_cast<RenderComponent *>(entity->getComponent(ComponentType::RenderComponentType));
+        ASSERT_NE(nullptr, rc);
+        rc->getMeshArray(meshes);
+    }
+
+    static bool isEqual(BufferData *lhs, BufferData *rhs) {
+        if (nullptr == lhs || nullptr == rhs) {
+            return lhs == rhs;
+        }
+
+        return lhs->getSize() == rhs->getSize() && 0 == ::memcmp(lhs->getData(), rhs->getData(), lhs->getSize());
+    }
 };
 
 TEST_F( AssimpWrapperTest, createTest ) {
@@ -45,5 +114,51 @@ TEST_F( AssimpWrapperTest, createTest ) {
     EXPECT_TRUE( ok );
 }
 
+TEST_F( AssimpWrapperTest, parallelImportTest ) {
+    MaterialBuilder::create(nullptr);
+    aiScene *scene = createScene(64, 3);
+
+    // Without a job system every stage runs on the calling thread
+    ASSERT_EQ(nullptr, Threading::JobSystem::getInstance());
+    Common::Ids serialIds, parallelIds;
+    World serialWorld("serial"), parallelWorld("parallel");
+    AssimpWrapper serial(serialIds, &serialWorld);
+    Entity *serialEntity = serial.importScene(scene);
+
+    ASSERT_TRUE(Threading::JobSystem::create(4));
+    AssimpWrapper parallel(parallelIds, &parallelWorld);
+    Entity *parallelEntity = parallel.importScene(scene);
+    Threading::JobSystem::destroy();
+
+    MeshArray serialMeshes, parallelMeshes;
+    getMeshes(serialEntity, serialMeshes);
+    getMeshes(parallelEntity, parallelMeshes);
+    EXPECT_EQ(3u, serialMeshes.size());
+    ASSERT_EQ(serialMeshes.size(), parallelMeshes.size());
+    for (size_t i = 0; i < serialMeshes.size(); ++i) {
+        Mesh *lhs = serialMeshes[i];
+        Mesh *rhs = parallelMeshes[i];
+        EXPECT_TRUE(isEqual(lhs->getVertexBuffer(), rhs->getVertexBuffer()));
+        EXPECT_TRUE(isEqual(lhs->getIndexBuffer(), rhs->getIndexBuffer()));
+        EXPECT_EQ(lhs->getMaterial(), rhs->getMaterial());
+        ASSERT_EQ(lhs->getNumberOfPrimitiveGroups(), rhs->getNumberOfPrimitiveGroups());
+        for (size_t j = 0; j < lhs->getNumberOfPrimitiveGroups(); ++j) {
+            EXPECT_EQ(lhs->getPrimitiveGroupAt(j)->m_numIndices, rhs->getPrimitiveGroupAt(j)->m_numIndices);
+        }
+    }
+
+    ui32 serialVertices = 0, serialTriangles = 0, parallelVertices = 0, parallelTriangles = 0;
+    serial.getStatistics(serialVertices, serialTriangles);
+    parallel.getStatistics(parallelVertices, parallelTriangles);
+    EXPECT_EQ(64u * 4u, serialVertices);
+    EXPECT_EQ(serialVertices, parallelVertices);
+    EXPECT_EQ(serialTriangles, parallelTriangles);
+    EXPECT_EQ(serialEntity->getAABB().getMin(), parallelEntity->getAABB().getMin());
+    EXPECT_EQ(serialEntity->getAABB().getMax(), parallelEntity->getAABB().getMax());
+
+    delete scene;
+    MaterialBuilder::destroy();
+}
+
 }
 }
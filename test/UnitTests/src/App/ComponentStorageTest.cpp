@@ -0,0 +1,150 @@
+/*-----------------------------------------------------------------------------------------------
+The MIT License (MIT)
+
+Copyright (c) 2015-2022 OSRE ( Open Source Render Engine ) by Kim Kulling
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of
+this software and associated documentation files (the "Software"), to deal in
+the Software without restriction, including without limitation the rights to
+use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+the Software, and to permit persons to whom the Software is furnished to do so,
+subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+-----------------------------------------------------------------------------------------------*/
+#include "osre_testcommon.h"
+#include <osre/App/ComponentStorage.h>
+#include <osre/App/Entity.h>
+#include <osre/App/TComponentPool.h>
+#include <osre/Common/Ids.h>
+
+namespace OSRE {
+namespace UnitTest {
+
+using namespace ::OSRE::App;
+
+class ComponentStorageTest : public ::testing::Test {
+protected:
+    struct Payload {
+        ui32 mValue;
+
+        explicit Payload(ui32 value) :
+                mValue(value) {
+            // empty
+        }
+    };
+};
+
+TEST_F(ComponentStorageTest, poolAddGetRemoveTest) {
+    TComponentPool<Payload> pool;
+    EXPECT_EQ(0u, pool.size());
+    EXPECT_EQ(nullptr, pool.get(3));
+
+    for (ui32 i = 0; i < 5; ++i) {
+        Payload *payload = pool.add(i * 2, i);
+        ASSERT_NE(nullptr, payload);
+        EXPECT_EQ(i, payload->mValue);
+    }
+    EXPECT_EQ(5u, pool.size());
+    EXPECT_FALSE(pool.has(3));
+    EXPECT_TRUE(pool.has(4));
+
+    // Adding twice returns the existing component
+    EXPECT_EQ(2u, pool.add(4, 99u)->mValue);
+    EXPECT_EQ(5u, pool.size());
+
+    // The last component fills the gap
+    EXPECT_TRUE(pool.remove(2));
+    EXPECT_FALSE(pool.remove(2));
+    EXPECT_EQ(4u, pool.size());
+    EXPECT_EQ(8u, pool.getEntityAt(1));
+    EXPECT_EQ(4u, pool.at(1).mValue);
+    for (ui32 i = 0; i < 5; ++i) {
+        if (1 != i) {
+            ASSERT_NE(nullptr, pool.get(i * 2));
+            EXPECT_EQ(i, pool.get(i * 2)->mValue);
+        }
+    }
+
+    pool.clear();
+    EXPECT_EQ(0u, pool.size());
+    EXPECT_FALSE(pool.has(0));
+}
+
+TEST_F(ComponentStorageTest, poolForEachTest) {
+    static const ui32 NumComponents = 5000;
+    TComponentPool<Payload> pool;
+    for (ui32 i = 0; i < NumComponents; ++i) {
+        pool.add(i, i);
+    }
+
+    // The chunks only run in parallel with a job system
+    const bool ownsJobSystem = nullptr == Threading::JobSystem::getInstance();
+    if (ownsJobSystem) {
+        ASSERT_TRUE(Threading::JobSystem::create());
+    }
+    pool.forEach([](Payload &payload) { payload.mValue += 1; });
+    pool.forEachParallel(256, [](Payload &payload) { payload.mValue *= 2; });
+    if (ownsJobSystem) {
+        Threading::JobSystem::destroy();
+    }
+    for (ui32 i = 0; i < NumComponents; ++i) {
+        EXPECT_EQ((i + 1) * 2, pool.get(i)->mValue);
+    }
+}
+
+TEST_F(ComponentStorageTest, poolMoveComponentTest) {
+    TComponentPool<RenderComponent> pool;
+    for (ui32 i = 0; i < 3; ++i) {
+        pool.add(i, nullptr, i);
+    }
+
+    // The remove moves the last render component into the gap
+    EXPECT_TRUE(pool.remove(0));
+    EXPECT_EQ(2u, pool.size());
+    ASSERT_NE(nullptr, pool.get(2));
+    EXPECT_EQ(2u, pool.get(2)->getId());
+    EXPECT_EQ(ComponentType::RenderComponentType, pool.get(2)->getType());
+    EXPECT_TRUE(pool.get(2)->isVisible());
+}
+
+TEST_F(ComponentStorageTest, entityIdTest) {
+    ComponentStorage storage;
+    const ui32 id0 = storage.createEntityId();
+    const ui32 id1 = storage.createEntityId();
+    EXPECT_NE(id0, id1);
+    EXPECT_EQ(2u, storage.getNumEntities());
+
+    storage.releaseEntityId(id0);
+    EXPECT_EQ(1u, storage.getNumEntities());
+    EXPECT_EQ(id0, storage.createEntityId());
+}
+
+TEST_F(ComponentStorageTest, entityComponentsTest) {
+    Common::Ids ids;
+    Entity entity("test", ids, nullptr);
+    EXPECT_NE(nullptr, entity.getComponent(ComponentType::RenderComponentType));
+    EXPECT_EQ(nullptr, entity.getComponent(ComponentType::LightComponentType));
+
+    Component *light = entity.createComponent(ComponentType::LightComponentType);
+    ASSERT_NE(nullptr, light);
+    EXPECT_EQ(ComponentType::LightComponentType, light->getType());
+    EXPECT_EQ(&entity, light->getOwner());
+    EXPECT_EQ(light, entity.getComponent(ComponentType::LightComponentType));
+
+    EXPECT_TRUE(entity.destroyComponent(ComponentType::LightComponentType));
+    EXPECT_FALSE(entity.destroyComponent(ComponentType::LightComponentType));
+    EXPECT_EQ(nullptr, entity.getComponent(ComponentType::LightComponentType));
+    EXPECT_EQ(nullptr, entity.createComponent(ComponentType::InvalidComponent));
+}
+
+} // Namespace UnitTest
+} // Namespace OSRE
@@ -0,0 +1,108 @@
+/*-----------------------------------------------------------------------------------------------
+The MIT License (MIT)
+
+Copyright (c) 2015-2022 OSRE ( Open Source Render Engine ) by Kim Kulling
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of
+this software and associated documentation files (the "Software"), to deal in
+the Software without restriction, including without limitation the rights to
+use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+the Software, and to permit persons to whom the Software is furnished to do so,
+subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+-----------------------------------------------------------------------------------------------*/
+#include "osre_testcommon.h"
+#include <osre/Common/FreeListAllocator.h>
+
+namespace OSRE {
+namespace UnitTest {
+
+using namespace ::OSRE::Common;
+
+class FreeListAllocatorTest : public ::testing::Test {
+    // empty
+};
+
+TEST_F(FreeListAllocatorTest, createTest) {
+    FreeListAllocator allocator(1024);
+    EXPECT_EQ(1024u, allocator.getCapacity());
+    EXPECT_EQ(0u, allocator.getUsed());
+    EXPECT_EQ(1u, allocator.getNumFreeRanges());
+    EXPECT_EQ(1024u, allocator.getLargestFreeRange());
+}
+
+TEST_F(FreeListAllocatorTest, allocTest) {
+    FreeListAllocator allocator(1024);
+    EXPECT_EQ(FreeListAllocator::InvalidOffset, allocator.alloc(0));
+
+    const size_t first = allocator.alloc(100);
+    const size_t second = allocator.alloc(100);
+    EXPECT_EQ(0u, first);
+    EXPECT_EQ(100u, second);
+    EXPECT_EQ(200u, allocator.getUsed());
+    EXPECT_EQ(2u, allocator.getNumAllocations());
+
+    // Does not fit anymore
+    EXPECT_EQ(FreeListAllocator::InvalidOffset, allocator.alloc(1000));
+}
+
+TEST_F(FreeListAllocatorTest, alignmentTest) {
+    FreeListAllocator allocator(1024);
+    allocator.alloc(10);
+
+    // Vertex strides are not a power of two
+    const size_t offset = allocator.alloc(44, 44);
+    EXPECT_EQ(44u, offset);
+    EXPECT_EQ(88u, allocator.getUsed());
+
+    // The padding is given back with the allocation
+    EXPECT_TRUE(allocator.release(offset));
+    EXPECT_EQ(10u, allocator.getUsed());
+    EXPECT_EQ(1u, allocator.getNumFreeRanges());
+}
+
+TEST_F(FreeListAllocatorTest, releaseAndMergeTest) {
+    FreeListAllocator allocator(300);
+    const size_t a = allocator.alloc(100);
+    const size_t b = allocator.alloc(100);
+    const size_t c = allocator.alloc(100);
+    EXPECT_EQ(0u, allocator.getNumFreeRanges());
+
+    EXPECT_FALSE(allocator.release(50));
+    EXPECT_TRUE(allocator.release(a));
+    EXPECT_TRUE(allocator.release(c));
+    EXPECT_FALSE(allocator.release(c));
+    EXPECT_EQ(2u, allocator.getNumFreeRanges());
+    EXPECT_EQ(100u, allocator.getLargestFreeRange());
+
+    // The freed hole is reused first
+    EXPECT_EQ(a, allocator.alloc(80));
+    EXPECT_TRUE(allocator.release(a));
+
+    // Releasing the middle range merges everything into one range again
+    EXPECT_TRUE(allocator.release(b));
+    EXPECT_EQ(1u, allocator.getNumFreeRanges());
+    EXPECT_EQ(300u, allocator.getLargestFreeRange());
+    EXPECT_EQ(0u, allocator.getUsed());
+}
+
+TEST_F(FreeListAllocatorTest, resetTest) {
+    FreeListAllocator allocator(100);
+    allocator.alloc(60);
+    allocator.reset(200);
+    EXPECT_EQ(200u, allocator.getCapacity());
+    EXPECT_EQ(0u, allocator.getNumAllocations());
+    EXPECT_EQ(0u, allocator.alloc(200));
+}
+
+} // Namespace UnitTest
+} // Namespace OSRE
@@ -0,0 +1,105 @@
+/*-----------------------------------------------------------------------------------------------
+The MIT License (MIT)
+
+Copyright (c) 2015-2022 OSRE ( Open Source Render Engine ) by Kim Kulling
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of
+this software and associated documentation files (the "Software"), to deal in
+the Software without restriction, including without limitation the rights to
+use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+the Software, and to permit persons to whom the Software is furnished to do so,
+subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+-----------------------------------------------------------------------------------------------*/
+#include "osre_testcommon.h"
+#include <osre/Common/Frustum.h>
+#include <osre/Common/FrustumCuller.h>
+
+namespace OSRE {
+namespace UnitTest {
+
+using namespace ::OSRE::Common;
+
+class FrustumCullerTest : public ::testing::Test {
+protected:
+    Frustum mFrustum;
+
+    void SetUp() override {
+        glm::vec3 pos(-10, 10, 0), center(0, 0, 0), up(0, 0, 1);
+        mFrustum.extractFrom(glm::perspective(1.2f, 1.f, 0.1f, 100.0f) * glm::lookAt(pos, center, up));
+    }
+};
+
+TEST_F( FrustumCullerTest, emptyTest ) {
+    FrustumCuller culler;
+    CPPCore::TArray<ui32> visible;
+    EXPECT_EQ(0u, culler.size());
+    EXPECT_EQ(0u, culler.cull(mFrustum, visible));
+    EXPECT_TRUE(visible.isEmpty());
+}
+
+TEST_F( FrustumCullerTest, cullTest ) {
+    FrustumCuller culler;
+    EXPECT_EQ(0u, culler.add(AABB(glm::vec3(-1, -1, -1), glm::vec3(1, 1, 1))));
+    EXPECT_EQ(1u, culler.add(AABB(glm::vec3(-30, 20, -1), glm::vec3(-25, 25, 1))));
+    EXPECT_EQ(2u, culler.add(AABB(glm::vec3(-1, -1, -1), glm::vec3(200, 200, 1))));
+    EXPECT_EQ(3u, culler.size());
+
+    CPPCore::TArray<ui32> visible;
+    ASSERT_EQ(2u, culler.cull(mFrustum, visible));
+    EXPECT_EQ(0u, visible[0]);
+    EXPECT_EQ(2u, visible[1]);
+
+    // Move the visible box out of the frustum
+    culler.set(0, AABB(glm::vec3(-30, 20, -1), glm::vec3(-25, 25, 1)));
+    ASSERT_EQ(1u, culler.cull(mFrustum, visible));
+    EXPECT_EQ(2u, visible[0]);
+
+    culler.clear();
+    EXPECT_EQ(0u, culler.size());
+    EXPECT_EQ(0u, culler.cull(mFrustum, visible));
+}
+
+TEST_F( FrustumCullerTest, classifyEqualityTest ) {
+    // Not a multiple of the block size, so the padding gets tested as well
+    static const ui32 NumBoxes = 1003;
+    ui32 seed = 4711;
+    auto random = [&seed](f32 range) {
+        seed = seed * 1664525u + 1013904223u;
+        return static_cast<f32>(seed >> 8) / static_cast<f32>(1 << 24) * range - range * 0.5f;
+    };
+
+    FrustumCuller culler;
+    std::vector<bool> expected;
+    for (ui32 i = 0; i < NumBoxes; ++i) {
+        const glm::vec3 min(random(200.0f), random(200.0f), random(200.0f));
+        const AABB aabb(min, min + glm::vec3(random(10.0f) + 5.0f));
+        culler.add(aabb);
+        expected.push_back(mFrustum.classify(aabb) != Frustum::Visibility::Outside);
+    }
+
+    CPPCore::TArray<ui32> visible;
+    const size_t numVisible = culler.cull(mFrustum, visible);
+    EXPECT_EQ(numVisible, visible.size());
+    EXPECT_GT(numVisible, 0u);
+    EXPECT_LT(numVisible, static_cast<size_t>(NumBoxes));
+
+    std::vector<bool> result(NumBoxes, false);
+    for (size_t i = 0; i < numVisible; ++i) {
+        ASSERT_LT(visible[i], NumBoxes);
+        result[visible[i]] = true;
+    }
+    EXPECT_EQ(expected, result);
+}
+
+} // namespace UnitTest
+} // namespace OSRE
@@ -58,6 +58,22 @@ TEST_F( FrustumTest, extractFromTest ) {
     EXPECT_FALSE(result);
 }
 
+TEST_F( FrustumTest, classifyTest ) {
+    glm::vec3 pos(-10, 10, 0), center(0, 0, 0), up(0, 0, 1);
+    glm::mat4 vp = glm::perspective(1.2f, 1.f, 0.1f, 100.0f) * glm::lookAt(pos, center, up);
+    Frustum f;
+    f.extractFrom(vp);
+
+    AABB inside(glm::vec3(-1, -1, -1), glm::vec3(1, 1, 1));
+    EXPECT_EQ(Frustum::Visibility::Inside, f.classify(inside));
+
+    AABB outside(glm::vec3(-30, 20, -1), glm::vec3(-25, 25, 1));
+    EXPECT_EQ(Frustum::Visibility::Outside, f.classify(outside));
+
+    AABB intersecting(glm::vec3(-1, -1, -1), glm::vec3(200, 200, 1));
+    EXPECT_EQ(Frustum::Visibility::Intersecting, f.classify(intersecting));
+}
+
 } // namespace UnitTest
 } // namespace OSRE
 
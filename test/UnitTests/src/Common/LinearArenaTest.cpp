@@ -0,0 +1,83 @@
+/*-----------------------------------------------------------------------------------------------
+The MIT License (MIT)
+
+Copyright (c) 2015-2022 OSRE ( Open Source Render Engine ) by Kim Kulling
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of
+this software and associated documentation files (the "Software"), to deal in
+the Software without restriction, including without limitation the rights to
+use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+the Software, and to permit persons to whom the Software is furnished to do so,
+subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+-----------------------------------------------------------------------------------------------*/
+#include "osre_testcommon.h"
+#include <osre/Common/LinearArena.h>
+
+namespace OSRE {
+namespace UnitTest {
+
+using namespace ::OSRE::Common;
+
+class LinearArenaTest : public ::testing::Test {
+    // empty
+};
+
+TEST_F(LinearArenaTest, createTest) {
+    LinearArena arena(1024);
+    EXPECT_EQ(1024u, arena.getCapacity());
+    EXPECT_EQ(0u, arena.getUsed());
+    EXPECT_EQ(0u, arena.getHighWaterMark());
+}
+
+TEST_F(LinearArenaTest, allocTest) {
+    LinearArena arena(1024);
+    EXPECT_EQ(nullptr, arena.alloc(0));
+
+    c8 *ptr1 = static_cast<c8 *>(arena.alloc(10));
+    c8 *ptr2 = static_cast<c8 *>(arena.alloc(10));
+    EXPECT_NE(nullptr, ptr1);
+    EXPECT_NE(nullptr, ptr2);
+    EXPECT_EQ(0u, reinterpret_cast<uintptr_t>(ptr2) % LinearArena::DefaultAlignment);
+    EXPECT_GE(ptr2, ptr1 + 10);
+    EXPECT_EQ(0u, arena.getNumOverflows());
+}
+
+TEST_F(LinearArenaTest, resetTest) {
+    LinearArena arena(1024);
+    void *ptr1 = arena.alloc(100);
+    arena.alloc(100);
+    const size_t used = arena.getUsed();
+    EXPECT_GE(used, 200u);
+
+    arena.reset();
+    EXPECT_EQ(0u, arena.getUsed());
+    EXPECT_EQ(used, arena.getHighWaterMark());
+    EXPECT_EQ(ptr1, arena.alloc(100));
+}
+
+TEST_F(LinearArenaTest, overflowTest) {
+    LinearArena arena(64);
+    EXPECT_NE(nullptr, arena.alloc(48));
+    EXPECT_NE(nullptr, arena.alloc(256));
+    EXPECT_EQ(1u, arena.getNumOverflows());
+
+    // The main block grows to the high-water mark
+    arena.reset();
+    EXPECT_GE(arena.getCapacity(), arena.getHighWaterMark());
+    arena.alloc(48);
+    arena.alloc(256);
+    EXPECT_EQ(1u, arena.getNumOverflows());
+}
+
+} // Namespace UnitTest
+} // Namespace OSRE
@@ -0,0 +1,72 @@
+/*-----------------------------------------------------------------------------------------------
+The MIT License (MIT)
+
+Copyright (c) 2015-2022 OSRE ( Open Source Render Engine ) by Kim Kulling
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of
+this software and associated documentation files (the "Software"), to deal in
+the Software without restriction, including without limitation the rights to
+use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+the Software, and to permit persons to whom the Software is furnished to do so,
+subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+-----------------------------------------------------------------------------------------------*/
+#include "osre_testcommon.h"
+#include <osre/Common/RadixSort.h>
+
+#include <vector>
+
+namespace OSRE {
+namespace UnitTest {
+
+using namespace ::OSRE::Common;
+
+class RadixSortTest : public ::testing::Test {
+    // empty
+};
+
+TEST_F(RadixSortTest, sortTest) {
+    const ui64 keys[] = { 0xff00000000000000ull, 5, 0x100, 3, 0xffffffffffffffffull, 0, 0x100000000ull };
+    const size_t numItems = sizeof(keys) / sizeof(keys[0]);
+    std::vector<SortItem> items(numItems), tmp(numItems);
+    for (size_t i = 0; i < numItems; ++i) {
+        items[i].m_key = keys[i];
+        items[i].m_index = static_cast<ui32>(i);
+    }
+
+    radixSort(&items[0], &tmp[0], numItems);
+    for (size_t i = 1; i < numItems; ++i) {
+        EXPECT_LE(items[i - 1].m_key, items[i].m_key);
+    }
+    EXPECT_EQ(5u, items[0].m_index);
+    EXPECT_EQ(4u, items[numItems - 1].m_index);
+}
+
+TEST_F(RadixSortTest, stableTest) {
+    const size_t numItems = 100;
+    std::vector<SortItem> items(numItems), tmp(numItems);
+    for (size_t i = 0; i < numItems; ++i) {
+        items[i].m_key = (i % 3) << 40;
+        items[i].m_index = static_cast<ui32>(i);
+    }
+
+    radixSort(&items[0], &tmp[0], numItems);
+    for (size_t i = 1; i < numItems; ++i) {
+        EXPECT_LE(items[i - 1].m_key, items[i].m_key);
+        if (items[i - 1].m_key == items[i].m_key) {
+            EXPECT_LT(items[i - 1].m_index, items[i].m_index);
+        }
+    }
+}
+
+} // Namespace UnitTest
+} // Namespace OSRE
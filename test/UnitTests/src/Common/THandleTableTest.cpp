@@ -0,0 +1,87 @@
+/*-----------------------------------------------------------------------------------------------
+The MIT License (MIT)
+
+Copyright (c) 2015-2022 OSRE ( Open Source Render Engine ) by Kim Kulling
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of
+this software and associated documentation files (the "Software"), to deal in
+the Software without restriction, including without limitation the rights to
+use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+the Software, and to permit persons to whom the Software is furnished to do so,
+subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+-----------------------------------------------------------------------------------------------*/
+#include "osre_testcommon.h"
+#include <osre/Common/THandleTable.h>
+
+namespace OSRE {
+namespace UnitTest {
+
+using namespace ::OSRE::Common;
+
+class THandleTableTest : public ::testing::Test {
+    // empty
+};
+
+TEST_F(THandleTableTest, addGetTest) {
+    THandleTable<i32> table;
+    EXPECT_EQ(0u, table.size());
+
+    Handle h1 = table.add(1);
+    Handle h2 = table.add(2);
+    EXPECT_TRUE(h1.isValid());
+    EXPECT_NE(h1, h2);
+    EXPECT_EQ(2u, table.size());
+    ASSERT_NE(nullptr, table.get(h1));
+    ASSERT_NE(nullptr, table.get(h2));
+    EXPECT_EQ(1, *table.get(h1));
+    EXPECT_EQ(2, *table.get(h2));
+
+    Handle invalid;
+    EXPECT_EQ(nullptr, table.get(invalid));
+    EXPECT_EQ(nullptr, table.get(Handle(100)));
+}
+
+TEST_F(THandleTableTest, staleHandleTest) {
+    THandleTable<i32> table;
+    Handle h1 = table.add(1);
+    EXPECT_TRUE(table.remove(h1));
+    EXPECT_FALSE(table.isValid(h1));
+    EXPECT_EQ(nullptr, table.get(h1));
+    EXPECT_FALSE(table.remove(h1));
+
+    // The slot gets reused, the old handle must stay stale
+    Handle h2 = table.add(2);
+    EXPECT_EQ(h1.m_idx, h2.m_idx);
+    EXPECT_NE(h1, h2);
+    EXPECT_EQ(nullptr, table.get(h1));
+    EXPECT_EQ(2, *table.get(h2));
+    EXPECT_EQ(1u, table.capacity());
+}
+
+TEST_F(THandleTableTest, clearTest) {
+    THandleTable<i32> table;
+    Handle h1 = table.add(1);
+    Handle h2 = table.add(2);
+    table.clear();
+    EXPECT_EQ(0u, table.size());
+    EXPECT_FALSE(table.isValid(h1));
+    EXPECT_FALSE(table.isValid(h2));
+
+    Handle h3 = table.add(3);
+    EXPECT_EQ(3, *table.get(h3));
+    EXPECT_EQ(nullptr, table.get(h1));
+    EXPECT_EQ(nullptr, table.get(h2));
+}
+
+} // Namespace UnitTest
+} // Namespace OSRE
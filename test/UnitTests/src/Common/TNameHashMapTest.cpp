@@ -0,0 +1,100 @@
+/*-----------------------------------------------------------------------------------------------
+The MIT License (MIT)
+
+Copyright (c) 2015-2022 OSRE ( Open Source Render Engine ) by Kim Kulling
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of
+this software and associated documentation files (the "Software"), to deal in
+the Software without restriction, including without limitation the rights to
+use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+the Software, and to permit persons to whom the Software is furnished to do so,
+subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+-----------------------------------------------------------------------------------------------*/
+#include "osre_testcommon.h"
+#include <osre/Common/TNameHashMap.h>
+
+namespace OSRE {
+namespace UnitTest {
+
+using namespace ::OSRE::Common;
+
+class TNameHashMapTest : public ::testing::Test {
+    // empty
+};
+
+TEST_F(TNameHashMapTest, insertGetTest) {
+    TNameHashMap<i32> map;
+    EXPECT_EQ(0u, map.size());
+    EXPECT_TRUE(map.insert("a", 1));
+    EXPECT_TRUE(map.insert("b", 2));
+    EXPECT_FALSE(map.insert("a", 3));
+    EXPECT_FALSE(map.insert("", 4));
+    EXPECT_EQ(2u, map.size());
+
+    i32 value = 0;
+    EXPECT_TRUE(map.getValue("a", value));
+    EXPECT_EQ(1, value);
+    EXPECT_TRUE(map.getValue("b", value));
+    EXPECT_EQ(2, value);
+    EXPECT_FALSE(map.getValue("c", value));
+    EXPECT_FALSE(map.hasKey(""));
+}
+
+TEST_F(TNameHashMapTest, collisionTest) {
+    // The name hash ignores the case, so both names have the same hash
+    const String name1 = "diffuse";
+    const String name2 = "DIFFUSE";
+    ASSERT_EQ(StringUtils::hashName(name1), StringUtils::hashName(name2));
+
+    TNameHashMap<i32> map;
+    EXPECT_TRUE(map.insert(name1, 1));
+    EXPECT_TRUE(map.insert(name2, 2));
+    EXPECT_EQ(2u, map.size());
+
+    i32 value = 0;
+    EXPECT_TRUE(map.getValue(name1, value));
+    EXPECT_EQ(1, value);
+    EXPECT_TRUE(map.getValue(name2, value));
+    EXPECT_EQ(2, value);
+
+    EXPECT_TRUE(map.remove(name1));
+    EXPECT_FALSE(map.hasKey(name1));
+    EXPECT_TRUE(map.getValue(name2, value));
+    EXPECT_EQ(2, value);
+    EXPECT_FALSE(map.remove(name1));
+}
+
+TEST_F(TNameHashMapTest, removeClearTest) {
+    TNameHashMap<i32> map;
+    EXPECT_TRUE(map.insert("a", 1));
+    EXPECT_TRUE(map.insert("b", 2));
+    EXPECT_TRUE(map.insert("c", 3));
+
+    // The bucket of the last name moves into the slot of the removed one
+    EXPECT_TRUE(map.remove("a"));
+    i32 value = 0;
+    EXPECT_TRUE(map.getValue("c", value));
+    EXPECT_EQ(3, value);
+    EXPECT_TRUE(map.remove("c"));
+    EXPECT_TRUE(map.getValue("b", value));
+    EXPECT_EQ(2, value);
+    EXPECT_EQ(1u, map.size());
+
+    map.clear();
+    EXPECT_EQ(0u, map.size());
+    EXPECT_FALSE(map.hasKey("b"));
+    EXPECT_TRUE(map.insert("b", 4));
+}
+
+} // Namespace UnitTest
+} // Namespace OSRE
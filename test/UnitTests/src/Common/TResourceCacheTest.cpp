@@ -0,0 +1,270 @@
+/*-----------------------------------------------------------------------------------------------
+The MIT License (MIT)
+
+Copyright (c) 2015-2022 OSRE ( Open Source Render Engine ) by Kim Kulling
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of
+this software and associated documentation files (the "Software"), to deal in
+the Software without restriction, including without limitation the rights to
+use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+the Software, and to permit persons to whom the Software is furnished to do so,
+subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+-----------------------------------------------------------------------------------------------*/
+#include "osre_testcommon.h"
+#include <osre/Common/TResource.h>
+#include <osre/Common/TResourceCache.h>
+#include <osre/Threading/JobSystem.h>
+
+#include <atomic>
+
+namespace OSRE {
+namespace UnitTest {
+
+using namespace ::OSRE::Common;
+
+static const size_t ResourceSize = 1000;
+
+struct TestData {
+    size_t mSize;
+};
+
+class TestLoader {
+public:
+    size_t load(const IO::Uri &, TestData *data) {
+        data->mSize = ResourceSize;
+        return ResourceSize;
+    }
+};
+
+class TestResource : public TResource<TestData, TestLoader> {
+public:
+    static ui32 sNumDeleted;
+
+    TestResource(const String &name, const IO::Uri &uri) :
+            TResource(name, uri) {
+        // empty
+    }
+
+    ~TestResource() override {
+        ++sNumDeleted;
+    }
+
+protected:
+    ResourceState onLoad(const IO::Uri &uri, TestLoader &loader) override {
+        if (ResourceState::Loaded == getState()) {
+            return getState();
+        }
+        getStats().m_memory = loader.load(uri, create());
+        setState(ResourceState::Loaded);
+
+        return getState();
+    }
+
+    ResourceState onUnload(TestLoader &) override {
+        getStats().m_memory = 0;
+        setState(ResourceState::Unloaded);
+
+        return getState();
+    }
+};
+
+ui32 TestResource::sNumDeleted = 0;
+
+// Loads on the job system, the job does not finish before the gate is opened
+class AsyncTestResource : public TestResource {
+public:
+    static std::atomic<bool> sGate;
+
+    AsyncTestResource(const String &name, const IO::Uri &uri) :
+            TestResource(name, uri) {
+        // empty
+    }
+
+    ResourceState loadAsync() override {
+        setState(ResourceState::Loading);
+        Threading::JobSystem *jobSystem = Threading::JobSystem::getInstance();
+        jobSystem->run(jobSystem->createJob(onLoadJob, this));
+
+        return getState();
+    }
+
+private:
+    static void onLoadJob(void *data) {
+        while (!sGate.load()) {
+            std::this_thread::yield();
+        }
+        AsyncTestResource *res = static_cast<AsyncTestResource *>(data);
+        TestLoader loader;
+        res->getStats().m_memory = loader.load(res->getUri(), res->create());
+        res->setState(ResourceState::Loaded);
+    }
+};
+
+std::atomic<bool> AsyncTestResource::sGate(false);
+
+// Reports its loaded instance as used outside of the cache, like a texture waiting for the upload
+class PinnedTestResource : public TestResource {
+public:
+    bool mInUse;
+
+    PinnedTestResource(const String &name, const IO::Uri &uri) :
+            TestResource(name, uri),
+            mInUse(true) {
+        // empty
+    }
+
+    bool isInUse() const override {
+        return mInUse;
+    }
+};
+
+using TestCache = TResourceCache<TResourceFactory<TestResource>, TestResource>;
+using AsyncTestCache = TResourceCache<TResourceFactory<AsyncTestResource>, AsyncTestResource>;
+using PinnedTestCache = TResourceCache<TResourceFactory<PinnedTestResource>, PinnedTestResource>;
+
+class TResourceCacheTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        TestResource::sNumDeleted = 0;
+    }
+};
+
+TEST_F(TResourceCacheTest, createFindTest) {
+    TestCache cache;
+    TestResource *res = cache.create("a");
+    ASSERT_NE(nullptr, res);
+    EXPECT_EQ(res, cache.find("a"));
+    EXPECT_EQ(res, cache.create("a"));
+    EXPECT_EQ(nullptr, cache.find("b"));
+    EXPECT_EQ(nullptr, cache.find(""));
+    EXPECT_EQ(1u, cache.getNumResources());
+    EXPECT_EQ(0u, cache.getRefCount("a"));
+
+    cache.clear();
+    EXPECT_EQ(0u, cache.getNumResources());
+    EXPECT_EQ(1u, TestResource::sNumDeleted);
+}
+
+TEST_F(TResourceCacheTest, hashCollisionTest) {
+    // The name hash ignores the case, so both names have the same hash
+    ASSERT_EQ(StringUtils::hashName("tex"), StringUtils::hashName("TEX"));
+
+    TestCache cache;
+    TestResource *res1 = cache.acquire("tex");
+    TestResource *res2 = cache.acquire("TEX");
+    ASSERT_NE(nullptr, res1);
+    ASSERT_NE(nullptr, res2);
+    EXPECT_NE(res1, res2);
+    EXPECT_EQ(res1, cache.find("tex"));
+    EXPECT_EQ(res2, cache.find("TEX"));
+    EXPECT_EQ(2u, cache.getNumResources());
+
+    cache.setMemoryBudget(ResourceSize);
+    EXPECT_TRUE(cache.release(res1));
+    EXPECT_EQ(nullptr, cache.find("tex"));
+    EXPECT_EQ(res2, cache.find("TEX"));
+    EXPECT_EQ(1u, cache.getRefCount("TEX"));
+}
+
+TEST_F(TResourceCacheTest, refCountTest) {
+    TestCache cache;
+    TestResource *res = cache.acquire("a");
+    ASSERT_NE(nullptr, res);
+    EXPECT_EQ(res, cache.acquire("a"));
+    EXPECT_EQ(2u, cache.getRefCount("a"));
+
+    // Without a job system the resource is loaded at once
+    EXPECT_EQ(ResourceState::Loaded, res->getState());
+    EXPECT_EQ(ResourceSize, res->getMemory());
+    EXPECT_EQ(ResourceSize, cache.getMemoryUsage());
+
+    EXPECT_TRUE(cache.release(res));
+    EXPECT_TRUE(cache.release(res));
+    EXPECT_FALSE(cache.release(res));
+    EXPECT_EQ(0u, cache.getRefCount("a"));
+    EXPECT_EQ(res, cache.find("a"));
+}
+
+TEST_F(TResourceCacheTest, lruEvictionTest) {
+    TestCache cache;
+    cache.setMemoryBudget(ResourceSize * 5 / 2);
+    TestResource *a = cache.acquire("a");
+    TestResource *b = cache.acquire("b");
+    TestResource *c = cache.acquire("c");
+
+    // Referenced resources are kept, even above the budget
+    EXPECT_EQ(0u, cache.trim());
+    EXPECT_EQ(3 * ResourceSize, cache.getMemoryUsage());
+
+    cache.release(a);
+    EXPECT_EQ(nullptr, cache.find("a"));
+    EXPECT_EQ(1u, TestResource::sNumDeleted);
+    EXPECT_EQ(2 * ResourceSize, cache.getMemoryUsage());
+    cache.release(b);
+    cache.release(c);
+    EXPECT_EQ(2u, cache.getNumResources());
+
+    // b was used last, so c goes first
+    cache.release(cache.acquire("b"));
+    cache.setMemoryBudget(ResourceSize);
+    EXPECT_EQ(1u, cache.trim());
+    EXPECT_EQ(nullptr, cache.find("c"));
+    EXPECT_NE(nullptr, cache.find("b"));
+    EXPECT_EQ(ResourceSize, cache.getMemoryUsage());
+}
+
+TEST_F(TResourceCacheTest, inUseNotEvictedTest) {
+    PinnedTestCache cache;
+    cache.setMemoryBudget(0);
+    PinnedTestResource *res = cache.acquire("a");
+    ASSERT_NE(nullptr, res);
+
+    // Still used outside of the cache, so it survives the release
+    EXPECT_TRUE(cache.release(res));
+    EXPECT_EQ(0u, cache.trim());
+    EXPECT_EQ(res, cache.find("a"));
+    EXPECT_EQ(0u, TestResource::sNumDeleted);
+
+    res->mInUse = false;
+    EXPECT_EQ(1u, cache.trim());
+    EXPECT_EQ(nullptr, cache.find("a"));
+    EXPECT_EQ(1u, TestResource::sNumDeleted);
+}
+
+TEST_F(TResourceCacheTest, asyncLoadTest) {
+    EXPECT_TRUE(Threading::JobSystem::create(2));
+    AsyncTestResource::sGate = false;
+    {
+        AsyncTestCache cache;
+        cache.setMemoryBudget(0);
+        AsyncTestResource *res = cache.acquire("a");
+        ASSERT_NE(nullptr, res);
+        EXPECT_EQ(ResourceState::Loading, res->getState());
+        EXPECT_EQ(0u, res->getMemory());
+
+        // Not evicted while loading, even without a reference
+        EXPECT_TRUE(cache.release(res));
+        EXPECT_EQ(res, cache.find("a"));
+
+        AsyncTestResource::sGate = true;
+        EXPECT_EQ(ResourceState::Loaded, res->waitForLoad());
+        EXPECT_EQ(ResourceSize, res->getMemory());
+        EXPECT_EQ(1u, cache.trim());
+        EXPECT_EQ(0u, cache.getNumResources());
+        EXPECT_EQ(0u, cache.getMemoryUsage());
+    }
+    EXPECT_TRUE(Threading::JobSystem::destroy());
+}
+
+} // Namespace UnitTest
+} // Namespace OSRE
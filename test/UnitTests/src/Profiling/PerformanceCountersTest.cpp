@@ -23,6 +23,8 @@ CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
 #include "osre_testcommon.h"
 #include <osre/Profiling/PerformanceCounterRegistry.h>
 
+#include <thread>
+
 namespace OSRE {
 namespace UnitTest {
 
@@ -110,5 +112,38 @@ TEST_F( PerformanceCountersTest, resetCounterTest ) {
     EXPECT_TRUE( ok );
 }
 
+TEST_F( PerformanceCountersTest, concurrentAccessTest ) {
+    bool ok = PerformanceCounterRegistry::create();
+    EXPECT_TRUE( ok );
+
+    static const ui32 NumUpdates = 10000;
+    std::thread writer( []() {
+        // A second thread registers and updates its own counter, like the render thread does
+        PerformanceCounterRegistry::registerCounter( "writer" );
+        for ( ui32 i = 0; i < NumUpdates; ++i ) {
+            PerformanceCounterRegistry::addValueToCounter( "writer", 1 );
+        }
+    } );
+
+    ok = PerformanceCounterRegistry::registerCounter( TestKey );
+    EXPECT_TRUE( ok );
+    ui32 v( 0 );
+    for ( ui32 i = 0; i < NumUpdates; ++i ) {
+        PerformanceCounterRegistry::addValueToCounter( TestKey, 1 );
+        PerformanceCounterRegistry::queryCounter( "writer", v );
+    }
+    writer.join();
+
+    ok = PerformanceCounterRegistry::queryCounter( TestKey, v );
+    EXPECT_TRUE( ok );
+    EXPECT_EQ( NumUpdates, v );
+    ok = PerformanceCounterRegistry::queryCounter( "writer", v );
+    EXPECT_TRUE( ok );
+    EXPECT_EQ( NumUpdates, v );
+
+    ok = PerformanceCounterRegistry::destroy();
+    EXPECT_TRUE( ok );
+}
+
 } // Namespace UnitTest
 } // Namespace OSRE
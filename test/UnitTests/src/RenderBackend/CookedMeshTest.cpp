@@ -0,0 +1,186 @@
+/*-----------------------------------------------------------------------------------------------
+The MIT License (MIT)
+
+Copyright (c) 2015-2022 OSRE ( Open Source Render Engine ) by Kim Kulling
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of
+this software and associated documentation files (the "Software"), to deal in
+the Software without restriction, including without limitation the rights to
+use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+the Software, and to permit persons to whom the Software is furnished to do so,
+subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+-----------------------------------------------------------------------------------------------*/
+#include "osre_testcommon.h"
+#include <osre/RenderBackend/CookedMesh.h>
+#include <osre/RenderBackend/Mesh.h>
+#include "src/Engine/IO/FileStream.h"
+#include "src/Engine/IO/MappedFileStream.h"
+
+#include <cstdio>
+#include <cstring>
+
+namespace OSRE {
+namespace UnitTest {
+
+using namespace ::OSRE::RenderBackend;
+using namespace ::OSRE::IO;
+
+class CookedMeshTest : public ::testing::Test {
+protected:
+    static const ui32 NumQuads = 10;
+
+    MeshArray mMeshes;
+    MeshArray mLoaded;
+
+    void SetUp() override {
+        // A row of quads, the second mesh has no index buffer
+        Mesh *mesh = new Mesh("quads", VertexType::RenderVertex, IndexType::UnsignedShort);
+        RenderVert vertices[NumQuads * 4];
+        ui16 indices[NumQuads * 6];
+        for (ui32 i = 0; i < NumQuads; ++i) {
+            const f32 x = static_cast<f32>(i);
+            vertices[i * 4 + 0].position = glm::vec3(x, 0, 0);
+            vertices[i * 4 + 1].position = glm::vec3(x + 1, 0, 0);
+            vertices[i * 4 + 2].position = glm::vec3(x + 1, 1, 0);
+            vertices[i * 4 + 3].position = glm::vec3(x, 1, -1);
+            const ui16 base = static_cast<ui16>(i * 4);
+            const ui16 quad[6] = { base, static_cast<ui16>(base + 1), static_cast<ui16>(base + 2),
+                base, static_cast<ui16>(base + 2), static_cast<ui16>(base + 3) };
+            ::memcpy(&indices[i * 6], quad, sizeof(quad));
+        }
+        mesh->createVertexBuffer(vertices, sizeof(vertices), BufferAccessType::ReadOnly);
+        mesh->createIndexBuffer(indices, sizeof(indices), IndexType::UnsignedShort, BufferAccessType::ReadOnly);
+        mesh->addPrimitiveGroup(NumQuads * 3, PrimitiveType::TriangleList, 0);
+        mesh->addPrimitiveGroup(NumQuads * 3, PrimitiveType::TriangleList, NumQuads * 3);
+        mesh->setModelMatrix(true, glm::translate(glm::mat4(1.0f), glm::vec3(1, 2, 3)));
+        mMeshes.add(mesh);
+
+        Mesh *points = new Mesh("points", VertexType::ColorVertex, IndexType::UnsignedInt);
+        ColorVert colorVertices[3];
+        points->createVertexBuffer(colorVertices, sizeof(colorVertices), BufferAccessType::ReadWrite);
+        mMeshes.add(points);
+    }
+
+    void TearDown() override {
+        for (size_t i = 0; i < mMeshes.size(); ++i) {
+            delete mMeshes[i];
+        }
+        for (size_t i = 0; i < mLoaded.size(); ++i) {
+            delete mLoaded[i];
+        }
+    }
+
+    void expectEqual(BufferData *expected, BufferData *loaded) {
+        if (nullptr == expected) {
+            EXPECT_EQ(nullptr, loaded);
+            return;
+        }
+        ASSERT_NE(nullptr, loaded);
+        ASSERT_EQ(expected->getSize(), loaded->getSize());
+        EXPECT_EQ(0, ::memcmp(expected->getData(), loaded->getData(), expected->getSize()));
+        EXPECT_EQ(expected->getBufferAccessType(), loaded->getBufferAccessType());
+    }
+
+    void expectRoundTrip() {
+        ASSERT_EQ(mMeshes.size(), mLoaded.size());
+        for (size_t i = 0; i < mMeshes.size(); ++i) {
+            Mesh *expected = mMeshes[i], *loaded = mLoaded[i];
+            EXPECT_EQ(expected->getName(), loaded->getName());
+            EXPECT_EQ(expected->getVertexType(), loaded->getVertexType());
+            EXPECT_EQ(expected->getIndexType(), loaded->getIndexType());
+            EXPECT_EQ(expected->isLocal(), loaded->isLocal());
+            EXPECT_EQ(expected->getLocalMatrix(), loaded->getLocalMatrix());
+            expectEqual(expected->getVertexBuffer(), loaded->getVertexBuffer());
+            expectEqual(expected->getIndexBuffer(), loaded->getIndexBuffer());
+            ASSERT_EQ(expected->getNumberOfPrimitiveGroups(), loaded->getNumberOfPrimitiveGroups());
+            for (size_t j = 0; j < expected->getNumberOfPrimitiveGroups(); ++j) {
+                EXPECT_EQ(expected->getPrimitiveGroupAt(j)->m_primitive, loaded->getPrimitiveGroupAt(j)->m_primitive);
+                EXPECT_EQ(expected->getPrimitiveGroupAt(j)->m_startIndex, loaded->getPrimitiveGroupAt(j)->m_startIndex);
+                EXPECT_EQ(expected->getPrimitiveGroupAt(j)->m_numIndices, loaded->getPrimitiveGroupAt(j)->m_numIndices);
+            }
+            EXPECT_FALSE(loaded->isAABBDirty());
+        }
+    }
+};
+
+TEST_F(CookedMeshTest, roundTripTest) {
+    const Uri uri("file://./CookedMeshTest.osmc");
+    FileStream writer(uri, Stream::AccessMode::WriteAccessBinary);
+    ASSERT_TRUE(writer.open());
+    EXPECT_TRUE(CookedMesh::save(mMeshes, writer));
+    writer.close();
+
+    // Mapped
+    MappedFileStream mapped(uri);
+    ASSERT_TRUE(mapped.open());
+    EXPECT_EQ(0u, mapped.getSize() % CookedMesh::Alignment);
+    EXPECT_TRUE(CookedMesh::load(mapped, mLoaded));
+    mapped.close();
+    expectRoundTrip();
+    const Common::AABB &aabb = mLoaded[0]->getAABB();
+    EXPECT_FLOAT_EQ(0.0f, aabb.getMin().x);
+    EXPECT_FLOAT_EQ(-1.0f, aabb.getMin().z);
+    EXPECT_FLOAT_EQ(static_cast<f32>(NumQuads), aabb.getMax().x);
+    for (size_t i = 0; i < mLoaded.size(); ++i) {
+        delete mLoaded[i];
+    }
+    mLoaded.clear();
+
+    // Read into memory
+    FileStream reader(uri, Stream::AccessMode::ReadAccessBinary);
+    ASSERT_TRUE(reader.open());
+    CPPCore::TArray<String> materialRefs;
+    EXPECT_TRUE(CookedMesh::load(reader, mLoaded, &materialRefs));
+    reader.close();
+    expectRoundTrip();
+    EXPECT_EQ(mMeshes.size(), materialRefs.size());
+
+    ::remove("./CookedMeshTest.osmc");
+}
+
+TEST_F(CookedMeshTest, rejectBrokenDataTest) {
+    const Uri uri("file://./CookedMeshTest_broken.osmc");
+    FileStream writer(uri, Stream::AccessMode::WriteAccessBinary);
+    ASSERT_TRUE(writer.open());
+    EXPECT_TRUE(CookedMesh::save(mMeshes, writer));
+    writer.close();
+
+    MappedFileStream mapped(uri);
+    ASSERT_TRUE(mapped.open());
+    const size_t size = mapped.getSize();
+    std::vector<uc8> data(size);
+    ::memcpy(data.data(), mapped.map(), size);
+    mapped.close();
+    ::remove("./CookedMeshTest_broken.osmc");
+
+    // Truncated
+    EXPECT_FALSE(CookedMesh::load(data.data(), size / 2, mLoaded));
+    EXPECT_TRUE(mLoaded.isEmpty());
+
+    // Unknown version
+    std::vector<uc8> broken(data);
+    broken[4] = 99;
+    EXPECT_FALSE(CookedMesh::load(broken.data(), size, mLoaded));
+
+    // No cooked file
+    broken = data;
+    broken[0] = 'X';
+    EXPECT_FALSE(CookedMesh::load(broken.data(), size, mLoaded));
+    EXPECT_TRUE(mLoaded.isEmpty());
+
+    EXPECT_TRUE(CookedMesh::load(data.data(), size, mLoaded));
+    expectRoundTrip();
+}
+
+} // Namespace UnitTest
+} // Namespace OSRE
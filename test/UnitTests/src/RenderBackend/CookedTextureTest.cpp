@@ -0,0 +1,171 @@
+/*-----------------------------------------------------------------------------------------------
+The MIT License (MIT)
+
+Copyright (c) 2015-2022 OSRE ( Open Source Render Engine ) by Kim Kulling
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of
+this software and associated documentation files (the "Software"), to deal in
+the Software without restriction, including without limitation the rights to
+use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+the Software, and to permit persons to whom the Software is furnished to do so,
+subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+-----------------------------------------------------------------------------------------------*/
+#include "osre_testcommon.h"
+#include <osre/RenderBackend/CookedTexture.h>
+#include <osre/RenderBackend/TextureCompression.h>
+#include "src/Engine/IO/FileStream.h"
+#include "src/Engine/IO/MappedFileStream.h"
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <vector>
+
+namespace OSRE {
+namespace UnitTest {
+
+using namespace ::OSRE::RenderBackend;
+using namespace ::OSRE::IO;
+
+static const ui32 Width = 64;
+static const ui32 Height = 24;
+
+class CookedTextureTest : public ::testing::Test {
+protected:
+    std::vector<uc8> mPixels;
+    Texture mTexture;
+
+    void SetUp() override {
+        mPixels.resize(Width * Height * 4);
+        for (size_t i = 0; i < mPixels.size(); ++i) {
+            mPixels[i] = static_cast<uc8>((i * 7) & 0xff);
+        }
+    }
+
+    void TearDown() override {
+        // The loaded data is released like the one of stb_image
+        ::free(mTexture.m_data);
+        mTexture.m_data = nullptr;
+    }
+
+    std::vector<uc8> cook(PixelFormatType format, ui32 channels) {
+        const Uri uri("file://./CookedTextureTest.ostc");
+        FileStream writer(uri, Stream::AccessMode::WriteAccessBinary);
+        EXPECT_TRUE(writer.open());
+        EXPECT_TRUE(CookedTexture::cook(mPixels.data(), Width, Height, channels, format, writer));
+        writer.close();
+
+        MappedFileStream mapped(uri);
+        EXPECT_TRUE(mapped.open());
+        std::vector<uc8> data(mapped.getSize());
+        if (!data.empty()) {
+            ::memcpy(data.data(), mapped.map(), data.size());
+        }
+        mapped.close();
+        ::remove("./CookedTextureTest.ostc");
+
+        return data;
+    }
+};
+
+TEST_F(CookedTextureTest, cookCompressedTest) {
+    const Uri uri("file://./CookedTextureTest_bc3.ostc");
+    FileStream writer(uri, Stream::AccessMode::WriteAccessBinary);
+    ASSERT_TRUE(writer.open());
+    EXPECT_TRUE(CookedTexture::cook(mPixels.data(), Width, Height, 4, PixelFormatType::BC3, writer));
+    writer.close();
+
+    MappedFileStream mapped(uri);
+    ASSERT_TRUE(mapped.open());
+    EXPECT_TRUE(CookedTexture::load(mapped, mTexture));
+    mapped.close();
+    ::remove("./CookedTextureTest_bc3.ostc");
+
+    EXPECT_EQ(PixelFormatType::BC3, mTexture.mPixelFormat);
+    EXPECT_EQ(Width, mTexture.m_width);
+    EXPECT_EQ(Height, mTexture.m_height);
+    EXPECT_EQ(4u, mTexture.m_channels);
+    EXPECT_EQ(TextureCompression::getNumMipLevels(Width, Height), mTexture.mNumMipLevels);
+
+    // The first level is the encoded image, the last one a single block
+    std::vector<uc8> blocks(TextureCompression::getImageSize(PixelFormatType::BC3, Width, Height));
+    TextureCompression::encode(PixelFormatType::BC3, mPixels.data(), Width, Height, 4, blocks.data());
+    ASSERT_NE(nullptr, mTexture.m_data);
+    EXPECT_EQ(0, ::memcmp(blocks.data(), mTexture.m_data, blocks.size()));
+    size_t size = 0;
+    for (ui32 i = 0; i < mTexture.mNumMipLevels; ++i) {
+        const ui32 w = (Width >> i) > 0 ? Width >> i : 1;
+        const ui32 h = (Height >> i) > 0 ? Height >> i : 1;
+        size += TextureCompression::getImageSize(PixelFormatType::BC3, w, h);
+    }
+    EXPECT_EQ(size, mTexture.m_size);
+}
+
+TEST_F(CookedTextureTest, cookUncompressedTest) {
+    std::vector<uc8> data = cook(PixelFormatType::R8G8B8A8, 4);
+    ASSERT_FALSE(data.empty());
+    EXPECT_EQ(0u, data.size() % CookedTexture::Alignment);
+    EXPECT_TRUE(CookedTexture::load(data.data(), data.size(), mTexture));
+
+    // The second level follows the first one directly
+    std::vector<uc8> half((Width / 2) * (Height / 2) * 4);
+    TextureCompression::downsample(mPixels.data(), Width, Height, 4, half.data());
+    EXPECT_EQ(0, ::memcmp(mPixels.data(), mTexture.m_data, mPixels.size()));
+    EXPECT_EQ(0, ::memcmp(half.data(), mTexture.m_data + mPixels.size(), half.size()));
+
+    // Saving the loaded texture gives the same file
+    const Uri uri("file://./CookedTextureTest_saved.ostc");
+    FileStream writer(uri, Stream::AccessMode::WriteAccessBinary);
+    ASSERT_TRUE(writer.open());
+    EXPECT_TRUE(CookedTexture::save(mTexture, writer));
+    writer.close();
+    FileStream reader(uri, Stream::AccessMode::ReadAccessBinary);
+    ASSERT_TRUE(reader.open());
+    std::vector<uc8> saved(reader.getSize());
+    EXPECT_EQ(saved.size(), reader.read(saved.data(), saved.size()));
+    reader.close();
+    ::remove("./CookedTextureTest_saved.ostc");
+    EXPECT_TRUE(saved == data);
+}
+
+TEST_F(CookedTextureTest, rejectBrokenDataTest) {
+    FileStream dummy;
+    EXPECT_FALSE(CookedTexture::cook(mPixels.data(), Width, Height, 4, PixelFormatType::R8G8B8, dummy));
+    EXPECT_FALSE(CookedTexture::cook(mPixels.data(), Width, Height, 4, PixelFormatType::BC7, dummy));
+
+    std::vector<uc8> data = cook(PixelFormatType::BC1, 4);
+    ASSERT_FALSE(data.empty());
+
+    // Truncated
+    EXPECT_FALSE(CookedTexture::load(data.data(), data.size() / 2, mTexture));
+    EXPECT_EQ(nullptr, mTexture.m_data);
+
+    // Unknown version
+    std::vector<uc8> broken(data);
+    broken[4] = 99;
+    EXPECT_FALSE(CookedTexture::load(broken.data(), broken.size(), mTexture));
+
+    // A level which does not match its format
+    broken = data;
+    broken[32 + 8] = static_cast<uc8>(broken[32 + 8] + 1);
+    EXPECT_FALSE(CookedTexture::load(broken.data(), broken.size(), mTexture));
+
+    // No cooked file
+    broken = data;
+    broken[0] = 0;
+    EXPECT_FALSE(CookedTexture::load(broken.data(), broken.size(), mTexture));
+    EXPECT_EQ(nullptr, mTexture.m_data);
+}
+
+} // Namespace UnitTest
+} // Namespace OSRE
@@ -0,0 +1,117 @@
+/*-----------------------------------------------------------------------------------------------
+The MIT License (MIT)
+
+Copyright (c) 2015-2022 OSRE ( Open Source Render Engine ) by Kim Kulling
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of
+this software and associated documentation files (the "Software"), to deal in
+the Software without restriction, including without limitation the rights to
+use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+the Software, and to permit persons to whom the Software is furnished to do so,
+subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+-----------------------------------------------------------------------------------------------*/
+#include "osre_testcommon.h"
+#include <osre/RenderBackend/Mesh.h>
+#include <osre/RenderBackend/MeshProcessor.h>
+#include <osre/Threading/JobSystem.h>
+
+#include <vector>
+
+namespace OSRE {
+namespace UnitTest {
+
+using namespace ::OSRE::Common;
+using namespace ::OSRE::RenderBackend;
+
+class MeshProcessorTest : public ::testing::Test {
+protected:
+    static void fillVertices(std::vector<RenderVert> &vertices) {
+        for (size_t i = 0; i < vertices.size(); ++i) {
+            const f32 t = static_cast<f32>(i);
+            vertices[i].position = glm::vec3(t * 0.5f - 10.0f, -t, (i % 7) * 3.0f);
+            vertices[i].normal = glm::vec3(1000.0f, -1000.0f, 1000.0f);
+        }
+    }
+};
+
+TEST_F(MeshProcessorTest, computeAABBTest) {
+    // Odd sizes cover the scalar tails of the wide loops
+    const size_t sizes[] = { 1, 2, 3, 5, 17, 1031 };
+    for (size_t size : sizes) {
+        std::vector<RenderVert> vertices(size);
+        fillVertices(vertices);
+
+        AABB expected;
+        for (const RenderVert &v : vertices) {
+            expected.merge(v.position);
+        }
+
+        AABB aabb;
+        MeshProcessor::computeAABB(reinterpret_cast<const uc8 *>(&vertices[0]), size, sizeof(RenderVert), aabb);
+        EXPECT_EQ(expected, aabb);
+    }
+}
+
+TEST_F(MeshProcessorTest, computeAABBParallelTest) {
+    std::vector<RenderVert> vertices(MeshProcessor::ParallelThreshold * 4 + 3);
+    fillVertices(vertices);
+
+    AABB expected;
+    for (const RenderVert &v : vertices) {
+        expected.merge(v.position);
+    }
+
+    AABB aabb;
+    MeshProcessor::computeAABB(reinterpret_cast<const uc8 *>(&vertices[0]), vertices.size(), sizeof(RenderVert), aabb);
+    EXPECT_EQ(expected, aabb);
+
+    // Split across the job system workers
+    Threading::JobSystem::create(3);
+    AABB parallelAabb;
+    MeshProcessor::computeAABB(reinterpret_cast<const uc8 *>(&vertices[0]), vertices.size(), sizeof(RenderVert), parallelAabb);
+    Threading::JobSystem::destroy();
+    EXPECT_EQ(expected, parallelAabb);
+}
+
+TEST_F(MeshProcessorTest, cacheAABBTest) {
+    std::vector<RenderVert> vertices(16);
+    fillVertices(vertices);
+    Mesh mesh("test", VertexType::RenderVertex, IndexType::UnsignedShort);
+    mesh.createVertexBuffer(&vertices[0], sizeof(RenderVert) * vertices.size(), BufferAccessType::ReadWrite);
+    EXPECT_TRUE(mesh.isAABBDirty());
+
+    MeshProcessor processor;
+    processor.addMesh(&mesh);
+    EXPECT_TRUE(processor.execute());
+    EXPECT_FALSE(mesh.isAABBDirty());
+    const AABB first = processor.getAABB();
+
+    // Unmarked writes are not seen, the cached box will be used
+    RenderVert *verts = reinterpret_cast<RenderVert *>(mesh.getVertexBuffer()->getData());
+    verts[0].position.x = -100.0f;
+    MeshProcessor cached;
+    cached.addMesh(&mesh);
+    cached.execute();
+    EXPECT_EQ(first, cached.getAABB());
+
+    // A marked range invalidates the box
+    mesh.markVertexRangeDirty(0, sizeof(RenderVert));
+    EXPECT_TRUE(mesh.isAABBDirty());
+    MeshProcessor updated;
+    updated.addMesh(&mesh);
+    updated.execute();
+    EXPECT_FLOAT_EQ(-100.0f, updated.getAABB().getMin().x);
+}
+
+} // Namespace UnitTest
+} // Namespace OSRE
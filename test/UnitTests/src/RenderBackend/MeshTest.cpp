@@ -39,5 +39,25 @@ TEST_F(MeshTest, createPrimitiveGroupsTest) {
     EXPECT_NE(nullptr, mesh->getPrimitiveGroupAt(0));
 }
 
+TEST_F(MeshTest, dirtyVertexRangeTest) {
+    Mesh mesh("test", VertexType::RenderVertex, IndexType::UnsignedShort);
+    EXPECT_FALSE(mesh.hasDirtyVertexRange());
+    EXPECT_EQ(0u, mesh.getDirtyVertexSize());
+
+    mesh.markVertexRangeDirty(64, 32);
+    EXPECT_TRUE(mesh.hasDirtyVertexRange());
+    EXPECT_EQ(64u, mesh.getDirtyVertexOffset());
+    EXPECT_EQ(32u, mesh.getDirtyVertexSize());
+
+    // Ranges get merged
+    mesh.markVertexRangeDirty(16, 8);
+    mesh.markVertexRangeDirty(120, 8);
+    EXPECT_EQ(16u, mesh.getDirtyVertexOffset());
+    EXPECT_EQ(112u, mesh.getDirtyVertexSize());
+
+    mesh.clearDirtyVertexRange();
+    EXPECT_FALSE(mesh.hasDirtyVertexRange());
+}
+
 }
 }
@@ -0,0 +1,108 @@
+/*-----------------------------------------------------------------------------------------------
+The MIT License (MIT)
+
+Copyright (c) 2015-2022 OSRE ( Open Source Render Engine ) by Kim Kulling
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of
+this software and associated documentation files (the "Software"), to deal in
+the Software without restriction, including without limitation the rights to
+use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+the Software, and to permit persons to whom the Software is furnished to do so,
+subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+-----------------------------------------------------------------------------------------------*/
+#include "osre_testcommon.h"
+#include "src/Engine/RenderBackend/NullRenderer/NullRenderEventHandler.h"
+
+#include <osre/RenderBackend/MaterialBuilder.h>
+#include <osre/RenderBackend/Mesh.h>
+#include <osre/RenderBackend/MeshBuilder.h>
+#include <osre/RenderBackend/Pipeline.h>
+#include <osre/RenderBackend/RenderCommon.h>
+#include <osre/RenderBackend/RenderPass.h>
+
+namespace OSRE {
+namespace UnitTest {
+
+using namespace ::OSRE::RenderBackend;
+
+class NullRenderEventHandlerTest : public ::testing::Test {
+    // empty
+};
+
+TEST_F(NullRenderEventHandlerTest, createTest) {
+    NullRenderEventHandler handler;
+    const NullRenderStatistics stats = handler.getStatistics();
+    EXPECT_EQ(0u, stats.m_numFrames);
+    EXPECT_EQ(0u, stats.m_numDrawCalls);
+    EXPECT_EQ(0u, stats.m_numUploadedBytes);
+    EXPECT_EQ(0u, stats.m_numStateChanges);
+}
+
+TEST_F(NullRenderEventHandlerTest, countDrawsTest) {
+    MaterialBuilder::create();
+    MeshBuilder meshBuilder;
+    meshBuilder.allocCube(VertexType::RenderVertex, 1, 1, 1, BufferAccessType::ReadOnly);
+    Mesh *mesh = meshBuilder.getMesh();
+    ASSERT_NE(nullptr, mesh);
+
+    Pipeline pipeline("test");
+    pipeline.addPass(RenderPassFactory::create(RenderPassId));
+
+    NullRenderEventHandler handler;
+    EXPECT_TRUE(handler.onEvent(OnAttachEventHandlerEvent, nullptr));
+    CreateRendererEventData createData(nullptr);
+    createData.m_pipeline = &pipeline;
+    EXPECT_TRUE(handler.onEvent(OnCreateRendererEvent, &createData));
+
+    // one pass, one batch, one mesh
+    MeshEntry *entry = new MeshEntry;
+    entry->numInstances = 0;
+    entry->m_isDirty = true;
+    entry->mMeshArray.add(mesh);
+    RenderBatchData *batch = new RenderBatchData("batch");
+    batch->m_meshArray.add(entry);
+    PassData *pass = new PassData("pass", nullptr);
+    pass->m_geoBatches.add(batch);
+    CPPCore::TArray<PassData *> passes;
+    passes.add(pass);
+
+    Frame frame;
+    frame.init(passes);
+    InitPassesEventData initData;
+    initData.m_frame = &frame;
+    EXPECT_TRUE(handler.onEvent(OnInitPassesEvent, &initData));
+    EXPECT_FALSE(entry->m_isDirty);
+
+    NullRenderStatistics stats = handler.getStatistics();
+    const size_t meshSize = mesh->getVertexBuffer()->getSize() + mesh->getIndexBuffer()->getSize();
+    EXPECT_EQ(meshSize, stats.m_numUploadedBytes);
+
+    EXPECT_TRUE(handler.onEvent(OnRenderFrameEvent, nullptr));
+    EXPECT_TRUE(handler.onEvent(OnRenderFrameEvent, nullptr));
+    stats = handler.getStatistics();
+    EXPECT_EQ(2u, stats.m_numFrames);
+    EXPECT_EQ(2u * mesh->getNumberOfPrimitiveGroups(), stats.m_numDrawCalls);
+    EXPECT_LT(0u, stats.m_numStateChanges);
+
+    EXPECT_TRUE(handler.onEvent(OnDestroyRendererEvent, nullptr));
+    EXPECT_TRUE(handler.onEvent(OnDetatachEventHandlerEvent, nullptr));
+
+    delete pass;
+    delete batch;
+    delete entry;
+    delete mesh;
+    MaterialBuilder::destroy();
+}
+
+} // Namespace UnitTest
+} // Namespace OSRE
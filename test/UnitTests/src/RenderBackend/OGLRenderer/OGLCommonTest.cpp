@@ -0,0 +1,56 @@
+/*-----------------------------------------------------------------------------------------------
+The MIT License (MIT)
+
+Copyright (c) 2015-2022 OSRE ( Open Source Render Engine ) by Kim Kulling
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of
+this software and associated documentation files (the "Software"), to deal in
+the Software without restriction, including without limitation the rights to
+use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+the Software, and to permit persons to whom the Software is furnished to do so,
+subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+-----------------------------------------------------------------------------------------------*/
+#include <gtest/gtest.h>
+#include "src/Engine/RenderBackend/OGLRenderer/OGLCommon.h"
+
+namespace OSRE {
+namespace UnitTest {
+
+using namespace ::OSRE::RenderBackend;
+
+class OGLCommonTest : public ::testing::Test {
+    // empty
+};
+
+TEST_F(OGLCommonTest, parameterIdTest) {
+    const ui32 model = getParameterId("OGLCommonTest_Model");
+    const ui32 view = getParameterId("OGLCommonTest_View");
+    EXPECT_NE(InvalidParameterId, model);
+    EXPECT_NE(InvalidParameterId, view);
+    EXPECT_NE(model, view);
+
+    // Ids are dense, a new name gets the next one
+    EXPECT_EQ(model + 1, view);
+
+    // Interning the same name again returns the same id
+    EXPECT_EQ(model, getParameterId("OGLCommonTest_Model"));
+    EXPECT_EQ(view, findParameterId("OGLCommonTest_View"));
+}
+
+TEST_F(OGLCommonTest, invalidParameterIdTest) {
+    EXPECT_EQ(InvalidParameterId, getParameterId(""));
+    EXPECT_EQ(InvalidParameterId, findParameterId("OGLCommonTest_Unknown"));
+}
+
+} // Namespace UnitTest
+} // Namespace OSRE
@@ -0,0 +1,112 @@
+/*-----------------------------------------------------------------------------------------------
+The MIT License (MIT)
+
+Copyright (c) 2015-2022 OSRE ( Open Source Render Engine ) by Kim Kulling
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of
+this software and associated documentation files (the "Software"), to deal in
+the Software without restriction, including without limitation the rights to
+use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+the Software, and to permit persons to whom the Software is furnished to do so,
+subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+-----------------------------------------------------------------------------------------------*/
+#include <gtest/gtest.h>
+#include "src/Engine/RenderBackend/OGLRenderer/OGLMultiDrawBatch.h"
+#include <osre/Common/glm_common.h>
+
+namespace OSRE {
+namespace UnitTest {
+
+using namespace ::OSRE::RenderBackend;
+
+class OGLMultiDrawBatchTest : public ::testing::Test {
+protected:
+    static OGLPrimGroup createGroup(size_t numIndices, size_t indexOffset, GLint baseVertex) {
+        OGLPrimGroup grp;
+        grp.m_primitive = GL_TRIANGLES;
+        grp.m_indexType = GL_UNSIGNED_SHORT;
+        grp.m_numIndices = numIndices;
+        grp.m_indexOffset = indexOffset;
+        grp.m_firstIndex = static_cast<ui32>(indexOffset / sizeof(ui16));
+        grp.m_baseVertex = baseVertex;
+
+        return grp;
+    }
+};
+
+TEST_F(OGLMultiDrawBatchTest, addTest) {
+    OGLMultiDrawBatch batch;
+    EXPECT_TRUE(batch.isEmpty());
+    EXPECT_EQ(static_cast<GLenum>(GL_NONE), batch.getPrimitive());
+
+    const glm::mat4 model1(1.0f);
+    const glm::mat4 model2 = glm::translate(glm::mat4(1.0f), glm::vec3(1.0f, 2.0f, 3.0f));
+    EXPECT_TRUE(batch.add(createGroup(36, 0, 0), model1));
+    EXPECT_TRUE(batch.add(createGroup(6, 72, 24), model2));
+    EXPECT_EQ(2u, batch.size());
+    EXPECT_EQ(static_cast<GLenum>(GL_TRIANGLES), batch.getPrimitive());
+    EXPECT_EQ(static_cast<GLenum>(GL_UNSIGNED_SHORT), batch.getIndexType());
+
+    // The indirect commands count the offset in indices
+    const DrawElementsIndirectCommand *cmds = batch.getCommands();
+    EXPECT_EQ(36u, cmds[0].m_count);
+    EXPECT_EQ(1u, cmds[0].m_instanceCount);
+    EXPECT_EQ(0u, cmds[0].m_firstIndex);
+    EXPECT_EQ(6u, cmds[1].m_count);
+    EXPECT_EQ(36u, cmds[1].m_firstIndex);
+    EXPECT_EQ(24, cmds[1].m_baseVertex);
+    EXPECT_EQ(0u, cmds[1].m_baseInstance);
+    EXPECT_EQ(model2, batch.getModels()[1]);
+
+    // The fallback arrays count the offset in bytes
+    EXPECT_EQ(6, batch.getCounts()[1]);
+    EXPECT_EQ(reinterpret_cast<const GLvoid *>(72), batch.getIndexOffsets()[1]);
+    EXPECT_EQ(24, batch.getBaseVertices()[1]);
+
+    batch.clear();
+    EXPECT_TRUE(batch.isEmpty());
+    EXPECT_EQ(static_cast<GLenum>(GL_NONE), batch.getIndexType());
+}
+
+TEST_F(OGLMultiDrawBatchTest, incompatibleGroupTest) {
+    OGLMultiDrawBatch batch;
+    EXPECT_TRUE(batch.add(createGroup(3, 0, 0), glm::mat4(1.0f)));
+
+    OGLPrimGroup lines = createGroup(2, 0, 0);
+    lines.m_primitive = GL_LINES;
+    EXPECT_FALSE(batch.canAdd(lines));
+    EXPECT_FALSE(batch.add(lines, glm::mat4(1.0f)));
+
+    OGLPrimGroup wideIndices = createGroup(3, 0, 0);
+    wideIndices.m_indexType = GL_UNSIGNED_INT;
+    EXPECT_FALSE(batch.add(wideIndices, glm::mat4(1.0f)));
+    EXPECT_EQ(1u, batch.size());
+
+    // After a flush every group fits
+    batch.clear();
+    EXPECT_TRUE(batch.add(lines, glm::mat4(1.0f)));
+    EXPECT_EQ(static_cast<GLenum>(GL_LINES), batch.getPrimitive());
+}
+
+TEST_F(OGLMultiDrawBatchTest, fullBatchTest) {
+    OGLMultiDrawBatch batch;
+    for (ui32 i = 0; i < OGLMultiDrawBatch::MaxDraws; ++i) {
+        EXPECT_TRUE(batch.add(createGroup(3, i * 6, i * 3), glm::mat4(1.0f)));
+    }
+    EXPECT_EQ(OGLMultiDrawBatch::MaxDraws, batch.size());
+    EXPECT_FALSE(batch.canAdd(createGroup(3, 0, 0)));
+    EXPECT_EQ(OGLMultiDrawBatch::MaxDraws, batch.size());
+}
+
+} // Namespace UnitTest
+} // Namespace OSRE
@@ -0,0 +1,143 @@
+/*-----------------------------------------------------------------------------------------------
+The MIT License (MIT)
+
+Copyright (c) 2015-2022 OSRE ( Open Source Render Engine ) by Kim Kulling
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of
+this software and associated documentation files (the "Software"), to deal in
+the Software without restriction, including without limitation the rights to
+use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+the Software, and to permit persons to whom the Software is furnished to do so,
+subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+-----------------------------------------------------------------------------------------------*/
+#include <gtest/gtest.h>
+#include "src/Engine/RenderBackend/OGLRenderer/OGLProgramCache.h"
+#include "src/Engine/IO/FileStream.h"
+#include <osre/IO/Uri.h>
+#include <osre/RenderBackend/Shader.h>
+
+#include <cstdio>
+
+namespace OSRE {
+namespace UnitTest {
+
+using namespace ::OSRE::IO;
+using namespace ::OSRE::RenderBackend;
+
+static const c8 *CacheDir = "./";
+static const c8 *DriverId = "OSRE|Test|4.6";
+
+class OGLProgramCacheTest : public ::testing::Test {
+protected:
+    void setSources(Shader &shader, const c8 *vs, const c8 *fs) {
+        shader.setSource(ShaderType::SH_VertexShaderType, vs);
+        shader.setSource(ShaderType::SH_FragmentShaderType, fs);
+    }
+};
+
+TEST_F(OGLProgramCacheTest, disabledWithoutDirectoryTest) {
+    OGLProgramCache cache("", DriverId);
+    EXPECT_FALSE(cache.isEnabled());
+
+    std::vector<uc8> binary(16, 1);
+    EXPECT_FALSE(cache.store(1, 2, binary));
+    GLenum format = 0;
+    EXPECT_FALSE(cache.load(1, format, binary));
+}
+
+TEST_F(OGLProgramCacheTest, keyTest) {
+    OGLProgramCache cache(CacheDir, DriverId);
+    Shader a, b;
+    setSources(a, "void main() {}", "void main() { out = 1; }");
+    setSources(b, "void main() {}", "void main() { out = 1; }");
+    EXPECT_EQ(cache.computeKey(a), cache.computeKey(b));
+
+    // Changed sources or another driver must not reuse the binary
+    setSources(b, "void main() {}", "void main() { out = 2; }");
+    EXPECT_NE(cache.computeKey(a), cache.computeKey(b));
+    OGLProgramCache otherDriver(CacheDir, "OSRE|Test|4.5");
+    EXPECT_NE(cache.computeKey(a), otherDriver.computeKey(a));
+
+    // The same source in another stage is another program
+    Shader c;
+    setSources(c, "void main() { out = 1; }", "void main() {}");
+    EXPECT_NE(cache.computeKey(a), cache.computeKey(c));
+
+    // A binary compiled with the draw id prelude is another program
+    EXPECT_EQ(cache.computeKey(a), cache.computeKey(a, ""));
+    EXPECT_NE(cache.computeKey(a), cache.computeKey(a, "#define OSRE_DRAW_ID gl_DrawIDARB\n"));
+}
+
+TEST_F(OGLProgramCacheTest, storeAndLoadTest) {
+    OGLProgramCache cache(CacheDir, DriverId);
+    ASSERT_TRUE(cache.isEnabled());
+
+    const ui64 key = 0x0123456789abcdefull;
+    std::vector<uc8> binary(100);
+    for (size_t i = 0; i < binary.size(); ++i) {
+        binary[i] = static_cast<uc8>(i * 7);
+    }
+    EXPECT_TRUE(cache.store(key, 0x8741, binary));
+
+    GLenum format = 0;
+    std::vector<uc8> loaded;
+    EXPECT_TRUE(cache.load(key, format, loaded));
+    EXPECT_EQ(0x8741u, format);
+    EXPECT_EQ(binary, loaded);
+
+    // Another key must not find the entry
+    EXPECT_FALSE(cache.load(key + 1, format, loaded));
+
+    cache.remove(key);
+    EXPECT_FALSE(cache.load(key, format, loaded));
+}
+
+TEST_F(OGLProgramCacheTest, rejectTruncatedEntryTest) {
+    OGLProgramCache cache(CacheDir, DriverId);
+    ASSERT_TRUE(cache.isEnabled());
+
+    const ui64 key = 42;
+    std::vector<uc8> binary(64, 3);
+    ASSERT_TRUE(cache.store(key, 1, binary));
+
+    // Rewrite the entry with a header only
+    FileStream stream(Uri("file://" + cache.getFilename(key)), Stream::AccessMode::WriteAccessBinary);
+    ASSERT_TRUE(stream.open());
+    stream.writeUI32(OGLProgramCache::Magic);
+    stream.writeUI32(OGLProgramCache::Version);
+    stream.writeUI32(42);
+    stream.writeUI32(0);
+    stream.writeUI32(1);
+    stream.writeUI32(64);
+    stream.close();
+
+    GLenum format = 0;
+    EXPECT_FALSE(cache.load(key, format, binary));
+    cache.remove(key);
+}
+
+TEST_F(OGLProgramCacheTest, hitRateTest) {
+    OGLProgramCache cache(CacheDir, DriverId);
+    EXPECT_EQ(0u, cache.getHitRate());
+
+    cache.countLookup(false);
+    cache.countLookup(true);
+    cache.countLookup(true);
+    cache.countLookup(true);
+    EXPECT_EQ(3u, cache.getNumHits());
+    EXPECT_EQ(1u, cache.getNumMisses());
+    EXPECT_EQ(75u, cache.getHitRate());
+}
+
+} // Namespace UnitTest
+} // Namespace OSRE
@@ -27,6 +27,9 @@ CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
 #include <osre/RenderBackend/Mesh.h>
 #include <osre/RenderBackend/Material.h>
 #include <osre/Common/glm_common.h>
+#include <osre/Threading/JobSystem.h>
+
+#include <thread>
 
 namespace OSRE {
 namespace UnitTest {
@@ -193,6 +196,47 @@ TEST_F(RenderCommonTest, access_material_param_Test) {
     delete mat;
 }
 
+TEST_F(RenderCommonTest, flipTextureTest) {
+    uc8 data[] = { 1, 2, 3, 4, 5, 6, 7, 8, 9 };
+    TextureLoader::flipVertical(data, 3, 3, 1);
+    const uc8 expected[] = { 7, 8, 9, 4, 5, 6, 1, 2, 3 };
+    for (ui32 i = 0; i < 9; ++i) {
+        EXPECT_EQ(expected[i], data[i]);
+    }
+
+    uc8 twoRows[] = { 1, 2, 3, 4 };
+    TextureLoader::flipVertical(twoRows, 1, 2, 2);
+    EXPECT_EQ(3u, twoRows[0]);
+    EXPECT_EQ(4u, twoRows[1]);
+    EXPECT_EQ(1u, twoRows[2]);
+    EXPECT_EQ(2u, twoRows[3]);
+}
+
+TEST_F(RenderCommonTest, loadTextureAsyncTest) {
+    // Without a job system the texture is loaded at once
+    TextureResource syncRes("missing_sync", IO::Uri("file://missing/texture.png"));
+    EXPECT_EQ(Common::ResourceState::Error, syncRes.loadAsync());
+    ASSERT_NE(nullptr, syncRes.get());
+    EXPECT_EQ(Common::ResourceState::Error, syncRes.get()->mState.load());
+
+    EXPECT_TRUE(Threading::JobSystem::create(2));
+    TextureResource asyncRes("missing_async", IO::Uri("file://missing/texture.png"));
+    const Common::ResourceState state = asyncRes.loadAsync();
+    EXPECT_TRUE(Common::ResourceState::Loading == state || Common::ResourceState::Error == state);
+
+    // The texture is there at once, so materials can reference it
+    Texture *tex = asyncRes.get();
+    ASSERT_NE(nullptr, tex);
+    EXPECT_EQ("missing_async", tex->m_textureName);
+    while (Common::ResourceState::Loading == asyncRes.getState()) {
+        std::this_thread::yield();
+    }
+    EXPECT_EQ(Common::ResourceState::Error, asyncRes.getState());
+    EXPECT_EQ(Common::ResourceState::Error, tex->mState.load());
+    EXPECT_EQ(Common::ResourceState::Error, asyncRes.loadAsync());
+    EXPECT_TRUE(Threading::JobSystem::destroy());
+}
+
 static bool isEqual(c8 *buf, c8 v, ui32 size) {
     bool equal = true;
     for (ui32 i = 0; i < size; ++i) {
@@ -235,6 +279,36 @@ TEST_F(RenderCommonTest, uniformBufferEncodeDecodeTest) {
     EXPECT_EQ(lenData, lenData_out);
 }
 
+TEST_F(RenderCommonTest, instanceDataRangeTest) {
+    RenderBatchData batch("b1");
+    EXPECT_FALSE(batch.hasDirtyInstances());
+
+    glm::mat4 transforms[4];
+    for (ui32 i = 0; i < 4; ++i) {
+        transforms[i] = glm::translate(glm::mat4(1.0f), glm::vec3(static_cast<f32>(i), 0, 0));
+    }
+    batch.setInstanceTransforms(2, 4, transforms);
+    EXPECT_EQ(6u, batch.m_instances.size());
+    EXPECT_TRUE(batch.m_dirtyFlag & RenderBatchData::InstanceDataDirty);
+
+    // The stream has grown, so the whole stream has to be uploaded
+    EXPECT_EQ(0u, batch.getDirtyInstanceOffset());
+    EXPECT_EQ(6u, batch.getDirtyInstanceCount());
+    EXPECT_EQ(glm::mat4(1.0f), batch.m_instances[0].transform);
+    EXPECT_EQ(transforms[3], batch.m_instances[5].transform);
+    batch.clearDirtyInstances();
+
+    // Updates inside the stream will merge into one range
+    const glm::vec4 colors[2] = { glm::vec4(1, 0, 0, 1), glm::vec4(0, 1, 0, 1) };
+    batch.setInstanceColors(4, 1, colors);
+    batch.setInstanceColors(1, 2, colors);
+    EXPECT_EQ(6u, batch.m_instances.size());
+    EXPECT_EQ(1u, batch.getDirtyInstanceOffset());
+    EXPECT_EQ(4u, batch.getDirtyInstanceCount());
+    EXPECT_EQ(colors[1], batch.m_instances[2].color);
+    EXPECT_EQ(glm::vec4(1, 1, 1, 1), batch.m_instances[3].color);
+}
+
 } // Namespace UnitTest
 } // Namespace OSRE
 
@@ -0,0 +1,139 @@
+/*-----------------------------------------------------------------------------------------------
+The MIT License (MIT)
+
+Copyright (c) 2015-2022 OSRE ( Open Source Render Engine ) by Kim Kulling
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of
+this software and associated documentation files (the "Software"), to deal in
+the Software without restriction, including without limitation the rights to
+use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+the Software, and to permit persons to whom the Software is furnished to do so,
+subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+-----------------------------------------------------------------------------------------------*/
+#include "osre_testcommon.h"
+#include <osre/RenderBackend/TextureCompression.h>
+
+#include <cstdlib>
+#include <vector>
+
+namespace OSRE {
+namespace UnitTest {
+
+using namespace ::OSRE::RenderBackend;
+
+class TextureCompressionTest : public ::testing::Test {
+protected:
+    static const ui32 Width = 32;
+    static const ui32 Height = 20;
+
+    std::vector<uc8> mPixels;
+
+    void SetUp() override {
+        // Smooth gradients with red against green, the alpha has a hard edge
+        mPixels.resize(Width * Height * 4);
+        for (ui32 y = 0; y < Height; ++y) {
+            for (ui32 x = 0; x < Width; ++x) {
+                uc8 *pixel = &mPixels[(y * Width + x) * 4];
+                pixel[0] = static_cast<uc8>(x * 255 / (Width - 1));
+                pixel[1] = static_cast<uc8>(255 - x * 255 / (Width - 1));
+                pixel[2] = static_cast<uc8>(y * 4);
+                pixel[3] = static_cast<uc8>(x < Width / 2 ? 0 : 255);
+            }
+        }
+    }
+
+    i32 getMaxError(const std::vector<uc8> &decoded, ui32 channel) const {
+        i32 maxError = 0;
+        for (size_t i = 0; i < Width * Height; ++i) {
+            const i32 error = std::abs(static_cast<i32>(decoded[i * 4 + channel]) - static_cast<i32>(mPixels[i * 4 + channel]));
+            maxError = error > maxError ? error : maxError;
+        }
+
+        return maxError;
+    }
+
+    std::vector<uc8> roundTrip(PixelFormatType format) {
+        std::vector<uc8> blocks(TextureCompression::getImageSize(format, Width, Height));
+        std::vector<uc8> decoded(Width * Height * 4);
+        EXPECT_TRUE(TextureCompression::encode(format, mPixels.data(), Width, Height, 4, blocks.data()));
+        EXPECT_TRUE(TextureCompression::decode(format, blocks.data(), Width, Height, decoded.data()));
+
+        return decoded;
+    }
+};
+
+TEST_F(TextureCompressionTest, imageSizeTest) {
+    EXPECT_TRUE(TextureCompression::isCompressed(PixelFormatType::BC7));
+    EXPECT_FALSE(TextureCompression::isCompressed(PixelFormatType::R8G8B8A8));
+    EXPECT_EQ(32u, TextureCompression::getImageSize(PixelFormatType::BC1, 5, 5));
+    EXPECT_EQ(64u, TextureCompression::getImageSize(PixelFormatType::BC3, 8, 8));
+    EXPECT_EQ(16u, TextureCompression::getImageSize(PixelFormatType::ETC2_RGBA8, 1, 1));
+    EXPECT_EQ(16u, TextureCompression::getImageSize(PixelFormatType::R8G8B8A8, 2, 2));
+    EXPECT_EQ(9u, TextureCompression::getNumMipLevels(256, 64));
+    EXPECT_EQ(1u, TextureCompression::getNumMipLevels(1, 1));
+}
+
+TEST_F(TextureCompressionTest, roundTripTest) {
+    std::vector<uc8> decoded = roundTrip(PixelFormatType::BC1);
+    EXPECT_LE(getMaxError(decoded, 0), 12);
+    EXPECT_LE(getMaxError(decoded, 1), 12);
+    EXPECT_LE(getMaxError(decoded, 2), 12);
+
+    // The alpha edge lies on a block border, so it survives exactly
+    decoded = roundTrip(PixelFormatType::BC3);
+    EXPECT_LE(getMaxError(decoded, 0), 12);
+    EXPECT_EQ(0, getMaxError(decoded, 3));
+
+    decoded = roundTrip(PixelFormatType::BC5);
+    EXPECT_LE(getMaxError(decoded, 0), 4);
+    EXPECT_LE(getMaxError(decoded, 1), 4);
+}
+
+TEST_F(TextureCompressionTest, solidColorTest) {
+    const uc8 pixels[3 * 4] = { 255, 0, 255, 255, 0, 255, 255, 0, 255, 255, 0, 255 };
+    uc8 blocks[8];
+    uc8 decoded[2 * 2 * 4];
+    EXPECT_TRUE(TextureCompression::encode(PixelFormatType::BC1, pixels, 2, 2, 3, blocks));
+    EXPECT_TRUE(TextureCompression::decode(PixelFormatType::BC1, blocks, 2, 2, decoded));
+    for (ui32 i = 0; i < 4; ++i) {
+        EXPECT_EQ(255, decoded[i * 4 + 0]);
+        EXPECT_EQ(0, decoded[i * 4 + 1]);
+        EXPECT_EQ(255, decoded[i * 4 + 2]);
+        EXPECT_EQ(255, decoded[i * 4 + 3]);
+    }
+}
+
+TEST_F(TextureCompressionTest, passThroughFormatsTest) {
+    uc8 blocks[16];
+    EXPECT_FALSE(TextureCompression::canEncode(PixelFormatType::BC7));
+    EXPECT_FALSE(TextureCompression::canDecode(PixelFormatType::ETC2_RGB8));
+    EXPECT_FALSE(TextureCompression::encode(PixelFormatType::BC7, mPixels.data(), 4, 4, 4, blocks));
+}
+
+TEST_F(TextureCompressionTest, downsampleTest) {
+    const uc8 pixels[2 * 2 * 2] = { 0, 10, 100, 20, 50, 30, 250, 40 };
+    uc8 target[2];
+    TextureCompression::downsample(pixels, 2, 2, 2, target);
+    EXPECT_EQ(100, target[0]);
+    EXPECT_EQ(25, target[1]);
+
+    // A single column keeps its width
+    const uc8 column[4] = { 10, 20, 30, 40 };
+    uc8 half[2];
+    TextureCompression::downsample(column, 1, 4, 1, half);
+    EXPECT_EQ(15, half[0]);
+    EXPECT_EQ(35, half[1]);
+}
+
+} // Namespace UnitTest
+} // Namespace OSRE
@@ -0,0 +1,146 @@
+/*-----------------------------------------------------------------------------------------------
+The MIT License (MIT)
+
+Copyright (c) 2015-2022 OSRE ( Open Source Render Engine ) by Kim Kulling
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of
+this software and associated documentation files (the "Software"), to deal in
+the Software without restriction, including without limitation the rights to
+use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+the Software, and to permit persons to whom the Software is furnished to do so,
+subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+-----------------------------------------------------------------------------------------------*/
+#include "osre_testcommon.h"
+#include <osre/RenderBackend/UniformBlock.h>
+
+namespace OSRE {
+namespace UnitTest {
+
+using namespace ::OSRE::RenderBackend;
+
+class UniformBlockTest : public ::testing::Test {
+    // empty
+};
+
+TEST_F(UniformBlockTest, createTest) {
+    UniformBlock block("FrameBlock");
+    EXPECT_EQ(UniformBlockType::FrameBlock, block.getType());
+    EXPECT_EQ(0u, block.getSize());
+    EXPECT_EQ(0u, block.getNumMembers());
+
+    UniformBlock unknown("Custom");
+    EXPECT_EQ(UniformBlockType::InvalidBlockType, unknown.getType());
+}
+
+TEST_F(UniformBlockTest, std140OffsetsTest) {
+    UniformBlock block("MaterialBlock");
+    EXPECT_EQ(0u, block.addMember("a", ParameterType::PT_Float));
+    EXPECT_EQ(16u, block.addMember("b", ParameterType::PT_Float3));
+    EXPECT_EQ(28u, block.addMember("c", ParameterType::PT_Float));
+    EXPECT_EQ(32u, block.addMember("d", ParameterType::PT_Float2));
+    EXPECT_EQ(48u, block.addMember("e", ParameterType::PT_FloatArray, 3));
+    EXPECT_EQ(96u, block.addMember("f", ParameterType::PT_Mat4));
+    EXPECT_EQ(160u, block.addMember("g", ParameterType::PT_Int));
+    EXPECT_EQ(176u, block.getSize());
+
+    const UniformBlock::Member *member = block.findMember("e");
+    ASSERT_NE(nullptr, member);
+    EXPECT_EQ(16u, member->m_arrayStride);
+    EXPECT_EQ(nullptr, block.findMember("x"));
+}
+
+TEST_F(UniformBlockTest, std140MatrixOffsetsTest) {
+    UniformBlock block("MaterialBlock");
+    EXPECT_EQ(0u, block.addMember("a", ParameterType::PT_Float));
+    EXPECT_EQ(16u, block.addMember("b", ParameterType::PT_Float4));
+    EXPECT_EQ(32u, block.addMember("c", ParameterType::PT_Mat3));
+    EXPECT_EQ(80u, block.addMember("d", ParameterType::PT_Float));
+    EXPECT_EQ(96u, block.addMember("e", ParameterType::PT_FloatArray, 2));
+    EXPECT_EQ(128u, block.addMember("f", ParameterType::PT_Float));
+    EXPECT_EQ(144u, block.getSize());
+
+    const UniformBlock::Member *member = block.findMember("c");
+    ASSERT_NE(nullptr, member);
+    EXPECT_EQ(48u, member->m_arrayStride);
+}
+
+TEST_F(UniformBlockTest, setMat3ValueTest) {
+    UniformBlock block("MaterialBlock");
+    block.addMember("normalMat", ParameterType::PT_Mat3);
+    block.clearDirty();
+
+    const f32 mat[9] = { 1.0f, 2.0f, 3.0f, 4.0f, 5.0f, 6.0f, 7.0f, 8.0f, 9.0f };
+    EXPECT_TRUE(block.setValue("normalMat", mat, sizeof(mat)));
+    EXPECT_TRUE(block.isDirty());
+
+    // Every column starts at a vec4 slot
+    const f32 *data = reinterpret_cast<const f32 *>(block.getData());
+    EXPECT_FLOAT_EQ(1.0f, data[0]);
+    EXPECT_FLOAT_EQ(3.0f, data[2]);
+    EXPECT_FLOAT_EQ(4.0f, data[4]);
+    EXPECT_FLOAT_EQ(9.0f, data[10]);
+    EXPECT_EQ(48u, block.getSize());
+}
+
+TEST_F(UniformBlockTest, setValueTest) {
+    UniformBlock block("MaterialBlock");
+    block.addMember("scale", ParameterType::PT_Float);
+    block.addMember("weights", ParameterType::PT_FloatArray, 2);
+    block.clearDirty();
+
+    const f32 scale = 2.0f;
+    EXPECT_TRUE(block.setValue("scale", &scale, sizeof(f32)));
+    EXPECT_TRUE(block.isDirty());
+    block.clearDirty();
+
+    // Same value, nothing to upload
+    EXPECT_TRUE(block.setValue("scale", &scale, sizeof(f32)));
+    EXPECT_FALSE(block.isDirty());
+
+    const f32 weights[2] = { 0.25f, 0.75f };
+    EXPECT_TRUE(block.setValue("weights", weights, sizeof(weights)));
+    EXPECT_TRUE(block.isDirty());
+
+    const f32 *data = reinterpret_cast<const f32 *>(block.getData());
+    EXPECT_FLOAT_EQ(2.0f, data[0]);
+    EXPECT_FLOAT_EQ(0.25f, data[4]);
+    EXPECT_FLOAT_EQ(0.75f, data[8]);
+
+    EXPECT_FALSE(block.setValue("unknown", &scale, sizeof(f32)));
+}
+
+TEST_F(UniformBlockTest, setValueByIndexTest) {
+    UniformBlock block("MaterialBlock");
+    block.addMember("scale", ParameterType::PT_Float);
+    block.addMember("offset", ParameterType::PT_Float2);
+    block.clearDirty();
+
+    const i32 index = block.getMemberIndex("offset");
+    EXPECT_EQ(1, index);
+    EXPECT_EQ(-1, block.getMemberIndex("unknown"));
+    ASSERT_NE(nullptr, block.getMemberAt(index));
+    EXPECT_EQ("offset", block.getMemberAt(index)->m_name);
+    EXPECT_EQ(nullptr, block.getMemberAt(2));
+
+    const f32 offset[2] = { 1.0f, 2.0f };
+    EXPECT_TRUE(block.setValue(static_cast<size_t>(index), offset, sizeof(offset)));
+    EXPECT_TRUE(block.isDirty());
+    const f32 *data = reinterpret_cast<const f32 *>(block.getData());
+    EXPECT_FLOAT_EQ(1.0f, data[2]);
+    EXPECT_FLOAT_EQ(2.0f, data[3]);
+
+    EXPECT_FALSE(block.setValue(static_cast<size_t>(2), offset, sizeof(offset)));
+}
+
+} // Namespace UnitTest
+} // Namespace OSRE
@@ -112,5 +112,85 @@ TEST_F( NodeTest, onUpdateTest ) {
     EXPECT_NE(nullptr, myNode);
 }
 
+TEST_F( NodeTest, createChildTest ) {
+    Node *parent = createNode( "parent", *m_ids, nullptr );
+    Node *child = parent->createChild( "child" );
+    EXPECT_EQ( 1u, parent->getNumChildren() );
+    EXPECT_EQ( child, parent->getChildAt( 0 ) );
+    EXPECT_EQ( parent, child->getParent() );
+}
+
+TEST_F( NodeTest, worldTransformTest ) {
+    Node *parent = createNode( "parent", *m_ids, nullptr );
+    Node *child = createNode( "child", *m_ids, parent );
+    Node *grandChild = createNode( "grandChild", *m_ids, child );
+    parent->translate( glm::vec3( 1, 0, 0 ) );
+    child->translate( glm::vec3( 0, 2, 0 ) );
+    grandChild->scale( glm::vec3( 2, 2, 2 ) );
+
+    glm::vec4 pos = grandChild->getWorlTransformMatrix() * glm::vec4( 1, 1, 1, 1 );
+    EXPECT_FLOAT_EQ( 3.0f, pos.x );
+    EXPECT_FLOAT_EQ( 4.0f, pos.y );
+    EXPECT_FLOAT_EQ( 2.0f, pos.z );
+    EXPECT_FALSE( parent->isWorldTransformDirty() );
+    EXPECT_FALSE( child->isWorldTransformDirty() );
+    EXPECT_FALSE( grandChild->isWorldTransformDirty() );
+
+    // A change is pushed down to all children, but not up to the parent
+    child->translate( glm::vec3( 0, 0, 3 ) );
+    EXPECT_FALSE( parent->isWorldTransformDirty() );
+    EXPECT_TRUE( child->isWorldTransformDirty() );
+    EXPECT_TRUE( grandChild->isWorldTransformDirty() );
+
+    pos = grandChild->getWorlTransformMatrix() * glm::vec4( 1, 1, 1, 1 );
+    EXPECT_FLOAT_EQ( 3.0f, pos.x );
+    EXPECT_FLOAT_EQ( 4.0f, pos.y );
+    EXPECT_FLOAT_EQ( 5.0f, pos.z );
+}
+
+TEST_F( NodeTest, updateWorldTransformsTest ) {
+    Node *root = createNode( "root", *m_ids, nullptr );
+    Node *left = createNode( "left", *m_ids, root );
+    Node *right = createNode( "right", *m_ids, root );
+    Node *leaf = createNode( "leaf", *m_ids, left );
+    root->translate( glm::vec3( 1, 0, 0 ) );
+    left->translate( glm::vec3( 1, 0, 0 ) );
+    right->translate( glm::vec3( 0, 1, 0 ) );
+    leaf->translate( glm::vec3( 1, 0, 0 ) );
+
+    Node::NodeArray queue;
+    root->updateWorldTransforms( queue );
+    EXPECT_EQ( 4u, queue.size() );
+    EXPECT_EQ( root, queue[ 0 ] );
+    EXPECT_EQ( leaf, queue[ 3 ] );
+    for ( size_t i = 0; i < queue.size(); ++i ) {
+        EXPECT_FALSE( queue[ i ]->isWorldTransformDirty() );
+    }
+    EXPECT_FLOAT_EQ( 3.0f, leaf->getWorlTransformMatrix()[ 3 ].x );
+    EXPECT_FLOAT_EQ( 1.0f, right->getWorlTransformMatrix()[ 3 ].y );
+
+    // Nothing changed, so only the root is visited
+    root->updateWorldTransforms( queue );
+    EXPECT_EQ( 1u, queue.size() );
+
+    // Only the changed subtree is visited
+    left->setTransformationMatrix( glm::mat4( 1.0f ) );
+    EXPECT_FALSE( right->isWorldTransformDirty() );
+    root->updateWorldTransforms( queue );
+    EXPECT_EQ( 3u, queue.size() );
+    EXPECT_EQ( left, queue[ 1 ] );
+    EXPECT_EQ( leaf, queue[ 2 ] );
+    EXPECT_FALSE( leaf->isWorldTransformDirty() );
+    EXPECT_FLOAT_EQ( 2.0f, leaf->getWorlTransformMatrix()[ 3 ].x );
+
+    // A lazy read of the parent keeps the way to the dirty children
+    left->translate( glm::vec3( 1, 0, 0 ) );
+    EXPECT_FLOAT_EQ( 2.0f, left->getWorlTransformMatrix()[ 3 ].x );
+    EXPECT_TRUE( leaf->isWorldTransformDirty() );
+    root->updateWorldTransforms( queue );
+    EXPECT_FALSE( leaf->isWorldTransformDirty() );
+    EXPECT_FLOAT_EQ( 3.0f, leaf->getWorlTransformMatrix()[ 3 ].x );
+}
+
 } // Namespace UnitTest
 } // Namespace OSRE
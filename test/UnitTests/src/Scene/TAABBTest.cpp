@@ -147,5 +147,24 @@ TEST_F(TAABBTest, isInTest) {
     EXPECT_FALSE(result);
 }
 
+TEST_F( TAABBTest, boxTest ) {
+    AABB aabb(glm::vec3(0, 0, 0), glm::vec3(2, 2, 2));
+    AABB inner(glm::vec3(0.5f, 0.5f, 0.5f), glm::vec3(1, 1, 1));
+    AABB outer(glm::vec3(3, 3, 3), glm::vec3(4, 4, 4));
+    EXPECT_TRUE(aabb.isIn(inner));
+    EXPECT_FALSE(inner.isIn(aabb));
+    EXPECT_TRUE(aabb.intersects(inner));
+    EXPECT_FALSE(aabb.intersects(outer));
+    EXPECT_FLOAT_EQ(24.0f, aabb.getSurfaceArea());
+
+    // Merging an empty box changes nothing
+    AABB merged(aabb);
+    merged.merge(AABB());
+    EXPECT_EQ(aabb, merged);
+    merged.merge(outer);
+    EXPECT_EQ(glm::vec3(0, 0, 0), merged.getMin());
+    EXPECT_EQ(glm::vec3(4, 4, 4), merged.getMax());
+}
+
 } // Namespace Unittest
 } // Namespace OSRE
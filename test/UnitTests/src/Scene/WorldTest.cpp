@@ -21,7 +21,9 @@ IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
 CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
 -----------------------------------------------------------------------------------------------*/
 #include "osre_testcommon.h"
+#include <osre/App/Entity.h>
 #include <osre/App/World.h>
+#include <osre/Common/Ids.h>
 
 namespace OSRE {
 namespace UnitTest {
@@ -42,5 +44,25 @@ TEST_F( WorldTest, createTest ) {
     EXPECT_TRUE( ok );
 }
 
+TEST_F( WorldTest, addEntityTest ) {
+    Common::Ids ids;
+    World myWorld( "test" );
+    World otherWorld( "other" );
+    Entity *entity = new Entity( "entity", ids, &myWorld );
+    Entity *otherEntity = new Entity( "other", ids, &otherWorld );
+    Entity *freeEntity = new Entity( "free", ids, nullptr );
+
+    // Added ones and entities of other worlds are ignored
+    myWorld.addEntity( entity );
+    myWorld.addEntity( otherEntity );
+    myWorld.addEntity( freeEntity );
+    CPPCore::TArray<Entity *> entities;
+    myWorld.getEntityArray( entities );
+    ASSERT_EQ( 1u, entities.size() );
+    EXPECT_EQ( entity, entities[ 0 ] );
+
+    delete freeEntity;
+}
+
 } // Namespace UnitTest
 } // Namespace OSRE
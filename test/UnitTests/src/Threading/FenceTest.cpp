@@ -0,0 +1,72 @@
+/*-----------------------------------------------------------------------------------------------
+The MIT License (MIT)
+
+Copyright (c) 2015-2022 OSRE ( Open Source Render Engine ) by Kim Kulling
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of
+this software and associated documentation files (the "Software"), to deal in
+the Software without restriction, including without limitation the rights to
+use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+the Software, and to permit persons to whom the Software is furnished to do so,
+subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+-----------------------------------------------------------------------------------------------*/
+#include "osre_testcommon.h"
+#include <osre/Threading/Fence.h>
+
+#include <thread>
+
+namespace OSRE {
+namespace UnitTest {
+
+using namespace ::OSRE::Threading;
+
+class FenceTest : public ::testing::Test {
+    // empty
+};
+
+TEST_F(FenceTest, createTest) {
+    Fence fence;
+    EXPECT_EQ(0u, fence.getValue());
+
+    Fence fence2(5);
+    EXPECT_EQ(5u, fence2.getValue());
+}
+
+TEST_F(FenceTest, signalTest) {
+    Fence fence;
+    fence.signal(2);
+    EXPECT_EQ(2u, fence.getValue());
+
+    // Values are monotonic
+    fence.signal(1);
+    EXPECT_EQ(2u, fence.getValue());
+
+    fence.reset();
+    EXPECT_EQ(0u, fence.getValue());
+}
+
+TEST_F(FenceTest, waitTest) {
+    Fence fence;
+    std::thread producer([&fence]() {
+        for (ui64 i = 1; i <= 100; ++i) {
+            fence.signal(i);
+        }
+    });
+
+    fence.wait(100);
+    EXPECT_EQ(100u, fence.getValue());
+    producer.join();
+}
+
+} // Namespace UnitTest
+} // Namespace OSRE
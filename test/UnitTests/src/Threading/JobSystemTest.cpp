@@ -0,0 +1,188 @@
+/*-----------------------------------------------------------------------------------------------
+The MIT License (MIT)
+
+Copyright (c) 2015-2022 OSRE ( Open Source Render Engine ) by Kim Kulling
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of
+this software and associated documentation files (the "Software"), to deal in
+the Software without restriction, including without limitation the rights to
+use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+the Software, and to permit persons to whom the Software is furnished to do so,
+subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+-----------------------------------------------------------------------------------------------*/
+#include "osre_testcommon.h"
+#include <osre/Threading/JobSystem.h>
+
+#include <atomic>
+#include <thread>
+#include <vector>
+
+namespace OSRE {
+namespace UnitTest {
+
+using namespace ::OSRE::Threading;
+
+class JobSystemTest : public ::testing::Test {
+    // empty
+};
+
+static void incrementJob(void *data) {
+    static_cast<std::atomic<i32> *>(data)->fetch_add(1);
+}
+
+struct OrderData {
+    std::atomic<i32> m_counter;
+    i32 m_first;
+    i32 m_second;
+};
+
+static void firstJob(void *data) {
+    OrderData *order = static_cast<OrderData *>(data);
+    order->m_first = order->m_counter.fetch_add(1);
+}
+
+static void secondJob(void *data) {
+    OrderData *order = static_cast<OrderData *>(data);
+    order->m_second = order->m_counter.fetch_add(1);
+}
+
+TEST_F(JobSystemTest, createTest) {
+    EXPECT_EQ(nullptr, JobSystem::getInstance());
+    EXPECT_TRUE(JobSystem::create(2));
+    EXPECT_FALSE(JobSystem::create(2));
+    ASSERT_NE(nullptr, JobSystem::getInstance());
+    EXPECT_EQ(3u, JobSystem::getInstance()->getNumWorkers());
+    EXPECT_TRUE(JobSystem::destroy());
+    EXPECT_FALSE(JobSystem::destroy());
+    EXPECT_EQ(nullptr, JobSystem::getInstance());
+
+    JobSystem jobSystem;
+    EXPECT_LE(1u, jobSystem.getNumWorkers());
+}
+
+TEST_F(JobSystemTest, runTest) {
+    JobSystem jobSystem(3);
+    std::atomic<i32> counter(0);
+    JobHandle job = jobSystem.createJob(incrementJob, &counter);
+    EXPECT_FALSE(jobSystem.isFinished(job));
+    jobSystem.run(job);
+    jobSystem.waitFor(job);
+    EXPECT_TRUE(jobSystem.isFinished(job));
+    EXPECT_EQ(1, counter.load());
+}
+
+TEST_F(JobSystemTest, childJobTest) {
+    static const i32 NumChildren = 1000;
+
+    JobSystem jobSystem(3);
+    std::atomic<i32> counter(0);
+    JobHandle root = jobSystem.createJob(nullptr, nullptr);
+    for (i32 i = 0; i < NumChildren; ++i) {
+        jobSystem.run(jobSystem.createChildJob(root, incrementJob, &counter));
+    }
+    jobSystem.run(root);
+    jobSystem.waitFor(root);
+    EXPECT_EQ(NumChildren, counter.load());
+}
+
+TEST_F(JobSystemTest, dependencyTest) {
+    JobSystem jobSystem(3);
+    for (ui32 i = 0; i < 100; ++i) {
+        OrderData order;
+        order.m_counter.store(0);
+        order.m_first = -1;
+        order.m_second = -1;
+        JobHandle first = jobSystem.createJob(firstJob, &order);
+        JobHandle second = jobSystem.createJob(secondJob, &order);
+        EXPECT_TRUE(jobSystem.addDependency(second, first));
+
+        // The dependent job is started first, but must wait for its precondition
+        jobSystem.run(second);
+        jobSystem.run(first);
+        jobSystem.waitFor(second);
+        EXPECT_TRUE(jobSystem.isFinished(first));
+        EXPECT_EQ(0, order.m_first);
+        EXPECT_EQ(1, order.m_second);
+    }
+}
+
+TEST_F(JobSystemTest, finishedPreconditionTest) {
+    JobSystem jobSystem(2);
+    std::atomic<i32> counter(0);
+    JobHandle first = jobSystem.createJob(incrementJob, &counter);
+    jobSystem.run(first);
+    jobSystem.waitFor(first);
+
+    // A finished precondition must not hold the dependent job back
+    JobHandle second = jobSystem.createJob(incrementJob, &counter);
+    EXPECT_TRUE(jobSystem.addDependency(second, first));
+    jobSystem.run(second);
+    jobSystem.waitFor(second);
+    EXPECT_EQ(2, counter.load());
+}
+
+TEST_F(JobSystemTest, ringWrapTest) {
+    JobSystem jobSystem(2);
+    std::atomic<i32> counter(0);
+
+    // The unfinished job keeps its slot while the ring wraps around
+    JobHandle pending = jobSystem.createJob(incrementJob, &counter);
+    for (ui32 i = 0; i < JobSystem::MaxJobs * 2; ++i) {
+        JobHandle job = jobSystem.createJob(incrementJob, &counter);
+        ASSERT_NE(pending, job);
+        jobSystem.run(job);
+    }
+    jobSystem.run(pending);
+    jobSystem.waitFor(pending);
+    while (jobSystem.executeNext()) {
+        // empty
+    }
+    EXPECT_TRUE(jobSystem.isFinished(pending));
+}
+
+TEST_F(JobSystemTest, parallelForTest) {
+    static const size_t Count = 100000;
+
+    for (ui32 numWorkers = 0; numWorkers < 4; ++numWorkers) {
+        JobSystem jobSystem(numWorkers);
+        std::vector<i32> values(Count, 0);
+        jobSystem.parallelFor(Count, 1000, [&values](size_t begin, size_t end) {
+            for (size_t i = begin; i < end; ++i) {
+                values[i] += 1;
+            }
+        });
+        for (size_t i = 0; i < Count; ++i) {
+            ASSERT_EQ(1, values[i]);
+        }
+    }
+}
+
+TEST_F(JobSystemTest, foreignThreadTest) {
+    static const i32 NumJobs = 1000;
+
+    JobSystem jobSystem(2);
+    std::atomic<i32> counter(0);
+    std::thread producer([&jobSystem, &counter]() {
+        JobHandle root = jobSystem.createJob(nullptr, nullptr);
+        for (i32 i = 0; i < NumJobs; ++i) {
+            jobSystem.run(jobSystem.createChildJob(root, incrementJob, &counter));
+        }
+        jobSystem.run(root);
+        jobSystem.waitFor(root);
+    });
+    producer.join();
+    EXPECT_EQ(NumJobs, counter.load());
+}
+
+} // Namespace UnitTest
+} // Namespace OSRE
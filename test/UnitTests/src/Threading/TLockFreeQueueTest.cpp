@@ -0,0 +1,101 @@
+/*-----------------------------------------------------------------------------------------------
+The MIT License (MIT)
+
+Copyright (c) 2015-2022 OSRE ( Open Source Render Engine ) by Kim Kulling
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of
+this software and associated documentation files (the "Software"), to deal in
+the Software without restriction, including without limitation the rights to
+use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+the Software, and to permit persons to whom the Software is furnished to do so,
+subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+-----------------------------------------------------------------------------------------------*/
+#include "osre_testcommon.h"
+#include <osre/Threading/TLockFreeQueue.h>
+
+#include <thread>
+#include <vector>
+
+namespace OSRE {
+namespace UnitTest {
+
+using namespace ::OSRE::Threading;
+
+class TLockFreeQueueTest : public ::testing::Test {
+    // empty
+};
+
+TEST_F(TLockFreeQueueTest, createTest) {
+    TLockFreeQueue<i32> queue(100, QueueMode::SPSC);
+    EXPECT_EQ(128u, queue.capacity());
+    EXPECT_TRUE(queue.isEmpty());
+    EXPECT_EQ(0u, queue.size());
+    EXPECT_EQ(QueueMode::SPSC, queue.getMode());
+}
+
+TEST_F(TLockFreeQueueTest, enqueueDequeueTest) {
+    TLockFreeQueue<i32> queue(4, QueueMode::SPSC);
+    EXPECT_TRUE(queue.tryEnqueue(1));
+    EXPECT_TRUE(queue.tryEnqueue(2));
+    EXPECT_EQ(2u, queue.size());
+
+    i32 item = 0;
+    EXPECT_TRUE(queue.tryDequeue(item));
+    EXPECT_EQ(1, item);
+    EXPECT_TRUE(queue.tryDequeue(item));
+    EXPECT_EQ(2, item);
+    EXPECT_FALSE(queue.tryDequeue(item));
+    EXPECT_TRUE(queue.isEmpty());
+}
+
+TEST_F(TLockFreeQueueTest, fullTest) {
+    TLockFreeQueue<i32> queue(4, QueueMode::MPSC);
+    for (i32 i = 0; i < 4; ++i) {
+        EXPECT_TRUE(queue.tryEnqueue(i));
+    }
+    EXPECT_FALSE(queue.tryEnqueue(4));
+
+    i32 item = 0;
+    EXPECT_TRUE(queue.tryDequeue(item));
+    EXPECT_TRUE(queue.tryEnqueue(4));
+}
+
+TEST_F(TLockFreeQueueTest, multiProducerTest) {
+    static const i32 NumProducers = 4;
+    static const i32 NumItems = 10000;
+    TLockFreeQueue<i32> queue(64, QueueMode::MPSC);
+
+    std::vector<std::thread> producers;
+    for (i32 i = 0; i < NumProducers; ++i) {
+        producers.emplace_back([&queue]() {
+            for (i32 j = 1; j <= NumItems; ++j) {
+                queue.enqueue(j);
+            }
+        });
+    }
+
+    i64 sum = 0;
+    for (i32 i = 0; i < NumProducers * NumItems; ++i) {
+        sum += queue.dequeue();
+    }
+    for (std::thread &producer : producers) {
+        producer.join();
+    }
+
+    const i64 expected = static_cast<i64>(NumProducers) * NumItems * (NumItems + 1) / 2;
+    EXPECT_EQ(expected, sum);
+    EXPECT_TRUE(queue.isEmpty());
+}
+
+} // Namespace UnitTest
+} // Namespace OSRE
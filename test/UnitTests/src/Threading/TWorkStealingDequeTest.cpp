@@ -0,0 +1,116 @@
+/*-----------------------------------------------------------------------------------------------
+The MIT License (MIT)
+
+Copyright (c) 2015-2022 OSRE ( Open Source Render Engine ) by Kim Kulling
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of
+this software and associated documentation files (the "Software"), to deal in
+the Software without restriction, including without limitation the rights to
+use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+the Software, and to permit persons to whom the Software is furnished to do so,
+subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+-----------------------------------------------------------------------------------------------*/
+#include "osre_testcommon.h"
+#include <osre/Threading/TWorkStealingDeque.h>
+
+#include <atomic>
+#include <thread>
+#include <vector>
+
+namespace OSRE {
+namespace UnitTest {
+
+using namespace ::OSRE::Threading;
+
+class TWorkStealingDequeTest : public ::testing::Test {
+    // empty
+};
+
+TEST_F(TWorkStealingDequeTest, createTest) {
+    TWorkStealingDeque<ui32> deque(100);
+    EXPECT_EQ(128u, deque.capacity());
+    EXPECT_TRUE(deque.isEmpty());
+    EXPECT_EQ(0u, deque.size());
+}
+
+TEST_F(TWorkStealingDequeTest, pushPopStealTest) {
+    TWorkStealingDeque<ui32> deque(4);
+    for (ui32 i = 0; i < 4; ++i) {
+        EXPECT_TRUE(deque.push(i));
+    }
+    EXPECT_FALSE(deque.push(4));
+    EXPECT_EQ(4u, deque.size());
+
+    // The owner pops the newest item, thieves take the oldest one
+    ui32 item = 0;
+    EXPECT_TRUE(deque.pop(item));
+    EXPECT_EQ(3u, item);
+    EXPECT_TRUE(deque.steal(item));
+    EXPECT_EQ(0u, item);
+    EXPECT_TRUE(deque.pop(item));
+    EXPECT_EQ(2u, item);
+    EXPECT_TRUE(deque.pop(item));
+    EXPECT_EQ(1u, item);
+    EXPECT_FALSE(deque.pop(item));
+    EXPECT_FALSE(deque.steal(item));
+    EXPECT_TRUE(deque.isEmpty());
+}
+
+TEST_F(TWorkStealingDequeTest, concurrentStealTest) {
+    static const ui32 NumItems = 100000;
+    static const ui32 NumThieves = 3;
+
+    TWorkStealingDeque<ui32> deque(1024);
+    std::atomic<bool> done(false);
+    std::atomic<ui64> sum(0);
+    std::atomic<ui32> count(0);
+    std::vector<std::thread> thieves;
+    for (ui32 i = 0; i < NumThieves; ++i) {
+        thieves.push_back(std::thread([&deque, &done, &sum, &count]() {
+            ui32 item = 0;
+            while (!done.load()) {
+                if (deque.steal(item)) {
+                    sum.fetch_add(item);
+                    count.fetch_add(1);
+                }
+            }
+        }));
+    }
+
+    ui32 item = 0;
+    for (ui32 i = 1; i <= NumItems; ++i) {
+        while (!deque.push(i)) {
+            if (deque.pop(item)) {
+                sum.fetch_add(item);
+                count.fetch_add(1);
+            }
+        }
+    }
+    while (count.load() < NumItems) {
+        if (deque.pop(item)) {
+            sum.fetch_add(item);
+            count.fetch_add(1);
+        }
+    }
+    done.store(true);
+    for (std::thread &thief : thieves) {
+        thief.join();
+    }
+
+    // Each item was taken exactly once
+    EXPECT_EQ(NumItems, count.load());
+    EXPECT_EQ(static_cast<ui64>(NumItems) * (NumItems + 1) / 2, sum.load());
+}
+
+} // Namespace UnitTest
+} // Namespace OSRE